@@ -50,6 +50,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <DGMaxLogger.h>
 
 #include "Base/MeshManipulator.h"
+#include "Base/MpiContainer.h"
 #include "LinearAlgebra/SmallVector.h"
 #include "Utilities/GlobalMatrix.h"
 #include "Utilities/GlobalVector.h"
@@ -117,6 +118,9 @@ class SolverWorkspace {
         return eigenvalues_;
     }
 
+    /// Log the total number of iterations and solve time over all k-points.
+    void logStatistics() const;
+
    private:
     /// Helper function for getting the Stiffness matrix to use as basis in the
     /// eigenvalue problem.
@@ -163,11 +167,18 @@ class SolverWorkspace {
 
     std::vector<PetscScalar> eigenvalues_;
 
+    // Statistics over all solves
+    std::size_t numberOfSolves_;
+    PetscInt totalIterations_;
+    double totalSolveTime_;
+
     void initStiffnessMatrixShifts();
     void initMatrices();
     /// Initialize the Shell matrix
     void initStiffnessShellMatrix();
     void initSolver();
+    /// Configure the spectral transformation for shift-and-invert.
+    void initShiftInvert();
     void initEigenvectorStorage();
 
     void shellMultiply(Vec in, Vec out);
@@ -244,6 +255,43 @@ void sortEigenvalues(std::vector<PetscScalar>& result) {
               });
 }
 
+/// Gather the eigenvalues computed by the independent groups of processors
+/// (see MPIContainer::splitWorld). Each group only has the eigenvalues for the
+/// k-points it computed, afterwards all processors have all eigenvalues.
+void gatherEigenvalues(std::vector<std::vector<PetscScalar>>& eigenvalues) {
+#ifdef HPGEM_USE_MPI
+    Base::MPIContainer& mpiInstance = Base::MPIContainer::Instance();
+    // All processors in a group have the same eigenvalues, so only the first
+    // one of each group contributes.
+    const bool contributes = mpiInstance.getProcessorID() == 0;
+    std::vector<int> counts(eigenvalues.size(), 0);
+    if (contributes) {
+        for (std::size_t i = 0; i < eigenvalues.size(); ++i) {
+            counts[i] = static_cast<int>(eigenvalues[i].size());
+        }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, counts.data(), counts.size(), MPI_INT, MPI_SUM,
+                  mpiInstance.getWorldComm());
+    std::vector<std::size_t> offsets(eigenvalues.size() + 1, 0);
+    for (std::size_t i = 0; i < eigenvalues.size(); ++i) {
+        offsets[i + 1] = offsets[i] + counts[i];
+    }
+    std::vector<PetscScalar> values(offsets.back(), 0.0);
+    if (contributes) {
+        for (std::size_t i = 0; i < eigenvalues.size(); ++i) {
+            std::copy(eigenvalues[i].begin(), eigenvalues[i].end(),
+                      values.begin() + offsets[i]);
+        }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), MPIU_SCALAR,
+                  MPIU_SUM, mpiInstance.getWorldComm());
+    for (std::size_t i = 0; i < eigenvalues.size(); ++i) {
+        eigenvalues[i].assign(values.begin() + offsets[i],
+                              values.begin() + offsets[i + 1]);
+    }
+#endif
+}
+
 ///
 
 template <std::size_t DIM>
@@ -262,9 +310,18 @@ std::unique_ptr<AbstractEigenvalueResult<DIM>> DGMaxEigenvalue<DIM>::solve(
     LinearAlgebra::SmallVector<DIM> dk;  // Step in k-space from previous solve
     std::size_t maxStep = kpath.totalNumberOfSteps();
 
+    // When the processors are split into groups, each group solves a
+    // contiguous part of the path. This keeps the steps in k-space small, so
+    // that the previous solution remains a good starting point.
+    Base::MPIContainer& mpiInstance = Base::MPIContainer::Instance();
+    const std::size_t numberOfGroups = mpiInstance.getNumberOfGroups();
+    const std::size_t groupID = mpiInstance.getGroupID();
+    const std::size_t firstStep = groupID * maxStep / numberOfGroups;
+    const std::size_t endStep = (groupID + 1) * maxStep / numberOfGroups;
+
     std::vector<std::vector<PetscScalar>> eigenvalues(maxStep);
 
-    for (int i = 0; i < maxStep; ++i) {
+    for (std::size_t i = firstStep; i < endStep; ++i) {
         DGMaxLogger(INFO, "Computing eigenvalues for k-point %/%", i + 1,
                     maxStep);
         workspace.updateKPoint(kpath.k(i));
@@ -274,6 +331,10 @@ std::unique_ptr<AbstractEigenvalueResult<DIM>> DGMaxEigenvalue<DIM>::solve(
         eigenvalues[i] = workspace.getEigenvalues();
         sortEigenvalues(eigenvalues[i]);
     }
+    workspace.logStatistics();
+    if (numberOfGroups > 1) {
+        gatherEigenvalues(eigenvalues);
+    }
 
     return std::make_unique<Result>(input, eigenvalues);
 }
@@ -326,7 +387,10 @@ SolverWorkspace<DIM>::SolverWorkspace(DGMaxEigenvalueBase::SolverConfig config,
       tempFieldVector_(fieldIndex_, -1, -1),
       targetFrequency_(1),
       targetNumberOfEigenvalues_(numberOfEigenvalues),
-      numberOfEigenVectors_(0) {
+      numberOfEigenVectors_(0),
+      numberOfSolves_(0),
+      totalIterations_(0),
+      totalSolveTime_(0) {
 
     initMatrices();
     DGMaxLogger(INFO, "Matrices assembled");
@@ -476,11 +540,19 @@ void SolverWorkspace<DIM>::initSolver() {
     err =
         EPSSetProblemType(solver_, config_.useHermitian_ ? EPS_HEP : EPS_NHEP);
     CHKERRABORT(PETSC_COMM_WORLD, err);
-    err = EPSSetWhichEigenpairs(solver_, EPS_WHICH_USER);
-    CHKERRABORT(PETSC_COMM_WORLD, err);
-    err = EPSSetEigenvalueComparison(solver_, compareEigen,
-                                     &(this->targetFrequency_));
-    CHKERRABORT(PETSC_COMM_WORLD, err);
+    if (config_.shiftInvert_ == DGMaxEigenvalueBase::NO_SHIFT_INVERT) {
+        err = EPSSetWhichEigenpairs(solver_, EPS_WHICH_USER);
+        CHKERRABORT(PETSC_COMM_WORLD, err);
+        err = EPSSetEigenvalueComparison(solver_, compareEigen,
+                                         &(this->targetFrequency_));
+        CHKERRABORT(PETSC_COMM_WORLD, err);
+    } else {
+        // After the transformation the eigenvalues closest to the target are
+        // the largest ones.
+        err = EPSSetWhichEigenpairs(solver_, EPS_TARGET_MAGNITUDE);
+        CHKERRABORT(PETSC_COMM_WORLD, err);
+        initShiftInvert();
+    }
     err = EPSSetTarget(solver_, targetFrequency_ * targetFrequency_);
     CHKERRABORT(PETSC_COMM_WORLD, err);
 
@@ -494,8 +566,61 @@ void SolverWorkspace<DIM>::initSolver() {
     // overrides of the standard values.
     err = EPSSetFromOptions(solver_);
     CHKERRABORT(PETSC_COMM_WORLD, err);
-    err = EPSSetOperators(solver_, shell_, nullptr);
+    if (config_.shiftInvert_ == DGMaxEigenvalueBase::NO_SHIFT_INVERT) {
+        err = EPSSetOperators(solver_, shell_, nullptr);
+    } else {
+        // The inner solve needs an explicit matrix, the shell only adds the
+        // projector, which is not used at each step with shift-and-invert.
+        err = EPSSetOperators(solver_, getActualStiffnessMatrix(), nullptr);
+    }
+    CHKERRABORT(PETSC_COMM_WORLD, err);
+}
+
+template <std::size_t DIM>
+void SolverWorkspace<DIM>::initShiftInvert() {
+    logger.assert_always(
+        config_.useProjector_ != DGMaxEigenvalueBase::ALL,
+        "Shift-and-invert can not be combined with projecting at each step");
+    PetscErrorCode err;
+    ST spectralTransform;
+    err = EPSGetST(solver_, &spectralTransform);
+    CHKERRABORT(PETSC_COMM_WORLD, err);
+    err = STSetType(spectralTransform, STSINVERT);
+    CHKERRABORT(PETSC_COMM_WORLD, err);
+    // The nonzero pattern does not change between k-points, which allows the
+    // symbolic factorisation to be reused.
+    err = STSetMatStructure(spectralTransform, SAME_NONZERO_PATTERN);
     CHKERRABORT(PETSC_COMM_WORLD, err);
+
+    KSP innerSolver;
+    PC preconditioner;
+    err = STGetKSP(spectralTransform, &innerSolver);
+    CHKERRABORT(PETSC_COMM_WORLD, err);
+    err = KSPGetPC(innerSolver, &preconditioner);
+    CHKERRABORT(PETSC_COMM_WORLD, err);
+    if (config_.shiftInvert_ == DGMaxEigenvalueBase::SHIFT_INVERT_DIRECT) {
+        err = KSPSetType(innerSolver, KSPPREONLY);
+        CHKERRABORT(PETSC_COMM_WORLD, err);
+        err = PCSetType(preconditioner, PCLU);
+        CHKERRABORT(PETSC_COMM_WORLD, err);
+#ifdef PETSC_HAVE_MUMPS
+        // The builtin LU factorisation is only sequential
+        err = PCFactorSetMatSolverType(preconditioner, MATSOLVERMUMPS);
+        CHKERRABORT(PETSC_COMM_WORLD, err);
+#endif
+    } else {
+        err = KSPSetType(innerSolver, KSPGMRES);
+        CHKERRABORT(PETSC_COMM_WORLD, err);
+        err = PCSetType(preconditioner, PCGAMG);
+        CHKERRABORT(PETSC_COMM_WORLD, err);
+        // Keep the multigrid interpolation when the operator changes
+        err = PCGAMGSetReuseInterpolation(preconditioner, PETSC_TRUE);
+        CHKERRABORT(PETSC_COMM_WORLD, err);
+        // The outer eigenvalue solver needs accurate solves
+        err = KSPSetTolerances(innerSolver, 1e-10, PETSC_DEFAULT,
+                               PETSC_DEFAULT, PETSC_DEFAULT);
+        CHKERRABORT(PETSC_COMM_WORLD, err);
+    }
 }
 
 template <std::size_t DIM>
@@ -621,6 +746,15 @@ void SolverWorkspace<DIM>::updateKPoint(
 
     // Note, as we use a shell matrix for EPS, we don't have to call
     // EPSSetOperators, as the matrix used has not changed.
+    if (config_.shiftInvert_ != DGMaxEigenvalueBase::NO_SHIFT_INVERT) {
+        // With shift-and-invert the matrix is used directly, setting it again
+        // makes sure that the spectral transformation is updated. As the
+        // nonzero pattern is unchanged, only the numerical part of the
+        // factorisation is redone.
+        PetscErrorCode error =
+            EPSSetOperators(solver_, getActualStiffnessMatrix(), nullptr);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+    }
 
     currentK_ = newK;
 }
@@ -691,12 +825,40 @@ void SolverWorkspace<DIM>::solve() {
                 "Eigenvalue solver stopped after % iterations with % "
                 "eigenvalues in %s",
                 iterations, numEigenvalues, time.count());
+    numberOfSolves_++;
+    totalIterations_ += iterations;
+    totalSolveTime_ += time.count();
 
     // Post processing //
     /////////////////////
     extractEigenVectors();
 }
 
+template <std::size_t DIM>
+void SolverWorkspace<DIM>::logStatistics() const {
+    PetscErrorCode error;
+    ST spectralTransform;
+    error = EPSGetST(solver_, &spectralTransform);
+    CHKERRABORT(PETSC_COMM_WORLD, error);
+    KSP innerSolver;
+    error = STGetKSP(spectralTransform, &innerSolver);
+    CHKERRABORT(PETSC_COMM_WORLD, error);
+    PetscInt innerIterations;
+    error = KSPGetTotalIterations(innerSolver, &innerIterations);
+    CHKERRABORT(PETSC_COMM_WORLD, error);
+    DGMaxLogger(INFO,
+                "Solved % k-points with % outer and % inner iterations in %s "
+                "(shift-and-invert: %)",
+                numberOfSolves_, totalIterations_, innerIterations,
+                totalSolveTime_,
+                config_.shiftInvert_ == DGMaxEigenvalueBase::NO_SHIFT_INVERT
+                    ? "no"
+                    : (config_.shiftInvert_ ==
+                               DGMaxEigenvalueBase::SHIFT_INVERT_DIRECT
+                           ? "direct"
+                           : "iterative"));
+}
+
 // ShiftWorkspace //
 ////////////////////
 
@@ -62,12 +62,23 @@ class DGMaxEigenvalueBase {
         ALL
     };
 
+    enum ShiftInvertUse {
+        /// Solve for the eigenvalues of the operator itself
+        NO_SHIFT_INVERT,
+        /// Shift-and-invert around the target with a sparse direct (LU) solve
+        SHIFT_INVERT_DIRECT,
+        /// Shift-and-invert around the target with a multigrid preconditioned
+        /// Krylov solve
+        SHIFT_INVERT_ITERATIVE
+    };
+
     struct SolverConfig {
         SolverConfig()
             : useHermitian_(true),
               shiftFactor_(0),
               stab_(100),
-              useProjector_(NONE){};
+              useProjector_(NONE),
+              shiftInvert_(NO_SHIFT_INVERT){};
 
         /// Whether to solve M^{-1}S x = omega^2 (non Hermitian) or
         /// L^{-1} S L^{-T}y = omega^2 y (Hermitian)
@@ -78,6 +89,10 @@ class DGMaxEigenvalueBase {
         double stab_;
         /// Use a projector to remove the kernel of the stiffness matrix
         ProjectorUse useProjector_;
+        /// Use a shift-and-invert spectral transformation, which speeds up
+        /// the convergence of interior eigenvalues. Can not be combined with
+        /// using the projector at each step.
+        ShiftInvertUse shiftInvert_;
 
         /// Whether the config uses shifts
         bool usesShifts() const {
@@ -163,6 +178,11 @@ class DGMaxEigenvalue : public AbstractEigenvalueSolver<DIM>,
     DGMaxEigenvalue(Base::MeshManipulator<DIM>& mesh, std::size_t order,
                     SolverConfig config);
 
+    /// Solve the eigenvalue problem for each k-point on the path. When the
+    /// processors are split into groups (the --groups option), each group
+    /// solves a contiguous part of the path on its own copy of the mesh
+    /// (partitioned for the size of a group), after which the results of all
+    /// groups are gathered.
     std::unique_ptr<AbstractEigenvalueResult<DIM>> solve(
         const EigenvalueProblem<DIM>& input) override;
 
@@ -40,7 +40,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <petscksp.h>
 
+#include <cmath>
 #include <complex>
+#include "Base/MpiContainer.h"
 #include "Output/TecplotDiscontinuousSolutionWriter.h"
 #include "Utilities/GlobalMatrix.h"
 #include "Utilities/GlobalVector.h"
@@ -57,7 +59,23 @@ DGMaxHarmonic<DIM>::DGMaxHarmonic(Base::MeshManipulator<DIM>& mesh,
 template <std::size_t DIM>
 void DGMaxHarmonic<DIM>::solve(const HarmonicProblem<DIM>& harmonicProblem,
                                double stab) {
+    solveSweep(harmonicProblem, {harmonicProblem.omega()}, stab,
+               [](std::size_t, double) {});
+}
+
+template <std::size_t DIM>
+void DGMaxHarmonic<DIM>::solveSweep(
+    const HarmonicProblem<DIM>& harmonicProblem,
+    const std::vector<double>& frequencies, double stab,
+    SweepCallback onSolution, SweepConfig config) {
     PetscErrorCode error;
+    logger.assert_always(
+        !harmonicProblem.rhsDependsOnOmega() ||
+            (frequencies.size() == 1 &&
+             frequencies[0] == harmonicProblem.omega()),
+        "The right hand side of the problem depends on omega, so it can not "
+        "be reused for a sweep over % frequencies",
+        frequencies.size());
     std::cout << "finding a time-harmonic solution" << std::endl;
 
     std::map<std::size_t, typename DGMaxDiscretization<DIM>::InputFunction>
@@ -100,6 +118,13 @@ void DGMaxHarmonic<DIM>::solve(const HarmonicProblem<DIM>& harmonicProblem,
     //    error = VecScale(rhsVector, harmonicProblem.omega());
     //    CHKERRABORT(PETSC_COMM_WORLD, error);
 
+    // The system matrix S - omega^2 M, recomputed for each frequency from the
+    // assembled stiffness and mass matrix. The mass matrix is block diagonal,
+    // so its nonzero pattern is a subset of that of the stiffness matrix.
+    Mat systemMatrix;
+    error = MatDuplicate(stiffnessMatrix, MAT_COPY_VALUES, &systemMatrix);
+    CHKERRABORT(PETSC_COMM_WORLD, error);
+
     KSP solver;
     error = KSPCreate(PETSC_COMM_WORLD, &solver);
     CHKERRABORT(PETSC_COMM_WORLD, error);
@@ -114,13 +139,6 @@ void DGMaxHarmonic<DIM>::solve(const HarmonicProblem<DIM>& harmonicProblem,
     error = KSPSetPC(solver, preconditioner);
     CHKERRABORT(PETSC_COMM_WORLD, error);
 
-    double omega2 = harmonicProblem.omega();
-    omega2 *= omega2;
-
-    error = MatAXPY(stiffnessMatrix, -1.0 * omega2, massMatrix,
-                    SUBSET_NONZERO_PATTERN);
-    CHKERRABORT(PETSC_COMM_WORLD, error);
-
     error = KSPSetTolerances(solver, 1e-10, PETSC_DEFAULT, PETSC_DEFAULT,
                              PETSC_DEFAULT);
     CHKERRABORT(PETSC_COMM_WORLD, error);
@@ -128,22 +146,69 @@ void DGMaxHarmonic<DIM>::solve(const HarmonicProblem<DIM>& harmonicProblem,
     error = KSPSetType(solver, "minres");
     CHKERRABORT(PETSC_COMM_WORLD, error);
 
+    error = KSPSetInitialGuessNonzero(
+        solver, config.warmStart_ ? PETSC_TRUE : PETSC_FALSE);
+    CHKERRABORT(PETSC_COMM_WORLD, error);
+
     // everything that is set in the code, but before this line is overridden by
     // command-line options
     error = KSPSetFromOptions(solver);
     CHKERRABORT(PETSC_COMM_WORLD, error);
 
-    error = KSPSetOperators(solver, stiffnessMatrix, stiffnessMatrix);
-    CHKERRABORT(PETSC_COMM_WORLD, error);
-    error = KSPSetUp(solver);
-    CHKERRABORT(PETSC_COMM_WORLD, error);
-    error = KSPSolve(solver, rhsVector, resultVector);
-    CHKERRABORT(PETSC_COMM_WORLD, error);
+    // Each group of processors solves a contiguous part of the frequencies, so
+    // that subsequent frequencies in a group stay close together.
+    Base::MPIContainer& mpiInstance = Base::MPIContainer::Instance();
+    const std::size_t numberOfGroups = mpiInstance.getNumberOfGroups();
+    const std::size_t groupID = mpiInstance.getGroupID();
+    const std::size_t firstFrequency =
+        groupID * frequencies.size() / numberOfGroups;
+    const std::size_t endFrequency =
+        (groupID + 1) * frequencies.size() / numberOfGroups;
+
+    // omega^2 for which the current preconditioner was built, negative if
+    // there is none.
+    double preconditionerOmega2 = -1.0;
+    for (std::size_t i = firstFrequency; i < endFrequency; ++i) {
+        double omega2 = frequencies[i] * frequencies[i];
+
+        error = MatCopy(stiffnessMatrix, systemMatrix, SAME_NONZERO_PATTERN);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+        error = MatAXPY(systemMatrix, -1.0 * omega2, massMatrix,
+                        SUBSET_NONZERO_PATTERN);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+
+        bool reusePreconditioner =
+            preconditionerOmega2 >= 0 &&
+            std::abs(omega2 - preconditionerOmega2) <=
+                config.preconditionerReuseTolerance_ * preconditionerOmega2;
+        if (!reusePreconditioner) {
+            preconditionerOmega2 = omega2;
+        }
+        error = KSPSetReusePreconditioner(
+            solver, reusePreconditioner ? PETSC_TRUE : PETSC_FALSE);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+        error = KSPSetOperators(solver, systemMatrix, systemMatrix);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+        error = KSPSetUp(solver);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+        error = KSPSolve(solver, rhsVector, resultVector);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+
+        PetscInt iterations;
+        error = KSPGetIterationNumber(solver, &iterations);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+        logger(INFO, "Frequency %/% (omega = %) solved in % iterations%", i + 1,
+               frequencies.size(), frequencies[i], iterations,
+               reusePreconditioner ? " (reused preconditioner)" : "");
+
+        resultVector.writeTimeIntegrationVector(0);  // DOUBTFUL
+        onSolution(i, frequencies[i]);
+    }
 
     error = KSPDestroy(&solver);
     CHKERRABORT(PETSC_COMM_WORLD, error);
-
-    resultVector.writeTimeIntegrationVector(0);  // DOUBTFUL
+    error = MatDestroy(&systemMatrix);
+    CHKERRABORT(PETSC_COMM_WORLD, error);
 }
 
 template <std::size_t DIM>
@@ -41,6 +41,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "../ProblemTypes/HarmonicProblem.h"
 
+#include <functional>
+#include <vector>
+
 #include "DGMaxDiscretization.h"
 
 using namespace hpgem;
@@ -49,9 +52,42 @@ using namespace hpgem;
 template <std::size_t DIM>
 class DGMaxHarmonic {
    public:
+    /// Configuration of a frequency sweep
+    struct SweepConfig {
+        SweepConfig()
+            : preconditionerReuseTolerance_(0.05), warmStart_(true){};
+
+        /// Reuse the preconditioner (or factorisation) of an earlier
+        /// frequency as long as omega^2 differs at most this fraction from
+        /// the omega^2 it was built for. Use 0 to rebuild it every frequency.
+        double preconditionerReuseTolerance_;
+        /// Use the solution of the previous frequency as initial guess.
+        bool warmStart_;
+    };
+
+    /// Callback after solving for a frequency with its index in the sweep and
+    /// the frequency itself. The solution is available as time integration
+    /// vector 0, so that computeError and writeTec can be used.
+    using SweepCallback = std::function<void(std::size_t, double)>;
+
     explicit DGMaxHarmonic(Base::MeshManipulator<DIM>& mesh, std::size_t order);
     void solve(const HarmonicProblem<DIM>& harmonicProblem, double stab);
 
+    /// Solve the harmonic problem for a list of frequencies, replacing
+    /// harmonicProblem.omega(). The right hand side is assembled once from
+    /// the source term and boundary condition of harmonicProblem, so these
+    /// may not depend on the frequency (see rhsDependsOnOmega, which is
+    /// checked unless the only frequency is harmonicProblem.omega()). The
+    /// stiffness and mass matrix are also only assembled once, and the
+    /// frequencies should preferably be sorted so that the preconditioner and
+    /// previous solution stay useful. When the processors are split into
+    /// groups (the --groups option) each group solves a contiguous part of
+    /// the frequencies and calls onSolution only for those.
+    void solveSweep(const HarmonicProblem<DIM>& harmonicProblem,
+                    const std::vector<double>& frequencies, double stab,
+                    SweepCallback onSolution,
+                    SweepConfig config = SweepConfig());
+
     std::map<typename DGMaxDiscretization<DIM>::NormType, double> computeError(
         const typename std::set<typename DGMaxDiscretization<DIM>::NormType>&
             norms,
@@ -38,6 +38,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "DGMaxTimeIntegration.h"
 
+#include <chrono>
+
 #include "petscksp.h"
 
 #include "Utilities/GlobalMatrix.h"
@@ -48,7 +50,10 @@ using namespace hpgem;
 template <std::size_t DIM>
 DGMaxTimeIntegration<DIM>::DGMaxTimeIntegration(
     Base::MeshManipulator<DIM>& mesh, std::size_t order)
-    : mesh_(mesh), discretization(), snapshotTime(nullptr) {
+    : mesh_(mesh),
+      discretization(),
+      snapshotTime(nullptr),
+      numberOfSnapshots(0) {
     discretization.initializeBasisFunctions(mesh_, order);
 }
 
@@ -71,11 +76,13 @@ void DGMaxTimeIntegration<DIM>::solve(
         delete[] snapshotTime;
         snapshotTime = nullptr;
     }
-    snapshotTime = new double[parameters.numberOfSnapshots()];
-    for (Base::Element* element :
-         mesh_.getElementsList(Base::IteratorType::GLOBAL)) {
-        element->setNumberOfTimeIntegrationVectors(
-            parameters.numberOfSnapshots());
+    if (parameters.storeSnapshots) {
+        snapshotTime = new double[parameters.numberOfSnapshots()];
+        for (Base::Element* element :
+             mesh_.getElementsList(Base::IteratorType::GLOBAL)) {
+            element->setNumberOfTimeIntegrationVectors(
+                parameters.numberOfSnapshots());
+        }
     }
 
     PetscErrorCode error;
@@ -134,15 +141,9 @@ void DGMaxTimeIntegration<DIM>::solve(
     derivative.assemble();
     std::cout << "derivative_ assembled" << std::endl;
 
-    Vec dummy, dummy2, dummy3;
+    Vec dummy;
     error = VecDuplicate(derivative, &dummy);
     CHKERRABORT(PETSC_COMM_WORLD, error);
-    if (parameters.method == CO4) {
-        error = VecDuplicate(derivative, &dummy3);
-        CHKERRABORT(PETSC_COMM_WORLD, error);
-    }
-    error = VecDuplicate(derivative, &dummy2);
-    CHKERRABORT(PETSC_COMM_WORLD, error);
     error = MatMult(massMatrix, derivative, dummy);
     CHKERRABORT(PETSC_COMM_WORLD, error);
     error = VecCopy(dummy, derivative);
@@ -155,7 +156,6 @@ void DGMaxTimeIntegration<DIM>::solve(
     double tau = parameters.timeStepSize;
 
     double t = 0;
-    snapshotTime[0] = t;
 
     double scale0, scale1;
     if (parameters.method == CO2) {
@@ -165,7 +165,6 @@ void DGMaxTimeIntegration<DIM>::solve(
 
     LinearAlgebra::SmallVector<6> alpha, beta, alpha_sum, beta_sum,
         scale0vector, scale1vector;
-    double sourceTime;
     if (parameters.method == CO4) {
         getCoeffCO4(alpha, beta, alpha_sum, beta_sum, scale0vector,
                     scale1vector);
@@ -174,111 +173,190 @@ void DGMaxTimeIntegration<DIM>::solve(
 
     std::cout << tau << " " << parameters.numberOfSteps << std::endl;
 
-    for (int i = 0; i < parameters.numberOfSteps; ++i) {
-        if (i % parameters.snapshotStride == 0) {
-            logger(DEBUG, "Writing snapshot at timestep %, (t=%)", i, t);
+    // Both methods consist of stages of the form
+    //   x += xFactor * y
+    //   y  = scale0 * scale1 * y
+    //        + scale1 * M^{-1} (stiffnessFactor * S x
+    //                           + boundaryFactor * b + sourceFactor * s)
+    // where x is the field (resultVector), y its derivative, b and s the
+    // boundary and source vectors, and the factors contain the time scaling.
+    // Each stage is done with a minimal number of passes over the vectors: a
+    // single VecAXPBYPCZ for the combined right hand side, and MatMultAdd for
+    // applying the (inverse) mass matrix and adding it to y.
+    // The final x update of a time step is postponed and merged with the first
+    // update of the next time step (pendingX), unless a snapshot is needed.
+    double pendingX = 0.0;
+    auto applyStage = [&](double xFactor, double stiffnessFactor,
+                          double boundaryFactor, double sourceFactor,
+                          double stageScale0, double stageScale1) {
+        error = VecAXPY(resultVector, pendingX + xFactor, derivative);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+        pendingX = 0.0;
+        error = MatMult(stiffnessMatrix, resultVector, dummy);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+        error = VecAXPBYPCZ(dummy, stageScale1 * boundaryFactor,
+                            stageScale1 * sourceFactor,
+                            stageScale1 * stiffnessFactor, rhsBoundary,
+                            rhsSource);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+        if (stageScale0 * stageScale1 != 1.0) {
+            error = VecScale(derivative, stageScale0 * stageScale1);
+            CHKERRABORT(PETSC_COMM_WORLD, error);
+        }
+        error = MatMultAdd(massMatrix, dummy, derivative, derivative);
+        CHKERRABORT(PETSC_COMM_WORLD, error);
+    };
+    auto applyPendingX = [&]() {
+        if (pendingX != 0.0) {
+            error = VecAXPY(resultVector, pendingX, derivative);
+            CHKERRABORT(PETSC_COMM_WORLD, error);
+            pendingX = 0.0;
+        }
+    };
+
+    // Snapshots are either stored in the elements, or copied and streamed to
+    // the sinks, which process them on a separate thread.
+    std::unique_ptr<DGMax::SnapshotQueue> snapshotQueue;
+    if (!snapshotSinks_.empty()) {
+        snapshotQueue = std::make_unique<DGMax::SnapshotQueue>(
+            snapshotSinks_, parameters.snapshotQueueCapacity);
+    }
+    auto takeSnapshot = [&](std::size_t step) {
+        applyPendingX();
+        logger(DEBUG, "Writing snapshot at timestep %, (t=%)", step, t);
+        if (parameters.storeSnapshots) {
             resultVector.writeTimeIntegrationVector(snapshotIndex);
             snapshotTime[snapshotIndex] = t;
-            snapshotIndex++;
         }
-        if (parameters.method == CO2) {
-            // leap-frog sceme (Yee)
-            error = VecAXPY(resultVector, tau / 2, derivative);
-            CHKERRABORT(PETSC_COMM_WORLD, error);
-            error = MatMult(stiffnessMatrix, resultVector, dummy);
-            CHKERRABORT(
-                PETSC_COMM_WORLD,
-                error);  // starting here:dummy contaings partial update of x
-
-            // compute dummy2, a time scaled version of the RHS contains
-            // time-scaled version of RHS
-            error = VecCopy(rhsBoundary, dummy2);
-            CHKERRABORT(PETSC_COMM_WORLD, error);
-            error = VecScale(dummy2, input.timeScalingBoundary(t));
+        if (snapshotQueue) {
+            DGMax::Snapshot snapshot;
+            snapshot.index = snapshotIndex;
+            snapshot.time = t;
+            snapshot.indexing = &indexing;
+            const PetscScalar* data;
+            PetscInt localSize;
+            error = VecGetLocalSize(resultVector, &localSize);
             CHKERRABORT(PETSC_COMM_WORLD, error);
-            error = VecAXPY(dummy2, input.timeScalingSource(t), rhsSource);
+            error = VecGetArrayRead(resultVector, &data);
             CHKERRABORT(PETSC_COMM_WORLD, error);
-
-            CHKERRABORT(PETSC_COMM_WORLD, error);
-            error = VecScale(dummy2, 0.5 * tau);
-            CHKERRABORT(PETSC_COMM_WORLD, error);
-            error = VecAYPX(dummy, -tau, dummy2);
-            CHKERRABORT(PETSC_COMM_WORLD, error);
-            // Stage 2
-            error = VecCopy(rhsBoundary, dummy2);
-            CHKERRABORT(PETSC_COMM_WORLD, error);
-            error = VecScale(dummy2, input.timeScalingBoundary(t + tau));
-            CHKERRABORT(PETSC_COMM_WORLD, error);
-            error =
-                VecAXPY(dummy2, input.timeScalingSource(t + tau), rhsSource);
+            snapshot.coefficients.assign(data, data + localSize);
+            error = VecRestoreArrayRead(resultVector, &data);
             CHKERRABORT(PETSC_COMM_WORLD, error);
+            snapshotQueue->push(std::move(snapshot));
+        }
+        snapshotIndex++;
+    };
 
-            error = VecAXPY(dummy, 0.5 * tau, dummy2);
-            CHKERRABORT(PETSC_COMM_WORLD, error);
-            error = VecScale(dummy, scale1);
-            CHKERRABORT(PETSC_COMM_WORLD, error);
-            error = MatMult(massMatrix, dummy, dummy2);
-            CHKERRABORT(
-                PETSC_COMM_WORLD,
-                error);  // starting here: dummy2 contiains partial update of x
-            error = VecAYPX(derivative, scale0 * scale1, dummy2);
-            CHKERRABORT(PETSC_COMM_WORLD, error);
-            error = VecAXPY(resultVector, tau / 2, derivative);
-            CHKERRABORT(PETSC_COMM_WORLD, error);
+    // Time spent writing snapshots, excluded from the bandwidth measurement
+    std::chrono::duration<double> snapshotDuration(0);
+    auto loopStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < parameters.numberOfSteps; ++i) {
+        if (i % parameters.snapshotStride == 0) {
+            auto snapshotStart = std::chrono::steady_clock::now();
+            takeSnapshot(i);
+            snapshotDuration +=
+                std::chrono::steady_clock::now() - snapshotStart;
+        }
+        if (parameters.method == CO2) {
+            // leap-frog sceme (Yee)
+            applyStage(tau / 2, -tau,
+                       0.5 * tau *
+                           (input.timeScalingBoundary(t) +
+                            input.timeScalingBoundary(t + tau)),
+                       0.5 * tau *
+                           (input.timeScalingSource(t) +
+                            input.timeScalingSource(t + tau)),
+                       scale0, scale1);
+            pendingX = tau / 2;
             t = t + tau;
         }
 
         if (parameters.method == CO4) {
             for (unsigned int k = 1; k < 6; ++k) {
-                error = VecAXPY(resultVector, tau * (alpha[k - 1] + beta[k]),
-                                derivative);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
-
-                error = MatMult(stiffnessMatrix, resultVector, dummy);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
-
-                sourceTime = t + (alpha_sum[k - 1] + beta_sum[k - 1]) * tau;
-                double eta = input.timeScalingBoundary(sourceTime);
-                // error = VecCopy(RHS_, dummy2);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
-                error = VecScale(dummy2, beta[k] * tau * eta);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
-                VecAYPX(dummy, -(beta[k] + alpha[k]) * tau, dummy2);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
-
-                sourceTime = t + (alpha_sum[k] + beta_sum[k]) * tau;
-                eta = input.timeScalingBoundary(sourceTime);
-                // error = VecCopy(RHS_, dummy2);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
-                error = VecScale(dummy2, alpha[k] * tau * eta);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
-                error = VecAXPY(dummy, 1.0, dummy2);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
-
-                error = VecScale(dummy, scale1vector[k]);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
-                error = MatMult(massMatrix, dummy, dummy3);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
-                VecAYPX(derivative, scale0vector[k] * scale1vector[k], dummy3);
-                CHKERRABORT(PETSC_COMM_WORLD, error);
+                double sourceTime1 =
+                    t + (alpha_sum[k - 1] + beta_sum[k - 1]) * tau;
+                double sourceTime2 = t + (alpha_sum[k] + beta_sum[k]) * tau;
+                applyStage(tau * (alpha[k - 1] + beta[k]),
+                           -(beta[k] + alpha[k]) * tau,
+                           tau * (beta[k] * input.timeScalingBoundary(
+                                                sourceTime1) +
+                                  alpha[k] * input.timeScalingBoundary(
+                                                 sourceTime2)),
+                           tau * (beta[k] * input.timeScalingSource(
+                                                sourceTime1) +
+                                  alpha[k] * input.timeScalingSource(
+                                                 sourceTime2)),
+                           scale0vector[k], scale1vector[k]);
             }
-            error = VecAXPY(resultVector, tau * alpha[5], derivative);
-            CHKERRABORT(PETSC_COMM_WORLD, error);
+            pendingX = tau * alpha[5];
             t += tau;
         }
-        // getArrayRead only gets local values, so make the entire std::vector
-        // local
     }
+    applyPendingX();
+    std::chrono::duration<double> loopDuration =
+        std::chrono::steady_clock::now() - loopStart - snapshotDuration;
+    reportBandwidth(stiffnessMatrix, massMatrix, derivative,
+                    parameters.method == CO2 ? 1 : 5, parameters.numberOfSteps,
+                    loopDuration.count());
+
     // Save the last snapshot if needed.
     if (parameters.numberOfSteps % parameters.snapshotStride == 0) {
-        logger(DEBUG, "Writing snapshot at timestep %, (t=%)",
-               parameters.numberOfSteps, t);
-        resultVector.writeTimeIntegrationVector(snapshotIndex);
-        snapshotTime[snapshotIndex] = t;
-        snapshotIndex++;
+        takeSnapshot(parameters.numberOfSteps);
+    }
+    if (snapshotQueue) {
+        snapshotQueue->close();
     }
+    error = VecDestroy(&dummy);
+    CHKERRABORT(PETSC_COMM_WORLD, error);
     // Save the number of snapshots for writing the output.
-    numberOfSnapshots = snapshotIndex;
+    numberOfSnapshots = parameters.storeSnapshots ? snapshotIndex : 0;
+}
+
+/// Report the memory bandwidth achieved by the time integration. The traffic
+/// is estimated from the stages as implemented in solve: each stage passes
+/// over 12 vectors (3 for the x update, 2 for MatMult, 4 for VecAXPBYPCZ and 3
+/// for MatMultAdd) and reads both matrices once in AIJ format. Optional
+/// scaling for conductivity and ghost exchanges are not counted, so this is a
+/// lower bound.
+template <std::size_t DIM>
+void DGMaxTimeIntegration<DIM>::reportBandwidth(Mat stiffnessMatrix,
+                                                Mat massMatrix, Vec vector,
+                                                std::size_t stagesPerStep,
+                                                std::size_t numberOfSteps,
+                                                double seconds) const {
+    if (numberOfSteps == 0 || seconds <= 0) {
+        return;
+    }
+    PetscErrorCode error;
+    PetscInt size;
+    error = VecGetSize(vector, &size);
+    CHKERRABORT(PETSC_COMM_WORLD, error);
+    MatInfo stiffnessInfo, massInfo;
+    error = MatGetInfo(stiffnessMatrix, MAT_GLOBAL_SUM, &stiffnessInfo);
+    CHKERRABORT(PETSC_COMM_WORLD, error);
+    error = MatGetInfo(massMatrix, MAT_GLOBAL_SUM, &massInfo);
+    CHKERRABORT(PETSC_COMM_WORLD, error);
+
+    const double vectorBytes = size * sizeof(PetscScalar);
+    // Value and column index for each nonzero, row offset for each row
+    const double matrixBytes =
+        (stiffnessInfo.nz_used + massInfo.nz_used) *
+            (sizeof(PetscScalar) + sizeof(PetscInt)) +
+        2.0 * size * sizeof(PetscInt);
+    const double bytesPerStep =
+        stagesPerStep * (12 * vectorBytes + matrixBytes);
+    const double secondsPerStep = seconds / numberOfSteps;
+    logger(INFO,
+           "Time integration: % steps in %s, %ms per step, estimated memory "
+           "bandwidth % GB/s (% MB per step)",
+           numberOfSteps, seconds, 1e3 * secondsPerStep,
+           bytesPerStep / secondsPerStep * 1e-9, bytesPerStep * 1e-6);
+}
+
+template <std::size_t DIM>
+void DGMaxTimeIntegration<DIM>::addSnapshotSink(
+    std::shared_ptr<DGMax::SnapshotSink> sink) {
+    snapshotSinks_.push_back(std::move(sink));
 }
 
 template <std::size_t DIM>
@@ -323,6 +401,9 @@ void DGMaxTimeIntegration<DIM>::getCoeffCO4(
 
 template <std::size_t DIM>
 void DGMaxTimeIntegration<DIM>::writeTimeSnapshots(std::string fileName) const {
+    logger.assert_always(numberOfSnapshots > 0,
+                         "No stored snapshots, set storeSnapshots or use a "
+                         "TecplotSnapshotSink");
     std::ofstream fileWriter;
     fileWriter.open(fileName);
 
@@ -381,6 +462,8 @@ void DGMaxTimeIntegration<DIM>::printErrors(
     const typename DGMaxDiscretization<DIM>::TimeFunction& exactField,
     const typename DGMaxDiscretization<DIM>::TimeFunction& exactCurl) const {
     using NormType = typename DGMaxDiscretization<DIM>::NormType;
+    logger.assert_always(numberOfSnapshots > 0,
+                         "No stored snapshots, set storeSnapshots");
     std::set<NormType> normSet;
 
     std::cout << "t";
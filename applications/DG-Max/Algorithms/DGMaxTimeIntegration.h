@@ -39,9 +39,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef HPGEM_APP_DGMAXTIMEINTEGRATION_H
 #define HPGEM_APP_DGMAXTIMEINTEGRATION_H
 
+#include <petscmat.h>
+
 #include "Output/TecplotDiscontinuousSolutionWriter.h"
 
 #include "../ProblemTypes/TimeIntegrationProblem.h"
+#include "../Utils/SnapshotStream.h"
 
 #include "DGMaxDiscretization.h"
 
@@ -62,6 +65,17 @@ class DGMaxTimeIntegration {
     ~DGMaxTimeIntegration();
     void solve(const SeparableTimeIntegrationProblem<DIM>& input,
                TimeIntegrationParameters<DIM> parameters);
+    /// \brief Add a sink to which the snapshots of the next solve are
+    /// streamed.
+    void addSnapshotSink(std::shared_ptr<DGMax::SnapshotSink> sink);
+    /// \brief The discretization, for example to construct a
+    /// DGMax::TecplotSnapshotSink.
+    const DGMaxDiscretization<DIM>& getDiscretization() const {
+        return discretization;
+    }
+    /// \brief Write the snapshots stored by the last solve, which requires
+    /// TimeIntegrationParameters::storeSnapshots (see also
+    /// DGMax::TecplotSnapshotSink). The same holds for printErrors.
     void writeTimeSnapshots(std::string fileName) const;
     void printErrors(
         const std::vector<typename DGMaxDiscretization<DIM>::NormType>& norms,
@@ -79,6 +93,10 @@ class DGMaxTimeIntegration {
                      LinearAlgebra::SmallVector<6>& beta_sum,
                      LinearAlgebra::SmallVector<6>& scale0,
                      LinearAlgebra::SmallVector<6>& scale1) const;
+    /// \brief Log the time per step and the estimated memory bandwidth.
+    void reportBandwidth(Mat stiffnessMatrix, Mat massMatrix, Vec vector,
+                         std::size_t stagesPerStep, std::size_t numberOfSteps,
+                         double seconds) const;
     void writeTimeLevel(Output::TecplotDiscontinuousSolutionWriter<DIM>& writer,
                         std::size_t timeLevel, bool firstLevel) const;
     Base::MeshManipulator<DIM>& mesh_;
@@ -86,6 +104,7 @@ class DGMaxTimeIntegration {
     // TODO: This should be output of the solver, not a local variable.
     double* snapshotTime;
     std::size_t numberOfSnapshots;
+    std::vector<std::shared_ptr<DGMax::SnapshotSink>> snapshotSinks_;
 };
 
 template <std::size_t DIM>
@@ -103,6 +122,16 @@ struct TimeIntegrationParameters {
     /// \brief Stride of the time steps where a snapshot should be taken
     std::size_t snapshotStride;
 
+    /// \brief Whether to also store the snapshots in the elements, for use
+    /// with writeTimeSnapshots and printErrors. By default the snapshots are
+    /// only streamed to the sinks (see addSnapshotSink), as storing them uses
+    /// memory proportional to the number of snapshots.
+    bool storeSnapshots = false;
+
+    /// \brief Maximum number of snapshots waiting to be processed by the
+    /// snapshot sinks.
+    std::size_t snapshotQueueCapacity = 4;
+
     /// \brief Configure the time stepping parameters in the traditional style.
     ///
     /// This is intended as compatibility method with the previous style of
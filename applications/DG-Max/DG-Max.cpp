@@ -160,7 +160,8 @@ int main(int argc, char** argv) {
         EigenvalueProblem<DIM> input(path, numEigenvalues.getValue());
         std::unique_ptr<AbstractEigenvalueResult<DIM>> result =
             solver.solve(input);
-        if (Base::MPIContainer::Instance().getProcessorID() == 0) {
+        if (Base::MPIContainer::Instance().getProcessorID() == 0 &&
+            Base::MPIContainer::Instance().getGroupID() == 0) {
             result->printFrequencies();
         }
 
@@ -175,6 +176,7 @@ int main(int argc, char** argv) {
         //        parameters.configureTraditional(DGMaxTimeIntegration::CO2, 1,
         //        p.getValue(), numElements.getValue());
         //        parameters.snapshotStride = 100;
+        //        parameters.storeSnapshots = true;
         //        timeSolver.solve(testProblem, parameters);
         //
         //        timeSolver.writeTimeSnapshots("domokos.dat");
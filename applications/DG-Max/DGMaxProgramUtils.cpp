@@ -1,7 +1,9 @@
 
 #include "DGMaxProgramUtils.h"
 
+#include "Base/CommandLineOptions.h"
 #include "Base/MeshManipulator.h"
+#include "Base/MpiContainer.h"
 
 #include "DGMaxLogger.h"
 #include "ElementInfos.h"
@@ -15,6 +17,26 @@ using namespace hpgem;
 #endif
 
 namespace DGMax {
+
+// Number of independent processor groups, e.g. --groups 4. Each group runs its
+// own replica of the computation on part of the k-points or frequencies.
+static auto& numberOfGroups = Base::register_argument<std::size_t>(
+    '\0', "groups",
+    "Split the processors into this many independent groups, each running its "
+    "own replica of the computation (e.g. for parameter sweeps)",
+    false, 1);
+
+// The split has to happen before the communicators are set up
+static const bool groupHookRegistered = []() {
+    Base::register_setup_hook([]() {
+        if (numberOfGroups.isUsed()) {
+            Base::MPIContainer::splitWorld(
+                static_cast<int>(numberOfGroups.getValue()));
+        }
+    });
+    return true;
+}();
+
 void printArguments(int argc, char** argv) {
 #ifdef HPGEM_USE_MPI
     int rank;
@@ -71,6 +71,11 @@ class HarmonicProblem {
         const Geometry::PointPhysical<DIM>& point,
         Base::PhysicalFace<DIM>& face,
         LinearAlgebra::SmallVector<DIM>& result) const = 0;
+
+    /// Whether the source term or boundary condition change with omega. Only
+    /// problems that return false can be used for a frequency sweep, as the
+    /// right hand side is then assembled once for all frequencies.
+    virtual bool rhsDependsOnOmega() const { return true; }
 };
 
 template <std::size_t DIM>
@@ -156,7 +156,9 @@ void runWithDimension() {
         result = solver.solve(input);
     }
 
-    if (Base::MPIContainer::Instance().getProcessorID() == 0) {
+    // With --groups every group has all results, only write them once.
+    if (Base::MPIContainer::Instance().getProcessorID() == 0 &&
+        Base::MPIContainer::Instance().getGroupID() == 0) {
         result->printFrequencies();
         result->writeFrequencies("frequencies.csv");
     }
@@ -66,6 +66,14 @@ auto &method = Base::register_argument<std::string>(
     "The method to be used, either 'DGMAX' or 'DIVDGMAX' (default)", false,
     "DIVDGMAX");
 
+// Compare the eigenvalue solver setups, the solver logs the iterations and
+// time used for each level.
+auto &shiftInvert = Base::register_argument<std::string>(
+    '\0', "shiftInvert",
+    "Shift-and-invert for DGMAX, either 'NONE' (default), 'DIRECT' or "
+    "'ITERATIVE'",
+    false, "NONE");
+
 /// Create a reference bandstructure based on the structure index
 template <std::size_t DIM>
 std::unique_ptr<BandStructure<DIM>> createStructure(
@@ -128,6 +136,15 @@ void runWithDimension() {
         config.stab_ = 100;
         config.shiftFactor_ = 0.0;
         config.useProjector_ = DGMaxEigenvalueBase::NONE;
+        if (shiftInvert.getValue() == "DIRECT") {
+            config.shiftInvert_ = DGMaxEigenvalueBase::SHIFT_INVERT_DIRECT;
+        } else if (shiftInvert.getValue() == "ITERATIVE") {
+            config.shiftInvert_ = DGMaxEigenvalueBase::SHIFT_INVERT_ITERATIVE;
+        } else if (shiftInvert.getValue() != "NONE") {
+            DGMaxLogger(ERROR, "Unknown shift-and-invert mode %",
+                        shiftInvert.getValue());
+            return;
+        }
         convergenceTest = std::make_unique<DGMax::DGMaxEVConvergenceTest<DIM>>(
             testPoint, meshFiles,
             0.0,  // No expecations
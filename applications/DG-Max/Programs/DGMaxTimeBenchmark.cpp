@@ -0,0 +1,144 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2020, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Program to benchmark the time integration, it reports the time per step and
+// the estimated memory bandwidth achieved by the time stepping. Optionally the
+// snapshots are streamed to a Tecplot file while stepping, to measure the
+// overhead of the snapshot stream.
+
+#include "Base/CommandLineOptions.h"
+
+#include "DGMaxLogger.h"
+#include "DGMaxProgramUtils.h"
+#include "Algorithms/DGMaxTimeIntegration.h"
+#include "ProblemTypes/Time/SampleTestProblems.h"
+#include "Utils/SnapshotStream.h"
+
+using namespace hpgem;
+
+auto& meshFile = Base::register_argument<std::string>(
+    'm', "meshFile", "The hpgem meshfile to use", true);
+
+auto& order = Base::register_argument<std::size_t>(
+    'p', "order", "Polynomial order of the solution", true);
+
+auto& d = Base::register_argument<std::size_t>(
+    'd', "dimension", "The dimension of the problem", true);
+
+auto& method = Base::register_argument<std::string>(
+    '\0', "method", "The time integration method, either 'CO2' or 'CO4'",
+    false, "CO2");
+
+auto& steps = Base::register_argument<std::size_t>(
+    '\0', "steps", "The number of time steps to take", false, 100);
+
+auto& tau = Base::register_argument<double>('\0', "tau", "The time step size",
+                                            false, 1e-3);
+
+auto& stab = Base::register_argument<double>(
+    '\0', "stab", "The stabilization parameter", false, 100);
+
+auto& snapshotFile = Base::register_argument<std::string>(
+    '\0', "snapshotFile",
+    "Stream the snapshots to this Tecplot file (one file per processor)",
+    false);
+
+auto& snapshotStride = Base::register_argument<std::size_t>(
+    '\0', "snapshotStride",
+    "The number of time steps between snapshots, by default only the initial "
+    "and final snapshot are taken",
+    false);
+
+template <std::size_t DIM>
+void runWithDimension();
+
+int main(int argc, char** argv) {
+    Base::parse_options(argc, argv);
+    initDGMaxLogging();
+    DGMax::printArguments(argc, argv);
+
+    switch (d.getValue()) {
+        case 2:
+            runWithDimension<2>();
+            break;
+        case 3:
+            runWithDimension<3>();
+            break;
+        default:
+            logger.assert_always(false, "Can only run with dimension 2 or 3");
+    }
+    return 0;
+}
+
+template <std::size_t DIM>
+void runWithDimension() {
+    TimeIntegrationParameters<DIM> parameters;
+    if (method.getValue() == "CO2") {
+        parameters.method = DGMaxTimeIntegration<DIM>::CO2;
+    } else if (method.getValue() == "CO4") {
+        parameters.method = DGMaxTimeIntegration<DIM>::CO4;
+    } else {
+        logger(ERROR, "Invalid method %, should be either CO2 or CO4",
+               method.getValue());
+        return;
+    }
+    parameters.stab = stab.getValue();
+    parameters.timeStepSize = tau.getValue();
+    parameters.numberOfSteps = steps.getValue();
+    // Only the initial and final snapshot, to measure the time stepping
+    parameters.snapshotStride = snapshotStride.isUsed()
+                                    ? snapshotStride.getValue()
+                                    : steps.getValue();
+
+    Base::ConfigurationData configData(1, 1);
+    auto mesh = DGMax::readMesh<DIM>(
+        meshFile.getValue(), &configData,
+        [](const Geometry::PointPhysical<DIM>& p) { return 1.0; });
+    logger(INFO, "Loaded mesh % with % local elements", meshFile.getValue(),
+           mesh->getNumberOfElements());
+
+    SampleTestProblems<DIM> problem(SampleTestProblems<DIM>::SINSIN);
+    DGMaxTimeIntegration<DIM> solver(*mesh, order.getValue());
+    if (snapshotFile.isUsed()) {
+        solver.addSnapshotSink(
+            std::make_shared<DGMax::TecplotSnapshotSink<DIM>>(
+                snapshotFile.getValue(), *mesh, solver.getDiscretization()));
+    }
+    // The solver reports the time per step and the bandwidth
+    solver.solve(problem, parameters);
+}
@@ -0,0 +1,240 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2020, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SnapshotStream.h"
+
+#include <cmath>
+#include <complex>
+#include <sstream>
+
+#include "Base/Element.h"
+#include "Base/MeshManipulator.h"
+#include "Base/MpiContainer.h"
+#include "Utilities/GlobalIndexing.h"
+
+namespace DGMax {
+
+LinearAlgebra::MiddleSizeVector Snapshot::elementCoefficients(
+    const Base::Element* element) const {
+    LinearAlgebra::MiddleSizeVector result(
+        element->getTotalNumberOfBasisFunctions());
+    std::size_t runningTotal = 0;
+    for (std::size_t unknown : indexing->getIncludedUnknowns()) {
+        // DGMax only uses basis functions local to the element
+        std::size_t numberOfBasisFunctions =
+            element->getLocalNumberOfBasisFunctions(unknown);
+        std::size_t start = indexing->getProcessorLocalIndex(element, unknown);
+        for (std::size_t i = 0; i < numberOfBasisFunctions; ++i) {
+            result[runningTotal++] = coefficients[start + i];
+        }
+    }
+    logger.assert_debug(runningTotal == result.size(),
+                        "Only element local basis functions are supported");
+    return result;
+}
+
+// SnapshotQueue //
+///////////////////
+
+SnapshotQueue::SnapshotQueue(std::vector<std::shared_ptr<SnapshotSink>> sinks,
+                             std::size_t capacity)
+    : sinks_(std::move(sinks)),
+      capacity_(std::max<std::size_t>(capacity, 1)),
+      closed_(false),
+      worker_(&SnapshotQueue::run, this) {}
+
+SnapshotQueue::~SnapshotQueue() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        notEmpty_.notify_all();
+        worker_.join();
+    }
+}
+
+void SnapshotQueue::push(Snapshot snapshot) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    logger.assert_always(!closed_, "Adding a snapshot to a closed queue");
+    notFull_.wait(lock, [this]() {
+        return queue_.size() < capacity_ || error_ != nullptr;
+    });
+    if (error_ != nullptr) {
+        // The worker stopped, the exception is rethrown by close()
+        return;
+    }
+    queue_.push_back(std::move(snapshot));
+    lock.unlock();
+    notEmpty_.notify_one();
+}
+
+void SnapshotQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    notEmpty_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    if (error_ != nullptr) {
+        std::rethrow_exception(error_);
+    }
+    for (auto& sink : sinks_) {
+        sink->finish();
+    }
+}
+
+void SnapshotQueue::run() {
+    while (true) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this]() { return !queue_.empty() || closed_; });
+        if (queue_.empty()) {
+            // Closed and everything has been consumed
+            return;
+        }
+        Snapshot snapshot = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        notFull_.notify_one();
+        try {
+            for (auto& sink : sinks_) {
+                sink->consume(snapshot);
+            }
+        } catch (...) {
+            lock.lock();
+            error_ = std::current_exception();
+            queue_.clear();
+            lock.unlock();
+            notFull_.notify_all();
+            return;
+        }
+    }
+}
+
+// TecplotSnapshotSink //
+/////////////////////////
+
+template <std::size_t DIM>
+TecplotSnapshotSink<DIM>::TecplotSnapshotSink(
+    std::string fileName, const Base::MeshManipulator<DIM>& mesh,
+    const DGMaxDiscretization<DIM>& discretization)
+    : mesh_(mesh), discretization_(discretization), firstZone_(true) {
+    Base::MPIContainer& mpiInstance = Base::MPIContainer::Instance();
+    if (mpiInstance.getNumberOfProcessors() > 1) {
+        fileName += "." + std::to_string(mpiInstance.getProcessorID());
+    }
+    output_.open(fileName);
+    logger.assert_always(output_.good(), "Could not open %", fileName);
+    std::string dimensions = DIM == 2 ? "01" : "012";
+    std::string variables = DIM == 2 ? "E0,E1,H0,H1" : "E0,E1,E2,H0,H1,H2";
+    writer_ = std::make_unique<Output::TecplotDiscontinuousSolutionWriter<DIM>>(
+        output_, "The electric field", dimensions, variables);
+}
+
+template <std::size_t DIM>
+void TecplotSnapshotSink<DIM>::consume(const Snapshot& snapshot) {
+    std::stringstream zoneName;
+    zoneName << "t=" << snapshot.time;
+    writer_->write(
+        &mesh_, zoneName.str(), !firstZone_,
+        [&](const Base::Element* element,
+            const Geometry::PointReference<DIM>& point, std::ostream& stream) {
+            const LinearAlgebra::MiddleSizeVector coefficients =
+                snapshot.elementCoefficients(element);
+            LinearAlgebra::SmallVector<DIM> electricField =
+                discretization_.computeField(element, point, coefficients);
+            LinearAlgebra::SmallVector<DIM> curlField =
+                discretization_.computeCurlField(element, point, coefficients);
+            for (std::size_t i = 0; i < DIM; ++i) {
+                stream << electricField[i] << " ";
+            }
+            for (std::size_t i = 0; i < DIM; ++i) {
+                stream << curlField[i] << (i + 1 < DIM ? " " : "\n");
+            }
+        });
+    firstZone_ = false;
+}
+
+// FourierSnapshotSink //
+/////////////////////////
+
+FourierSnapshotSink::FourierSnapshotSink(std::vector<double> frequencies)
+    : frequencies_(std::move(frequencies)),
+      transforms_(frequencies_.size()),
+      previousTime_(0),
+      hasPrevious_(false) {}
+
+void FourierSnapshotSink::consume(const Snapshot& snapshot) {
+    if (!hasPrevious_) {
+        for (auto& transform : transforms_) {
+            transform.assign(snapshot.coefficients.size(), 0.0);
+        }
+        previousCoefficients_ = snapshot.coefficients;
+        previousTime_ = snapshot.time;
+        hasPrevious_ = true;
+        return;
+    }
+    logger.assert_always(
+        previousCoefficients_.size() == snapshot.coefficients.size(),
+        "Snapshots of different sizes");
+    // Trapezoidal rule on [previousTime_, snapshot.time]
+    const double halfDt = 0.5 * (snapshot.time - previousTime_);
+    for (std::size_t f = 0; f < frequencies_.size(); ++f) {
+        const double previousPhase = -frequencies_[f] * previousTime_;
+        const double phase = -frequencies_[f] * snapshot.time;
+        const PetscScalar previousFactor =
+            halfDt * std::complex<double>(std::cos(previousPhase),
+                                          std::sin(previousPhase));
+        const PetscScalar factor =
+            halfDt * std::complex<double>(std::cos(phase), std::sin(phase));
+        std::vector<PetscScalar>& transform = transforms_[f];
+        for (std::size_t i = 0; i < transform.size(); ++i) {
+            transform[i] += previousFactor * previousCoefficients_[i] +
+                            factor * snapshot.coefficients[i];
+        }
+    }
+    previousCoefficients_ = snapshot.coefficients;
+    previousTime_ = snapshot.time;
+}
+
+template class TecplotSnapshotSink<2>;
+template class TecplotSnapshotSink<3>;
+
+}  // namespace DGMax
@@ -0,0 +1,184 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2020, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HPGEM_APP_SNAPSHOTSTREAM_H
+#define HPGEM_APP_SNAPSHOTSTREAM_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <petscsys.h>
+
+#include "LinearAlgebra/MiddleSizeVector.h"
+#include "Output/TecplotDiscontinuousSolutionWriter.h"
+
+#include "Algorithms/DGMaxDiscretization.h"
+
+namespace hpgem {
+namespace Base {
+class Element;
+}
+namespace Utilities {
+class GlobalIndexing;
+}
+}  // namespace hpgem
+
+namespace DGMax {
+
+using namespace hpgem;
+
+/// A copy of the processor local part of the solution at a single point in
+/// time.
+struct Snapshot {
+    /// Index of the snapshot in the sequence of snapshots
+    std::size_t index;
+    /// The time of the snapshot
+    double time;
+    /// The processor local part of the coefficient vector
+    std::vector<PetscScalar> coefficients;
+    /// The indexing used for the coefficients
+    const Utilities::GlobalIndexing* indexing;
+
+    /// The coefficients of a processor local element
+    LinearAlgebra::MiddleSizeVector elementCoefficients(
+        const Base::Element* element) const;
+};
+
+/// Consumer of a stream of snapshots from a time integration.
+class SnapshotSink {
+   public:
+    virtual ~SnapshotSink() = default;
+
+    /// Process a snapshot. This is called from a separate thread, in the order
+    /// of the snapshots, and thus should not communicate with other
+    /// processors.
+    virtual void consume(const Snapshot& snapshot) = 0;
+
+    /// Called on the main thread after the last snapshot is consumed, for
+    /// example to combine the results of all processors.
+    virtual void finish() {}
+};
+
+/// Bounded queue of snapshots that are passed to the sinks by a separate
+/// thread. Adding a snapshot only blocks when the queue is full, so that the
+/// memory usage is bounded independent of the number of snapshots.
+class SnapshotQueue {
+   public:
+    SnapshotQueue(std::vector<std::shared_ptr<SnapshotSink>> sinks,
+                  std::size_t capacity);
+    SnapshotQueue(const SnapshotQueue&) = delete;
+    SnapshotQueue& operator=(const SnapshotQueue&) = delete;
+    ~SnapshotQueue();
+
+    /// Add a snapshot, blocks while the queue is full.
+    void push(Snapshot snapshot);
+
+    /// Wait for all snapshots to be consumed and finish the sinks. Rethrows
+    /// any exception thrown by a sink.
+    void close();
+
+   private:
+    void run();
+
+    std::vector<std::shared_ptr<SnapshotSink>> sinks_;
+    std::size_t capacity_;
+    std::deque<Snapshot> queue_;
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    bool closed_;
+    std::exception_ptr error_;
+    std::thread worker_;
+};
+
+/// Sink writing the electric field and its curl of each snapshot as a zone in
+/// a Tecplot file, the streaming equivalent of
+/// DGMaxTimeIntegration::writeTimeSnapshots. With multiple processors each
+/// processor writes its own file, with the processor number appended.
+template <std::size_t DIM>
+class TecplotSnapshotSink : public SnapshotSink {
+   public:
+    TecplotSnapshotSink(std::string fileName,
+                        const Base::MeshManipulator<DIM>& mesh,
+                        const DGMaxDiscretization<DIM>& discretization);
+
+    void consume(const Snapshot& snapshot) override;
+
+   private:
+    std::ofstream output_;
+    std::unique_ptr<Output::TecplotDiscontinuousSolutionWriter<DIM>> writer_;
+    const Base::MeshManipulator<DIM>& mesh_;
+    const DGMaxDiscretization<DIM>& discretization_;
+    bool firstZone_;
+};
+
+/// Sink computing the Fourier transform
+///   E(omega) = int_{t_0}^{t_N} E(t) e^{-i omega t} dt
+/// of the coefficients for a set of frequencies while the snapshots are
+/// produced, so that no snapshots need to be stored. The integral is
+/// approximated with the trapezoidal rule over the snapshot times, which need
+/// not be equidistant. Only the previous snapshot is kept.
+class FourierSnapshotSink : public SnapshotSink {
+   public:
+    explicit FourierSnapshotSink(std::vector<double> frequencies);
+
+    void consume(const Snapshot& snapshot) override;
+
+    const std::vector<double>& getFrequencies() const { return frequencies_; }
+
+    /// The transformed processor local coefficients for a frequency
+    const std::vector<PetscScalar>& getTransform(std::size_t frequency) const {
+        return transforms_[frequency];
+    }
+
+   private:
+    std::vector<double> frequencies_;
+    std::vector<std::vector<PetscScalar>> transforms_;
+    std::vector<PetscScalar> previousCoefficients_;
+    double previousTime_;
+    bool hasPrevious_;
+};
+
+}  // namespace DGMax
+
+#endif  // HPGEM_APP_SNAPSHOTSTREAM_H
@@ -40,6 +40,7 @@
 #define HPGEM_APP_EULER_H
 
 #include "Base/HpgemAPISimplified.h"
+#include "RoeFluxBatch.h"
 
 using namespace hpgem;
 
@@ -91,32 +92,41 @@ class Euler : public Base::HpgemAPISimplified<DIM> {
         const LinearAlgebra::MiddleSizeVector &qReconstructionRight,
         LinearAlgebra::SmallVector<DIM> &normal);
 
-    /// \brief Compute the integrand for the right hand side for the reference
-    /// face corresponding to a boundary face.
-    LinearAlgebra::MiddleSizeVector integrandRightHandSideOnRefFace(
-        Base::PhysicalFace<DIM> &face, const double &time,
+    /// \brief Store the reflected and interior state and the normal at a
+    /// quadrature point of a boundary face in the face batch.
+    void gatherFaceState(
+        FaceStateBatch<DIM> &batch, Base::PhysicalFace<DIM> &face,
+        const std::size_t iPoint,
         const LinearAlgebra::MiddleSizeVector &solutionCoefficients);
 
-    /// \brief Compute the integrand for the right hand side for the reference
-    /// face corresponding to an internal face.
-    LinearAlgebra::MiddleSizeVector integrandRightHandSideOnRefFace(
-        Base::PhysicalFace<DIM> &face, const double &time,
-        const Base::Side &iSide,
+    /// \brief Store the left and right state and the normal at a quadrature
+    /// point of an internal face in the face batch.
+    void gatherFaceState(
+        FaceStateBatch<DIM> &batch, Base::PhysicalFace<DIM> &face,
+        const std::size_t iPoint,
         const LinearAlgebra::MiddleSizeVector &solutionCoefficientsLeft,
         const LinearAlgebra::MiddleSizeVector &solutionCoefficientsRight);
 
+    /// \brief Compute the integrand for the right hand side for the reference
+    /// face on side iSide, from the flux at point iPoint of the face batch.
+    LinearAlgebra::MiddleSizeVector integrandRightHandSideOnRefFace(
+        const FaceStateBatch<DIM> &batch, Base::PhysicalFace<DIM> &face,
+        const Base::Side &iSide, const std::size_t iPoint);
+
     /// \brief Compute the right-hand side corresponding to a boundary face
     LinearAlgebra::MiddleSizeVector computeRightHandSideAtFace(
         Base::Face *ptrFace,
         LinearAlgebra::MiddleSizeVector &solutionCoefficients,
         const double time) override final;
 
-    /// \brief Compute the right-hand side corresponding to an internal face
-    LinearAlgebra::MiddleSizeVector computeRightHandSideAtFace(
-        Base::Face *ptrFace, const Base::Side side,
-        LinearAlgebra::MiddleSizeVector &solutionCoefficientsLeft,
-        LinearAlgebra::MiddleSizeVector &solutionCoefficientsRight,
-        const double time) override final;
+    /// \brief Compute the right-hand sides of both elements adjacent to an
+    /// internal face, from a single evaluation of the Roe flux.
+    std::pair<LinearAlgebra::MiddleSizeVector, LinearAlgebra::MiddleSizeVector>
+        computeBothRightHandSidesAtFace(
+            Base::Face *ptrFace,
+            LinearAlgebra::MiddleSizeVector &solutionCoefficientsLeft,
+            LinearAlgebra::MiddleSizeVector &solutionCoefficientsRight,
+            const double time) override final;
 
     /// *****************************************
     /// ***    		Various Functions         ***
@@ -48,7 +48,7 @@ Euler<DIM>::Euler(
     const std::size_t polynomialOrder,
     const TimeIntegration::ButcherTableau *const ptrButcherTableau)
     : Base::HpgemAPISimplified<DIM>(numOfVariables, polynomialOrder,
-                                    ptrButcherTableau),
+                                    ptrButcherTableau, 1, true),
       numOfVariables_(numOfVariables) {}
 
 /// *****************************************
@@ -500,11 +500,12 @@ LinearAlgebra::MiddleSizeVector Euler<DIM>::RoeRiemannFluxFunction(
     return 0.5 * flux * area;
 }
 
-/// \brief Compute the integrand for the right hand side for the reference face
-/// corresponding to an external face.
+/// \brief Store the states and normal at a quadrature point of an external
+/// face in the face batch.
 template <std::size_t DIM>
-LinearAlgebra::MiddleSizeVector Euler<DIM>::integrandRightHandSideOnRefFace(
-    Base::PhysicalFace<DIM> &face, const double &time,
+void Euler<DIM>::gatherFaceState(
+    FaceStateBatch<DIM> &batch, Base::PhysicalFace<DIM> &face,
+    const std::size_t iPoint,
     const LinearAlgebra::MiddleSizeVector &solutionCoefficients) {
     // Get the number of basis functions
     std::size_t numOfBasisFunctionsLeft =
@@ -513,124 +514,92 @@ LinearAlgebra::MiddleSizeVector Euler<DIM>::integrandRightHandSideOnRefFace(
             ->getNumberOfBasisFunctions();  // Get the number of basis functions
                                             // on the left
 
-    LinearAlgebra::MiddleSizeVector &integrand = face.getResultVector();
-    LinearAlgebra::MiddleSizeVector qReconstructionLeft(numOfVariables_);
-    LinearAlgebra::MiddleSizeVector qReconstructionRight(numOfVariables_);
-
     // Compute the numerical solution at the given point.
     std::size_t jVB;  // Index for both variable and basis function.
     for (std::size_t jV = 0; jV < numOfVariables_; jV++) {
-        qReconstructionLeft(jV) = 0;
+        double qReconstructionLeft = 0;
         for (std::size_t jB = 0; jB < numOfBasisFunctionsLeft; jB++) {
             jVB = face.getFace()->getPtrElementLeft()->convertToSingleIndex(jB,
                                                                             jV);
-            qReconstructionLeft(jV) +=
-                face.basisFunction(Base::Side::LEFT, jB) *
-                solutionCoefficients(jVB);
+            qReconstructionLeft += face.basisFunction(Base::Side::LEFT, jB) *
+                                   solutionCoefficients(jVB);
         }
-    }
 
-    // Boundary face is assumed to be a solid wall: set reflective solution on
-    // the other side
-    qReconstructionRight(0) = qReconstructionLeft(0);
-    for (std::size_t iD = 0; iD < DIM; iD++) {
-        qReconstructionRight(iD + 1) = -qReconstructionLeft(iD + 1);
+        // Boundary face is assumed to be a solid wall: set reflective
+        // solution on the other side. Like before, the flux is computed with
+        // the reflected state on the left.
+        bool isMomentum = (jV > 0 && jV < DIM + 1);
+        batch.stateLeft[jV][iPoint] =
+            isMomentum ? -qReconstructionLeft : qReconstructionLeft;
+        batch.stateRight[jV][iPoint] = qReconstructionLeft;
     }
-    qReconstructionRight(DIM + 1) = qReconstructionLeft(DIM + 1);
 
     // Compute normal vector, with size of the ref-to-phys face scale, pointing
     // outward of the left element.
-    LinearAlgebra::SmallVector<DIM> normal = face.getNormalVector();
-
-    // Compute flux
-    // todo:RoeRiemannFluxFunction might benefit from features of PhysicalFace
-    LinearAlgebra::MiddleSizeVector flux = RoeRiemannFluxFunction(
-        qReconstructionRight, qReconstructionLeft, normal);
-
-    // todo: Other implementation is simply to put the flux to zero. No mass,
-    // momentum and energy should get out. This saves computational time
-
-    // Compute integrand on the reference element.
-    std::size_t iVB;  // Index for both variable and basis function.
-    for (std::size_t iB = 0; iB < numOfBasisFunctionsLeft; iB++) {
-        for (std::size_t iV = 0; iV < numOfVariables_;
-             iV++)  // Index for direction
-        {
-            iVB = face.getFace()->getPtrElementLeft()->convertToSingleIndex(iB,
-                                                                            iV);
-            integrand(iVB) =
-                -flux(iV) * face.basisFunction(Base::Side::LEFT, iB);
-        }
+    const LinearAlgebra::SmallVector<DIM> &normal = face.getNormalVector();
+    for (std::size_t iD = 0; iD < DIM; iD++) {
+        batch.normal[iD][iPoint] = normal(iD);
     }
-
-    return integrand;
 }
 
-/// \brief Compute the integrand for the right hand side for the reference face
-/// corresponding to an internal face.
+/// \brief Store the states and normal at a quadrature point of an internal
+/// face in the face batch.
 template <std::size_t DIM>
-LinearAlgebra::MiddleSizeVector Euler<DIM>::integrandRightHandSideOnRefFace(
-    Base::PhysicalFace<DIM> &face, const double &time, const Base::Side &iSide,
+void Euler<DIM>::gatherFaceState(
+    FaceStateBatch<DIM> &batch, Base::PhysicalFace<DIM> &face,
+    const std::size_t iPoint,
     const LinearAlgebra::MiddleSizeVector &solutionCoefficientsLeft,
     const LinearAlgebra::MiddleSizeVector &solutionCoefficientsRight) {
     // Get the number of basis functions
-    // todo: rewrite the below lines into neater synteax
-    std::size_t numOfTestBasisFunctions =
-        face.getFace()
-            ->getPtrElement(iSide)
-            ->getNumberOfBasisFunctions();  // Get the number of test basis
-                                            // functions on a given side, iSide
     std::size_t numOfSolutionBasisFunctionsLeft =
-        face.getFace()
-            ->getPtrElementLeft()
-            ->getNumberOfBasisFunctions();  // Get the number of basis functions
-                                            // on the left
+        face.getFace()->getPtrElementLeft()->getNumberOfBasisFunctions();
     std::size_t numOfSolutionBasisFunctionsRight =
-        face.getFace()
-            ->getPtrElementRight()
-            ->getNumberOfBasisFunctions();  // Get the number of basis functions
-                                            // on the right side
-
-    LinearAlgebra::MiddleSizeVector &integrand = face.getResultVector(iSide);
-    LinearAlgebra::MiddleSizeVector qReconstructionLeft(numOfVariables_);
-    LinearAlgebra::MiddleSizeVector qReconstructionRight(numOfVariables_);
+        face.getFace()->getPtrElementRight()->getNumberOfBasisFunctions();
 
     // Compute the numerical solution at the given point at the left and right
     // side.
     std::size_t jVB;  // Index for both variable and basis function.
     for (std::size_t jV = 0; jV < numOfVariables_; jV++) {
-        qReconstructionLeft(jV) = 0;
-        qReconstructionRight(jV) = 0;
+        double qReconstructionLeft = 0;
+        double qReconstructionRight = 0;
         for (std::size_t jB = 0; jB < numOfSolutionBasisFunctionsLeft; jB++) {
             jVB = face.getFace()->getPtrElementLeft()->convertToSingleIndex(jB,
                                                                             jV);
-            qReconstructionLeft(jV) +=
-                face.basisFunction(Base::Side::LEFT, jB) *
-                solutionCoefficientsLeft(jVB);
+            qReconstructionLeft += face.basisFunction(Base::Side::LEFT, jB) *
+                                   solutionCoefficientsLeft(jVB);
         }
         for (std::size_t jB = 0; jB < numOfSolutionBasisFunctionsRight; jB++) {
             jVB = face.getFace()->getPtrElementRight()->convertToSingleIndex(
                 jB, jV);
-            qReconstructionRight(jV) +=
-                face.basisFunction(Base::Side::RIGHT, jB) *
-                solutionCoefficientsRight(jVB);
+            qReconstructionRight += face.basisFunction(Base::Side::RIGHT, jB) *
+                                    solutionCoefficientsRight(jVB);
         }
+        batch.stateLeft[jV][iPoint] = qReconstructionLeft;
+        batch.stateRight[jV][iPoint] = qReconstructionRight;
     }
 
     // Compute normal vector, with size of the ref-to-phys face scale, pointing
     // outward of the left element.
-    LinearAlgebra::SmallVector<DIM> normal = face.getNormalVector();
-
-    // Compute flux
-    LinearAlgebra::MiddleSizeVector flux;
-    // todo:RoeRiemannFluxFunction might benefit from features of PhysicalFace
-    if (iSide == Base::Side::RIGHT) {
-        flux = -RoeRiemannFluxFunction(qReconstructionLeft,
-                                       qReconstructionRight, normal);
-    } else {
-        flux = RoeRiemannFluxFunction(qReconstructionLeft, qReconstructionRight,
-                                      normal);
+    const LinearAlgebra::SmallVector<DIM> &normal = face.getNormalVector();
+    for (std::size_t iD = 0; iD < DIM; iD++) {
+        batch.normal[iD][iPoint] = normal(iD);
     }
+}
+
+/// \brief Compute the integrand for the right hand side for the reference face
+/// at quadrature point iPoint, using the flux in the face batch.
+template <std::size_t DIM>
+LinearAlgebra::MiddleSizeVector Euler<DIM>::integrandRightHandSideOnRefFace(
+    const FaceStateBatch<DIM> &batch, Base::PhysicalFace<DIM> &face,
+    const Base::Side &iSide, const std::size_t iPoint) {
+    std::size_t numOfTestBasisFunctions =
+        face.getFace()->getPtrElement(iSide)->getNumberOfBasisFunctions();
+
+    LinearAlgebra::MiddleSizeVector &integrand = face.getResultVector(iSide);
+
+    // The flux is computed for the left element, it has the opposite sign for
+    // the right element.
+    const double sign = (iSide == Base::Side::RIGHT) ? -1.0 : 1.0;
 
     // Compute integrand on the reference element.
     std::size_t iVB;  // Index for both variable and basis function.
@@ -640,7 +609,8 @@ LinearAlgebra::MiddleSizeVector Euler<DIM>::integrandRightHandSideOnRefFace(
         {
             iVB = face.getFace()->getPtrElement(iSide)->convertToSingleIndex(
                 iB, iV);
-            integrand(iVB) = -flux(iV) * face.basisFunction(iSide, iB);
+            integrand(iVB) = -sign * batch.flux[iV][iPoint] *
+                             face.basisFunction(iSide, iB);
         }
     }
 
@@ -655,36 +625,52 @@ template <std::size_t DIM>
 LinearAlgebra::MiddleSizeVector Euler<DIM>::computeRightHandSideAtFace(
     Base::Face *ptrFace, LinearAlgebra::MiddleSizeVector &solutionCoefficients,
     const double time) {
-    // Define the integrand function for the right hand side for the reference
-    // face.
-    std::function<LinearAlgebra::MiddleSizeVector(Base::PhysicalFace<DIM> &
-                                                  face)>
-        integrandFunction = [&](Base::PhysicalFace<DIM> &face)
-        -> LinearAlgebra::MiddleSizeVector {
-        return this->integrandRightHandSideOnRefFace(face, time,
-                                                     solutionCoefficients);
-    };
-
-    return this->faceIntegrator_.integrate(ptrFace, integrandFunction);
+    // The batch is local, so that faces can be integrated concurrently
+    FaceStateBatch<DIM> batch;
+    batch.resize(ptrFace->getGaussQuadratureRule()->getNumberOfPoints());
+
+    // Collect the states at all quadrature points, compute the Roe flux for
+    // all of them at once and integrate the result.
+    return this->faceIntegrator_.integrateBatched(
+        ptrFace,
+        [&](Base::PhysicalFace<DIM> &face, std::size_t iPoint) {
+            gatherFaceState(batch, face, iPoint, solutionCoefficients);
+        },
+        [&](std::size_t) { computeRoeFluxBatch(batch, gamma_); },
+        [&](Base::PhysicalFace<DIM> &face, std::size_t iPoint)
+            -> LinearAlgebra::MiddleSizeVector {
+            return integrandRightHandSideOnRefFace(batch, face,
+                                                   Base::Side::LEFT, iPoint);
+        });
 }
 
-/// \brief Compute the right-hand side corresponding to an internal face
+/// \brief Compute the right-hand sides corresponding to an internal face. The
+/// Roe flux is computed once and used for both sides.
 template <std::size_t DIM>
-LinearAlgebra::MiddleSizeVector Euler<DIM>::computeRightHandSideAtFace(
-    Base::Face *ptrFace, const Base::Side side,
-    LinearAlgebra::MiddleSizeVector &solutionCoefficientsLeft,
-    LinearAlgebra::MiddleSizeVector &solutionCoefficientsRight,
-    const double time) {
-    // Define the integrand function for the right hand side for the reference
-    // face.
-    std::function<LinearAlgebra::MiddleSizeVector(Base::PhysicalFace<DIM> &)>
-        integrandFunction = [&](Base::PhysicalFace<DIM> &face)
-        -> LinearAlgebra::MiddleSizeVector {
-        return this->integrandRightHandSideOnRefFace(face, time, side,
-                                                     solutionCoefficientsLeft,
-                                                     solutionCoefficientsRight);
-    };
-    return this->faceIntegrator_.integrate(ptrFace, integrandFunction);
+std::pair<LinearAlgebra::MiddleSizeVector, LinearAlgebra::MiddleSizeVector>
+    Euler<DIM>::computeBothRightHandSidesAtFace(
+        Base::Face *ptrFace,
+        LinearAlgebra::MiddleSizeVector &solutionCoefficientsLeft,
+        LinearAlgebra::MiddleSizeVector &solutionCoefficientsRight,
+        const double /*time*/) {
+    FaceStateBatch<DIM> batch;
+    batch.resize(ptrFace->getGaussQuadratureRule()->getNumberOfPoints());
+
+    return this->faceIntegrator_.integratePairBatched(
+        ptrFace,
+        [&](Base::PhysicalFace<DIM> &face, std::size_t iPoint) {
+            gatherFaceState(batch, face, iPoint, solutionCoefficientsLeft,
+                            solutionCoefficientsRight);
+        },
+        [&](std::size_t) { computeRoeFluxBatch(batch, gamma_); },
+        [&](Base::PhysicalFace<DIM> &face, std::size_t iPoint)
+            -> std::pair<LinearAlgebra::MiddleSizeVector,
+                         LinearAlgebra::MiddleSizeVector> {
+            return {integrandRightHandSideOnRefFace(batch, face,
+                                                    Base::Side::LEFT, iPoint),
+                    integrandRightHandSideOnRefFace(batch, face,
+                                                    Base::Side::RIGHT, iPoint)};
+        });
 }
 
 /// *****************************************
@@ -0,0 +1,232 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPGEM_APP_ROEFLUXBATCH_H
+#define HPGEM_APP_ROEFLUXBATCH_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+/// Number of quadrature points for which the flux is computed together. Four
+/// doubles fill an AVX register, with SSE2 each lane loop takes two
+/// instructions.
+constexpr std::size_t ROE_FLUX_LANES = 4;
+
+/// \brief Left and right states and normals at all quadrature points of a face,
+/// stored per component (structure of arrays).
+///
+/// The normal is the one of PhysicalFace::getNormalVector, so its length is
+/// the reference-to-physical scaling of the face. The resulting normal flux is
+/// scaled with the same factor.
+template <std::size_t DIM>
+struct FaceStateBatch {
+    /// \brief Set the number of points; this only allocates when the batch
+    /// grows beyond the largest size used so far.
+    void resize(std::size_t numberOfPoints) {
+        for (std::size_t iV = 0; iV < DIM + 2; ++iV) {
+            stateLeft[iV].resize(numberOfPoints);
+            stateRight[iV].resize(numberOfPoints);
+            flux[iV].resize(numberOfPoints);
+        }
+        for (std::size_t iD = 0; iD < DIM; ++iD) {
+            normal[iD].resize(numberOfPoints);
+        }
+    }
+
+    std::size_t size() const { return flux[0].size(); }
+
+    std::array<std::vector<double>, DIM + 2> stateLeft;
+    std::array<std::vector<double>, DIM + 2> stateRight;
+    std::array<std::vector<double>, DIM> normal;
+    std::array<std::vector<double>, DIM + 2> flux;
+};
+
+/// \brief Compute the Roe Riemann flux for all points of the batch.
+///
+/// The points are processed in blocks of ROE_FLUX_LANES. Each block is copied
+/// to local lane arrays, and the flux is computed by loops over the lanes with
+/// a branch free body, which the compiler turns into SIMD instructions. The
+/// last block is padded by repeating its last point. This computes the same
+/// flux as Euler::RoeRiemannFluxFunction.
+template <std::size_t DIM>
+void computeRoeFluxBatch(FaceStateBatch<DIM> &batch, const double gamma) {
+    constexpr std::size_t NV = DIM + 2;
+    constexpr std::size_t L = ROE_FLUX_LANES;
+    const std::size_t numberOfPoints = batch.size();
+    const double epsilon = 0.01;
+
+    for (std::size_t start = 0; start < numberOfPoints; start += L) {
+        const std::size_t count = std::min(L, numberOfPoints - start);
+        double qL[NV][L], qR[NV][L], n[DIM][L], flux[NV][L];
+        for (std::size_t l = 0; l < L; ++l) {
+            std::size_t iP = start + std::min(l, count - 1);
+            for (std::size_t iV = 0; iV < NV; ++iV) {
+                qL[iV][l] = batch.stateLeft[iV][iP];
+                qR[iV][l] = batch.stateRight[iV][iP];
+            }
+            for (std::size_t iD = 0; iD < DIM; ++iD) {
+                n[iD][l] = batch.normal[iD][iP];
+            }
+        }
+
+        for (std::size_t l = 0; l < L; ++l) {
+            // Compute correct normal direction
+            double area = 0.0;
+            for (std::size_t iD = 0; iD < DIM; ++iD) {
+                area += n[iD][l] * n[iD][l];
+            }
+            area = std::sqrt(area);
+            double normal[DIM];
+            for (std::size_t iD = 0; iD < DIM; ++iD) {
+                normal[iD] = n[iD][l] / area;
+            }
+
+            // Compute the Roe average state
+            double qAverage[DIM + 1];
+            double zL = std::sqrt(qL[0][l]);
+            double zR = std::sqrt(qR[0][l]);
+            double tmp1 = 1.0 / (qL[0][l] + zL * zR);
+            double tmp2 = 1.0 / (qR[0][l] + zL * zR);
+            double rhoInverseLeft = 1.0 / qL[0][l];
+            double rhoInverseRight = 1.0 / qR[0][l];
+            double ruSquaredLeft = 0.0;
+            double ruSquaredRight = 0.0;
+            for (std::size_t iD = 0; iD < DIM; ++iD) {
+                qAverage[iD] = qL[iD + 1][l] * tmp1 + qR[iD + 1][l] * tmp2;
+                ruSquaredLeft += qL[iD + 1][l] * qL[iD + 1][l];
+                ruSquaredRight += qR[iD + 1][l] * qR[iD + 1][l];
+            }
+            double pressureLeft =
+                (gamma - 1) *
+                (qL[DIM + 1][l] - 0.5 * ruSquaredLeft * rhoInverseLeft);
+            double pressureRight =
+                (gamma - 1) *
+                (qR[DIM + 1][l] - 0.5 * ruSquaredRight * rhoInverseRight);
+            qAverage[DIM] = (qL[DIM + 1][l] + pressureLeft) * tmp1 +
+                            (qR[DIM + 1][l] + pressureRight) * tmp2;
+
+            double alphaAvg = 0.0;
+            double unAvg = 0.0;
+            for (std::size_t iD = 0; iD < DIM; ++iD) {
+                alphaAvg += qAverage[iD] * qAverage[iD];
+                unAvg += qAverage[iD] * normal[iD];
+            }
+            alphaAvg *= 0.5;
+
+            const double a2Avg =
+                std::abs((gamma - 1) * (qAverage[DIM] - alphaAvg));
+            const double aAvg = std::sqrt(a2Avg);
+            const double ovaAvg = 1.0 / aAvg;
+            const double ova2Avg = 1.0 / a2Avg;
+
+            // Eigenvalues with entropy correction, as selects instead of
+            // branches
+            double lam1 = std::abs(unAvg + aAvg);
+            double lam2 = std::abs(unAvg - aAvg);
+            double lam3 = std::abs(unAvg);
+            lam1 = lam1 < epsilon
+                       ? (lam1 * lam1 + epsilon * epsilon) / (2.0 * epsilon)
+                       : lam1;
+            lam2 = lam2 < epsilon
+                       ? (lam2 * lam2 + epsilon * epsilon) / (2.0 * epsilon)
+                       : lam2;
+            lam3 = lam3 < epsilon
+                       ? (lam3 * lam3 + epsilon * epsilon) / (2.0 * epsilon)
+                       : lam3;
+
+            const double abv1 = 0.5 * (lam1 + lam2);
+            const double abv2 = 0.5 * (lam1 - lam2);
+            const double abv3 = abv1 - lam3;
+
+            double qDifference[NV];
+            for (std::size_t iV = 0; iV < NV; ++iV) {
+                qDifference[iV] = qR[iV][l] - qL[iV][l];
+            }
+            double abv4 = alphaAvg * qDifference[0];
+            double abv5 = -unAvg * qDifference[0];
+            for (std::size_t iD = 0; iD < DIM; ++iD) {
+                abv4 += -qAverage[iD] * qDifference[iD + 1];
+                abv5 += normal[iD] * qDifference[iD + 1];
+            }
+            abv4 += qDifference[DIM + 1];
+            abv4 *= (gamma - 1);
+
+            const double abv6 = abv3 * abv4 * ova2Avg + abv2 * abv5 * ovaAvg;
+            const double abv7 = abv2 * abv4 * ovaAvg + abv3 * abv5;
+
+            double pLR = pressureLeft + pressureRight;
+            double runL = 0.0;
+            double runR = 0.0;
+            for (std::size_t iD = 0; iD < DIM; ++iD) {
+                runL += qL[iD + 1][l] * normal[iD];
+                runR += qR[iD + 1][l] * normal[iD];
+            }
+            double unL = runL * rhoInverseLeft;
+            double unR = runR * rhoInverseRight;
+
+            // The flux is computed twice, and the normal was scaled to unit
+            // length, hence the factor 0.5 * area
+            const double scale = 0.5 * area;
+            flux[0][l] =
+                scale * (runL + runR - (lam3 * qDifference[0] + abv6));
+            for (std::size_t iD = 0; iD < DIM; ++iD) {
+                flux[iD + 1][l] =
+                    scale * (runL * qL[iD + 1][l] * rhoInverseLeft +
+                             runR * qR[iD + 1][l] * rhoInverseRight +
+                             pLR * normal[iD] -
+                             (lam3 * qDifference[iD + 1] +
+                              qAverage[iD] * abv6 + normal[iD] * abv7));
+            }
+            flux[DIM + 1][l] =
+                scale * (unL * (qL[DIM + 1][l] + pressureLeft) +
+                         unR * (qR[DIM + 1][l] + pressureRight) -
+                         (lam3 * qDifference[DIM + 1] +
+                          qAverage[DIM] * abv6 + unAvg * abv7));
+        }
+
+        for (std::size_t iV = 0; iV < NV; ++iV) {
+            for (std::size_t l = 0; l < count; ++l) {
+                batch.flux[iV][start + l] = flux[iV][l];
+            }
+        }
+    }
+}
+
+#endif  // HPGEM_APP_ROEFLUXBATCH_H
@@ -0,0 +1,166 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures the throughput of the Roe Riemann solver of the Euler application,
+// in flux evaluations per second, for the pointwise implementation
+// (Euler::RoeRiemannFluxFunction) and for the batched implementation that is
+// used for the face integrals (computeRoeFluxBatch).
+
+#include "Euler.h"
+#include "Logger.h"
+#include <chrono>
+#include <random>
+
+using namespace hpgem;
+
+auto& dimension = Base::register_argument<std::size_t>(
+    'D', "dim", "number of dimensions in the problem", false, 2);
+auto& numberOfPoints = Base::register_argument<std::size_t>(
+    'P', "points", "number of quadrature points per face", false, 7);
+auto& numberOfFaces = Base::register_argument<std::size_t>(
+    'F', "faces", "number of faces (with random states) to evaluate", false,
+    10000);
+auto& numberOfRepeats = Base::register_argument<std::size_t>(
+    'r', "repeats", "number of times each face is evaluated", false, 20);
+
+template <std::size_t DIM>
+void doThings() {
+    const TimeIntegration::ButcherTableau* const ptrButcherTableau =
+        TimeIntegration::AllTimeIntegrators::Instance().getRule(2, 2, true);
+    Euler<DIM> euler(DIM + 2, 1.0, 1, ptrButcherTableau);
+    const double gamma = 1.4;
+
+    const std::size_t nPoints = numberOfPoints.getValue();
+    const std::size_t nFaces = numberOfFaces.getValue();
+    const std::size_t nRepeats = numberOfRepeats.getValue();
+
+    // Random states around the state of the Euler test problem, one batch per
+    // face.
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> perturbation(-0.2, 0.2);
+    std::vector<FaceStateBatch<DIM>> batches(nFaces);
+    for (FaceStateBatch<DIM>& batch : batches) {
+        batch.resize(nPoints);
+        for (std::size_t iP = 0; iP < nPoints; ++iP) {
+            batch.stateLeft[0][iP] = 1.5 + perturbation(generator);
+            batch.stateRight[0][iP] = 1.5 + perturbation(generator);
+            for (std::size_t iD = 0; iD < DIM; ++iD) {
+                batch.stateLeft[iD + 1][iP] = perturbation(generator);
+                batch.stateRight[iD + 1][iP] = perturbation(generator);
+                batch.normal[iD][iP] = perturbation(generator);
+            }
+            batch.normal[0][iP] += 1.0;
+            batch.stateLeft[DIM + 1][iP] = 30.0 + perturbation(generator);
+            batch.stateRight[DIM + 1][iP] = 30.0 + perturbation(generator);
+        }
+    }
+
+    // Pointwise solver, with the states in the vectors it expects
+    LinearAlgebra::MiddleSizeVector qLeft(DIM + 2), qRight(DIM + 2);
+    LinearAlgebra::SmallVector<DIM> normal;
+    std::vector<LinearAlgebra::MiddleSizeVector> pointwiseFlux(
+        nFaces * nPoints);
+    auto startClock = std::chrono::steady_clock::now();
+    for (std::size_t iR = 0; iR < nRepeats; ++iR) {
+        for (std::size_t iF = 0; iF < nFaces; ++iF) {
+            const FaceStateBatch<DIM>& batch = batches[iF];
+            for (std::size_t iP = 0; iP < nPoints; ++iP) {
+                for (std::size_t iV = 0; iV < DIM + 2; ++iV) {
+                    qLeft(iV) = batch.stateLeft[iV][iP];
+                    qRight(iV) = batch.stateRight[iV][iP];
+                }
+                for (std::size_t iD = 0; iD < DIM; ++iD) {
+                    normal(iD) = batch.normal[iD][iP];
+                }
+                pointwiseFlux[iF * nPoints + iP] =
+                    euler.RoeRiemannFluxFunction(qLeft, qRight, normal);
+            }
+        }
+    }
+    std::chrono::duration<double> pointwiseTime =
+        std::chrono::steady_clock::now() - startClock;
+
+    startClock = std::chrono::steady_clock::now();
+    for (std::size_t iR = 0; iR < nRepeats; ++iR) {
+        for (FaceStateBatch<DIM>& batch : batches) {
+            computeRoeFluxBatch(batch, gamma);
+        }
+    }
+    std::chrono::duration<double> batchedTime =
+        std::chrono::steady_clock::now() - startClock;
+
+    double maxDifference = 0.0;
+    for (std::size_t iF = 0; iF < nFaces; ++iF) {
+        for (std::size_t iP = 0; iP < nPoints; ++iP) {
+            for (std::size_t iV = 0; iV < DIM + 2; ++iV) {
+                maxDifference = std::max(
+                    maxDifference,
+                    std::abs(pointwiseFlux[iF * nPoints + iP](iV) -
+                             batches[iF].flux[iV][iP]));
+            }
+        }
+    }
+
+    const double evaluations = double(nRepeats * nFaces * nPoints);
+    logger(INFO, "Roe flux, % dimensions, % points per face", DIM, nPoints);
+    logger(INFO, "pointwise: % evaluations/s",
+           evaluations / pointwiseTime.count());
+    logger(INFO, "batched:   % evaluations/s (% lanes)",
+           evaluations / batchedTime.count(), ROE_FLUX_LANES);
+    logger(INFO, "maximum difference between the two: %", maxDifference);
+}
+
+int main(int argc, char** argv) {
+    Base::parse_options(argc, argv);
+
+    switch (dimension.getValue()) {
+        case 1:
+            doThings<1>();
+            break;
+        case 2:
+            doThings<2>();
+            break;
+        case 3:
+            doThings<3>();
+            break;
+        default:
+            logger(ERROR, "Only dimensions 1, 2 and 3 are supported");
+    }
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures the time it takes to construct the faces and edges of large meshes.
+// A small structured mesh is refined uniformly a number of times; every
+// refinement rebuilds the connectivity of the active mesh.
+
+#include "../../conf/cmake/CMakeDefinitions.h"
+#include "Base/CommandLineOptions.h"
+#include "Base/ConfigurationData.h"
+#include "Base/MeshManipulator.h"
+#include "Geometry/Mappings/RefinementMapsForCube.h"
+#include "Geometry/Mappings/RefinementMapsForSquare.h"
+#include "Logger.h"
+#include <chrono>
+
+using namespace hpgem;
+
+auto& dimension = Base::register_argument<std::size_t>(
+    'D', "dim", "number of dimensions of the mesh (2 or 3)", false, 3);
+auto& numberOfLevels = Base::register_argument<std::size_t>(
+    'l', "levels", "number of uniform refinements of the initial mesh", false,
+    4);
+
+template <std::size_t DIM>
+void refineUniformly(const Geometry::RefinementMapping* refinementMapping) {
+    using namespace std::string_literals;
+    Base::ConfigurationData config(1);
+    Base::MeshManipulator<DIM> mesh(&config);
+    mesh.readMesh(Base::getCMAKE_hpGEM_SOURCE_DIR() + "/tests/files/"s +
+                  std::to_string(DIM) + "Drectangular1mesh.hpgem"s);
+    for (std::size_t level = 1; level <= numberOfLevels.getValue(); ++level) {
+        auto start = std::chrono::steady_clock::now();
+        mesh.refine(refinementMapping);
+        std::chrono::duration<double> time =
+            std::chrono::steady_clock::now() - start;
+        logger(INFO,
+               "Level %: % elements, % faces, % edges, refinement took % s",
+               level, mesh.getNumberOfElements(), mesh.getNumberOfFaces(),
+               mesh.getNumberOfEdges(), time.count());
+    }
+}
+
+int main(int argc, char** argv) {
+    Base::parse_options(argc, argv);
+    switch (dimension.getValue()) {
+        case 2:
+            refineUniformly<2>(Geometry::RefinementMapForSquare3::instance());
+            break;
+        case 3:
+            // the eight-way split of a cube produces children whose faces
+            // cannot be matched, so split every cube into four instead
+            refineUniformly<3>(Geometry::RefinementMapForCube4::instance());
+            break;
+        default:
+            logger(ERROR, "Only meshes of dimension 2 and 3 are supported");
+    }
+    return 0;
+}
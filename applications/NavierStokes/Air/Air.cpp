@@ -522,7 +522,7 @@ LinearAlgebra::MiddleSizeVector Air::getExactSolution(
 // todo: add time
 LinearAlgebra::MiddleSizeVector Air::computeBoundaryState(
     Base::PhysicalFace<DIM> &face,
-    const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES> faceStateStuctLeft,
+    const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES> &faceStateStuctLeft,
     const double time) {
     const Geometry::PointPhysical<DIM> pPhys = face.getPointPhysical();
 
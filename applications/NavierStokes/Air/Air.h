@@ -89,7 +89,7 @@ class Air : public UnsteadyNavierStokesAPI<DIM, NUMBER_OF_VARIABLES> {
     LinearAlgebra::MiddleSizeVector computeBoundaryState(
         Base::PhysicalFace<DIM> &face,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            faceStateStuctLeft,
+            &faceStateStuctLeft,
         const double time) override final;
 
     /// \brief Output function. This fucntion gives the state as output, and
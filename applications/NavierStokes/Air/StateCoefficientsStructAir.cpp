@@ -73,7 +73,7 @@ StateCoefficientsStructAir::StateCoefficientsStructAir(
 // todo: NOTE viscosity is based on the stateJacobian, but it is not implemented
 // for this case(!) Not sure how to resolve this issue yet
 StateCoefficientsStructAir::StateCoefficientsStructAir(
-    const LinearAlgebra::MiddleSizeVector &stateBoundary, const double time)
+    const StateVector &stateBoundary, const double time)
     : StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>(stateBoundary, time)
 
 {
@@ -92,7 +92,7 @@ StateCoefficientsStructAir::~StateCoefficientsStructAir() {}
 /// ***************************************
 
 double StateCoefficientsStructAir::computePressure(
-    const LinearAlgebra::MiddleSizeVector &state) const {
+    const StateVector &state) const {
 
     // Compute the velocity components
     double velocitySquared = 0;
@@ -116,14 +116,14 @@ double StateCoefficientsStructAir::computePressure(
 }
 
 double StateCoefficientsStructAir::computeSpeedOfSound(
-    const LinearAlgebra::MiddleSizeVector &state, const double pressure) const {
+    const StateVector &state, const double pressure) const {
     return std::sqrt(GAMMA * pressure / state(0));
 }
 
-LinearAlgebra::MiddleSizeMatrix
+StateCoefficientsStructAir::FluxMatrix
     StateCoefficientsStructAir::computeHyperbolicMatrix(
-        const LinearAlgebra::MiddleSizeVector &state, const double pressure) {
-    LinearAlgebra::MiddleSizeMatrix fluxMatrix(NUMBER_OF_VARIABLES, DIM);
+        const StateVector &state, const double pressure) {
+    FluxMatrix fluxMatrix;
     double densityInverse = 1.0 / state(0);
 
     for (std::size_t iD = 0; iD < DIM; iD++) {
@@ -149,10 +149,8 @@ LinearAlgebra::MiddleSizeMatrix
 }
 
 double StateCoefficientsStructAir::computeViscosity(
-    const LinearAlgebra::MiddleSizeVector &state,
-    const LinearAlgebra::MiddleSizeVector &partialState,
-    const LinearAlgebra::MiddleSizeMatrix stateJacobian,
-    const double pressure) {
+    const StateVector &state, const StateVector &partialState,
+    const FluxMatrix &stateJacobian, const double pressure) {
     // todo: this temperature definition is bullshit, see FlowBetweenPlates
     double temperature = MACH * MACH * GAMMA * pressure / state(0);
 
@@ -175,15 +173,14 @@ double StateCoefficientsStructAir::computeViscosity(
                                // THETA_S)*std::pow(temperature,3.0/20);
 }
 
-std::vector<LinearAlgebra::MiddleSizeMatrix>
+StateCoefficientsStructAir::EllipticTensor
     StateCoefficientsStructAir::computeEllipticTensor(
-        const LinearAlgebra::MiddleSizeVector partialState,
-        const double viscosity) {
+        const StateVector &partialState, const double viscosity) {
     // todo: Check if this also works correctly in 3D
 
     // std::cout << "viscosity: " << viscosity << std::endl;
 
-    std::vector<LinearAlgebra::MiddleSizeMatrix> ellipticTensor_(DIM * DIM);
+    EllipticTensor ellipticTensor_;
     double velocityNormSquared = 0.0;
     double thermalFactor = GAMMA / (REYNOLDS * PRANDTL);
 
@@ -198,8 +195,10 @@ std::vector<LinearAlgebra::MiddleSizeMatrix>
         velocityNormSquared += partialState(iD + 1) * partialState(iD + 1);
     }
 
-    LinearAlgebra::MiddleSizeMatrix APartial1(DIM + 2, DIM + 2);
-    LinearAlgebra::MiddleSizeMatrix APartial2(DIM + 2, DIM + 2);
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, NUMBER_OF_VARIABLES>
+        APartial1;
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, NUMBER_OF_VARIABLES>
+        APartial2;
 
     // A11 A22 en A33: For documentation see the full matrix in Klaij et al.
     // 2006
@@ -297,10 +296,10 @@ std::vector<LinearAlgebra::MiddleSizeMatrix>
 /// ***      Additional Functions       ***
 /// ***************************************
 
-LinearAlgebra::MiddleSizeMatrix
+StateCoefficientsStructAir::FluxMatrix
     StateCoefficientsStructAir::computeEllipticTensorMatrixContractionFast(
-        const LinearAlgebra::MiddleSizeMatrix &matrix) const {
-    LinearAlgebra::MiddleSizeMatrix result(NUMBER_OF_VARIABLES, DIM);
+        const FluxMatrix &matrix) const {
+    FluxMatrix result;
     double pos;
 
     // A11 A22 and A33
@@ -59,9 +59,8 @@ class StateCoefficientsStructAir
         const LinearAlgebra::MiddleSizeVector &stateCoefficients,
         const Base::Side side, const double time);
 
-    StateCoefficientsStructAir(
-        const LinearAlgebra::MiddleSizeVector &stateBoundary,
-        const double time);
+    StateCoefficientsStructAir(const StateVector &stateBoundary,
+                               const double time);
 
     virtual ~StateCoefficientsStructAir();
 
@@ -69,31 +68,28 @@ class StateCoefficientsStructAir
     /// ***      Constutive relations       ***
     /// ***************************************
 
-    double computePressure(
-        const LinearAlgebra::MiddleSizeVector &state) const override final;
+    double computePressure(const StateVector &state) const override final;
 
-    double computeSpeedOfSound(const LinearAlgebra::MiddleSizeVector &state,
+    double computeSpeedOfSound(const StateVector &state,
                                const double pressure) const override final;
 
-    virtual LinearAlgebra::MiddleSizeMatrix computeHyperbolicMatrix(
-        const LinearAlgebra::MiddleSizeVector &state,
-        const double pressure) override final;
+    virtual FluxMatrix computeHyperbolicMatrix(
+        const StateVector &state, const double pressure) override final;
 
-    double computeViscosity(const LinearAlgebra::MiddleSizeVector &state,
-                            const LinearAlgebra::MiddleSizeVector &partialState,
-                            const LinearAlgebra::MiddleSizeMatrix stateJacobian,
+    double computeViscosity(const StateVector &state,
+                            const StateVector &partialState,
+                            const FluxMatrix &stateJacobian,
                             const double pressure) override final;
 
-    std::vector<LinearAlgebra::MiddleSizeMatrix> computeEllipticTensor(
-        const LinearAlgebra::MiddleSizeVector partialState,
-        const double viscosity) override final;
+    EllipticTensor computeEllipticTensor(const StateVector &partialState,
+                                         const double viscosity) override final;
 
     /// ***************************************
     /// ***      Additional Functions       ***
     /// ***************************************
 
-    LinearAlgebra::MiddleSizeMatrix computeEllipticTensorMatrixContractionFast(
-        const LinearAlgebra::MiddleSizeMatrix &matrix) const override final;
+    FluxMatrix computeEllipticTensorMatrixContractionFast(
+        const FluxMatrix &matrix) const override final;
 };
 
 #endif  // HPGEM_APP_STATECOEFFICIENTSSTRUCTAIR_H
@@ -67,30 +67,30 @@ class InviscidTerms {
     /// **************************************************
 
     /// \brief Compute the local Lax-Friedrichs flux
-    LinearAlgebra::MiddleSizeVector computeLLFFluxFunction(
-        const LinearAlgebra::MiddleSizeVector stateLeft,
-        const LinearAlgebra::MiddleSizeVector stateRight,
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> computeLLFFluxFunction(
+        const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateLeft,
+        const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateRight,
         const double pressureLeft, const double pressureRight,
         const LinearAlgebra::SmallVector<DIM> &unitNormalLeft);
 
     /// \brief Compute the local Lax-Friedrichs flux
-    LinearAlgebra::MiddleSizeVector computeLLFFluxFunction(
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> computeLLFFluxFunction(
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            faceStateStructLeft,
+            &faceStateStructLeft,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            faceStateStructRight,
+            &faceStateStructRight,
         const LinearAlgebra::SmallVector<DIM> &unitNormalLeft);
 
     /// \brief Compute the Roe Rieman flux
-    LinearAlgebra::MiddleSizeVector computeRoeFluxFunction(
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> computeRoeFluxFunction(
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            faceStateStructLeft,
+            &faceStateStructLeft,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            faceStateStructRight,
+            &faceStateStructRight,
         const LinearAlgebra::SmallVector<DIM> &unitNormalLeft);
 
     /// \brief Compute the HLLC Flux function, based on Klaij et al. 2006
-    LinearAlgebra::MiddleSizeVector computeHLLCFluxFunction(
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> computeHLLCFluxFunction(
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
             &faceStateStructLeft,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
@@ -69,7 +69,7 @@ LinearAlgebra::MiddleSizeVector
                       // basisfunction j
 
     // Compute the flux
-    LinearAlgebra::MiddleSizeMatrix fluxMatrix =
+    const LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> &fluxMatrix =
         elementStateStruct.getHyperbolicMatrix();
 
     // Compute the integrand for all equations
@@ -101,10 +101,10 @@ LinearAlgebra::MiddleSizeVector
 
 /// \brief Compute the local Lax-Friedrichs flux
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeVector
+LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES>
     InviscidTerms<DIM, NUMBER_OF_VARIABLES>::computeLLFFluxFunction(
-        const LinearAlgebra::MiddleSizeVector stateLeft,
-        const LinearAlgebra::MiddleSizeVector stateRight,
+        const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateLeft,
+        const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateRight,
         const double pressureLeft, const double pressureRight,
         const LinearAlgebra::SmallVector<DIM> &unitNormalLeft) {
     const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
@@ -137,10 +137,10 @@ LinearAlgebra::MiddleSizeVector
     double lMax = std::max(std::abs(waveSpeedLeft), std::abs(waveSpeedRight));
 
     // todo: remove this, temporary hack
-    LinearAlgebra::MiddleSizeMatrix fluxMatrixCombined =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxMatrixCombined =
         constitutiveRelations.computeHyperbolicMatrix(stateLeft, pressureLeft) +
         constitutiveRelations.computeHyperbolicMatrix(stateLeft, pressureLeft);
-    LinearAlgebra::MiddleSizeVector flux(NUMBER_OF_VARIABLES);
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> flux;
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
         for (std::size_t iD = 0; iD < DIM; iD++) {
             flux(iV) = fluxMatrixCombined(iV, iD) * unitNormalLeft(iD);
@@ -152,16 +152,17 @@ LinearAlgebra::MiddleSizeVector
 
 /// \brief Compute the local Lax-Friedrichs flux
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeVector
+LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES>
     InviscidTerms<DIM, NUMBER_OF_VARIABLES>::computeLLFFluxFunction(
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            faceStateStructLeft,
+            &faceStateStructLeft,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            faceStateStructRight,
+            &faceStateStructRight,
         const LinearAlgebra::SmallVector<DIM> &unitNormalLeft) {
     // For convenience:
-    LinearAlgebra::MiddleSizeVector stateLeft = faceStateStructLeft.getState();
-    LinearAlgebra::MiddleSizeVector stateRight =
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateLeft =
+        faceStateStructLeft.getState();
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateRight =
         faceStateStructRight.getState();
     double pressureLeft = faceStateStructLeft.getPressure();
     double pressureRight = faceStateStructRight.getPressure();
@@ -197,10 +198,10 @@ LinearAlgebra::MiddleSizeVector
     double lMax = std::max(std::abs(waveSpeedLeft), std::abs(waveSpeedRight));
 
     // todo: remove this, temporary hack
-    LinearAlgebra::MiddleSizeMatrix fluxMatrixCombined =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxMatrixCombined =
         faceStateStructLeft.getHyperbolicMatrix() +
         faceStateStructRight.getHyperbolicMatrix();
-    LinearAlgebra::MiddleSizeVector flux(NUMBER_OF_VARIABLES);
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> flux;
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
         for (std::size_t iD = 0; iD < DIM; iD++) {
             flux(iV) += fluxMatrixCombined(iV, iD) * unitNormalLeft(iD);
@@ -216,21 +217,23 @@ LinearAlgebra::MiddleSizeVector
 
 // Compute the Roe Riemann Flux function
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeVector
+LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES>
     InviscidTerms<DIM, NUMBER_OF_VARIABLES>::computeRoeFluxFunction(
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            faceStateStructLeft,
+            &faceStateStructLeft,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            faceStateStructRight,
+            &faceStateStructRight,
         const LinearAlgebra::SmallVector<DIM> &unitNormalLeft) {
     // Compute correct normal direction and difference vector
-    LinearAlgebra::MiddleSizeVector stateLeft = faceStateStructLeft.getState();
-    LinearAlgebra::MiddleSizeVector stateRight =
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateLeft =
+        faceStateStructLeft.getState();
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateRight =
         faceStateStructRight.getState();
-    LinearAlgebra::MiddleSizeVector stateDifference = stateRight - stateLeft;
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateDifference =
+        stateRight - stateLeft;
 
     // Compute the Roe average state
-    LinearAlgebra::MiddleSizeVector stateAverage(DIM + 1);
+    LinearAlgebra::SmallVector<DIM + 1> stateAverage;
     double zL = std::sqrt(stateLeft(0));
     double zR = std::sqrt(stateRight(0));
     double tmp1 = 1.0 / (stateLeft(0) + zL * zR);
@@ -315,7 +318,7 @@ LinearAlgebra::MiddleSizeVector
 
     // Compute the Roe Riemann Flux function: h(u_L,u_R) = 0.5*(F(u_L) + F(u_R)
     // - |A|(u_R - u_L))
-    LinearAlgebra::MiddleSizeVector flux(DIM + 2);
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> flux;
 
     double pLR = pressureLeft + pressureRight;
 
@@ -354,7 +357,7 @@ LinearAlgebra::MiddleSizeVector
 
 /// \brief Compute the HLLC Flux function, based on Klaij et al. 2006
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeVector
+LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES>
     InviscidTerms<DIM, NUMBER_OF_VARIABLES>::computeHLLCFluxFunction(
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
             &faceStateStructLeft,
@@ -362,8 +365,9 @@ LinearAlgebra::MiddleSizeVector
             &faceStateStructRight,
         const LinearAlgebra::SmallVector<DIM> &unitNormalLeft) {
     // For convenience:
-    LinearAlgebra::MiddleSizeVector stateLeft = faceStateStructLeft.getState();
-    LinearAlgebra::MiddleSizeVector stateRight =
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateLeft =
+        faceStateStructLeft.getState();
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateRight =
         faceStateStructRight.getState();
     double pressureLeft = faceStateStructLeft.getPressure();
     double pressureRight = faceStateStructRight.getPressure();
@@ -421,8 +425,8 @@ LinearAlgebra::MiddleSizeVector
     /// compute intermediate states
     double factorLeft = 1.0 / (waveSpeedLeft - waveSpeedMiddle);
     double factorRight = 1.0 / (waveSpeedRight - waveSpeedMiddle);
-    LinearAlgebra::MiddleSizeVector stateIntermediateLeft(NUMBER_OF_VARIABLES);
-    LinearAlgebra::MiddleSizeVector stateIntermediateRight(NUMBER_OF_VARIABLES);
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateIntermediateLeft;
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateIntermediateRight;
 
     // compute intermediate states: part 1
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
@@ -449,12 +453,12 @@ LinearAlgebra::MiddleSizeVector
         (pIntermediate * waveSpeedMiddle - pressureRight * normalSpeedRight);
 
     /// compute normalFluxLeft and normalFluxRight
-    LinearAlgebra::MiddleSizeMatrix fluxMatrixLeft =
+    const LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> &fluxMatrixLeft =
         faceStateStructLeft.getHyperbolicMatrix();
-    LinearAlgebra::MiddleSizeMatrix fluxMatrixRight =
-        faceStateStructRight.getHyperbolicMatrix();
-    LinearAlgebra::MiddleSizeVector normalFluxLeft(NUMBER_OF_VARIABLES);
-    LinearAlgebra::MiddleSizeVector normalFluxRight(NUMBER_OF_VARIABLES);
+    const LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+        &fluxMatrixRight = faceStateStructRight.getHyperbolicMatrix();
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> normalFluxLeft;
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> normalFluxRight;
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
         for (std::size_t iD = 0; iD < DIM; iD++) {
             normalFluxLeft(iV) += fluxMatrixLeft(iV, iD) * unitNormalLeft(iD);
@@ -463,9 +467,7 @@ LinearAlgebra::MiddleSizeVector
     }
 
     // compute flux function
-    LinearAlgebra::MiddleSizeVector fluxFunction(NUMBER_OF_VARIABLES);
-
-    fluxFunction =
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> fluxFunction =
         0.5 * (normalFluxLeft + normalFluxRight +
                (std::abs(waveSpeedMiddle) - std::abs(waveSpeedLeft)) *
                    stateIntermediateLeft +
@@ -501,14 +503,14 @@ LinearAlgebra::MiddleSizeVector
 
     // Compute the flux. Based on the type of boundary condition this is either
     // done exact, or using a flux function
-    LinearAlgebra::MiddleSizeVector flux(NUMBER_OF_VARIABLES);
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> flux;
     if (boundaryType == BoundaryType::FULL_STATE) {
         flux =
             computeRoeFluxFunction(faceStateStructLeft, faceStateStructBoundary,
                                    face.getUnitNormalVector());
     } else {
         // todo: move this part to a separate function
-        LinearAlgebra::MiddleSizeMatrix fluxMatrix =
+        const LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> &fluxMatrix =
             faceStateStructBoundary.getHyperbolicMatrix();
         for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
             for (std::size_t iD = 0; iD < DIM; iD++) {
@@ -567,8 +569,9 @@ std::pair<LinearAlgebra::MiddleSizeVector, LinearAlgebra::MiddleSizeVector>
     // Compute left flux
     LinearAlgebra::SmallVector<DIM> unitNormalLeft =
         face.getUnitNormalVector();  // todo: remove this line
-    LinearAlgebra::MiddleSizeVector flux = computeRoeFluxFunction(
-        faceStateStructLeft, faceStateStructRight, unitNormalLeft);
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> flux =
+        computeRoeFluxFunction(faceStateStructLeft, faceStateStructRight,
+                               unitNormalLeft);
 
     // Compute integrands
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES;
@@ -654,8 +657,9 @@ LinearAlgebra::MiddleSizeMatrix
     // computeFluxJacobian2D(elementStateFunctions.getState());
 
     // Compute the first stateflux
-    LinearAlgebra::MiddleSizeMatrix fluxFirst = computeFluxMatrix(
-        elementStateStruct.getState(), elementStateStruct.getPressure());
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxFirst =
+        computeFluxMatrix(elementStateStruct.getState(),
+                          elementStateStruct.getPressure());
 
     // compute the integrand matrix
     std::size_t iVB1, iVB2;
@@ -673,18 +677,18 @@ LinearAlgebra::MiddleSizeMatrix
                 elementStateStruct.getStateCoefficients();
             // add pertubation to the correct solutionCoefficient
             stateCoefficientsPerturb(iVB2) += EPSILON;
-            LinearAlgebra::MiddleSizeVector stateNew =
+            LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateNew =
                 computeStateOnElement<DIM, NUMBER_OF_VARIABLES>(
                     element, stateCoefficientsPerturb);
             double pressureNew = newState.computePressure(stateNew);
 
             // Compute new state flux
-            LinearAlgebra::MiddleSizeMatrix fluxSecond =
+            LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxSecond =
                 newState.computeHyperbolicMatrix(stateNew, pressureNew);
 
             // Compute the difference
-            LinearAlgebra::MiddleSizeMatrix fluxDifference =
-                (1.0 / EPSILON) * (fluxSecond - fluxFirst);
+            LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+                fluxDifference = (1.0 / EPSILON) * (fluxSecond - fluxFirst);
 
             for (std::size_t iV1 = 0; iV1 < NUMBER_OF_VARIABLES;
                  iV1++)  // This is the variable in the coefficient vector
@@ -741,7 +745,6 @@ LinearAlgebra::MiddleSizeMatrix
     LinearAlgebra::MiddleSizeMatrix integrand(
         NUMBER_OF_VARIABLES * numberOfBasisFunctionsElementSide,
         NUMBER_OF_VARIABLES * numberOfBasisFunctionsDerivativeSide);
-    LinearAlgebra::MiddleSizeVector jacobianFluxFunction(NUMBER_OF_VARIABLES);
     StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES> newState;
 
     // compute the integrand matrix
@@ -759,10 +762,12 @@ LinearAlgebra::MiddleSizeMatrix
     }
 
     // Compute the first flux function
-    LinearAlgebra::MiddleSizeVector fluxFirst = computeLLFFluxFunction(
-        faceStateStructLeft, faceStateStructRight.getState(),
-        faceStateStructLeft.getPressure(), faceStateStructRight.getPressure(),
-        face.getUnitNormalVector());
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> fluxFirst =
+        computeLLFFluxFunction(faceStateStructLeft.getState(),
+                               faceStateStructRight.getState(),
+                               faceStateStructLeft.getPressure(),
+                               faceStateStructRight.getPressure(),
+                               face.getUnitNormalVector());
     // First two for loops compute the derivative of the flux function with
     // respect to iVB2 Second two loops computes the integrand matrix
     for (std::size_t iV2 = 0; iV2 < NUMBER_OF_VARIABLES;
@@ -777,8 +782,9 @@ LinearAlgebra::MiddleSizeMatrix
                        .convertToSingleIndex(iB2, iV2);
             // Compute new perturbed state and flux
             LinearAlgebra::MiddleSizeVector solutionCoefficientsPerturb;
-            LinearAlgebra::MiddleSizeVector fluxSecond;
-            LinearAlgebra::MiddleSizeVector stateLeftNew, stateRightNew;
+            LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> fluxSecond;
+            LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateLeftNew,
+                stateRightNew;
             if (derivativeSide == Base::Side::LEFT) {
                 solutionCoefficientsPerturb =
                     faceStateStructLeft.getStateCoefficients();
@@ -806,7 +812,7 @@ LinearAlgebra::MiddleSizeMatrix
             }
 
             // Compute the difference
-            LinearAlgebra::MiddleSizeVector differenceFlux =
+            LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> differenceFlux =
                 (fluxSecond - fluxFirst) / EPSILON;
             // Now compute the normal integrand, with the correct derivative
             // flux function
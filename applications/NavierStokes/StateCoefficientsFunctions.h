@@ -43,6 +43,9 @@
 #include "Base/PhysicalFace.h"
 #include "LinearAlgebra/MiddleSizeVector.h"
 #include "LinearAlgebra/MiddleSizeMatrix.h"
+#include "LinearAlgebra/SmallVector.h"
+#include "LinearAlgebra/SmallMatrix.h"
+#include <array>
 
 using namespace hpgem;
 
@@ -53,11 +56,11 @@ using namespace hpgem;
 /// calculation \brief Compute state at an element
 
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeVector computeStateOnElement(
+LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> computeStateOnElement(
     Base::PhysicalElement<DIM> &element,
     const LinearAlgebra::MiddleSizeVector &stateCoefficients) {
     std::size_t numberOfBasisFunctions = element.getNumOfBasisFunctions();
-    LinearAlgebra::MiddleSizeVector elementState(NUMBER_OF_VARIABLES);
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> elementState;
     std::size_t iVB;  // Index in state coefficients for variable i and
                       // basisfunction j
     // todo: check if this function can be made more efficient
@@ -75,14 +78,15 @@ LinearAlgebra::MiddleSizeVector computeStateOnElement(
 
 /// \brief Compute state derivatives at an element.
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix computeStateJacobianAtElement(
+LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+    computeStateJacobianAtElement(
     Base::PhysicalElement<DIM> &element,
     const LinearAlgebra::MiddleSizeVector &stateCoefficients) {
     std::size_t numberOfBasisFunctions = element.getNumOfBasisFunctions();
     std::size_t iVB;  // Index in state coefficients for variable i and
                       // basisfunction j
 
-    LinearAlgebra::MiddleSizeMatrix stateJacobian(NUMBER_OF_VARIABLES, DIM);
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stateJacobian;
     LinearAlgebra::SmallVector<DIM> gradientBasisFunction;
 
     for (std::size_t iB = 0; iB < numberOfBasisFunctions; iB++) {
@@ -101,12 +105,12 @@ LinearAlgebra::MiddleSizeMatrix computeStateJacobianAtElement(
 
 /// \brief Compute state at a face
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeVector computeStateOnFace(
+LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> computeStateOnFace(
     Base::PhysicalFace<DIM> &face, const Base::Side &iSide,
     const LinearAlgebra::MiddleSizeVector &stateCoefficients) {
     std::size_t numOfBasisFunctions =
         face.getPhysicalElement(iSide).getNumOfBasisFunctions();
-    LinearAlgebra::MiddleSizeVector state(NUMBER_OF_VARIABLES);
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> state;
     std::size_t iVB;  // Index in solution coefficients for variable i and
                       // basisfunction j
 
@@ -126,7 +130,8 @@ LinearAlgebra::MiddleSizeVector computeStateOnFace(
 /// \brief Compute derivatives of the state with respect to the coordinates, at
 /// a face
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix computeStateJacobianAtFace(
+LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+    computeStateJacobianAtFace(
     Base::PhysicalFace<DIM> &face, const Base::Side &iSide,
     const LinearAlgebra::MiddleSizeVector &stateCoefficients) {
     std::size_t numberOfBasisFunctions =
@@ -134,7 +139,7 @@ LinearAlgebra::MiddleSizeMatrix computeStateJacobianAtFace(
     std::size_t iVB;  // Index in state coefficients for variable i and
                       // basisfunction j
 
-    LinearAlgebra::MiddleSizeMatrix stateJacobian(NUMBER_OF_VARIABLES, DIM);
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stateJacobian;
     LinearAlgebra::SmallVector<DIM> gradientBasisFunction;
 
     for (std::size_t iB = 0; iB < numberOfBasisFunctions; iB++) {
@@ -154,9 +159,9 @@ LinearAlgebra::MiddleSizeMatrix computeStateJacobianAtFace(
 /// \brief Computes the partial states: all states except the density are
 /// divided by the density
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeVector computePartialState(
-    const LinearAlgebra::MiddleSizeVector &state) {
-    LinearAlgebra::MiddleSizeVector partialState(NUMBER_OF_VARIABLES);
+LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> computePartialState(
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &state) {
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> partialState;
     double q1Inverse = 1.0 / state(0);
 
     partialState(0) = state(0);
@@ -174,11 +179,11 @@ LinearAlgebra::MiddleSizeVector computePartialState(
 
 /// \brief Computes the Jacobian of the velocity matrix
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix computeVelocityJacobian(
-    const LinearAlgebra::MiddleSizeVector &partialState,
-    const LinearAlgebra::MiddleSizeMatrix &stateJacobian) {
+LinearAlgebra::SmallMatrix<DIM, DIM> computeVelocityJacobian(
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &partialState,
+    const LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> &stateJacobian) {
 
-    LinearAlgebra::MiddleSizeMatrix velocityJacobian(DIM, DIM);
+    LinearAlgebra::SmallMatrix<DIM, DIM> velocityJacobian;
     // First put in the velocity Jacobian matrix L
     double inverseDensity = 1.0 / partialState(0);
     for (std::size_t iD1 = 0; iD1 < DIM; iD1++) {
@@ -196,12 +201,12 @@ LinearAlgebra::MiddleSizeMatrix computeVelocityJacobian(
 /// stateCoefficients. Implemented for efficiency reasons when calculating
 /// stabilityparameters
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix computeStateOnFace(
+LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> computeStateOnFace(
     Base::PhysicalFace<DIM> &face, const Base::Side &iSide,
     const LinearAlgebra::MiddleSizeMatrix &stateCoefficients) {
     std::size_t numOfBasisFunctions =
         face.getPhysicalElement(iSide).getNumOfBasisFunctions();
-    LinearAlgebra::MiddleSizeMatrix state(NUMBER_OF_VARIABLES, DIM);
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> state;
     std::size_t iVB;  // Index in solution coefficients for variable i and
                       // basisfunction j
 
@@ -229,10 +234,13 @@ LinearAlgebra::MiddleSizeMatrix computeStateOnFace(
 // This is a naive implementation, but can be used for debugging fast
 // implementations
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix computeEllipticTensorMatrixContraction(
-    const std::vector<LinearAlgebra::MiddleSizeMatrix> &ellipticTensor,
-    const LinearAlgebra::MiddleSizeMatrix &matrix) {
-    LinearAlgebra::MiddleSizeMatrix result(NUMBER_OF_VARIABLES, DIM);
+LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+    computeEllipticTensorMatrixContraction(
+        const std::array<LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES,
+                                                    NUMBER_OF_VARIABLES>,
+                         DIM * DIM> &ellipticTensor,
+        const LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> &matrix) {
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> result;
     double pos;
 
     for (std::size_t iD = 0; iD < DIM; iD++) {
@@ -43,17 +43,26 @@
 #include "Base/PhysicalFace.h"
 #include "LinearAlgebra/MiddleSizeVector.h"
 #include "LinearAlgebra/MiddleSizeMatrix.h"
+#include "LinearAlgebra/SmallVector.h"
+#include "LinearAlgebra/SmallMatrix.h"
 #include "StateCoefficientsFunctions.h"
-#include <vector>
+#include <array>
 #include <limits>
 
 using namespace hpgem;
 
-// todo: Optimise this code
-
+/// \brief All quantities at a single quadrature point. The point-wise
+/// containers have their sizes fixed at compile time, so that constructing a
+/// struct and evaluating the flux functions on it does not touch the heap.
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
 class StateCoefficientsStruct {
    public:
+    using StateVector = LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES>;
+    using FluxMatrix = LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>;
+    using EllipticTensor = std::array<
+        LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, NUMBER_OF_VARIABLES>,
+        DIM * DIM>;
+
     /// \brief Constructor to obtain constitutive relations
     StateCoefficientsStruct() {}
 
@@ -85,8 +94,7 @@ class StateCoefficientsStruct {
     }
 
     /// \brief Constructor for a given dirichlet boundary state
-    StateCoefficientsStruct(
-        const LinearAlgebra::MiddleSizeVector &stateBoundary, const double time)
+    StateCoefficientsStruct(const StateVector &stateBoundary, const double time)
         : state_(stateBoundary),
           partialState_(computePartialState<DIM, NUMBER_OF_VARIABLES>(state_)) {
     }
@@ -97,17 +105,15 @@ class StateCoefficientsStruct {
     /// ***      Constutive relations       ***
     /// ***************************************
 
-    virtual double computePressure(
-        const LinearAlgebra::MiddleSizeVector &state) const {
+    virtual double computePressure(const StateVector &state) const {
         logger(ERROR,
                "I want to compute the pressure, but I am not yet implemented!");
         double result = 15;
         return result;
     }
 
-    virtual double computeSpeedOfSound(
-        const LinearAlgebra::MiddleSizeVector &state,
-        const double pressure) const {
+    virtual double computeSpeedOfSound(const StateVector &state,
+                                       const double pressure) const {
         logger(ERROR,
                "I want to compute the speed of sound, but I am not yet "
                "implemented!");
@@ -115,20 +121,19 @@ class StateCoefficientsStruct {
         return result;
     }
 
-    virtual LinearAlgebra::MiddleSizeMatrix computeHyperbolicMatrix(
-        const LinearAlgebra::MiddleSizeVector &state, const double pressure) {
+    virtual FluxMatrix computeHyperbolicMatrix(const StateVector &state,
+                                               const double pressure) {
         logger(ERROR,
                "I want to compute the hyperbolic flux matrix, but I am not yet "
                "implemented!");
-        LinearAlgebra::MiddleSizeMatrix matrix;
+        FluxMatrix matrix;
         return matrix;
     }
 
-    virtual double computeViscosity(
-        const LinearAlgebra::MiddleSizeVector &state,
-        const LinearAlgebra::MiddleSizeVector &partialState,
-        const LinearAlgebra::MiddleSizeMatrix stateJacobian,
-        const double pressure) {
+    virtual double computeViscosity(const StateVector &state,
+                                    const StateVector &partialState,
+                                    const FluxMatrix &stateJacobian,
+                                    const double pressure) {
         logger(
             ERROR,
             "I want to compute the viscosity, but I am not yet implemented!");
@@ -136,13 +141,12 @@ class StateCoefficientsStruct {
         return viscosity;
     }
 
-    virtual std::vector<LinearAlgebra::MiddleSizeMatrix> computeEllipticTensor(
-        const LinearAlgebra::MiddleSizeVector partialState,
-        const double viscosity) {
+    virtual EllipticTensor computeEllipticTensor(
+        const StateVector &partialState, const double viscosity) {
         logger(ERROR,
                "I want to compute the elliptic tensor, but I am not yet "
                "implemented!");
-        std::vector<LinearAlgebra::MiddleSizeMatrix> ellipticTensor;
+        EllipticTensor ellipticTensor;
         return ellipticTensor;
     }
 
@@ -152,9 +156,8 @@ class StateCoefficientsStruct {
 
     // Note: This is a naive implementation of the elliptic tensor matrix times
     // matrix computation. You can specify your own, faster one in the class.
-    virtual LinearAlgebra::MiddleSizeMatrix
-        computeEllipticTensorMatrixContractionFast(
-            const LinearAlgebra::MiddleSizeMatrix &matrix) const {
+    virtual FluxMatrix computeEllipticTensorMatrixContractionFast(
+        const FluxMatrix &matrix) const {
         return computeEllipticTensorMatrixContraction<DIM, NUMBER_OF_VARIABLES>(
             ellipticTensor_, matrix);
     }
@@ -163,19 +166,15 @@ class StateCoefficientsStruct {
     /// ***      Get Functions       ***
     /// ********************************
 
-    LinearAlgebra::MiddleSizeVector getStateCoefficients() const {
+    const LinearAlgebra::MiddleSizeVector &getStateCoefficients() const {
         return stateCoefficients_;
     }
 
-    LinearAlgebra::MiddleSizeVector getState() const { return state_; }
+    const StateVector &getState() const { return state_; }
 
-    LinearAlgebra::MiddleSizeVector getPartialState() const {
-        return partialState_;
-    }
+    const StateVector &getPartialState() const { return partialState_; }
 
-    LinearAlgebra::MiddleSizeMatrix getStateJacobian() const {
-        return stateJacobian_;
-    }
+    const FluxMatrix &getStateJacobian() const { return stateJacobian_; }
 
     double getPressure() const { return pressure_; }
 
@@ -183,13 +182,9 @@ class StateCoefficientsStruct {
 
     double getViscosity() const { return viscosity_; }
 
-    LinearAlgebra::MiddleSizeMatrix getHyperbolicMatrix() const {
-        return hyperbolicMatrix_;
-    }
+    const FluxMatrix &getHyperbolicMatrix() const { return hyperbolicMatrix_; }
 
-    std::vector<LinearAlgebra::MiddleSizeMatrix> getEllipticTensor() const {
-        return ellipticTensor_;
-    }
+    const EllipticTensor &getEllipticTensor() const { return ellipticTensor_; }
 
    protected:
     /// \brief This contains the solutionCoefficients where all other structures
@@ -197,17 +192,17 @@ class StateCoefficientsStruct {
     LinearAlgebra::MiddleSizeVector stateCoefficients_;
 
     /// \brief This is the state at the given point of the element
-    LinearAlgebra::MiddleSizeVector state_;
+    StateVector state_;
 
     /// \brief The statejacobian is the derivative of the states with respect to
     /// the coordinate system. i.e. the first row is d/dx rho(x,y), d/dy
     /// rho(x,y)
-    LinearAlgebra::MiddleSizeMatrix stateJacobian_;
+    FluxMatrix stateJacobian_;
 
     /// \brief This is the partial state at the given point of the element. By
     /// partial state all state variables except the density, is divided by the
     /// density (i.e. rho, u , v)
-    LinearAlgebra::MiddleSizeVector partialState_;
+    StateVector partialState_;
 
     /// \brief This is the pressure calculated from the constitutive relations,
     /// which is required to calculate the ellipticTensor
@@ -222,11 +217,11 @@ class StateCoefficientsStruct {
 
     /// \brief The hyperbolic matrix is used for the hyperbolic part of the
     /// Navier-Stokes equations.
-    LinearAlgebra::MiddleSizeMatrix hyperbolicMatrix_;
+    FluxMatrix hyperbolicMatrix_;
 
     /// \brief The elliptic tensor is used for the elliptic part of the
     /// Navier-Stokes equations.
-    std::vector<LinearAlgebra::MiddleSizeMatrix> ellipticTensor_;
+    EllipticTensor ellipticTensor_;
 };
 
 #endif  // HPGEM_APP_STATECOEFFICIENTSSTRUCT_H
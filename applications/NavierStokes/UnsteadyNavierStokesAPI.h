@@ -101,7 +101,7 @@ class UnsteadyNavierStokesAPI : public Base::HpgemAPISimplified<DIM> {
     virtual LinearAlgebra::MiddleSizeVector computeBoundaryState(
         Base::PhysicalFace<DIM> &face,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            faceStateStuctLeft,
+            &faceStateStuctLeft,
         const double time) {
         logger(ERROR,
                "No boundary condition specificied on an external boundary.");
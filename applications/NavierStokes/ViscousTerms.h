@@ -67,7 +67,7 @@ class ViscousTerms {
 
     /// \brief Computes the flux function for the auxilliary value at an
     /// external face
-    LinearAlgebra::MiddleSizeMatrix fluxAuxilliaryBoundary(
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxAuxilliaryBoundary(
         Base::PhysicalFace<DIM> &face,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
             &faceStateStructBoundary,
@@ -100,18 +100,19 @@ class ViscousTerms {
 
     /// \brief Computes the fluxFunction in the stability parameter calculation
     /// used for the integrand
-    LinearAlgebra::MiddleSizeMatrix fluxStabilityParameters(
-        const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
-            &faceStateStructBoundary,
-        const LinearAlgebra::MiddleSizeVector &stateLeft,
-        const LinearAlgebra::SmallVector<DIM> &normalInternal);
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+        fluxStabilityParameters(
+            const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
+                &faceStateStructBoundary,
+            const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateLeft,
+            const LinearAlgebra::SmallVector<DIM> &normalInternal);
 
     /// \brief Computes the integrand required for the stability parameter
     /// calculations
     LinearAlgebra::MiddleSizeMatrix
         integrandStabilityRightHandSideOnBoundaryFace(
             Base::PhysicalFace<DIM> &face,
-            const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
+            const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
             const double time);
 
     /// \brief Computes the rhs, for the system of equations solving the
@@ -119,15 +120,16 @@ class ViscousTerms {
     /// integrand
     LinearAlgebra::MiddleSizeMatrix computeRhsStabilityParametersBoundary(
         const Base::Face *ptrFace,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
         const double time);
 
     /// \brief Computes the stability parameters used in the auxilliary
     /// integrand for an internal face for given stabilityParameterflux
-    LinearAlgebra::MiddleSizeMatrix computeStabilityParametersBoundary(
-        Base::PhysicalFace<DIM> &face,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
-        const double time);
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+        computeStabilityParametersBoundary(
+            Base::PhysicalFace<DIM> &face,
+            const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
+            const double time);
 
     /// **************************************************
     /// ***    Internal face integration functions     ***
@@ -135,7 +137,7 @@ class ViscousTerms {
 
     /// \brief Computes the fluxFunction for the auxilliary values at an
     /// internal face
-    LinearAlgebra::MiddleSizeMatrix fluxAuxilliary(
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxAuxilliary(
         Base::PhysicalFace<DIM> &face,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
             &faceStateStructLeft,
@@ -170,18 +172,22 @@ class ViscousTerms {
 
     /// \brief Computes the fluxFunction in the stability parameter calculation
     /// used for the integrand
-    LinearAlgebra::MiddleSizeMatrix fluxStabilityParameters(
-        const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES> faceStateStruct,
-        const LinearAlgebra::MiddleSizeVector &stateInternal,
-        const LinearAlgebra::MiddleSizeVector &stateExternal,
-        const LinearAlgebra::SmallVector<DIM> &normalInternal);
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+        fluxStabilityParameters(
+            const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
+                &faceStateStruct,
+            const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES>
+                &stateInternal,
+            const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES>
+                &stateExternal,
+            const LinearAlgebra::SmallVector<DIM> &normalInternal);
 
     /// \brief Computes the integrand required for the stability parameter
     /// calculations
     LinearAlgebra::MiddleSizeMatrix integrandStabilityRightHandSideOnFace(
         Base::PhysicalFace<DIM> &face,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsRight,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsRight,
         const Base::Side &side);
 
     /// \brief Computes the rhs, for the system of equations solving the
@@ -189,16 +195,17 @@ class ViscousTerms {
     /// integrand
     LinearAlgebra::MiddleSizeMatrix computeRhsStabilityParameters(
         const Base::Face *ptrFace,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsRight,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsRight,
         const Base::Side &side);
 
     /// \brief Computes the stability parameters used in the auxilliary
     /// integrand for an internal face for given stabilityParameterflux
-    LinearAlgebra::MiddleSizeMatrix computeStabilityParameters(
-        Base::PhysicalFace<DIM> &face,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsRight);
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+        computeStabilityParameters(
+            Base::PhysicalFace<DIM> &face,
+            const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
+            const LinearAlgebra::MiddleSizeVector &stateCoefficientsRight);
 
     /// \brief Sets the mass matrix used in the computation of the stability
     /// parameters
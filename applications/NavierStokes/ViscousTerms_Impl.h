@@ -62,7 +62,7 @@ LinearAlgebra::MiddleSizeVector
     std::size_t iVB;
 
     // Calculate flux function
-    LinearAlgebra::MiddleSizeMatrix fluxFunction =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxFunction =
         elementStateStruct.computeEllipticTensorMatrixContractionFast(
             elementStateStruct.getStateJacobian());
 
@@ -97,7 +97,7 @@ LinearAlgebra::MiddleSizeVector
 /// \brief Computes the flux function for the auxilliary value at an external
 /// face
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix
+LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
     ViscousTerms<DIM, NUMBER_OF_VARIABLES>::fluxAuxilliaryBoundary(
         Base::PhysicalFace<DIM> &face,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
@@ -105,11 +105,11 @@ LinearAlgebra::MiddleSizeMatrix
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
             &faceStateStructLeft,
         const double &time) {
-    LinearAlgebra::MiddleSizeMatrix fluxBoundary =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxBoundary =
         faceStateStructBoundary.computeEllipticTensorMatrixContractionFast(
             faceStateStructLeft.getStateJacobian());
-    LinearAlgebra::MiddleSizeMatrix stabilityParametersBoundary =
-        computeStabilityParametersBoundary(
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+        stabilityParametersBoundary = computeStabilityParametersBoundary(
             face, faceStateStructLeft.getStateCoefficients(), time);
 
     // std::cout << "fluxBoundary: " << fluxBoundary << std::endl;
@@ -139,12 +139,12 @@ LinearAlgebra::MiddleSizeVector
 
     // Compute Left flux
     // note: left flux is the same as the right flux
-    LinearAlgebra::MiddleSizeMatrix fluxFunctionBoundary =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxFunctionBoundary =
         fluxAuxilliaryBoundary(face, faceStateStructBoundary,
                                faceStateStructLeft, time);
 
     // Compute Left integrand
-    LinearAlgebra::MiddleSizeVector partialIntegrand(NUMBER_OF_VARIABLES);
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> partialIntegrand;
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
         for (std::size_t iD = 0; iD < DIM; iD++) {
             partialIntegrand(iV) +=
@@ -197,9 +197,8 @@ LinearAlgebra::MiddleSizeVector
     // Compute state times normal matrix for the Left face, this is the same as
     // for the Right side todo: move this to the StateCoefficientsFunctions
     // class
-    LinearAlgebra::MiddleSizeMatrix stateNormalBoundary(NUMBER_OF_VARIABLES,
-                                                        DIM);
-    LinearAlgebra::MiddleSizeMatrix stateNormalLeft(NUMBER_OF_VARIABLES, DIM);
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stateNormalBoundary;
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stateNormalLeft;
     LinearAlgebra::SmallVector<DIM> unitNormalLeft = face.getUnitNormalVector();
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
         for (std::size_t iD = 0; iD < DIM; iD++) {
@@ -211,7 +210,7 @@ LinearAlgebra::MiddleSizeVector
     }
 
     // Compute flux
-    LinearAlgebra::MiddleSizeMatrix fluxBoundary =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxBoundary =
         faceStateStructLeft.computeEllipticTensorMatrixContractionFast(
             stateNormalLeft) -
         faceStateStructBoundary.computeEllipticTensorMatrixContractionFast(
@@ -260,15 +259,15 @@ LinearAlgebra::MiddleSizeVector
 /// \brief Computes the fluxFunction in the stability parameter calculation used
 /// for the integrand
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix
+LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
     ViscousTerms<DIM, NUMBER_OF_VARIABLES>::fluxStabilityParameters(
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
             &faceStateStructBoundary,
-        const LinearAlgebra::MiddleSizeVector &stateLeft,
+        const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateLeft,
         const LinearAlgebra::SmallVector<DIM> &normalInternal) {
     // Compute velocity normal matrix
-    LinearAlgebra::MiddleSizeMatrix stateNormal(NUMBER_OF_VARIABLES, DIM);
-    LinearAlgebra::MiddleSizeVector stateDifference =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stateNormal;
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateDifference =
         stateLeft - faceStateStructBoundary.getState();
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
         for (std::size_t iD = 0; iD < DIM; iD++) {
@@ -286,7 +285,7 @@ template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
 LinearAlgebra::MiddleSizeMatrix ViscousTerms<DIM, NUMBER_OF_VARIABLES>::
     integrandStabilityRightHandSideOnBoundaryFace(
         Base::PhysicalFace<DIM> &face,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
         const double time) {
     std::size_t numberOfBasisFunctions =
         face.getPhysicalElement(Base::Side::LEFT).getNumberOfBasisFunctions();
@@ -304,10 +303,10 @@ LinearAlgebra::MiddleSizeMatrix ViscousTerms<DIM, NUMBER_OF_VARIABLES>::
     const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
         faceStateStructBoundary =
             instance_->computeBoundaryFaceStateStruct(stateBoundary, time);
-    const LinearAlgebra::MiddleSizeVector stateLeft =
+    const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateLeft =
         computeStateOnFace<DIM, NUMBER_OF_VARIABLES>(face, Base::Side::LEFT,
                                                      stateCoefficientsLeft);
-    LinearAlgebra::MiddleSizeMatrix stabilityFluxFunction =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stabilityFluxFunction =
         fluxStabilityParameters(faceStateStructBoundary, stateLeft,
                                 face.getUnitNormalVector());
 
@@ -335,7 +334,7 @@ template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
 LinearAlgebra::MiddleSizeMatrix ViscousTerms<DIM, NUMBER_OF_VARIABLES>::
     computeRhsStabilityParametersBoundary(
         const Base::Face *ptrFace,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
         const double time) {
     std::function<LinearAlgebra::MiddleSizeMatrix(Base::PhysicalFace<DIM> &)>
         integrandFunction = [=](Base::PhysicalFace<DIM> &face)
@@ -349,10 +348,10 @@ LinearAlgebra::MiddleSizeMatrix ViscousTerms<DIM, NUMBER_OF_VARIABLES>::
 /// \brief Computes the stability parameters used in the auxilliary integrand
 /// for an internal face for given stabilityParameterflux
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix
+LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
     ViscousTerms<DIM, NUMBER_OF_VARIABLES>::computeStabilityParametersBoundary(
         Base::PhysicalFace<DIM> &face,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
         const double time) {
     // Datastructures
     std::size_t numberOfTestBasisFunctionsLeft =
@@ -378,24 +377,24 @@ LinearAlgebra::MiddleSizeMatrix
 /// \brief Computes the fluxFunction for the auxilliary values at an internal
 /// face
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix
+LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
     ViscousTerms<DIM, NUMBER_OF_VARIABLES>::fluxAuxilliary(
         Base::PhysicalFace<DIM> &face,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
             &faceStateStructLeft,
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
             &faceStateStructRight) {
-    LinearAlgebra::MiddleSizeMatrix fluxLeft =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxLeft =
         faceStateStructLeft.computeEllipticTensorMatrixContractionFast(
             faceStateStructLeft.getStateJacobian());
-    LinearAlgebra::MiddleSizeMatrix fluxRight =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxRight =
         faceStateStructRight.computeEllipticTensorMatrixContractionFast(
             faceStateStructRight.getStateJacobian());
 
     // std::cout << "stateJacobian" << faceStateStructLeft.getStateJacobian() <<
     // std::endl;
 
-    LinearAlgebra::MiddleSizeMatrix stabilityParameters =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stabilityParameters =
         computeStabilityParameters(face,
                                    faceStateStructLeft.getStateCoefficients(),
                                    faceStateStructRight.getStateCoefficients());
@@ -438,11 +437,11 @@ std::pair<LinearAlgebra::MiddleSizeVector, LinearAlgebra::MiddleSizeVector>
 
     // Compute Left flux
     // note: left flux is the same as the right flux
-    LinearAlgebra::MiddleSizeMatrix fluxFunctionLeft =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxFunctionLeft =
         fluxAuxilliary(face, faceStateStructLeft, faceStateStructRight);
 
     // Compute Left integrand
-    LinearAlgebra::MiddleSizeVector partialIntegrand(NUMBER_OF_VARIABLES);
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> partialIntegrand;
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
         for (std::size_t iD = 0; iD < DIM; iD++) {
             partialIntegrand(iV) +=
@@ -499,8 +498,8 @@ std::pair<LinearAlgebra::MiddleSizeVector, LinearAlgebra::MiddleSizeVector>
     // Compute state times normal matrix for the Left face, this is the same as
     // for the Right side todo: move this to the StateCoefficientsFunctions
     // class
-    LinearAlgebra::MiddleSizeMatrix stateNormalLeft(NUMBER_OF_VARIABLES, DIM);
-    LinearAlgebra::MiddleSizeVector stateDifferenceLeft;
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stateNormalLeft;
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateDifferenceLeft;
     stateDifferenceLeft =
         faceStateStructLeft.getState() - faceStateStructRight.getState();
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
@@ -511,12 +510,12 @@ std::pair<LinearAlgebra::MiddleSizeVector, LinearAlgebra::MiddleSizeVector>
     }
 
     // Compute fluxLeft
-    LinearAlgebra::MiddleSizeMatrix fluxLeft =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxLeft =
         faceStateStructLeft.computeEllipticTensorMatrixContractionFast(
             stateNormalLeft);
 
     // compute fluxRight
-    LinearAlgebra::MiddleSizeMatrix fluxRight =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxRight =
         faceStateStructLeft.computeEllipticTensorMatrixContractionFast(
             stateNormalLeft);
 
@@ -569,15 +568,16 @@ std::pair<LinearAlgebra::MiddleSizeVector, LinearAlgebra::MiddleSizeVector>
 /// \brief Computes the fluxFunction in the stability parameter calculation used
 /// for the integrand
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix
+LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
     ViscousTerms<DIM, NUMBER_OF_VARIABLES>::fluxStabilityParameters(
-        const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES> faceStateStruct,
-        const LinearAlgebra::MiddleSizeVector &stateInternal,
-        const LinearAlgebra::MiddleSizeVector &stateExternal,
+        const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
+            &faceStateStruct,
+        const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateInternal,
+        const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> &stateExternal,
         const LinearAlgebra::SmallVector<DIM> &normalInternal) {
     // Compute velocity normal matrix
-    LinearAlgebra::MiddleSizeMatrix stateNormal(NUMBER_OF_VARIABLES, DIM);
-    LinearAlgebra::MiddleSizeVector stateDifference =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stateNormal;
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateDifference =
         stateInternal - stateExternal;
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
         for (std::size_t iD = 0; iD < DIM; iD++) {
@@ -611,8 +611,8 @@ template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
 LinearAlgebra::MiddleSizeMatrix ViscousTerms<DIM, NUMBER_OF_VARIABLES>::
     integrandStabilityRightHandSideOnFace(
         Base::PhysicalFace<DIM> &face,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsRight,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsRight,
         const Base::Side &side) {
 
     std::size_t numberOfBasisFunctions =
@@ -622,7 +622,7 @@ LinearAlgebra::MiddleSizeMatrix ViscousTerms<DIM, NUMBER_OF_VARIABLES>::
         numberOfBasisFunctions * NUMBER_OF_VARIABLES, DIM);
 
     // compute stabilityFluxFunction
-    LinearAlgebra::MiddleSizeMatrix stabilityFluxFunction;
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stabilityFluxFunction;
     if (side == Base::Side::LEFT) {
         // From the given state coefficients, and coordinate in face, compute
         // the new StateStruct for the left side (Elliptic tensor is required)
@@ -631,7 +631,7 @@ LinearAlgebra::MiddleSizeMatrix ViscousTerms<DIM, NUMBER_OF_VARIABLES>::
                 face, stateCoefficientsLeft, Base::Side::LEFT, 0);
         // From the given state coefficients reconstruct the state on the right
         // side
-        const LinearAlgebra::MiddleSizeVector stateRight =
+        const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateRight =
             computeStateOnFace<DIM, NUMBER_OF_VARIABLES>(
                 face, Base::Side::RIGHT, stateCoefficientsRight);
         stabilityFluxFunction = fluxStabilityParameters(
@@ -641,7 +641,7 @@ LinearAlgebra::MiddleSizeMatrix ViscousTerms<DIM, NUMBER_OF_VARIABLES>::
         const StateCoefficientsStruct<DIM, NUMBER_OF_VARIABLES>
             faceStateStructRight = instance_->computeFaceStateStruct(
                 face, stateCoefficientsRight, Base::Side::RIGHT, 0);
-        const LinearAlgebra::MiddleSizeVector stateLeft =
+        const LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateLeft =
             computeStateOnFace<DIM, NUMBER_OF_VARIABLES>(face, Base::Side::LEFT,
                                                          stateCoefficientsLeft);
         stabilityFluxFunction = fluxStabilityParameters(
@@ -672,8 +672,8 @@ template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
 LinearAlgebra::MiddleSizeMatrix
     ViscousTerms<DIM, NUMBER_OF_VARIABLES>::computeRhsStabilityParameters(
         const Base::Face *ptrFace,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsRight,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsRight,
         const Base::Side &side) {
     std::function<LinearAlgebra::MiddleSizeMatrix(Base::PhysicalFace<DIM> &)>
         integrandFunction = [=](Base::PhysicalFace<DIM> &face)
@@ -687,11 +687,11 @@ LinearAlgebra::MiddleSizeMatrix
 /// \brief Computes the stability parameters used in the auxilliary integrand
 /// for an internal face for given stabilityParameterflux
 template <std::size_t DIM, std::size_t NUMBER_OF_VARIABLES>
-LinearAlgebra::MiddleSizeMatrix
+LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
     ViscousTerms<DIM, NUMBER_OF_VARIABLES>::computeStabilityParameters(
         Base::PhysicalFace<DIM> &face,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsLeft,
-        const LinearAlgebra::MiddleSizeVector stateCoefficientsRight) {
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsLeft,
+        const LinearAlgebra::MiddleSizeVector &stateCoefficientsRight) {
     // Datastructures
     std::size_t numberOfTestBasisFunctionsLeft =
         face.getPhysicalElement(Base::Side::LEFT).getNumberOfBasisFunctions();
@@ -818,10 +818,11 @@ LinearAlgebra::MiddleSizeMatrix
     LinearAlgebra::SmallVector<DIM> flux;
 
     // First flux function
-    LinearAlgebra::MiddleSizeMatrix fluxFunction =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxFunction =
         elementStateStruct.computeEllipticTensorMatrixContractionFast(
             elementStateStruct.getStateJacobian());
-    LinearAlgebra::MiddleSizeMatrix fluxFirst = fluxFunction;
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxFirst =
+        fluxFunction;
 
     // compute the integrand matrix
     std::size_t iVB1, iVB2;
@@ -842,14 +843,14 @@ LinearAlgebra::MiddleSizeMatrix
                 elementStateStructSecond(element, stateCoefficients, 0);
 
             // Compute second flux
-            LinearAlgebra::MiddleSizeMatrix fluxSecond =
+            LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxSecond =
                 elementStateStructSecond
                     .computeEllipticTensorMatrixContractionFast(
                         elementStateStructSecond.getStateJacobian());
 
             // Compute the difference
-            LinearAlgebra::MiddleSizeMatrix fluxFunctionDiv =
-                (1.0 / EPSILON) * (fluxSecond - fluxFirst);
+            LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+                fluxFunctionDiv = (1.0 / EPSILON) * (fluxSecond - fluxFirst);
 
             for (std::size_t iV1 = 0; iV1 < NUMBER_OF_VARIABLES;
                  iV1++)  // This is the variable in the coefficient vector
@@ -901,9 +902,9 @@ LinearAlgebra::MiddleSizeMatrix
     // Compute First Flux
     // todo: move this stateNormal function to StatecoefficientsFunctions or let
     // BLAS do it
-    LinearAlgebra::MiddleSizeMatrix fluxFirst;
-    LinearAlgebra::MiddleSizeMatrix stateNormalFirst(NUMBER_OF_VARIABLES, DIM);
-    LinearAlgebra::MiddleSizeVector stateDifferenceFirst =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxFirst;
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> stateNormalFirst;
+    LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES> stateDifferenceFirst =
         faceStateStructLeft.getState() - faceStateStructRight.getState();
     for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
         for (std::size_t iD = 0; iD < DIM; iD++) {
@@ -933,10 +934,11 @@ LinearAlgebra::MiddleSizeMatrix
             // Compute new state by perturbing one of the coefficients and
             // compute the second flux
             LinearAlgebra::MiddleSizeVector solutionCoefficientsPerturb;
-            LinearAlgebra::MiddleSizeMatrix fluxSecond;
-            LinearAlgebra::MiddleSizeMatrix stateNormalSecond(
-                NUMBER_OF_VARIABLES, DIM);
-            LinearAlgebra::MiddleSizeVector stateDifferenceSecond;
+            LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxSecond;
+            LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+                stateNormalSecond;
+            LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES>
+                stateDifferenceSecond;
             if (derivativeSide == Base::Side::LEFT) {
                 // Compute new state
                 solutionCoefficientsPerturb =
@@ -1006,8 +1008,8 @@ LinearAlgebra::MiddleSizeMatrix
             }
 
             // Compute fluxdifference
-            LinearAlgebra::MiddleSizeMatrix fluxDifference =
-                (1.0 / EPSILON) * (fluxSecond - fluxFirst);
+            LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+                fluxDifference = (1.0 / EPSILON) * (fluxSecond - fluxFirst);
 
             for (std::size_t iB1 = 0;
                  iB1 < numberOfBasisFunctionsDerivativeSide;
@@ -1056,7 +1058,7 @@ LinearAlgebra::MiddleSizeMatrix
     LinearAlgebra::SmallVector<DIM> unitNormalLeft = face.getUnitNormalVector();
 
     // Compute First Flux
-    LinearAlgebra::MiddleSizeMatrix fluxFunctionFirst =
+    LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM> fluxFunctionFirst =
         fluxAuxilliary(face, faceStateStructLeft, faceStateStructRight);
 
     // Flux sign, depending on the elementSide
@@ -1078,7 +1080,8 @@ LinearAlgebra::MiddleSizeMatrix
 
             // compute new state
             LinearAlgebra::MiddleSizeVector solutionCoefficientsPerturb;
-            LinearAlgebra::MiddleSizeMatrix fluxFunctionSecond;
+            LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+                fluxFunctionSecond;
             if (derivativeSide == Base::Side::LEFT) {
                 solutionCoefficientsPerturb =
                     faceStateStructLeft.getStateCoefficients();
@@ -1102,14 +1105,15 @@ LinearAlgebra::MiddleSizeMatrix
             }
 
             // Compute fluxdifference
-            LinearAlgebra::MiddleSizeMatrix fluxFunctionDifference =
-                (1.0 / EPSILON) * (fluxFunctionSecond - fluxFunctionFirst);
+            LinearAlgebra::SmallMatrix<NUMBER_OF_VARIABLES, DIM>
+                fluxFunctionDifference =
+                    (1.0 / EPSILON) * (fluxFunctionSecond - fluxFunctionFirst);
 
             // Compute partial integrand second
             // todo: this is a simple matrix vector multiplciation: let BLAS do
             // it
-            LinearAlgebra::MiddleSizeVector partialIntegrandDifference(
-                NUMBER_OF_VARIABLES);
+            LinearAlgebra::SmallVector<NUMBER_OF_VARIABLES>
+                partialIntegrandDifference;
             for (std::size_t iV = 0; iV < NUMBER_OF_VARIABLES; iV++) {
                 for (std::size_t iD = 0; iD < DIM; iD++) {
                     partialIntegrandDifference(iV) +=
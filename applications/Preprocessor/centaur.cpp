@@ -37,9 +37,12 @@
  */
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <limits>
 
 #include "centaur.h"
+#include "parallel.h"
 #include "Logger.h"
 
 using namespace hpgem;
@@ -112,90 +115,32 @@ CentaurReader::CentaurReader(std::string filename) {
     readNodeConnections();
 }
 
-std::function<void(int&)> difference_generator(
-    const std::vector<std::size_t>& input) {
-    std::size_t i = 1;
-    return [=](int& result) mutable {
-        result = static_cast<long long>(input[i + 1]) -
-                 static_cast<long long>(input[i]);
-        i++;
-    };
-}
-
 Range<std::vector<std::vector<double>>> CentaurReader::getNodeCoordinates() {
-    centaurFile.seekg(nodeStart);
-    std::size_t dimension = 3;
-    if (centaurFileType < 0) dimension = 2;
-    std::vector<double> coordinate(dimension);
-    std::uint32_t nodesOnLine;
-    auto currentLine = readLine();
-    currentLine >> nodesOnLine;  // actually available nodes, but for old
-                                 // centaur files that is the same
-    if (centaurFileType > 4) currentLine >> nodesOnLine;
-    logger(VERBOSE, "Processing % nodes per line", nodesOnLine);
-    std::uint32_t remainderThisLine = nodesOnLine;
+    std::size_t dimension = getDimension();
     std::size_t index = 1;
-    currentLine = readLine();
-    auto increment = [=, currentLine = std::move(currentLine)](
+    // the range owns the decoded coordinates, so they are released as soon as
+    // the nodes have been processed
+    auto increment = [this, dimension, index, coordinates = readNodes()](
                          std::vector<std::vector<double>>& next) mutable {
-        if (remainderThisLine == 0) {
-            remainderThisLine = nodesOnLine;
-            currentLine = readLine();
-        }
+        auto getCoordinate = [&](std::size_t centaurIndex) {
+            auto start = coordinates.begin() + (centaurIndex - 1) * dimension;
+            return std::vector<double>(start, start + dimension);
+        };
         auto position = boundaryConnections.find(index);
         // skip over boundary nodes that are already processed
         while (position != boundaryConnections.end() &&
                position->second[0] != index) {
             position = boundaryConnections.find(++index);
-            for (auto& value : coordinate) {
-                currentLine >> value;
-            }
-            if (--remainderThisLine == 0) {
-                remainderThisLine = nodesOnLine;
-                currentLine = readLine();
-            }
         }
-        next.resize(1);
-        for (auto& value : coordinate) {
-            currentLine >> value;
-        }
-        next[0] = coordinate;
-        remainderThisLine--;
-        index++;
-        if (position != boundaryConnections.end() &&
-            position->second.size() > 1) {
-            std::istringstream::pos_type currentFilePosition =
-                centaurFile.tellg();
-            auto oldRemainder = remainderThisLine;
-            std::istringstream::pos_type currentLinePosition =
-                currentLine.tellg();
-            auto oldLine = std::move(currentLine);
-            currentLine = std::istringstream(oldLine.str());
-            currentLine.seekg(currentLinePosition);
-            for (auto offset :
-                 Range<int>{static_cast<int>(position->second[1]) -
-                                static_cast<int>(position->second[0]),
-                            difference_generator(position->second),
-                            position->second.size() - 1}) {
-                logger.assert_always(offset > 0, "Need to skip % positions",
-                                     offset);
-                while (static_cast<uint32_t>(offset) > remainderThisLine) {
-                    currentLine = readLine();
-                    offset -= remainderThisLine;
-                    remainderThisLine = nodesOnLine;
-                }
-                while (offset-- > 0) {
-                    --remainderThisLine;
-                    for (auto& value : coordinate) {
-                        currentLine >> value;
-                    }
-                }
-                next.push_back(coordinate);
+        next.clear();
+        if (position == boundaryConnections.end()) {
+            next.push_back(getCoordinate(index));
+        } else {
+            for (auto periodicIndex : position->second) {
+                next.push_back(getCoordinate(periodicIndex));
             }
-            currentLine = std::move(oldLine);
-            centaurFile.seekg(currentFilePosition);
-            remainderThisLine = oldRemainder;
         }
+        index++;
         if (HPGEM_LOGLEVEL >= Log::VERBOSE) {
             for (auto outputCoordinate : next) {
                 std::cout << "(" << outputCoordinate[0];
@@ -214,53 +159,157 @@ Range<std::vector<std::vector<double>>> CentaurReader::getNodeCoordinates() {
 }
 
 Range<std::vector<std::size_t>> CentaurReader::getElements() {
-    centaurFile.seekg(elementStart);
-    std::size_t currentGroupRemainder = 0;
-    std::size_t entitiesOnLine = 0;
-    std::size_t remainderThisLine = 0;
-    std::size_t groupsProcessed = 0;
-    UnstructuredInputStream<std::istringstream> currentLine;
-    auto increment = [=, currentLine = std::move(currentLine)](
+    std::vector<std::pair<std::size_t, std::size_t>> groups;
+    std::vector<std::uint32_t> elementNodes = readElements(groups);
+    std::size_t group = 0;
+    std::size_t elementInGroup = 0;
+    std::size_t position = 0;
+    auto increment = [=, elementNodes = std::move(elementNodes)](
                          std::vector<std::size_t>& next) mutable {
-        while (currentGroupRemainder == 0) {
-            if (centaurFileType < 2)
-                groupsProcessed += 2;
-            else
-                groupsProcessed++;
-            currentLine = readLine();
-            currentLine >> currentGroupRemainder;
-            entitiesOnLine = currentGroupRemainder;
-            if (centaurFileType > 4) currentLine >> entitiesOnLine;
-            remainderThisLine = entitiesOnLine;
-            if (groupsProcessed == 1)
-                next.resize(8);
-            else if (groupsProcessed == 3)
-                next.resize(5);
-            else if (groupsProcessed == 4)
-                next.resize(4);
-            else if (centaurFileType < 0)
-                next.resize(3);
-            else
-                next.resize(6);
-            currentLine = readLine();
-        }
-        if (remainderThisLine == 0) {
-            currentLine = readLine();
-            remainderThisLine = entitiesOnLine;
+        while (group < groups.size() &&
+               elementInGroup == groups[group].first) {
+            group++;
+            elementInGroup = 0;
         }
-        for (auto& index : next) {
-            uint32_t input;
-            currentLine >> input;
-            index = toHpgemNumbering[input];
+        if (group == groups.size()) {
+            return;
         }
-        remainderThisLine--;
-        currentGroupRemainder--;
+        std::size_t nodesPerElement = groups[group].second;
+        next.assign(elementNodes.begin() + position,
+                    elementNodes.begin() + position + nodesPerElement);
+        position += nodesPerElement;
+        elementInGroup++;
     };
     std::vector<std::size_t> first;
     increment(first);
     return {first, std::move(increment), numberOfElements};
 }
 
+template <typename Decoder>
+void CentaurReader::readGroup(std::size_t numberOfEntities,
+                              std::size_t entitiesPerLine,
+                              std::size_t entitySize, Decoder&& decode) {
+    if (numberOfEntities == 0) {
+        skipLine();
+        return;
+    }
+    logger.assert_always(entitiesPerLine > 0,
+                         "The lines of a group should contain entities");
+    // big enough to keep all threads busy and to read efficiently, small
+    // enough to not need a second copy of the entire group
+    constexpr std::size_t chunkSize = std::size_t{1} << 26;
+    std::size_t entitiesPerChunk =
+        std::max<std::size_t>(chunkSize / entitySize, 1);
+    std::vector<char> buffer;
+    for (std::size_t lineStart = 0; lineStart < numberOfEntities;
+         lineStart += entitiesPerLine) {
+        std::size_t entitiesOnLine =
+            std::min(entitiesPerLine, numberOfEntities - lineStart);
+        std::uint32_t lineSize, referenceSize;
+        centaurFile >> lineSize;
+        logger.assert_always(lineSize >= entitiesOnLine * entitySize,
+                             "read error in centaur file");
+        for (std::size_t first = 0; first < entitiesOnLine;
+             first += entitiesPerChunk) {
+            std::size_t count =
+                std::min(entitiesPerChunk, entitiesOnLine - first);
+            buffer.resize(count * entitySize);
+            centaurFile.read(buffer.data(), buffer.size());
+            logger.assert_always(!!centaurFile, "read error in centaur file");
+            decode(buffer.data(), lineStart + first, count);
+        }
+        centaurFile.seekg(lineSize - entitiesOnLine * entitySize,
+                          std::ios_base::cur);
+        centaurFile >> referenceSize;
+        logger.assert_always(lineSize == referenceSize,
+                             "read error in centaur file");
+    }
+}
+
+std::vector<double> CentaurReader::readNodes() {
+    centaurFile.seekg(nodeStart);
+    std::size_t dimension = getDimension();
+    std::uint32_t numberOfEntities, nodesOnLine;
+    auto currentLine = readLine();
+    currentLine >> numberOfEntities;
+    nodesOnLine = numberOfEntities;
+    if (centaurFileType > 4) currentLine >> nodesOnLine;
+    logger(VERBOSE, "Processing % nodes per line", nodesOnLine);
+    std::vector<double> coordinates(numberOfEntities * dimension);
+    readGroup(numberOfEntities, nodesOnLine, dimension * sizeof(double),
+              [&](const char* data, std::size_t first, std::size_t count) {
+                  double* target = coordinates.data() + first * dimension;
+                  parallelFor(count * dimension, 1 << 16,
+                              [&](std::size_t, std::size_t begin,
+                                  std::size_t end) {
+                                  std::memcpy(target + begin,
+                                              data + begin * sizeof(double),
+                                              (end - begin) * sizeof(double));
+                              });
+              });
+    return coordinates;
+}
+
+std::vector<std::uint32_t> CentaurReader::readElements(
+    std::vector<std::pair<std::size_t, std::size_t>>& groups) {
+    centaurFile.seekg(elementStart);
+    std::vector<std::uint32_t> elementNodes;
+    groups.clear();
+    // old files have no hexahedra and pyramids
+    std::size_t numberOfGroups = (centaurFileType > 1) ? 4 : 2;
+    for (std::size_t group = 0; group < numberOfGroups; ++group) {
+        std::size_t groupsProcessed =
+            (centaurFileType > 1) ? group + 1 : 2 * group + 2;
+        std::size_t nodesPerElement;
+        if (groupsProcessed == 1)
+            nodesPerElement = 8;
+        else if (groupsProcessed == 3)
+            nodesPerElement = 5;
+        else if (groupsProcessed == 4)
+            nodesPerElement = 4;
+        else if (centaurFileType < 0)
+            nodesPerElement = 3;
+        else
+            nodesPerElement = 6;
+        std::uint32_t numberOfEntities, entitiesOnLine;
+        auto currentLine = readLine();
+        currentLine >> numberOfEntities;
+        entitiesOnLine = numberOfEntities;
+        if (centaurFileType > 4) currentLine >> entitiesOnLine;
+        groups.push_back({numberOfEntities, nodesPerElement});
+        std::size_t offset = elementNodes.size();
+        elementNodes.resize(offset + numberOfEntities * nodesPerElement);
+        readGroup(
+            numberOfEntities, entitiesOnLine,
+            nodesPerElement * sizeof(std::uint32_t),
+            [&](const char* data, std::size_t first, std::size_t count) {
+                std::uint32_t* target =
+                    elementNodes.data() + offset + first * nodesPerElement;
+                parallelFor(
+                    count * nodesPerElement, 1 << 16,
+                    [&](std::size_t, std::size_t begin, std::size_t end) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                            std::uint32_t input;
+                            std::memcpy(&input,
+                                        data + i * sizeof(std::uint32_t),
+                                        sizeof(std::uint32_t));
+                            logger.assert_debug(
+                                input < toHpgemNumbering.size(),
+                                "Node % does not exist", input);
+                            logger.assert_debug(
+                                toHpgemNumbering[input] <=
+                                    std::numeric_limits<std::uint32_t>::max(),
+                                "Node % does not fit in 32 bits",
+                                toHpgemNumbering[input]);
+                            target[i] = static_cast<std::uint32_t>(
+                                toHpgemNumbering[input]);
+                        }
+                    });
+            });
+    }
+    return elementNodes;
+}
+
 std::uint32_t CentaurReader::skipGroup(std::size_t linesPerEntity,
                                        bool multiline) {
     std::uint32_t numberOfEntities;
@@ -271,14 +320,23 @@ std::uint32_t CentaurReader::skipGroup(std::size_t linesPerEntity,
     if (centaurFileType > 4 && multiline)
         currentLine >> numberOfEntitiesPerLine;
     logger(VERBOSE, "there are % entities per line", numberOfEntitiesPerLine);
-    if (numberOfEntities == 0) readLine();
+    if (numberOfEntities == 0) skipLine();
     for (std::size_t i = 0; i < numberOfEntities;
          i += numberOfEntitiesPerLine) {
-        for (std::size_t j = 0; j < linesPerEntity; ++j) readLine();
+        for (std::size_t j = 0; j < linesPerEntity; ++j) skipLine();
     }
     return numberOfEntities;
 }
 
+void CentaurReader::skipLine() {
+    std::uint32_t lineSize, referenceSize;
+    centaurFile >> lineSize;
+    centaurFile.seekg(lineSize, std::ios_base::cur);
+    centaurFile >> referenceSize;
+    logger.assert_always(!!centaurFile && lineSize == referenceSize,
+                         "read error in centaur file");
+}
+
 void CentaurReader::readNodeConnections() {
     std::uint32_t numberOfPeriodicTransformations = 1;
     if (centaurFileType > 3) {
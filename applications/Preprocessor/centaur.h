@@ -65,11 +65,29 @@ class CentaurReader {
 
    private:
     UnstructuredInputStream<std::istringstream> readLine();
+    /// Move past the next line without reading its content
+    void skipLine();
     // returns the number of skipped entities
     std::uint32_t skipGroup(std::size_t linesPerEntity = 1,
                             bool multiline = true);
     void readNodeConnections();
 
+    /// Read the lines of a group of entities whose first line (with the
+    /// number of entities) has already been read. The data is read in chunks
+    /// of whole entities, regardless of the lines of the file, that are passed
+    /// to decode(data, firstEntity, numberOfEntities).
+    template <typename Decoder>
+    void readGroup(std::size_t numberOfEntities, std::size_t entitiesPerLine,
+                   std::size_t entitySize, Decoder&& decode);
+
+    /// The coordinates of all nodes, in the order of the centaur file
+    std::vector<double> readNodes();
+    /// The (hpGEM) nodes of all elements, in the order of the centaur file.
+    /// groups is filled with the number of elements and the number of nodes
+    /// per element for each group of elements in the file.
+    std::vector<std::uint32_t> readElements(
+        std::vector<std::pair<std::size_t, std::size_t>>& groups);
+
     UnstructuredInputStream<std::ifstream> centaurFile;
     std::ifstream::pos_type nodeStart;
     std::ifstream::pos_type elementStart;
@@ -252,6 +252,26 @@ class ElementShape {
                      std::vector<std::size_t>>
         getAdjacentEntities(std::size_t entityIndex) const;
 
+    /**
+     * @brief same as getAdjacentEntities when both dimensions are smaller than
+     * the dimension of this shape, but returns the stored indices instead of a
+     * copy
+     */
+    template <std::size_t entityDimension, std::size_t targetDimension>
+    const std::vector<std::size_t>& getStoredAdjacentEntities(
+        std::size_t entityIndex) const {
+        static_assert(entityDimension < dimension && targetDimension < dimension,
+                      "Only the adjacency of bounding entities is stored");
+        logger.assert_debug(
+            entityIndex < getNumberOfEntities<entityDimension>(),
+            "This shape is bounded by only % shapes of dimension %, but you "
+            "asked for shape %",
+            getNumberOfEntities<entityDimension>(), entityDimension,
+            entityIndex);
+        return shapeData.template getAdjacentShapes<
+            entityDimension>()[targetDimension][entityIndex];
+    }
+
     bool checkShape() const { return checkBoundaryShape(tag<dimension - 1>{}); }
 
    private:
@@ -177,10 +177,10 @@ void processMesh(Preprocessor::HpgemReader& meshFile) {
     std::vector<std::size_t> boundaryNodes;
     std::map<std::size_t, std::size_t> toBoundaryIndex;
     std::set<LinearAlgebra::SmallVector<dimension>> processedCoordinates;
-    for (auto& node : inputMesh.getNodes()) {
+    for (auto node : inputMesh.getNodes()) {
         bool added = false;
         for (std::size_t i = 0; i < node.getNumberOfElements(); ++i) {
-            Preprocessor::Element<dimension>& element = node.getElement(i);
+            auto element = node.getElement(i);
             auto nodeCoordinate = element.getCoordinate(node.getLocalIndex(i));
             if (position.onBoundary(nodeCoordinate) &&
                 std::find(processedCoordinates.begin(),
@@ -202,7 +202,7 @@ void processMesh(Preprocessor::HpgemReader& meshFile) {
             processedCoordinates.insert(nodeCoordinate);
         }
     }
-    for (auto& face : inputMesh.getFaces()) {
+    for (auto face : inputMesh.getFaces()) {
         auto nodeIndices = face.template getIncidenceListAsIndices<0>();
         bool onBoundary = true;
         for (auto index : nodeIndices) {
@@ -228,6 +228,7 @@ void processMesh(Preprocessor::HpgemReader& meshFile) {
             resultPartitionID[resultElement] = inputPartitionID[inputElement];
         }
     }
+    resultMesh.fixConnectivity();
     Preprocessor::outputMesh(resultMesh, resultPartitionID,
                              meshFile.getTargetProcessorCount());
 }
@@ -44,8 +44,11 @@
 #include <cstddef>
 using idx_t = std::size_t;
 #endif
+#include <algorithm>
 #include <chrono>
-#include <random>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 #include "Base/CommandLineOptions.h"
 #include "Base/MpiContainer.h"
 #include "mesh.h"
@@ -67,9 +70,43 @@ auto& dimension = Base::register_argument<std::size_t>(
     false);
 auto& targetMpiCount = Base::register_argument<std::size_t>(
     'n', "MPICount", "Target number of processors", false, 1);
+auto& polynomialOrder = Base::register_argument<std::size_t>(
+    '\0', "polynomialOrder",
+    "Polynomial order of the solver, used to estimate the cost of an element",
+    false, 1);
+auto& numberOfUnknowns = Base::register_argument<std::size_t>(
+    '\0', "numberOfUnknowns",
+    "Number of unknowns of the solver, used to estimate the cost of an "
+    "element",
+    false, 1);
+auto& balanceMemory = Base::register_argument<bool>(
+    '\0', "balanceMemory",
+    "Also balance the memory use (the number of degrees of freedom) next to "
+    "the computational cost",
+    false, false);
+auto& partitionSeed = Base::register_argument<std::size_t>(
+    '\0', "seed", "Seed for the partitioner, to get reproducible partitions",
+    false, 0);
+
+/// The largest amount of memory this process had in use so far in bytes, or 0
+/// if this is not known on this platform.
+std::size_t getPeakMemoryUsage() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * std::size_t{1024};
+#endif
+#else
+    return 0;
+#endif
+}
 
 template <std::size_t dimension>
-void printMeshStatistics(const Preprocessor::Mesh<dimension>& mesh) {
+void printMeshStatistics(const Preprocessor::Mesh<dimension>& mesh,
+                         std::chrono::steady_clock::time_point start) {
     logger(INFO, "Mesh counts");
     logger(INFO, "\tElements: %", mesh.getNumberOfElements());
     logger(INFO, "\tFaces: %", mesh.getNumberOfFaces());
@@ -93,54 +130,184 @@ void printMeshStatistics(const Preprocessor::Mesh<dimension>& mesh) {
         }
         logger(INFO, "Mesh bounding box min % - max %", minCoord, maxCoord);
     }
+
+    auto now = std::chrono::steady_clock::now();
+    logger(INFO, "Reading the mesh took %ms",
+           std::chrono::duration_cast<std::chrono::milliseconds>(now - start)
+               .count());
+    logger(INFO, "Mesh storage: % MiB",
+           static_cast<double>(mesh.getMemoryUsage()) / 1048576.);
+    std::size_t peakMemory = getPeakMemoryUsage();
+    if (peakMemory > 0) {
+        logger(INFO, "Peak memory use: % MiB",
+               static_cast<double>(peakMemory) / 1048576.);
+    }
+}
+
+/// Number of DG basis functions of the given order on an element or face,
+/// where the shape is deduced from its dimension and number of nodes.
+std::size_t getNumberOfBasisFunctions(std::size_t shapeDimension,
+                                      std::size_t numberOfNodes,
+                                      std::size_t order) {
+    const std::size_t p = order;
+    switch (shapeDimension) {
+        case 0:
+            return 1;
+        case 1:
+            return p + 1;
+        case 2:
+            // triangle or square
+            return numberOfNodes == 3 ? (p + 1) * (p + 2) / 2
+                                      : (p + 1) * (p + 1);
+        case 3:
+            switch (numberOfNodes) {
+                case 4:  // tetrahedron
+                    return (p + 1) * (p + 2) * (p + 3) / 6;
+                case 5:  // pyramid
+                    return (p + 1) * (p + 2) * (2 * p + 3) / 6;
+                case 6:  // triangular prism
+                    return (p + 1) * (p + 1) * (p + 2) / 2;
+                default:  // cube
+                    return (p + 1) * (p + 1) * (p + 1);
+            }
+        default:
+            logger(ERROR, "Shapes of dimension % are not supported",
+                   shapeDimension);
+            return 0;
+    }
 }
 
+/// Weights of the graph of elements (connected through their faces) that is
+/// partitioned.
+struct PartitionWeights {
+    /// Number of balance constraints per element
+    std::size_t numberOfConstraints;
+    /// Weights of the elements, numberOfConstraints per element. The first is
+    /// the computational cost: the work of an element is proportional to the
+    /// number of basis functions times the number of quadrature points (which
+    /// grows like the number of basis functions). The optional second is the
+    /// memory use: the number of degrees of freedom.
+    std::vector<idx_t> elementWeights;
+    /// Offsets in adjacentElements for each element (CSR format)
+    std::vector<idx_t> adjacencyOffsets;
+    /// The elements that share a face with each element
+    std::vector<idx_t> adjacentElements;
+    /// Weight of each connection: the amount of data that is communicated
+    /// over the face when both elements are on different processors.
+    std::vector<idx_t> connectionWeights;
+};
+
 template <std::size_t dimension>
-void processMesh(Preprocessor::Mesh<dimension> mesh) {
-    printMeshStatistics(mesh);
+PartitionWeights computePartitionWeights(
+    const Preprocessor::Mesh<dimension>& mesh) {
+    const std::size_t order = polynomialOrder.getValue();
+    const std::size_t unknowns = numberOfUnknowns.getValue();
+    PartitionWeights weights;
+    weights.numberOfConstraints = balanceMemory.getValue() ? 2 : 1;
+    weights.elementWeights.resize(weights.numberOfConstraints *
+                                  mesh.getNumberOfElements());
+    weights.adjacencyOffsets.resize(mesh.getNumberOfElements() + 1);
+    for (auto element : mesh.getElements()) {
+        const std::size_t index = element.getGlobalIndex();
+        const std::size_t numberOfBasisFunctions = getNumberOfBasisFunctions(
+            dimension, element.getNumberOfNodes(), order);
+        weights.elementWeights[weights.numberOfConstraints * index] =
+            unknowns * numberOfBasisFunctions * numberOfBasisFunctions;
+        if (weights.numberOfConstraints > 1) {
+            weights.elementWeights[weights.numberOfConstraints * index + 1] =
+                unknowns * numberOfBasisFunctions;
+        }
+        weights.adjacencyOffsets[index] = weights.adjacentElements.size();
+        for (auto face : element.getFacesList()) {
+            if (face.getNumberOfElements() == 2) {
+                if (face.getElement(0) == element) {
+                    weights.adjacentElements.push_back(
+                        face.getElement(1).getGlobalIndex());
+                } else {
+                    weights.adjacentElements.push_back(
+                        face.getElement(0).getGlobalIndex());
+                }
+                weights.connectionWeights.push_back(
+                    unknowns * getNumberOfBasisFunctions(
+                                   dimension - 1, face.getNumberOfNodes(),
+                                   order));
+            }
+        }
+    }
+    weights.adjacencyOffsets.back() = weights.adjacentElements.size();
+    return weights;
+}
+
+/// Report the imbalance for each constraint and the edge cut of a partitioning
+template <std::size_t dimension>
+void printPartitionStatistics(
+    const PartitionWeights& weights,
+    const Preprocessor::MeshData<idx_t, dimension, dimension>& partitionID,
+    std::size_t numberOfProcessors) {
+    const std::size_t numberOfElements = weights.adjacencyOffsets.size() - 1;
+    const std::size_t numberOfConstraints = weights.numberOfConstraints;
+    std::vector<double> loads(numberOfConstraints * numberOfProcessors, 0);
+    std::vector<double> totalLoads(numberOfConstraints, 0);
+    std::size_t cutFaces = 0;
+    std::size_t edgeCut = 0;
+    for (std::size_t i = 0; i < numberOfElements; ++i) {
+        for (std::size_t c = 0; c < numberOfConstraints; ++c) {
+            loads[numberOfConstraints * partitionID[i] + c] +=
+                weights.elementWeights[numberOfConstraints * i + c];
+            totalLoads[c] += weights.elementWeights[numberOfConstraints * i + c];
+        }
+        for (idx_t j = weights.adjacencyOffsets[i];
+             j < weights.adjacencyOffsets[i + 1]; ++j) {
+            // count every face once
+            const std::size_t neighbour = weights.adjacentElements[j];
+            if (i < neighbour && partitionID[i] != partitionID[neighbour]) {
+                ++cutFaces;
+                edgeCut += weights.connectionWeights[j];
+            }
+        }
+    }
+    const char* constraintNames[] = {"computational cost", "memory"};
+    for (std::size_t c = 0; c < numberOfConstraints; ++c) {
+        double maximumLoad = 0;
+        for (std::size_t p = 0; p < numberOfProcessors; ++p) {
+            maximumLoad =
+                std::max(maximumLoad, loads[numberOfConstraints * p + c]);
+        }
+        logger(INFO, "Predicted imbalance of the %: %", constraintNames[c],
+               maximumLoad * numberOfProcessors / totalLoads[c]);
+    }
+    logger(INFO, "Edge cut: % faces, % degrees of freedom", cutFaces, edgeCut);
+}
+
+template <std::size_t dimension>
+void processMesh(Preprocessor::Mesh<dimension> mesh,
+                 std::chrono::steady_clock::time_point start) {
+    printMeshStatistics(mesh, start);
 
     Preprocessor::MeshData<idx_t, dimension, dimension> partitionID(&mesh);
     idx_t numberOfProcessors = targetMpiCount.getValue();
     if (numberOfProcessors > 1) {
 #ifdef HPGEM_USE_METIS
-        idx_t numberOfConstraints = 1;
+        PartitionWeights weights = computePartitionWeights(mesh);
+        idx_t numberOfConstraints = weights.numberOfConstraints;
         idx_t numberOfElements = mesh.getNumberOfElements();
-        float imbalance = 1.001;
+        std::vector<float> imbalance(numberOfConstraints, 1.001);
         idx_t totalCutSize;
 
-        std::vector<idx_t> xadj(numberOfElements + 1);
-        std::vector<idx_t> adjncy(
-            2 * mesh.getNumberOfFaces());  // actually interior faces only
-        idx_t connectionsUsed{0};
-        for (auto element : mesh.getElements()) {
-            xadj[element.getGlobalIndex()] = connectionsUsed;
-            for (auto face : element.getFacesList()) {
-                if (face.getNumberOfElements() == 2) {
-                    if (face.getElement(0) == element) {
-                        adjncy[connectionsUsed++] =
-                            face.getElement(1).getGlobalIndex();
-                    } else {
-                        adjncy[connectionsUsed++] =
-                            face.getElement(0).getGlobalIndex();
-                    }
-                }
-            }
-        }
-        xadj.back() = connectionsUsed;
-        std::random_device seedGenerator;
-        idx_t seed = seedGenerator();
-
-        logger(DEBUG, "Metis ran with the seed %", seed);
+        logger(DEBUG, "Metis ran with the seed %", partitionSeed.getValue());
 
         idx_t metisOptions[METIS_NOPTIONS];
         METIS_SetDefaultOptions(metisOptions);
         metisOptions[METIS_OPTION_CTYPE] = METIS_CTYPE_SHEM;
         metisOptions[METIS_OPTION_RTYPE] = METIS_RTYPE_FM;
-        metisOptions[METIS_OPTION_SEED] = seed;
-        METIS_PartGraphKway(&numberOfElements, &numberOfConstraints,
-                            xadj.data(), adjncy.data(), NULL, NULL, NULL,
-                            &numberOfProcessors, NULL, &imbalance, metisOptions,
-                            &totalCutSize, partitionID.data());
+        metisOptions[METIS_OPTION_SEED] = partitionSeed.getValue();
+        METIS_PartGraphKway(
+            &numberOfElements, &numberOfConstraints,
+            weights.adjacencyOffsets.data(), weights.adjacentElements.data(),
+            weights.elementWeights.data(), NULL,
+            weights.connectionWeights.data(), &numberOfProcessors, NULL,
+            imbalance.data(), metisOptions, &totalCutSize, partitionID.data());
+        printPartitionStatistics(weights, partitionID, numberOfProcessors);
 #else
         logger(
             ERROR,
@@ -163,7 +330,7 @@ int main(int argc, char** argv) {
                "This is a sequential code, use the command line options to set "
                "the target number of processors instead");
     }
-    Base::MPIContainer::Instance().onlyOnOneProcessor({[]() {
+    Base::MPIContainer::Instance().onlyOnOneProcessor({[start]() {
         std::string fileName = inputFileName.getValue();
         std::transform(fileName.begin(), fileName.end(), fileName.begin(),
                        tolower);
@@ -181,11 +348,11 @@ int main(int argc, char** argv) {
                     hpgemFile.getDimension(), dimension.getValue());
             }
             if (hpgemFile.getDimension() == 1) {
-                processMesh(Preprocessor::readFile<1>(hpgemFile));
+                processMesh(Preprocessor::readFile<1>(hpgemFile), start);
             } else if (hpgemFile.getDimension() == 2) {
-                processMesh(Preprocessor::readFile<2>(hpgemFile));
+                processMesh(Preprocessor::readFile<2>(hpgemFile), start);
             } else if (hpgemFile.getDimension() == 3) {
-                processMesh(Preprocessor::readFile<3>(hpgemFile));
+                processMesh(Preprocessor::readFile<3>(hpgemFile), start);
             } else {
                 logger(ERROR, "Dimension % is not supported",
                        hpgemFile.getDimension());
@@ -203,9 +370,9 @@ int main(int argc, char** argv) {
                     centaurFile.getDimension(), dimension.getValue());
             }
             if (centaurFile.getDimension() == 2) {
-                processMesh(Preprocessor::readFile<2>(centaurFile));
+                processMesh(Preprocessor::readFile<2>(centaurFile), start);
             } else if (centaurFile.getDimension() == 3) {
-                processMesh(Preprocessor::readFile<3>(centaurFile));
+                processMesh(Preprocessor::readFile<3>(centaurFile), start);
             } else {
                 logger(ERROR,
                        "Centaur file should not be able to have dimension %",
@@ -39,7 +39,10 @@
 #ifndef HPGEM_APP_MESH_H
 #define HPGEM_APP_MESH_H
 
-#include "Base/ConstIterableWrapper.h"
+#include <array>
+#include <iterator>
+#include <memory>
+#include <type_traits>
 #include "LinearAlgebra/SmallVector.h"
 #include "elementShape.h"
 
@@ -60,6 +63,178 @@ class Element;
 template <std::size_t dimension>
 class Mesh;
 
+namespace Detail {
+
+/// The type used to present a MeshEntity of dimension entityDimension, this is
+/// an Element for the entities of the highest dimension
+template <std::size_t entityDimension, std::size_t meshDimension>
+using EntityType =
+    std::conditional_t<entityDimension == meshDimension,
+                       Element<meshDimension>,
+                       MeshEntity<entityDimension, meshDimension>>;
+
+/// The incidence between the elements and the MeshEntity-s of one dimension,
+/// stored in both directions in compressed sparse row format.
+struct IncidenceTable {
+    /// The number of MeshEntity-s of this dimension
+    std::size_t numberOfEntities = 0;
+    /// The global indices of the MeshEntity-s bounding element e are
+    /// elementEntities[elementOffsets[e]] up to (not including)
+    /// elementEntities[elementOffsets[e + 1]], ordered by their local index.
+    std::vector<std::size_t> elementOffsets = {0};
+    std::vector<std::size_t> elementEntities;
+    /// The elements bounded by MeshEntity i are entityElements[entityOffsets[i]]
+    /// up to (not including) entityElements[entityOffsets[i + 1]]. The local
+    /// index of the MeshEntity on such an element is stored at the same
+    /// position in entityLocalIndices.
+    std::vector<std::size_t> entityOffsets = {0};
+    std::vector<std::size_t> entityElements;
+    std::vector<std::size_t> entityLocalIndices;
+
+    /// Compute the lists per MeshEntity from the lists per element
+    void transpose();
+
+    /// The number of bytes allocated for the tables
+    std::size_t getMemoryUsage() const;
+};
+
+constexpr std::size_t exp2(std::size_t power) {
+    if (power == 0) {
+        return 1;
+    }
+    if ((power / 2) * 2 == power) {
+        return exp2(power / 2) * exp2(power / 2);
+    } else {
+        return 2 * exp2(power - 1);
+    }
+}
+}  // namespace Detail
+
+/**
+ * \brief A list of MeshEntity-s that refers to the storage of the Mesh
+ *
+ * Incidence lists are not copied out of the Mesh, instead this range
+ * refers to the global indices stored in the Mesh and creates the MeshEntity-s
+ * on the fly while iterating. The global indices are either consecutive (all
+ * MeshEntity-s of a dimension or a MeshEntity itself), a part of the
+ * incidence tables of the Mesh, or a part of the incidence tables selected by
+ * a list of local indices of an ElementShape. Only the incidence lists that
+ * have to be merged from several elements own their indices.
+ *
+ * The range is invalidated when the connectivity of the Mesh changes.
+ *
+ * @tparam entityDimension The dimension of the MeshEntity-s in the range
+ * @tparam meshDimension The dimension of the mesh.
+ */
+template <std::size_t entityDimension, std::size_t meshDimension>
+class EntityRange {
+   public:
+    using value_type = Detail::EntityType<entityDimension, meshDimension>;
+
+    class const_iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = EntityRange::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator(const EntityRange* entityRange, std::size_t start)
+            : range(entityRange), position(start) {}
+
+        value_type operator*() const { return (*range)[position]; }
+
+        const_iterator& operator++() {
+            ++position;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator result = *this;
+            ++position;
+            return result;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return range == other.range && position == other.position;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+       private:
+        const EntityRange* range;
+        std::size_t position;
+    };
+    using iterator = const_iterator;
+
+    EntityRange() = default;
+
+    /// The MeshEntity-s first up to (not including) first + size
+    EntityRange(const Mesh<meshDimension>* owner, std::size_t firstEntity,
+                std::size_t size)
+        : mesh(owner), first(firstEntity), numberOfEntities(size) {}
+
+    /// The MeshEntity-s indices[0] up to (not including) indices[size]
+    EntityRange(const Mesh<meshDimension>* owner,
+                const std::size_t* entityIndices, std::size_t size)
+        : mesh(owner), indices(entityIndices), numberOfEntities(size) {}
+
+    /// The MeshEntity-s indices[localIndices[i]] for all i
+    EntityRange(const Mesh<meshDimension>* owner,
+                const std::size_t* entityIndices,
+                const std::vector<std::size_t>& positions)
+        : mesh(owner),
+          indices(entityIndices),
+          localIndices(positions.data()),
+          numberOfEntities(positions.size()) {}
+
+    /// The MeshEntity-s in a list that has been computed for this range
+    EntityRange(const Mesh<meshDimension>* owner,
+                std::vector<std::size_t> ownIndices)
+        : mesh(owner),
+          ownedIndices(std::make_shared<const std::vector<std::size_t>>(
+              std::move(ownIndices))),
+          indices(ownedIndices->data()),
+          numberOfEntities(ownedIndices->size()) {}
+
+    std::size_t size() const { return numberOfEntities; }
+    bool empty() const { return numberOfEntities == 0; }
+
+    /// The global index of the i-th MeshEntity in this range
+    std::size_t getGlobalIndex(std::size_t i) const {
+        logger.assert_debug(i < numberOfEntities,
+                            "Asked for entity %, but there are only %", i,
+                            numberOfEntities);
+        if (indices == nullptr) {
+            return first + i;
+        }
+        if (localIndices == nullptr) {
+            return indices[i];
+        }
+        return indices[localIndices[i]];
+    }
+
+    value_type operator[](std::size_t i) const;
+    value_type front() const { return (*this)[0]; }
+    value_type back() const { return (*this)[numberOfEntities - 1]; }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, numberOfEntities}; }
+
+   private:
+    const Mesh<meshDimension>* mesh = nullptr;
+    /// Storage for the indices if they are not stored in the mesh
+    std::shared_ptr<const std::vector<std::size_t>> ownedIndices;
+    /// The global indices, nullptr if they are consecutive
+    const std::size_t* indices = nullptr;
+    /// Selection from the global indices, nullptr if all are used
+    const std::size_t* localIndices = nullptr;
+    /// The first global index if the indices are consecutive
+    std::size_t first = 0;
+    std::size_t numberOfEntities = 0;
+};
+
 /**
  * \brief Topological part of the Mesh
  *
@@ -82,6 +257,10 @@ class Mesh;
  * boundaries. This information should be accessed via a connected Element,
  * which does contain geometrical information.
  *
+ * A MeshEntity is only a handle, the connectivity itself is stored in the
+ * incidence tables of the Mesh. It is cheap to copy and the incidence lists
+ * it returns refer to the storage of the Mesh.
+ *
  * @tparam entityDimension The dimension of the entity itself (e.g. 0 for a
  * Node)
  * @tparam meshDimension The dimension of the mesh.
@@ -105,8 +284,7 @@ class MeshEntity {
     MeshEntity& operator=(MeshEntity&&) = default;
 
     /// Get a connected Element by its local index.
-    Element<meshDimension>& getElement(std::size_t i);
-    const Element<meshDimension>& getElement(std::size_t i) const;
+    Element<meshDimension> getElement(std::size_t i) const;
 
     /// Given a connected Element, what is its local index?
     std::size_t getElementIndex(const Element<meshDimension>& element) const;
@@ -127,52 +305,52 @@ class MeshEntity {
     /// entityDimension this uniquely determines the MeshEntity.
     std::size_t getGlobalIndex() const;
 
-    std::vector<MeshEntity<meshDimension, meshDimension>> getElementsList()
-        const {
+    EntityRange<meshDimension, meshDimension> getElementsList() const {
         return getIncidenceList<meshDimension>();
     }
 
     /// List of facet-MeshEntities to which this is connected.
     /// \return
-    std::vector<MeshEntity<meshDimension - 1, meshDimension>> getFacesList()
-        const {
+    EntityRange<meshDimension - 1, meshDimension> getFacesList() const {
         return getIncidenceList<meshDimension - 1>();
     }
 
     /// Number of facet-MeshEntities to which this is connected.
     std::size_t getNumberOfFaces() const { return getFacesList().size(); }
 
-    std::vector<MeshEntity<1, meshDimension>> getEdgesList() const {
+    EntityRange<1, meshDimension> getEdgesList() const {
         return getIncidenceList<1>();
     }
 
     std::size_t getNumberOfEdges() const { return getEdgesList().size(); }
 
-    std::vector<MeshEntity<0, meshDimension>> getNodesList() const {
+    EntityRange<0, meshDimension> getNodesList() const {
         return getIncidenceList<0>();
     }
 
     std::size_t getNumberOfNodes() const { return getNodesList().size(); }
 
     // when d == entityDimension, it will just return {*this}
-    /// List of all connected entities
+    /// List of all connected entities. Only the MeshEntity-s of a dimension
+    /// in between entityDimension and meshDimension are computed, the other
+    /// lists refer to the storage of the Mesh
     template <int d>
-    std::vector<MeshEntity<(d < 0 ? d + meshDimension : d), meshDimension>>
+    EntityRange<(d < 0 ? d + meshDimension : d), meshDimension>
         getIncidenceList() const;
 
+    /// Copy of the global indices of getIncidenceList()
     template <int d>
     std::vector<std::size_t> getIncidenceListAsIndices() const;
 
     template <int d>
     std::size_t getNumberOfIncidentEntities() const {
-        return getIncidenceListAsIndices<d>().size();
+        return getIncidenceList<d>().size();
     }
 
     template <int d>
-    MeshEntity<(d < 0 ? d + meshDimension : d), meshDimension>
+    Detail::EntityType<(d < 0 ? d + meshDimension : d), meshDimension>
         getIncidentEntity(std::size_t i) const {
-        return mesh->template getEntity<(d < 0 ? d + meshDimension : d)>(
-            getIncidenceListAsIndices<(d < 0 ? d + meshDimension : d)>()[i]);
+        return getIncidenceList<d>()[i];
     }
 
     const Mesh<meshDimension>* getMesh() const { return mesh; }
@@ -182,33 +360,50 @@ class MeshEntity {
 
    protected:
     friend Mesh<meshDimension>;
-    MeshEntity(Mesh<meshDimension>* mesh, std::size_t entityID)
-        : mesh(mesh), entityID(entityID) {}
+    MeshEntity(const Mesh<meshDimension>* owner, std::size_t id)
+        : mesh(owner), entityID(id) {}
 
-    /// Add an element that is this MeshEntity is part of
-    ///
-    /// \param elementID The entityID of the element
-    /// \param localEntityIndex The localIndex of this MeshEntity for the
-    /// element.
-    void addElement(std::size_t elementID, std::size_t localEntityIndex);
+    /// The incidence table for the dimension of this MeshEntity
+    const Detail::IncidenceTable& getTable() const;
+
+    // Implementation of getIncidenceList, the tag selects the relation
+    // between d, entityDimension and meshDimension
+    template <std::size_t d>
+    using incidenceCase = std::integral_constant<
+        int, (d == entityDimension
+                  ? 0
+                  : (d == meshDimension
+                         ? 1
+                         : (entityDimension == meshDimension
+                                ? 2
+                                : (d < entityDimension ? 3 : 4))))>;
+    /// this MeshEntity itself
+    template <std::size_t d>
+    EntityRange<d, meshDimension> computeIncidenceList(
+        std::integral_constant<int, 0>) const;
+    /// the elements, stored in the Mesh
+    template <std::size_t d>
+    EntityRange<d, meshDimension> computeIncidenceList(
+        std::integral_constant<int, 1>) const;
+    /// the MeshEntity-s bounding an element, stored in the Mesh
+    template <std::size_t d>
+    EntityRange<d, meshDimension> computeIncidenceList(
+        std::integral_constant<int, 2>) const;
+    /// the MeshEntity-s bounding this MeshEntity, selected from those of the
+    /// first element
+    template <std::size_t d>
+    EntityRange<d, meshDimension> computeIncidenceList(
+        std::integral_constant<int, 3>) const;
+    /// the MeshEntity-s bounded by this MeshEntity, merged from all elements
+    template <std::size_t d>
+    EntityRange<d, meshDimension> computeIncidenceList(
+        std::integral_constant<int, 4>) const;
 
-    Mesh<meshDimension>* mesh;
+    const Mesh<meshDimension>* mesh = nullptr;
     /// The id of this MeshEntity
     std::size_t entityID = std::numeric_limits<std::size_t>::max();
-    /// The entityIDs for the Elements that this MeshEntity is part of
-    std::vector<std::size_t> elementIDs;
-    /// For each of the elements that this MeshEntity is part of, the local id
-    /// of this MeshEntity on the element.
-    std::vector<std::size_t> localIDs;
-    // NOTE: Probably the following identity should hold:
-    // elements[elementIDs[i]].incidenceList[dimension][localIDs[i]] == entityID
 };
 
-/**
- * @brief While this is conceptually just an index into the mesh, it also
- * presents some functions for local inspection and manipulation of the mesh
- * @tparam dim the dimension of the mesh
- */
 /**
  * \brief An Element of the Mesh.
  *
@@ -227,6 +422,8 @@ class MeshEntity {
  * connected elements to a node usually have the same coordinate, this is not
  * required and not possible with periodic boundaries.
  *
+ * Like a MeshEntity this is only a handle into the Mesh.
+ *
  * @tparam dim The dimension of the
  */
 template <std::size_t dim>
@@ -257,24 +454,8 @@ class Element : public MeshEntity<dim, dim> {
 
     std::vector<LinearAlgebra::SmallVector<dim>> getCoordinatesList() const;
 
-    /// Set the global coordinate of a node
-    /// \param localIndex The local index of the node
-    /// \param newCoordinate The new coordinate.
-    void setNodeCoordinate(std::size_t localIndex,
-                           LinearAlgebra::SmallVector<dim> newCoordinate);
-
-    /// Set the node at a specific local index.
-    ///
-    /// \param localIndex The local index of the node
-    /// \param globalIndex The global index of the node
-    /// \param coordinateIndex  The global coordinate index for the point
-    /// corresponding to the node.
-    void setNode(std::size_t localIndex, std::size_t globalIndex,
-                 std::size_t coordinateIndex);
-
-    template <std::size_t d>
-    std::enable_if_t<(d > 0)> setEntity(std::size_t localIndex,
-                                        std::size_t globalIndex);
+    /// The geometry of this element (e.g. a cube or tetrahedron)
+    const ElementShape<dim>* getShape() const;
 
     using MeshEntity<dim, dim>::getIncidenceList;
     using MeshEntity<dim, dim>::getIncidenceListAsIndices;
@@ -292,8 +473,8 @@ class Element : public MeshEntity<dim, dim> {
     /// \param entity The MeshEntity on the boundary.
     /// \return The shared MeshEntity-s
     template <int d, std::size_t entityDimension>
-    std::vector<MeshEntity<(d < 0 ? d + dim : d), dim>> getIncidenceList(
-        const MeshEntity<entityDimension, dim>& entity) const;
+    std::vector<Detail::EntityType<(d < 0 ? d + dim : d), dim>>
+        getIncidenceList(const MeshEntity<entityDimension, dim>& entity) const;
 
     /// Same as getIncidenceList(const MeshEntity<entityDimension, dim>& entity)
     /// but computing the global indices of the MeshEntity-s
@@ -317,92 +498,10 @@ class Element : public MeshEntity<dim, dim> {
 
    private:
     friend Mesh<dim>;
-    Element(Mesh<dim>* mesh, std::size_t elementID)
-        : MeshEntity<dim, dim>(mesh, elementID) {
-        this->addElement(elementID, 0);
-    }
-
-    /// Add a node to this element.
-    /// \param globalNodeIndex The global index of the (topological) node
-    /// \param coordinateIndex The global index of the coordinate for the node.
-    void addNode(std::size_t globalNodeIndex, std::size_t coordinateIndex);
-
-    template <std::size_t d>
-    std::enable_if_t<(d > 0)> addEntity(std::size_t globalIndex);
-
-    void setGeometry(const ElementShape<dim>* shape) {
-        referenceGeometry = shape;
-    }
-
-    /// The geometry of this element (e.g. a cube or tetrahedron)
-    const ElementShape<dim>* referenceGeometry;
-    /// The global indices of all the MeshEntities that form the boundary of
-    /// this element, grouped by the dimension of the MeshEntities.
-    std::array<std::vector<std::size_t>, dim> incidenceLists;
-    /// The global indices of the coordinates for the corners of this element.
-    std::vector<std::size_t> globalCoordinateIndices;
-};
-
-namespace Detail {
-
-/// MeshEntities stores MeshEntity-s of all dimensions.
-// Implementation note, inheritiance is used to recursively store all
-// dimensions.
-template <std::size_t entityDimension, std::size_t dimension = entityDimension>
-struct MeshEntities : public MeshEntities<entityDimension - 1, dimension> {
-    /// The entities themselves
-    std::vector<MeshEntity<entityDimension, dimension>> data;
-
-    /// Get the MeshEntity's of a specific entityDimension
-    template <std::size_t SUB_DIM>
-    std::vector<MeshEntity<SUB_DIM, dimension>>& getData() {
-        static_assert(SUB_DIM <= entityDimension,
-                      "Requested data is not available in this entity");
-        return MeshEntities<SUB_DIM, dimension>::data;
-    }
-
-    /// Get the MeshEntity's of a specific entityDimension
-    template <std::size_t SUB_DIM>
-    const std::vector<MeshEntity<SUB_DIM, dimension>>& getData() const {
-        static_assert(SUB_DIM <= entityDimension,
-                      "Requested data is not available in this entity");
-        return MeshEntities<SUB_DIM, dimension>::data;
-    }
-};
-
-// Base case of MeshEntities, there are no MeshEntities of dimension lower than
-// 0.
-template <std::size_t dimension>
-struct MeshEntities<0, dimension> {
-    std::vector<MeshEntity<0, dimension>> data;
-
-    template <std::size_t SUB_DIM>
-    std::vector<MeshEntity<0, dimension>>& getData() {
-        static_assert(SUB_DIM == 0,
-                      "Requested data is not available in this entity");
-        return data;
-    }
-
-    template <std::size_t SUB_DIM>
-    const std::vector<MeshEntity<0, dimension>>& getData() const {
-        static_assert(SUB_DIM == 0,
-                      "Requested data is not available in this entity");
-        return data;
-    }
+    Element(const Mesh<dim>* owner, std::size_t elementID)
+        : MeshEntity<dim, dim>(owner, elementID) {}
 };
 
-constexpr std::size_t exp2(std::size_t power) {
-    if (power == 0) {
-        return 1;
-    }
-    if ((power / 2) * 2 == power) {
-        return exp2(power / 2) * exp2(power / 2);
-    } else {
-        return 2 * exp2(power - 1);
-    }
-}
-}  // namespace Detail
-
 /// Simplified Mesh finite element Mesh for use with the preprocessor.
 ///
 /// A bare minimum Mesh for use with the Preprocessor. This is conceptually the
@@ -411,6 +510,14 @@ constexpr std::size_t exp2(std::size_t power) {
 /// preprocessor. This ensures that we can still store a large mesh for
 /// partitioning.
 ///
+/// All data is kept in flat arrays. The elements store their shape and the
+/// indices of the coordinates of their nodes. For each dimension below the
+/// dimension of the mesh an Detail::IncidenceTable stores which MeshEntity-s
+/// bound each element and which elements each MeshEntity bounds. These tables
+/// are only (re)computed by fixConnectivity(), so after adding nodes and
+/// elements fixConnectivity() should be called before the connectivity of the
+/// Mesh is used.
+///
 /// \tparam dimension The dimension of the Mesh
 template <std::size_t dimension>
 class Mesh {
@@ -432,102 +539,54 @@ class Mesh {
     Mesh() = default;
     ~Mesh() = default;
 
-    Mesh(const Mesh& other)
-        : elementsList(other.elementsList),
-          coordinates(other.coordinates),
-          otherEntities(other.otherEntities) {
-        for (auto& element : elementsList) {
-            element.mesh = this;
-        }
-        copyEntities(tag<dimension>{});
-    }
-
-    Mesh(Mesh&& other)
-        : elementsList(std::move(other.elementsList)),
-          coordinates(std::move(other.coordinates)),
-          otherEntities(std::move(other.otherEntities)) {
-        for (auto& element : elementsList) {
-            element.mesh = this;
-        }
-        copyEntities(tag<dimension>{});
-    }
-
-    Mesh& operator=(const Mesh& other) {
-        elementsList = other.elementsList;
-        coordinates = other.coordinates;
-        otherEntities = other.otherEntities;
-        for (auto& element : elementsList) {
-            element.mesh = this;
-        }
-        copyEntities(tag<dimension>{});
-    }
+    Mesh(const Mesh& other) = default;
+    Mesh(Mesh&& other) = default;
+    Mesh& operator=(const Mesh& other) = default;
+    Mesh& operator=(Mesh&& other) = default;
 
-    Mesh& operator=(Mesh&& other) {
-        elementsList = std::move(other.elementsList);
-        coordinates = std::move(other.coordinates);
-        otherEntities = std::move(other.otherEntities);
-        for (auto& element : elementsList) {
-            element.mesh = this;
-        }
-        copyEntities(tag<dimension>{});
-    }
-
-    std::vector<Element<dimension>>& getElements();
-    const std::vector<Element<dimension>>& getElements() const;
+    EntityRange<dimension, dimension> getElements() const;
     /// Get an element by its index.
     /// \param i The global index of the element
     /// \return The element.
-    Element<dimension>& getElement(std::size_t i) { return getElements()[i]; }
-    const Element<dimension>& getElement(std::size_t i) const {
-        return getElements()[i];
-    }
-    std::size_t getNumberOfElements() const { return getElements().size(); }
+    Element<dimension> getElement(std::size_t i) const;
+    std::size_t getNumberOfElements() const { return elementShapes.size(); }
 
-    std::vector<MeshEntity<dimension - 1, dimension>>& getFaces();
-    const std::vector<MeshEntity<dimension - 1, dimension>>& getFaces() const;
+    EntityRange<dimension - 1, dimension> getFaces() const;
     MeshEntity<dimension - 1, dimension> getFace(std::size_t i) const {
-        return getFaces()[i];
+        return getEntity<dimension - 1>(i);
     };
-    std::size_t getNumberOfFaces() const { return getFaces().size(); }
+    std::size_t getNumberOfFaces() const {
+        return getNumberOfEntities<dimension - 1>();
+    }
 
-    std::vector<MeshEntity<1, dimension>>& getEdges();
-    const std::vector<MeshEntity<1, dimension>>& getEdges() const;
-    MeshEntity<1, dimension> getEdge(std::size_t i) const {
-        return getEdges()[i];
+    EntityRange<1, dimension> getEdges() const;
+    Detail::EntityType<1, dimension> getEdge(std::size_t i) const {
+        return getEntity<1>(i);
     };
-    std::size_t getNumberOfEdges() const { return getEdges().size(); }
+    std::size_t getNumberOfEdges() const { return getNumberOfEntities<1>(); }
 
-    std::vector<MeshEntity<0, dimension>>& getNodes();
-    const std::vector<MeshEntity<0, dimension>>& getNodes() const;
+    EntityRange<0, dimension> getNodes() const;
     MeshEntity<0, dimension> getNode(std::size_t i) const {
-        return getNodes()[i];
+        return getEntity<0>(i);
     };
-    std::size_t getNumberOfNodes() const { return getNodes().size(); }
+    std::size_t getNumberOfNodes() const { return getNumberOfEntities<0>(); }
 
     std::vector<coordinateData>& getNodeCoordinates();
     const std::vector<coordinateData>& getNodeCoordinates() const;
 
     /// Get the list of MeshEntity-s of a specific dimension
     template <int entityDimension>
-    std::vector<MeshEntity<(entityDimension < 0 ? entityDimension + dimension
-                                                : entityDimension),
-                           dimension>>&
-        getEntities();
-    template <int entityDimension>
-    const std::vector<MeshEntity<
-        (entityDimension < 0 ? entityDimension + dimension : entityDimension),
-        dimension>>&
+    EntityRange<(entityDimension < 0 ? entityDimension + dimension
+                                     : entityDimension),
+                dimension>
         getEntities() const;
     template <int entityDimension>
-    MeshEntity<entityDimension, dimension> getEntity(std::size_t i) const {
-        return getEntities<entityDimension>()[i];
-    };
+    Detail::EntityType<(entityDimension < 0 ? entityDimension + dimension
+                                            : entityDimension),
+                       dimension>
+        getEntity(std::size_t i) const;
     template <int entityDimension>
-    std::size_t getNumberOfEntities() const {
-        return entityDimension + dimension >= 0
-                   ? getEntities<entityDimension>().size()
-                   : 0;
-    }
+    std::size_t getNumberOfEntities() const;
 
     /// Set the number of nodes in the Mesh. Will add or remove Nodes as
     /// necessary.
@@ -539,7 +598,10 @@ class Mesh {
         std::size_t nodeIndex,
         LinearAlgebra::SmallVector<dimension> coordinate);
 
-    void addElement(std::vector<std::size_t> nodeCoordinateIDs);
+    /// Add an element with the given coordinates for its nodes. The
+    /// connectivity of the element is only available after the next call to
+    /// fixConnectivity()
+    void addElement(const std::vector<std::size_t>& nodeCoordinateIDs);
 
     void updateCoordinate(std::size_t coordinateIndex,
                           LinearAlgebra::SmallVector<dimension> coordinate) {
@@ -550,138 +612,51 @@ class Mesh {
         return getNodeCoordinates()[coordinateIndex].coordinate;
     }
 
-    bool isValid() const {
-        logger(DEBUG, "The mesh has % elements", getNumberOfElements());
-        for (auto element : getElements()) {
-            if (getElement(element.getGlobalIndex()) != element) {
-                logger(ERROR,
-                       "The index for element % has been set incorrectly",
-                       element.getGlobalIndex());
-                return false;
-            }
-            if (!checkBoundingEntities(element, tag<dimension - 1>{})) {
-                return false;
-            }
-        }
-        return checkEntities(tag<dimension>{});
-    }
-    // todo: is this needed?
-    void fixConnectivity();
+    bool isValid() const;
 
-   private:
-    /// Recursively checks that for each MeshEntity that is adjacent to an
-    /// Element, that that MeshEntity has the Element in its list of adjacent
-    /// Elements.
-    template <std::size_t d>
-    bool checkBoundingEntities(const Element<dimension>& element,
-                               tag<d>) const {
-        for (auto boundingEntity : element.template getIncidenceList<d>()) {
-            auto candidateElements = boundingEntity.getElementsList();
-            if (std::find(candidateElements.begin(), candidateElements.end(),
-                          element) == candidateElements.end()) {
-                logger(ERROR,
-                       "The element is bounded by a %-dimensional shape that "
-                       "is not near the element",
-                       d);
-                return false;
-            }
-        }
-        return checkBoundingEntities(element, tag<d - 1>{});
-    }
-    // Base case.
-    bool checkBoundingEntities(const Element<dimension>& element,
-                               tag<0>) const {
-        for (auto boundingEntity : element.template getIncidenceList<0>()) {
-            auto candidateElements = boundingEntity.getElementsList();
-            if (std::find(candidateElements.begin(), candidateElements.end(),
-                          element) == candidateElements.end()) {
-                logger(ERROR,
-                       "The element is bounded by a %-dimensional shape that "
-                       "is not near the element",
-                       0);
-                return false;
-            }
-        }
-        return true;
-    }
+    /// Compute the MeshEntity-s of all dimensions in between nodes and
+    /// elements and the incidence tables from the nodes of the elements.
+    /// MeshEntity-s are numbered in the order they are first encountered when
+    /// going through the elements in order.
+    void fixConnectivity();
 
-    // do the elements bounded by this 'face' know this
-    /// Reverse of checkBoundingEntities(). For each MeshEntity, check for all
-    /// pairs of (adjecent Element, localIndex) that the MeshEntity is indeed at
-    /// localIndex of the Element.
-    template <std::size_t d>
-    bool checkEntities(tag<d>) const {
-        for (auto entity : otherEntities.template getData<d>()) {
-            for (std::size_t i = 0; i < entity.getNumberOfElements(); ++i) {
-                if (entity !=
-                    entity.getElement(i).template getIncidentEntity<d>(
-                        entity.getLocalIndex(i))) {
-                    logger(ERROR,
-                           "This %-dimensional shape is adjacent to an element "
-                           "that is not bounded by this shape",
-                           d);
-                    return false;
-                }
-            }
-        }
-        return checkEntities(tag<d - 1>{});
-    }
-    // Base case.
-    bool checkEntities(tag<0>) const {
-        for (auto entity : otherEntities.template getData<0>()) {
-            for (std::size_t i = 0; i < entity.getNumberOfElements(); ++i) {
-                if (entity !=
-                    entity.getElement(i).template getIncidentEntity<0>(
-                        entity.getLocalIndex(i))) {
-                    logger(ERROR,
-                           "This %-dimensional shape is adjacent to an element "
-                           "that is not bounded by this shape",
-                           0);
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
+    /// The number of bytes allocated for the topology and geometry of the mesh
+    std::size_t getMemoryUsage() const;
 
-    template <std::size_t d>
-    void fixElement(Element<dimension>& element, tag<d>);
-    void fixElement(Element<dimension>& element, tag<1>);
-    void fixElement(Element<dimension>& element, tag<0>) {}
+   private:
+    template <std::size_t, std::size_t>
+    friend class MeshEntity;
+    friend Element<dimension>;
 
-    template <std::size_t d>
-    void copyEntities(tag<d>) {
-        for (auto& entity : otherEntities.template getData<d>()) {
-            entity.mesh = this;
-        }
-        copyEntities(tag<d - 1>{});
-    }
-    void copyEntities(tag<0>) {
-        for (auto& entity : otherEntities.template getData<0>()) {
-            entity.mesh = this;
-        }
+    /// The incidence table for MeshEntity-s of dimension d < dimension
+    const Detail::IncidenceTable& getIncidenceTable(std::size_t d) const {
+        logger.assert_debug(d < dimension,
+                            "The elements are not stored in an incidence table");
+        logger.assert_debug(connectivityIsCurrent,
+                            "The connectivity of the mesh is out of date, "
+                            "call fixConnectivity() first");
+        return incidences[d];
     }
 
+    /// Recursively find the MeshEntity-s of dimension 1 to d
     template <std::size_t d>
-    void fixEntity(Element<dimension>& element, std::size_t i);
-
-    template <std::size_t entityDimension>
-    std::size_t newEntity() {
-        std::size_t newIndex =
-            otherEntities.template getData<entityDimension>().size();
-        otherEntities.template getData<entityDimension>().push_back(
-            {this, newIndex});
-        return newIndex;
-    }
+    void findEntities(tag<d>);
+    void findEntities(tag<0>) {}
 
     const ElementShape<dimension>* findGeometry(std::size_t numberOfNodes);
 
-    std::vector<Element<dimension>> elementsList;
+    /// The shape of each element
+    std::vector<const ElementShape<dimension>*> elementShapes;
+    /// The coordinates of the nodes of element e are
+    /// elementCoordinateIndices[elementCoordinateOffsets[e]] up to (not
+    /// including) elementCoordinateIndices[elementCoordinateOffsets[e + 1]]
+    std::vector<std::size_t> elementCoordinateOffsets = {0};
+    std::vector<std::size_t> elementCoordinateIndices;
     std::vector<coordinateData> coordinates;
-    // re-stores slices of the elements for consistent use of getEntities<d>,
-    // algorithms that need elements can un-slice by asking for the first (and
-    // only) element
-    Detail::MeshEntities<dimension> otherEntities;
+    /// The connectivity of the nodes (0) up to the faces (dimension - 1)
+    std::array<Detail::IncidenceTable, dimension> incidences;
+    /// Whether the incidence tables match the nodes and elements
+    bool connectivityIsCurrent = true;
 };
 
 // for use with file readers that can 'guess' the correct numbering of the node
@@ -702,6 +677,7 @@ Mesh<dimension> readFile(file_t& file) {
     for (auto element : file.getElements()) {
         result.addElement(element);
     }
+    result.fixConnectivity();
     logger.assert_debug(result.isValid(), "Unspecified problem with the mesh");
     return result;
 };
@@ -103,6 +103,7 @@ class MeshData {
     }
 
     dataType* data() { return data_.data(); }
+    const dataType* data() const { return data_.data(); }
 
     std::size_t size() { return data_.size(); }
 
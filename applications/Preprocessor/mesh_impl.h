@@ -38,27 +38,75 @@
 
 #include "mesh.h"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace hpgem;
 
 namespace Preprocessor {
 
+inline void Detail::IncidenceTable::transpose() {
+    std::size_t numberOfElements = elementOffsets.size() - 1;
+    entityOffsets.assign(numberOfEntities + 1, 0);
+    for (auto entity : elementEntities) {
+        ++entityOffsets[entity + 1];
+    }
+    std::partial_sum(entityOffsets.begin(), entityOffsets.end(),
+                     entityOffsets.begin());
+    entityElements.resize(elementEntities.size());
+    entityLocalIndices.resize(elementEntities.size());
+    // going through the elements in order keeps the elements of each entity
+    // sorted
+    std::vector<std::size_t> nextPosition(entityOffsets.begin(),
+                                          entityOffsets.end() - 1);
+    for (std::size_t element = 0; element < numberOfElements; ++element) {
+        for (std::size_t i = elementOffsets[element];
+             i < elementOffsets[element + 1]; ++i) {
+            std::size_t position = nextPosition[elementEntities[i]]++;
+            entityElements[position] = element;
+            entityLocalIndices[position] = i - elementOffsets[element];
+        }
+    }
+}
+
+inline std::size_t Detail::IncidenceTable::getMemoryUsage() const {
+    return sizeof(std::size_t) *
+           (elementOffsets.capacity() + elementEntities.capacity() +
+            entityOffsets.capacity() + entityElements.capacity() +
+            entityLocalIndices.capacity());
+}
+
 template <std::size_t entityDimension, std::size_t meshDimension>
-Element<meshDimension>& MeshEntity<entityDimension, meshDimension>::getElement(
-    std::size_t i) {
-    return mesh->getElement(elementIDs[i]);
-};
+auto EntityRange<entityDimension, meshDimension>::operator[](
+    std::size_t i) const -> value_type {
+    return mesh->template getEntity<entityDimension>(getGlobalIndex(i));
+}
 
 template <std::size_t entityDimension, std::size_t meshDimension>
-const Element<meshDimension>&
-    MeshEntity<entityDimension, meshDimension>::getElement(
-        std::size_t i) const {
-    return mesh->getElement(elementIDs[i]);
+const Detail::IncidenceTable&
+    MeshEntity<entityDimension, meshDimension>::getTable() const {
+    return mesh->getIncidenceTable(entityDimension);
+}
+
+template <std::size_t entityDimension, std::size_t meshDimension>
+Element<meshDimension> MeshEntity<entityDimension, meshDimension>::getElement(
+    std::size_t i) const {
+    if (entityDimension == meshDimension) {
+        logger.assert_debug(i == 0, "An element only contains itself");
+        return mesh->getElement(entityID);
+    }
+    logger.assert_debug(i < getNumberOfElements(),
+                        "Asked for element %, but there are only %", i,
+                        getNumberOfElements());
+    const auto& table = getTable();
+    return mesh->getElement(
+        table.entityElements[table.entityOffsets[entityID] + i]);
 }
 
 template <std::size_t entityDimension, std::size_t meshDimension>
 std::size_t MeshEntity<entityDimension, meshDimension>::getElementIndex(
     const Element<meshDimension>& element) const {
-    for (std::size_t i = 0; i < elementIDs.size(); ++i) {
+    for (std::size_t i = 0; i < getNumberOfElements(); ++i) {
         if (getElement(i) == element) {
             return i;
         }
@@ -70,27 +118,27 @@ std::size_t MeshEntity<entityDimension, meshDimension>::getElementIndex(
 template <std::size_t entityDimension, std::size_t meshDimension>
 std::size_t MeshEntity<entityDimension, meshDimension>::getNumberOfElements()
     const {
-    return elementIDs.size();
+    if (entityDimension == meshDimension) {
+        return 1;
+    }
+    const auto& table = getTable();
+    return table.entityOffsets[entityID + 1] - table.entityOffsets[entityID];
 }
 
 template <std::size_t entityDimension, std::size_t meshDimension>
 std::size_t MeshEntity<entityDimension, meshDimension>::getLocalIndex(
     std::size_t i) const {
-    return localIDs[i];
+    if (entityDimension == meshDimension) {
+        return 0;
+    }
+    const auto& table = getTable();
+    return table.entityLocalIndices[table.entityOffsets[entityID] + i];
 }
 
 template <std::size_t entityDimension, std::size_t meshDimension>
 std::size_t MeshEntity<entityDimension, meshDimension>::getLocalIndex(
     const Element<meshDimension>& element) const {
-    for (std::size_t i = 0; i < elementIDs.size(); ++i) {
-        if (getElement(i).getGlobalIndex() == element.getGlobalIndex()) {
-            logger.assert_debug(getElement(i) == element,
-                                "Two different elements got the same index");
-            return localIDs[i];
-        }
-    }
-    logger(ERROR, "Element not found");
-    return 0;
+    return getLocalIndex(getElementIndex(element));
 }
 
 template <std::size_t entityDimension, std::size_t meshDimension>
@@ -100,131 +148,152 @@ std::size_t MeshEntity<entityDimension, meshDimension>::getGlobalIndex() const {
 
 template <std::size_t entityDimension, std::size_t meshDimension>
 template <int d>
-std::vector<MeshEntity<(d < 0 ? d + meshDimension : d), meshDimension>>
+EntityRange<(d < 0 ? d + meshDimension : d), meshDimension>
     MeshEntity<entityDimension, meshDimension>::getIncidenceList() const {
-    auto indices = getIncidenceListAsIndices<d>();
-    std::vector<MeshEntity<(d < 0 ? d + meshDimension : d), meshDimension>>
-        result(indices.size());
-    for (std::size_t i = 0; i < indices.size(); ++i) {
-        result[i] = mesh->template getEntity<(d < 0 ? d + meshDimension : d)>(
-            indices[i]);
-    }
-    return result;
+    static_assert(d + static_cast<int>(meshDimension) >= 0,
+                  "The codimension you are interested in is too high for the "
+                  "dimension of this object");
+    constexpr std::size_t actualDimension = (d < 0 ? d + meshDimension : d);
+    return computeIncidenceList<actualDimension>(
+        incidenceCase<actualDimension>{});
 }
 
 template <std::size_t entityDimension, std::size_t meshDimension>
-template <int d>
-std::vector<std::size_t> MeshEntity<
-    entityDimension, meshDimension>::getIncidenceListAsIndices() const {
-    static_assert(d + entityDimension >= 0,
-                  "The codimension you are interested in is too high for the "
-                  "dimension of this object");
-    if (d < 0) {
-        return getIncidenceListAsIndices<(d < 0 ? d + meshDimension : d)>();
-    }
-    if (d == entityDimension) {
-        return {getGlobalIndex()};
-    }
-    if (d == meshDimension) {
-        return std::vector<std::size_t>(elementIDs.begin(), elementIDs.end());
-    } else if (d < entityDimension) {
-        // easy case: all adjacent entities of this entityDimension are adjacent
-        // to all adjacent elements
-        return getElement(0).template getIncidenceListAsIndices<d>(*this);
-    } else {
-        std::vector<std::size_t> result;
-        for (auto elementID : elementIDs) {
-            const auto& element = mesh->getElement(elementID);
-            std::vector<std::size_t> newEntries =
-                element.template getIncidenceListAsIndices<d>(*this);
-            result.insert(result.end(), newEntries.begin(), newEntries.end());
+template <std::size_t d>
+EntityRange<d, meshDimension>
+    MeshEntity<entityDimension, meshDimension>::computeIncidenceList(
+        std::integral_constant<int, 0>) const {
+    return {mesh, entityID, 1};
+}
+
+template <std::size_t entityDimension, std::size_t meshDimension>
+template <std::size_t d>
+EntityRange<d, meshDimension>
+    MeshEntity<entityDimension, meshDimension>::computeIncidenceList(
+        std::integral_constant<int, 1>) const {
+    const auto& table = getTable();
+    return {mesh, table.entityElements.data() + table.entityOffsets[entityID],
+            getNumberOfElements()};
+}
+
+template <std::size_t entityDimension, std::size_t meshDimension>
+template <std::size_t d>
+EntityRange<d, meshDimension>
+    MeshEntity<entityDimension, meshDimension>::computeIncidenceList(
+        std::integral_constant<int, 2>) const {
+    const auto& table = mesh->getIncidenceTable(d);
+    return {mesh, table.elementEntities.data() + table.elementOffsets[entityID],
+            table.elementOffsets[entityID + 1] - table.elementOffsets[entityID]};
+}
+
+template <std::size_t entityDimension, std::size_t meshDimension>
+template <std::size_t d>
+EntityRange<d, meshDimension>
+    MeshEntity<entityDimension, meshDimension>::computeIncidenceList(
+        std::integral_constant<int, 3>) const {
+    // easy case: all adjacent entities of this dimension are adjacent to all
+    // adjacent elements
+    const auto& table = mesh->getIncidenceTable(d);
+    std::size_t elementID = getElement(0).getGlobalIndex();
+    return {mesh, table.elementEntities.data() + table.elementOffsets[elementID],
+            mesh->elementShapes[elementID]
+                ->template getStoredAdjacentEntities<entityDimension, d>(
+                    getLocalIndex(0))};
+}
+
+template <std::size_t entityDimension, std::size_t meshDimension>
+template <std::size_t d>
+EntityRange<d, meshDimension>
+    MeshEntity<entityDimension, meshDimension>::computeIncidenceList(
+        std::integral_constant<int, 4>) const {
+    const auto& table = mesh->getIncidenceTable(d);
+    std::vector<std::size_t> result;
+    for (std::size_t i = 0; i < getNumberOfElements(); ++i) {
+        std::size_t elementID = getElement(i).getGlobalIndex();
+        for (auto localIndex :
+             mesh->elementShapes[elementID]
+                 ->template getStoredAdjacentEntities<entityDimension, d>(
+                     getLocalIndex(i))) {
+            result.push_back(
+                table.elementEntities[table.elementOffsets[elementID] +
+                                      localIndex]);
         }
-        std::sort(result.begin(), result.end());
-        result.erase(std::unique(result.begin(), result.end()), result.end());
-        return result;
     }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return {mesh, std::move(result)};
 }
 
 template <std::size_t entityDimension, std::size_t meshDimension>
-void MeshEntity<entityDimension, meshDimension>::addElement(
-    std::size_t elementID, std::size_t localEntityIndex) {
-    elementIDs.push_back(elementID);
-    localIDs.push_back(localEntityIndex);
+template <int d>
+std::vector<std::size_t> MeshEntity<
+    entityDimension, meshDimension>::getIncidenceListAsIndices() const {
+    auto list = getIncidenceList<d>();
+    std::vector<std::size_t> result(list.size());
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        result[i] = list.getGlobalIndex(i);
+    }
+    return result;
 }
 
 template <std::size_t entityDimension, std::size_t meshDimension>
 bool MeshEntity<entityDimension, meshDimension>::operator==(
     const MeshEntity& other) const {
-    return mesh == other.mesh && entityID == other.entityID &&
-           elementIDs == other.elementIDs && localIDs == other.localIDs;
+    return mesh == other.mesh && entityID == other.entityID;
 }
 
 template <std::size_t dimension>
 bool Element<dimension>::operator==(const Element& other) const {
     return static_cast<const MeshEntity<dimension, dimension>&>(*this) ==
-               static_cast<const MeshEntity<dimension, dimension>&>(other) &&
-           other.globalCoordinateIndices == globalCoordinateIndices &&
-           other.incidenceLists == incidenceLists;
+           static_cast<const MeshEntity<dimension, dimension>&>(other);
 }
 
 template <std::size_t dimension>
 LinearAlgebra::SmallVector<dimension> Element<dimension>::getCoordinate(
     std::size_t localIndex) const {
-    return this->mesh->getCoordinate(globalCoordinateIndices[localIndex]);
+    return this->mesh->getCoordinate(getCoordinateIndex(localIndex));
 }
 
 template <std::size_t dimension>
 std::size_t Element<dimension>::getCoordinateIndex(
     std::size_t localIndex) const {
-    return globalCoordinateIndices[localIndex];
+    logger.assert_debug(localIndex < getShape()->getNumberOfNodes(),
+                        "Asked for node %, but there are only %", localIndex,
+                        getShape()->getNumberOfNodes());
+    return this->mesh->elementCoordinateIndices
+        [this->mesh->elementCoordinateOffsets[this->entityID] + localIndex];
 }
 
 template <std::size_t dimension>
 std::vector<LinearAlgebra::SmallVector<dimension>>
     Element<dimension>::getCoordinatesList() const {
     std::vector<LinearAlgebra::SmallVector<dimension>> result;
-    result.reserve(referenceGeometry->getNumberOfNodes());
-    for (std::size_t i = 0; i < referenceGeometry->getNumberOfNodes(); ++i) {
+    result.reserve(getShape()->getNumberOfNodes());
+    for (std::size_t i = 0; i < getShape()->getNumberOfNodes(); ++i) {
         result.push_back(getCoordinate(i));
     }
     return result;
 }
 
 template <std::size_t dimension>
-void Element<dimension>::setNodeCoordinate(
-    std::size_t localIndex,
-    LinearAlgebra::SmallVector<dimension> newCoordinate) {
-    std::size_t globalIndex = globalCoordinateIndices[localIndex];
-    this->mesh->updateCoordinate(globalIndex, newCoordinate);
-}
-
-template <std::size_t dimension>
-void Element<dimension>::setNode(std::size_t localIndex,
-                                 std::size_t globalIndex,
-                                 std::size_t coordinateIndex) {
-    incidenceLists[0][localIndex] = globalIndex;
-    globalCoordinateIndices[localIndex] = coordinateIndex;
-}
-
-template <std::size_t dimension>
-template <std::size_t d>
-std::enable_if_t<(d > 0)> Element<dimension>::setEntity(
-    std::size_t localIndex, std::size_t globalIndex) {
-    incidenceLists[d][localIndex] = globalIndex;
+const ElementShape<dimension>* Element<dimension>::getShape() const {
+    return this->mesh->elementShapes[this->entityID];
 }
 
 template <std::size_t dimension>
 template <int d, std::size_t entityDimension>
-std::vector<MeshEntity<(d < 0 ? d + dimension : d), dimension>>
+std::vector<Detail::EntityType<(d < 0 ? d + dimension : d), dimension>>
     Element<dimension>::getIncidenceList(
         const MeshEntity<entityDimension, dimension>& entity) const {
     auto indices = getIncidenceListAsIndices<d>(entity);
-    std::vector<MeshEntity<(d < 0 ? d + dimension : d), dimension>> result(
-        indices.size());
-    for (std::size_t i = 0; i < indices.size(); ++i) {
-        result[i] = this->mesh->template getEntity<(d < 0 ? d + dimension : d)>(
-            indices[i]);
+    std::vector<Detail::EntityType<(d < 0 ? d + dimension : d), dimension>>
+        result;
+    result.reserve(indices.size());
+    for (auto index : indices) {
+        result.push_back(
+            this->mesh->template getEntity<(d < 0 ? d + dimension : d)>(index));
     }
+    return result;
 }
 
 template <std::size_t dimension>
@@ -232,8 +301,9 @@ template <int d, std::size_t entityDimension>
 std::vector<std::size_t> Element<dimension>::getIncidenceListAsIndices(
     const MeshEntity<entityDimension, dimension>& entity) const {
     auto result = getLocalIncidenceListAsIndices<d>(entity);
+    auto globalIndices = getIncidenceList<d>();
     for (auto& index : result) {
-        index = incidenceLists[(d < 0 ? d + dimension : d)][index];
+        index = globalIndices.getGlobalIndex(index);
     }
     return result;
 }
@@ -242,101 +312,79 @@ template <std::size_t dimension>
 template <int d, std::size_t entityDimension>
 std::vector<std::size_t> Element<dimension>::getLocalIncidenceListAsIndices(
     const MeshEntity<entityDimension, dimension>& entity) const {
-    static_assert(d + dimension >= 0,
+    static_assert(d + static_cast<int>(dimension) >= 0,
                   "The requested codimension is too high for the dimension of "
                   "this element");
     constexpr std::size_t actualDimension = (d < 0 ? d + dimension : d);
-    if (incidenceLists[actualDimension].size() <
-        referenceGeometry->template getNumberOfEntities<actualDimension>())
-        return {};
-    std::vector<std::size_t> result =
-        referenceGeometry
-            ->template getAdjacentEntities<entityDimension, actualDimension>(
-                entity.getLocalIndex(*this));
-    return result;
+    return getShape()
+        ->template getAdjacentEntities<entityDimension, actualDimension>(
+            entity.getLocalIndex(*this));
 }
 
 template <std::size_t dimension>
-void Element<dimension>::addNode(std::size_t globalNodeIndex,
-                                 std::size_t coordinateIndex) {
-    incidenceLists[0].push_back(globalNodeIndex);
-    globalCoordinateIndices.push_back(coordinateIndex);
+EntityRange<dimension, dimension> Mesh<dimension>::getElements() const {
+    return getEntities<dimension>();
 }
 
 template <std::size_t dimension>
-template <std::size_t d>
-std::enable_if_t<(d > 0)> Element<dimension>::addEntity(
-    std::size_t globalIndex) {
-    incidenceLists[d].push_back(globalIndex);
+Element<dimension> Mesh<dimension>::getElement(std::size_t i) const {
+    logger.assert_debug(i < getNumberOfElements(),
+                        "Asked for element %, but there are only %", i,
+                        getNumberOfElements());
+    return {this, i};
 }
 
 template <std::size_t dimension>
-std::vector<Element<dimension>>& Mesh<dimension>::getElements() {
-    return elementsList;
-}
-
-template <std::size_t dimension>
-const std::vector<Element<dimension>>& Mesh<dimension>::getElements() const {
-    return elementsList;
-}
-
-template <std::size_t dimension>
-std::vector<MeshEntity<dimension - 1, dimension>>& Mesh<dimension>::getFaces() {
+EntityRange<dimension - 1, dimension> Mesh<dimension>::getFaces() const {
     return getEntities<dimension - 1>();
 }
 
 template <std::size_t dimension>
-const std::vector<MeshEntity<dimension - 1, dimension>>&
-    Mesh<dimension>::getFaces() const {
-    return getEntities<dimension - 1>();
-}
-
-template <std::size_t dimension>
-std::vector<MeshEntity<1, dimension>>& Mesh<dimension>::getEdges() {
+EntityRange<1, dimension> Mesh<dimension>::getEdges() const {
     return getEntities<1>();
 }
 
 template <std::size_t dimension>
-const std::vector<MeshEntity<1, dimension>>& Mesh<dimension>::getEdges() const {
-    return getEntities<1>();
-}
-
-template <std::size_t dimension>
-std::vector<MeshEntity<0, dimension>>& Mesh<dimension>::getNodes() {
+EntityRange<0, dimension> Mesh<dimension>::getNodes() const {
     return getEntities<0>();
 }
 
 template <std::size_t dimension>
-const std::vector<MeshEntity<0, dimension>>& Mesh<dimension>::getNodes() const {
-    return getEntities<0>();
+template <int entityDimension>
+EntityRange<(entityDimension < 0 ? entityDimension + dimension
+                                 : entityDimension),
+            dimension>
+    Mesh<dimension>::getEntities() const {
+    static_assert(entityDimension + static_cast<int>(dimension) >= 0,
+                  "The requested codimension is too high for the dimension of "
+                  "this element");
+    return {this, std::size_t{0}, getNumberOfEntities<entityDimension>()};
 }
 
 template <std::size_t dimension>
 template <int entityDimension>
-std::vector<MeshEntity<(entityDimension < 0 ? entityDimension + dimension
-                                            : entityDimension),
-                       dimension>>&
-    Mesh<dimension>::getEntities() {
-    static_assert(entityDimension + dimension >= 0,
-                  "The requested codimension is too high for the dimension of "
-                  "this element");
-    constexpr std::size_t actualDimension =
-        (entityDimension < 0 ? entityDimension + dimension : entityDimension);
-    return otherEntities.template getData<actualDimension>();
-};
+Detail::EntityType<(entityDimension < 0 ? entityDimension + dimension
+                                        : entityDimension),
+                   dimension>
+    Mesh<dimension>::getEntity(std::size_t i) const {
+    logger.assert_debug(i < getNumberOfEntities<entityDimension>(),
+                        "Asked for entity %, but there are only %", i,
+                        getNumberOfEntities<entityDimension>());
+    return {this, i};
+}
 
 template <std::size_t dimension>
 template <int entityDimension>
-const std::vector<MeshEntity<(entityDimension < 0 ? entityDimension + dimension
-                                                  : entityDimension),
-                             dimension>>&
-    Mesh<dimension>::getEntities() const {
-    static_assert(entityDimension + dimension >= 0,
-                  "The requested codimension is too high for the dimension of "
-                  "this element");
+std::size_t Mesh<dimension>::getNumberOfEntities() const {
+    if (entityDimension + static_cast<int>(dimension) < 0) {
+        return 0;
+    }
     constexpr std::size_t actualDimension =
         (entityDimension < 0 ? entityDimension + dimension : entityDimension);
-    return otherEntities.template getData<actualDimension>();
+    if (actualDimension == dimension) {
+        return getNumberOfElements();
+    }
+    return incidences[actualDimension].numberOfEntities;
 }
 
 template <std::size_t dimension>
@@ -353,23 +401,18 @@ const std::vector<typename Mesh<dimension>::coordinateData>&
 
 template <std::size_t dimension>
 void Mesh<dimension>::setNumberOfNodes(std::size_t number) {
-    if (number < otherEntities.template getData<0>().size()) {
-        otherEntities.template getData<0>().resize(number);
-    } else
-        addNodes(number - otherEntities.template getData<0>().size());
+    incidences[0].numberOfEntities = number;
+    connectivityIsCurrent = false;
 }
 
 template <std::size_t dimension>
 void Mesh<dimension>::addNode() {
-    std::size_t newIndex = otherEntities.template getData<0>().size();
-    otherEntities.template getData<0>().push_back({this, newIndex});
+    addNodes(1);
 }
 
 template <std::size_t dimension>
 void Mesh<dimension>::addNodes(std::size_t count) {
-    for (std::size_t i = 0; i < count; ++i) {
-        addNode();
-    }
+    setNumberOfNodes(getNumberOfNodes() + count);
 }
 
 template <std::size_t dimension>
@@ -380,81 +423,188 @@ std::size_t Mesh<dimension>::addNodeCoordinate(
 }
 
 template <std::size_t dimension>
-void Mesh<dimension>::addElement(std::vector<std::size_t> nodeCoordinateIDs) {
-    std::size_t elementID = elementsList.size();
-    Element<dimension> newElement{this, elementID};
-    newElement.setGeometry(findGeometry(nodeCoordinateIDs.size()));
-    for (auto coordinateID : nodeCoordinateIDs) {
-        std::size_t nodeID = coordinates[coordinateID].nodeIndex;
-        newElement.addNode(nodeID, coordinateID);
+void Mesh<dimension>::addElement(
+    const std::vector<std::size_t>& nodeCoordinateIDs) {
+    elementShapes.push_back(findGeometry(nodeCoordinateIDs.size()));
+    elementCoordinateIndices.insert(elementCoordinateIndices.end(),
+                                    nodeCoordinateIDs.begin(),
+                                    nodeCoordinateIDs.end());
+    elementCoordinateOffsets.push_back(elementCoordinateIndices.size());
+    connectivityIsCurrent = false;
+}
+
+template <std::size_t dimension>
+bool Mesh<dimension>::isValid() const {
+    logger(DEBUG, "The mesh has % elements", getNumberOfElements());
+    if (!connectivityIsCurrent) {
+        logger(ERROR, "The connectivity of the mesh is out of date");
+        return false;
     }
-    elementsList.push_back(newElement);
-    otherEntities.template getData<dimension>().push_back(newElement);
-    for (std::size_t i = 0; i < nodeCoordinateIDs.size(); ++i) {
-        auto coordinateID = nodeCoordinateIDs[i];
-        std::size_t nodeID = coordinates[coordinateID].nodeIndex;
-        otherEntities.template getData<0>()[nodeID].addElement(elementID, i);
+    for (std::size_t d = 0; d < dimension; ++d) {
+        const auto& table = incidences[d];
+        if (table.elementOffsets.size() != getNumberOfElements() + 1 ||
+            table.entityOffsets.size() != table.numberOfEntities + 1) {
+            logger(ERROR,
+                   "The incidence table of the %-dimensional shapes has the "
+                   "wrong size",
+                   d);
+            return false;
+        }
+        // Checks that for each MeshEntity that is adjacent to an Element, that
+        // that MeshEntity has the Element in its list of adjacent Elements.
+        for (std::size_t element = 0; element < getNumberOfElements();
+             ++element) {
+            for (std::size_t i = table.elementOffsets[element];
+                 i < table.elementOffsets[element + 1]; ++i) {
+                std::size_t entity = table.elementEntities[i];
+                auto first =
+                    table.entityElements.begin() + table.entityOffsets[entity];
+                auto last = table.entityElements.begin() +
+                            table.entityOffsets[entity + 1];
+                if (std::find(first, last, element) == last) {
+                    logger(ERROR,
+                           "The element is bounded by a %-dimensional shape "
+                           "that is not near the element",
+                           d);
+                    return false;
+                }
+            }
+        }
+        // Reverse of the above. For each MeshEntity, check for all pairs of
+        // (adjacent Element, localIndex) that the MeshEntity is indeed at
+        // localIndex of the Element.
+        for (std::size_t entity = 0; entity < table.numberOfEntities;
+             ++entity) {
+            for (std::size_t i = table.entityOffsets[entity];
+                 i < table.entityOffsets[entity + 1]; ++i) {
+                std::size_t element = table.entityElements[i];
+                if (table.elementEntities[table.elementOffsets[element] +
+                                          table.entityLocalIndices[i]] !=
+                    entity) {
+                    logger(ERROR,
+                           "This %-dimensional shape is adjacent to an element "
+                           "that is not bounded by this shape",
+                           d);
+                    return false;
+                }
+            }
+        }
     }
-    fixElement(elementsList.back(), tag<dimension - 1>{});
+    return true;
 }
 
 template <std::size_t dimension>
 void Mesh<dimension>::fixConnectivity() {
-    for (auto& element : getElements()) {
-        fixElement(element, tag<dimension - 1>{});
+    auto& nodes = incidences[0];
+    nodes.elementOffsets = elementCoordinateOffsets;
+    nodes.elementEntities.resize(elementCoordinateIndices.size());
+    for (std::size_t i = 0; i < elementCoordinateIndices.size(); ++i) {
+        nodes.elementEntities[i] =
+            coordinates[elementCoordinateIndices[i]].nodeIndex;
     }
+    nodes.transpose();
+    findEntities(tag<dimension - 1>{});
+    connectivityIsCurrent = true;
 }
 
 template <std::size_t dimension>
 template <std::size_t d>
-void Mesh<dimension>::fixElement(Element<dimension>& element, tag<d>) {
-    for (std::size_t i = element.incidenceLists[d].size();
-         i < element.referenceGeometry->template getNumberOfEntities<d>();
-         ++i) {
-        fixEntity<d>(element, i);
+void Mesh<dimension>::findEntities(tag<d>) {
+    findEntities(tag<d - 1>{});
+    const auto& nodes = incidences[0];
+    auto& table = incidences[d];
+    std::size_t numberOfElements = getNumberOfElements();
+    table.elementOffsets.resize(numberOfElements + 1);
+    for (std::size_t element = 0; element < numberOfElements; ++element) {
+        table.elementOffsets[element + 1] =
+            table.elementOffsets[element] +
+            elementShapes[element]->template getNumberOfEntities<d>();
     }
-    fixElement(element, tag<d - 1>{});
-}
-
-template <std::size_t dimension>
-void Mesh<dimension>::fixElement(Element<dimension>& element, tag<1>) {
-    for (std::size_t i = element.incidenceLists[1].size();
-         i < element.referenceGeometry->template getNumberOfEntities<1>();
-         ++i) {
-        fixEntity<1>(element, i);
+    std::size_t numberOfIncidences = table.elementOffsets.back();
+    // the sorted global indices of the nodes of a bounding entity, so the same
+    // entity gives the same nodes, independent of the element
+    auto getEntityNodes = [&](std::size_t incidence,
+                              std::vector<std::size_t>& result) {
+        std::size_t element =
+            std::upper_bound(table.elementOffsets.begin(),
+                             table.elementOffsets.end(), incidence) -
+            table.elementOffsets.begin() - 1;
+        const auto& localNodes =
+            elementShapes[element]->template getStoredAdjacentEntities<d, 0>(
+                incidence - table.elementOffsets[element]);
+        result.resize(localNodes.size());
+        for (std::size_t i = 0; i < localNodes.size(); ++i) {
+            result[i] = nodes.elementEntities[nodes.elementOffsets[element] +
+                                              localNodes[i]];
+        }
+        std::sort(result.begin(), result.end());
+    };
+    // Group the incidences by the lowest node of the entity with a counting
+    // sort. All incidences of an entity end up in the same group and the
+    // groups are small, so the incidences of the same entity can be found by
+    // comparing the nodes within a group.
+    std::vector<std::size_t> entityNodes;
+    std::vector<std::size_t> groupOffsets(getNumberOfNodes() + 1, 0);
+    table.elementEntities.resize(numberOfIncidences);
+    for (std::size_t i = 0; i < numberOfIncidences; ++i) {
+        getEntityNodes(i, entityNodes);
+        table.elementEntities[i] = entityNodes[0];
+        ++groupOffsets[entityNodes[0] + 1];
+    }
+    std::partial_sum(groupOffsets.begin(), groupOffsets.end(),
+                     groupOffsets.begin());
+    std::vector<std::size_t> groupedIncidences(numberOfIncidences);
+    {
+        std::vector<std::size_t> nextPosition(groupOffsets.begin(),
+                                              groupOffsets.end() - 1);
+        for (std::size_t i = 0; i < numberOfIncidences; ++i) {
+            groupedIncidences[nextPosition[table.elementEntities[i]]++] = i;
+        }
     }
+    // within a group the incidences are sorted, so the first incidence with
+    // the same nodes is the first incidence of the entity overall, store its
+    // position in elementEntities for now
+    std::vector<std::vector<std::size_t>> groupNodes;
+    for (std::size_t group = 0; group < getNumberOfNodes(); ++group) {
+        std::size_t groupSize = groupOffsets[group + 1] - groupOffsets[group];
+        if (groupNodes.size() < groupSize) {
+            groupNodes.resize(groupSize);
+        }
+        for (std::size_t i = 0; i < groupSize; ++i) {
+            std::size_t incidence = groupedIncidences[groupOffsets[group] + i];
+            getEntityNodes(incidence, groupNodes[i]);
+            std::size_t first = 0;
+            while (groupNodes[first] != groupNodes[i]) {
+                ++first;
+            }
+            table.elementEntities[incidence] =
+                groupedIncidences[groupOffsets[group] + first];
+        }
+    }
+    groupedIncidences = std::vector<std::size_t>();
+    groupOffsets = std::vector<std::size_t>();
+    // number the entities in the order of their first incidence
+    table.numberOfEntities = 0;
+    for (std::size_t i = 0; i < numberOfIncidences; ++i) {
+        std::size_t firstIncidence = table.elementEntities[i];
+        table.elementEntities[i] = (firstIncidence == i)
+                                       ? table.numberOfEntities++
+                                       : table.elementEntities[firstIncidence];
+    }
+    table.transpose();
 }
 
 template <std::size_t dimension>
-template <std::size_t d>
-void Mesh<dimension>::fixEntity(Element<dimension>& element,
-                                std::size_t index) {
-    std::vector<std::size_t> localNodeIndices =
-        element.referenceGeometry->template getAdjacentEntities<d, 0>(index);
-    for (auto& nodeIndex : localNodeIndices) {
-        nodeIndex =
-            element.template getIncidentEntity<0>(nodeIndex).getGlobalIndex();
-    }
-    auto candidates =
-        getNodes()[localNodeIndices[0]].template getIncidenceListAsIndices<d>();
-    std::sort(candidates.begin(), candidates.end());
-    for (std::size_t i = 1; i < localNodeIndices.size(); ++i) {
-        auto newElements = getNodes()[localNodeIndices[i]]
-                               .template getIncidenceListAsIndices<d>();
-        std::sort(newElements.begin(), newElements.end());
-        std::vector<std::size_t> temp;
-        temp.reserve(std::max(candidates.size(), newElements.size()));
-        std::set_intersection(candidates.begin(), candidates.end(),
-                              newElements.begin(), newElements.end(),
-                              std::back_inserter(temp));
-        candidates = std::move(temp);
+std::size_t Mesh<dimension>::getMemoryUsage() const {
+    std::size_t result =
+        sizeof(const ElementShape<dimension>*) * elementShapes.capacity() +
+        sizeof(std::size_t) * (elementCoordinateOffsets.capacity() +
+                               elementCoordinateIndices.capacity()) +
+        sizeof(coordinateData) * coordinates.capacity();
+    for (const auto& table : incidences) {
+        result += table.getMemoryUsage();
     }
-    logger.assert_always(candidates.size() < 2, "mesh data is not consistent");
-    std::size_t entityIndex =
-        (candidates.size() == 1 ? candidates[0] : newEntity<d>());
-    element.template addEntity<d>(entityIndex);
-    otherEntities.template getData<d>()[entityIndex].addElement(
-        element.getGlobalIndex(), index);
+    return result;
 }
 
 template <std::size_t dimension>
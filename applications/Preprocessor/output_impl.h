@@ -38,9 +38,11 @@
 
 #include "output.h"
 #include "LinearAlgebra/SmallVector.h"
+#include "parallel.h"
 #include <fstream>
 #include <set>
 #include <map>
+#include <sstream>
 
 using namespace hpgem;
 
@@ -48,6 +50,37 @@ namespace Detail {
 template <std::size_t d>
 struct tag {};
 
+/// Write the lines for the entities 0 to n - 1 to output. Blocks of entities
+/// are formatted in parallel by format(stream, thread, i), each thread into
+/// its own buffer, after which the buffers are written in order.
+template <typename FormatFunction>
+void formatInParallel(std::ofstream& output, std::size_t n,
+                      FormatFunction&& format) {
+    // large enough to keep the threads busy, small enough to keep the buffers
+    // small compared to the mesh
+    constexpr std::size_t entitiesPerThread = 1 << 14;
+    std::size_t blockSize = entitiesPerThread * Preprocessor::getNumberOfThreads();
+    std::vector<std::string> buffers(Preprocessor::getNumberOfThreads());
+    for (std::size_t blockStart = 0; blockStart < n; blockStart += blockSize) {
+        std::size_t blockEnd = std::min(blockStart + blockSize, n);
+        Preprocessor::parallelFor(
+            blockEnd - blockStart, entitiesPerThread / 4,
+            [&](std::size_t thread, std::size_t begin, std::size_t end) {
+                std::ostringstream stream;
+                stream << std::hexfloat;
+                for (std::size_t i = blockStart + begin; i < blockStart + end;
+                     ++i) {
+                    format(stream, thread, i);
+                }
+                buffers[thread] = stream.str();
+            });
+        for (auto& buffer : buffers) {
+            output << buffer;
+            buffer.clear();
+        }
+    }
+}
+
 template <std::size_t dimension>
 void printOtherEntityCounts(std::ofstream& output,
                             const Preprocessor::Mesh<dimension>& mesh, tag<0>) {
@@ -63,20 +96,23 @@ void printOtherEntityCounts(std::ofstream& output,
 template <std::size_t dimension, typename indexType>
 void printOtherEntities(
     std::ofstream& output, const Preprocessor::Mesh<dimension>& mesh,
-    Preprocessor::MeshData<indexType, dimension, dimension>& partitions,
+    const Preprocessor::MeshData<indexType, dimension, dimension>& partitions,
     tag<0>) {}
 
 template <std::size_t d, std::size_t dimension, typename indexType>
 void printOtherEntities(
     std::ofstream& output, const Preprocessor::Mesh<dimension>& mesh,
-    Preprocessor::MeshData<indexType, dimension, dimension>& partitions,
+    const Preprocessor::MeshData<indexType, dimension, dimension>& partitions,
     tag<d>) {
-    for (auto entity : mesh.template getEntities<d>()) {
+    formatInParallel(output, mesh.template getNumberOfEntities<d>(),
+                     [&](std::ostream& stream, std::size_t,
+                         std::size_t entityIndex) {
+        auto entity = mesh.template getEntity<d>(entityIndex);
         std::set<std::size_t> localPartitions;
-        output << entity.getNumberOfElements() << " ";
+        stream << entity.getNumberOfElements() << " ";
         for (std::size_t i = 0; i < entity.getNumberOfElements(); ++i) {
             auto element = entity.getElement(i);
-            output << element.getGlobalIndex() << " " << entity.getLocalIndex(i)
+            stream << element.getGlobalIndex() << " " << entity.getLocalIndex(i)
                    << " ";
             for (auto node : element.getNodesList()) {
                 for (auto neighbour : node.getElementsList()) {
@@ -84,12 +120,12 @@ void printOtherEntities(
                 }
             }
         }
-        output << localPartitions.size() << " ";
+        stream << localPartitions.size() << " ";
         for (auto partition : localPartitions) {
-            output << partition << " ";
+            stream << partition << " ";
         }
-        output << std::endl;
-    }
+        stream << "\n";
+    });
     printOtherEntities(output, mesh, partitions, tag<d - 1>{});
 }
 }  // namespace Detail
@@ -101,6 +137,9 @@ void Preprocessor::outputMesh(
     if (mesh.getNumberOfNodes() == 0) {
         logger(WARN, "outputting empty mesh");
     }
+    // the output is formatted on several threads, which may only read the
+    // partitions
+    const auto& partitionIDs = partitions;
     std::ofstream output(outputFileName.getValue());
     output << std::hexfloat;
     output << "mesh 1" << std::endl;
@@ -118,22 +157,27 @@ void Preprocessor::outputMesh(
         output << whiteSpace;
     }
     output << std::endl;
-    std::vector<std::size_t> partitionData(numberOfPartitions, 0);
+    // the number of nodes in each partition, counted per thread
+    std::vector<std::vector<std::size_t>> partitionData(
+        getNumberOfThreads(), std::vector<std::size_t>(numberOfPartitions, 0));
     MeshData<std::vector<std::size_t>, dimension, 0> coordinateIndices(&mesh);
-    for (auto node : mesh.getNodes()) {
+    ::Detail::formatInParallel(output, mesh.getNumberOfNodes(), [&](
+                                   std::ostream& stream, std::size_t thread,
+                                   std::size_t nodeIndex) {
+        auto node = mesh.getNode(nodeIndex);
         std::set<std::size_t> nodePartitions;
         std::set<LinearAlgebra::SmallVector<dimension>> nodeCoordinates;
         for (std::size_t i = 0; i < node.getNumberOfElements(); ++i) {
             auto element = node.getElement(i);
-            nodePartitions.insert(partitions[element]);
+            nodePartitions.insert(partitionIDs[element]);
             // make sure the shadow elements have all their nodes reside in all
             // required partitions
             auto list = element.getNodesList();
             for (auto otherNode : list) {
                 auto otherList = otherNode.getElementsList();
                 for (auto otherElement : otherList) {
-                    if (partitions[otherElement] != partitions[element]) {
-                        nodePartitions.insert(partitions[otherElement]);
+                    if (partitionIDs[otherElement] != partitionIDs[element]) {
+                        nodePartitions.insert(partitionIDs[otherElement]);
                     }
                 }
             }
@@ -146,53 +190,65 @@ void Preprocessor::outputMesh(
             }
         }
         logger(DEBUG, "%", nodePartitions.size());
-        coordinateIndices[node].resize(node.getNumberOfElements());
+        // the data has been allocated for all nodes, so the threads write to
+        // different entries
+        auto& nodeCoordinateIndices = coordinateIndices.data()[nodeIndex];
+        nodeCoordinateIndices.resize(node.getNumberOfElements());
         for (std::size_t i = 0; i < node.getNumberOfElements(); ++i) {
-            coordinateIndices[node][i] = std::distance(
+            nodeCoordinateIndices[i] = std::distance(
                 nodeCoordinates.begin(),
                 nodeCoordinates.find(
                     node.getElement(i).getCoordinate(node.getLocalIndex(i))));
         }
-        output << nodePartitions.size() << " ";
+        stream << nodePartitions.size() << " ";
         for (auto partition : nodePartitions) {
-            partitionData[partition]++;
-            output << partition << " ";
+            partitionData[thread][partition]++;
+            stream << partition << " ";
         }
-        output << std::endl << nodeCoordinates.size() << " ";
+        stream << "\n" << nodeCoordinates.size() << " ";
         for (auto coordinate : nodeCoordinates) {
             for (std::size_t i = 0; i < dimension; ++i) {
-                output << coordinate[i] << " ";
+                stream << coordinate[i] << " ";
             }
         }
-        output << std::endl;
-    }
-    for (auto element : mesh.getElements()) {
-        output << element.getNumberOfNodes() << " ";
+        stream << "\n";
+    });
+    const auto& nodeCoordinateIndices = coordinateIndices;
+    ::Detail::formatInParallel(output, mesh.getNumberOfElements(), [&](
+                                   std::ostream& stream, std::size_t,
+                                   std::size_t elementIndex) {
+        auto element = mesh.getElement(elementIndex);
+        stream << element.getNumberOfNodes() << " ";
         for (auto node : element.getNodesList()) {
-            output << node.getGlobalIndex() << " ";
-            output << coordinateIndices[node][node.getElementIndex(element)]
+            stream << node.getGlobalIndex() << " ";
+            stream << nodeCoordinateIndices.data()[node.getGlobalIndex()]
+                                                  [node.getElementIndex(element)]
                    << " ";
         }
-        output << partitions[element] << " ";
+        stream << partitionIDs[element] << " ";
         std::set<std::size_t> shadowPartitions;
         for (auto node : element.getNodesList()) {
             for (auto otherElement : node.getElementsList()) {
-                if (partitions[otherElement] != partitions[element]) {
-                    shadowPartitions.insert(partitions[otherElement]);
+                if (partitionIDs[otherElement] != partitionIDs[element]) {
+                    shadowPartitions.insert(partitionIDs[otherElement]);
                 }
             }
         }
-        output << shadowPartitions.size() << " ";
+        stream << shadowPartitions.size() << " ";
         for (auto index : shadowPartitions) {
-            output << index << " ";
+            stream << index << " ";
         }
-        output << std::endl;
-    }
-    printOtherEntities(output, mesh, partitions,
+        stream << "\n";
+    });
+    printOtherEntities(output, mesh, partitionIDs,
                        ::Detail::tag<dimension - 1>{});
     output.seekp(partitionInformation);
     for (std::size_t i = 0; i < numberOfPartitions; ++i) {
-        output << partitionData[i] << " ";
+        std::size_t nodesInPartition = 0;
+        for (const auto& threadData : partitionData) {
+            nodesInPartition += threadData[i];
+        }
+        output << nodesInPartition << " ";
     }
     output.close();
 }
@@ -0,0 +1,86 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2017, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPGEM_APP_PARALLEL_H
+#define HPGEM_APP_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Preprocessor {
+
+/// The number of threads used by the multi-threaded parts of the
+/// preprocessor. The preprocessor runs on a single processor, so it can use
+/// the whole machine.
+inline std::size_t getNumberOfThreads() {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/// Split the indices 0 to n - 1 into consecutive blocks and call
+/// work(thread, begin, end) for every block, each on its own thread. Blocks
+/// contain at least minimumPerThread indices, so small ranges are processed
+/// on the calling thread only. The blocks are ordered by the thread index.
+template <typename Work>
+void parallelFor(std::size_t n, std::size_t minimumPerThread, Work&& work) {
+    std::size_t numberOfThreads =
+        std::min(getNumberOfThreads(),
+                 std::max<std::size_t>(n / std::max<std::size_t>(
+                                               minimumPerThread, 1),
+                                       1));
+    if (numberOfThreads == 1) {
+        work(std::size_t{0}, std::size_t{0}, n);
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(numberOfThreads - 1);
+    for (std::size_t thread = 1; thread < numberOfThreads; ++thread) {
+        threads.emplace_back([&work, thread, n, numberOfThreads]() {
+            work(thread, n * thread / numberOfThreads,
+                 n * (thread + 1) / numberOfThreads);
+        });
+    }
+    work(std::size_t{0}, std::size_t{0}, n / numberOfThreads);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+}  // namespace Preprocessor
+
+#endif  // HPGEM_APP_PARALLEL_H
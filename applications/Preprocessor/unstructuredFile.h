@@ -87,6 +87,10 @@ class UnstructuredInputStream {
 
     void seekg(pos_type pos) { stream.seekg(pos); }
 
+    void seekg(off_type off, std::ios_base::seekdir dir) {
+        stream.seekg(off, dir);
+    }
+
     void open(const std::string& filename,
               std::ios_base::openmode mode = std::ios_base::in) {
         stream.open(filename, mode);
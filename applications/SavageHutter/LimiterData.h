@@ -0,0 +1,187 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPGEM_APP_LIMITERDATA_H
+#define HPGEM_APP_LIMITERDATA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "Base/Element.h"
+#include "Base/MeshManipulatorBase.h"
+#include "LinearAlgebra/MiddleSizeMatrix.h"
+#include "LinearAlgebra/MiddleSizeVector.h"
+
+using namespace hpgem;
+
+/// Data of a single element that is shared by the limiters during one
+/// limiting sweep.
+struct LimiterElementData {
+    /// Average of every variable over the element
+    LinearAlgebra::MiddleSizeVector average_;
+
+    /// Averages of the face neighbours, indexed by the local face number of
+    /// the element. The entry is empty for boundary faces.
+    std::vector<LinearAlgebra::MiddleSizeVector> neighbourAverages_;
+
+    /// Minimum and maximum over the averages of the element and its face
+    /// neighbours, per variable.
+    LinearAlgebra::MiddleSizeVector neighbourMinimum_;
+    LinearAlgebra::MiddleSizeVector neighbourMaximum_;
+
+    /// Values of the variables (columns) at the tabulated points (rows): first
+    /// the vertices of the reference element, then the points of the Gauss
+    /// quadrature rule of the element.
+    LinearAlgebra::MiddleSizeMatrix pointValues_;
+
+    /// Minimum and maximum over the tabulated points, per variable.
+    LinearAlgebra::MiddleSizeVector pointMinimum_;
+    LinearAlgebra::MiddleSizeVector pointMaximum_;
+
+    /// Whether the height is below the dry limit somewhere in the element
+    bool isDry_ = false;
+
+    /// Whether the troubled cell detector marked the element for limiting
+    bool isTroubled_ = false;
+};
+
+/// \brief Computes the LimiterElementData for all local elements of a mesh.
+///
+/// The data is computed from the coefficients of a time integration vector:
+/// the values at the vertices and quadrature points are computed with one
+/// small matrix-matrix product per element, using the values of the basis
+/// functions that are tabulated once per reference element. The neighbour
+/// averages are collected by visiting the faces of every element, so the
+/// limiters themselves do not need to evaluate the neighbouring elements.
+///
+/// An element is troubled when it is dry or when the solution at one of the
+/// tabulated points lies outside the range of the averages of the element and
+/// its face neighbours (a discrete maximum principle). Elements that are not
+/// troubled do not need to be limited.
+///
+/// The element-wise work runs on several threads. The data of every element
+/// is only written by one thread, and the mesh and the coefficients are only
+/// read, so no locking is needed. The tabulation assumes that all elements
+/// with the same reference geometry, quadrature rule and number of basis
+/// functions use the same (discontinuous) basis functions.
+template <std::size_t DIM>
+class LimiterData {
+   public:
+    LimiterData();
+
+    /// Recompute the data for the local elements of the mesh. The
+    /// coefficients of the face neighbours should be up to date, so in
+    /// parallel the time integration vector needs to be synchronized first.
+    /// \param mesh The mesh with the elements to compute the data for
+    /// \param timeIntegrationVectorId The vector with the coefficients
+    /// \param dryLimit Height below which an element is considered dry
+    void update(const Base::MeshManipulatorBase* mesh,
+                std::size_t timeIntegrationVectorId, double dryLimit);
+
+    /// The data of a local element from the last update
+    const LimiterElementData& getData(const Base::Element* element) const;
+
+    /// Set the number of threads used for the element-wise work.
+    void setNumberOfThreads(std::size_t numberOfThreads) {
+        numberOfThreads_ = std::max(numberOfThreads, std::size_t(1));
+    }
+
+    /// Set the relative tolerance of the troubled cell detector.
+    void setDetectorTolerance(double tolerance) {
+        detectorTolerance_ = tolerance;
+    }
+
+   private:
+    /// Values of the basis functions (columns) at the tabulated points (rows)
+    /// and the quadrature weights of the quadrature points.
+    struct PointTable {
+        LinearAlgebra::MiddleSizeMatrix basisFunctionValues_;
+        std::size_t numberOfVertices_;
+        std::vector<const Geometry::PointReference<DIM>*> quadraturePoints_;
+        std::vector<double> weights_;
+    };
+
+    using TableKey = std::tuple<const void*, const void*, std::size_t>;
+
+    const PointTable& getTable(const Base::Element* element);
+
+    /// Compute the point values and the average of a single element
+    void computeElementValues(const Base::Element* element,
+                              const PointTable& table,
+                              std::size_t timeIntegrationVectorId,
+                              LimiterElementData& data) const;
+
+    /// Compute the neighbour data and apply the detector for a single element
+    void computeNeighbourData(const Base::Element* element, double dryLimit,
+                              LimiterElementData& data) const;
+
+    /// Call function(i) for i in [0, n), divided over the threads
+    template <typename Function>
+    void parallelFor(std::size_t n, const Function& function) const;
+
+    std::size_t numberOfThreads_;
+
+    double detectorTolerance_;
+
+    /// The elements for which data is computed: the local elements followed
+    /// by the face neighbours that are not local.
+    std::vector<const Base::Element*> elements_;
+
+    /// Tables used by elements_, same indexing
+    std::vector<const PointTable*> elementTables_;
+
+    /// Position of an element in elements_
+    std::unordered_map<const Base::Element*, std::size_t> elementPosition_;
+
+    /// The data of elements_, same indexing
+    std::vector<LimiterElementData> data_;
+
+    /// Number of local elements at the start of elements_
+    std::size_t numberOfLocalElements_;
+
+    std::map<TableKey, PointTable> tables_;
+};
+
+#include "LimiterData_Impl.h"
+
+#endif  // HPGEM_APP_LIMITERDATA_H
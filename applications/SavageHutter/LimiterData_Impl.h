@@ -0,0 +1,275 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "LimiterData.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Logger.h"
+
+using namespace hpgem;
+
+template <std::size_t DIM>
+LimiterData<DIM>::LimiterData()
+    :
+#ifdef HPGEM_USE_MPI
+      // The processors already divide the elements
+      numberOfThreads_(1),
+#else
+      numberOfThreads_(
+          std::max(std::thread::hardware_concurrency(), 1u)),
+#endif
+      detectorTolerance_(1e-10),
+      numberOfLocalElements_(0) {
+}
+
+template <std::size_t DIM>
+void LimiterData<DIM>::update(const Base::MeshManipulatorBase* mesh,
+                              std::size_t timeIntegrationVectorId,
+                              double dryLimit) {
+    elements_.clear();
+    elementPosition_.clear();
+    for (const Base::Element* element : mesh->getElementsList()) {
+        elementPosition_[element] = elements_.size();
+        elements_.push_back(element);
+    }
+    numberOfLocalElements_ = elements_.size();
+    // Face neighbours that are owned by another processor
+    for (std::size_t i = 0; i < numberOfLocalElements_; ++i) {
+        const Base::Element* element = elements_[i];
+        for (std::size_t iFace = 0; iFace < element->getNumberOfFaces();
+             ++iFace) {
+            const Base::Face* face = element->getFace(iFace);
+            if (!face->isInternal()) {
+                continue;
+            }
+            const Base::Element* other = face->getPtrOtherElement(element);
+            if (elementPosition_.count(other) == 0) {
+                elementPosition_[other] = elements_.size();
+                elements_.push_back(other);
+            }
+        }
+    }
+
+    // Tabulating evaluates the basis functions, which is done serially
+    elementTables_.resize(elements_.size());
+    for (std::size_t i = 0; i < elements_.size(); ++i) {
+        elementTables_[i] = &getTable(elements_[i]);
+    }
+
+    data_.resize(elements_.size());
+    parallelFor(elements_.size(), [&](std::size_t i) {
+        computeElementValues(elements_[i], *elementTables_[i],
+                             timeIntegrationVectorId, data_[i]);
+    });
+    parallelFor(numberOfLocalElements_, [&](std::size_t i) {
+        computeNeighbourData(elements_[i], dryLimit, data_[i]);
+    });
+}
+
+template <std::size_t DIM>
+const LimiterElementData& LimiterData<DIM>::getData(
+    const Base::Element* element) const {
+    auto position = elementPosition_.find(element);
+    logger.assert_debug(position != elementPosition_.end() &&
+                            position->second < numberOfLocalElements_,
+                        "No limiter data for element %", element->getID());
+    return data_[position->second];
+}
+
+template <std::size_t DIM>
+const typename LimiterData<DIM>::PointTable& LimiterData<DIM>::getTable(
+    const Base::Element* element) {
+    const QuadratureRules::GaussQuadratureRule* rule =
+        element->getGaussQuadratureRule();
+    const Geometry::ReferenceGeometry* referenceGeometry =
+        element->getReferenceGeometry();
+    const std::size_t numberOfBasisFunctions =
+        element->getNumberOfBasisFunctions();
+    TableKey key(rule, referenceGeometry, numberOfBasisFunctions);
+    auto existing = tables_.find(key);
+    if (existing != tables_.end()) {
+        return existing->second;
+    }
+
+    PointTable& table = tables_[key];
+    table.numberOfVertices_ = referenceGeometry->getNumberOfNodes();
+    const std::size_t numberOfPoints =
+        table.numberOfVertices_ + rule->getNumberOfPoints();
+    table.basisFunctionValues_.resize(numberOfPoints, numberOfBasisFunctions);
+    for (std::size_t iPoint = 0; iPoint < table.numberOfVertices_; ++iPoint) {
+        const Geometry::PointReference<DIM>& pRef =
+            referenceGeometry->getReferenceNodeCoordinate(iPoint);
+        for (std::size_t iFun = 0; iFun < numberOfBasisFunctions; ++iFun) {
+            table.basisFunctionValues_(iPoint, iFun) =
+                element->basisFunction(iFun, pRef);
+        }
+    }
+    for (std::size_t p = 0; p < rule->getNumberOfPoints(); ++p) {
+        const Geometry::PointReference<DIM>& pRef = rule->getPoint(p);
+        table.quadraturePoints_.push_back(&pRef);
+        table.weights_.push_back(rule->weight(p));
+        for (std::size_t iFun = 0; iFun < numberOfBasisFunctions; ++iFun) {
+            table.basisFunctionValues_(table.numberOfVertices_ + p, iFun) =
+                element->basisFunction(iFun, pRef);
+        }
+    }
+    return table;
+}
+
+template <std::size_t DIM>
+void LimiterData<DIM>::computeElementValues(
+    const Base::Element* element, const PointTable& table,
+    std::size_t timeIntegrationVectorId, LimiterElementData& data) const {
+    const LinearAlgebra::MiddleSizeVector& coefficients =
+        element->getTimeIntegrationVector(timeIntegrationVectorId);
+    const std::size_t numberOfBasisFunctions =
+        table.basisFunctionValues_.getNumberOfColumns();
+    const std::size_t numberOfVariables =
+        coefficients.size() / numberOfBasisFunctions;
+
+    // The coefficients are stored variable by variable, so they form a column
+    // major (basis function x variable) matrix.
+    LinearAlgebra::MiddleSizeMatrix coefficientMatrix(numberOfBasisFunctions,
+                                                      numberOfVariables);
+    std::copy(coefficients.data(), coefficients.data() + coefficients.size(),
+              coefficientMatrix.data());
+    data.pointValues_ = table.basisFunctionValues_ * coefficientMatrix;
+
+    data.average_.resize(numberOfVariables);
+    data.pointMinimum_.resize(numberOfVariables);
+    data.pointMaximum_.resize(numberOfVariables);
+    double measure = 0;
+    for (std::size_t iVar = 0; iVar < numberOfVariables; ++iVar) {
+        data.average_[iVar] = 0;
+        data.pointMinimum_[iVar] = data.pointValues_(0, iVar);
+        data.pointMaximum_[iVar] = data.pointValues_(0, iVar);
+    }
+    for (std::size_t p = 0; p < table.weights_.size(); ++p) {
+        const double weight =
+            table.weights_[p] *
+            std::abs(element->calcJacobian(*table.quadraturePoints_[p])
+                         .determinant());
+        measure += weight;
+        for (std::size_t iVar = 0; iVar < numberOfVariables; ++iVar) {
+            data.average_[iVar] +=
+                weight * data.pointValues_(table.numberOfVertices_ + p, iVar);
+        }
+    }
+    data.average_ /= measure;
+    for (std::size_t iPoint = 1; iPoint < data.pointValues_.getNumberOfRows();
+         ++iPoint) {
+        for (std::size_t iVar = 0; iVar < numberOfVariables; ++iVar) {
+            const double value = data.pointValues_(iPoint, iVar);
+            data.pointMinimum_[iVar] =
+                std::min(data.pointMinimum_[iVar], value);
+            data.pointMaximum_[iVar] =
+                std::max(data.pointMaximum_[iVar], value);
+        }
+    }
+}
+
+template <std::size_t DIM>
+void LimiterData<DIM>::computeNeighbourData(const Base::Element* element,
+                                            double dryLimit,
+                                            LimiterElementData& data) const {
+    data.neighbourMinimum_ = data.average_;
+    data.neighbourMaximum_ = data.average_;
+    data.neighbourAverages_.assign(element->getNumberOfFaces(), {});
+    for (std::size_t iFace = 0; iFace < element->getNumberOfFaces(); ++iFace) {
+        const Base::Face* face = element->getFace(iFace);
+        if (!face->isInternal()) {
+            continue;
+        }
+        const LinearAlgebra::MiddleSizeVector& average =
+            data_[elementPosition_.at(face->getPtrOtherElement(element))]
+                .average_;
+        data.neighbourAverages_[iFace] = average;
+        for (std::size_t iVar = 0; iVar < average.size(); ++iVar) {
+            data.neighbourMinimum_[iVar] =
+                std::min(data.neighbourMinimum_[iVar], average[iVar]);
+            data.neighbourMaximum_[iVar] =
+                std::max(data.neighbourMaximum_[iVar], average[iVar]);
+        }
+    }
+
+    data.isDry_ = data.pointMinimum_[0] < dryLimit;
+    data.isTroubled_ = data.isDry_;
+    for (std::size_t iVar = 0;
+         iVar < data.average_.size() && !data.isTroubled_; ++iVar) {
+        const double tolerance =
+            detectorTolerance_ *
+            std::max({1.0, std::abs(data.neighbourMinimum_[iVar]),
+                      std::abs(data.neighbourMaximum_[iVar])});
+        data.isTroubled_ =
+            data.pointMinimum_[iVar] < data.neighbourMinimum_[iVar] - tolerance ||
+            data.pointMaximum_[iVar] > data.neighbourMaximum_[iVar] + tolerance;
+    }
+}
+
+template <std::size_t DIM>
+template <typename Function>
+void LimiterData<DIM>::parallelFor(std::size_t n,
+                                   const Function& function) const {
+    // Starting a thread only pays off for a reasonable amount of elements
+    const std::size_t minimumElementsPerThread = 256;
+    const std::size_t numberOfThreads =
+        std::min(numberOfThreads_, n / minimumElementsPerThread);
+    if (numberOfThreads <= 1) {
+        for (std::size_t i = 0; i < n; ++i) {
+            function(i);
+        }
+        return;
+    }
+    const std::size_t chunkSize = (n + numberOfThreads - 1) / numberOfThreads;
+    auto runChunk = [&function, n, chunkSize](std::size_t chunk) {
+        const std::size_t end = std::min(n, (chunk + 1) * chunkSize);
+        for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+            function(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t chunk = 1; chunk < numberOfThreads; ++chunk) {
+        threads.emplace_back(runChunk, chunk);
+    }
+    runChunk(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
@@ -44,6 +44,7 @@
 #include "Base/HpgemAPISimplified.h"
 #include "SlopeLimiters/EmptySlopeLimiter.h"
 #include "HeightLimiters/EmptyHeightLimiter.h"
+#include "LimiterData.h"
 
 template <std::size_t DIM>
 class SavageHutterBase : public Base::HpgemAPISimplified<DIM> {
@@ -118,6 +119,10 @@ class SavageHutterBase : public Base::HpgemAPISimplified<DIM> {
 
     HeightLimiter *heightLimiter_;
 
+    /// Averages, point values and troubled cell flags of the elements, shared
+    /// by the limiters during the limiting after a time step.
+    LimiterData<DIM> limiterData_;
+
     /// If the minimum height in an element is below this number, the element is
     /// considered to be dry.
     double dryLimit_;
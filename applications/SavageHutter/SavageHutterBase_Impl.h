@@ -188,16 +188,24 @@ void SavageHutterBase<DIM>::computeOneTimeStep(double &time, const double dt) {
     setInflowBC(time);
 }
 
+///\details First compute the limiter data of all elements in one sweep, then
+/// only visit the elements that the troubled cell detector marked. Dry elements
+/// are adapted with the non-negativity limiter, the others get their slope
+/// limited.
 template <std::size_t DIM>
 void SavageHutterBase<DIM>::limitSolutionOuterLoop() {
 
     this->synchronize(0);
+    limiterData_.update(this->meshes_[0], 0, dryLimit_);
     for (Base::Element *element : this->meshes_[0]->getElementsList()) {
+        const LimiterElementData &data = limiterData_.getData(element);
+        if (!data.isTroubled_) {
+            continue;
+        }
         // don't use the slope limiter if the water height is adapted with the
         // non-negativity limiter
-        const double minimum = getMinimumHeight(element);
-        logger(DEBUG, "minimum: %", minimum);
-        if (minimum < dryLimit_) {
+        logger(DEBUG, "minimum: %", data.pointMinimum_[0]);
+        if (data.isDry_) {
             logger(DEBUG, "I should limit the height now!");
             LinearAlgebra::MiddleSizeVector &solutionCoefficients =
                 element->getTimeIntegrationVector(0);
@@ -207,7 +215,7 @@ void SavageHutterBase<DIM>::limitSolutionOuterLoop() {
             // only limit the slope when there is a slope, so not when the
             // solution exists of piecewise constants.
             if (element->getNumberOfBasisFunctions() > 1) {
-                slopeLimiter_->limitSlope(element);
+                slopeLimiter_->limitSlope(element, data);
             }
         }
     }
@@ -39,6 +39,7 @@
 #ifndef HPGEM_APP_SLOPELIMITER_H
 #define HPGEM_APP_SLOPELIMITER_H
 #include "Base/Element.h"
+#include "../LimiterData.h"
 
 using namespace hpgem;
 
@@ -48,6 +49,13 @@ class SlopeLimiter {
 
     virtual void limitSlope(Base::Element *elt) = 0;
 
+    /// Limit the slope of a troubled element, using the averages and point
+    /// values computed in the limiter sweep. By default the data is ignored.
+    virtual void limitSlope(Base::Element *elt,
+                            const LimiterElementData & /*data*/) {
+        limitSlope(elt);
+    }
+
     virtual ~SlopeLimiter() {}
 
    protected:
@@ -51,6 +51,30 @@ void TvbLimiter1D::limitSlope(Base::Element *element) {
     }
 }
 
+///\details Same as limitSlope(Base::Element*), but the slope and the averages
+/// of the element and its neighbours are taken from the limiter data.
+void TvbLimiter1D::limitSlope(Base::Element *element,
+                              const LimiterElementData &data) {
+    const std::vector<LinearAlgebra::MiddleSizeVector> &neighbours =
+        data.neighbourAverages_;
+    // for now, just don't use the limiter at the boundary
+    if (neighbours[0].size() == 0 || neighbours[1].size() == 0) {
+        return;
+    }
+    const PointReferenceT &pRefL =
+        element->getReferenceGeometry()->getReferenceNodeCoordinate(0);
+    const double dx = 2 * element->calcJacobian(pRefL).determinant();
+    for (std::size_t iVar = 0; iVar < numberOfVariables_; ++iVar) {
+        // the first two tabulated points are the vertices
+        const double slope =
+            data.pointValues_(1, iVar) - data.pointValues_(0, iVar);
+        if (std::abs(slope) >= dx * dx) {
+            limitWithMinMod(element, iVar, data.average_[iVar],
+                            neighbours[0][iVar], neighbours[1][iVar]);
+        }
+    }
+}
+
 ///\details Doing it the DG way for p=1 does not lead to conservation of mass,
 /// so for now, do it the FVM way. Don't look at the slope in this element at
 /// all, just at the averages of this element and the adjacent elements. We also
@@ -86,6 +110,12 @@ void TvbLimiter1D::limitWithMinMod(Base::Element *element,
         const_cast<Base::Element *>(elemL), elemL->getTimeIntegrationVector(0),
         elementIntegrator_)(iVar);
 
+    limitWithMinMod(element, iVar, u0, uElemL, uElemR);
+}
+
+void TvbLimiter1D::limitWithMinMod(Base::Element *element,
+                                   const std::size_t iVar, double u0,
+                                   double uElemL, double uElemR) {
     logger(INFO, "uLeft: %\nu0: %\nuRight: %", uElemL, u0, uElemR);
 
     LinearAlgebra::MiddleSizeVector newCoeffs =
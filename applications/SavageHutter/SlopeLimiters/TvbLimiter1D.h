@@ -52,11 +52,19 @@ class TvbLimiter1D : public SlopeLimiter {
 
     void limitSlope(Base::Element *element) override final;
 
+    void limitSlope(Base::Element *element,
+                    const LimiterElementData &data) override final;
+
     ~TvbLimiter1D() {}
 
    private:
     void limitWithMinMod(Base::Element *element, const std::size_t iVar);
 
+    /// Replace the solution by the min-mod reconstruction from the averages
+    /// of the element and its left and right neighbour.
+    void limitWithMinMod(Base::Element *element, const std::size_t iVar,
+                         double u0, double uElemL, double uElemR);
+
     bool hasSmallSlope(const Base::Element *element, const std::size_t iVar);
 
     Integration::ElementIntegral<1> elementIntegrator_;
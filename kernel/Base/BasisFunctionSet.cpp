@@ -46,7 +46,8 @@ namespace hpgem {
 namespace Base {
 
 // class BasisFunctionSet;
-BasisFunctionSet::BasisFunctionSet(std::size_t order) : order_(order) {}
+BasisFunctionSet::BasisFunctionSet(std::size_t order)
+    : order_(order), orthonormal_(false) {}
 
 BasisFunctionSet::~BasisFunctionSet() {
     while (!vecOfBasisFcn_.empty()) {
@@ -66,11 +67,18 @@ std::size_t BasisFunctionSet::getOrder() const { return order_; }
 void BasisFunctionSet::addBasisFunction(BaseBasisFunction* bf) {
     logger.assert_debug(bf != nullptr, "Invalid basis function passed");
     vecOfBasisFcn_.push_back(bf);
+    // the evaluator does not know about the new basis function
+    evaluator_.reset();
+    orthonormal_ = false;
     while (!registeredRules_.empty()) {
         registeredRules_.back()->unregisterBasisFunctionSet(this);
         vecOfBasisFcn_.pop_back();
     }
 }
+
+void BasisFunctionSet::setEvaluator(BasisFunctionSetEvaluator* evaluator) {
+    evaluator_.reset(evaluator);
+}
 }  // namespace Base
 
 double Base::BasisFunctionSet::eval(
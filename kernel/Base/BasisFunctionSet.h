@@ -39,9 +39,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef HPGEM_KERNEL_BASISFUNCTIONSET_H
 #define HPGEM_KERNEL_BASISFUNCTIONSET_H
 
+#include <memory>
 #include <vector>
 #include "Logger.h"
 #include "BaseBasisFunction.h"
+#include "BasisFunctionSetEvaluator.h"
 namespace hpgem {
 namespace LinearAlgebra {
 template <std::size_t DIM>
@@ -127,6 +129,35 @@ class BasisFunctionSet {
     LinearAlgebra::SmallVector<DIM> evalDeriv(
         std::size_t i, const Geometry::PointReference<DIM> &p) const;
 
+    ///\brief evaluates all basis functions of this set at point p
+    /// \details Uses the evaluator of this set, if there is one, so work that
+    /// the basis functions have in common is only done once.
+    template <std::size_t DIM>
+    void evalAll(const Geometry::PointReference<DIM> &p,
+                 std::vector<double> &values) const;
+
+    ///\brief evaluates the gradients of all basis functions of this set at
+    /// point p
+    template <std::size_t DIM>
+    void evalAllDerivs(
+        const Geometry::PointReference<DIM> &p,
+        std::vector<LinearAlgebra::SmallVector<DIM>> &derivs) const;
+
+    /// Provide an evaluator that computes all basis functions of this set at
+    /// once. The set takes ownership of the evaluator. Adding basis functions
+    /// to the set afterwards removes the evaluator again.
+    void setEvaluator(BasisFunctionSetEvaluator *evaluator);
+
+    bool hasEvaluator() const { return evaluator_ != nullptr; }
+
+    /// Mark the basis functions of this set as orthonormal in the L2 inner
+    /// product on the reference geometry, so the mass matrix of an element with
+    /// an affine mapping is |J| times the identity. Adding basis functions to
+    /// the set afterwards removes the mark again.
+    void setOrthonormal(bool orthonormal) { orthonormal_ = orthonormal; }
+
+    bool isOrthonormal() const { return orthonormal_; }
+
     ///\evaluate the gradient of basis function i at a point needed for a
     /// quadrature rule, where the quadrature rule is meant for integrating over
     /// an element
@@ -216,6 +247,8 @@ class BasisFunctionSet {
    private:
     std::size_t order_;
     BaseBasisFunctions vecOfBasisFcn_;
+    std::unique_ptr<const BasisFunctionSetEvaluator> evaluator_;
+    bool orthonormal_;
     // altering this field does not alter the visible behavior of the function
     // set
     mutable std::vector<QuadratureRules::GaussQuadratureRule *>
@@ -362,6 +395,33 @@ LinearAlgebra::SmallVector<DIM> BasisFunctionSet::evalDeriv(
     return vecOfBasisFcn_[i]->evalDeriv(p);
 }
 
+template <std::size_t DIM>
+void BasisFunctionSet::evalAll(const Geometry::PointReference<DIM> &p,
+                               std::vector<double> &values) const {
+    values.resize(size());
+    if (evaluator_) {
+        evaluator_->evalAll(p, values);
+        return;
+    }
+    for (std::size_t i = 0; i < size(); ++i) {
+        values[i] = vecOfBasisFcn_[i]->eval(p);
+    }
+}
+
+template <std::size_t DIM>
+void BasisFunctionSet::evalAllDerivs(
+    const Geometry::PointReference<DIM> &p,
+    std::vector<LinearAlgebra::SmallVector<DIM>> &derivs) const {
+    derivs.resize(size());
+    if (evaluator_) {
+        evaluator_->evalAllDerivs(p, derivs);
+        return;
+    }
+    for (std::size_t i = 0; i < size(); ++i) {
+        derivs[i] = vecOfBasisFcn_[i]->evalDeriv(p);
+    }
+}
+
 template <std::size_t DIM>
 LinearAlgebra::SmallVector<DIM> BasisFunctionSet::evalCurl(
     std::size_t i, const Geometry::PointReference<DIM> &p) const {
@@ -0,0 +1,121 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPGEM_KERNEL_BASISFUNCTIONSETEVALUATOR_H
+#define HPGEM_KERNEL_BASISFUNCTIONSETEVALUATOR_H
+
+#include <vector>
+#include "LinearAlgebra/SmallVector.h"
+#include "Logger.h"
+
+namespace hpgem {
+
+namespace Geometry {
+template <std::size_t DIM>
+class PointReference;
+}
+
+namespace Base {
+
+/// \brief Evaluates all basis functions of a BasisFunctionSet at once.
+/// \details A BasisFunctionSet evaluates its basis functions one by one, which
+/// repeats the work that they have in common (like evaluating the same
+/// polynomials). Families of basis functions with a common structure can
+/// provide an evaluator that computes this shared work once per point. The
+/// evaluator must produce the basis functions in the order of the set.
+class BasisFunctionSetEvaluator {
+   public:
+    BasisFunctionSetEvaluator() = default;
+    BasisFunctionSetEvaluator(const BasisFunctionSetEvaluator& other) = delete;
+    BasisFunctionSetEvaluator& operator=(
+        const BasisFunctionSetEvaluator& other) = delete;
+
+    virtual ~BasisFunctionSetEvaluator() = default;
+
+    // we have to manually specify reasonable choices for template parameters in
+    // virtual functions
+    virtual void evalAll(const Geometry::PointReference<1>& /*p*/,
+                         std::vector<double>& /*values*/) const {
+        logger(ERROR, "The reference point you passed has the wrong dimension");
+    }
+
+    virtual void evalAll(const Geometry::PointReference<2>& /*p*/,
+                         std::vector<double>& /*values*/) const {
+        logger(ERROR, "The reference point you passed has the wrong dimension");
+    }
+
+    virtual void evalAll(const Geometry::PointReference<3>& /*p*/,
+                         std::vector<double>& /*values*/) const {
+        logger(ERROR, "The reference point you passed has the wrong dimension");
+    }
+
+    virtual void evalAll(const Geometry::PointReference<4>& /*p*/,
+                         std::vector<double>& /*values*/) const {
+        logger(ERROR, "The reference point you passed has the wrong dimension");
+    }
+
+    virtual void evalAllDerivs(
+        const Geometry::PointReference<1>& /*p*/,
+        std::vector<LinearAlgebra::SmallVector<1>>& /*derivs*/) const {
+        logger(ERROR, "The reference point you passed has the wrong dimension");
+    }
+
+    virtual void evalAllDerivs(
+        const Geometry::PointReference<2>& /*p*/,
+        std::vector<LinearAlgebra::SmallVector<2>>& /*derivs*/) const {
+        logger(ERROR, "The reference point you passed has the wrong dimension");
+    }
+
+    virtual void evalAllDerivs(
+        const Geometry::PointReference<3>& /*p*/,
+        std::vector<LinearAlgebra::SmallVector<3>>& /*derivs*/) const {
+        logger(ERROR, "The reference point you passed has the wrong dimension");
+    }
+
+    virtual void evalAllDerivs(
+        const Geometry::PointReference<4>& /*p*/,
+        std::vector<LinearAlgebra::SmallVector<4>>& /*derivs*/) const {
+        logger(ERROR, "The reference point you passed has the wrong dimension");
+    }
+};
+
+}  // namespace Base
+
+}  // namespace hpgem
+
+#endif  // HPGEM_KERNEL_BASISFUNCTIONSETEVALUATOR_H
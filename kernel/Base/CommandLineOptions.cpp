@@ -37,7 +37,7 @@
  */
 
 #include "CommandLineOptions.h"
-//#include "MpiContainer.h"
+#include "MpiContainer.h"
 #include "Logger.h"
 #include <cstring>
 
@@ -84,6 +84,18 @@ static auto& printHelp = Base::register_argument<bool>(
     '?', "help", "Prints this help message", false, false);
 
 static bool hasParsed = false;
+
+static std::vector<std::function<void()>>& getSetupHooks() {
+    static std::vector<std::function<void()>> hooks;
+    return hooks;
+}
+
+void Base::register_setup_hook(std::function<void()> hook) {
+    logger.assert_debug(!hasParsed,
+                        "Setup hooks must be registered before parsing");
+    getSetupHooks().push_back(std::move(hook));
+}
+
 bool Base::parse_isDone() { return hasParsed; }
 void Base::parse_options(int argc, char** argv) {
     logger.assert_debug(!hasParsed, "Arguments have already been parsed");
@@ -121,6 +133,10 @@ void Base::parse_options(int argc, char** argv) {
     argc -= count;
     argv += count;
 
+    for (auto& hook : getSetupHooks()) {
+        hook();
+    }
+
 #if defined(HPGEM_USE_ANY_PETSC)
     // block so variables can be created without affecting the rest of the
     // function
@@ -133,8 +149,10 @@ void Base::parse_options(int argc, char** argv) {
             // not happen on COMM_WORLD communicating on COMM_WORLD is a bad
             // idea if you are a library and are not sure who else might use MPI
             //(PETSc CLAIMS this is not needed, but also does not provide this
-            // safeguard itself)
-            MPI_Comm_dup(MPI_COMM_WORLD, &PETSC_COMM_WORLD);
+            // safeguard itself). When the processors are split into groups,
+            // PETSc works within the group of this processor.
+            MPI_Comm_dup(Base::MPIContainer::Instance().getComm(),
+                         &PETSC_COMM_WORLD);
 #endif
 #ifdef HPGEM_USE_SLEPC
             SlepcInitialize(&argc, &argv, PETSC_NULL, "PETSc help\n");
@@ -66,6 +66,15 @@ void parse_options(int argc, char** argv);
  */
 bool parse_isDone();
 
+/**
+ * Register a function that parse_options calls directly after parsing the
+ * arguments, before the MPIContainer and PETSc are set up. This allows an
+ * application option to influence the communicators, for example to split the
+ * processors into groups with MPIContainer::splitWorld.
+ * @param hook The function to call, it may read the values of the options.
+ */
+void register_setup_hook(std::function<void()> hook);
+
 /*
  * The code below this comment is difficult to understand, so don't change
  * anything unless you know what you're doing and you test your changes
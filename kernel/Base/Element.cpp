@@ -174,6 +174,17 @@ void Element::setQuadratureRulesWithOrder(std::size_t quadrROrder) {
     }
 }
 
+void Element::resetQuadratureRules() {
+    quadratureRule_ =
+        Geometry::ElementGeometry::referenceGeometry_->getGaussQuadratureRule(
+            orderCoeff_ * basisFunctions_.getMaximumOrder() + 1);
+    for (Face *face : facesList_) {
+        if (face != nullptr) {
+            face->createQuadratureRules();
+        }
+    }
+}
+
 void Element::setGaussQuadratureRule(
     QuadratureRules::GaussQuadratureRule *const quadR) {
     logger.assert_debug(quadR != nullptr, "Invalid quadrature rule passed");
@@ -197,6 +208,26 @@ const Base::BaseBasisFunction *Element::getBasisFunction(std::size_t i) const {
 }
 #endif
 
+void Element::copyBasisFunctionSets(const Element &other) {
+    logger.assert_debug(
+        getReferenceGeometry() == other.getReferenceGeometry(),
+        "Cannot copy the basis functions of a % to a %",
+        other.getReferenceGeometry()->getName(),
+        getReferenceGeometry()->getName());
+    basisFunctions_ = other.basisFunctions_;
+    for (std::size_t unknown = 0; unknown < getNumberOfUnknowns(); ++unknown) {
+        setNumberOfBasisFunctions(
+            basisFunctions_.getNumberOfBasisFunctions(unknown), unknown);
+    }
+    quadratureRule_ = other.quadratureRule_;
+    orderCoeff_ = other.orderCoeff_;
+}
+
+void Element::clearFacesAndEdges() {
+    std::fill(facesList_.begin(), facesList_.end(), nullptr);
+    std::fill(edgesList_.begin(), edgesList_.end(), nullptr);
+}
+
 void Element::setFace(std::size_t localFaceNumber, Face *face) {
     logger.assert_debug(localFaceNumber < getNumberOfFaces(),
                         "Asked for face %, but there are only % faces",
@@ -150,6 +150,23 @@ class Element final : public Geometry::ElementGeometry, public ElementData {
     /// this element.
     QuadratureRules::GaussQuadratureRule* getGaussQuadratureRule() const;
 
+    /// \brief Use the quadrature rule that matches the current basis functions,
+    /// also when it is less accurate than the current rule (e.g. after the
+    /// polynomial order has been lowered), and update the rules of the faces.
+    void resetQuadratureRules();
+
+    /// \brief Get the highest polynomial order of the basis functions of this
+    /// element.
+    std::size_t getPolynomialOrder() const {
+        return basisFunctions_.getMaximumOrder();
+    }
+
+    /// \brief Whether the basis functions of every unknown form a single set
+    /// that is orthonormal on the reference geometry.
+    bool hasOrthonormalBasisFunctions() const {
+        return basisFunctions_.hasOrthonormalBasisFunctions();
+    }
+
     // std::vector<Base::ElementCacheData>& getVecCacheData();
 
     /// \brief Get the value of the basis function (corresponding to index i) at
@@ -361,6 +378,14 @@ class Element final : public Geometry::ElementGeometry, public ElementData {
 
     void setNode(std::size_t localNodeNumber, Node* node);
 
+    /// \brief Use the same basis function sets and quadrature rule as another
+    /// element of the same shape, for example the parent of a refined element.
+    void copyBasisFunctionSets(const Element& other);
+
+    /// \brief Forget the faces and edges of this element, so they can be
+    /// constructed again after the connectivity of the mesh changed.
+    void clearFacesAndEdges();
+
     ///\deprecated Does not follow naming conventions, use
     /// getLocalNumberOfBasisFunctions instead
     std::size_t getLocalNrOfBasisFunctions() const {
@@ -387,6 +412,16 @@ class Element final : public Geometry::ElementGeometry, public ElementData {
         return basisFunctions_.getTotalLocalNumberOfBasisFunctions();
     }
 
+    /// return the set of the basis functions of an unknown that are associated
+    /// with this element only, or nullptr if there are no such functions
+    const BasisFunctionSet* getLocalBasisFunctionSet(
+        std::size_t unknown) const {
+        if (getLocalNumberOfBasisFunctions(unknown) == 0) {
+            return nullptr;
+        }
+        return basisFunctions_.getBasisFunctionSetAndIndex(0, unknown).first;
+    }
+
     Face* getFace(std::size_t localFaceNumber) const {
         logger.assert_debug(localFaceNumber < getNumberOfFaces(),
                             "Asked for face %, but there are only % faces",
@@ -794,19 +829,16 @@ Element::SolutionVector Element::getSolution(
     std::size_t timeIntegrationVectorId,
     const Geometry::PointReference<DIM>& p) const {
     std::size_t numberOfUnknowns = ElementData::getNumberOfUnknowns();
-    std::vector<std::size_t> numberOfBasisFunctions =
-        std::vector<std::size_t>(numberOfUnknowns, 0);
     SolutionVector solution(numberOfUnknowns);
 
-    LinearAlgebra::MiddleSizeVector data =
+    const LinearAlgebra::MiddleSizeVector& data =
         ElementData::getTimeIntegrationVector(timeIntegrationVectorId);
 
-    std::size_t iVB = 0;
+    std::vector<double> values;
     for (std::size_t iV = 0; iV < numberOfUnknowns; ++iV) {
-        numberOfBasisFunctions[iV] = ElementData::getNumberOfBasisFunctions(iV);
-        for (std::size_t iB = 0; iB < numberOfBasisFunctions[iV]; ++iB) {
-            iVB = convertToSingleIndex(iB, iV);
-            solution[iV] += data(iVB) * basisFunction(iB, p);
+        basisFunctions_.evalAll(p, iV, values);
+        for (std::size_t iB = 0; iB < values.size(); ++iB) {
+            solution[iV] += data(convertToSingleIndex(iB, iV)) * values[iB];
         }
     }
     return solution;
@@ -817,24 +849,23 @@ std::vector<LinearAlgebra::SmallVector<DIM>> Element::getSolutionGradient(
     std::size_t timeIntegrationVectorId,
     const Geometry::PointReference<DIM>& p) const {
     std::size_t numberOfUnknowns = ElementData::getNumberOfUnknowns();
-    std::vector<std::size_t> numberOfBasisFunctions =
-        std::vector<std::size_t>(numberOfUnknowns, 0);
     std::vector<LinearAlgebra::SmallVector<DIM>> solution(numberOfUnknowns);
     auto jacobean = getReferenceToPhysicalMap()->calcJacobian(p);
     jacobean = jacobean.transpose();
 
-    LinearAlgebra::MiddleSizeVector data =
+    const LinearAlgebra::MiddleSizeVector& data =
         ElementData::getTimeIntegrationVector(timeIntegrationVectorId);
 
-    std::size_t iVB = 0;
+    std::vector<LinearAlgebra::SmallVector<DIM>> derivatives;
     for (std::size_t iV = 0; iV < numberOfUnknowns; ++iV) {
-        numberOfBasisFunctions[iV] = ElementData::getNumberOfBasisFunctions(iV);
-        for (std::size_t iB = 0; iB < numberOfBasisFunctions[iV]; ++iB) {
-            iVB = convertToSingleIndex(iB, iV);
-            auto derivative = basisFunctionDeriv(iB, p);
-            jacobean.solve(derivative);
-            solution[iV] += data(iVB) * derivative;
+        basisFunctions_.evalAllDerivs(p, iV, derivatives);
+        for (std::size_t iB = 0; iB < derivatives.size(); ++iB) {
+            solution[iV] +=
+                data(convertToSingleIndex(iB, iV)) * derivatives[iB];
         }
+        // the transformation to physical coordinates is linear, so it can be
+        // applied to the combined gradient
+        jacobean.solve(solution[iV]);
     }
     return solution;
 }
@@ -128,6 +128,27 @@ std::size_t ElementBasisFunctions::getMaximumOrder() const {
     return order;
 }
 
+bool ElementBasisFunctions::hasOrthonormalBasisFunctions() const {
+    if (getNumberOfUnknowns() == 0) {
+        return false;
+    }
+    for (std::size_t i = 0; i < getNumberOfUnknowns(); ++i) {
+        std::size_t numberOfSets = 0;
+        for (int pos : setPositions_[i]) {
+            if (pos != -1) {
+                ++numberOfSets;
+                if (!sets_->at(pos)->isOrthonormal()) {
+                    return false;
+                }
+            }
+        }
+        if (numberOfSets != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void ElementBasisFunctions::clearBasisFunctionPosition(std::size_t unknown) {
     assertValidUnknown(unknown, false);
     setPositions_[unknown].clear();
@@ -128,6 +128,16 @@ class ElementBasisFunctions {
     /// element \return The order
     std::size_t getMaximumOrder() const;
 
+    /// \brief Whether each unknown uses a single basis function set that is
+    /// orthonormal on the reference geometry.
+    ///
+    /// The union of several orthonormal sets (e.g. conforming basis functions)
+    /// is in general not orthonormal, so this requires exactly one set per
+    /// unknown.
+    /// \return true if the mass matrix on the reference geometry is the
+    ///   identity matrix
+    bool hasOrthonormalBasisFunctions() const;
+
     /// \brief Convert from element basis function index to the
     ///   basisFunctionSet to which it belongs and the index in that set.
     ///
@@ -143,6 +153,26 @@ class ElementBasisFunctions {
         getBasisFunctionSetAndIndex(
             size_t index, std::size_t unknown = LEGACY_BEHAVIOUR) const;
 
+    /// \brief Evaluate all basis functions of an unknown at a point
+    ///
+    /// Evaluates the basis functions in the local ordering of the element.
+    /// Each basisFunctionSet is evaluated as a whole, so that work shared by
+    /// its basis functions is done only once.
+    ///
+    /// \param p The reference point at which to evaluate
+    /// \param unknown The unknown for which to evaluate the basis functions
+    /// \param values The values of the basis functions (output)
+    template <std::size_t DIM>
+    void evalAll(const Geometry::PointReference<DIM> &p, std::size_t unknown,
+                 std::vector<double> &values) const;
+
+    /// \brief Evaluate the gradients of all basis functions of an unknown at
+    /// a point, in the local ordering of the element.
+    template <std::size_t DIM>
+    void evalAllDerivs(
+        const Geometry::PointReference<DIM> &p, std::size_t unknown,
+        std::vector<LinearAlgebra::SmallVector<DIM>> &derivs) const;
+
     /// Validate the internal consistency
     void validatePositions() const;
 
@@ -269,6 +299,36 @@ inline std::size_t ElementBasisFunctions::getTotalLocalNumberOfBasisFunctions()
     }
     return total;
 }
+
+template <std::size_t DIM>
+void ElementBasisFunctions::evalAll(const Geometry::PointReference<DIM> &p,
+                                    std::size_t unknown,
+                                    std::vector<double> &values) const {
+    assertValidUnknown(unknown, false);
+    values.clear();
+    std::vector<double> setValues;
+    for (int pos : setPositions_[unknown]) {
+        if (pos != -1) {
+            sets_->at(pos)->evalAll(p, setValues);
+            values.insert(values.end(), setValues.begin(), setValues.end());
+        }
+    }
+}
+
+template <std::size_t DIM>
+void ElementBasisFunctions::evalAllDerivs(
+    const Geometry::PointReference<DIM> &p, std::size_t unknown,
+    std::vector<LinearAlgebra::SmallVector<DIM>> &derivs) const {
+    assertValidUnknown(unknown, false);
+    derivs.clear();
+    std::vector<LinearAlgebra::SmallVector<DIM>> setDerivs;
+    for (int pos : setPositions_[unknown]) {
+        if (pos != -1) {
+            sets_->at(pos)->evalAllDerivs(p, setDerivs);
+            derivs.insert(derivs.end(), setDerivs.begin(), setDerivs.end());
+        }
+    }
+}
 }  // namespace Base
 
 }  // namespace hpgem
@@ -56,6 +56,8 @@ ElementData::ElementData(std::size_t timeLevels, std::size_t numberOfUnknowns,
       numberOfBasisFunctions_(numberOfUnknowns_),
       timeLevelDataVectors_(timeLevels_),
       userData_(nullptr),
+      localTimeLevel_(0),
+      coarsestNeighbourLocalTimeLevel_(0),
       elementMatrix_(numberOfElementMatrixes),
       elementVector_(numberOfElementVectors) {
     logger(VERBOSE, "In constructor of ElementData: ");
@@ -77,6 +79,9 @@ ElementData::ElementData(const ElementData& other) {
     // note: shallow copy
     userData_ = other.userData_;
 
+    localTimeLevel_ = other.localTimeLevel_;
+    coarsestNeighbourLocalTimeLevel_ = other.coarsestNeighbourLocalTimeLevel_;
+
     elementMatrix_ = other.elementMatrix_;
     elementVector_ = other.elementVector_;
 }
@@ -518,6 +523,16 @@ void ElementData::setUserData(UserElementData* data) const {
 }
 
 UserElementData* ElementData::getUserData() const { return userData_; }
+
+void ElementData::setLocalTimeLevel(std::size_t level,
+                                    std::size_t coarsestNeighbourLevel) {
+    logger.assert_debug(coarsestNeighbourLevel <= level,
+                        "The coarsest level of the neighbours (%) should not "
+                        "be finer than the level of the element (%)",
+                        coarsestNeighbourLevel, level);
+    localTimeLevel_ = level;
+    coarsestNeighbourLocalTimeLevel_ = coarsestNeighbourLevel;
+}
 }  // namespace Base
 
 }  // namespace hpgem
@@ -129,7 +129,7 @@ class ElementData {
     }
 
     /// \brief Get the number of time integration vectors.
-    std::size_t getNumberOfTimeIntegrationVectors() {
+    std::size_t getNumberOfTimeIntegrationVectors() const {
         return timeIntegrationVectors_.size();
     }
 
@@ -189,6 +189,18 @@ class ElementData {
 
     UserData* getUserData() const;
 
+    /// \brief Set the local time level of this element and the coarsest local
+    /// time level among the element and its face neighbours, 0 is the
+    /// coarsest level. See HpgemAPISimplified::computeLocalTimeLevels.
+    void setLocalTimeLevel(std::size_t level,
+                           std::size_t coarsestNeighbourLevel);
+
+    std::size_t getLocalTimeLevel() const { return localTimeLevel_; }
+
+    std::size_t getCoarsestNeighbourLocalTimeLevel() const {
+        return coarsestNeighbourLocalTimeLevel_;
+    }
+
     /// \brief Convert the index corresponding to the basis function
     /// (iBasisFunction) and the index corresponding to the variable (iVar) to a
     /// single index. \param[in] iVar The index corresponding to the variable.
@@ -245,6 +257,11 @@ class ElementData {
     /// Used only outside of the Kernel.
     mutable UserData* userData_;
 
+    /// Local time level of this element and the coarsest local time level of
+    /// it and its neighbours, used by local time stepping.
+    std::size_t localTimeLevel_;
+    std::size_t coarsestNeighbourLocalTimeLevel_;
+
     /// Stores element matrix(es) for this element
     std::vector<LinearAlgebra::MiddleSizeMatrix> elementMatrix_;
 
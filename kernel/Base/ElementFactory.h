@@ -75,6 +75,13 @@ class ElementFactory {
                          std::vector<Geometry::PointPhysical<DIM> >& points,
                          std::size_t owner, bool owning);
 
+    //! make an element with a given id instead of a new one, for example for
+    //! an element that moves to another processor
+    template <std::size_t DIM>
+    Element* makeElement(const std::vector<std::size_t>& globalNodeIndexes,
+                         std::vector<Geometry::PointPhysical<DIM> >& points,
+                         std::size_t owner, bool owning, std::size_t id);
+
     //! mesh creation routines can use this to set their desired defaults
     void setCollectionOfBasisFunctionSets(
         const CollectionOfBasisFunctionSets* functions);
@@ -107,10 +114,18 @@ Element* ElementFactory::makeElement(
     const std::vector<std::size_t>& globalNodeIndexes,
     std::vector<Geometry::PointPhysical<DIM> >& points, std::size_t owner,
     bool owning) {
-    return new Element(
-        globalNodeIndexes, basisFunctionSets_, points, unknowns_, timeLevels_,
-        GlobalUniqueIndex::instance().getElementIndex(), owner, owning,
-        numberOfElementMatrices_, numberOfElementVectors_);
+    return makeElement(globalNodeIndexes, points, owner, owning,
+                       GlobalUniqueIndex::instance().getElementIndex());
+}
+
+template <std::size_t DIM>
+Element* ElementFactory::makeElement(
+    const std::vector<std::size_t>& globalNodeIndexes,
+    std::vector<Geometry::PointPhysical<DIM> >& points, std::size_t owner,
+    bool owning, std::size_t id) {
+    return new Element(globalNodeIndexes, basisFunctionSets_, points,
+                       unknowns_, timeLevels_, id, owner, owning,
+                       numberOfElementMatrices_, numberOfElementVectors_);
 }
 
 }  // namespace Base
@@ -0,0 +1,220 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "EntityConnectivity.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+
+#include "Element.h"
+#include "Node.h"
+#include "Geometry/ReferenceGeometry.h"
+#include "Logger.h"
+
+namespace hpgem {
+
+namespace Base {
+
+namespace {
+
+/// Starting a thread only pays off for a reasonable amount of work
+const std::size_t MINIMUM_WORK_PER_THREAD = 4096;
+
+/// Calls function(thread) for thread = 0, ..., numberOfThreads - 1, each in
+/// its own thread.
+template <typename FUNCTION>
+void runThreads(std::size_t numberOfThreads, const FUNCTION& function) {
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 1; thread < numberOfThreads; ++thread) {
+        threads.emplace_back(function, thread);
+    }
+    function(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+/// The local node indices of the faces or edges of a reference geometry
+struct EntityShape {
+    const Geometry::ReferenceGeometry* geometry;
+    std::vector<std::vector<std::size_t>> entities;
+};
+}  // namespace
+
+EntityConnectivity::EntityConnectivity(const std::vector<Element*>& elements,
+                                       std::size_t codimension,
+                                       std::size_t numberOfThreads) {
+    logger.assert_always(codimension == 1 || codimension == 2,
+                         "Can only match faces or edges, not entities of "
+                         "codimension %",
+                         codimension);
+    if (numberOfThreads == 0) {
+#ifdef HPGEM_USE_MPI
+        // The processors already divide the work
+        numberOfThreads = 1;
+#else
+        numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+#endif
+    }
+
+    // The reference geometries are shared by many elements, so only look up
+    // the local node indices of their faces or edges once.
+    std::vector<EntityShape> shapes;
+    std::vector<std::size_t> elementShape(elements.size());
+    std::vector<std::size_t> offsets(elements.size() + 1, 0);
+    std::size_t keyLength = 0;
+    for (std::size_t iElement = 0; iElement < elements.size(); ++iElement) {
+        const Element* element = elements[iElement];
+        const Geometry::ReferenceGeometry* geometry =
+            element->getReferenceGeometry();
+        std::size_t shape = 0;
+        while (shape < shapes.size() && shapes[shape].geometry != geometry) {
+            ++shape;
+        }
+        if (shape == shapes.size()) {
+            EntityShape newShape{geometry, {}};
+            std::size_t numberOfEntities = codimension == 1
+                                               ? element->getNumberOfFaces()
+                                               : element->getNumberOfEdges();
+            for (std::size_t i = 0; i < numberOfEntities; ++i) {
+                newShape.entities.push_back(
+                    codimension == 1
+                        ? geometry->getCodim1EntityLocalIndices(i)
+                        : geometry->getCodim2EntityLocalIndices(i));
+                keyLength =
+                    std::max(keyLength, newShape.entities.back().size());
+            }
+            shapes.push_back(std::move(newShape));
+        }
+        elementShape[iElement] = shape;
+        offsets[iElement + 1] =
+            offsets[iElement] + shapes[shape].entities.size();
+    }
+    const std::size_t numberOfIncidences = offsets.back();
+    incidences_.resize(numberOfIncidences);
+    first_.assign(numberOfIncidences, numberOfIncidences);
+    next_.assign(numberOfIncidences, numberOfIncidences);
+
+    // The key of an incidence is the sorted list of the global indices of its
+    // nodes, padded for entities with fewer nodes
+    std::vector<std::size_t> keys(numberOfIncidences * keyLength,
+                                  std::numeric_limits<std::size_t>::max());
+    std::vector<std::size_t> hashes(numberOfIncidences);
+    const std::size_t numberOfKeyThreads = std::max<std::size_t>(
+        1, std::min(numberOfThreads,
+                    numberOfIncidences / MINIMUM_WORK_PER_THREAD));
+    const std::size_t chunkSize =
+        (elements.size() + numberOfKeyThreads - 1) / numberOfKeyThreads;
+    runThreads(numberOfKeyThreads, [&](std::size_t thread) {
+        const std::size_t end =
+            std::min(elements.size(), (thread + 1) * chunkSize);
+        for (std::size_t iElement = thread * chunkSize; iElement < end;
+             ++iElement) {
+            Element* element = elements[iElement];
+            const EntityShape& shape = shapes[elementShape[iElement]];
+            for (std::size_t i = 0; i < shape.entities.size(); ++i) {
+                const std::size_t incidence = offsets[iElement] + i;
+                incidences_[incidence] = {element, i};
+                std::size_t* key = &keys[incidence * keyLength];
+                const std::vector<std::size_t>& localNodes = shape.entities[i];
+                for (std::size_t j = 0; j < localNodes.size(); ++j) {
+                    key[j] = element->getNode(localNodes[j])->getID();
+                }
+                std::sort(key, key + localNodes.size());
+                std::size_t hash = 0;
+                for (std::size_t j = 0; j < localNodes.size(); ++j) {
+                    hash ^= std::hash<std::size_t>()(key[j]) + 0x9e3779b9 +
+                            (hash << 6) + (hash >> 2);
+                }
+                hashes[incidence] = hash;
+            }
+        }
+    });
+
+    // Each thread links the incidences with a hash value in its own residue
+    // class, so it only writes to its own entries of first_ and next_
+    const std::size_t numberOfHashThreads = std::max<std::size_t>(
+        1, std::min(numberOfThreads,
+                    numberOfIncidences / MINIMUM_WORK_PER_THREAD));
+    auto hashFunction = [&hashes](std::size_t incidence) {
+        return hashes[incidence];
+    };
+    auto equalKeys = [&keys, keyLength](std::size_t left, std::size_t right) {
+        return std::equal(&keys[left * keyLength],
+                          &keys[left * keyLength] + keyLength,
+                          &keys[right * keyLength]);
+    };
+    runThreads(numberOfHashThreads, [&](std::size_t thread) {
+        // maps the first incidence of a face or edge to the last one found
+        std::unordered_map<std::size_t, std::size_t, decltype(hashFunction),
+                           decltype(equalKeys)>
+            lastIncidence(numberOfIncidences / numberOfHashThreads + 1,
+                          hashFunction, equalKeys);
+        for (std::size_t i = 0; i < numberOfIncidences; ++i) {
+            if (hashes[i] % numberOfHashThreads != thread) {
+                continue;
+            }
+            auto found = lastIncidence.find(i);
+            if (found == lastIncidence.end()) {
+                lastIncidence.emplace(i, i);
+                first_[i] = i;
+            } else {
+                next_[found->second] = i;
+                first_[i] = found->first;
+                found->second = i;
+            }
+        }
+    });
+}
+
+void EntityConnectivity::getSharingIncidences(
+    std::size_t i, std::vector<std::size_t>& result) const {
+    logger.assert_debug(i < getNumberOfIncidences(),
+                        "Asked for incidence %, but there are only %", i,
+                        getNumberOfIncidences());
+    result.clear();
+    for (std::size_t j = first_[i]; j < getNumberOfIncidences(); j = next_[j]) {
+        result.push_back(j);
+    }
+}
+
+}  // namespace Base
+
+}  // namespace hpgem
@@ -0,0 +1,102 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPGEM_KERNEL_ENTITYCONNECTIVITY_H
+#define HPGEM_KERNEL_ENTITYCONNECTIVITY_H
+
+#include <cstdlib>
+#include <vector>
+
+namespace hpgem {
+
+namespace Base {
+
+class Element;
+
+/// \brief Finds the elements that share a face or an edge.
+///
+/// Every face (codimension 1) or edge (codimension 2) of the given elements is
+/// identified by the sorted global indices of its nodes. Incidences with the
+/// same key are grouped using hash tables. The keys are computed in parallel,
+/// and each thread builds the hash table for its own part of the hash values,
+/// so no locking is needed. The memory use and the run time are linear in the
+/// number of elements, unlike intersecting the element lists of the nodes.
+class EntityConnectivity {
+   public:
+    /// A face or edge as seen from one of its elements
+    struct Incidence {
+        Element* element;
+        std::size_t localIndex;
+    };
+
+    /// \param elements The elements, in the order the incidences should have
+    /// \param codimension 1 to match the faces, 2 to match the edges
+    /// \param numberOfThreads The number of threads to use, 0 to let the
+    /// hardware decide
+    EntityConnectivity(const std::vector<Element*>& elements,
+                       std::size_t codimension,
+                       std::size_t numberOfThreads = 0);
+
+    /// The number of incidences, i.e. the number of faces or edges counted
+    /// once for each element that they bound
+    std::size_t getNumberOfIncidences() const { return incidences_.size(); }
+
+    /// The incidences, ordered by element and then by local index
+    const Incidence& getIncidence(std::size_t i) const {
+        return incidences_[i];
+    }
+
+    /// The indices of all incidences of the same face or edge as incidence i
+    /// (including i itself), in increasing order
+    void getSharingIncidences(std::size_t i,
+                              std::vector<std::size_t>& result) const;
+
+   private:
+    std::vector<Incidence> incidences_;
+    /// The first incidence of the face or edge of an incidence
+    std::vector<std::size_t> first_;
+    /// The next incidence of the same face or edge, or the number of
+    /// incidences for the last one
+    std::vector<std::size_t> next_;
+};
+
+}  // namespace Base
+
+}  // namespace hpgem
+
+#endif  // HPGEM_KERNEL_ENTITYCONNECTIVITY_H
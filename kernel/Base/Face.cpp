@@ -114,6 +114,30 @@ Face::Face(Element* ptrElemL, const std::size_t& localFaceNumberL,
     initialiseFaceToFaceMapIndex(leftNodes, rightNodes);
 }
 
+Face::Face(Element* ptrElemL, const std::size_t& localFaceNumberL,
+           Element* ptrElemR, const std::size_t& localFaceNumberR,
+           const Geometry::MappingReferenceToReference<1>* nonconformingMapR,
+           std::size_t faceID, std::size_t numberOfFaceMatrixes,
+           std::size_t numberOfFaceVectors)
+    : FaceGeometry(ptrElemL, localFaceNumberL, ptrElemR, localFaceNumberR,
+                   nonconformingMapR),
+      FaceData(ptrElemL->getTotalNumberOfBasisFunctions() +
+                   ptrElemR->getTotalNumberOfBasisFunctions(),
+               numberOfFaceMatrixes, numberOfFaceVectors),
+      elementLeft_(ptrElemL),
+      elementRight_(ptrElemR),
+      numberOfConformingDOFOnTheFace_(std::vector<std::size_t>(1, 0)),
+      faceID_(faceID) {
+    logger.assert_debug(ptrElemL != nullptr, "Invalid element passed");
+    logger.assert_debug(ptrElemR != nullptr,
+                        "Error: passing a boundary face to the constructor for "
+                        "internal faces!");
+    createQuadratureRules();
+    ptrElemL->setFace(localFaceNumberL, this);
+    ptrElemR->setFace(localFaceNumberR, this);
+    numberOfConformingDOFOnTheFace_.resize(ptrElemL->getNumberOfUnknowns(), 0);
+}
+
 Face::Face(Element* ptrElemL, const std::size_t& localFaceNumberL,
            const Geometry::FaceType& faceType, std::size_t faceID,
            std::size_t numberOfFaceMatrixes, std::size_t numberOfFaceVectors)
@@ -75,6 +75,15 @@ class Face final : public Geometry::FaceGeometry, public FaceData {
          std::size_t numberOfFaceMatrixes = 0,
          std::size_t numberOfFaceVectors = 0);
 
+    /// Constructor for an internal face that only covers part of the face of
+    /// the (coarser) right element. The right element refers to one of the
+    /// faces that cover its face.
+    Face(Element* ptrElemL, const std::size_t& localFaceNumL,
+         Element* ptrElemRight, const std::size_t& localFaceNumR,
+         const Geometry::MappingReferenceToReference<1>* nonconformingMapR,
+         std::size_t faceID, std::size_t numberOfFaceMatrixes = 0,
+         std::size_t numberOfFaceVectors = 0);
+
     /// copy constructor should not be used: if adjacent elements are the same,
     /// then the Face already exists and there is no need for another, if
     /// adjacent elements are different, the copy is not really a copy
@@ -52,20 +52,49 @@ FaceFactory::FaceFactory()
 Face* FaceFactory::makeFace(Element* leftElementPtr,
                             std::size_t leftElementLocalFaceNo,
                             Geometry::FaceType faceType) {
+    return makeFace(leftElementPtr, leftElementLocalFaceNo, faceType,
+                    GlobalUniqueIndex::instance().getFaceIndex());
+}
+
+Face* FaceFactory::makeFace(Element* leftElementPtr,
+                            std::size_t leftElementLocalFaceNo,
+                            Geometry::FaceType faceType, std::size_t id) {
     logger.assert_debug(leftElementPtr != nullptr, "Invalid element passed");
-    return new Face(leftElementPtr, leftElementLocalFaceNo, faceType,
-                    GlobalUniqueIndex::instance().getFaceIndex(),
+    return new Face(leftElementPtr, leftElementLocalFaceNo, faceType, id,
                     numberOfFaceMatrices_, numberOfFaceVectors_);
 }
+
 Face* FaceFactory::makeFace(Element* leftElementPtr,
                             std::size_t leftElementLocalFaceNo,
                             Element* rightElementPtr,
                             std::size_t rightElementLocalFaceNo) {
+    return makeFace(leftElementPtr, leftElementLocalFaceNo, rightElementPtr,
+                    rightElementLocalFaceNo,
+                    GlobalUniqueIndex::instance().getFaceIndex());
+}
+
+Face* FaceFactory::makeFace(Element* leftElementPtr,
+                            std::size_t leftElementLocalFaceNo,
+                            Element* rightElementPtr,
+                            std::size_t rightElementLocalFaceNo,
+                            std::size_t id) {
     logger.assert_debug(leftElementPtr != nullptr, "Invalid element passed");
     logger.assert_debug(rightElementPtr != nullptr,
                         "This routine is intended for internal faces");
     return new Face(leftElementPtr, leftElementLocalFaceNo, rightElementPtr,
-                    rightElementLocalFaceNo,
+                    rightElementLocalFaceNo, id, numberOfFaceMatrices_,
+                    numberOfFaceVectors_);
+}
+
+Face* FaceFactory::makeFace(
+    Element* leftElementPtr, std::size_t leftElementLocalFaceNo,
+    Element* rightElementPtr, std::size_t rightElementLocalFaceNo,
+    const Geometry::MappingReferenceToReference<1>* nonconformingMapR) {
+    logger.assert_debug(leftElementPtr != nullptr, "Invalid element passed");
+    logger.assert_debug(rightElementPtr != nullptr,
+                        "This routine is intended for internal faces");
+    return new Face(leftElementPtr, leftElementLocalFaceNo, rightElementPtr,
+                    rightElementLocalFaceNo, nonconformingMapR,
                     GlobalUniqueIndex::instance().getFaceIndex(),
                     numberOfFaceMatrices_, numberOfFaceVectors_);
 }
@@ -62,6 +62,21 @@ class FaceFactory {
                    Element* rightElementPtr,
                    std::size_t rightElementLocalFaceNo);
 
+    //! make a face with a given id instead of a new one, for example for a
+    //! face of an element that moves to another processor
+    Face* makeFace(Element* leftElementPtr, std::size_t leftElementLocalFaceNo,
+                   Geometry::FaceType faceType, std::size_t id);
+    Face* makeFace(Element* leftElementPtr, std::size_t leftElementLocalFaceNo,
+                   Element* rightElementPtr,
+                   std::size_t rightElementLocalFaceNo, std::size_t id);
+
+    //! make a face that only covers part of the face of the right element,
+    //! see Face
+    Face* makeFace(
+        Element* leftElementPtr, std::size_t leftElementLocalFaceNo,
+        Element* rightElementPtr, std::size_t rightElementLocalFaceNo,
+        const Geometry::MappingReferenceToReference<1>* nonconformingMapR);
+
     void setNumberOfFaceMatrices(std::size_t matrices);
 
     void setNumberOfFaceVectors(std::size_t vectors);
@@ -37,6 +37,7 @@
  */
 
 #include "GlobalUniqueIndex.h"
+#include "Logger.h"
 
 namespace hpgem {
 
@@ -55,4 +56,28 @@ std::size_t Base::GlobalUniqueIndex::getEdgeIndex() { return edgeIndex_++; }
 
 std::size_t Base::GlobalUniqueIndex::getNodeIndex() { return nodeIndex_++; }
 
+void Base::GlobalUniqueIndex::skipToElementIndex(std::size_t index) {
+    logger.assert_debug(index >= elementIndex_,
+                        "Element index % has already been handed out", index);
+    elementIndex_ = index;
+}
+
+void Base::GlobalUniqueIndex::skipToFaceIndex(std::size_t index) {
+    logger.assert_debug(index >= faceIndex_,
+                        "Face index % has already been handed out", index);
+    faceIndex_ = index;
+}
+
+void Base::GlobalUniqueIndex::skipToEdgeIndex(std::size_t index) {
+    logger.assert_debug(index >= edgeIndex_,
+                        "Edge index % has already been handed out", index);
+    edgeIndex_ = index;
+}
+
+void Base::GlobalUniqueIndex::skipToNodeIndex(std::size_t index) {
+    logger.assert_debug(index >= nodeIndex_,
+                        "Node index % has already been handed out", index);
+    nodeIndex_ = index;
+}
+
 }  // namespace hpgem
@@ -61,6 +61,28 @@ class GlobalUniqueIndex final {
     /// number might also be returned by one of the other functions)
     std::size_t getNodeIndex();
 
+    /// the number that the next call of getElementIndex will return
+    std::size_t peekElementIndex() const { return elementIndex_; }
+    /// the number that the next call of getFaceIndex will return
+    std::size_t peekFaceIndex() const { return faceIndex_; }
+    /// the number that the next call of getEdgeIndex will return
+    std::size_t peekEdgeIndex() const { return edgeIndex_; }
+    /// the number that the next call of getNodeIndex will return
+    std::size_t peekNodeIndex() const { return nodeIndex_; }
+
+    /// make sure the next call of getElementIndex returns index. The numbers
+    /// that are skipped are reserved for entities on other processors
+    void skipToElementIndex(std::size_t index);
+    /// make sure the next call of getFaceIndex returns index. The numbers that
+    /// are skipped are reserved for entities on other processors
+    void skipToFaceIndex(std::size_t index);
+    /// make sure the next call of getEdgeIndex returns index. The numbers that
+    /// are skipped are reserved for entities on other processors
+    void skipToEdgeIndex(std::size_t index);
+    /// make sure the next call of getNodeIndex returns index. The numbers that
+    /// are skipped are reserved for entities on other processors
+    void skipToNodeIndex(std::size_t index);
+
    private:
     GlobalUniqueIndex() = default;
     GlobalUniqueIndex(const GlobalUniqueIndex&) = delete;
@@ -0,0 +1,243 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPGEM_KERNEL_HPGEMAPIIMPLICIT_H
+#define HPGEM_KERNEL_HPGEMAPIIMPLICIT_H
+
+#include "Base/HpgemAPISimplified.h"
+#include "Utilities/GlobalIndexing.h"
+#include "Utilities/GlobalMatrix.h"
+#include "Utilities/GlobalVector.h"
+#include <memory>
+
+#if defined(HPGEM_USE_ANY_PETSC)
+#include "petscts.h"
+#endif
+
+namespace hpgem {
+namespace Base {
+
+/// \brief Part of the right hand side that should be computed by the
+/// computeRightHandSideAt... functions.
+enum class RightHandSidePart { ALL, EXPLICIT, IMPLICIT };
+
+/// \brief Interface for solving time dependent PDE's with implicit or IMEX
+/// time integration. The time integration is done by PETSc TS.
+/** The semi-discrete system \f$ M\dot{u} = f(u) \f$ is written in the form
+ * \f[ M\dot{u} - f_I(u) = f_E(u), \f] where \f$ f_I \f$ is the implicit part
+ * and \f$ f_E \f$ the explicit part of the right hand side. Without IMEX
+ * \f$ f_I = f \f$ and \f$ f_E = 0 \f$. The residual is evaluated with the
+ * computeRightHandSideAt... functions of HpgemAPISimplified. When IMEX is used
+ * these functions should check getRightHandSidePart() and only return the
+ * requested part.
+ */
+/** \details The Jacobian \f$ \partial f_I / \partial u \f$ is either assembled
+ * from computeJacobianAtElement and computeJacobianAtFace, or approximated by
+ * finite differences of the residual (Jacobian-free Newton-Krylov). In the
+ * latter case the block diagonal matrix \f$ \sigma M \f$ is used to build the
+ * preconditioner. By default a fully implicit ARK scheme with a fixed time
+ * step is used. All settings can be changed on the command line with the
+ * usual PETSc options (-ts_type, -ts_arkimex_type, -snes_rtol, -pc_type, ...).
+ */
+/** \details Error controlled time stepping, local time stepping, mesh
+ * adaptation and rebalancing of HpgemAPISimplified are not supported by this
+ * interface.
+ */
+template <std::size_t DIM>
+class HpgemAPIImplicit : public HpgemAPISimplified<DIM> {
+   public:
+    using typename HpgemAPIBase<DIM>::PointPhysicalT;
+    using typename HpgemAPIBase<DIM>::PointReferenceT;
+    using typename HpgemAPIBase<DIM>::PointReferenceOnFaceT;
+
+    HpgemAPIImplicit(const std::size_t numberOfUnknowns,
+                     const std::size_t polynomialOrder,
+                     const bool useImex = false,
+                     const bool assembleJacobian = false,
+                     const bool computeBothFaces = false);
+
+    HpgemAPIImplicit(const HpgemAPIImplicit &other) = delete;
+    HpgemAPIImplicit &operator=(const HpgemAPIImplicit &other) = delete;
+
+    ~HpgemAPIImplicit() override;
+
+    /// \brief Create the mesh, with room for the mass and Jacobian matrices.
+    void readMesh(std::string fileName) override;
+
+    /// \brief Compute the derivative of the (implicit part of the) right hand
+    /// side at an element with respect to the coefficients of the element.
+    virtual LinearAlgebra::MiddleSizeMatrix computeJacobianAtElement(
+        Base::Element *ptrElement,
+        const LinearAlgebra::MiddleSizeVector &solutionCoefficients,
+        const double time) {
+        logger(ERROR, "No function computeJacobianAtElement() implemented.");
+        LinearAlgebra::MiddleSizeMatrix jacobianAtElement;
+        return jacobianAtElement;
+    }
+
+    /// \brief Compute the derivative of the (implicit part of the) right hand
+    /// side at a boundary face with respect to the coefficients of the
+    /// element.
+    virtual LinearAlgebra::MiddleSizeMatrix computeJacobianAtFace(
+        Base::Face *ptrFace,
+        LinearAlgebra::MiddleSizeVector &solutionCoefficients,
+        const double time) {
+        logger(ERROR,
+               "No function computeJacobianAtFace() for boundary faces "
+               "implemented.");
+        LinearAlgebra::MiddleSizeMatrix jacobianAtFace;
+        return jacobianAtFace;
+    }
+
+    /// \brief Compute the derivative of the (implicit part of the) right hand
+    /// side for the test functions at side elementSide of an internal face with
+    /// respect to the coefficients of the element at side derivativeSide.
+    virtual LinearAlgebra::MiddleSizeMatrix computeJacobianAtFace(
+        Base::Face *ptrFace,
+        LinearAlgebra::MiddleSizeVector &solutionCoefficientsLeft,
+        LinearAlgebra::MiddleSizeVector &solutionCoefficientsRight,
+        const double time, const Base::Side elementSide,
+        const Base::Side derivativeSide) {
+        logger(ERROR,
+               "No function computeJacobianAtFace() for internal faces "
+               "implemented.");
+        LinearAlgebra::MiddleSizeMatrix jacobianAtFace;
+        return jacobianAtFace;
+    }
+
+    /// \brief Compute one time step with PETSc TS.
+    void computeOneTimeStep(double &time, const double dt) override;
+
+    /// \brief Check that no options are used that this interface does not
+    /// support.
+    bool checkBeforeSolving() override;
+
+    /// \brief Total number of nonlinear iterations of all time steps so far.
+    std::size_t getNumberOfNonlinearIterations() const {
+        return numberOfNonlinearIterations_;
+    }
+
+    /// \brief Total number of linear iterations of all time steps so far.
+    std::size_t getNumberOfLinearIterations() const {
+        return numberOfLinearIterations_;
+    }
+
+   protected:
+    /// \brief Part of the right hand side that is currently being computed.
+    RightHandSidePart getRightHandSidePart() const {
+        return rightHandSidePart_;
+    }
+
+    /// \brief Compute the requested part of the right hand side of the
+    /// coefficients in the state vector and store it in the result vector.
+    void computeRightHandSidePart(const RightHandSidePart part,
+                                  const double time);
+
+    /// \brief Compute the element and face matrices of the Jacobian of the
+    /// implicit residual \f$ \sigma M - \partial f_I / \partial u \f$ at the
+    /// coefficients in the state vector.
+    void computeJacobianMatrices(const double shift, const double time);
+
+    /// Split the right hand side in an implicit and an explicit part.
+    const bool useImex_;
+
+    /// Assemble the Jacobian instead of using finite differences.
+    const bool assembleJacobian_;
+
+    /// Time integration vector with the coefficients at which the residual is
+    /// evaluated.
+    const std::size_t stateVectorId_;
+
+    /// Time integration vector with the result of the right hand side.
+    const std::size_t resultVectorId_;
+
+    /// Element matrix with the mass matrix.
+    const std::size_t massElementMatrixID_;
+
+    /// Element matrix with the element block of the Jacobian.
+    const std::size_t jacobianElementMatrixID_;
+
+    /// Face matrix with the face blocks of the Jacobian.
+    const std::size_t jacobianFaceMatrixID_;
+
+   private:
+    /// \brief Create the global vectors and matrices and the PETSc TS.
+    void createTimeStepper(const double time);
+
+#if defined(HPGEM_USE_ANY_PETSC)
+    /// \brief Copy the PETSc vector into the state vector of the elements.
+    void writeState(Vec state);
+
+    /// \brief Residual \f$ M\dot{u} - f_I(u) \f$.
+    static PetscErrorCode computeIFunction(TS ts, PetscReal time, Vec state,
+                                           Vec stateDot, Vec residual,
+                                           void *context);
+
+    /// \brief Explicit part \f$ f_E(u) \f$, only used for IMEX.
+    static PetscErrorCode computeRHSFunction(TS ts, PetscReal time, Vec state,
+                                             Vec result, void *context);
+
+    /// \brief Jacobian \f$ \sigma M - \partial f_I / \partial u \f$ of the
+    /// residual.
+    static PetscErrorCode computeIJacobian(TS ts, PetscReal time, Vec state,
+                                           Vec stateDot, PetscReal shift,
+                                           Mat jacobian, Mat preconditioner,
+                                           void *context);
+
+    std::unique_ptr<Utilities::GlobalIndexing> indexing_;
+    std::unique_ptr<Utilities::GlobalPetscMatrix> massMatrix_;
+    /// Assembled Jacobian, or only the block diagonal preconditioner when the
+    /// Jacobian is approximated by finite differences.
+    std::unique_ptr<Utilities::GlobalPetscMatrix> jacobian_;
+    std::unique_ptr<Utilities::GlobalPetscVector> solution_;
+    std::unique_ptr<Utilities::GlobalPetscVector> stateVector_;
+    std::unique_ptr<Utilities::GlobalPetscVector> resultVector_;
+    Mat matrixFreeJacobian_;
+    TS ts_;
+#endif
+
+    RightHandSidePart rightHandSidePart_;
+
+    std::size_t numberOfNonlinearIterations_;
+    std::size_t numberOfLinearIterations_;
+};
+}  // namespace Base
+}  // namespace hpgem
+#include "HpgemAPIImplicit_Impl.h"
+
+#endif  // HPGEM_KERNEL_HPGEMAPIIMPLICIT_H
@@ -0,0 +1,393 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "HpgemAPIImplicit.h"
+
+#include "Base/CommandLineOptions.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/FaceMatrix.h"
+
+#include "Logger.h"
+namespace hpgem {
+namespace Base {
+
+/// \param[in] numberOfUnknowns Number of variables in the PDE
+/// \param[in] polynomialOrder Polynomial order of the basis functions
+/// \param[in] useImex Split the right hand side in an explicit and an implicit
+/// part (true) or treat it fully implicit (false).
+/// \param[in] assembleJacobian Assemble the Jacobian from
+/// computeJacobianAtElement and computeJacobianAtFace (true) or approximate it
+/// with finite differences of the right hand side (false).
+/// \param[in] computeBothFaces Compute integrands for test functions on
+/// both sides of the faces simultaneously (true) or seperately (false).
+template <std::size_t DIM>
+HpgemAPIImplicit<DIM>::HpgemAPIImplicit(const std::size_t numberOfUnknowns,
+                                        const std::size_t polynomialOrder,
+                                        const bool useImex,
+                                        const bool assembleJacobian,
+                                        const bool computeBothFaces)
+    : HpgemAPISimplified<DIM>(numberOfUnknowns, polynomialOrder, 3, 0,
+                              computeBothFaces),
+      useImex_(useImex),
+      assembleJacobian_(assembleJacobian),
+      stateVectorId_(1),
+      resultVectorId_(2),
+      massElementMatrixID_(0),
+      jacobianElementMatrixID_(1),
+      jacobianFaceMatrixID_(0),
+#if defined(HPGEM_USE_ANY_PETSC)
+      matrixFreeJacobian_(nullptr),
+      ts_(nullptr),
+#endif
+      rightHandSidePart_(RightHandSidePart::ALL),
+      numberOfNonlinearIterations_(0),
+      numberOfLinearIterations_(0) {
+}
+
+template <std::size_t DIM>
+HpgemAPIImplicit<DIM>::~HpgemAPIImplicit() {
+#if defined(HPGEM_USE_ANY_PETSC)
+    TSDestroy(&ts_);
+    MatDestroy(&matrixFreeJacobian_);
+#endif
+}
+
+template <std::size_t DIM>
+void HpgemAPIImplicit<DIM>::readMesh(std::string fileName) {
+    // Set the number of Element/Face Matrices/Vectors.
+    std::size_t numberOfElementMatrices = 2;  // Mass matrix and Jacobian
+    std::size_t numberOfElementVectors = 0;
+    std::size_t numberOfFaceMatrices = 1;  // Jacobian
+    std::size_t numberOfFaceVectors = 0;
+
+    // Create mesh and set basis functions.
+    this->addMesh(fileName, numberOfElementMatrices, numberOfElementVectors,
+                  numberOfFaceMatrices, numberOfFaceVectors);
+    if (reorderMesh.getValue()) {
+        this->meshes_[0]->sortAlongSpaceFillingCurve();
+    }
+    this->meshes_[0]->useDefaultDGBasisFunctions(this->polynomialOrder_);
+
+    // Solution, state and result vector.
+    this->setNumberOfTimeIntegrationVectorsGlobally(
+        this->globalNumberOfTimeIntegrationVectors_);
+
+    // Plot info about the mesh
+    std::size_t numberOfElements = this->meshes_[0]->getNumberOfElements();
+    logger(VERBOSE, "Total number of elements: %", numberOfElements);
+}
+
+/// \details The mesh is fixed during the computation, so the options that
+/// change the mesh or the time step per element are rejected.
+template <std::size_t DIM>
+bool HpgemAPIImplicit<DIM>::checkBeforeSolving() {
+    HpgemAPISimplified<DIM>::checkBeforeSolving();
+    if (error.isUsed()) {
+        logger(ERROR,
+               "Error controlled time stepping is not supported with implicit "
+               "time integration, use the PETSc option -ts_adapt_type "
+               "instead.");
+    }
+    if (numberOfLocalTimeLevels.getValue() > 1) {
+        logger(ERROR,
+               "Local time stepping is not supported with implicit time "
+               "integration.");
+    }
+    if (numberOfStepsBetweenAdaptations.getValue() > 0 ||
+        numberOfStepsBetweenPAdaptations.getValue() > 0 ||
+        numberOfStepsBetweenRebalancing.getValue() > 0) {
+        logger(ERROR,
+               "Mesh adaptation and rebalancing are not supported with "
+               "implicit time integration.");
+    }
+    return true;
+}
+
+template <std::size_t DIM>
+void HpgemAPIImplicit<DIM>::computeRightHandSidePart(
+    const RightHandSidePart part, const double time) {
+    rightHandSidePart_ = part;
+    this->computeRightHandSide(stateVectorId_, resultVectorId_, time);
+    rightHandSidePart_ = RightHandSidePart::ALL;
+}
+
+/// \details Without an assembled Jacobian only the element blocks
+/// \f$ \sigma M \f$ are computed, these are used for the preconditioner.
+template <std::size_t DIM>
+void HpgemAPIImplicit<DIM>::computeJacobianMatrices(const double shift,
+                                                    const double time) {
+    for (Base::Element *ptrElement : this->meshes_[0]->getElementsList()) {
+        LinearAlgebra::MiddleSizeMatrix jacobian =
+            ptrElement->getElementMatrix(massElementMatrixID_) * shift;
+        if (assembleJacobian_) {
+            jacobian -= computeJacobianAtElement(
+                ptrElement, ptrElement->getTimeIntegrationVector(stateVectorId_),
+                time);
+        }
+        ptrElement->setElementMatrix(jacobian, jacobianElementMatrixID_);
+    }
+
+    if (!assembleJacobian_) {
+        return;
+    }
+
+    for (Base::Face *ptrFace : this->meshes_[0]->getFacesList()) {
+        if (!ptrFace->isOwnedByCurrentProcessor()) continue;
+
+        LinearAlgebra::MiddleSizeVector &coefficientsLeft =
+            ptrFace->getPtrElementLeft()->getTimeIntegrationVector(
+                stateVectorId_);
+        if (ptrFace->isInternal()) {
+            LinearAlgebra::MiddleSizeVector &coefficientsRight =
+                ptrFace->getPtrElementRight()->getTimeIntegrationVector(
+                    stateVectorId_);
+            Base::FaceMatrix jacobian(
+                ptrFace->getPtrElementLeft()->getTotalNumberOfBasisFunctions(),
+                ptrFace->getPtrElementRight()
+                    ->getTotalNumberOfBasisFunctions());
+            for (Base::Side elementSide :
+                 {Base::Side::LEFT, Base::Side::RIGHT}) {
+                for (Base::Side derivativeSide :
+                     {Base::Side::LEFT, Base::Side::RIGHT}) {
+                    jacobian.setElementMatrix(
+                        -computeJacobianAtFace(ptrFace, coefficientsLeft,
+                                               coefficientsRight, time,
+                                               elementSide, derivativeSide),
+                        elementSide, derivativeSide);
+                }
+            }
+            ptrFace->setFaceMatrix(jacobian, jacobianFaceMatrixID_);
+        } else {
+            Base::FaceMatrix jacobian(
+                ptrFace->getPtrElementLeft()->getTotalNumberOfBasisFunctions(),
+                0);
+            jacobian.setElementMatrix(
+                -computeJacobianAtFace(ptrFace, coefficientsLeft, time),
+                Base::Side::LEFT, Base::Side::LEFT);
+            ptrFace->setFaceMatrix(jacobian, jacobianFaceMatrixID_);
+        }
+    }
+}
+
+/// \details The global matrices need element and face matrices of the right
+/// size, so these are computed first at the current solution.
+template <std::size_t DIM>
+void HpgemAPIImplicit<DIM>::createTimeStepper(const double time) {
+#if defined(HPGEM_USE_ANY_PETSC)
+    for (Base::Element *ptrElement : this->meshes_[0]->getElementsList()) {
+        ptrElement->setElementMatrix(
+            this->computeMassMatrixAtElement(ptrElement), massElementMatrixID_);
+        ptrElement->getTimeIntegrationVector(stateVectorId_) =
+            ptrElement->getTimeIntegrationVector(this->solutionVectorId_);
+    }
+    this->synchronize(stateVectorId_);
+    computeJacobianMatrices(1., time);
+
+    indexing_ = std::make_unique<Utilities::GlobalIndexing>(this->meshes_[0]);
+    massMatrix_ = std::make_unique<Utilities::GlobalPetscMatrix>(
+        *indexing_, massElementMatrixID_, -1);
+    jacobian_ = std::make_unique<Utilities::GlobalPetscMatrix>(
+        *indexing_, jacobianElementMatrixID_,
+        assembleJacobian_ ? static_cast<int>(jacobianFaceMatrixID_) : -1);
+    solution_ =
+        std::make_unique<Utilities::GlobalPetscVector>(*indexing_, -1, -1);
+    stateVector_ =
+        std::make_unique<Utilities::GlobalPetscVector>(*indexing_, -1, -1);
+    resultVector_ =
+        std::make_unique<Utilities::GlobalPetscVector>(*indexing_, -1, -1);
+
+    int ierr = TSCreate(PETSC_COMM_WORLD, &ts_);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    ierr = TSSetProblemType(ts_, TS_NONLINEAR);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    ierr = TSSetType(ts_, TSARKIMEX);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    if (!useImex_) {
+        ierr = TSARKIMEXSetFullyImplicit(ts_, PETSC_TRUE);
+        CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    }
+    ierr = TSSetIFunction(ts_, nullptr, computeIFunction, this);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    if (useImex_) {
+        ierr = TSSetRHSFunction(ts_, nullptr, computeRHSFunction, this);
+        CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    }
+
+    if (assembleJacobian_) {
+        ierr = TSSetIJacobian(ts_, *jacobian_, *jacobian_, computeIJacobian,
+                              this);
+    } else {
+        // Jacobian-free Newton-Krylov: the action of the Jacobian is computed
+        // by differencing the residual, the block diagonal of the Jacobian is
+        // used to build the preconditioner.
+        SNES snes;
+        ierr = TSGetSNES(ts_, &snes);
+        CHKERRABORT(PETSC_COMM_WORLD, ierr);
+        ierr = MatCreateSNESMF(snes, &matrixFreeJacobian_);
+        CHKERRABORT(PETSC_COMM_WORLD, ierr);
+        ierr = TSSetIJacobian(ts_, matrixFreeJacobian_, *jacobian_,
+                              computeIJacobian, this);
+    }
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+
+    // The time step is chosen by the caller of computeOneTimeStep
+    TSAdapt adapt;
+    ierr = TSGetAdapt(ts_, &adapt);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    ierr = TSAdaptSetType(adapt, TSADAPTNONE);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    ierr = TSSetExactFinalTime(ts_, TS_EXACTFINALTIME_MATCHSTEP);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    ierr = TSSetFromOptions(ts_);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+#endif
+}
+
+template <std::size_t DIM>
+void HpgemAPIImplicit<DIM>::computeOneTimeStep(double &time, const double dt) {
+#if defined(HPGEM_USE_ANY_PETSC)
+    if (ts_ == nullptr) {
+        createTimeStepper(time);
+    }
+
+    solution_->constructFromTimeIntegrationVector(this->solutionVectorId_);
+
+    int ierr = TSSetTime(ts_, time);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    ierr = TSSetTimeStep(ts_, dt);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    ierr = TSSetStepNumber(ts_, 0);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    ierr = TSSetMaxTime(ts_, time + dt);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    ierr = TSSolve(ts_, *solution_);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+
+    TSConvergedReason reason;
+    TSGetConvergedReason(ts_, &reason);
+    if (reason < 0) {
+        logger(ERROR, "Implicit time step at time % failed: %", time,
+               TSConvergedReasons[reason]);
+    }
+    PetscInt iterations;
+    TSGetSNESIterations(ts_, &iterations);
+    numberOfNonlinearIterations_ += iterations;
+    TSGetKSPIterations(ts_, &iterations);
+    numberOfLinearIterations_ += iterations;
+
+    solution_->writeTimeIntegrationVector(this->solutionVectorId_);
+    this->synchronize(this->solutionVectorId_);
+
+    time += dt;
+    return;
+#endif
+    logger(ERROR,
+           "Petsc is needed for implicit time integration. Please put "
+           "if(hpGEM_USE_PETSC) in the CMakeLists.txt of your application to "
+           "make this clearer to other users");
+}
+
+#if defined(HPGEM_USE_ANY_PETSC)
+template <std::size_t DIM>
+void HpgemAPIImplicit<DIM>::writeState(Vec state) {
+    int ierr = VecCopy(state, *stateVector_);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    stateVector_->writeTimeIntegrationVector(stateVectorId_);
+    this->synchronize(stateVectorId_);
+}
+
+template <std::size_t DIM>
+PetscErrorCode HpgemAPIImplicit<DIM>::computeIFunction(TS ts, PetscReal time,
+                                                       Vec state, Vec stateDot,
+                                                       Vec residual,
+                                                       void *context) {
+    auto *self = static_cast<HpgemAPIImplicit<DIM> *>(context);
+    self->writeState(state);
+    self->computeRightHandSidePart(
+        self->useImex_ ? RightHandSidePart::IMPLICIT : RightHandSidePart::ALL,
+        time);
+    self->resultVector_->constructFromTimeIntegrationVector(
+        self->resultVectorId_);
+
+    PetscErrorCode ierr = MatMult(*self->massMatrix_, stateDot, residual);
+    CHKERRQ(ierr);
+    ierr = VecAXPY(residual, -1., *self->resultVector_);
+    CHKERRQ(ierr);
+    return 0;
+}
+
+template <std::size_t DIM>
+PetscErrorCode HpgemAPIImplicit<DIM>::computeRHSFunction(TS ts,
+                                                         PetscReal time,
+                                                         Vec state, Vec result,
+                                                         void *context) {
+    auto *self = static_cast<HpgemAPIImplicit<DIM> *>(context);
+    self->writeState(state);
+    self->computeRightHandSidePart(RightHandSidePart::EXPLICIT, time);
+    self->resultVector_->constructFromTimeIntegrationVector(
+        self->resultVectorId_);
+
+    PetscErrorCode ierr = VecCopy(*self->resultVector_, result);
+    CHKERRQ(ierr);
+    return 0;
+}
+
+/// \details The global matrix is re-assembled in place, so PETSc can keep
+/// using the same Mat handle and its nonzero structure.
+template <std::size_t DIM>
+PetscErrorCode HpgemAPIImplicit<DIM>::computeIJacobian(
+    TS ts, PetscReal time, Vec state, Vec stateDot, PetscReal shift,
+    Mat jacobian, Mat preconditioner, void *context) {
+    auto *self = static_cast<HpgemAPIImplicit<DIM> *>(context);
+    self->writeState(state);
+    self->computeJacobianMatrices(shift, time);
+    self->jacobian_->assemble();
+
+    if (jacobian != preconditioner) {
+        // Let the matrix free Jacobian pick up the new base point
+        PetscErrorCode ierr = MatAssemblyBegin(jacobian, MAT_FINAL_ASSEMBLY);
+        CHKERRQ(ierr);
+        ierr = MatAssemblyEnd(jacobian, MAT_FINAL_ASSEMBLY);
+        CHKERRQ(ierr);
+    }
+    return 0;
+}
+#endif
+}  // namespace Base
+}  // namespace hpgem
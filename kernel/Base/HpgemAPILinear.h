@@ -300,6 +300,10 @@ class HpgemAPILinear : public HpgemAPISimplified<DIM> {
     /// \brief Create and Store things before solving the problem.
     void tasksBeforeSolving() override;
 
+    /// \brief Compute the mass and stiffness matrices again for the new
+    /// elements and basis functions.
+    void tasksAfterMeshChange() override;
+
    protected:
     /// Boolean to indicate if there is a source term.
     const bool useSourceTerm_;
@@ -504,5 +504,11 @@ void HpgemAPILinear<DIM>::tasksBeforeSolving() {
     logger(INFO, "Computing stiffness matrices.");
     createStiffnessMatrices();
 }
+
+template <std::size_t DIM>
+void HpgemAPILinear<DIM>::tasksAfterMeshChange() {
+    createMassMatrices();
+    createStiffnessMatrices();
+}
 }  // namespace Base
 }  // namespace hpgem
\ No newline at end of file
@@ -57,6 +57,66 @@ CommandLineOption<double>& dt = Base::register_argument<double>(
 CommandLineOption<double>& error = Base::register_argument<double>(
     0, "error", "maximum acceptable relative error per time step", false,
     std::numeric_limits<double>::infinity());
+CommandLineOption<std::size_t>& numberOfLocalTimeLevels =
+    Base::register_argument<std::size_t>(
+        0, "timeLevels",
+        "maximum number of power-of-two local time step levels (1 disables "
+        "local time stepping)",
+        false, 1);
+CommandLineOption<std::size_t>& numberOfStepsBetweenAdaptations =
+    Base::register_argument<std::size_t>(
+        0, "adaptEvery",
+        "number of time steps between two adaptations of the mesh (0 disables "
+        "mesh adaptation)",
+        false, 0);
+CommandLineOption<std::size_t>& maximumRefinementLevel =
+    Base::register_argument<std::size_t>(
+        0, "maxRefinementLevel",
+        "maximum number of times an element of the initial mesh is refined",
+        false, 2);
+CommandLineOption<double>& adaptFraction = Base::register_argument<double>(
+    0, "adaptFraction",
+    "fraction of the elements that is refined (and coarsened), or raised (and "
+    "lowered) in polynomial order, at every adaptation of the mesh",
+    false, 0.1);
+CommandLineOption<std::size_t>& numberOfStepsBetweenPAdaptations =
+    Base::register_argument<std::size_t>(
+        0, "pAdaptEvery",
+        "number of time steps between two adaptations of the polynomial orders "
+        "(0 disables p-adaptation)",
+        false, 0);
+CommandLineOption<std::size_t>& minimumPolynomialOrder =
+    Base::register_argument<std::size_t>(
+        0, "minPolynomialOrder",
+        "lowest polynomial order that p-adaptation may assign to an element",
+        false, 1);
+CommandLineOption<std::size_t>& maximumPolynomialOrder =
+    Base::register_argument<std::size_t>(
+        0, "maxPolynomialOrder",
+        "highest polynomial order that p-adaptation may assign to an element",
+        false, 5);
+CommandLineOption<std::size_t>& numberOfStepsBetweenRebalancing =
+    Base::register_argument<std::size_t>(
+        0, "rebalanceEvery",
+        "number of time steps between two checks of the load balance (0 "
+        "disables load rebalancing)",
+        false, 0);
+CommandLineOption<double>& imbalanceTolerance =
+    Base::register_argument<double>(
+        0, "imbalanceTolerance",
+        "ratio of the largest and the average processor load above which the "
+        "mesh is redistributed",
+        false, 1.1);
+CommandLineOption<bool>& reorderMesh = Base::register_argument<bool>(
+    0, "reorderMesh",
+    "sort the elements and faces along a space filling curve after reading "
+    "the mesh, so global matrices are closer to banded",
+    false, false);
+CommandLineOption<bool>& orthonormalBasis = Base::register_argument<bool>(
+    0, "orthonormalBasis",
+    "use orthonormal modal basis functions, so the mass matrix of elements "
+    "with an affine mapping is a multiple of the identity",
+    false, false);
 CommandLineOption<std::string>& outputName =
     Base::register_argument<std::string>(
         0, "outFile", "Name of the output file (without extentions)", false,
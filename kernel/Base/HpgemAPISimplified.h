@@ -51,6 +51,7 @@
 #include "Output/TecplotSingleElementWriter.h"
 #include "Output/VTKTimeDependentWriter.h"
 #include <functional>
+#include <unordered_map>
 namespace hpgem {
 namespace Integration {
 template <std::size_t DIM>
@@ -63,6 +64,17 @@ extern CommandLineOption<double> &endTime;
 extern CommandLineOption<double> &dt;
 extern CommandLineOption<double> &error;
 extern CommandLineOption<std::size_t> &numberOfSnapshots;
+extern CommandLineOption<std::size_t> &numberOfLocalTimeLevels;
+extern CommandLineOption<std::size_t> &numberOfStepsBetweenAdaptations;
+extern CommandLineOption<std::size_t> &maximumRefinementLevel;
+extern CommandLineOption<double> &adaptFraction;
+extern CommandLineOption<std::size_t> &numberOfStepsBetweenPAdaptations;
+extern CommandLineOption<std::size_t> &minimumPolynomialOrder;
+extern CommandLineOption<std::size_t> &maximumPolynomialOrder;
+extern CommandLineOption<std::size_t> &numberOfStepsBetweenRebalancing;
+extern CommandLineOption<double> &imbalanceTolerance;
+extern CommandLineOption<bool> &reorderMesh;
+extern CommandLineOption<bool> &orthonormalBasis;
 
 /// \brief Simplified Interface for solving PDE's.
 /** This class is well-suited for problems of the form \f[ l(\partial_t^k u) =
@@ -132,7 +144,24 @@ extern CommandLineOption<std::size_t> &numberOfSnapshots;
  * output file. \li Override the function 'showProgress' to determine how you
  * want to show the progress of the time integration routine. \li Override the
  * function 'solve' when using another time integration routine than a
- * Runge-Kutta integration method.
+ * Runge-Kutta integration method. \li Override the function
+ * 'computeMaximumWaveSpeedAtElement' (or 'computeLocalTimeStepAtElement') and
+ * pass --timeLevels to let elements take local time steps that match their
+ * own size and wave speed. \li Pass --adaptEvery to refine and coarsen the
+ * mesh during the time integration, based on the error indicators computed by
+ * 'computeErrorIndicators' (by default the jumps of the solution over the
+ * faces). Adaptation is only supported for serial computations. \li Pass
+ * --pAdaptEvery to raise and lower the polynomial order of single elements,
+ * based on the same error indicators, between --minPolynomialOrder and
+ * --maxPolynomialOrder. \li Pass --rebalanceEvery to redistribute the
+ * elements over the processors when the load, as estimated by
+ * 'computeElementCost', becomes unbalanced. \li Pass
+ * --reorderMesh to sort the element and face lists along a space filling
+ * curve, which brings the global matrices of meshes with a random element
+ * order closer to banded form.
+ * \li Pass --orthonormalBasis to use orthonormal modal basis functions, so
+ * the mass matrix equations of elements with an affine mapping are solved by
+ * a scaling (see 'hasScaledIdentityMassMatrix').
  */
 /** \details For an example of using this interface see the application class
  * 'AcousticWave'.
@@ -194,6 +223,23 @@ class HpgemAPISimplified : public HpgemAPIBase<DIM>,
     virtual LinearAlgebra::MiddleSizeMatrix computeMassMatrixAtElement(
         Base::Element *ptrElement);
 
+    /// \brief Whether the mass matrix of the element is |J| times the identity
+    /// matrix.
+    /// \details This holds for orthonormal basis functions on an element with
+    /// an affine mapping, in which case solveMassMatrixEquationsAtElement
+    /// divides by |J| instead of computing and solving the mass matrix.
+    /// Override this function to return false if you change the integrand of
+    /// the mass matrix; otherwise solve stops with an error in
+    /// checkScaledIdentityMassMatrices.
+    virtual bool hasScaledIdentityMassMatrix(
+        const Base::Element *ptrElement) const;
+
+    /// \brief Check that computeMassMatrixAtElement gives |J| times the
+    /// identity matrix for the elements for which hasScaledIdentityMassMatrix
+    /// holds, so an overridden mass matrix is not silently replaced by a
+    /// scaling.
+    void checkScaledIdentityMassMatrices();
+
     /// \brief Solve the mass matrix equations for a single element.
     /// \details Solve the equation \f$ Mu = r \f$ for \f$ u \f$ for a single
     /// element, where \f$ r \f$ is the right-hand sid and \f$ M \f$ is the mass
@@ -379,6 +425,63 @@ class HpgemAPISimplified : public HpgemAPIBase<DIM>,
     virtual void computeOneTimeStep(double &time, const double maxRelativeError,
                                     const double dtMax);
 
+    /// \brief Compute the maximum wave speed at an element, this is used to
+    /// assign the element to a local time level.
+    virtual double computeMaximumWaveSpeedAtElement(
+        Base::Element * /*ptrElement*/,
+        const LinearAlgebra::MiddleSizeVector & /*solutionCoefficients*/) {
+        return 1.0;
+    }
+
+    /// \brief Estimate the largest stable time step for a single element.
+    virtual double computeLocalTimeStepAtElement(Base::Element *ptrElement);
+
+    /// \brief Group the elements in power-of-two local time levels and return
+    /// the time step of the coarsest level.
+    virtual double computeLocalTimeLevels(const double finestTimeStep);
+
+    /// \brief Compute one time step, where every local time level is advanced
+    /// with its own time step.
+    virtual void computeOneLocalTimeStep(double &time, const double timeStep);
+
+    /// \brief Get the local time level of an element, 0 is the coarsest level.
+    std::size_t getLocalTimeLevel(const Base::Element *ptrElement) const {
+        return ptrElement->getLocalTimeLevel();
+    }
+
+    /// \brief Get the number of local time levels in use (on all processors).
+    std::size_t getNumberOfLocalTimeLevels() const {
+        return elementsPerLocalTimeLevel_.size();
+    }
+
+    /// \brief Compute an error indicator for every local element, based on the
+    /// jumps of the numerical solution over its internal faces.
+    virtual std::unordered_map<std::size_t, double> computeErrorIndicators(
+        const std::size_t timeIntegrationVectorId);
+
+    /// \brief Get the refinement mapping that is used to split an element when
+    /// the mesh is adapted.
+    virtual const Geometry::RefinementMapping *getRefinementMapping(
+        const Base::Element *ptrElement);
+
+    /// \brief Refine and coarsen the mesh based on the error indicators and
+    /// transfer all time integration vectors to the new active elements.
+    virtual void adaptMesh();
+
+    /// \brief Raise and lower the polynomial order of the elements based on the
+    /// error indicators and transfer all time integration vectors to the new
+    /// basis functions.
+    virtual void adaptPolynomialOrders();
+
+    /// \brief Estimate the work per coarse time step for a single element, used
+    /// to balance the load over the processors.
+    virtual double computeElementCost(const Base::Element *ptrElement);
+
+    /// \brief Redistribute the elements over the processors if the load is
+    /// unbalanced and transfer all time integration vectors to their new owner.
+    /// Returns whether the mesh has been redistributed.
+    virtual bool rebalance();
+
     /// \brief Set output names.
     virtual void setOutputNames(std::string outputFileName,
                                 std::string internalFileTitle,
@@ -417,6 +520,11 @@ class HpgemAPISimplified : public HpgemAPIBase<DIM>,
     /// \brief Create and Store things before solving the problem.
     virtual void tasksBeforeSolving() {}
 
+    /// \brief Update the things that were stored before solving after the
+    /// elements or their basis functions have changed, i.e. after adaptMesh,
+    /// adaptPolynomialOrders or a rebalance that redistributed the mesh.
+    virtual void tasksAfterMeshChange() {}
+
     virtual void tasksAfterSolving() {}
 
     /// \brief Check things before solving (e.g. check if a mesh is created.)
@@ -496,6 +604,72 @@ class HpgemAPISimplified : public HpgemAPIBase<DIM>,
     }
 
    private:
+    /// \brief Compute the error indicators above and below which a fraction
+    /// --adaptFraction of the elements lies. Returns false if that fraction
+    /// contains no elements.
+    bool computeAdaptationThresholds(
+        const std::unordered_map<std::size_t, double> &errorIndicators,
+        double &upperThreshold, double &lowerThreshold) const;
+
+    /// \brief Advance all elements of a local time level by one step of size
+    /// timeStep, followed by two half steps of all finer levels.
+    void advanceLocalTimeLevel(const std::size_t level, const double time,
+                               const double timeStep);
+
+    /// \brief Compute the time derivative for the elements of a single local
+    /// time level. The face contributions between levels are also added to
+    /// the flux correction of the coarser element, with the given weight.
+    void computeTimeDerivativeAtLocalTimeLevel(
+        const std::size_t level, const std::vector<std::size_t> &inputVectorIds,
+        const std::vector<double> &coefficientsInputVectors,
+        const std::size_t resultVectorId, const double time,
+        const double fluxCorrectionWeight);
+
+    /// \brief Check if the stages of an element are computed when advancing
+    /// a local time level: the element is on this level, or on a finer level
+    /// and next to an element that is on this level or coarser.
+    bool isActiveAtLocalTimeLevel(const Base::Element *ptrElement,
+                                  const std::size_t level) const {
+        const std::size_t elementLevel = ptrElement->getLocalTimeLevel();
+        return elementLevel == level ||
+               (elementLevel > level &&
+                ptrElement->getCoarsestNeighbourLocalTimeLevel() <= level);
+    }
+
+    /// \brief Get the coefficients of an element as seen from a given local
+    /// time level at a given time.
+    LinearAlgebra::MiddleSizeVector getStateAtLocalTimeLevel(
+        const Base::Element *ptrElement, const std::size_t level,
+        const std::vector<std::size_t> &inputVectorIds,
+        const std::vector<double> &coefficientsInputVectors, const double time);
+
+    /// Local elements per local time level.
+    std::vector<std::vector<Base::Element *>> elementsPerLocalTimeLevel_;
+
+    /// Local elements for which the stages are computed per local time level,
+    /// this includes the finer elements next to the level.
+    std::vector<std::vector<Base::Element *>> activeElementsPerLocalTimeLevel_;
+
+    /// Local faces next to an active element per local time level.
+    std::vector<std::vector<Base::Face *>> facesPerLocalTimeLevel_;
+
+    /// Start time and size of the current step of every local time level.
+    std::vector<double> localTimeLevelStartTimes_;
+    std::vector<double> localTimeLevelStepSizes_;
+
+    /// Index of the time integration vector that stores the solution at the
+    /// start of the current step of the level of the element.
+    std::size_t localTimeLevelStartVectorId_;
+
+    /// Index of the time integration vector that collects, during the step of
+    /// the level of the element, the difference between the face
+    /// contributions of the finer neighbours and the predicted ones used in
+    /// its own stages.
+    std::size_t localTimeLevelFluxCorrectionVectorId_;
+
+    /// Whether the two time integration vectors above have been added
+    bool hasLocalTimeLevelVectors_;
+
     std::vector<
         std::pair<std::function<double(Base::Element *,
                                        const Geometry::PointReference<DIM> &,
@@ -45,6 +45,11 @@
 #include "Base/MpiContainer.h"
 #include "Base/TimeIntegration/AllTimeIntegrators.h"
 #include "Geometry/PointReference.h"
+#include "Geometry/Mappings/MappingReferenceToPhysical.h"
+#include "Geometry/Mappings/RefinementMapsForCube.h"
+#include "Geometry/Mappings/RefinementMapsForLine.h"
+#include "Geometry/Mappings/RefinementMapsForSquare.h"
+#include "Geometry/Mappings/RefinementMapsForTriangle.h"
 #include "Integration/ElementIntegral.h"
 #include "Integration/FaceIntegral.h"
 #include "Output/TecplotDiscontinuousSolutionWriter.h"
@@ -54,9 +59,13 @@
 #include "Utilities/BasisFunctions2DH1ConformingTriangle.h"
 #include "Utilities/BasisFunctions3DH1ConformingCube.h"
 #include "Utilities/BasisFunctions3DH1ConformingTetrahedron.h"
+#include "Utilities/SpaceFillingCurvePartitioner.h"
 #include "LinearAlgebra/Axpy.h"
 
 #include "Logger.h"
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
 namespace hpgem {
 namespace Base {
 
@@ -67,6 +76,17 @@ extern CommandLineOption<double> &endTime;
 extern CommandLineOption<double> &startTime;
 extern CommandLineOption<double> &dt;
 extern CommandLineOption<std::string> &outputName;
+extern CommandLineOption<std::size_t> &numberOfLocalTimeLevels;
+extern CommandLineOption<std::size_t> &numberOfStepsBetweenAdaptations;
+extern CommandLineOption<std::size_t> &maximumRefinementLevel;
+extern CommandLineOption<double> &adaptFraction;
+extern CommandLineOption<std::size_t> &numberOfStepsBetweenPAdaptations;
+extern CommandLineOption<std::size_t> &minimumPolynomialOrder;
+extern CommandLineOption<std::size_t> &maximumPolynomialOrder;
+extern CommandLineOption<std::size_t> &numberOfStepsBetweenRebalancing;
+extern CommandLineOption<double> &imbalanceTolerance;
+extern CommandLineOption<bool> &reorderMesh;
+extern CommandLineOption<bool> &orthonormalBasis;
 
 /// \param[in] numberOfVariables Number of variables in the PDE
 /// \param[in] polynomialOrder Polynomial order of the basis functions
@@ -88,7 +108,10 @@ HpgemAPISimplified<DIM>::HpgemAPISimplified(
       internalFileTitle_("output"),
       solutionTitle_("solution"),
       computeBothFaces_(computeBothFaces),
-      polynomialOrder_(polynomialOrder) {
+      polynomialOrder_(polynomialOrder),
+      localTimeLevelStartVectorId_(0),
+      localTimeLevelFluxCorrectionVectorId_(0),
+      hasLocalTimeLevelVectors_(false) {
     this->globalNumberOfTimeIntegrationVectors_ =
         ptrButcherTableau->getNumberOfStages() + 1;
     solutionVectorId_ = 0;
@@ -121,7 +144,10 @@ HpgemAPISimplified<DIM>::HpgemAPISimplified(
       internalFileTitle_("output"),
       solutionTitle_("solution"),
       computeBothFaces_(computeBothFaces),
-      polynomialOrder_(polynomialOrder) {
+      polynomialOrder_(polynomialOrder),
+      localTimeLevelStartVectorId_(0),
+      localTimeLevelFluxCorrectionVectorId_(0),
+      hasLocalTimeLevelVectors_(false) {
     this->globalNumberOfTimeIntegrationVectors_ =
         globalNumberOfTimeIntegrationVectors;
     solutionVectorId_ = 0;
@@ -146,7 +172,15 @@ void HpgemAPISimplified<DIM>::readMesh(std::string fileName) {
     // Create mesh and set basis functions.
     this->addMesh(fileName, numberOfElementMatrices, numberOfElementVectors,
                   numberOfFaceMatrices, numberOfFaceVectors);
-    this->meshes_[0]->useDefaultDGBasisFunctions(this->polynomialOrder_);
+    if (reorderMesh.getValue()) {
+        this->meshes_[0]->sortAlongSpaceFillingCurve();
+    }
+    if (orthonormalBasis.getValue()) {
+        this->meshes_[0]->useOrthonormalDGBasisFunctions(
+            this->polynomialOrder_);
+    } else {
+        this->meshes_[0]->useDefaultDGBasisFunctions(this->polynomialOrder_);
+    }
 
     // Set the number of time integration vectors according to the size of the
     // Butcher tableau.
@@ -201,10 +235,56 @@ LinearAlgebra::MiddleSizeMatrix
     return this->elementIntegrator_.integrate(ptrElement, integrandFunction);
 }
 
+template <std::size_t DIM>
+bool HpgemAPISimplified<DIM>::hasScaledIdentityMassMatrix(
+    const Base::Element *ptrElement) const {
+    return ptrElement->hasOrthonormalBasisFunctions() &&
+           ptrElement->getReferenceToPhysicalMap()->isAffine();
+}
+
+/// \details Each element is checked once, before the time integration, so
+/// this costs as much as computing all mass matrices a single time.
+template <std::size_t DIM>
+void HpgemAPISimplified<DIM>::checkScaledIdentityMassMatrices() {
+    for (Base::Element *ptrElement : this->meshes_[0]->getElementsList()) {
+        if (!hasScaledIdentityMassMatrix(ptrElement)) {
+            continue;
+        }
+        const PointReferenceT &center =
+            ptrElement->getReferenceGeometry()->getCenter();
+        const double scaling =
+            std::abs(ptrElement->calcJacobian(center).determinant());
+        const LinearAlgebra::MiddleSizeMatrix massMatrix =
+            computeMassMatrixAtElement(ptrElement);
+        for (std::size_t i = 0; i < massMatrix.getNumberOfRows(); ++i) {
+            for (std::size_t j = 0; j < massMatrix.getNumberOfColumns(); ++j) {
+                const double expected = (i == j) ? scaling : 0.;
+                if (std::abs(massMatrix(i, j) - expected) > 1e-10 * scaling) {
+                    logger(ERROR,
+                           "The mass matrix of element % is not % times the "
+                           "identity matrix, but hasScaledIdentityMassMatrix "
+                           "holds. Do not use --orthonormalBasis with a "
+                           "different mass matrix, or override "
+                           "hasScaledIdentityMassMatrix.",
+                           ptrElement->getID(), scaling);
+                }
+            }
+        }
+    }
+}
+
 template <std::size_t DIM>
 void HpgemAPISimplified<DIM>::solveMassMatrixEquationsAtElement(
     Base::Element *ptrElement,
     LinearAlgebra::MiddleSizeVector &functionCoefficients) {
+    if (hasScaledIdentityMassMatrix(ptrElement)) {
+        // The Jacobian is the same everywhere, so evaluate it in the center
+        const PointReferenceT &center =
+            ptrElement->getReferenceGeometry()->getCenter();
+        functionCoefficients /=
+            std::abs(ptrElement->calcJacobian(center).determinant());
+        return;
+    }
     computeMassMatrixAtElement(ptrElement).solve(functionCoefficients);
 }
 
@@ -851,6 +931,948 @@ void HpgemAPISimplified<DIM>::computeOneTimeStep(
     time += dt;
 }
 
+/// \details By default the time step is estimated as \f$ h / ((2p+1) c) \f$,
+/// where \f$ h \f$ is the diameter of the element, \f$ p \f$ its polynomial
+/// order and \f$ c \f$ the maximum wave speed at the element. Only the ratios
+/// between the time steps of different elements are used.
+template <std::size_t DIM>
+double HpgemAPISimplified<DIM>::computeLocalTimeStepAtElement(
+    Base::Element *ptrElement) {
+    const double waveSpeed = computeMaximumWaveSpeedAtElement(
+        ptrElement, ptrElement->getTimeIntegrationVector(solutionVectorId_));
+    logger.assert_debug(waveSpeed > 0, "The wave speed should be positive.");
+    return ptrElement->getPhysicalGeometry()->getDiameter() /
+           (static_cast<double>(2 * ptrElement->getPolynomialOrder() + 1) *
+            waveSpeed);
+}
+
+/// \param[in] finestTimeStep Time step of the finest local time level, this
+/// is the time step that would be used without local time stepping.
+/// \return Time step of the coarsest local time level.
+/// \details An element that can take a time step that is \f$ 2^k \f$ times as
+/// large as the most restrictive element is put on level \f$ L-1-k \f$, where
+/// \f$ L \f$ is the number of levels. The number of levels is bounded by the
+/// command line option --timeLevels. This is called again after the mesh or
+/// the polynomial orders changed, the extra time integration vectors are only
+/// added the first time.
+template <std::size_t DIM>
+double HpgemAPISimplified<DIM>::computeLocalTimeLevels(
+    const double finestTimeStep) {
+    const std::size_t maximumNumberOfLevels =
+        numberOfLocalTimeLevels.getValue();
+    logger.assert_always(maximumNumberOfLevels > 0,
+                         "There should be at least one local time level");
+
+    // Local stable time step of all elements, including the shadow elements,
+    // such that every processor knows the levels of its neighbours.
+    std::unordered_map<std::size_t, double> localTimeSteps;
+    double minimumTimeStep = std::numeric_limits<double>::infinity();
+    for (Base::Element *ptrElement :
+         this->meshes_[0]->getElementsList(IteratorType::GLOBAL)) {
+        const double localTimeStep = computeLocalTimeStepAtElement(ptrElement);
+        localTimeSteps[ptrElement->getID()] = localTimeStep;
+        minimumTimeStep = std::min(minimumTimeStep, localTimeStep);
+    }
+#ifdef HPGEM_USE_MPI
+    auto &communicator = MPIContainer::Instance();
+    communicator.reduce(minimumTimeStep, MPI_MIN);
+    communicator.broadcast(minimumTimeStep);
+#endif
+
+    // Number of times the time step can be doubled for each element.
+    std::unordered_map<std::size_t, std::size_t> levels;
+    std::size_t numberOfLevels = 1;
+    for (auto &localTimeStep : localTimeSteps) {
+        const std::size_t numberOfDoublings = std::min(
+            maximumNumberOfLevels - 1,
+            static_cast<std::size_t>(
+                std::floor(std::log2(localTimeStep.second / minimumTimeStep))));
+        levels[localTimeStep.first] = numberOfDoublings;
+        numberOfLevels = std::max(numberOfLevels, numberOfDoublings + 1);
+    }
+#ifdef HPGEM_USE_MPI
+    communicator.reduce(numberOfLevels, MPI_MAX);
+    communicator.broadcast(numberOfLevels);
+#endif
+    // Count levels from coarse to fine
+    for (auto &level : levels) {
+        level.second = numberOfLevels - 1 - level.second;
+    }
+
+    // The coarsest level among each element and its neighbours. The shadow
+    // elements get this information from their owners.
+    std::unordered_map<std::size_t, std::size_t> coarsestNeighbourLevels =
+        levels;
+    for (Base::Face *ptrFace : this->meshes_[0]->getFacesList()) {
+        if (ptrFace->isInternal()) {
+            const std::size_t idLeft = ptrFace->getPtrElementLeft()->getID();
+            const std::size_t idRight = ptrFace->getPtrElementRight()->getID();
+            const std::size_t coarsestLevel =
+                std::min(levels[idLeft], levels[idRight]);
+            coarsestNeighbourLevels[idLeft] =
+                std::min(coarsestNeighbourLevels[idLeft], coarsestLevel);
+            coarsestNeighbourLevels[idRight] =
+                std::min(coarsestNeighbourLevels[idRight], coarsestLevel);
+        }
+    }
+#ifdef HPGEM_USE_MPI
+    Base::Submesh &submesh = this->meshes_[0]->getMesh().getSubmesh();
+    for (const auto &it : submesh.getPullElements()) {
+        for (Base::Element *ptrElement : it.second) {
+            communicator.receive(coarsestNeighbourLevels[ptrElement->getID()],
+                                 it.first, ptrElement->getID());
+        }
+    }
+    for (const auto &it : submesh.getPushElements()) {
+        for (Base::Element *ptrElement : it.second) {
+            communicator.send(coarsestNeighbourLevels[ptrElement->getID()],
+                              it.first, ptrElement->getID());
+        }
+    }
+    communicator.sync();
+#endif
+    // Store the levels on the elements, so the time stepping does not need
+    // to look them up
+    for (Base::Element *ptrElement :
+         this->meshes_[0]->getElementsList(IteratorType::GLOBAL)) {
+        ptrElement->setLocalTimeLevel(
+            levels[ptrElement->getID()],
+            coarsestNeighbourLevels[ptrElement->getID()]);
+    }
+
+    elementsPerLocalTimeLevel_.assign(numberOfLevels, {});
+    activeElementsPerLocalTimeLevel_.assign(numberOfLevels, {});
+    facesPerLocalTimeLevel_.assign(numberOfLevels, {});
+    localTimeLevelStartTimes_.assign(numberOfLevels, 0.);
+    localTimeLevelStepSizes_.assign(numberOfLevels, 0.);
+    for (Base::Element *ptrElement : this->meshes_[0]->getElementsList()) {
+        elementsPerLocalTimeLevel_[ptrElement->getLocalTimeLevel()].push_back(
+            ptrElement);
+        for (std::size_t level = 0; level < numberOfLevels; ++level) {
+            if (isActiveAtLocalTimeLevel(ptrElement, level)) {
+                activeElementsPerLocalTimeLevel_[level].push_back(ptrElement);
+            }
+        }
+    }
+    for (Base::Face *ptrFace : this->meshes_[0]->getFacesList()) {
+        for (std::size_t level = 0; level < numberOfLevels; ++level) {
+            if (isActiveAtLocalTimeLevel(ptrFace->getPtrElementLeft(), level) ||
+                (ptrFace->isInternal() &&
+                 isActiveAtLocalTimeLevel(ptrFace->getPtrElementRight(),
+                                          level))) {
+                facesPerLocalTimeLevel_[level].push_back(ptrFace);
+            }
+        }
+    }
+
+    // Two extra time integration vectors: the solution at the start of the
+    // step of each level, needed to interpolate coarse neighbours in time,
+    // and the flux correction of the interfaces between levels. Elements
+    // created later (e.g. by adaptMesh) get them from the global count.
+    if (!hasLocalTimeLevelVectors_) {
+        localTimeLevelStartVectorId_ =
+            this->globalNumberOfTimeIntegrationVectors_;
+        localTimeLevelFluxCorrectionVectorId_ =
+            this->globalNumberOfTimeIntegrationVectors_ + 1;
+        this->globalNumberOfTimeIntegrationVectors_ += 2;
+        this->setNumberOfTimeIntegrationVectorsGlobally(
+            this->globalNumberOfTimeIntegrationVectors_);
+        hasLocalTimeLevelVectors_ = true;
+    }
+
+    // Report the distribution of the elements over the levels and processors,
+    // the slowest processor of each level determines the pace of the others.
+    std::vector<std::size_t> numberOfElements(numberOfLevels);
+    for (std::size_t level = 0; level < numberOfLevels; ++level) {
+        numberOfElements[level] = elementsPerLocalTimeLevel_[level].size();
+    }
+    std::vector<std::size_t> totalNumberOfElements = numberOfElements;
+    std::vector<std::size_t> maximumNumberOfElements = numberOfElements;
+    std::size_t numberOfProcessors = 1;
+#ifdef HPGEM_USE_MPI
+    numberOfProcessors = communicator.getNumberOfProcessors();
+    communicator.reduce(totalNumberOfElements, MPI_SUM);
+    communicator.broadcast(totalNumberOfElements);
+    communicator.reduce(maximumNumberOfElements, MPI_MAX);
+    communicator.broadcast(maximumNumberOfElements);
+#endif
+    double workGlobalTimeStepping = 0;
+    double workLocalTimeStepping = 0;
+    for (std::size_t level = 0; level < numberOfLevels; ++level) {
+        const double numberOfElementsOnLevel =
+            static_cast<double>(totalNumberOfElements[level]);
+        workGlobalTimeStepping +=
+            numberOfElementsOnLevel *
+            std::ldexp(1., static_cast<int>(numberOfLevels - 1));
+        workLocalTimeStepping +=
+            numberOfElementsOnLevel * std::ldexp(1., static_cast<int>(level));
+        double imbalance = 1.;
+        if (totalNumberOfElements[level] > 0) {
+            imbalance = static_cast<double>(maximumNumberOfElements[level] *
+                                            numberOfProcessors) /
+                        numberOfElementsOnLevel;
+        }
+        logger(INFO,
+               "Local time level %: % elements, time step %, load imbalance "
+               "between processors %",
+               level, totalNumberOfElements[level],
+               std::ldexp(finestTimeStep,
+                          static_cast<int>(numberOfLevels - 1 - level)),
+               imbalance);
+    }
+    logger(INFO, "Expected speed-up of local time stepping: %",
+           workGlobalTimeStepping / workLocalTimeStepping);
+    return std::ldexp(finestTimeStep, static_cast<int>(numberOfLevels - 1));
+}
+
+/// \details The levels are advanced recursively from coarse to fine: first a
+/// level takes its own step, then the next finer level takes two steps of
+/// half the size. The Runge-Kutta stages of a level are also computed for the
+/// finer elements directly next to it, such that the coarse step sees a
+/// prediction of these neighbours instead of their frozen values. These
+/// predictions are discarded afterwards, only the elements of the level
+/// itself are updated. Neighbours on a coarser level have already completed
+/// their step and are interpolated linearly in time; neighbours further away
+/// on a finer level are used as they are at the start of the step.
+///
+/// On a face between two levels the coarse element first uses the flux of the
+/// predicted fine neighbour. Once the finer levels have caught up, this flux
+/// is replaced by the one that the fine neighbour actually used in its own
+/// steps, such that what leaves one element enters the other and the
+/// interface conserves mass.
+template <std::size_t DIM>
+void HpgemAPISimplified<DIM>::computeOneLocalTimeStep(double &time,
+                                                      const double timeStep) {
+    logger.assert_always(getNumberOfLocalTimeLevels() > 0,
+                         "Please compute the local time levels before using "
+                         "local time stepping");
+    advanceLocalTimeLevel(0, time, timeStep);
+    time += timeStep;
+}
+
+template <std::size_t DIM>
+void HpgemAPISimplified<DIM>::advanceLocalTimeLevel(const std::size_t level,
+                                                    const double time,
+                                                    const double timeStep) {
+    localTimeLevelStartTimes_[level] = time;
+    localTimeLevelStepSizes_[level] = timeStep;
+    for (Base::Element *ptrElement : elementsPerLocalTimeLevel_[level]) {
+        const LinearAlgebra::MiddleSizeVector &solutionCoefficients =
+            ptrElement->getTimeIntegrationVector(solutionVectorId_);
+        ptrElement->getTimeIntegrationVector(localTimeLevelStartVectorId_) =
+            solutionCoefficients;
+        ptrElement->getTimeIntegrationVector(
+            localTimeLevelFluxCorrectionVectorId_) =
+            LinearAlgebra::MiddleSizeVector(solutionCoefficients.size());
+    }
+    this->synchronize(localTimeLevelStartVectorId_);
+
+    // Compute intermediate Runge-Kutta stages for this level only
+    const std::size_t numberOfStages = ptrButcherTableau_->getNumberOfStages();
+    for (std::size_t iStage = 0; iStage < numberOfStages; iStage++) {
+        const double stageTime =
+            time + ptrButcherTableau_->getC(iStage) * timeStep;
+
+        std::vector<std::size_t> inputVectorIds;
+        std::vector<double> coefficientsInputVectors;
+
+        inputVectorIds.push_back(solutionVectorId_);
+        coefficientsInputVectors.push_back(1);
+        for (std::size_t jStage = 0; jStage < iStage; jStage++) {
+            inputVectorIds.push_back(auxiliaryVectorIds_[jStage]);
+            coefficientsInputVectors.push_back(
+                timeStep * ptrButcherTableau_->getA(iStage, jStage));
+        }
+
+        computeTimeDerivativeAtLocalTimeLevel(
+            level, inputVectorIds, coefficientsInputVectors,
+            auxiliaryVectorIds_[iStage], stageTime,
+            timeStep * ptrButcherTableau_->getB(iStage));
+    }
+
+    // Update the solution of this level
+    for (Base::Element *ptrElement : elementsPerLocalTimeLevel_[level]) {
+        LinearAlgebra::MiddleSizeVector &solutionCoefficients =
+            ptrElement->getTimeIntegrationVector(solutionVectorId_);
+        for (std::size_t jStage = 0; jStage < numberOfStages; jStage++) {
+            solutionCoefficients.axpy(
+                timeStep * ptrButcherTableau_->getB(jStage),
+                ptrElement->getTimeIntegrationVector(
+                    auxiliaryVectorIds_[jStage]));
+        }
+    }
+    this->synchronize(solutionVectorId_);
+
+    // Let the finer levels catch up, then correct the fluxes over the faces
+    // to the finer levels
+    if (level + 1 < getNumberOfLocalTimeLevels()) {
+        advanceLocalTimeLevel(level + 1, time, timeStep / 2);
+        advanceLocalTimeLevel(level + 1, time + timeStep / 2, timeStep / 2);
+        for (Base::Element *ptrElement : elementsPerLocalTimeLevel_[level]) {
+            LinearAlgebra::MiddleSizeVector &correction =
+                ptrElement->getTimeIntegrationVector(
+                    localTimeLevelFluxCorrectionVectorId_);
+            solveMassMatrixEquationsAtElement(ptrElement, correction);
+            ptrElement->getTimeIntegrationVector(solutionVectorId_) +=
+                correction;
+        }
+        this->synchronize(solutionVectorId_);
+    }
+}
+
+template <std::size_t DIM>
+LinearAlgebra::MiddleSizeVector
+    HpgemAPISimplified<DIM>::getStateAtLocalTimeLevel(
+        const Base::Element *ptrElement, const std::size_t level,
+        const std::vector<std::size_t> &inputVectorIds,
+        const std::vector<double> &coefficientsInputVectors,
+        const double time) {
+    const std::size_t elementLevel = ptrElement->getLocalTimeLevel();
+    if (isActiveAtLocalTimeLevel(ptrElement, level)) {
+        return getLinearCombinationOfVectors(ptrElement, inputVectorIds,
+                                             coefficientsInputVectors);
+    }
+    if (elementLevel > level) {
+        // A finer level is still at the start of the step of this level.
+        return ptrElement->getTimeIntegrationVector(solutionVectorId_);
+    }
+    // A coarser level has already completed its step.
+    const double theta = (time - localTimeLevelStartTimes_[elementLevel]) /
+                         localTimeLevelStepSizes_[elementLevel];
+    LinearAlgebra::MiddleSizeVector state(
+        ptrElement->getTimeIntegrationVector(localTimeLevelStartVectorId_));
+    state *= 1. - theta;
+    state.axpy(theta, ptrElement->getTimeIntegrationVector(solutionVectorId_));
+    return state;
+}
+
+/// \details For a face between an element on this level and a finer element,
+/// the contribution to the element on this level uses a prediction of the
+/// finer element, so it is subtracted from the flux correction of the
+/// element. For a face between an element on this level and a coarser
+/// element that is not active, the contribution that the coarser element
+/// would get is added to its flux correction.
+template <std::size_t DIM>
+void HpgemAPISimplified<DIM>::computeTimeDerivativeAtLocalTimeLevel(
+    const std::size_t level, const std::vector<std::size_t> &inputVectorIds,
+    const std::vector<double> &coefficientsInputVectors,
+    const std::size_t resultVectorId, const double time,
+    const double fluxCorrectionWeight) {
+    // Apply the right hand side corresponding to integration on the elements.
+    for (Base::Element *ptrElement : activeElementsPerLocalTimeLevel_[level]) {
+        LinearAlgebra::MiddleSizeVector inputFunctionCoefficients(
+            getLinearCombinationOfVectors(ptrElement, inputVectorIds,
+                                          coefficientsInputVectors));
+        ptrElement->getTimeIntegrationVector(resultVectorId) =
+            computeRightHandSideAtElement(ptrElement, inputFunctionCoefficients,
+                                          time);
+    }
+
+    // Add a face contribution to the flux correction of an element that this
+    // processor owns
+    auto addFluxCorrection = [&](Base::Element *ptrElement, const double weight,
+                                 const LinearAlgebra::MiddleSizeVector
+                                     &contribution) {
+        if (ptrElement->isOwnedByCurrentProcessor()) {
+            ptrElement
+                ->getTimeIntegrationVector(
+                    localTimeLevelFluxCorrectionVectorId_)
+                .axpy(weight, contribution);
+        }
+    };
+
+    // Apply the right hand side corresponding to integration on the faces,
+    // only the active sides are updated.
+    for (Base::Face *ptrFace : facesPerLocalTimeLevel_[level]) {
+        Base::Element *ptrElementLeft = ptrFace->getPtrElementLeft();
+        LinearAlgebra::MiddleSizeVector inputFunctionCoefficientsLeft(
+            getStateAtLocalTimeLevel(ptrElementLeft, level, inputVectorIds,
+                                     coefficientsInputVectors, time));
+        if (ptrFace->isInternal()) {
+            Base::Element *ptrElementRight = ptrFace->getPtrElementRight();
+            LinearAlgebra::MiddleSizeVector inputFunctionCoefficientsRight(
+                getStateAtLocalTimeLevel(ptrElementRight, level,
+                                         inputVectorIds,
+                                         coefficientsInputVectors, time));
+            const bool isLeftActive =
+                isActiveAtLocalTimeLevel(ptrElementLeft, level);
+            const bool isRightActive =
+                isActiveAtLocalTimeLevel(ptrElementRight, level);
+            const std::size_t levelLeft = ptrElementLeft->getLocalTimeLevel();
+            const std::size_t levelRight = ptrElementRight->getLocalTimeLevel();
+            // Sign of the flux correction: -1 for the predicted contribution
+            // to an element on this level, +1 for the actual contribution to
+            // an inactive coarser element, 0 otherwise
+            auto correctionSign = [&](const bool isActive,
+                                      const std::size_t ownLevel,
+                                      const std::size_t otherLevel) {
+                if (isActive && ownLevel == level && otherLevel > level) {
+                    return -1.;
+                }
+                if (!isActive && ownLevel < level && otherLevel == level) {
+                    return 1.;
+                }
+                return 0.;
+            };
+            const double signLeft =
+                correctionSign(isLeftActive, levelLeft, levelRight);
+            const double signRight =
+                correctionSign(isRightActive, levelRight, levelLeft);
+
+            if (!computeBothFaces_) {
+                if (isLeftActive || signLeft != 0) {
+                    const LinearAlgebra::MiddleSizeVector contribution =
+                        computeRightHandSideAtFace(
+                            ptrFace, Base::Side::LEFT,
+                            inputFunctionCoefficientsLeft,
+                            inputFunctionCoefficientsRight, time);
+                    if (isLeftActive) {
+                        ptrElementLeft->getTimeIntegrationVector(
+                            resultVectorId) += contribution;
+                    }
+                    if (signLeft != 0) {
+                        addFluxCorrection(ptrElementLeft,
+                                          signLeft * fluxCorrectionWeight,
+                                          contribution);
+                    }
+                }
+                if (isRightActive || signRight != 0) {
+                    const LinearAlgebra::MiddleSizeVector contribution =
+                        computeRightHandSideAtFace(
+                            ptrFace, Base::Side::RIGHT,
+                            inputFunctionCoefficientsLeft,
+                            inputFunctionCoefficientsRight, time);
+                    if (isRightActive) {
+                        ptrElementRight->getTimeIntegrationVector(
+                            resultVectorId) += contribution;
+                    }
+                    if (signRight != 0) {
+                        addFluxCorrection(ptrElementRight,
+                                          signRight * fluxCorrectionWeight,
+                                          contribution);
+                    }
+                }
+            } else {
+                std::pair<LinearAlgebra::MiddleSizeVector,
+                          LinearAlgebra::MiddleSizeVector>
+                    resultFunctionCoefficients(computeBothRightHandSidesAtFace(
+                        ptrFace, inputFunctionCoefficientsLeft,
+                        inputFunctionCoefficientsRight, time));
+                if (isLeftActive) {
+                    ptrElementLeft->getTimeIntegrationVector(resultVectorId) +=
+                        resultFunctionCoefficients.first;
+                }
+                if (isRightActive) {
+                    ptrElementRight->getTimeIntegrationVector(resultVectorId) +=
+                        resultFunctionCoefficients.second;
+                }
+                if (signLeft != 0) {
+                    addFluxCorrection(ptrElementLeft,
+                                      signLeft * fluxCorrectionWeight,
+                                      resultFunctionCoefficients.first);
+                }
+                if (signRight != 0) {
+                    addFluxCorrection(ptrElementRight,
+                                      signRight * fluxCorrectionWeight,
+                                      resultFunctionCoefficients.second);
+                }
+            }
+        } else {
+            ptrElementLeft->getTimeIntegrationVector(resultVectorId) +=
+                computeRightHandSideAtFace(
+                    ptrFace, inputFunctionCoefficientsLeft, time);
+        }
+    }
+
+    for (Base::Element *ptrElement : activeElementsPerLocalTimeLevel_[level]) {
+        solveMassMatrixEquationsAtElement(
+            ptrElement, ptrElement->getTimeIntegrationVector(resultVectorId));
+    }
+    this->synchronize(resultVectorId);
+}
+
+/// \param[in] timeIntegrationVectorId Index of the time integration vector
+/// for which the error indicators are computed.
+/// \return For every local element (by id) the square root of the integral of
+/// the squared jump of the solution over its internal faces.
+/// \details The jumps of a DG solution are of the same order as its error, so
+/// they indicate where the mesh is too coarse without knowing the exact
+/// solution.
+template <std::size_t DIM>
+std::unordered_map<std::size_t, double>
+    HpgemAPISimplified<DIM>::computeErrorIndicators(
+        const std::size_t timeIntegrationVectorId) {
+    const std::size_t numberOfUnknowns = this->configData_->numberOfUnknowns_;
+    std::unordered_map<std::size_t, double> errorIndicators;
+    for (Base::Element *ptrElement : this->meshes_[0]->getElementsList()) {
+        errorIndicators[ptrElement->getID()] = 0;
+    }
+
+    for (Base::Face *ptrFace : this->meshes_[0]->getFacesList()) {
+        if (!ptrFace->isInternal()) {
+            continue;
+        }
+        const Base::Element *ptrElementLeft = ptrFace->getPtrElementLeft();
+        const Base::Element *ptrElementRight = ptrFace->getPtrElementRight();
+        const LinearAlgebra::MiddleSizeVector &coefficientsLeft =
+            ptrElementLeft->getTimeIntegrationVector(timeIntegrationVectorId);
+        const LinearAlgebra::MiddleSizeVector &coefficientsRight =
+            ptrElementRight->getTimeIntegrationVector(timeIntegrationVectorId);
+
+        std::function<double(Base::PhysicalFace<DIM> &)> integrandFunction =
+            [&](Base::PhysicalFace<DIM> &face) -> double {
+            double squaredJump = 0;
+            for (std::size_t iV = 0; iV < numberOfUnknowns; ++iV) {
+                LinearAlgebra::MiddleSizeVector::type jump = 0;
+                for (std::size_t iB = 0;
+                     iB < ptrElementLeft->getNumberOfBasisFunctions(iV); ++iB) {
+                    jump += coefficientsLeft(
+                                ptrElementLeft->convertToSingleIndex(iB, iV)) *
+                            face.basisFunction(Side::LEFT, iB, iV);
+                }
+                for (std::size_t iB = 0;
+                     iB < ptrElementRight->getNumberOfBasisFunctions(iV);
+                     ++iB) {
+                    jump -= coefficientsRight(
+                                ptrElementRight->convertToSingleIndex(iB, iV)) *
+                            face.basisFunction(Side::RIGHT, iB, iV);
+                }
+                squaredJump += std::norm(jump);
+            }
+            return squaredJump;
+        };
+        const double faceContribution =
+            faceIntegrator_.integrate(ptrFace, integrandFunction);
+
+        // Shadow elements are not in the map and their contribution is
+        // computed by their owner.
+        if (errorIndicators.count(ptrElementLeft->getID()) > 0) {
+            errorIndicators[ptrElementLeft->getID()] += faceContribution;
+        }
+        if (errorIndicators.count(ptrElementRight->getID()) > 0) {
+            errorIndicators[ptrElementRight->getID()] += faceContribution;
+        }
+    }
+
+    for (auto &errorIndicator : errorIndicators) {
+        errorIndicator.second = std::sqrt(errorIndicator.second);
+    }
+    return errorIndicators;
+}
+
+/// \details By default every element is split in \f$ 2^d \f$ elements of the
+/// same shape, which keeps the polynomial spaces of the children nested in
+/// that of the parent.
+template <std::size_t DIM>
+const Geometry::RefinementMapping *
+    HpgemAPISimplified<DIM>::getRefinementMapping(
+        const Base::Element *ptrElement) {
+    switch (ptrElement->getReferenceGeometry()->getGeometryType()) {
+        case Geometry::ReferenceGeometryType::LINE:
+            return Geometry::RefinementMapForLine1::instance();
+        case Geometry::ReferenceGeometryType::TRIANGLE:
+            return Geometry::RefinementMapForTriangle4::instance();
+        case Geometry::ReferenceGeometryType::SQUARE:
+            return Geometry::RefinementMapForSquare3::instance();
+        case Geometry::ReferenceGeometryType::CUBE:
+            return Geometry::RefinementMapForCube7::instance();
+        default:
+            logger(ERROR, "Mesh adaptation is not implemented for a %",
+                   ptrElement->getReferenceGeometry()->getName());
+            return nullptr;
+    }
+}
+
+/// \param[in] errorIndicators Error indicator of every local element.
+/// \param[out] upperThreshold Elements with an indicator of at least this value
+/// are among the fraction with the largest indicators.
+/// \param[out] lowerThreshold Elements with an indicator of at most this value
+/// are among the fraction with the smallest indicators.
+template <std::size_t DIM>
+bool HpgemAPISimplified<DIM>::computeAdaptationThresholds(
+    const std::unordered_map<std::size_t, double> &errorIndicators,
+    double &upperThreshold, double &lowerThreshold) const {
+    std::vector<double> sortedErrorIndicators;
+    sortedErrorIndicators.reserve(errorIndicators.size());
+    for (const auto &errorIndicator : errorIndicators) {
+        sortedErrorIndicators.push_back(errorIndicator.second);
+    }
+    std::sort(sortedErrorIndicators.begin(), sortedErrorIndicators.end());
+    const std::size_t numberOfMarkedElements = static_cast<std::size_t>(
+        adaptFraction.getValue() *
+        static_cast<double>(sortedErrorIndicators.size()));
+    if (numberOfMarkedElements == 0) {
+        return false;
+    }
+    upperThreshold = sortedErrorIndicators[sortedErrorIndicators.size() -
+                                           numberOfMarkedElements];
+    lowerThreshold = sortedErrorIndicators[numberOfMarkedElements - 1];
+    return true;
+}
+
+/// \details The elements with the largest error indicators are refined and the
+/// refined elements whose children all have the smallest error indicators are
+/// coarsened, each group holds a fraction --adaptFraction of the active
+/// elements. Elements are refined at most --maxRefinementLevel times. The time
+/// integration vectors are transferred to the new elements by an L2
+/// projection, which is exact for refinement and conserves the mean of the
+/// solution for coarsening. Neighbours of refined elements may be refined as
+/// well and coarsening can be cancelled, so that face neighbours differ by at
+/// most one level of refinement.
+template <std::size_t DIM>
+void HpgemAPISimplified<DIM>::adaptMesh() {
+    std::unordered_map<std::size_t, double> errorIndicators =
+        computeErrorIndicators(solutionVectorId_);
+    double refineThreshold, coarsenThreshold;
+    if (!computeAdaptationThresholds(errorIndicators, refineThreshold,
+                                     coarsenThreshold)) {
+        return;
+    }
+    // If the indicators do not discriminate between the elements (e.g. for a
+    // constant solution) nothing is marked.
+    auto isMarkedForRefinement = [&](const Base::Element *ptrElement) {
+        auto errorIndicator = errorIndicators.find(ptrElement->getID());
+        return errorIndicator != errorIndicators.end() &&
+               errorIndicator->second >= refineThreshold &&
+               errorIndicator->second > coarsenThreshold &&
+               ptrElement->getPositionInTree()->getLevel() <
+                   maximumRefinementLevel.getValue();
+    };
+    auto isMarkedForCoarsening = [&](const Base::Element *ptrElement) {
+        auto errorIndicator = errorIndicators.find(ptrElement->getID());
+        return errorIndicator != errorIndicators.end() &&
+               errorIndicator->second <= coarsenThreshold &&
+               errorIndicator->second < refineThreshold;
+    };
+
+    // Project the solution of the children on the parents that may be
+    // coarsened, before the children are removed.
+    std::unordered_set<const Base::Element *> elementsToCoarsen;
+    for (Base::Element *ptrParent :
+         this->meshes_[0]->getElementsList(IteratorType::GLOBAL)) {
+        const auto *positionInTree = ptrParent->getPositionInTree();
+        if (positionInTree->isLeaf() ||
+            ptrParent->getRefinementMap() == nullptr) {
+            continue;
+        }
+        bool canCoarsen = true;
+        for (const auto *child : positionInTree->getChildren()) {
+            canCoarsen = canCoarsen && child->isLeaf() &&
+                         isMarkedForCoarsening(child->getData());
+        }
+        if (!canCoarsen) {
+            continue;
+        }
+        elementsToCoarsen.insert(ptrParent);
+        const Geometry::RefinementMapping *refinementMap =
+            ptrParent->getRefinementMap();
+        const Base::Element *ptrFirstChild =
+            positionInTree->getChild(0)->getData();
+        ptrParent->setNumberOfTimeIntegrationVectors(
+            ptrFirstChild->getNumberOfTimeIntegrationVectors());
+        for (std::size_t id = 0;
+             id < ptrFirstChild->getNumberOfTimeIntegrationVectors(); ++id) {
+            LinearAlgebra::MiddleSizeVector coefficients(
+                ptrParent->getTotalNumberOfBasisFunctions());
+            for (std::size_t iChild = 0;
+                 iChild < positionInTree->getNumberOfChildren(); ++iChild) {
+                const Base::Element *ptrChild =
+                    positionInTree->getChild(iChild)->getData();
+                std::function<LinearAlgebra::MiddleSizeVector(
+                    Base::PhysicalElement<DIM> &)>
+                    integrandFunction = [&](Base::PhysicalElement<DIM> &element)
+                    -> LinearAlgebra::MiddleSizeVector {
+                    const PointReferenceT pointParent =
+                        refinementMap->refinementTransform(
+                            iChild, element.getPointReference());
+                    const LinearAlgebra::MiddleSizeVector solution =
+                        ptrChild->getSolution(id, element.getPointReference());
+                    LinearAlgebra::MiddleSizeVector integrand(
+                        ptrParent->getTotalNumberOfBasisFunctions());
+                    for (std::size_t iV = 0;
+                         iV < this->configData_->numberOfUnknowns_; ++iV) {
+                        for (std::size_t iB = 0;
+                             iB < ptrParent->getNumberOfBasisFunctions(iV);
+                             ++iB) {
+                            integrand(ptrParent->convertToSingleIndex(iB, iV)) =
+                                ptrParent->basisFunction(iB, pointParent) *
+                                solution(iV);
+                        }
+                    }
+                    return integrand;
+                };
+                coefficients +=
+                    elementIntegrator_.integrate(ptrChild, integrandFunction);
+            }
+            solveMassMatrixEquationsAtElement(ptrParent, coefficients);
+            ptrParent->setTimeIntegrationVector(id, coefficients);
+        }
+    }
+    this->meshes_[0]->coarsen([&](const Base::Element *ptrElement) {
+        return elementsToCoarsen.count(ptrElement) > 0;
+    });
+
+    // Refine per type of refinement mapping, so meshes with different shapes
+    // of elements can be adapted.
+    std::unordered_set<const Base::Element *> previouslyActiveElements;
+    std::vector<const Geometry::RefinementMapping *> refinementMappings;
+    for (Base::Element *ptrElement : this->meshes_[0]->getElementsList()) {
+        previouslyActiveElements.insert(ptrElement);
+        if (isMarkedForRefinement(ptrElement)) {
+            const Geometry::RefinementMapping *refinementMapping =
+                getRefinementMapping(ptrElement);
+            if (std::find(refinementMappings.begin(), refinementMappings.end(),
+                          refinementMapping) == refinementMappings.end()) {
+                refinementMappings.push_back(refinementMapping);
+            }
+        }
+    }
+    for (const Geometry::RefinementMapping *refinementMapping :
+         refinementMappings) {
+        this->meshes_[0]->refine(
+            refinementMapping, [&](const Base::Element *ptrElement) {
+                return isMarkedForRefinement(ptrElement) &&
+                       getRefinementMapping(ptrElement) == refinementMapping;
+            });
+    }
+
+    // Project the solution of the refined elements on their children.
+    for (Base::Element *ptrChild : this->meshes_[0]->getElementsList()) {
+        const auto *positionInTree = ptrChild->getPositionInTree();
+        if (positionInTree->isRoot() ||
+            previouslyActiveElements.count(ptrChild) > 0) {
+            continue;
+        }
+        const Base::Element *ptrParent =
+            positionInTree->getParent()->getData();
+        const Geometry::RefinementMapping *refinementMap =
+            ptrParent->getRefinementMap();
+        const std::size_t iChild = positionInTree->getSiblingIndex();
+        ptrChild->setNumberOfTimeIntegrationVectors(
+            ptrParent->getNumberOfTimeIntegrationVectors());
+        for (std::size_t id = 0;
+             id < ptrParent->getNumberOfTimeIntegrationVectors(); ++id) {
+            std::function<LinearAlgebra::MiddleSizeVector(
+                Base::PhysicalElement<DIM> &)>
+                integrandFunction = [&](Base::PhysicalElement<DIM> &element)
+                -> LinearAlgebra::MiddleSizeVector {
+                const LinearAlgebra::MiddleSizeVector solution =
+                    ptrParent->getSolution(
+                        id, refinementMap->refinementTransform(
+                                iChild, element.getPointReference()));
+                LinearAlgebra::MiddleSizeVector &integrand =
+                    element.getResultVector();
+                for (std::size_t iV = 0;
+                     iV < this->configData_->numberOfUnknowns_; ++iV) {
+                    for (std::size_t iB = 0;
+                         iB < element.getNumberOfBasisFunctions(); ++iB) {
+                        integrand(element.convertToSingleIndex(iB, iV)) =
+                            element.basisFunction(iB) * solution(iV);
+                    }
+                }
+                return integrand;
+            };
+            LinearAlgebra::MiddleSizeVector coefficients =
+                elementIntegrator_.integrate(ptrChild, integrandFunction);
+            solveMassMatrixEquationsAtElement(ptrChild, coefficients);
+            ptrChild->setTimeIntegrationVector(id, coefficients);
+        }
+    }
+    logger(INFO, "Adapted the mesh, it now has % elements.",
+           this->meshes_[0]->getNumberOfElements());
+}
+
+/// \details The elements with the largest error indicators get one polynomial
+/// order more, up to --maxPolynomialOrder, and those with the smallest error
+/// indicators one order less, down to --minPolynomialOrder. Each group holds a
+/// fraction --adaptFraction of the elements of a processor. The owner of an
+/// element decides on its order and sends it to the shadow copies. The time
+/// integration vectors are transferred to the new basis functions by an L2
+/// projection, which is exact when the order is raised and conserves the mean
+/// of the solution when it is lowered.
+template <std::size_t DIM>
+void HpgemAPISimplified<DIM>::adaptPolynomialOrders() {
+    std::unordered_map<std::size_t, double> errorIndicators =
+        computeErrorIndicators(solutionVectorId_);
+    double raiseThreshold = std::numeric_limits<double>::infinity();
+    double lowerThreshold = -std::numeric_limits<double>::infinity();
+    computeAdaptationThresholds(errorIndicators, raiseThreshold,
+                                lowerThreshold);
+
+    // New polynomial order of every element, including the shadow elements.
+    // If the indicators do not discriminate between the elements (e.g. for a
+    // constant solution) the orders are kept.
+    std::unordered_map<std::size_t, std::size_t> newPolynomialOrders;
+    for (Base::Element *ptrElement :
+         this->meshes_[0]->getElementsList(IteratorType::GLOBAL)) {
+        std::size_t polynomialOrder = ptrElement->getPolynomialOrder();
+        auto errorIndicator = errorIndicators.find(ptrElement->getID());
+        if (errorIndicator != errorIndicators.end()) {
+            if (errorIndicator->second >= raiseThreshold &&
+                errorIndicator->second > lowerThreshold &&
+                polynomialOrder < maximumPolynomialOrder.getValue()) {
+                ++polynomialOrder;
+            } else if (errorIndicator->second <= lowerThreshold &&
+                       errorIndicator->second < raiseThreshold &&
+                       polynomialOrder > minimumPolynomialOrder.getValue()) {
+                --polynomialOrder;
+            }
+        }
+        newPolynomialOrders[ptrElement->getID()] = polynomialOrder;
+    }
+#ifdef HPGEM_USE_MPI
+    Base::Submesh &submesh = this->meshes_[0]->getMesh().getSubmesh();
+    for (const auto &pull : submesh.getPullElements()) {
+        for (Base::Element *ptrElement : pull.second) {
+            Base::MPIContainer::Instance().receive(
+                newPolynomialOrders[ptrElement->getID()], pull.first,
+                ptrElement->getID());
+        }
+    }
+    for (const auto &push : submesh.getPushElements()) {
+        for (Base::Element *ptrElement : push.second) {
+            Base::MPIContainer::Instance().send(
+                newPolynomialOrders[ptrElement->getID()], push.first,
+                ptrElement->getID());
+        }
+    }
+    Base::MPIContainer::Instance().sync();
+#endif
+
+    std::size_t numberOfChangedElements = 0;
+    for (Base::Element *ptrElement :
+         this->meshes_[0]->getElementsList(IteratorType::GLOBAL)) {
+        const std::size_t oldPolynomialOrder = ptrElement->getPolynomialOrder();
+        const std::size_t newPolynomialOrder =
+            newPolynomialOrders[ptrElement->getID()];
+        if (newPolynomialOrder == oldPolynomialOrder) {
+            continue;
+        }
+        if (ptrElement->isOwnedByCurrentProcessor()) {
+            ++numberOfChangedElements;
+        }
+        // Keep the old basis functions and coefficients to evaluate the old
+        // solution.
+        std::unique_ptr<Base::Element> ptrOldElement(
+            ptrElement->copyWithoutFacesEdgesNodes());
+        this->meshes_[0]->setDefaultDGPolynomialOrder(ptrElement,
+                                                      newPolynomialOrder);
+        // Exact for the product of the old and new basis functions
+        QuadratureRules::GaussQuadratureRule *quadratureRule =
+            ptrElement->getReferenceGeometry()->getGaussQuadratureRule(
+                oldPolynomialOrder + newPolynomialOrder + 1);
+        for (std::size_t id = 0;
+             id < ptrElement->getNumberOfTimeIntegrationVectors(); ++id) {
+            std::function<LinearAlgebra::MiddleSizeVector(
+                Base::PhysicalElement<DIM> &)>
+                integrandFunction = [&](Base::PhysicalElement<DIM> &element)
+                -> LinearAlgebra::MiddleSizeVector {
+                const LinearAlgebra::MiddleSizeVector solution =
+                    ptrOldElement->getSolution(id, element.getPointReference());
+                LinearAlgebra::MiddleSizeVector &integrand =
+                    element.getResultVector();
+                for (std::size_t iV = 0;
+                     iV < this->configData_->numberOfUnknowns_; ++iV) {
+                    for (std::size_t iB = 0;
+                         iB < element.getNumberOfBasisFunctions(); ++iB) {
+                        integrand(element.convertToSingleIndex(iB, iV)) =
+                            element.basisFunction(iB) * solution(iV);
+                    }
+                }
+                return integrand;
+            };
+            LinearAlgebra::MiddleSizeVector coefficients =
+                elementIntegrator_.integrate(ptrElement, integrandFunction,
+                                             quadratureRule);
+            solveMassMatrixEquationsAtElement(ptrElement, coefficients);
+            ptrElement->setTimeIntegrationVector(id, coefficients);
+        }
+    }
+    logger(INFO, "Changed the polynomial order of % elements.",
+           numberOfChangedElements);
+}
+
+/// \details By default the cost is the number of basis functions times the
+/// number of quadrature points on the element and its faces, which is
+/// proportional to the work of an explicit right-hand side evaluation. With
+/// local time stepping an element on level \f$ l \f$ takes \f$ 2^l \f$ steps
+/// per coarse time step, so its cost is multiplied accordingly.
+template <std::size_t DIM>
+double HpgemAPISimplified<DIM>::computeElementCost(
+    const Base::Element *ptrElement) {
+    std::size_t numberOfQuadraturePoints =
+        ptrElement->getGaussQuadratureRule()->getNumberOfPoints();
+    for (const Base::Face *ptrFace : ptrElement->getFacesList()) {
+        numberOfQuadraturePoints +=
+            ptrFace->getGaussQuadratureRule()->getNumberOfPoints();
+    }
+    double cost = static_cast<double>(
+        ptrElement->getTotalNumberOfBasisFunctions() * numberOfQuadraturePoints);
+    if (getNumberOfLocalTimeLevels() > 0) {
+        cost *=
+            std::ldexp(1., static_cast<int>(ptrElement->getLocalTimeLevel()));
+    }
+    return cost;
+}
+
+/// \details The load of a processor is the sum of computeElementCost over the
+/// elements it owns. When the largest load exceeds the average load by more
+/// than the factor --imbalanceTolerance the elements are cut into pieces of
+/// equal cost along a space filling curve through their centres. Only the
+/// load of each processor is exchanged to detect the imbalance, and the cuts
+/// are found without collecting the elements on one processor. The elements
+/// are then moved to their new owners together with their basis functions
+/// and data, see MeshManipulator::redistribute. Redistributing a refined mesh
+/// is not supported, but on a single processor there is nothing to balance.
+template <std::size_t DIM>
+bool HpgemAPISimplified<DIM>::rebalance() {
+    Base::MeshManipulator<DIM> &mesh = *this->meshes_[0];
+    auto &communicator = MPIContainer::Instance();
+    const std::size_t numberOfProcessors =
+        communicator.getNumberOfProcessors();
+    if (numberOfProcessors == 1) {
+        return false;
+    }
+
+    std::vector<double> costs;
+    std::vector<LinearAlgebra::SmallVector<DIM>> centers;
+    double load = 0;
+    for (Base::Element *ptrElement : mesh.getElementsList()) {
+        costs.push_back(computeElementCost(ptrElement));
+        load += costs.back();
+        const PointReferenceT &centerReference =
+            ptrElement->getReferenceGeometry()->getCenter();
+        const PointPhysicalT center =
+            ptrElement->referenceToPhysical(centerReference);
+        centers.push_back(center.getCoordinates());
+    }
+    double maximumLoad = load;
+    double totalLoad = load;
+#ifdef HPGEM_USE_MPI
+    communicator.reduce(maximumLoad, MPI_MAX);
+    communicator.broadcast(maximumLoad);
+    communicator.reduce(totalLoad, MPI_SUM);
+    communicator.broadcast(totalLoad);
+#endif
+    const double imbalance =
+        totalLoad > 0 ? maximumLoad * static_cast<double>(numberOfProcessors) /
+                            totalLoad
+                      : 1.;
+    if (imbalance <= imbalanceTolerance.getValue()) {
+        logger(VERBOSE, "Load imbalance % is within the tolerance", imbalance);
+        return false;
+    }
+
+    mesh.redistribute(Utilities::partitionAlongSpaceFillingCurveInParallel(
+        centers, costs, numberOfProcessors));
+    if (reorderMesh.getValue()) {
+        mesh.sortAlongSpaceFillingCurve();
+    }
+    logger(INFO, "Redistributed the mesh to reduce the load imbalance from %",
+           imbalance);
+    return true;
+}
+
 /// \param[in] outputFileName Name of the output file (minus extensions like
 /// .dat). \param[in] internalFileTitle Title of the file as used by Tecplot
 /// internally. \param[in] solutionTitle Title of the solution. \param[in]
@@ -908,6 +1930,15 @@ bool HpgemAPISimplified<DIM>::checkBeforeSolving() {
                "Error no mesh created : You need to create at least one mesh "
                "to solve a problem");
     }
+    // The refinement tree of the elements cannot be moved to other
+    // processors, so a refined mesh cannot be redistributed.
+    if (numberOfStepsBetweenAdaptations.getValue() > 0 &&
+        numberOfStepsBetweenRebalancing.getValue() > 0) {
+        logger(ERROR,
+               "Mesh adaptation (--adaptEvery) cannot be combined with load "
+               "rebalancing (--rebalanceEvery): redistributing a refined mesh "
+               "is not supported yet.");
+    }
     return true;
 }
 
@@ -989,11 +2020,20 @@ bool HpgemAPISimplified<DIM>::solve(const double initialTime,
     }
     double maximumRelativeError = error.getValue();
 
+    bool useLocalTimeStepping = numberOfLocalTimeLevels.getValue() > 1;
+    if (useLocalTimeStepping && error.isUsed()) {
+        logger(WARN,
+               "Local time stepping cannot be combined with an adaptive time "
+               "step, all elements will use the same time step.");
+        useLocalTimeStepping = false;
+    }
+
     // Set the initial time.
     double time = initialTime;
 
     // Create and Store things before solving the problem.
     tasksBeforeSolving();
+    checkScaledIdentityMassMatrices();
 
     // Set the initial numerical solution.
     logger(INFO, "Computing and interpolating the initial solution.");
@@ -1001,6 +2041,12 @@ bool HpgemAPISimplified<DIM>::solve(const double initialTime,
     tecplotWriter.write(this->meshes_[0], solutionTitle_, false, this, time);
     VTKWrite(VTKWriter, time, solutionVectorId_);
 
+    // With local time stepping dt is the time step of the finest level.
+    double localTimeStep = dt;
+    if (useLocalTimeStepping) {
+        localTimeStep = computeLocalTimeLevels(dt);
+    }
+
     // Solve the system of PDE's.
     logger(INFO, "Solving the system of PDE's.");
     logger(INFO, "Maximum time step: %.", dt);
@@ -1017,10 +2063,48 @@ bool HpgemAPISimplified<DIM>::solve(const double initialTime,
             computeOneTimeStep(
                 time, maximumRelativeError,
                 std::min(std::min(dt, outputTime - time), finalTime - time));
+        } else if (useLocalTimeStepping) {
+            computeOneLocalTimeStep(
+                time, std::min(std::min(localTimeStep, outputTime - time),
+                               finalTime - time));
         } else {
             computeOneTimeStep(time, dt);
         }
 
+        if (numberOfStepsBetweenAdaptations.getValue() > 0 &&
+            actualNumberOfTimeSteps %
+                    numberOfStepsBetweenAdaptations.getValue() ==
+                0) {
+            adaptMesh();
+            tasksAfterMeshChange();
+            if (useLocalTimeStepping) {
+                localTimeStep = computeLocalTimeLevels(dt);
+            }
+        }
+
+        if (numberOfStepsBetweenPAdaptations.getValue() > 0 &&
+            actualNumberOfTimeSteps %
+                    numberOfStepsBetweenPAdaptations.getValue() ==
+                0) {
+            adaptPolynomialOrders();
+            tasksAfterMeshChange();
+            if (useLocalTimeStepping) {
+                localTimeStep = computeLocalTimeLevels(dt);
+            }
+        }
+
+        if (numberOfStepsBetweenRebalancing.getValue() > 0 &&
+            actualNumberOfTimeSteps %
+                    numberOfStepsBetweenRebalancing.getValue() ==
+                0) {
+            if (rebalance()) {
+                tasksAfterMeshChange();
+                if (useLocalTimeStepping) {
+                    localTimeStep = computeLocalTimeLevels(dt);
+                }
+            }
+        }
+
         if (time > outputTime - 1e-12) {
             outputTime += outputDt;
             tecplotWriter.write(this->meshes_[0], solutionTitle_, false, this,
@@ -38,7 +38,9 @@
 //
 #ifndef HPGEM_KERNEL_LEVELTREE_H
 #define HPGEM_KERNEL_LEVELTREE_H
+#include <algorithm>
 #include <deque>
+#include <utility>
 #include <vector>
 #include <iostream>
 #include "Logger.h"
@@ -176,11 +178,17 @@ class LevelTree {
     TreeIterator<V> beginPostOrder();
 
     //! Erase all descendants of an entry (and reset its depth to 1)
-    void eraseChilds(TreeIterator<V> parentEl);
+    void eraseChilds(TreeIteratorConst<V> parentEl);
 
     //! Erase all entries (including descendants)
     void clear();
 
+    //! Reorder the root entries (and with them their descendants), such that
+    //! entries with a smaller key come first. Entries with equal keys keep
+    //! their relative order.
+    template <typename KeyFunction>
+    void sortRootEntries(KeyFunction key);
+
     //! Describe the LevelTree
     friend std::ostream& operator<<(std::ostream& os, const LevelTree<V>& e) {
         os << "LevelTree: ";
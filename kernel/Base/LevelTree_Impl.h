@@ -326,7 +326,7 @@ TreeIterator<V> LevelTree<V>::beginPostOrder() {
 
 //! Erase all descendants of an entry
 template <typename V>
-void LevelTree<V>::eraseChilds(TreeIterator<V> parent) {
+void LevelTree<V>::eraseChilds(TreeIteratorConst<V> parent) {
     (*parent.ptr_)->removeChildren();
     TreeIterator<V> testIterator =
         entries_.front()->getIterator(TreeTraversalMethod::ALLLEVEL);
@@ -347,6 +347,26 @@ void Base::LevelTree<V>::clear() {
     maxLevel_ = 0;
 }
 
+template <typename V>
+template <typename KeyFunction>
+void Base::LevelTree<V>::sortRootEntries(KeyFunction key) {
+    using KeyType = decltype(key(std::declval<const V&>()));
+    std::vector<std::pair<KeyType, TreeEntry<V>*>> keyedEntries;
+    keyedEntries.reserve(entries_.size());
+    for (TreeEntry<V>* entry : entries_) {
+        keyedEntries.emplace_back(key(entry->getData()), entry);
+    }
+    std::stable_sort(keyedEntries.begin(), keyedEntries.end(),
+                     [](const std::pair<KeyType, TreeEntry<V>*>& a,
+                        const std::pair<KeyType, TreeEntry<V>*>& b) {
+                         return a.first < b.first;
+                     });
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        entries_[i] = keyedEntries[i].second;
+        entries_[i]->setSiblings(i, &entries_);
+    }
+}
+
 }  // namespace Base
 
 }  // namespace hpgem
@@ -80,23 +80,63 @@ class Mesh final {
     Element* addElement(const std::vector<std::size_t>& globalNodeIndexes,
                         std::size_t owner, bool owning);
 
+    /// Add an element with a given id instead of a new one, for example for
+    /// an element that moved here from another processor. The same holds for
+    /// the overloads of addFace, addEdge and addNode that take an id.
+    Element* addElement(const std::vector<std::size_t>& globalNodeIndexes,
+                        std::size_t owner, bool owning, std::size_t id);
+
     void addSubElements(Base::Element* parent,
                         const std::vector<Base::Element*> subElements);
 
+    /// Delete the children of a refined element and disconnect them from
+    /// their nodes. The children may not be refined themselves.
+    void removeSubElements(Base::Element* parent);
+
     bool addFace(
         Element* leftElementPtr, std::size_t leftElementLocalFaceNo,
         Element* rightElementPtr, std::size_t rightElementLocalFaceNo,
         const Geometry::FaceType& faceType = Geometry::FaceType::WALL_BC);
 
+    bool addFace(Element* leftElementPtr, std::size_t leftElementLocalFaceNo,
+                 Element* rightElementPtr,
+                 std::size_t rightElementLocalFaceNo,
+                 const Geometry::FaceType& faceType, std::size_t id);
+
+    /// Add an internal face that only covers part of the face of the coarser
+    /// right element, see Face.
+    bool addNonconformingFace(
+        Element* leftElementPtr, std::size_t leftElementLocalFaceNo,
+        Element* rightElementPtr, std::size_t rightElementLocalFaceNo,
+        const Geometry::MappingReferenceToReference<1>* nonconformingMapR);
+
     void addSubFaces(const Base::Face* parent,
                      const std::vector<Base::Face*> subFaces);
 
     Edge* addEdge();
 
+    Edge* addEdge(std::size_t id);
+
+    /// Delete all faces and edges and empty the submesh, so they can be
+    /// constructed again when the active elements have changed.
+    void resetActiveMesh();
+
+    /// Sort the lists of elements, faces, edges and nodes such that entities
+    /// that are close in space are also close in the lists. The elements are
+    /// sorted along a Morton curve through their centres, the other entities
+    /// follow the first element they are adjacent to. Only the order of the
+    /// lists changes: the entities are not moved in memory and all IDs stay
+    /// the same. Since GlobalIndexing numbers the unknowns in the order of the
+    /// element list, this moves most couplings between neighbouring elements
+    /// closer to the diagonal of the global matrices.
+    void sortAlongSpaceFillingCurve();
+
     void addNodeCoordinate(Geometry::PointPhysical<DIM> node);
 
     Node* addNode();
 
+    Node* addNode(std::size_t id);
+
     void clear();
 
     std::size_t getNumberOfElements(
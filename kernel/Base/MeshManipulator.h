@@ -39,8 +39,10 @@
 #ifndef HPGEM_KERNEL_MESHMANIPULATOR_H
 #define HPGEM_KERNEL_MESHMANIPULATOR_H
 
+#include <array>
 #include <vector>
 #include <fstream>
+#include <map>
 
 #include "Geometry/FaceGeometry.h"
 #include "PhysicalElement.h"
@@ -127,6 +129,31 @@ class MeshManipulator : public MeshManipulatorBase {
     void useDefaultDGBasisFunctions(std::size_t order);
     void useDefaultDGBasisFunctions(std::size_t order, std::size_t unknown);
 
+    /// \brief Use the default DG basis functions of the given order for all
+    /// unknowns of a single element, so the polynomial order can differ between
+    /// elements.
+    /// \details The basis function sets are shared by all elements of the same
+    /// shape and order. The quadrature rules of the element and its faces are
+    /// chosen again for the new order, a face uses the rule of the element with
+    /// the highest order. The expansion coefficients are resized but not
+    /// transferred to the new basis functions. Indices into global matrices and
+    /// vectors (GlobalIndexing) have to be computed again afterwards. When
+    /// running in parallel the shadow element on the neighbouring processors
+    /// must get the same order.
+    void setDefaultDGPolynomialOrder(Element* element, std::size_t order);
+
+    /// \brief Use orthonormal modal DG basis functions of the given order on
+    /// all elements.
+    /// \details Lines, squares, triangles, cubes and tetrahedra get the
+    /// orthonormal basis functions from Utilities/BasisFunctionsOrthonormal.h,
+    /// so the mass matrix of an element with an affine mapping is a multiple
+    /// of the identity; prisms and pyramids keep the default DG basis
+    /// functions. This choice is remembered: later calls to
+    /// useDefaultDGBasisFunctions and setDefaultDGPolynomialOrder (e.g. after
+    /// mesh refinement or redistribution) also create orthonormal basis
+    /// functions.
+    void useOrthonormalDGBasisFunctions(std::size_t order);
+
     /// \brief automatically creates Nedelec DG basis functions for tetrahedra.
     /// \details This function should be called after a mesh has been created to
     /// ensure basis functions exist for all types of elements needed.
@@ -282,10 +309,90 @@ class MeshManipulator : public MeshManipulatorBase {
     //  *****************Iteration through the Elements*******************
 
     /**
-     * load a mesh that was generated and partitioned by the preprocessor
+     * load a mesh that was generated by the preprocessor. When the mesh was
+     * partitioned for the current number of processors, that partitioning is
+     * used. Otherwise (for example when the preprocessor was run without -n)
+     * the mesh is partitioned while it is read: every processor reads a
+     * separate part of the file, the elements are cut into pieces of equal
+     * size along a space filling curve through their centres, and the
+     * processors send each other the elements they need. No processor reads
+     * or stores the whole mesh.
      */
     void readMesh(const std::string& filename);
 
+    /**
+     * load a mesh that was generated by the preprocessor, but distribute the
+     * elements as given by elementPartitions instead of using the partitioning
+     * in the file. elementPartitions[i] is the processor that owns the i-th
+     * element of the file. The shadow elements and the processors that need a
+     * node, face or edge are derived from this in the same way as in the
+     * preprocessor.
+     */
+    void readMesh(const std::string& filename,
+                  const std::vector<std::size_t>& elementPartitions);
+
+    /**
+     * move the elements to other processors. newOwners[i] is the processor
+     * that will own the i-th element of getElementsList(), and all processors
+     * must call this function. The elements are sent to their new owner and
+     * to the processors that need them as shadow elements, together with the
+     * ids of their nodes, faces and edges, their (curved) geometry, their
+     * basis functions and their element data, so no mesh file is needed and
+     * the mesh looks the same as before, except for the distribution. Face
+     * data, user data and the extra pull requests of the submesh are not
+     * moved, and the mesh may not be refined. Every GlobalIndexing of this
+     * mesh has to be reset afterwards.
+     */
+    void redistribute(const std::vector<std::size_t>& newOwners);
+
+    /**
+     * generate a structured mesh of the box between bottomLeft and topRight
+     * directly in memory, without going through the preprocessor. The mesh is
+     * the same as the one the preprocessor makes from a structured input file:
+     * the nodes, the splitting of the cubes in triangles (2 per square) or
+     * tetrahedra (5 per cube), the numbering of the elements and the periodic
+     * boundaries match. The processors are laid out as a grid of blocks of
+     * elements, and each processor only generates its own block and the
+     * layer of shadow elements around it, so no processor ever needs the
+     * global mesh. The ids of the elements and nodes follow from their
+     * position in the grid. The faces and edges are numbered by the processor
+     * that owns the cube they are in. All ids are the same on all processors,
+     * and there are no unused ids in between, like in a mesh file.
+     */
+    void createStructuredMesh(
+        const Geometry::PointPhysical<DIM>& bottomLeft,
+        const Geometry::PointPhysical<DIM>& topRight,
+        const std::array<std::size_t, DIM>& numberOfElements, bool triangular,
+        const std::array<bool, DIM>& periodic = {});
+
+    /**
+     * sort the lists of elements, faces, edges and nodes along a space
+     * filling curve, so loops over the mesh visit neighbouring entities one
+     * after another and the global matrices are closer to banded. The IDs
+     * do not change (see Mesh::sortAlongSpaceFillingCurve)
+     */
+    void sortAlongSpaceFillingCurve() { theMesh_.sortAlongSpaceFillingCurve(); }
+
+    //! name of the file this mesh was read from
+    const std::string& getMeshFileName() const { return meshFileName_; }
+
+    //! number of elements in the file this mesh was read from, for a
+    //! generated structured mesh the number of elements the preprocessor would
+    //! have written
+    std::size_t getNumberOfElementsInFile() const {
+        return numberOfElementsInFile_;
+    }
+
+    //! position of an element of the unrefined mesh in the file this mesh was
+    //! read from (or would have been read from, for a generated structured
+    //! mesh). This is the same on all processors.
+    std::size_t getElementIndexInFile(const Element* element) const {
+        logger.assert_debug(element->getPositionInTree()->isRoot(),
+                            "Only the elements of the unrefined mesh appear in "
+                            "the mesh file");
+        return element->getID() - firstElementID_;
+    }
+
 #ifdef HPGEM_USE_QHULL
     /**
      * \brief create an unstructured triangular mesh
@@ -349,6 +456,8 @@ class MeshManipulator : public MeshManipulatorBase {
      * spring system. This is currently done using a relatively crude
      * implementation. Once there is a proper coupling between mercury and
      * hpGEM, some thought should be given to the improvement of this algorithm
+     * The largest node movement and the worst element quality are logged at
+     * VERBOSE level every iteration, a summary is logged at INFO level.
      * @param domainDescription A function that maps PointPhysicals to doubles,
      * such that negative numbers signify points inside the mesh
      * @param fixedPointIdxs pointIndexes of point that MUST remain in the same
@@ -528,15 +637,20 @@ class MeshManipulator : public MeshManipulatorBase {
         std::tuple<const Base::Element*, Geometry::PointReference<DIM>>>&
         getMeasurePoints();
 
-    ///\brief placeholder refinement driver
-    ///\details checks all elements on the current active level against the
-    /// provided binary predicate. If it returns true it will refine the element
-    /// according to the provided mapping. Note that the predicate should at
-    /// least return false for elements that are already refined and for
-    /// elements that have the wrong shape. Note also that you can do multiple
-    /// passes on the same level if you want different refinement mappings for
-    /// different elements. if you just want to refine every element on the
-    /// level, you can omit the final argument. If the relative sizes of the
+    ///\brief refine the active elements of the mesh
+    ///\details checks all active elements (the leaves of the refinement tree)
+    /// against the provided binary predicate. If it returns true it will
+    /// refine the element according to the provided mapping. Note that the
+    /// predicate should at least return false for elements that have the wrong
+    /// shape. Note also that you can do multiple passes if you want different
+    /// refinement mappings for different elements. if you just want to refine
+    /// every active element, you can omit the final argument. A face may
+    /// connect an element to part of the face of a neighbour that is one level
+    /// coarser (one hanging node per face), so a neighbour is only refined as
+    /// well if it is coarser than a selected element and the mapping
+    /// introduces new nodes on their shared face. The children use the
+    /// basis functions of their parent if they have the same shape, transfer
+    /// of the element data is up to the caller. If the relative sizes of the
     /// refined elements don't suit your needs, use the mesh mover to relocate
     /// the nodes Note that doing so might render the coarse mesh useless, due
     /// to it using the old (incorrect) mapping
@@ -545,8 +659,113 @@ class MeshManipulator : public MeshManipulatorBase {
     void refine(const Geometry::RefinementMapping* refinementMapping,
                 std::function<bool(const Element*)> shouldRefine = nullptr);
 
+    ///\brief undo the refinement of elements
+    ///\details checks all refined elements whose children are active against
+    /// the provided binary predicate. If it returns true the children are
+    /// deleted and the element becomes active again. An element is not
+    /// coarsened if a face neighbour of one of its children is finer than that
+    /// child and is not coarsened itself, so neighbours still differ by at most
+    /// one level of refinement. Transfer of the element data of the children
+    /// to their parent is up to the caller and should happen before calling
+    /// this function.
+    void coarsen(std::function<bool(const Element*)> shouldCoarsen);
+
+    ///\brief give the elements at a curved boundary a curved geometry
+    ///\details replaces the linear mapping of the elements that touch a
+    /// boundary face selected by isCurvedBoundary (by default the faces of type
+    /// WALL_BC and OPEN_BC) with a MappingToPhysLagrange of the given order.
+    /// The geometry nodes of these elements that lie on a selected face (also
+    /// those on an edge or vertex of a selected face, for elements that only
+    /// touch it there) are moved by projectToBoundary, which should map a
+    /// point near the boundary to the closest point on the exact boundary. The
+    /// other geometry nodes stay at their straight sided positions. This also
+    /// handles the shadow elements, so it should be called on all processors.
+    /// The quadrature rules are not changed; curved elements usually need a
+    /// somewhat higher quadrature order. Children of later refinements get
+    /// linear mappings again.
+    void curveBoundaryElements(
+        std::size_t geometryOrder,
+        std::function<Geometry::PointPhysical<DIM>(
+            const Geometry::PointPhysical<DIM>&)>
+            projectToBoundary,
+        std::function<bool(const Face*)> isCurvedBoundary = nullptr);
+
     //---------------------------------------------------------------------
    private:
+    //! The leaves of the refinement tree, in pre-order
+    std::vector<Element*> getActiveElements();
+
+    //! Internal faces of shadow elements become subdomain boundaries
+    void setSubdomainBoundaryFaceTypes();
+
+    //! Everything that is needed to construct an element of the unrefined
+    //! mesh on some processor, without knowing the rest of the mesh. See
+    //! redistribute.
+    struct ElementRecord {
+        std::size_t id;
+        std::size_t owner;
+        std::vector<std::size_t> shadowPartitions;
+        std::vector<std::size_t> nodeIDs;
+        std::vector<Geometry::PointPhysical<DIM>> nodeCoordinates;
+        std::vector<std::size_t> faceIDs;
+        //! whether the face is between two elements, and if so whether this
+        //! element is on its left side
+        std::vector<bool> isInternalFace;
+        std::vector<bool> isLeftOfFace;
+        //! the type of the faces on the boundary of the domain
+        std::vector<Geometry::FaceType> faceTypes;
+        std::vector<std::size_t> edgeIDs;
+        //! the order and geometry nodes of a curved element, the order is 0
+        //! for an element with straight sides
+        std::size_t geometryOrder = 0;
+        std::vector<Geometry::PointPhysical<DIM>> geometryNodes;
+        //! per unknown: the order of the default DG basis functions, or the
+        //! position in the collection of basis functions of some other set
+        bool hasBasisFunctions = false;
+        std::vector<bool> isDefaultDGBasis;
+        std::vector<std::size_t> basisFunctionSets;
+        std::size_t localTimeLevel = 0;
+        std::size_t coarsestNeighbourLocalTimeLevel = 0;
+        std::vector<LinearAlgebra::MiddleSizeVector> timeLevelData;
+        std::vector<LinearAlgebra::MiddleSizeVector> timeIntegrationVectors;
+        std::vector<LinearAlgebra::MiddleSizeMatrix> elementMatrices;
+        std::vector<LinearAlgebra::MiddleSizeVector> elementVectors;
+
+        //! append this record to a message
+        void pack(std::vector<std::size_t>& integers,
+                  std::vector<double>& reals) const;
+
+        //! read a record from a message, starting at the given positions,
+        //! which are moved to the next record
+        void unpack(const std::vector<std::size_t>& integers,
+                    std::size_t& integerPosition,
+                    const std::vector<double>& reals,
+                    std::size_t& realPosition);
+    };
+
+    //! The record of an element of this mesh, optionally with its basis
+    //! functions and data
+    ElementRecord makeElementRecord(const Element* element, std::size_t owner,
+                                    std::vector<std::size_t> shadowPartitions,
+                                    bool withData) const;
+
+    //! Construct the elements, nodes, faces and edges of the records, which
+    //! must contain all elements that this processor owns or pulls. Faces
+    //! and edges are shared by the elements that have the same id for them.
+    void createMeshFromElementRecords(std::vector<ElementRecord> records);
+
+    //! Read a mesh file that is not partitioned for the current number of
+    //! processors, see readMesh. The input must be at the first node.
+    void readMeshInParallel(std::ifstream& input, std::size_t numberOfNodes,
+                            std::size_t numberOfElements,
+                            std::size_t numberOfFaces,
+                            std::size_t numberOfEdges);
+
+    //! Position in collBasisFSet_ of the default DG basis functions for a shape
+    //! and order, the set is created when it is not there yet
+    std::size_t getDefaultDGBasisFunctionSetPosition(
+        Geometry::ReferenceGeometryType shape, std::size_t order);
+
     //! Construct the faces based on connectivity information about elements and
     //! nodes
     void faceFactory();
@@ -555,6 +774,19 @@ class MeshManipulator : public MeshManipulatorBase {
     //! nodes
     void edgeFactory();
 
+    //! Construct the faces between refined elements and their coarser
+    //! neighbours, which only cover part of the face of the coarse element.
+    //! Must be called before faceFactory.
+    void nonconformingFaceFactory();
+
+    //! Reconstruct the faces, edges and the local part of the mesh for the
+    //! leaves of the refinement tree. Boundary faces get the face type stored
+    //! for (element, local face number), or keep the type of the face they
+    //! had before.
+    void updateActiveMesh(
+        std::map<std::pair<const Element*, std::size_t>, Geometry::FaceType>
+            boundaryFaceTypes);
+
     // iterable should provide a begin() and an end() that return a
     // TreeEntry<Element*>
     // but concepts don't exist yet (will probably have to become an
@@ -573,6 +805,17 @@ class MeshManipulator : public MeshManipulatorBase {
     //! Collection of additional basis function set, if p-refinement is applied
     CollectionOfBasisFunctionSets collBasisFSet_;
 
+    //! default DG basis function sets by shape and order, the position in
+    //! collBasisFSet_ is looked up again because the collection may have been
+    //! cleared in the meantime
+    std::map<std::pair<Geometry::ReferenceGeometryType, std::size_t>,
+             std::shared_ptr<const BasisFunctionSet>>
+        defaultDGBasisFunctionSets_;
+
+    //! whether the default DG basis functions are the orthonormal ones, see
+    //! useOrthonormalDGBasisFunctions
+    bool orthonormalDGBasisFunctions_ = false;
+
     // when the mesh is updated, persistently store original node coordinates to
     // see if retriangulation is in order
     std::vector<Geometry::PointPhysical<DIM>> oldNodeLocations_;
@@ -580,6 +823,20 @@ class MeshManipulator : public MeshManipulatorBase {
     std::vector<std::tuple<const Base::Element*, Geometry::PointReference<DIM>>>
         measurePoints_;
 
+    //! all locations passed to addMeasurePoint, also those on other
+    //! processors, so the measure points survive redistribution
+    std::vector<Geometry::PointPhysical<DIM>> measurePointLocations_;
+
+    //! file this mesh was read from, empty if the mesh was generated
+    std::string meshFileName_;
+
+    //! number of elements in the mesh file, on all processors
+    std::size_t numberOfElementsInFile_ = 0;
+
+    //! id of the first element in the mesh file, elements (and reserved ids of
+    //! elements on other processors) are numbered consecutively from here
+    std::size_t firstElementID_ = 0;
+
     /// \brief Parse a double (possibly white space prefixed) from an input
     /// stream.
     ///
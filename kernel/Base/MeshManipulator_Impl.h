@@ -54,6 +54,7 @@
 #include "Geometry/PhysicalGeometry.h"
 #include "Geometry/ReferenceTriangle.h"
 #include "Edge.h"
+#include "EntityConnectivity.h"
 #include "Base/BasisFunctionSet.h"
 #include "ConfigurationData.h"
 #include "Element.h"
@@ -66,6 +67,7 @@
 #include "Geometry/PointReference.h"
 #include "BaseBasisFunction.h"
 #include "Geometry/Mappings/MappingReferenceToPhysical.h"
+#include "Geometry/Mappings/NonconformingFaceMapping.h"
 #include "ElementFactory.h"
 #include "FaceFactory.h"
 #include "L2Norm.h"
@@ -82,17 +84,28 @@
 #include "Utilities/BasisFunctions3DNedelec.h"
 #include "Utilities/BasisFunctions3DAinsworthCoyle.h"
 #include "Utilities/BasisFunctionsMonomials.h"
+#include "Utilities/BasisFunctionsOrthonormal.h"
+#include "Utilities/SpaceFillingCurvePartitioner.h"
 #include "Logger.h"
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <set>
 #include <array>
 #include <vector>
 #include <numeric>
+#include <sstream>
 #include <type_traits>
 #include <typeinfo>
+#include <unordered_map>
+#include <complex>
 
 //(crude) fix for pre-c++14 limitations of std::hash: just use the std::hash of
 // the underlying type
@@ -144,83 +157,9 @@ void MeshManipulator<DIM>::useMonomialBasisFunctions(std::size_t order) {
 template <std::size_t DIM>
 void MeshManipulator<DIM>::useDefaultDGBasisFunctions(std::size_t order) {
     collBasisFSet_.clear();
-    std::unordered_map<Geometry::ReferenceGeometryType, std::size_t,
-                       EnumHash<Geometry::ReferenceGeometryType>>
-        shapeToIndex;
     for (Element *element : getElementsList(IteratorType::GLOBAL)) {
-        try {
-            element->setDefaultBasisFunctionSet(shapeToIndex.at(
-                element->getReferenceGeometry()->getGeometryType()));
-        } catch (std::out_of_range &) {
-            switch (element->getReferenceGeometry()->getGeometryType()) {
-                case Geometry::ReferenceGeometryType::LINE:
-                    shapeToIndex[Geometry::ReferenceGeometryType::LINE] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet1DH1Line(order));
-                    break;
-                case Geometry::ReferenceGeometryType::SQUARE:
-                    shapeToIndex[Geometry::ReferenceGeometryType::SQUARE] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet2DH1Square(order));
-                    break;
-                case Geometry::ReferenceGeometryType::TRIANGLE:
-                    shapeToIndex[Geometry::ReferenceGeometryType::TRIANGLE] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet2DH1Triangle(order));
-                    break;
-                case Geometry::ReferenceGeometryType::CUBE:
-                    shapeToIndex[Geometry::ReferenceGeometryType::CUBE] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet3DH1Cube(order));
-                    break;
-                case Geometry::ReferenceGeometryType::TETRAHEDRON:
-                    shapeToIndex[Geometry::ReferenceGeometryType::TETRAHEDRON] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet3DH1Tetrahedron(
-                            order));
-                    break;
-                case Geometry::ReferenceGeometryType::TRIANGULARPRISM:
-                    shapeToIndex
-                        [Geometry::ReferenceGeometryType::TRIANGULARPRISM] =
-                            collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet3DH1ConformingPrism(
-                            order));
-                    break;
-                case Geometry::ReferenceGeometryType::PYRAMID:
-                    shapeToIndex[Geometry::ReferenceGeometryType::PYRAMID] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::
-                            createDGBasisFunctionSet3DH1ConformingPyramid(
-                                order));
-                    break;
-                case Geometry::ReferenceGeometryType::HYPERCUBE:
-                    logger(ERROR,
-                           "No well-conditioned basis functions have been "
-                           "implemented for %s",
-                           element->getReferenceGeometry()->getName());
-                    break;
-                case Geometry::ReferenceGeometryType::POINT:
-                    logger(ERROR,
-                           "A point is not a valid geometry for an Element!");
-                    break;
-                default:
-                    logger(
-                        ERROR,
-                        "A new geometry has been implemented, please add it to "
-                        "the cases in "
-                        "MeshManipulator::useDefaultDGBasisFunctions and "
-                        "MeshManipulator::useDefaultConformingBasisFunctions");
-            }
-            element->setDefaultBasisFunctionSet(shapeToIndex.at(
-                element->getReferenceGeometry()->getGeometryType()));
-        }
+        element->setDefaultBasisFunctionSet(getDefaultDGBasisFunctionSetPosition(
+            element->getReferenceGeometry()->getGeometryType(), order));
     }
 }
 
@@ -233,88 +172,120 @@ void MeshManipulator<DIM>::useDefaultDGBasisFunctions(std::size_t order,
         "useDefaultDGBasisFunctions(std::size_t unknown) will not clear "
         "collBasisFSet_ of the default basis functions. Use "
         "useDefaultBasisFunctions() instead for the zeroth unknown.");
-    std::unordered_map<Geometry::ReferenceGeometryType, std::size_t,
-                       EnumHash<Geometry::ReferenceGeometryType>>
-        shapeToIndex;
     for (Element *element : getElementsList(IteratorType::GLOBAL)) {
-        try {
-            element->setDefaultBasisFunctionSet(
-                shapeToIndex.at(
-                    element->getReferenceGeometry()->getGeometryType()),
-                unknown);
-        } catch (std::out_of_range &) {
-            switch (element->getReferenceGeometry()->getGeometryType()) {
-                case Geometry::ReferenceGeometryType::LINE:
-                    shapeToIndex[Geometry::ReferenceGeometryType::LINE] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet1DH1Line(order));
-                    break;
-                case Geometry::ReferenceGeometryType::SQUARE:
-                    shapeToIndex[Geometry::ReferenceGeometryType::SQUARE] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet2DH1Square(order));
-                    break;
-                case Geometry::ReferenceGeometryType::TRIANGLE:
-                    shapeToIndex[Geometry::ReferenceGeometryType::TRIANGLE] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet2DH1Triangle(order));
-                    break;
-                case Geometry::ReferenceGeometryType::CUBE:
-                    shapeToIndex[Geometry::ReferenceGeometryType::CUBE] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet3DH1Cube(order));
-                    break;
-                case Geometry::ReferenceGeometryType::TETRAHEDRON:
-                    shapeToIndex[Geometry::ReferenceGeometryType::TETRAHEDRON] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet3DH1Tetrahedron(
-                            order));
-                    break;
-                case Geometry::ReferenceGeometryType::TRIANGULARPRISM:
-                    shapeToIndex
-                        [Geometry::ReferenceGeometryType::TRIANGULARPRISM] =
-                            collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::createDGBasisFunctionSet3DH1ConformingPrism(
-                            order));
-                    break;
-                case Geometry::ReferenceGeometryType::PYRAMID:
-                    shapeToIndex[Geometry::ReferenceGeometryType::PYRAMID] =
-                        collBasisFSet_.size();
-                    collBasisFSet_.emplace_back(
-                        Utilities::
-                            createDGBasisFunctionSet3DH1ConformingPyramid(
-                                order));
-                    break;
-                case Geometry::ReferenceGeometryType::HYPERCUBE:
-                    logger(ERROR,
-                           "No well-conditioned basis functions have been "
-                           "implemented for %s",
-                           element->getReferenceGeometry()->getName());
-                    break;
-                case Geometry::ReferenceGeometryType::POINT:
-                    logger(ERROR,
-                           "A point is not a valid geometry for an Element!");
-                    break;
-                default:
-                    logger(
-                        ERROR,
-                        "A new geometry has been implemented, please add it to "
-                        "the cases in "
-                        "MeshManipulator::useDefaultDGBasisFunctions and "
-                        "MeshManipulator::useDefaultConformingBasisFunctions");
-            }
-            element->setDefaultBasisFunctionSet(
-                shapeToIndex.at(
-                    element->getReferenceGeometry()->getGeometryType()),
-                unknown);
+        element->setDefaultBasisFunctionSet(
+            getDefaultDGBasisFunctionSetPosition(
+                element->getReferenceGeometry()->getGeometryType(), order),
+            unknown);
+    }
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::setDefaultDGPolynomialOrder(Element *element,
+                                                       std::size_t order) {
+    element->setDefaultBasisFunctionSet(getDefaultDGBasisFunctionSetPosition(
+        element->getReferenceGeometry()->getGeometryType(), order));
+    element->resetQuadratureRules();
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::useOrthonormalDGBasisFunctions(std::size_t order) {
+    if (!orthonormalDGBasisFunctions_) {
+        // the cached sets belong to the other family of basis functions
+        defaultDGBasisFunctionSets_.clear();
+        orthonormalDGBasisFunctions_ = true;
+    }
+    useDefaultDGBasisFunctions(order);
+}
+
+template <std::size_t DIM>
+std::size_t MeshManipulator<DIM>::getDefaultDGBasisFunctionSetPosition(
+    Geometry::ReferenceGeometryType shape, std::size_t order) {
+    std::shared_ptr<const BasisFunctionSet> &set =
+        defaultDGBasisFunctionSets_[{shape, order}];
+    if (set != nullptr) {
+        auto position =
+            std::find(collBasisFSet_.begin(), collBasisFSet_.end(), set);
+        if (position != collBasisFSet_.end()) {
+            return position - collBasisFSet_.begin();
         }
     }
+    if (orthonormalDGBasisFunctions_) {
+        set.reset();
+        switch (shape) {
+            case Geometry::ReferenceGeometryType::LINE:
+                set.reset(
+                    Utilities::createOrthonormalBasisFunctionSet1DLine(order));
+                break;
+            case Geometry::ReferenceGeometryType::SQUARE:
+                set.reset(Utilities::createOrthonormalBasisFunctionSet2DSquare(
+                    order));
+                break;
+            case Geometry::ReferenceGeometryType::TRIANGLE:
+                set.reset(
+                    Utilities::createOrthonormalBasisFunctionSet2DTriangle(
+                        order));
+                break;
+            case Geometry::ReferenceGeometryType::CUBE:
+                set.reset(
+                    Utilities::createOrthonormalBasisFunctionSet3DCube(order));
+                break;
+            case Geometry::ReferenceGeometryType::TETRAHEDRON:
+                set.reset(
+                    Utilities::createOrthonormalBasisFunctionSet3DTetrahedron(
+                        order));
+                break;
+            default:
+                // no orthonormal basis functions, use the default ones below
+                break;
+        }
+        if (set != nullptr) {
+            collBasisFSet_.push_back(set);
+            return collBasisFSet_.size() - 1;
+        }
+    }
+    switch (shape) {
+        case Geometry::ReferenceGeometryType::LINE:
+            set.reset(Utilities::createDGBasisFunctionSet1DH1Line(order));
+            break;
+        case Geometry::ReferenceGeometryType::SQUARE:
+            set.reset(Utilities::createDGBasisFunctionSet2DH1Square(order));
+            break;
+        case Geometry::ReferenceGeometryType::TRIANGLE:
+            set.reset(Utilities::createDGBasisFunctionSet2DH1Triangle(order));
+            break;
+        case Geometry::ReferenceGeometryType::CUBE:
+            set.reset(Utilities::createDGBasisFunctionSet3DH1Cube(order));
+            break;
+        case Geometry::ReferenceGeometryType::TETRAHEDRON:
+            set.reset(
+                Utilities::createDGBasisFunctionSet3DH1Tetrahedron(order));
+            break;
+        case Geometry::ReferenceGeometryType::TRIANGULARPRISM:
+            set.reset(
+                Utilities::createDGBasisFunctionSet3DH1ConformingPrism(order));
+            break;
+        case Geometry::ReferenceGeometryType::PYRAMID:
+            set.reset(Utilities::createDGBasisFunctionSet3DH1ConformingPyramid(
+                order));
+            break;
+        case Geometry::ReferenceGeometryType::HYPERCUBE:
+            logger(ERROR,
+                   "No well-conditioned basis functions have been "
+                   "implemented for hypercubes");
+            break;
+        case Geometry::ReferenceGeometryType::POINT:
+            logger(ERROR, "A point is not a valid geometry for an Element!");
+            break;
+        default:
+            logger(ERROR,
+                   "A new geometry has been implemented, please add it to "
+                   "the cases in "
+                   "MeshManipulator::getDefaultDGBasisFunctionSetPosition and "
+                   "MeshManipulator::useDefaultConformingBasisFunctions");
+    }
+    collBasisFSet_.push_back(set);
+    return collBasisFSet_.size() - 1;
 }
 
 template <std::size_t DIM>
@@ -1051,7 +1022,8 @@ MeshManipulator<DIM>::MeshManipulator(const MeshManipulator &other)
     : MeshManipulatorBase(other),
       theMesh_(other.theMesh_),
       meshMover_(other.meshMover_),
-      collBasisFSet_(other.collBasisFSet_) {}
+      collBasisFSet_(other.collBasisFSet_),
+      orthonormalDGBasisFunctions_(other.orthonormalDGBasisFunctions_) {}
 
 template <std::size_t DIM>
 MeshManipulator<DIM>::~MeshManipulator() {
@@ -1271,6 +1243,7 @@ std::tuple<const Base::Element *, Geometry::PointReference<DIM>>
 template <std::size_t DIM>
 void MeshManipulator<DIM>::addMeasurePoint(
     Geometry::PointPhysical<DIM> pointPhysical) {
+    measurePointLocations_.push_back(pointPhysical);
     try {
         // bypass the API since it spawns an error, and the pointPhysical is
         // probably on another subdomain anyway
@@ -1334,9 +1307,67 @@ void MeshManipulator<DIM>::refine(
     FaceFactory::instance().setNumberOfFaceMatrices(numberOfFaceMatrices_);
     FaceFactory::instance().setNumberOfFaceVectors(numberOfFaceVectors_);
 
-    // do the refinement
+    // select the elements to refine, including the coarser neighbours, which
+    // would otherwise be two levels coarser than the new children. Neighbours
+    // on the same level get a hanging node on their shared face.
+    std::unordered_set<const Element *> elementsToRefine;
+    std::vector<const Element *> unprocessedElements;
     for (Base::Element *element : getElementsList()) {
         if (shouldRefine(element)) {
+            elementsToRefine.insert(element);
+            unprocessedElements.push_back(element);
+        }
+    }
+    std::size_t numberOfSelectedElements = elementsToRefine.size();
+    while (!unprocessedElements.empty()) {
+        const Element *element = unprocessedElements.back();
+        unprocessedElements.pop_back();
+        for (std::size_t i = 0; i < element->getNumberOfFaces(); ++i) {
+            const Face *face = element->getFace(i);
+            if (face->isInternal() &&
+                refinementMapping->getCodim1RefinementMaps()[i]
+                        ->getNumberOfNewNodes() > 0) {
+                const Element *other = face->getPtrElementLeft();
+                if (other == element) {
+                    other = face->getPtrElementRight();
+                }
+                if (other->getPositionInTree()->getLevel() <
+                        element->getPositionInTree()->getLevel() &&
+                    elementsToRefine.insert(other).second) {
+                    logger.assert_always(
+                        other->getReferenceGeometry() ==
+                            refinementMapping
+                                ->getBigElementReferenceGeometry(),
+                        "Element % has to be refined to prevent two hanging "
+                        "nodes on a face, but it is not a %",
+                        other->getID(),
+                        refinementMapping->getBigElementReferenceGeometry()
+                            ->getName());
+                    unprocessedElements.push_back(other);
+                }
+            }
+        }
+    }
+    logger(VERBOSE,
+           "Refining % elements, % of them to keep neighbours within one level",
+           elementsToRefine.size(),
+           elementsToRefine.size() - numberOfSelectedElements);
+
+    // the vertices of the faces that cover part of the face of a coarse element
+    // become nodes of its children, so they are reused when it is refined
+    std::map<std::pair<const Element *, std::size_t>, std::vector<Face *>>
+        nonconformingFaces;
+    for (Face *face : getFacesList(IteratorType::GLOBAL)) {
+        if (face->isNonconforming()) {
+            nonconformingFaces[std::make_pair(face->getPtrElementRight(),
+                                              face->localFaceNumberRight())]
+                .push_back(face);
+        }
+    }
+
+    // do the refinement
+    for (Base::Element *element : getElementsList()) {
+        if (elementsToRefine.count(element) > 0) {
             logger.assert_debug(
                 element->getRefinementMap() == nullptr,
                 "Element was already refined, refine the children instead");
@@ -1368,7 +1399,8 @@ void MeshManipulator<DIM>::refine(
                 const Face *face = element->getFace(i);
                 // if the face was already refined in the other element and it
                 // is also refined in this element
-                if (face->getPositionInTree()->hasChild() &&
+                if (!face->isNonconforming() &&
+                    face->getPositionInTree()->hasChild() &&
                     refinementMapping->getCodim1RefinementMaps()[i]
                             ->getNumberOfNewNodes() > 0) {
                     auto elementIndices =
@@ -1413,6 +1445,60 @@ void MeshManipulator<DIM>::refine(
             }
 
             std::size_t offset = element->getNumberOfNodes();
+            for (std::size_t i = 0; i < element->getNumberOfFaces(); ++i) {
+                auto finerFaces =
+                    nonconformingFaces.find(std::make_pair(element, i));
+                if (finerFaces == nonconformingFaces.end()) {
+                    continue;
+                }
+                for (Face *face : finerFaces->second) {
+                    Element *finer = face->getPtrElementLeft();
+                    for (std::size_t k = 0;
+                         k < face->getReferenceGeometry()->getNumberOfNodes();
+                         ++k) {
+                        std::size_t localNode =
+                            finer->getReferenceGeometry()
+                                ->getLocalNodeIndexFromFaceAndIndexOnFace(
+                                    face->localFaceNumberLeft(), k);
+                        Geometry::PointReference<DIM> position =
+                            face->mapRefFaceToRefElemR(
+                                static_cast<
+                                    const Geometry::PointReference<DIM - 1> &>(
+                                    face->getReferenceGeometry()
+                                        ->getReferenceNodeCoordinate(k)));
+                        for (std::size_t j = 0;
+                             j < refinementMapping->getNumberOfNewNodes();
+                             ++j) {
+                            if (newNodes[j + offset] != nullptr ||
+                                (position.getCoordinates() -
+                                 newReferenceNodes[j].getCoordinates())
+                                        .l2Norm() > 1e-10) {
+                                continue;
+                            }
+                            newNodes[j + offset] = finer->getNode(localNode);
+                            globalPointIndices[j + offset] =
+                                finer->getPhysicalGeometry()->getNodeIndex(
+                                    localNode);
+                            // across a periodic boundary the node has other
+                            // coordinates on this side
+                            Geometry::PointPhysical<DIM> nodeCoordinate =
+                                element->referenceToPhysical(
+                                    newReferenceNodes[j]);
+                            if ((nodeCoordinate.getCoordinates() -
+                                 theMesh_
+                                     .getNodeCoordinates()[globalPointIndices
+                                                               [j + offset]]
+                                     .getCoordinates())
+                                    .l2Norm() > 1e-10) {
+                                globalPointIndices[j + offset] =
+                                    theMesh_.getNumberOfNodeCoordinates();
+                                theMesh_.addNodeCoordinate(nodeCoordinate);
+                            }
+                        }
+                    }
+                }
+            }
+
             // generate new data
             for (std::size_t i = 0;
                  i < refinementMapping->getNumberOfNewNodes(); ++i) {
@@ -1444,6 +1530,10 @@ void MeshManipulator<DIM>::refine(
                     subElementNodeIndices, theMesh_.getNodeCoordinates(),
                     element->getOwner(), element->isOwnedByCurrentProcessor());
                 subElements.push_back(newElement);
+                if (refinementMapping->getSubElementReferenceGeometry(i) ==
+                    element->getReferenceGeometry()) {
+                    newElement->copyBasisFunctionSets(*element);
+                }
                 for (std::size_t j = 0;
                      j < refinementMapping->getSubElementReferenceGeometry(i)
                              ->getNumberOfNodes();
@@ -1454,10 +1544,15 @@ void MeshManipulator<DIM>::refine(
                 }
             }
             theMesh_.addSubElements(element, subElements);
+            element->setRefinementMap(refinementMapping);
 
-            // connect sub-faces
+            // connect sub-faces, the faces to a coarser or finer neighbour
+            // are constructed again by updateActiveMesh
             for (std::size_t i = 0; i < element->getNumberOfFaces(); ++i) {
                 const Face *face = element->getFace(i);
+                if (face->isNonconforming()) {
+                    continue;
+                }
                 if (face->getPositionInTree()->hasChild()) {
                     auto childIterator =
                         ++face->getPositionInTree()->getIterator(
@@ -1504,8 +1599,7 @@ void MeshManipulator<DIM>::refine(
             }
         }
     }
-    faceFactory();
-    edgeFactory();
+    updateActiveMesh({});
 
     // move the measurepoints down the tree
     for (auto &pair : measurePoints_) {
@@ -1519,117 +1613,872 @@ void MeshManipulator<DIM>::refine(
 }
 
 template <std::size_t DIM>
-void MeshManipulator<DIM>::readMesh(const std::string &filename) {
-    // set to correct value in case some other meshManipulator changed things
-    ElementFactory::instance().setCollectionOfBasisFunctionSets(
-        &collBasisFSet_);
-    ElementFactory::instance().setNumberOfMatrices(numberOfElementMatrices_);
-    ElementFactory::instance().setNumberOfVectors(numberOfElementVectors_);
-    ElementFactory::instance().setNumberOfTimeLevels(
-        configData_->numberOfTimeLevels_);
-    ElementFactory::instance().setNumberOfUnknowns(
-        configData_->numberOfUnknowns_);
-    FaceFactory::instance().setNumberOfFaceMatrices(numberOfFaceMatrices_);
-    FaceFactory::instance().setNumberOfFaceVectors(numberOfFaceVectors_);
-    getElementsList().setSingleLevelTraversal(0);
-    logger.suppressWarnings([this]() {
-        getElementsList(IteratorType::GLOBAL).setSingleLevelTraversal(0);
-    });
-
-    using namespace std::string_literals;
-    std::ifstream input;
-    input.open(filename.c_str());
-    logger.assert_always(input.is_open(), "Cannot open input file: %",
-                         filename);
-    logger.assert_always(input.good(),
-                         "Something is not so good about this mesh");
-    std::string rawInput;
-    std::getline(input, rawInput);
-    logger.assert_always(
-        rawInput.substr(0, 4) == "mesh",
-        "incorrect file type, please use the preprocessor first");
-    logger.assert_always(
-        rawInput == "mesh 1"s,
-        "This file is too new to be read by the current version of hpGEM");
-    std::size_t numberOfNodes, numberOfElements, meshDimension;
-    input >> numberOfNodes >> numberOfElements >> meshDimension;
-    logger.assert_always(meshDimension == DIM,
-                         "The mesh in this input file has the wrong dimension "
-                         "(read %, but expected %)",
-                         meshDimension, DIM);
-    std::size_t numberOfFaces = 0;
-    std::size_t numberOfEdges = 0;
-    if (DIM > 1) input >> numberOfFaces;
-    if (DIM > 2) input >> numberOfEdges;
-    std::size_t numberOfPartitions, localNumberOfNodes;
-    input >> numberOfPartitions;
-    logger.assert_debug(MPIContainer::Instance().getProcessorID() >= 0,
-                        "We got assigned processor ID % by MPI (expected >=0)",
-                        MPIContainer::Instance().getProcessorID());
-    std::size_t processorID = MPIContainer::Instance().getProcessorID();
-    for (std::size_t i = 0; i < processorID + 1; ++i) {
-        input >> localNumberOfNodes;
+void MeshManipulator<DIM>::coarsen(
+    std::function<bool(const Element *)> shouldCoarsen) {
+    // select the refined elements that have only active children
+    std::unordered_set<const Element *> elementsToCoarsen;
+    std::vector<Element *> candidates;
+    getElementsList(IteratorType::GLOBAL).setPreOrderTraversal();
+    for (Element *element : theMesh_.getElementsList(IteratorType::GLOBAL)) {
+        const TreeEntry<Element *> *position = element->getPositionInTree();
+        if (position->isLeaf()) {
+            continue;
+        }
+        bool hasOnlyActiveChildren = true;
+        for (const TreeEntry<Element *> *child : position->getChildren()) {
+            hasOnlyActiveChildren &= child->isLeaf();
+        }
+        if (hasOnlyActiveChildren && element->getRefinementMap() != nullptr &&
+            shouldCoarsen(element)) {
+            elementsToCoarsen.insert(element);
+            candidates.push_back(element);
+        }
     }
-    input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    logger.assert_debug(MPIContainer::Instance().getNumberOfProcessors() >= 0,
-                        "MPI thinks we are running only on % processors",
-                        MPIContainer::Instance().getNumberOfProcessors());
-    logger.assert_always(
-        numberOfPartitions ==
-            static_cast<std::size_t>(
-                MPIContainer::Instance().getNumberOfProcessors()),
-        "This mesh is targeting % parallel threads, but you are running on % "
-        "threads, please rerun the preprocessor first",
-        numberOfPartitions, MPIContainer::Instance().getNumberOfProcessors());
-
-    std::size_t processedNodes = 0;
-    std::map<std::size_t, std::size_t> localNodeIndex;
-    std::map<std::size_t, std::size_t> startOfCoordinates;
 
-    // we need some leeway later on to synchronize face indices with node
-    // indices later on
-    if (DIM == 1) GlobalUniqueIndex::instance().getNodeIndex();
+    // a neighbour that is finer than a child has to be coarsened as well,
+    // otherwise it would end up two levels finer than the coarsened element
+    auto hasFinerNeighbour = [&](const Element *element) {
+        const Geometry::RefinementMapping *refinementMap =
+            element->getRefinementMap();
+        for (std::size_t i = 0; i < element->getNumberOfFaces(); ++i) {
+            for (std::size_t j = 0;
+                 j < refinementMap->getCodim1RefinementMaps()[i]
+                         ->getNumberOfSubElements();
+                 ++j) {
+                std::size_t elementIndex, faceIndex;
+                std::tie(elementIndex, faceIndex) =
+                    refinementMap->getSubElementAndLocalFaceIndex(i, j);
+                const Element *child = element->getPositionInTree()
+                                           ->getChild(elementIndex)
+                                           ->getData();
+                const Face *face = child->getFace(faceIndex);
+                // the finer neighbours are on the left of the faces that cover
+                // the face of the child, and all of them have the same parent
+                if (!face->isNonconforming() ||
+                    face->getPtrElementRight() != child) {
+                    continue;
+                }
+                const Element *other = face->getPtrElementLeft();
+                if (elementsToCoarsen.count(
+                        other->getPositionInTree()->getParent()->getData()) ==
+                    0) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+    bool hasChanged = true;
+    while (hasChanged) {
+        hasChanged = false;
+        for (Element *element : candidates) {
+            if (elementsToCoarsen.count(element) > 0 &&
+                hasFinerNeighbour(element)) {
+                elementsToCoarsen.erase(element);
+                hasChanged = true;
+            }
+        }
+    }
 
-    for (std::size_t i = 0; i < numberOfNodes; ++i) {
-        std::size_t nodePartitions;
+    // remember the boundary conditions of the children, and move the measure
+    // points up the tree before the children are deleted
+    std::map<std::pair<const Element *, std::size_t>, Geometry::FaceType>
+        boundaryFaceTypes;
+    for (Element *element : candidates) {
+        if (elementsToCoarsen.count(element) == 0) {
+            continue;
+        }
+        for (std::size_t i = 0; i < element->getNumberOfFaces(); ++i) {
+            std::size_t elementIndex, faceIndex;
+            std::tie(elementIndex, faceIndex) =
+                element->getRefinementMap()->getSubElementAndLocalFaceIndex(i,
+                                                                            0);
+            const Face *face = element->getPositionInTree()
+                                   ->getChild(elementIndex)
+                                   ->getData()
+                                   ->getFace(faceIndex);
+            if (!face->isInternal()) {
+                boundaryFaceTypes[std::make_pair(element, i)] =
+                    face->getFaceType();
+            }
+        }
+    }
+    for (auto &pair : measurePoints_) {
+        const Base::Element *element = std::get<0>(pair);
+        if (!element->getPositionInTree()->isRoot()) {
+            const Base::Element *parent =
+                element->getPositionInTree()->getParent()->getData();
+            if (elementsToCoarsen.count(parent) > 0) {
+                Geometry::PointPhysical<DIM> point =
+                    element->referenceToPhysical(std::get<1>(pair));
+                pair = std::make_tuple(parent,
+                                       parent->physicalToReference(point));
+            }
+        }
+    }
+    for (Element *element : candidates) {
+        if (elementsToCoarsen.count(element) > 0) {
+            theMesh_.removeSubElements(element);
+        }
+    }
+    logger(VERBOSE, "Coarsened % of % candidate elements",
+           elementsToCoarsen.size(), candidates.size());
+
+    updateActiveMesh(boundaryFaceTypes);
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::curveBoundaryElements(
+    std::size_t geometryOrder,
+    std::function<Geometry::PointPhysical<DIM>(
+        const Geometry::PointPhysical<DIM> &)>
+        projectToBoundary,
+    std::function<bool(const Face *)> isCurvedBoundary) {
+    if (!isCurvedBoundary) {
+        isCurvedBoundary = [](const Face *face) {
+            return face->getFaceType() == Geometry::FaceType::WALL_BC ||
+                   face->getFaceType() == Geometry::FaceType::OPEN_BC;
+        };
+    }
+    // The (sorted) coordinate indices of the vertices of each curved face
+    std::vector<std::vector<std::size_t>> curvedFaces;
+    std::unordered_map<std::size_t, std::vector<std::size_t>> facesOfVertex;
+    for (Face *face : getFacesList(IteratorType::GLOBAL)) {
+        if (face->isInternal() || !isCurvedBoundary(face)) continue;
+        std::vector<std::size_t> vertices =
+            face->getPtrElementLeft()
+                ->getPhysicalGeometry()
+                ->getGlobalFaceNodeIndices(face->localFaceNumberLeft());
+        std::sort(vertices.begin(), vertices.end());
+        for (std::size_t vertex : vertices) {
+            facesOfVertex[vertex].push_back(curvedFaces.size());
+        }
+        curvedFaces.push_back(std::move(vertices));
+    }
+
+    std::size_t numberOfCurvedElements = 0;
+    for (Element *element : getElementsList(IteratorType::GLOBAL)) {
+        const Geometry::PhysicalGeometryBase *physicalGeometry =
+            element->getPhysicalGeometry();
+        bool touchesCurvedFace = false;
+        for (std::size_t i = 0; i < physicalGeometry->getNumberOfNodes(); ++i) {
+            touchesCurvedFace =
+                touchesCurvedFace ||
+                facesOfVertex.count(physicalGeometry->getNodeIndex(i)) > 0;
+        }
+        if (!touchesCurvedFace) continue;
+        auto mapping = new Geometry::MappingToPhysLagrange<DIM>(
+            static_cast<const Geometry::PhysicalGeometry<DIM> *>(
+                physicalGeometry),
+            geometryOrder);
+        bool isCurved = false;
+        for (std::size_t i = 0; i < mapping->getNumberOfGeometryNodes(); ++i) {
+            // the geometry node is on a curved face if the smallest entity of
+            // the element that contains it is part of that face
+            std::vector<std::size_t> vertices =
+                mapping->getGeometryNodeVertices(i);
+            for (std::size_t &vertex : vertices) {
+                vertex = physicalGeometry->getNodeIndex(vertex);
+            }
+            std::sort(vertices.begin(), vertices.end());
+            auto candidates = facesOfVertex.find(vertices[0]);
+            if (candidates == facesOfVertex.end()) continue;
+            for (std::size_t candidate : candidates->second) {
+                const std::vector<std::size_t> &faceVertices =
+                    curvedFaces[candidate];
+                if (std::includes(faceVertices.begin(), faceVertices.end(),
+                                  vertices.begin(), vertices.end())) {
+                    mapping->setGeometryNode(
+                        i, projectToBoundary(mapping->getGeometryNode(i)));
+                    isCurved = true;
+                    break;
+                }
+            }
+        }
+        if (isCurved) {
+            element->setReferenceToPhysicalMap(mapping);
+            ++numberOfCurvedElements;
+        } else {
+            delete mapping;
+        }
+    }
+    logger(VERBOSE, "Curved the geometry of % elements", numberOfCurvedElements);
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::updateActiveMesh(
+    std::map<std::pair<const Element *, std::size_t>, Geometry::FaceType>
+        boundaryFaceTypes) {
+    logger.assert_always(
+        getPullElements().empty() && getPushElements().empty(),
+        "Changing the refinement of a distributed mesh is not supported yet");
+    FaceFactory::instance().setNumberOfFaceMatrices(numberOfFaceMatrices_);
+    FaceFactory::instance().setNumberOfFaceVectors(numberOfFaceVectors_);
+
+    LevelTree<Element *> &elements = getElementsList(IteratorType::GLOBAL);
+    elements.setPreOrderTraversal();
+    // faces that are not inside a refined element keep their type
+    for (Element *element : elements) {
+        if (element->getPositionInTree()->isLeaf()) {
+            for (std::size_t i = 0; i < element->getNumberOfFaces(); ++i) {
+                const Face *face = element->getFace(i);
+                if (face != nullptr && !face->isInternal() &&
+                    face->getFaceType() !=
+                        Geometry::FaceType::REFINEMENT_BOUNDARY) {
+                    boundaryFaceTypes.emplace(std::make_pair(element, i),
+                                              face->getFaceType());
+                }
+            }
+        }
+    }
+
+    theMesh_.resetActiveMesh();
+    // nodes that only connected deleted elements are no longer needed
+    std::vector<Node *> &nodes = getNodesList(IteratorType::GLOBAL);
+    std::size_t numberOfActiveNodes = 0;
+    for (Node *node : nodes) {
+        if (node->getNumberOfElements() > 0) {
+            nodes[numberOfActiveNodes++] = node;
+        } else {
+            delete node;
+        }
+    }
+    nodes.resize(numberOfActiveNodes);
+    for (Node *node : nodes) {
+        theMesh_.getSubmesh().add(node);
+    }
+    for (Element *element : elements) {
+        if (element->getPositionInTree()->isLeaf()) {
+            theMesh_.getSubmesh().add(element);
+        }
+    }
+    nonconformingFaceFactory();
+    faceFactory();
+    edgeFactory();
+
+    for (Face *face : getFacesList(IteratorType::GLOBAL)) {
+        if (!face->isInternal()) {
+            auto faceType = boundaryFaceTypes.find(std::make_pair(
+                face->getPtrElementLeft(), face->localFaceNumberLeft()));
+            logger.assert_always(
+                faceType != boundaryFaceTypes.end(),
+                "Face % of element % is a new boundary face, the mesh has a "
+                "hanging node",
+                face->localFaceNumberLeft(),
+                face->getPtrElementLeft()->getID());
+            face->setFaceType(faceType->second);
+        }
+    }
+    logger(VERBOSE, "Number of active elements: %",
+           getElementsList().size());
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::readMesh(const std::string &filename) {
+    std::ifstream input;
+    input.open(filename.c_str());
+    logger.assert_always(input.is_open(), "Cannot open input file: %",
+                         filename);
+    std::string rawInput;
+    std::getline(input, rawInput);
+    logger.assert_always(
+        rawInput == "mesh 1",
+        "incorrect file type, please use the preprocessor first");
+    std::size_t numberOfNodes, numberOfElements, meshDimension;
+    input >> numberOfNodes >> numberOfElements >> meshDimension;
+    logger.assert_always(meshDimension == DIM,
+                         "The mesh in this input file has the wrong dimension "
+                         "(read %, but expected %)",
+                         meshDimension, DIM);
+    std::size_t numberOfFaces = 0;
+    std::size_t numberOfEdges = 0;
+    std::size_t numberOfPartitions;
+    if (DIM > 1) input >> numberOfFaces;
+    if (DIM > 2) input >> numberOfEdges;
+    input >> numberOfPartitions;
+    input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    const std::size_t numberOfProcessors =
+        MPIContainer::Instance().getNumberOfProcessors();
+    if (numberOfPartitions == numberOfProcessors) {
+        input.close();
+        readMesh(filename, {});
+    } else if (numberOfProcessors == 1) {
+        input.close();
+        readMesh(filename, std::vector<std::size_t>(numberOfElements, 0));
+    } else {
+        logger(INFO,
+               "This mesh is partitioned for % processors, partitioning it "
+               "for % processors while reading it",
+               numberOfPartitions, numberOfProcessors);
+        readMeshInParallel(input, numberOfNodes, numberOfElements,
+                           numberOfFaces, numberOfEdges);
+        meshFileName_ = filename;
+    }
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::readMeshInParallel(std::ifstream &input,
+                                              std::size_t numberOfNodes,
+                                              std::size_t numberOfElements,
+                                              std::size_t numberOfFaces,
+                                              std::size_t numberOfEdges) {
+    auto &communicator = MPIContainer::Instance();
+    const std::size_t numberOfProcessors =
+        communicator.getNumberOfProcessors();
+    const std::size_t processorID = communicator.getProcessorID();
+
+    // After the header there are two lines for each node (its partitions and
+    // its coordinates), followed by a line for each element, face and edge.
+    // Each processor reads the lines that start in its part of the file.
+    const std::streamoff startOfNodes = input.tellg();
+    input.seekg(0, std::ios::end);
+    const std::streamoff sizeOfLines = input.tellg() - startOfNodes;
+    const std::streamoff begin =
+        startOfNodes + sizeOfLines * static_cast<std::streamoff>(processorID) /
+                           static_cast<std::streamoff>(numberOfProcessors);
+    const std::streamoff end =
+        startOfNodes +
+        sizeOfLines * static_cast<std::streamoff>(processorID + 1) /
+            static_cast<std::streamoff>(numberOfProcessors);
+    input.seekg(begin);
+    if (begin > startOfNodes) {
+        // a line that starts in the part of the previous processor is read
+        // by the previous processor
+        input.seekg(begin - 1);
+        if (input.get() != '\n') {
+            input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+    std::vector<std::string> lines;
+    std::string line;
+    while (input.tellg() < end && std::getline(input, line)) {
+        lines.push_back(line);
+    }
+
+    // the number of the first line that each processor read
+    std::vector<std::vector<std::size_t>> numberOfLines(numberOfProcessors,
+                                                        {lines.size()});
+    numberOfLines = communicator.exchange(numberOfLines);
+    std::vector<std::size_t> firstLine(numberOfProcessors + 1, 0);
+    for (std::size_t i = 0; i < numberOfProcessors; ++i) {
+        firstLine[i + 1] = firstLine[i] + numberOfLines[i][0];
+    }
+    auto processorOfLine = [&](std::size_t lineNumber) {
+        return static_cast<std::size_t>(std::upper_bound(firstLine.begin(),
+                                                         firstLine.end(),
+                                                         lineNumber) -
+                                        firstLine.begin()) -
+               1;
+    };
+    const std::size_t firstElementLine = 2 * numberOfNodes;
+    const std::size_t firstFaceLine = firstElementLine + numberOfElements;
+    const std::size_t firstEdgeLine = firstFaceLine + numberOfFaces;
+    const std::size_t endOfLines = firstEdgeLine + numberOfEdges;
+
+    // the lines of this processor are a consecutive range of the nodes,
+    // elements, faces and edges
+    std::map<std::size_t, std::vector<LinearAlgebra::SmallVector<DIM>>>
+        nodeCoordinates;
+    std::size_t firstElement = numberOfElements;
+    std::vector<std::size_t> elementNodeOffsets = {0};
+    std::vector<std::size_t> elementNodes;
+    std::vector<std::size_t> elementCoordinateOffsets;
+    // (element, local face number, face, whether the face is internal,
+    // whether the element is on the left side) for the elements of the faces
+    std::vector<std::vector<std::size_t>> faceIncidences(numberOfProcessors);
+    // (element, local edge number, edge) for the elements of the edges
+    std::vector<std::vector<std::size_t>> edgeIncidences(numberOfProcessors);
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        const std::size_t lineNumber = firstLine[processorID] + i;
+        std::istringstream lineInput(lines[i]);
+        if (lineNumber < firstElementLine) {
+            if (lineNumber % 2 == 1) {
+                auto &coordinates = nodeCoordinates[lineNumber / 2];
+                std::size_t numberOfCoordinates;
+                lineInput >> numberOfCoordinates;
+                coordinates.resize(numberOfCoordinates);
+                for (LinearAlgebra::SmallVector<DIM> &coordinate :
+                     coordinates) {
+                    for (std::size_t l = 0; l < DIM; ++l) {
+                        coordinate[l] = readDouble(lineInput);
+                    }
+                }
+            }
+        } else if (lineNumber < firstFaceLine) {
+            firstElement =
+                std::min(firstElement, lineNumber - firstElementLine);
+            std::size_t nodesPerElement;
+            lineInput >> nodesPerElement;
+            for (std::size_t j = 0; j < nodesPerElement; ++j) {
+                std::size_t globalIndex, coordinateOffset;
+                lineInput >> globalIndex >> coordinateOffset;
+                elementNodes.push_back(globalIndex);
+                elementCoordinateOffsets.push_back(coordinateOffset);
+            }
+            elementNodeOffsets.push_back(elementNodes.size());
+        } else if (lineNumber < endOfLines) {
+            const bool isFace = lineNumber < firstEdgeLine;
+            std::size_t numberOfIncidences;
+            lineInput >> numberOfIncidences;
+            for (std::size_t j = 0; j < numberOfIncidences; ++j) {
+                std::size_t elementIndex, localNumber;
+                lineInput >> elementIndex >> localNumber;
+                auto &message = (isFace ? faceIncidences : edgeIncidences)
+                    [processorOfLine(firstElementLine + elementIndex)];
+                message.push_back(elementIndex);
+                message.push_back(localNumber);
+                if (isFace) {
+                    message.push_back(lineNumber - firstFaceLine);
+                    message.push_back(numberOfIncidences == 2);
+                    message.push_back(j == 0);
+                } else {
+                    message.push_back(lineNumber - firstEdgeLine);
+                }
+            }
+        }
+    }
+    const std::size_t numberOfLocalElements = elementNodeOffsets.size() - 1;
+
+    // ask the processors that read the nodes of the elements for their
+    // coordinates
+    std::vector<std::vector<std::size_t>> requestedNodes(numberOfProcessors);
+    {
+        std::set<std::size_t> neededNodes(elementNodes.begin(),
+                                          elementNodes.end());
+        for (std::size_t node : neededNodes) {
+            requestedNodes[processorOfLine(2 * node + 1)].push_back(node);
+        }
+    }
+    requestedNodes = communicator.exchange(requestedNodes);
+    std::vector<std::vector<std::size_t>> numbersOfCoordinates(
+        numberOfProcessors);
+    std::vector<std::vector<double>> coordinateValues(numberOfProcessors);
+    for (std::size_t i = 0; i < numberOfProcessors; ++i) {
+        for (std::size_t node : requestedNodes[i]) {
+            const auto &coordinates = nodeCoordinates.at(node);
+            numbersOfCoordinates[i].push_back(coordinates.size());
+            for (const LinearAlgebra::SmallVector<DIM> &coordinate :
+                 coordinates) {
+                for (std::size_t l = 0; l < DIM; ++l) {
+                    coordinateValues[i].push_back(coordinate[l]);
+                }
+            }
+        }
+    }
+    numbersOfCoordinates = communicator.exchange(numbersOfCoordinates);
+    coordinateValues = communicator.exchange(coordinateValues);
+    nodeCoordinates.clear();
+    {
+        // the requests were answered in the order in which they were sent
+        std::set<std::size_t> neededNodes(elementNodes.begin(),
+                                          elementNodes.end());
+        std::vector<std::size_t> nextNumber(numberOfProcessors, 0);
+        std::vector<std::size_t> nextValue(numberOfProcessors, 0);
+        for (std::size_t node : neededNodes) {
+            const std::size_t from = processorOfLine(2 * node + 1);
+            auto &coordinates = nodeCoordinates[node];
+            coordinates.resize(numbersOfCoordinates[from][nextNumber[from]++]);
+            for (LinearAlgebra::SmallVector<DIM> &coordinate : coordinates) {
+                for (std::size_t l = 0; l < DIM; ++l) {
+                    coordinate[l] = coordinateValues[from][nextValue[from]++];
+                }
+            }
+        }
+    }
+
+    // cut the space filling curve through the element centres, which are
+    // approximated by the average of the corners
+    std::vector<LinearAlgebra::SmallVector<DIM>> centers(numberOfLocalElements);
+    for (std::size_t i = 0; i < numberOfLocalElements; ++i) {
+        const std::size_t numberOfCorners =
+            elementNodeOffsets[i + 1] - elementNodeOffsets[i];
+        for (std::size_t j = elementNodeOffsets[i];
+             j < elementNodeOffsets[i + 1]; ++j) {
+            centers[i] += nodeCoordinates.at(
+                elementNodes[j])[elementCoordinateOffsets[j]];
+        }
+        centers[i] /= static_cast<double>(numberOfCorners);
+    }
+    const std::vector<std::size_t> owners =
+        Utilities::partitionAlongSpaceFillingCurveInParallel(
+            centers, std::vector<double>(numberOfLocalElements, 1.),
+            numberOfProcessors);
+
+    // An element is needed by the owners of all elements it shares a node
+    // with, like in the preprocessor. The processors that read the nodes
+    // collect (element, local node number, owner) for each node.
+    std::vector<std::vector<std::size_t>> nodeIncidences(numberOfProcessors);
+    for (std::size_t i = 0; i < numberOfLocalElements; ++i) {
+        for (std::size_t j = elementNodeOffsets[i];
+             j < elementNodeOffsets[i + 1]; ++j) {
+            auto &message =
+                nodeIncidences[processorOfLine(2 * elementNodes[j] + 1)];
+            message.push_back(elementNodes[j]);
+            message.push_back(firstElement + i);
+            message.push_back(j - elementNodeOffsets[i]);
+            message.push_back(owners[i]);
+        }
+    }
+    nodeIncidences = communicator.exchange(nodeIncidences);
+    // node -> (element, local node number, owner, processor that sent it)
+    std::map<std::size_t, std::vector<std::array<std::size_t, 4>>>
+        elementsOfNode;
+    for (std::size_t i = 0; i < numberOfProcessors; ++i) {
+        for (std::size_t j = 0; j < nodeIncidences[i].size(); j += 4) {
+            elementsOfNode[nodeIncidences[i][j]].push_back(
+                {nodeIncidences[i][j + 1], nodeIncidences[i][j + 2],
+                 nodeIncidences[i][j + 3], i});
+        }
+    }
+    // (element, local node number, number of elements at the node, whether
+    // the element has the lowest index at the node, number of owners, owners)
+    std::vector<std::vector<std::size_t>> nodeNeighbours(numberOfProcessors);
+    for (const auto &entry : elementsOfNode) {
+        std::set<std::size_t> nodeOwners;
+        std::size_t lowestElement = numberOfElements;
+        for (const auto &incidence : entry.second) {
+            nodeOwners.insert(incidence[2]);
+            lowestElement = std::min(lowestElement, incidence[0]);
+        }
+        for (const auto &incidence : entry.second) {
+            auto &message = nodeNeighbours[incidence[3]];
+            message.push_back(incidence[0]);
+            message.push_back(incidence[1]);
+            message.push_back(entry.second.size());
+            message.push_back(incidence[0] == lowestElement);
+            message.push_back(nodeOwners.size());
+            message.insert(message.end(), nodeOwners.begin(),
+                           nodeOwners.end());
+        }
+    }
+    elementsOfNode.clear();
+    nodeNeighbours = communicator.exchange(nodeNeighbours);
+    faceIncidences = communicator.exchange(faceIncidences);
+    edgeIncidences = communicator.exchange(edgeIncidences);
+
+    // The elements get the ids that readMesh would give them
+    auto &globalIndex = GlobalUniqueIndex::instance();
+    const std::size_t firstElementID = globalIndex.peekElementIndex();
+    // in 1D readMesh skips a node index, and the faces get the ids of the
+    // nodes
+    const std::size_t firstNodeID =
+        globalIndex.peekNodeIndex() + (DIM == 1 ? 1 : 0);
+    const std::size_t firstFaceID = globalIndex.peekFaceIndex();
+    const std::size_t firstEdgeID = globalIndex.peekEdgeIndex();
+    std::vector<ElementRecord> localRecords(numberOfLocalElements);
+    std::vector<std::set<std::size_t>> neighbourOwners(numberOfLocalElements);
+    for (std::size_t i = 0; i < numberOfLocalElements; ++i) {
+        ElementRecord &record = localRecords[i];
+        record.id = firstElementID + firstElement + i;
+        record.owner = owners[i];
+        for (std::size_t j = elementNodeOffsets[i];
+             j < elementNodeOffsets[i + 1]; ++j) {
+            record.nodeIDs.push_back(firstNodeID + elementNodes[j]);
+            record.nodeCoordinates.emplace_back(nodeCoordinates.at(
+                elementNodes[j])[elementCoordinateOffsets[j]]);
+        }
+        if (DIM == 1) {
+            record.faceIDs = record.nodeIDs;
+            record.isInternalFace.resize(record.nodeIDs.size());
+            record.isLeftOfFace.resize(record.nodeIDs.size());
+            record.faceTypes.resize(record.nodeIDs.size(),
+                                    Geometry::FaceType::WALL_BC);
+        }
+    }
+    for (const std::vector<std::size_t> &message : nodeNeighbours) {
+        for (std::size_t j = 0; j < message.size(); j += 5 + message[j + 4]) {
+            const std::size_t element = message[j] - firstElement;
+            const std::size_t localNode = message[j + 1];
+            neighbourOwners[element].insert(
+                message.begin() + static_cast<std::ptrdiff_t>(j + 5),
+                message.begin() +
+                    static_cast<std::ptrdiff_t>(j + 5 + message[j + 4]));
+            if (DIM == 1) {
+                ElementRecord &record = localRecords[element];
+                record.isInternalFace[localNode] = message[j + 2] == 2;
+                record.isLeftOfFace[localNode] = message[j + 3] == 1;
+                if (message[j + 2] == 2) {
+                    record.faceTypes[localNode] = Geometry::FaceType::INTERNAL;
+                }
+            }
+        }
+    }
+    for (const std::vector<std::size_t> &message : faceIncidences) {
+        for (std::size_t j = 0; j < message.size(); j += 5) {
+            ElementRecord &record = localRecords[message[j] - firstElement];
+            const std::size_t localFace = message[j + 1];
+            if (record.faceIDs.size() <= localFace) {
+                record.faceIDs.resize(localFace + 1);
+                record.isInternalFace.resize(localFace + 1);
+                record.isLeftOfFace.resize(localFace + 1);
+                record.faceTypes.resize(localFace + 1);
+            }
+            record.faceIDs[localFace] = firstFaceID + message[j + 2];
+            record.isInternalFace[localFace] = message[j + 3] == 1;
+            record.isLeftOfFace[localFace] = message[j + 4] == 1;
+            record.faceTypes[localFace] = message[j + 3] == 1
+                                              ? Geometry::FaceType::INTERNAL
+                                              : Geometry::FaceType::WALL_BC;
+        }
+    }
+    for (const std::vector<std::size_t> &message : edgeIncidences) {
+        for (std::size_t j = 0; j < message.size(); j += 3) {
+            ElementRecord &record = localRecords[message[j] - firstElement];
+            const std::size_t localEdge = message[j + 1];
+            if (record.edgeIDs.size() <= localEdge) {
+                record.edgeIDs.resize(localEdge + 1);
+            }
+            record.edgeIDs[localEdge] = firstEdgeID + message[j + 2];
+        }
+    }
+
+    // send the elements to their owners and to the processors that need them
+    // as shadow elements
+    std::vector<std::vector<std::size_t>> integers(numberOfProcessors);
+    std::vector<std::vector<double>> reals(numberOfProcessors);
+    for (std::size_t i = 0; i < numberOfLocalElements; ++i) {
+        ElementRecord &record = localRecords[i];
+        neighbourOwners[i].erase(record.owner);
+        record.shadowPartitions.assign(neighbourOwners[i].begin(),
+                                       neighbourOwners[i].end());
+        record.pack(integers[record.owner], reals[record.owner]);
+        for (std::size_t shadowPartition : record.shadowPartitions) {
+            record.pack(integers[shadowPartition], reals[shadowPartition]);
+        }
+    }
+    localRecords.clear();
+    integers = communicator.exchange(integers);
+    reals = communicator.exchange(reals);
+    std::vector<ElementRecord> records;
+    for (std::size_t i = 0; i < numberOfProcessors; ++i) {
+        std::size_t integerPosition = 0, realPosition = 0;
+        while (integerPosition < integers[i].size()) {
+            records.emplace_back();
+            records.back().unpack(integers[i], integerPosition, reals[i],
+                                  realPosition);
+        }
+    }
+    createMeshFromElementRecords(std::move(records));
+
+    numberOfElementsInFile_ = numberOfElements;
+    firstElementID_ = firstElementID;
+    globalIndex.skipToElementIndex(firstElementID + numberOfElements);
+    globalIndex.skipToNodeIndex(firstNodeID + numberOfNodes);
+    if (DIM == 1) {
+        if (globalIndex.peekFaceIndex() < firstNodeID + numberOfNodes) {
+            globalIndex.skipToFaceIndex(firstNodeID + numberOfNodes);
+        }
+    } else {
+        globalIndex.skipToFaceIndex(firstFaceID + numberOfFaces);
+    }
+    globalIndex.skipToEdgeIndex(firstEdgeID + numberOfEdges);
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::readMesh(
+    const std::string &filename,
+    const std::vector<std::size_t> &elementPartitions) {
+    // set to correct value in case some other meshManipulator changed things
+    ElementFactory::instance().setCollectionOfBasisFunctionSets(
+        &collBasisFSet_);
+    ElementFactory::instance().setNumberOfMatrices(numberOfElementMatrices_);
+    ElementFactory::instance().setNumberOfVectors(numberOfElementVectors_);
+    ElementFactory::instance().setNumberOfTimeLevels(
+        configData_->numberOfTimeLevels_);
+    ElementFactory::instance().setNumberOfUnknowns(
+        configData_->numberOfUnknowns_);
+    FaceFactory::instance().setNumberOfFaceMatrices(numberOfFaceMatrices_);
+    FaceFactory::instance().setNumberOfFaceVectors(numberOfFaceVectors_);
+    getElementsList().setSingleLevelTraversal(0);
+    logger.suppressWarnings([this]() {
+        getElementsList(IteratorType::GLOBAL).setSingleLevelTraversal(0);
+    });
+
+    using namespace std::string_literals;
+    std::ifstream input;
+    input.open(filename.c_str());
+    logger.assert_always(input.is_open(), "Cannot open input file: %",
+                         filename);
+    logger.assert_always(input.good(),
+                         "Something is not so good about this mesh");
+    std::string rawInput;
+    std::getline(input, rawInput);
+    logger.assert_always(
+        rawInput.substr(0, 4) == "mesh",
+        "incorrect file type, please use the preprocessor first");
+    logger.assert_always(
+        rawInput == "mesh 1"s,
+        "This file is too new to be read by the current version of hpGEM");
+    std::size_t numberOfNodes, numberOfElements, meshDimension;
+    input >> numberOfNodes >> numberOfElements >> meshDimension;
+    logger.assert_always(meshDimension == DIM,
+                         "The mesh in this input file has the wrong dimension "
+                         "(read %, but expected %)",
+                         meshDimension, DIM);
+    std::size_t numberOfFaces = 0;
+    std::size_t numberOfEdges = 0;
+    if (DIM > 1) input >> numberOfFaces;
+    if (DIM > 2) input >> numberOfEdges;
+    const bool usePartitionsFromFile = elementPartitions.empty();
+    std::size_t numberOfPartitions, localNumberOfNodes = 0;
+    input >> numberOfPartitions;
+    logger.assert_debug(MPIContainer::Instance().getProcessorID() >= 0,
+                        "We got assigned processor ID % by MPI (expected >=0)",
+                        MPIContainer::Instance().getProcessorID());
+    std::size_t processorID = MPIContainer::Instance().getProcessorID();
+    for (std::size_t i = 0; i < numberOfPartitions; ++i) {
+        std::size_t numberOfNodesInPartition;
+        input >> numberOfNodesInPartition;
+        if (i == processorID) {
+            localNumberOfNodes = numberOfNodesInPartition;
+        }
+    }
+    input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    logger.assert_debug(MPIContainer::Instance().getNumberOfProcessors() >= 0,
+                        "MPI thinks we are running only on % processors",
+                        MPIContainer::Instance().getNumberOfProcessors());
+    const std::size_t numberOfProcessors =
+        MPIContainer::Instance().getNumberOfProcessors();
+    if (usePartitionsFromFile) {
+        logger.assert_always(
+            numberOfPartitions == numberOfProcessors,
+            "This mesh is targeting % parallel threads, but you are running on "
+            "% threads, please rerun the preprocessor first",
+            numberOfPartitions, numberOfProcessors);
+    } else {
+        logger.assert_always(
+            elementPartitions.size() == numberOfElements,
+            "Got a partition for % elements, but the mesh has % elements",
+            elementPartitions.size(), numberOfElements);
+        for (std::size_t partition : elementPartitions) {
+            logger.assert_always(partition < numberOfProcessors,
+                                 "Cannot put an element on processor %, "
+                                 "there are only % processors",
+                                 partition, numberOfProcessors);
+        }
+    }
+    meshFileName_ = filename;
+    numberOfElementsInFile_ = numberOfElements;
+
+    // With a new partitioning, the processors that need a node, element, face
+    // or edge are derived from the nodes of the elements in the same way as
+    // the preprocessor does: an element is needed by the owners of all
+    // elements it shares a node with. The neighbour partitions are only
+    // computed for the elements this processor needs, the set stays empty for
+    // the others.
+    std::vector<std::set<std::size_t>> elementNeighbourPartitions;
+    std::vector<bool> nodeIsNeeded;
+    if (!usePartitionsFromFile) {
+        const auto startOfNodes = input.tellg();
+        for (std::size_t i = 0; i < 2 * numberOfNodes; ++i) {
+            input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        // element -> node and node -> element tables in compressed row form
+        std::vector<std::size_t> elementNodeOffsets(numberOfElements + 1, 0);
+        std::vector<std::size_t> elementNodes;
+        std::vector<std::size_t> nodeElementOffsets(numberOfNodes + 1, 0);
+        for (std::size_t i = 0; i < numberOfElements; ++i) {
+            std::size_t nodesPerElement;
+            input >> nodesPerElement;
+            for (std::size_t j = 0; j < nodesPerElement; ++j) {
+                std::size_t globalIndex, coordinateOffset;
+                input >> globalIndex >> coordinateOffset;
+                elementNodes.push_back(globalIndex);
+                ++nodeElementOffsets[globalIndex + 1];
+            }
+            elementNodeOffsets[i + 1] = elementNodes.size();
+            input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        input.seekg(startOfNodes);
+        std::partial_sum(nodeElementOffsets.begin(), nodeElementOffsets.end(),
+                         nodeElementOffsets.begin());
+        std::vector<std::size_t> nodeElements(elementNodes.size());
+        std::vector<std::size_t> nextNodeElement(
+            nodeElementOffsets.begin(), nodeElementOffsets.end() - 1);
+        std::vector<bool> nodeHasLocalElement(numberOfNodes, false);
+        for (std::size_t i = 0; i < numberOfElements; ++i) {
+            for (std::size_t j = elementNodeOffsets[i];
+                 j < elementNodeOffsets[i + 1]; ++j) {
+                nodeElements[nextNodeElement[elementNodes[j]]++] = i;
+                if (elementPartitions[i] == processorID) {
+                    nodeHasLocalElement[elementNodes[j]] = true;
+                }
+            }
+        }
+
+        elementNeighbourPartitions.resize(numberOfElements);
+        nodeIsNeeded.assign(numberOfNodes, false);
+        for (std::size_t i = 0; i < numberOfElements; ++i) {
+            const auto begin = elementNodes.begin() + elementNodeOffsets[i];
+            const auto end = elementNodes.begin() + elementNodeOffsets[i + 1];
+            if (std::none_of(begin, end, [&](std::size_t node) {
+                    return nodeHasLocalElement[node];
+                })) {
+                continue;
+            }
+            for (auto node = begin; node != end; ++node) {
+                nodeIsNeeded[*node] = true;
+                for (std::size_t j = nodeElementOffsets[*node];
+                     j < nodeElementOffsets[*node + 1]; ++j) {
+                    elementNeighbourPartitions[i].insert(
+                        elementPartitions[nodeElements[j]]);
+                }
+            }
+        }
+    }
+
+    std::size_t processedNodes = 0;
+    std::map<std::size_t, std::size_t> localNodeIndex;
+    std::map<std::size_t, std::size_t> startOfCoordinates;
+
+    // we need some leeway later on to synchronize face indices with node
+    // indices later on
+    if (DIM == 1) GlobalUniqueIndex::instance().getNodeIndex();
+
+    for (std::size_t i = 0; i < numberOfNodes; ++i) {
+        std::size_t nodePartitions;
         input >> nodePartitions;
         bool present = false;
-        for (std::size_t j = 0; j < nodePartitions && !present; ++j) {
+        for (std::size_t j = 0; j < nodePartitions; ++j) {
             std::size_t partition;
             input >> partition;
             // getProcessorID is already nonnegative according to preceding
             // check
-            if (partition == processorID) {
-                input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                startOfCoordinates[i] = getNumberOfNodeCoordinates();
-                localNodeIndex[i] = processedNodes++;
-                std::size_t numberOfCoordinates;
-                input >> numberOfCoordinates;
-                for (std::size_t k = 0; k < numberOfCoordinates; ++k) {
-                    double nextValue;
-                    LinearAlgebra::SmallVector<DIM> nextCoordinate;
-                    for (std::size_t l = 0; l < DIM; ++l) {
-                        nextValue = readDouble(input);
-                        nextCoordinate[l] = nextValue;
-                    }
-                    getMesh().addNodeCoordinate(nextCoordinate);
+            present = present || partition == processorID;
+        }
+        if (!usePartitionsFromFile) {
+            present = nodeIsNeeded[i];
+        }
+        input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        if (present) {
+            startOfCoordinates[i] = getNumberOfNodeCoordinates();
+            localNodeIndex[i] = processedNodes++;
+            std::size_t numberOfCoordinates;
+            input >> numberOfCoordinates;
+            for (std::size_t k = 0; k < numberOfCoordinates; ++k) {
+                double nextValue;
+                LinearAlgebra::SmallVector<DIM> nextCoordinate;
+                for (std::size_t l = 0; l < DIM; ++l) {
+                    nextValue = readDouble(input);
+                    nextCoordinate[l] = nextValue;
                 }
-                present = true;
-                addNode();
+                getMesh().addNodeCoordinate(nextCoordinate);
             }
-        }
-        if (!present) {
-            input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            addNode();
+        } else {
             input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
             // reserve the index for use on another processor
             GlobalUniqueIndex::instance().getNodeIndex();
         }
     }
     logger.assert_always(
-        processedNodes == localNumberOfNodes,
+        !usePartitionsFromFile || processedNodes == localNumberOfNodes,
         "The mesh file lies about how many nodes are in this partition");
 
     std::map<std::size_t, Element *> actualElement;
+    // the number of elements of the whole mesh that contain a local node, to
+    // tell the boundary of the domain from the boundary of the partition
+    std::vector<std::size_t> numberOfElementsAtNode(processedNodes, 0);
 
     for (std::size_t i = 0; i < numberOfElements; ++i) {
         std::size_t nodesPerElement;
@@ -1641,21 +2490,38 @@ void MeshManipulator<DIM>::readMesh(const std::string &filename) {
             input >> globalIndex >> coordinateOffset;
             coordinateIndices.push_back(startOfCoordinates[globalIndex] +
                                         coordinateOffset);
-            nodeNumbers.push_back(localNodeIndex[globalIndex]);
+            // elements with a node that is not on this processor are not on
+            // this processor either, so they don't need the node numbers
+            auto localIndex = localNodeIndex.find(globalIndex);
+            if (localIndex != localNodeIndex.end()) {
+                nodeNumbers.push_back(localIndex->second);
+                ++numberOfElementsAtNode[localIndex->second];
+            }
         }
         std::size_t partition;
         input >> partition;
+        std::size_t numberOfShadowPartitions;
+        input >> numberOfShadowPartitions;
+        std::vector<std::size_t> shadowPartitions(numberOfShadowPartitions);
+        for (std::size_t &shadowPartition : shadowPartitions) {
+            input >> shadowPartition;
+        }
+        if (!usePartitionsFromFile) {
+            partition = elementPartitions[i];
+            shadowPartitions.clear();
+            for (std::size_t shadowPartition : elementNeighbourPartitions[i]) {
+                if (shadowPartition != partition) {
+                    shadowPartitions.push_back(shadowPartition);
+                }
+            }
+        }
         Base::Element *element = nullptr;
         if (partition == processorID) {
             element = addElement(coordinateIndices, partition, true);
             actualElement[i] = element;
             getMesh().getSubmesh().add(element);
         }
-        std::size_t numberOfShadowPartitions;
-        input >> numberOfShadowPartitions;
-        for (std::size_t j = 0; j < numberOfShadowPartitions; ++j) {
-            std::size_t shadowPartition;
-            input >> shadowPartition;
+        for (std::size_t shadowPartition : shadowPartitions) {
             if (shadowPartition == processorID) {
                 element = addElement(coordinateIndices, partition, false);
                 actualElement[i] = element;
@@ -1665,13 +2531,18 @@ void MeshManipulator<DIM>::readMesh(const std::string &filename) {
                 getMesh().getSubmesh().addPush(element, shadowPartition);
             }
         }
+        std::size_t elementID;
         if (element != nullptr) {
             for (std::size_t j = 0; j < nodeNumbers.size(); ++j) {
                 getNodesList()[nodeNumbers[j]]->addElement(element, j);
             }
+            elementID = element->getID();
         } else {
             // reserve the index for use in another processor
-            GlobalUniqueIndex::instance().getElementIndex();
+            elementID = GlobalUniqueIndex::instance().getElementIndex();
+        }
+        if (i == 0) {
+            firstElementID_ = elementID;
         }
     }
 
@@ -1696,46 +2567,53 @@ void MeshManipulator<DIM>::readMesh(const std::string &filename) {
             localFaceNumbers[j] = nextFaceNumber;
         }
         bool faceIsInPartition = false;
-        std::size_t numberOfPartitions;
-        input >> numberOfPartitions;
-        for (std::size_t j = 0; j < numberOfPartitions; ++j) {
+        std::size_t numberOfFacePartitions;
+        input >> numberOfFacePartitions;
+        for (std::size_t j = 0; j < numberOfFacePartitions; ++j) {
             std::size_t partition;
             input >> partition;
-            if (partition == processorID) {
-                faceIsInPartition = true;
-                if (localNumberOfFaces == 1) {
+            faceIsInPartition = faceIsInPartition || partition == processorID;
+        }
+        if (!usePartitionsFromFile) {
+            faceIsInPartition = false;
+            for (std::size_t j = 0; j < localNumberOfFaces; ++j) {
+                faceIsInPartition =
+                    faceIsInPartition ||
+                    elementNeighbourPartitions[globalElementIndices[j]].count(
+                        processorID) > 0;
+            }
+        }
+        if (faceIsInPartition) {
+            if (localNumberOfFaces == 1) {
+                logger.assert_always(
+                    actualElement[globalElementIndices[0]] != nullptr,
+                    "local face is bounded by nonlocal element");
+                addFace(actualElement[globalElementIndices[0]],
+                        localFaceNumbers[0], nullptr, 0,
+                        Geometry::FaceType::WALL_BC);
+            } else {
+                if (actualElement[globalElementIndices[0]] == nullptr) {
+                    logger.assert_always(
+                        actualElement[globalElementIndices[1]] != nullptr,
+                        "local face is bounded by nonlocal element");
+                    addFace(actualElement[globalElementIndices[1]],
+                            localFaceNumbers[1], nullptr, 0,
+                            Geometry::FaceType::PARTIAL_FACE);
+                } else if (actualElement[globalElementIndices[1]] == nullptr) {
                     logger.assert_always(
                         actualElement[globalElementIndices[0]] != nullptr,
                         "local face is bounded by nonlocal element");
                     addFace(actualElement[globalElementIndices[0]],
                             localFaceNumbers[0], nullptr, 0,
-                            Geometry::FaceType::WALL_BC);
+                            Geometry::FaceType::PARTIAL_FACE);
                 } else {
-                    if (actualElement[globalElementIndices[0]] == nullptr) {
-                        logger.assert_always(
-                            actualElement[globalElementIndices[1]] != nullptr,
-                            "local face is bounded by nonlocal element");
-                        addFace(actualElement[globalElementIndices[1]],
-                                localFaceNumbers[1], nullptr, 0,
-                                Geometry::FaceType::PARTIAL_FACE);
-                    } else if (actualElement[globalElementIndices[1]] ==
-                               nullptr) {
-                        logger.assert_always(
-                            actualElement[globalElementIndices[0]] != nullptr,
-                            "local face is bounded by nonlocal element");
-                        addFace(actualElement[globalElementIndices[0]],
-                                localFaceNumbers[0], nullptr, 0,
-                                Geometry::FaceType::PARTIAL_FACE);
-                    } else {
-                        addFace(actualElement[globalElementIndices[0]],
-                                localFaceNumbers[0],
-                                actualElement[globalElementIndices[1]],
-                                localFaceNumbers[1]);
-                    }
+                    addFace(actualElement[globalElementIndices[0]],
+                            localFaceNumbers[0],
+                            actualElement[globalElementIndices[1]],
+                            localFaceNumbers[1]);
                 }
             }
-        }
-        if (!faceIsInPartition) {
+        } else {
             GlobalUniqueIndex::instance().getFaceIndex();
         }
     }
@@ -1752,60 +2630,1317 @@ void MeshManipulator<DIM>::readMesh(const std::string &filename) {
             localEdgeNumbers[j] = nextEdgeNumber;
         }
         bool edgeIsInPartition = false;
-        std::size_t numberOfPartitions;
-        input >> numberOfPartitions;
-        for (std::size_t j = 0; j < numberOfPartitions; ++j) {
+        std::size_t numberOfEdgePartitions;
+        input >> numberOfEdgePartitions;
+        for (std::size_t j = 0; j < numberOfEdgePartitions; ++j) {
             std::size_t partition;
             input >> partition;
-            if (partition == processorID) {
-                edgeIsInPartition = true;
-                auto edge = addEdge();
-                for (std::size_t k = 0; k < globalElementIndices.size(); ++k) {
-                    if (actualElement[globalElementIndices[k]]) {
-                        edge->addElement(actualElement[globalElementIndices[k]],
-                                         localEdgeNumbers[k]);
+            edgeIsInPartition = edgeIsInPartition || partition == processorID;
+        }
+        if (!usePartitionsFromFile) {
+            edgeIsInPartition = false;
+            for (std::size_t elementIndex : globalElementIndices) {
+                edgeIsInPartition =
+                    edgeIsInPartition ||
+                    elementNeighbourPartitions[elementIndex].count(
+                        processorID) > 0;
+            }
+        }
+        if (edgeIsInPartition) {
+            auto edge = addEdge();
+            for (std::size_t k = 0; k < globalElementIndices.size(); ++k) {
+                if (actualElement[globalElementIndices[k]]) {
+                    edge->addElement(actualElement[globalElementIndices[k]],
+                                     localEdgeNumbers[k]);
+                }
+            }
+        } else {
+            GlobalUniqueIndex::instance().getEdgeIndex();
+        }
+    }
+
+    if (DIM == 1) {
+        // the faces get the ids of their nodes, so the ids are the same on all
+        // processors, no matter which nodes they have
+        logger.suppressWarnings([&]() {
+            std::size_t nodeNumber = 0;
+            for (auto node : getNodesList(Base::IteratorType::GLOBAL)) {
+                if (numberOfElementsAtNode[nodeNumber++] == 1) {
+                    theMesh_.addFace(node->getElement(0),
+                                     node->getNodeNumber(0), nullptr, 0,
+                                     Geometry::FaceType::WALL_BC,
+                                     node->getID());
+                } else if (node->getNumberOfElements() == 1) {
+                    theMesh_.addFace(node->getElement(0),
+                                     node->getNodeNumber(0), nullptr, 0,
+                                     Geometry::FaceType::PARTIAL_FACE,
+                                     node->getID());
+                } else {
+                    theMesh_.addFace(
+                        node->getElement(0), node->getNodeNumber(0),
+                        node->getElement(1), node->getNodeNumber(1),
+                        Geometry::FaceType::INTERNAL, node->getID());
+                }
+                theMesh_.getSubmesh().add(
+                    *(--theMesh_.getFacesList(Base::IteratorType::GLOBAL)
+                            .end()));
+            }
+        });
+        auto &globalIndex = GlobalUniqueIndex::instance();
+        if (globalIndex.peekFaceIndex() < globalIndex.peekNodeIndex()) {
+            globalIndex.skipToFaceIndex(globalIndex.peekNodeIndex());
+        }
+    }
+
+    setSubdomainBoundaryFaceTypes();
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::setSubdomainBoundaryFaceTypes() {
+    for (auto pair : getPullElements()) {
+        for (Base::Element *element : pair.second) {
+            for (Base::Face *face : element->getFacesList()) {
+                if (face->isInternal()) {
+                    if (face->getFaceType() == Geometry::FaceType::INTERNAL) {
+                        face->setFaceType(
+                            Geometry::FaceType::SUBDOMAIN_BOUNDARY);
+                    } else {
+                        face->setFaceType(
+                            Geometry::FaceType::PERIODIC_SUBDOMAIN_BC);
+                    }
+                }
+            }
+        }
+    }
+}
+
+namespace Detail {
+// the scalars in the data of an element are sent as one or two doubles,
+// depending on whether they are complex
+inline void packScalar(double value, std::vector<double> &reals) {
+    reals.push_back(value);
+}
+
+inline void packScalar(std::complex<double> value, std::vector<double> &reals) {
+    reals.push_back(value.real());
+    reals.push_back(value.imag());
+}
+
+inline void unpackScalar(double &value, const std::vector<double> &reals,
+                         std::size_t &position) {
+    value = reals[position++];
+}
+
+inline void unpackScalar(std::complex<double> &value,
+                         const std::vector<double> &reals,
+                         std::size_t &position) {
+    value = {reals[position], reals[position + 1]};
+    position += 2;
+}
+
+inline void packVectors(
+    const std::vector<LinearAlgebra::MiddleSizeVector> &vectors,
+    std::vector<std::size_t> &integers, std::vector<double> &reals) {
+    integers.push_back(vectors.size());
+    for (const LinearAlgebra::MiddleSizeVector &vector : vectors) {
+        integers.push_back(vector.size());
+        for (std::size_t i = 0; i < vector.size(); ++i) {
+            packScalar(vector[i], reals);
+        }
+    }
+}
+
+inline void unpackVectors(std::vector<LinearAlgebra::MiddleSizeVector> &vectors,
+                          const std::vector<std::size_t> &integers,
+                          std::size_t &integerPosition,
+                          const std::vector<double> &reals,
+                          std::size_t &realPosition) {
+    vectors.resize(integers[integerPosition++]);
+    for (LinearAlgebra::MiddleSizeVector &vector : vectors) {
+        vector.resize(integers[integerPosition++]);
+        for (std::size_t i = 0; i < vector.size(); ++i) {
+            unpackScalar(vector[i], reals, realPosition);
+        }
+    }
+}
+
+inline void packMatrices(
+    const std::vector<LinearAlgebra::MiddleSizeMatrix> &matrices,
+    std::vector<std::size_t> &integers, std::vector<double> &reals) {
+    integers.push_back(matrices.size());
+    for (const LinearAlgebra::MiddleSizeMatrix &matrix : matrices) {
+        integers.push_back(matrix.getNumberOfRows());
+        integers.push_back(matrix.getNumberOfColumns());
+        for (std::size_t i = 0; i < matrix.size(); ++i) {
+            packScalar(matrix.data()[i], reals);
+        }
+    }
+}
+
+inline void unpackMatrices(
+    std::vector<LinearAlgebra::MiddleSizeMatrix> &matrices,
+    const std::vector<std::size_t> &integers, std::size_t &integerPosition,
+    const std::vector<double> &reals, std::size_t &realPosition) {
+    matrices.resize(integers[integerPosition++]);
+    for (LinearAlgebra::MiddleSizeMatrix &matrix : matrices) {
+        std::size_t rows = integers[integerPosition++];
+        std::size_t columns = integers[integerPosition++];
+        matrix.resize(rows, columns);
+        for (std::size_t i = 0; i < matrix.size(); ++i) {
+            unpackScalar(matrix.data()[i], reals, realPosition);
+        }
+    }
+}
+
+template <std::size_t DIM>
+void packPoints(const std::vector<Geometry::PointPhysical<DIM>> &points,
+                std::vector<std::size_t> &integers,
+                std::vector<double> &reals) {
+    integers.push_back(points.size());
+    for (const Geometry::PointPhysical<DIM> &point : points) {
+        for (std::size_t i = 0; i < DIM; ++i) {
+            reals.push_back(point[i]);
+        }
+    }
+}
+
+template <std::size_t DIM>
+void unpackPoints(std::vector<Geometry::PointPhysical<DIM>> &points,
+                  const std::vector<std::size_t> &integers,
+                  std::size_t &integerPosition,
+                  const std::vector<double> &reals,
+                  std::size_t &realPosition) {
+    points.resize(integers[integerPosition++]);
+    for (Geometry::PointPhysical<DIM> &point : points) {
+        for (std::size_t i = 0; i < DIM; ++i) {
+            point[i] = reals[realPosition++];
+        }
+    }
+}
+}  // namespace Detail
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::ElementRecord::pack(
+    std::vector<std::size_t> &integers, std::vector<double> &reals) const {
+    integers.push_back(id);
+    integers.push_back(owner);
+    integers.push_back(shadowPartitions.size());
+    integers.insert(integers.end(), shadowPartitions.begin(),
+                    shadowPartitions.end());
+    integers.push_back(nodeIDs.size());
+    integers.insert(integers.end(), nodeIDs.begin(), nodeIDs.end());
+    Detail::packPoints(nodeCoordinates, integers, reals);
+    integers.push_back(faceIDs.size());
+    for (std::size_t i = 0; i < faceIDs.size(); ++i) {
+        integers.push_back(faceIDs[i]);
+        integers.push_back(isInternalFace[i]);
+        integers.push_back(isLeftOfFace[i]);
+        integers.push_back(static_cast<std::size_t>(faceTypes[i]));
+    }
+    integers.push_back(edgeIDs.size());
+    integers.insert(integers.end(), edgeIDs.begin(), edgeIDs.end());
+    integers.push_back(geometryOrder);
+    Detail::packPoints(geometryNodes, integers, reals);
+    integers.push_back(hasBasisFunctions);
+    if (!hasBasisFunctions) {
+        return;
+    }
+    integers.push_back(basisFunctionSets.size());
+    for (std::size_t i = 0; i < basisFunctionSets.size(); ++i) {
+        integers.push_back(isDefaultDGBasis[i]);
+        integers.push_back(basisFunctionSets[i]);
+    }
+    integers.push_back(localTimeLevel);
+    integers.push_back(coarsestNeighbourLocalTimeLevel);
+    Detail::packVectors(timeLevelData, integers, reals);
+    Detail::packVectors(timeIntegrationVectors, integers, reals);
+    Detail::packMatrices(elementMatrices, integers, reals);
+    Detail::packVectors(elementVectors, integers, reals);
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::ElementRecord::unpack(
+    const std::vector<std::size_t> &integers, std::size_t &integerPosition,
+    const std::vector<double> &reals, std::size_t &realPosition) {
+    auto nextRange = [&](std::vector<std::size_t> &range) {
+        std::size_t size = integers[integerPosition++];
+        range.assign(integers.begin() + integerPosition,
+                     integers.begin() + integerPosition + size);
+        integerPosition += size;
+    };
+    id = integers[integerPosition++];
+    owner = integers[integerPosition++];
+    nextRange(shadowPartitions);
+    nextRange(nodeIDs);
+    Detail::unpackPoints(nodeCoordinates, integers, integerPosition, reals,
+                         realPosition);
+    std::size_t numberOfFaces = integers[integerPosition++];
+    faceIDs.resize(numberOfFaces);
+    isInternalFace.resize(numberOfFaces);
+    isLeftOfFace.resize(numberOfFaces);
+    faceTypes.resize(numberOfFaces);
+    for (std::size_t i = 0; i < numberOfFaces; ++i) {
+        faceIDs[i] = integers[integerPosition++];
+        isInternalFace[i] = integers[integerPosition++] != 0;
+        isLeftOfFace[i] = integers[integerPosition++] != 0;
+        faceTypes[i] =
+            static_cast<Geometry::FaceType>(integers[integerPosition++]);
+    }
+    nextRange(edgeIDs);
+    geometryOrder = integers[integerPosition++];
+    Detail::unpackPoints(geometryNodes, integers, integerPosition, reals,
+                         realPosition);
+    hasBasisFunctions = integers[integerPosition++] != 0;
+    if (!hasBasisFunctions) {
+        return;
+    }
+    std::size_t numberOfUnknowns = integers[integerPosition++];
+    isDefaultDGBasis.resize(numberOfUnknowns);
+    basisFunctionSets.resize(numberOfUnknowns);
+    for (std::size_t i = 0; i < numberOfUnknowns; ++i) {
+        isDefaultDGBasis[i] = integers[integerPosition++] != 0;
+        basisFunctionSets[i] = integers[integerPosition++];
+    }
+    localTimeLevel = integers[integerPosition++];
+    coarsestNeighbourLocalTimeLevel = integers[integerPosition++];
+    Detail::unpackVectors(timeLevelData, integers, integerPosition, reals,
+                          realPosition);
+    Detail::unpackVectors(timeIntegrationVectors, integers, integerPosition,
+                          reals, realPosition);
+    Detail::unpackMatrices(elementMatrices, integers, integerPosition, reals,
+                           realPosition);
+    Detail::unpackVectors(elementVectors, integers, integerPosition, reals,
+                          realPosition);
+}
+
+template <std::size_t DIM>
+typename MeshManipulator<DIM>::ElementRecord
+    MeshManipulator<DIM>::makeElementRecord(
+        const Element *element, std::size_t owner,
+        std::vector<std::size_t> shadowPartitions, bool withData) const {
+    ElementRecord record;
+    record.id = element->getID();
+    record.owner = owner;
+    record.shadowPartitions = std::move(shadowPartitions);
+    const Geometry::PhysicalGeometryBase *physicalGeometry =
+        element->getPhysicalGeometry();
+    for (std::size_t i = 0; i < element->getNumberOfNodes(); ++i) {
+        record.nodeIDs.push_back(element->getNode(i)->getID());
+        record.nodeCoordinates.push_back(
+            physicalGeometry->getLocalNodeCoordinates(i));
+    }
+    for (const Face *face : element->getFacesList()) {
+        logger.assert_always(face != nullptr,
+                             "Element % does not know all of its faces",
+                             element->getID());
+        logger.assert_always(
+            face->getFaceType() != Geometry::FaceType::PARTIAL_FACE,
+            "Element % is not surrounded by its neighbours",
+            element->getID());
+        record.faceIDs.push_back(face->getID());
+        record.isInternalFace.push_back(face->isInternal());
+        record.isLeftOfFace.push_back(face->getPtrElementLeft() == element);
+        record.faceTypes.push_back(face->getFaceType());
+    }
+    for (const Edge *edge : element->getEdgesList()) {
+        logger.assert_always(edge != nullptr,
+                             "Element % does not know all of its edges",
+                             element->getID());
+        record.edgeIDs.push_back(edge->getID());
+    }
+    auto curvedMapping =
+        dynamic_cast<const Geometry::MappingToPhysLagrange<DIM> *>(
+            element->getReferenceToPhysicalMap());
+    if (curvedMapping != nullptr) {
+        record.geometryOrder = curvedMapping->getOrder();
+        for (std::size_t i = 0; i < curvedMapping->getNumberOfGeometryNodes();
+             ++i) {
+            record.geometryNodes.push_back(curvedMapping->getGeometryNode(i));
+        }
+    }
+    if (!withData) {
+        return record;
+    }
+    record.hasBasisFunctions = true;
+    for (std::size_t unknown = 0; unknown < element->getNumberOfUnknowns();
+         ++unknown) {
+        logger.assert_always(
+            element->getNumberOfBasisFunctions(unknown) ==
+                element->getLocalNumberOfBasisFunctions(unknown),
+            "Only elements with discontinuous basis functions can be moved");
+        const BasisFunctionSet *set =
+            element->getLocalBasisFunctionSet(unknown);
+        if (set == nullptr) {
+            record.hasBasisFunctions = false;
+            break;
+        }
+        // the default DG sets are created when they are first needed, so they
+        // may be in a different position on the other processor
+        auto defaultSet = defaultDGBasisFunctionSets_.find(
+            {element->getReferenceGeometry()->getGeometryType(),
+             set->getOrder()});
+        if (defaultSet != defaultDGBasisFunctionSets_.end() &&
+            defaultSet->second.get() == set) {
+            record.isDefaultDGBasis.push_back(true);
+            record.basisFunctionSets.push_back(set->getOrder());
+        } else {
+            auto position = std::find_if(
+                collBasisFSet_.begin(), collBasisFSet_.end(),
+                [&](const std::shared_ptr<const BasisFunctionSet> &candidate) {
+                    return candidate.get() == set;
+                });
+            logger.assert_always(position != collBasisFSet_.end(),
+                                 "Element % uses basis functions that are not "
+                                 "part of this mesh",
+                                 element->getID());
+            record.isDefaultDGBasis.push_back(false);
+            record.basisFunctionSets.push_back(
+                static_cast<std::size_t>(position - collBasisFSet_.begin()));
+        }
+    }
+    if (!record.hasBasisFunctions) {
+        record.isDefaultDGBasis.clear();
+        record.basisFunctionSets.clear();
+        return record;
+    }
+    record.localTimeLevel = element->getLocalTimeLevel();
+    record.coarsestNeighbourLocalTimeLevel =
+        element->getCoarsestNeighbourLocalTimeLevel();
+    for (std::size_t level = 0; level < configData_->numberOfTimeLevels_;
+         ++level) {
+        record.timeLevelData.push_back(element->getTimeLevelDataVector(level));
+    }
+    for (std::size_t i = 0; i < element->getNumberOfTimeIntegrationVectors();
+         ++i) {
+        record.timeIntegrationVectors.push_back(
+            element->getTimeIntegrationVector(i));
+    }
+    for (std::size_t i = 0; i < numberOfElementMatrices_; ++i) {
+        record.elementMatrices.push_back(element->getElementMatrix(i));
+    }
+    for (std::size_t i = 0; i < numberOfElementVectors_; ++i) {
+        record.elementVectors.push_back(element->getElementVector(i));
+    }
+    return record;
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::createMeshFromElementRecords(
+    std::vector<ElementRecord> records) {
+    // set to correct value in case some other meshManipulator changed things
+    ElementFactory::instance().setCollectionOfBasisFunctionSets(
+        &collBasisFSet_);
+    ElementFactory::instance().setNumberOfMatrices(numberOfElementMatrices_);
+    ElementFactory::instance().setNumberOfVectors(numberOfElementVectors_);
+    ElementFactory::instance().setNumberOfTimeLevels(
+        configData_->numberOfTimeLevels_);
+    ElementFactory::instance().setNumberOfUnknowns(
+        configData_->numberOfUnknowns_);
+    FaceFactory::instance().setNumberOfFaceMatrices(numberOfFaceMatrices_);
+    FaceFactory::instance().setNumberOfFaceVectors(numberOfFaceVectors_);
+    getElementsList().setSingleLevelTraversal(0);
+    logger.suppressWarnings([this]() {
+        getElementsList(IteratorType::GLOBAL).setSingleLevelTraversal(0);
+        getFacesList(IteratorType::GLOBAL).setPreOrderTraversal();
+        getEdgesList(IteratorType::GLOBAL).setPreOrderTraversal();
+    });
+    const std::size_t processorID = MPIContainer::Instance().getProcessorID();
+    // everything is created in the order of the ids, like in readMesh
+    std::sort(records.begin(), records.end(),
+              [](const ElementRecord &first, const ElementRecord &second) {
+                  return first.id < second.id;
+              });
+
+    // a periodic node has a coordinate for each of its copies
+    std::map<std::size_t, std::vector<Geometry::PointPhysical<DIM>>>
+        coordinatesOfNode;
+    for (const ElementRecord &record : records) {
+        for (std::size_t i = 0; i < record.nodeIDs.size(); ++i) {
+            auto &coordinates = coordinatesOfNode[record.nodeIDs[i]];
+            if (std::find(coordinates.begin(), coordinates.end(),
+                          record.nodeCoordinates[i]) == coordinates.end()) {
+                coordinates.push_back(record.nodeCoordinates[i]);
+            }
+        }
+    }
+    std::map<std::size_t, std::pair<Node *, std::size_t>> nodeAndCoordinates;
+    for (const auto &entry : coordinatesOfNode) {
+        std::size_t startOfCoordinates = getNumberOfNodeCoordinates();
+        for (const Geometry::PointPhysical<DIM> &coordinate : entry.second) {
+            getMesh().addNodeCoordinate(coordinate);
+        }
+        Node *node = theMesh_.addNode(entry.first);
+        theMesh_.getSubmesh().add(node);
+        nodeAndCoordinates[entry.first] = {node, startOfCoordinates};
+    }
+
+    std::vector<Element *> elements;
+    for (const ElementRecord &record : records) {
+        std::vector<std::size_t> coordinateIndices;
+        for (std::size_t i = 0; i < record.nodeIDs.size(); ++i) {
+            const auto &coordinates = coordinatesOfNode[record.nodeIDs[i]];
+            coordinateIndices.push_back(
+                nodeAndCoordinates[record.nodeIDs[i]].second +
+                static_cast<std::size_t>(
+                    std::find(coordinates.begin(), coordinates.end(),
+                              record.nodeCoordinates[i]) -
+                    coordinates.begin()));
+        }
+        Element *element =
+            theMesh_.addElement(coordinateIndices, record.owner,
+                                record.owner == processorID, record.id);
+        if (record.owner == processorID) {
+            getMesh().getSubmesh().add(element);
+            for (std::size_t shadowPartition : record.shadowPartitions) {
+                getMesh().getSubmesh().addPush(
+                    element, static_cast<int>(shadowPartition));
+            }
+        } else {
+            logger.assert_debug(
+                std::find(record.shadowPartitions.begin(),
+                          record.shadowPartitions.end(),
+                          processorID) != record.shadowPartitions.end(),
+                "Received element % that is not needed here", record.id);
+            getMesh().getSubmesh().addPull(element,
+                                           static_cast<int>(record.owner));
+        }
+        for (std::size_t i = 0; i < record.nodeIDs.size(); ++i) {
+            nodeAndCoordinates[record.nodeIDs[i]].first->addElement(element,
+                                                                     i);
+        }
+        if (record.geometryOrder > 0) {
+            auto mapping = new Geometry::MappingToPhysLagrange<DIM>(
+                static_cast<const Geometry::PhysicalGeometry<DIM> *>(
+                    element->getPhysicalGeometry()),
+                record.geometryOrder);
+            logger.assert_always(
+                mapping->getNumberOfGeometryNodes() ==
+                    record.geometryNodes.size(),
+                "Element % should have % geometry nodes, but got %",
+                record.id, mapping->getNumberOfGeometryNodes(),
+                record.geometryNodes.size());
+            for (std::size_t i = 0; i < record.geometryNodes.size(); ++i) {
+                mapping->setGeometryNode(i, record.geometryNodes[i]);
+            }
+            element->setReferenceToPhysicalMap(mapping);
+        }
+        // the basis functions have to be there before the faces, so the
+        // faces get the right quadrature rules
+        if (record.hasBasisFunctions) {
+            for (std::size_t unknown = 0;
+                 unknown < record.basisFunctionSets.size(); ++unknown) {
+                std::size_t position = record.basisFunctionSets[unknown];
+                if (record.isDefaultDGBasis[unknown]) {
+                    position = getDefaultDGBasisFunctionSetPosition(
+                        element->getReferenceGeometry()->getGeometryType(),
+                        position);
+                }
+                logger.assert_always(
+                    position < collBasisFSet_.size(),
+                    "Element % uses basis function set %, but there are only "
+                    "% sets",
+                    record.id, position, collBasisFSet_.size());
+                element->setDefaultBasisFunctionSet(position, unknown);
+            }
+            element->resetQuadratureRules();
+            element->setLocalTimeLevel(record.localTimeLevel,
+                                       record.coarsestNeighbourLocalTimeLevel);
+            for (std::size_t level = 0; level < record.timeLevelData.size();
+                 ++level) {
+                element->getTimeLevelDataVector(level) =
+                    record.timeLevelData[level];
+            }
+            element->setNumberOfTimeIntegrationVectors(
+                record.timeIntegrationVectors.size());
+            for (std::size_t i = 0; i < record.timeIntegrationVectors.size();
+                 ++i) {
+                element->getTimeIntegrationVector(i) =
+                    record.timeIntegrationVectors[i];
+            }
+            for (std::size_t i = 0; i < record.elementMatrices.size(); ++i) {
+                element->getElementMatrix(i) = record.elementMatrices[i];
+            }
+            for (std::size_t i = 0; i < record.elementVectors.size(); ++i) {
+                element->setElementVector(record.elementVectors[i], i);
+            }
+        }
+        elements.push_back(element);
+    }
+
+    // (id, whether the element is on the right, element, local face number)
+    std::vector<std::tuple<std::size_t, bool, std::size_t, std::size_t>>
+        faceIncidences;
+    // (id, element, local edge number)
+    std::vector<std::tuple<std::size_t, std::size_t, std::size_t>>
+        edgeIncidences;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        for (std::size_t j = 0; j < records[i].faceIDs.size(); ++j) {
+            faceIncidences.emplace_back(
+                records[i].faceIDs[j],
+                records[i].isInternalFace[j] && !records[i].isLeftOfFace[j], i,
+                j);
+        }
+        for (std::size_t j = 0; j < records[i].edgeIDs.size(); ++j) {
+            edgeIncidences.emplace_back(records[i].edgeIDs[j], i, j);
+        }
+    }
+    std::sort(faceIncidences.begin(), faceIncidences.end());
+    std::sort(edgeIncidences.begin(), edgeIncidences.end());
+    for (std::size_t i = 0; i < faceIncidences.size(); ++i) {
+        std::size_t faceID, element, localFace;
+        std::tie(faceID, std::ignore, element, localFace) = faceIncidences[i];
+        if (i + 1 < faceIncidences.size() &&
+            std::get<0>(faceIncidences[i + 1]) == faceID) {
+            logger.assert_debug(std::get<1>(faceIncidences[i + 1]),
+                                "Face % has two elements on its left side",
+                                faceID);
+            theMesh_.addFace(elements[element], localFace,
+                             elements[std::get<2>(faceIncidences[i + 1])],
+                             std::get<3>(faceIncidences[i + 1]),
+                             Geometry::FaceType::INTERNAL, faceID);
+            ++i;
+        } else if (records[element].isInternalFace[localFace]) {
+            // the other element of this face is not on this processor
+            theMesh_.addFace(elements[element], localFace, nullptr, 0,
+                             Geometry::FaceType::PARTIAL_FACE, faceID);
+        } else {
+            theMesh_.addFace(elements[element], localFace, nullptr, 0,
+                             records[element].faceTypes[localFace], faceID);
+        }
+        logger.suppressWarnings([this]() {
+            theMesh_.getSubmesh().add(
+                *(--theMesh_.getFacesList(Base::IteratorType::GLOBAL).end()));
+        });
+    }
+    for (std::size_t i = 0; i < edgeIncidences.size(); ++i) {
+        Edge *edge = theMesh_.addEdge(std::get<0>(edgeIncidences[i]));
+        theMesh_.getSubmesh().add(edge);
+        edge->addElement(elements[std::get<1>(edgeIncidences[i])],
+                         std::get<2>(edgeIncidences[i]));
+        while (i + 1 < edgeIncidences.size() &&
+               std::get<0>(edgeIncidences[i + 1]) == edge->getID()) {
+            ++i;
+            edge->addElement(elements[std::get<1>(edgeIncidences[i])],
+                             std::get<2>(edgeIncidences[i]));
+        }
+    }
+
+    setSubdomainBoundaryFaceTypes();
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::redistribute(
+    const std::vector<std::size_t> &newOwners) {
+    logger.assert_always(newOwners.size() == getNumberOfElements(),
+                         "There are % elements, but % new owners",
+                         getNumberOfElements(), newOwners.size());
+    for (const auto *entry :
+         getElementsList(IteratorType::GLOBAL).getRootEntries()) {
+        logger.assert_always(
+            entry->isLeaf(),
+            "Redistributing a refined mesh is not supported yet");
+    }
+    auto &communicator = MPIContainer::Instance();
+    const std::size_t numberOfProcessors = communicator.getNumberOfProcessors();
+
+    // the new owners of the shadow elements are sent by their current owners
+    std::unordered_map<const Element *, std::size_t> newOwner;
+    std::size_t position = 0;
+    for (const Element *element : getElementsList()) {
+        logger.assert_always(newOwners[position] < numberOfProcessors,
+                             "Cannot move an element to processor %, there "
+                             "are only % processors",
+                             newOwners[position], numberOfProcessors);
+        newOwner[element] = newOwners[position++];
+    }
+    std::vector<std::vector<std::size_t>> newShadowOwners(numberOfProcessors);
+    for (const auto &pair : getPushElements()) {
+        for (const Element *element : pair.second) {
+            newShadowOwners[pair.first].push_back(element->getID());
+            newShadowOwners[pair.first].push_back(newOwner.at(element));
+        }
+    }
+    newShadowOwners = communicator.exchange(newShadowOwners);
+    std::unordered_map<std::size_t, const Element *> shadowElements;
+    for (const auto &pair : getPullElements()) {
+        for (const Element *element : pair.second) {
+            shadowElements[element->getID()] = element;
+        }
+    }
+    for (const std::vector<std::size_t> &message : newShadowOwners) {
+        for (std::size_t i = 0; i < message.size(); i += 2) {
+            newOwner[shadowElements.at(message[i])] = message[i + 1];
+        }
+    }
+
+    // an element is needed by its new owner and, as shadow element, by the new
+    // owners of the elements it shares a node with
+    std::vector<std::vector<std::size_t>> integers(numberOfProcessors);
+    std::vector<std::vector<double>> reals(numberOfProcessors);
+    for (const Element *element : getElementsList()) {
+        std::size_t owner = newOwner.at(element);
+        std::set<std::size_t> shadowPartitions;
+        for (const Node *node : element->getNodesList()) {
+            for (std::size_t i = 0; i < node->getNumberOfElements(); ++i) {
+                shadowPartitions.insert(newOwner.at(node->getElement(i)));
+            }
+        }
+        shadowPartitions.erase(owner);
+        ElementRecord record = makeElementRecord(
+            element, owner, {shadowPartitions.begin(), shadowPartitions.end()},
+            true);
+        record.pack(integers[owner], reals[owner]);
+        for (std::size_t shadowPartition : shadowPartitions) {
+            record.pack(integers[shadowPartition], reals[shadowPartition]);
+        }
+    }
+    integers = communicator.exchange(integers);
+    reals = communicator.exchange(reals);
+    std::vector<ElementRecord> records;
+    for (std::size_t i = 0; i < numberOfProcessors; ++i) {
+        std::size_t integerPosition = 0, realPosition = 0;
+        while (integerPosition < integers[i].size()) {
+            records.emplace_back();
+            records.back().unpack(integers[i], integerPosition, reals[i],
+                                  realPosition);
+        }
+    }
+
+    theMesh_.clear();
+    measurePoints_.clear();
+    createMeshFromElementRecords(std::move(records));
+    // the measure points may have moved to another processor
+    std::vector<Geometry::PointPhysical<DIM>> measurePointLocations;
+    std::swap(measurePointLocations, measurePointLocations_);
+    for (const Geometry::PointPhysical<DIM> &pointPhysical :
+         measurePointLocations) {
+        addMeasurePoint(pointPhysical);
+    }
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::createStructuredMesh(
+    const Geometry::PointPhysical<DIM> &bottomLeft,
+    const Geometry::PointPhysical<DIM> &topRight,
+    const std::array<std::size_t, DIM> &numberOfElements, bool triangular,
+    const std::array<bool, DIM> &periodic) {
+    // set to correct value in case some other meshManipulator changed things
+    ElementFactory::instance().setCollectionOfBasisFunctionSets(
+        &collBasisFSet_);
+    ElementFactory::instance().setNumberOfMatrices(numberOfElementMatrices_);
+    ElementFactory::instance().setNumberOfVectors(numberOfElementVectors_);
+    ElementFactory::instance().setNumberOfTimeLevels(
+        configData_->numberOfTimeLevels_);
+    ElementFactory::instance().setNumberOfUnknowns(
+        configData_->numberOfUnknowns_);
+    FaceFactory::instance().setNumberOfFaceMatrices(numberOfFaceMatrices_);
+    FaceFactory::instance().setNumberOfFaceVectors(numberOfFaceVectors_);
+    getElementsList().setSingleLevelTraversal(0);
+    logger.suppressWarnings([this]() {
+        getElementsList(IteratorType::GLOBAL).setSingleLevelTraversal(0);
+    });
+    logger.assert_always(
+        !triangular || DIM == 2 || DIM == 3,
+        "I don't know how to generate triangles for this dimension");
+
+    // like in the preprocessor, the nodes form a grid with one node more than
+    // there are elements in each direction, except for periodic directions
+    std::array<std::size_t, DIM> numberOfNodes;
+    std::array<std::size_t, DIM> cellStride;
+    std::array<std::size_t, DIM> nodeStride;
+    std::size_t totalNumberOfCells = 1;
+    std::size_t totalNumberOfNodes = 1;
+    for (std::size_t i = 0; i < DIM; ++i) {
+        logger.assert_always(numberOfElements[i] > (periodic[i] ? 1 : 0),
+                             "Direction % needs at least % elements, but has %",
+                             i, periodic[i] ? 2 : 1, numberOfElements[i]);
+        numberOfNodes[i] = numberOfElements[i] + (periodic[i] ? 0 : 1);
+        cellStride[i] = totalNumberOfCells;
+        nodeStride[i] = totalNumberOfNodes;
+        totalNumberOfCells *= numberOfElements[i];
+        totalNumberOfNodes *= numberOfNodes[i];
+    }
+
+    // The corners of the elements in a cube of the grid. Bit i of a corner is
+    // set if the corner is at the top of the cube in direction i. As in the
+    // preprocessor, the splitting into simplices is rotated a quarter turn in
+    // the xy-plane every time the loop over the cubes takes a step, and once
+    // more when it wraps around an odd number of cubes. In cube c this adds up
+    // to sum_i c[i] * rotationStride[i] rotations.
+    std::vector<std::vector<std::size_t>> cornersOfElements;
+    if (!triangular) {
+        cornersOfElements.emplace_back(std::size_t{1} << DIM);
+        std::iota(cornersOfElements[0].begin(), cornersOfElements[0].end(),
+                  0);
+    } else if (DIM == 2) {
+        cornersOfElements = {{0, 1, 2}, {1, 3, 2}};
+    } else {
+        cornersOfElements = {{1, 2, 4, 7},
+                             {0, 1, 2, 4},
+                             {1, 3, 2, 7},
+                             {1, 4, 5, 7},
+                             {2, 6, 4, 7}};
+    }
+    const std::size_t elementsPerCell = cornersOfElements.size();
+    const std::array<std::size_t, 8> rotate = {2, 0, 3, 1, 6, 4, 7, 5};
+    std::array<std::vector<std::vector<std::size_t>>, 4> rotatedCorners;
+    rotatedCorners[0] = cornersOfElements;
+    for (std::size_t i = 1; i < 4; ++i) {
+        rotatedCorners[i] = rotatedCorners[i - 1];
+        for (std::vector<std::size_t> &corners : rotatedCorners[i]) {
+            for (std::size_t &corner : corners) {
+                if (triangular) corner = rotate[corner];
+            }
+        }
+    }
+    std::array<std::size_t, DIM> rotationStride;
+    rotationStride[0] = 1;
+    for (std::size_t i = 1; i < DIM; ++i) {
+        rotationStride[i] = (numberOfElements[i - 1] * rotationStride[i - 1] +
+                             1 + numberOfElements[i - 1] % 2) %
+                            4;
+    }
+    auto getRotation = [&](const std::array<std::size_t, DIM> &cell) {
+        std::size_t rotation = 0;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            rotation += (cell[i] % 4) * rotationStride[i];
+        }
+        return rotation % 4;
+    };
+
+    // lay out the processors as a grid of blocks, such that the area of the
+    // boundaries between the blocks is as small as possible
+    const std::size_t numberOfProcessors =
+        MPIContainer::Instance().getNumberOfProcessors();
+    const std::size_t processorID = MPIContainer::Instance().getProcessorID();
+    std::array<std::size_t, DIM> numberOfBlocks;
+    std::array<std::size_t, DIM> candidateBlocks;
+    double smallestArea = std::numeric_limits<double>::infinity();
+    std::function<void(std::size_t, std::size_t)> tryBlocks =
+        [&](std::size_t i, std::size_t remainingProcessors) {
+            if (i + 1 < DIM) {
+                for (std::size_t blocks = 1; blocks <= remainingProcessors;
+                     ++blocks) {
+                    if (remainingProcessors % blocks == 0) {
+                        candidateBlocks[i] = blocks;
+                        tryBlocks(i + 1, remainingProcessors / blocks);
                     }
                 }
+                return;
+            }
+            candidateBlocks[i] = remainingProcessors;
+            double area = 0;
+            for (std::size_t j = 0; j < DIM; ++j) {
+                if (candidateBlocks[j] > numberOfElements[j]) return;
+                std::size_t numberOfCuts = candidateBlocks[j] - 1;
+                if (periodic[j] && candidateBlocks[j] > 1) ++numberOfCuts;
+                area += double(numberOfCuts) * double(totalNumberOfCells) /
+                        double(numberOfElements[j]);
+            }
+            if (area < smallestArea) {
+                smallestArea = area;
+                numberOfBlocks = candidateBlocks;
+            }
+        };
+    tryBlocks(0, numberOfProcessors);
+    logger.assert_always(smallestArea < std::numeric_limits<double>::infinity(),
+                         "Cannot divide % elements over % processors",
+                         totalNumberOfCells, numberOfProcessors);
+    auto getOwner = [&](const std::array<std::size_t, DIM> &cell) {
+        std::size_t owner = 0;
+        std::size_t blockStride = 1;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            owner += blockStride * (((cell[i] + 1) * numberOfBlocks[i] - 1) /
+                                    numberOfElements[i]);
+            blockStride *= numberOfBlocks[i];
+        }
+        return owner;
+    };
+
+    // the cubes of the block of this processor, and the layer of cubes around
+    // it, per direction
+    std::array<std::vector<std::size_t>, DIM> visitedCells;
+    std::size_t remainingID = processorID;
+    for (std::size_t i = 0; i < DIM; ++i) {
+        const std::size_t n = numberOfElements[i];
+        const std::size_t block = remainingID % numberOfBlocks[i];
+        remainingID /= numberOfBlocks[i];
+        // shifted by n, to avoid wrapping below 0
+        const std::size_t first = n + n * block / numberOfBlocks[i] - 1;
+        const std::size_t last = n + n * (block + 1) / numberOfBlocks[i];
+        for (std::size_t cell = first; cell <= last; ++cell) {
+            if (periodic[i]) {
+                visitedCells[i].push_back(cell % n);
+            } else if (n <= cell && cell < 2 * n) {
+                visitedCells[i].push_back(cell - n);
+            }
+        }
+        std::sort(visitedCells[i].begin(), visitedCells[i].end());
+        visitedCells[i].erase(
+            std::unique(visitedCells[i].begin(), visitedCells[i].end()),
+            visitedCells[i].end());
+    }
+
+    // The node at a corner of a cube, and which of the periodic copies of the
+    // coordinates of the node it uses. As in the preprocessor, a node at the
+    // bottom of a periodic direction gets an extra copy of its coordinates at
+    // the top of that direction.
+    auto getCornerNode = [&](const std::array<std::size_t, DIM> &cell,
+                             std::size_t corner,
+                             std::array<std::size_t, DIM> &position,
+                             std::size_t &coordinateOffset) {
+        std::size_t node = 0;
+        std::size_t numberOfPeriodicBottoms = 0;
+        coordinateOffset = 0;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            position[i] = cell[i] + ((corner >> i) & 1);
+            if (position[i] == numberOfNodes[i]) {
+                position[i] = 0;
+                coordinateOffset += std::size_t{1}
+                                    << numberOfPeriodicBottoms++;
+            } else if (periodic[i] && position[i] == 0) {
+                ++numberOfPeriodicBottoms;
+            }
+            node += position[i] * nodeStride[i];
+        }
+        return node;
+    };
+
+    struct StructuredElement {
+        std::size_t globalIndex;
+        std::array<std::size_t, DIM> cell;
+        const std::vector<std::size_t> *corners;
+        std::size_t partition;
+        std::vector<std::size_t> shadowPartitions;
+        Element *element;
+    };
+
+    // Find the elements this processor needs. Like in readMesh, an element is
+    // needed by the owners of all elements it shares a node with.
+    std::vector<StructuredElement> localElements;
+    std::vector<std::size_t> neededNodes;
+    std::array<std::size_t, DIM> loopIndices{};
+    std::set<std::size_t> neighbourPartitions;
+    bool visitedAllCells = false;
+    while (!visitedAllCells) {
+        std::array<std::size_t, DIM> cell;
+        std::size_t cellIndex = 0;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            cell[i] = visitedCells[i][loopIndices[i]];
+            cellIndex += cell[i] * cellStride[i];
+        }
+        const std::size_t partition = getOwner(cell);
+        for (std::size_t k = 0; k < elementsPerCell; ++k) {
+            const std::vector<std::size_t> &corners =
+                rotatedCorners[getRotation(cell)][k];
+            neighbourPartitions.clear();
+            for (std::size_t corner : corners) {
+                std::array<std::size_t, DIM> position;
+                std::size_t coordinateOffset;
+                getCornerNode(cell, corner, position, coordinateOffset);
+                for (std::size_t side = 0; side < (std::size_t{1} << DIM);
+                     ++side) {
+                    std::array<std::size_t, DIM> neighbour = position;
+                    bool exists = true;
+                    for (std::size_t i = 0; i < DIM; ++i) {
+                        if (((side >> i) & 1) == 0) {
+                            exists = exists &&
+                                     neighbour[i] < numberOfElements[i];
+                        } else if (neighbour[i] > 0) {
+                            --neighbour[i];
+                        } else {
+                            neighbour[i] = numberOfElements[i] - 1;
+                            exists = exists && periodic[i];
+                        }
+                    }
+                    if (exists) {
+                        neighbourPartitions.insert(getOwner(neighbour));
+                    }
+                }
+            }
+            if (neighbourPartitions.count(processorID) == 0) {
+                continue;
+            }
+            StructuredElement local;
+            local.globalIndex = cellIndex * elementsPerCell + k;
+            local.cell = cell;
+            local.corners = &corners;
+            local.partition = partition;
+            for (std::size_t shadowPartition : neighbourPartitions) {
+                if (shadowPartition != partition) {
+                    local.shadowPartitions.push_back(shadowPartition);
+                }
+            }
+            local.element = nullptr;
+            localElements.push_back(std::move(local));
+            for (std::size_t corner : corners) {
+                std::array<std::size_t, DIM> position;
+                std::size_t coordinateOffset;
+                neededNodes.push_back(
+                    getCornerNode(cell, corner, position, coordinateOffset));
+            }
+        }
+        // emulates nested loops over all dimensions
+        visitedAllCells = true;
+        for (std::size_t i = 0; i < DIM && visitedAllCells; ++i) {
+            if (++loopIndices[i] < visitedCells[i].size()) {
+                visitedAllCells = false;
+            } else {
+                loopIndices[i] = 0;
+            }
+        }
+    }
+    std::sort(neededNodes.begin(), neededNodes.end());
+    neededNodes.erase(std::unique(neededNodes.begin(), neededNodes.end()),
+                      neededNodes.end());
+
+    // The ids of all entities follow from their place in the grid, the ids in
+    // between are reserved for the entities on the other processors
+    GlobalUniqueIndex &indices = GlobalUniqueIndex::instance();
+    const std::size_t firstNodeID = indices.peekNodeIndex();
+    std::vector<std::size_t> startOfCoordinates(neededNodes.size());
+    for (std::size_t j = 0; j < neededNodes.size(); ++j) {
+        std::array<std::size_t, DIM> position;
+        std::vector<Geometry::PointPhysical<DIM>> coordinates(1);
+        std::size_t remainder = neededNodes[j];
+        for (std::size_t i = 0; i < DIM; ++i) {
+            position[i] = remainder % numberOfNodes[i];
+            remainder /= numberOfNodes[i];
+            coordinates[0][i] =
+                bottomLeft[i] + static_cast<double>(position[i]) *
+                                    (topRight[i] - bottomLeft[i]) /
+                                    static_cast<double>(numberOfElements[i]);
+        }
+        for (std::size_t i = 0; i < DIM; ++i) {
+            if (periodic[i] && position[i] == 0) {
+                const std::size_t currentSize = coordinates.size();
+                for (std::size_t k = 0; k < currentSize; ++k) {
+                    Geometry::PointPhysical<DIM> copy = coordinates[k];
+                    copy[i] += topRight[i] - bottomLeft[i];
+                    coordinates.push_back(copy);
+                }
+            }
+        }
+        startOfCoordinates[j] = getNumberOfNodeCoordinates();
+        for (const Geometry::PointPhysical<DIM> &coordinate : coordinates) {
+            getMesh().addNodeCoordinate(coordinate);
+        }
+        indices.skipToNodeIndex(firstNodeID + neededNodes[j]);
+        addNode();
+    }
+    indices.skipToNodeIndex(firstNodeID + totalNumberOfNodes);
+
+    const std::size_t firstElementID = indices.peekElementIndex();
+    for (StructuredElement &local : localElements) {
+        std::vector<std::size_t> coordinateIndices;
+        std::vector<std::size_t> nodeNumbers;
+        for (std::size_t corner : *local.corners) {
+            std::array<std::size_t, DIM> position;
+            std::size_t coordinateOffset;
+            const std::size_t node =
+                getCornerNode(local.cell, corner, position, coordinateOffset);
+            const std::size_t nodeNumber =
+                std::lower_bound(neededNodes.begin(), neededNodes.end(),
+                                 node) -
+                neededNodes.begin();
+            coordinateIndices.push_back(startOfCoordinates[nodeNumber] +
+                                        coordinateOffset);
+            nodeNumbers.push_back(nodeNumber);
+        }
+        indices.skipToElementIndex(firstElementID + local.globalIndex);
+        if (local.partition == processorID) {
+            local.element =
+                addElement(coordinateIndices, local.partition, true);
+            getMesh().getSubmesh().add(local.element);
+            for (std::size_t shadowPartition : local.shadowPartitions) {
+                getMesh().getSubmesh().addPush(
+                    local.element, static_cast<int>(shadowPartition));
+            }
+        } else {
+            local.element =
+                addElement(coordinateIndices, local.partition, false);
+            getMesh().getSubmesh().addPull(
+                local.element, static_cast<int>(local.partition));
+        }
+        for (std::size_t j = 0; j < nodeNumbers.size(); ++j) {
+            getNodesList(IteratorType::GLOBAL)[nodeNumbers[j]]->addElement(
+                local.element, j);
+        }
+    }
+    indices.skipToElementIndex(firstElementID +
+                               totalNumberOfCells * elementsPerCell);
+
+    // A face or an edge is identified by a key: the grid point at the bottom
+    // of the smallest cube that contains it, and the corners of that cube it
+    // touches. The possible sets of corners are numbered.
+    const Geometry::ReferenceGeometry *referenceGeometry =
+        localElements.front().element->getReferenceGeometry();
+    auto getLocalNodes = [&](std::size_t codimension, std::size_t entity) {
+        return codimension == 1
+                   ? referenceGeometry->getCodim1EntityLocalIndices(entity)
+                   : referenceGeometry->getCodim2EntityLocalIndices(entity);
+    };
+    // moves cell to the cube at the bottom of the entity and returns the
+    // corners of that cube the entity touches
+    auto getCornerMask = [&](std::array<std::size_t, DIM> &cell,
+                             const std::vector<std::size_t> &corners,
+                             const std::vector<std::size_t> &localNodes) {
+        std::size_t bottom = ~std::size_t{0};
+        for (std::size_t localNode : localNodes) {
+            bottom &= corners[localNode];
+        }
+        std::size_t mask = 0;
+        for (std::size_t localNode : localNodes) {
+            mask |= std::size_t{1} << (corners[localNode] & ~bottom);
+        }
+        for (std::size_t i = 0; i < DIM; ++i) {
+            cell[i] += (bottom >> i) & 1;
+            if (cell[i] == numberOfNodes[i]) cell[i] = 0;
+        }
+        return mask;
+    };
+    auto getKinds = [&](std::size_t codimension,
+                        std::size_t numberOfEntities) {
+        std::vector<std::size_t> kinds;
+        for (const auto &cornersOfRotation : rotatedCorners) {
+            for (const std::vector<std::size_t> &corners : cornersOfRotation) {
+                for (std::size_t entity = 0; entity < numberOfEntities;
+                     ++entity) {
+                    std::array<std::size_t, DIM> cell{};
+                    kinds.push_back(getCornerMask(
+                        cell, corners, getLocalNodes(codimension, entity)));
+                }
+            }
+        }
+        std::sort(kinds.begin(), kinds.end());
+        kinds.erase(std::unique(kinds.begin(), kinds.end()), kinds.end());
+        return kinds;
+    };
+    auto getKey = [&](const std::vector<std::size_t> &kinds,
+                      std::size_t codimension,
+                      std::array<std::size_t, DIM> &cell,
+                      const std::vector<std::size_t> &corners,
+                      std::size_t entity, std::size_t &mask) {
+        mask = getCornerMask(cell, corners, getLocalNodes(codimension, entity));
+        std::size_t gridPoint = 0;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            gridPoint += cell[i] * nodeStride[i];
+        }
+        return gridPoint * kinds.size() +
+               (std::lower_bound(kinds.begin(), kinds.end(), mask) -
+                kinds.begin());
+    };
+    struct StructuredIncidence {
+        std::size_t key;
+        std::size_t localElementIndex;
+        std::size_t localIndex;
+    };
+    auto getIncidences = [&](const std::vector<std::size_t> &kinds,
+                             std::size_t codimension,
+                             std::size_t numberOfEntities) {
+        std::vector<StructuredIncidence> incidences;
+        for (std::size_t j = 0; j < localElements.size(); ++j) {
+            for (std::size_t entity = 0; entity < numberOfEntities;
+                 ++entity) {
+                std::array<std::size_t, DIM> cell = localElements[j].cell;
+                std::size_t mask;
+                incidences.push_back(
+                    {getKey(kinds, codimension, cell,
+                            *localElements[j].corners, entity, mask),
+                     j, entity});
+            }
+        }
+        std::sort(incidences.begin(), incidences.end(),
+                  [](const StructuredIncidence &a,
+                     const StructuredIncidence &b) {
+                      return a.key < b.key ||
+                             (a.key == b.key &&
+                              a.localElementIndex < b.localElementIndex);
+                  });
+        return incidences;
+    };
+
+    // The keys are sparse, so they are not used as ids. Instead, the faces and
+    // edges in a cube are numbered by the processor that owns the cube (at the
+    // top of a non-periodic direction: the cube below), in the order of their
+    // keys. That processor has all elements that touch the cube, so it knows
+    // all faces and edges it has to number. The other processors ask it for
+    // the ids.
+    auto &communicator = MPIContainer::Instance();
+    auto getDenseIDs = [&](const std::vector<StructuredIncidence> &incidences,
+                           std::size_t numberOfKinds,
+                           std::size_t &numberOfEntities) {
+        std::vector<std::size_t> numberedKeys;
+        std::vector<std::vector<std::size_t>> requests(numberOfProcessors);
+        for (std::size_t j = 0; j < incidences.size(); ++j) {
+            const std::size_t key = incidences[j].key;
+            if (j > 0 && incidences[j - 1].key == key) continue;
+            std::array<std::size_t, DIM> cell;
+            std::size_t gridPoint = key / numberOfKinds;
+            for (std::size_t i = 0; i < DIM; ++i) {
+                cell[i] = std::min(gridPoint % numberOfNodes[i],
+                                   numberOfElements[i] - 1);
+                gridPoint /= numberOfNodes[i];
+            }
+            const std::size_t numberingProcessor = getOwner(cell);
+            if (numberingProcessor == processorID) {
+                numberedKeys.push_back(key);
+            } else {
+                requests[numberingProcessor].push_back(key);
             }
         }
-        if (!edgeIsInPartition) {
-            GlobalUniqueIndex::instance().getEdgeIndex();
+        std::vector<std::vector<std::size_t>> numberOfNumberedKeys(
+            numberOfProcessors, {numberedKeys.size()});
+        numberOfNumberedKeys = communicator.exchange(numberOfNumberedKeys);
+        std::size_t firstID = 0;
+        numberOfEntities = 0;
+        for (std::size_t i = 0; i < numberOfProcessors; ++i) {
+            if (i < processorID) firstID += numberOfNumberedKeys[i][0];
+            numberOfEntities += numberOfNumberedKeys[i][0];
         }
-    }
-
-    std::size_t lastIndex = GlobalUniqueIndex::instance().getFaceIndex();
+        std::map<std::size_t, std::size_t> ids;
+        for (std::size_t j = 0; j < numberedKeys.size(); ++j) {
+            ids[numberedKeys[j]] = firstID + j;
+        }
+        std::vector<std::vector<std::size_t>> replies(numberOfProcessors);
+        const std::vector<std::vector<std::size_t>> receivedRequests =
+            communicator.exchange(requests);
+        for (std::size_t i = 0; i < numberOfProcessors; ++i) {
+            for (std::size_t key : receivedRequests[i]) {
+                replies[i].push_back(ids.at(key));
+            }
+        }
+        replies = communicator.exchange(replies);
+        for (std::size_t i = 0; i < numberOfProcessors; ++i) {
+            for (std::size_t j = 0; j < requests[i].size(); ++j) {
+                ids[requests[i][j]] = replies[i][j];
+            }
+        }
+        return ids;
+    };
 
-    if (DIM == 1) {
-        logger.suppressWarnings([&]() {
-            for (auto node : getNodesList(Base::IteratorType::GLOBAL)) {
-                while (lastIndex++ < node->getID() - 1)
-                    GlobalUniqueIndex::instance().getFaceIndex();
-                if (node->getNumberOfElements() == 1) {
-                    addFace(node->getElement(0), node->getNodeNumber(0),
-                            nullptr, 0, Geometry::FaceType::WALL_BC);
+    const std::size_t numberOfFacesPerElement =
+        referenceGeometry->getNumberOfCodim1Entities();
+    const std::vector<std::size_t> faceKinds =
+        getKinds(1, numberOfFacesPerElement);
+    // Whether a face that only one element of this processor is adjacent to
+    // has an element on the other side. This is not the case on the boundary,
+    // but also not on a periodic boundary where the splitting of the cubes does
+    // not match, as happens with an odd number of elements in that direction.
+    auto hasOtherElement = [&](const StructuredElement &local,
+                               std::size_t face) {
+        std::array<std::size_t, DIM> cell = local.cell;
+        std::size_t mask;
+        const std::size_t key =
+            getKey(faceKinds, 1, cell, *local.corners, face, mask);
+        std::size_t top = 0;
+        for (std::size_t corner = 0; corner < (std::size_t{1} << DIM);
+             ++corner) {
+            if ((mask >> corner) & 1) top |= corner;
+        }
+        // the cubes that contain the face are the cube at its bottom and the
+        // cubes below that in the directions the face is flat in
+        for (std::size_t below = 0; below < (std::size_t{1} << DIM); ++below) {
+            if ((below & top) != 0) continue;
+            std::array<std::size_t, DIM> neighbour = cell;
+            bool exists = true;
+            for (std::size_t i = 0; i < DIM; ++i) {
+                if (((below >> i) & 1) == 0) {
+                    exists = exists && neighbour[i] < numberOfElements[i];
+                } else if (neighbour[i] > 0) {
+                    --neighbour[i];
                 } else {
-                    addFace(node->getElement(0), node->getNodeNumber(0),
-                            node->getElement(1), node->getNodeNumber(1));
+                    neighbour[i] = numberOfElements[i] - 1;
+                    exists = exists && periodic[i];
+                }
+            }
+            if (!exists) continue;
+            for (const std::vector<std::size_t> &corners :
+                 rotatedCorners[getRotation(neighbour)]) {
+                if (neighbour == local.cell && &corners == local.corners) {
+                    continue;
+                }
+                for (std::size_t otherFace = 0;
+                     otherFace < numberOfFacesPerElement; ++otherFace) {
+                    std::array<std::size_t, DIM> otherCell = neighbour;
+                    std::size_t otherMask;
+                    if (getKey(faceKinds, 1, otherCell, corners, otherFace,
+                               otherMask) == key) {
+                        return true;
+                    }
                 }
             }
+        }
+        return false;
+    };
+
+    logger.suppressWarnings([&]() {
+        getFacesList(IteratorType::GLOBAL).setPreOrderTraversal();
+        getEdgesList(IteratorType::GLOBAL).setPreOrderTraversal();
+    });
+
+    const std::size_t firstFaceID = indices.peekFaceIndex();
+    const std::vector<StructuredIncidence> faceIncidences =
+        getIncidences(faceKinds, 1, numberOfFacesPerElement);
+    std::size_t numberOfFaces;
+    const std::map<std::size_t, std::size_t> faceIDs =
+        getDenseIDs(faceIncidences, faceKinds.size(), numberOfFaces);
+    for (std::size_t j = 0; j < faceIncidences.size(); ++j) {
+        const StructuredIncidence &left = faceIncidences[j];
+        const StructuredElement &leftElement =
+            localElements[left.localElementIndex];
+        const std::size_t faceID = firstFaceID + faceIDs.at(left.key);
+        if (j + 1 < faceIncidences.size() &&
+            faceIncidences[j + 1].key == left.key) {
+            const StructuredIncidence &right = faceIncidences[++j];
+            theMesh_.addFace(leftElement.element, left.localIndex,
+                             localElements[right.localElementIndex].element,
+                             right.localIndex, Geometry::FaceType::INTERNAL,
+                             faceID);
+        } else if (hasOtherElement(leftElement, left.localIndex)) {
+            theMesh_.addFace(leftElement.element, left.localIndex, nullptr, 0,
+                             Geometry::FaceType::PARTIAL_FACE, faceID);
+        } else {
+            theMesh_.addFace(leftElement.element, left.localIndex, nullptr, 0,
+                             Geometry::FaceType::WALL_BC, faceID);
+        }
+        logger.suppressWarnings([this]() {
+            theMesh_.getSubmesh().add(
+                *(--theMesh_.getFacesList(IteratorType::GLOBAL).end()));
         });
     }
+    indices.skipToFaceIndex(firstFaceID + numberOfFaces);
 
-    for (auto pair : getPullElements()) {
-        for (Base::Element *element : pair.second) {
-            for (Base::Face *face : element->getFacesList()) {
-                if (face->isInternal()) {
-                    if (face->getFaceType() == Geometry::FaceType::INTERNAL) {
-                        face->setFaceType(
-                            Geometry::FaceType::SUBDOMAIN_BOUNDARY);
-                    } else {
-                        face->setFaceType(
-                            Geometry::FaceType::PERIODIC_SUBDOMAIN_BC);
-                    }
-                }
+    //'edges' in DIM 2 are actually nodes
+    if (DIM > 2) {
+        const std::size_t firstEdgeID = indices.peekEdgeIndex();
+        const std::size_t numberOfEdgesPerElement =
+            referenceGeometry->getNumberOfCodim2Entities();
+        const std::vector<std::size_t> edgeKinds =
+            getKinds(2, numberOfEdgesPerElement);
+        const std::vector<StructuredIncidence> edgeIncidences =
+            getIncidences(edgeKinds, 2, numberOfEdgesPerElement);
+        std::size_t numberOfEdges;
+        const std::map<std::size_t, std::size_t> edgeIDs =
+            getDenseIDs(edgeIncidences, edgeKinds.size(), numberOfEdges);
+        for (std::size_t j = 0; j < edgeIncidences.size();) {
+            const std::size_t key = edgeIncidences[j].key;
+            Edge *edge = theMesh_.addEdge(firstEdgeID + edgeIDs.at(key));
+            theMesh_.getSubmesh().add(edge);
+            for (; j < edgeIncidences.size() && edgeIncidences[j].key == key;
+                 ++j) {
+                edge->addElement(
+                    localElements[edgeIncidences[j].localElementIndex].element,
+                    edgeIncidences[j].localIndex);
             }
         }
+        indices.skipToEdgeIndex(firstEdgeID + numberOfEdges);
     }
+
+    setSubdomainBoundaryFaceTypes();
+    meshFileName_.clear();
+    numberOfElementsInFile_ = totalNumberOfCells * elementsPerCell;
+    firstElementID_ = firstElementID;
 }
 
 #ifdef HPGEM_USE_QHULL
@@ -1871,7 +4006,10 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
             nextPoint[incrementalDimension] = BottomLeft[incrementalDimension];
         }
         nextPoint[incrementalDimension] += dist;
-        if (domainDescription(nextPoint) < 0) {
+        // the fixed points come on top of the grid, so a domain that fills its
+        // bounding box would otherwise get a few nodes too many
+        if (domainDescription(nextPoint) < 0 &&
+            hpGEMCoordinates.size() < TotalNoNodes) {
             hpGEMCoordinates.push_back(nextPoint);
             theMesh_.addNode();
             theMesh_.addNodeCoordinate(nextPoint);
@@ -1916,7 +4054,7 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
                 }
                 center = center / pointIndices.size();
                 if (domainDescription(center) < 0) {
-                    auto newElement = addElement(pointIndices);
+                    auto newElement = addElement(pointIndices, 0, true);
                     for (std::size_t i = 0; i < pointIndices.size(); ++i) {
                         theMesh_
                             .getNodesList(IteratorType::GLOBAL)[pointIndices[i]]
@@ -1933,6 +4071,15 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
 
         // compute current and expected (relative) edge length
         std::vector<double> expectedLength;
+        // the expected lengths are stored by the position of the node, which
+        // differs from its (global) id if other meshes were made before
+        std::unordered_map<const Node *, std::size_t> nodePosition;
+        for (std::size_t i = 0; i < hpGEMCoordinates.size(); ++i) {
+            nodePosition[theMesh_.getNodesList(IteratorType::GLOBAL)[i]] = i;
+        }
+        auto expected = [&](const Node *node) -> double & {
+            return expectedLength[nodePosition[node]];
+        };
         std::multimap<double, std::size_t> knownLengths;
         std::vector<double> currentLength;
         // for proper scaling
@@ -1967,11 +4114,9 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
                 for (Element *element : current->getElements()) {
                     for (std::size_t i = 0; i < element->getNumberOfNodes();
                          ++i) {
-                        if (std::isnan(
-                                expectedLength[element->getNode(i)->getID()]) ||
-                            std::isinf(
-                                expectedLength[element->getNode(i)->getID()])) {
-                            expectedLength[element->getNode(i)->getID()] =
+                        if (std::isnan(expected(element->getNode(i))) ||
+                            std::isinf(expected(element->getNode(i)))) {
+                            expected(element->getNode(i)) =
                                 growFactor * entry.first;
 
                             // inserting does not invalidate the iterators;
@@ -1979,7 +4124,8 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
                             // guaranteed to be visited later on
                             knownLengths.insert(knownLengths.end(),
                                                 {growFactor * entry.first,
-                                                 element->getNode(i)->getID()});
+                                                 nodePosition[element->getNode(
+                                                     i)]});
                         }
                     }
                 }
@@ -2000,10 +4146,8 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
                     element->getPhysicalGeometry()->getLocalNodeCoordinates(1);
                 currentLength.push_back(L2Norm(firstNode - secondNode));
                 totalcurrentLength += currentLength.back();
-                totalexpectedLength +=
-                    expectedLength[element->getNode(0)->getID()] / 2;
-                totalexpectedLength +=
-                    expectedLength[element->getNode(1)->getID()] / 2;
+                totalexpectedLength += expected(element->getNode(0)) / 2;
+                totalexpectedLength += expected(element->getNode(1)) / 2;
             }
         } else if (DIM == 2) {
             for (Face *face : theMesh_.getFacesList(IteratorType::GLOBAL)) {
@@ -2023,12 +4167,10 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
                 totalcurrentLength +=
                     currentLength.back() * currentLength.back();
                 totalexpectedLength +=
-                    std::pow(expectedLength[face->getPtrElementLeft()
-                                                ->getNode(nodeIndices[0])
-                                                ->getID()] +
-                                 expectedLength[face->getPtrElementLeft()
-                                                    ->getNode(nodeIndices[1])
-                                                    ->getID()],
+                    std::pow(expected(face->getPtrElementLeft()->getNode(
+                                 nodeIndices[0])) +
+                                 expected(face->getPtrElementLeft()->getNode(
+                                     nodeIndices[1])),
                              2.) /
                     4.;
             }
@@ -2050,13 +4192,11 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
                                       currentLength.back() *
                                       currentLength.back();
                 totalexpectedLength +=
-                    std::pow(expectedLength[edge->getElement(0)
-                                                ->getNode(nodeIndices[0])
-                                                ->getID()] +
-                                 expectedLength[edge->getElement(0)
-                                                    ->getNode(nodeIndices[1])
-                                                    ->getID()],
-                             3.) /
+                    std::pow(
+                        expected(edge->getElement(0)->getNode(nodeIndices[0])) +
+                            expected(
+                                edge->getElement(0)->getNode(nodeIndices[1])),
+                        3.) /
                     8.;
             }
         }
@@ -2089,8 +4229,8 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
                 // if the algorithm is to work correctly so pretend the volume
                 // is 1.5 times as large remember to scale back from a volume
                 // measure to a length measure
-                double length = (expectedLength[element->getNode(0)->getID()] +
-                                 expectedLength[element->getNode(1)->getID()]) /
+                double length = (expected(element->getNode(0)) +
+                                 expected(element->getNode(1))) /
                                 currentLength[centerPoints.size()] * 2 *
                                 totalcurrentLength / totalexpectedLength;
                 centerPoints.insert({length, (firstNode + secondNode) / 2.});
@@ -2115,12 +4255,10 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
                 // is 1.5 times as large remember to scale back from a volume
                 // measure to a length measure
                 double length =
-                    (expectedLength[face->getPtrElementLeft()
-                                        ->getNode(nodeIndices[0])
-                                        ->getID()] +
-                     expectedLength[face->getPtrElementLeft()
-                                        ->getNode(nodeIndices[1])
-                                        ->getID()]) /
+                    (expected(
+                         face->getPtrElementLeft()->getNode(nodeIndices[0])) +
+                     expected(
+                         face->getPtrElementLeft()->getNode(nodeIndices[1]))) /
                     currentLength[centerPoints.size()] *
                     std::pow(2 * totalcurrentLength / totalexpectedLength,
                              1. / 2.);
@@ -2145,12 +4283,8 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
                 // is 1.5 times as large remember to scale back from a volume
                 // measure to a length measure
                 double length =
-                    (expectedLength[edge->getElement(0)
-                                        ->getNode(nodeIndices[0])
-                                        ->getID()] +
-                     expectedLength[edge->getElement(0)
-                                        ->getNode(nodeIndices[1])
-                                        ->getID()]) /
+                    (expected(edge->getElement(0)->getNode(nodeIndices[0])) +
+                     expected(edge->getElement(0)->getNode(nodeIndices[1]))) /
                     currentLength[centerPoints.size()] *
                     std::pow(2 * totalcurrentLength / totalexpectedLength,
                              1. / 3.);
@@ -2204,7 +4338,7 @@ void MeshManipulator<DIM>::createUnstructuredMesh(
             }
             center = center / pointIndices.size();
             if (domainDescription(center) < 0) {
-                auto newElement = addElement(pointIndices);
+                auto newElement = addElement(pointIndices, 0, true);
                 for (std::size_t i = 0; i < pointIndices.size(); ++i) {
                     theMesh_
                         .getNodesList(IteratorType::GLOBAL)[pointIndices[i]]
@@ -2243,11 +4377,19 @@ void MeshManipulator<DIM>::updateMesh(
     std::function<Geometry::PointPhysical<DIM>(Geometry::PointPhysical<DIM>)>
         safeSpot,
     std::vector<std::size_t> dontConnect) {
+    auto startTime = std::chrono::steady_clock::now();
     std::sort(fixedPointIdxs.begin(), fixedPointIdxs.end());
     bool needsExpansion = false;
     double totalCurrentLength = 0;
+    double totalexpectedLength = 0;
     double oldQuality = 0;
     double worstQuality = 0.5;
+    double maxMovement = std::numeric_limits<double>::infinity();
+    // compute how far the nodes have moved relative to the length of the
+    // edges, to see if the nodes have moved so far that a retriangulation is
+    // in order
+    double maxShift = 0;
+    std::size_t numberOfTriangulations = 0;
 
     std::set<std::pair<std::size_t, std::size_t>> periodicPairing{};
 
@@ -2292,443 +4434,210 @@ void MeshManipulator<DIM>::updateMesh(
         }
     }
 
-    // compute the lengths of the edges and how far the nodes have moved, to see
-    // if the nodes have moved so far that a retriangulation is in order
-    double maxShift = 0;
-    // except don't bother if a retriangulation is in order anyway
-    if (oldNodeLocations_.size() == theMesh_.getNodeCoordinates().size()) {
-        std::vector<double> unscaledShift{};
-        unscaledShift.reserve(theMesh_.getNumberOfNodes(IteratorType::GLOBAL));
-        // compute current and expected (relative) edge length
-        std::vector<double> expectedLength{};
-        expectedLength.reserve(theMesh_.getNumberOfNodes(IteratorType::GLOBAL));
-        std::multimap<double, std::size_t> knownLengths;
-        std::vector<double> currentLength{};
-        // for proper scaling
-        double totalexpectedLength = 0;
-        for (Node *node : theMesh_.getNodesList(IteratorType::GLOBAL)) {
-            Geometry::PointPhysical<DIM> point =
-                node->getElement(0)
-                    ->getPhysicalGeometry()
-                    ->getLocalNodeCoordinates(node->getNodeNumber(0));
-            unscaledShift.push_back(
-                L2Norm(oldNodeLocations_[expectedLength.size()] - point));
-            expectedLength.push_back(relativeEdgeLength(point));
-            if (isnan(expectedLength.back()) || isinf(expectedLength.back())) {
-                needsExpansion |= true;
-            } else {
-                knownLengths.insert(
-                    {expectedLength.back(), expectedLength.size() - 1});
-            }
-        }
-        if (needsExpansion) {
-            // iterate over all nodes, sorted by edge lengths
-            for (std::pair<double, std::size_t> entry : knownLengths) {
-                Node *current =
-                    theMesh_.getNodesList(IteratorType::GLOBAL)[entry.second];
-                for (Element *element : current->getElements()) {
-                    for (std::size_t i = 0; i < element->getNumberOfNodes();
-                         ++i) {
-                        if (std::isnan(
-                                expectedLength[element->getNode(i)->getID()]) ||
-                            std::isinf(
-                                expectedLength[element->getNode(i)->getID()])) {
-                            expectedLength[element->getNode(i)->getID()] =
-                                growFactor * entry.first;
+    // The connectivity only changes when the mesh is retriangulated, so
+    // everything the iterations need from the mesh is gathered into flat
+    // arrays once per triangulation. Nodes and springs (elements in 1D,
+    // faces in 2D and edges otherwise) are indexed by their position in the
+    // global lists of the mesh.
+    // distinct coordinate indices per node, the one seen by the first
+    // element of the node comes first; more than one means periodic
+    std::vector<std::size_t> nodeCoordinateOffsets{};
+    std::vector<std::size_t> nodeCoordinates{};
+    // nodes connected to a node by a spring
+    std::vector<std::size_t> neighbourOffsets{};
+    std::vector<std::size_t> neighbours{};
+    std::vector<std::array<std::size_t, 2>> springNodes{};
+    std::vector<std::array<std::size_t, 2>> springCoordinates{};
+    // coordinates and springs of each simplex, DIM + 1 and
+    // DIM * (DIM + 1) / 2 per element respectively
+    constexpr std::size_t springsPerElement = DIM * (DIM + 1) / 2;
+    std::vector<std::size_t> elementCoordinates{};
+    std::vector<std::size_t> elementSprings{};
+    std::vector<double> expectedLength{};
+    std::vector<double> currentLength{};
+    std::vector<Geometry::PointPhysical<DIM>> movement{};
+    std::vector<bool> isFixed{};
 
-                            // inserting does not invalidate the iterators;
-                            // new node has a larger edge length, so it is
-                            // guaranteed to be visited later on
+    // Starting a thread only pays off for a reasonable amount of springs
+    const std::size_t minimumSpringsPerThread = 4096;
+#ifdef HPGEM_USE_MPI
+    const std::size_t maximumNumberOfThreads = 1;
+#else
+    const std::size_t maximumNumberOfThreads =
+        std::max(std::thread::hardware_concurrency(), 1u);
+#endif
+    std::size_t numberOfThreads = 1;
+    // per thread contributions to the movement of the nodes
+    std::vector<std::vector<Geometry::PointPhysical<DIM>>> threadMovement{};
+    // calls work(thread, begin, end) for consecutive chunks of [0, n), each
+    // chunk in its own thread
+    auto runChunks = [&](std::size_t n,
+                         const std::function<void(std::size_t, std::size_t,
+                                                  std::size_t)> &work) {
+        std::vector<std::thread> threads;
+        for (std::size_t thread = 1; thread < numberOfThreads; ++thread) {
+            threads.emplace_back(work, thread, thread * n / numberOfThreads,
+                                 (thread + 1) * n / numberOfThreads);
+        }
+        work(0, 0, n / numberOfThreads);
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    };
 
-                            knownLengths.insert(knownLengths.end(),
-                                                {growFactor * entry.first,
-                                                 element->getNode(i)->getID()});
-                        }
-                    }
+    auto gatherTopology = [&]() {
+        std::unordered_map<const Node *, std::size_t> nodePosition;
+        std::size_t numberOfNodes =
+            theMesh_.getNumberOfNodes(IteratorType::GLOBAL);
+        nodePosition.reserve(numberOfNodes);
+        nodeCoordinateOffsets.assign(1, 0);
+        nodeCoordinates.clear();
+        for (Node *node : theMesh_.getNodesList(IteratorType::GLOBAL)) {
+            nodePosition[node] = nodeCoordinateOffsets.size() - 1;
+            std::size_t first = nodeCoordinates.size();
+            for (std::size_t i = 0; i < node->getNumberOfElements(); ++i) {
+                std::size_t coordinate =
+                    node->getElement(i)->getPhysicalGeometry()->getNodeIndex(
+                        node->getNodeNumber(i));
+                if (std::find(nodeCoordinates.begin() + first,
+                              nodeCoordinates.end(),
+                              coordinate) == nodeCoordinates.end()) {
+                    nodeCoordinates.push_back(coordinate);
                 }
             }
+            nodeCoordinateOffsets.push_back(nodeCoordinates.size());
         }
-        // iterate over all edges to compute total length and scaling factor
-        // the volume scales with (total edge length)^dimension
-        // the total volume filled by the edges should be constant
-        // so scale appropriately
+
+        springNodes.clear();
+        springCoordinates.clear();
+        auto addSpring = [&](const Element *element,
+                             std::size_t firstLocalNode,
+                             std::size_t secondLocalNode) {
+            springNodes.push_back(
+                {nodePosition[element->getNode(firstLocalNode)],
+                 nodePosition[element->getNode(secondLocalNode)]});
+            springCoordinates.push_back(
+                {element->getPhysicalGeometry()->getNodeIndex(firstLocalNode),
+                 element->getPhysicalGeometry()->getNodeIndex(
+                     secondLocalNode)});
+        };
+        // the algorithm is mostly dimension independent, but the data type
+        // it operates on is not
+        std::unordered_map<const void *, std::size_t> springPosition;
         if (DIM == 1) {
-            currentLength.reserve(
-                theMesh_.getNumberOfElements(IteratorType::GLOBAL));
-            // the algorithm is mostly dimension independent, but the data type
-            // it operates on is not
             for (Element *element :
                  theMesh_.getElementsList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
-                firstNode =
-                    element->getPhysicalGeometry()->getLocalNodeCoordinates(0);
-                secondNode =
-                    element->getPhysicalGeometry()->getLocalNodeCoordinates(1);
-                currentLength.push_back(L2Norm(firstNode - secondNode));
-                totalCurrentLength += currentLength.back();
-                totalexpectedLength +=
-                    expectedLength[element->getNode(0)->getID()] / 2;
-                totalexpectedLength +=
-                    expectedLength[element->getNode(1)->getID()] / 2;
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(firstNode -
-                           oldNodeLocations_[element->getPhysicalGeometry()
-                                                 ->getNodeIndex(0)]) /
-                        currentLength.back());
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(secondNode -
-                           oldNodeLocations_[element->getPhysicalGeometry()
-                                                 ->getNodeIndex(1)]) /
-                        currentLength.back());
+                springPosition[element] = springNodes.size();
+                addSpring(element, 0, 1);
             }
         } else if (DIM == 2) {
-            currentLength.reserve(
-                theMesh_.getNumberOfFaces(IteratorType::GLOBAL));
             for (Face *face : theMesh_.getFacesList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
                 std::vector<std::size_t> nodeIndices =
                     face->getPtrElementLeft()
                         ->getReferenceGeometry()
                         ->getCodim1EntityLocalIndices(
                             face->localFaceNumberLeft());
-                firstNode = face->getPtrElementLeft()
-                                ->getPhysicalGeometry()
-                                ->getLocalNodeCoordinates(nodeIndices[0]);
-                secondNode = face->getPtrElementLeft()
-                                 ->getPhysicalGeometry()
-                                 ->getLocalNodeCoordinates(nodeIndices[1]);
-                currentLength.push_back(L2Norm(firstNode - secondNode));
-                totalCurrentLength +=
-                    currentLength.back() * currentLength.back();
-                totalexpectedLength +=
-                    std::pow(expectedLength[face->getPtrElementLeft()
-                                                ->getNode(nodeIndices[0])
-                                                ->getID()] +
-                                 expectedLength[face->getPtrElementLeft()
-                                                    ->getNode(nodeIndices[1])
-                                                    ->getID()],
-                             2.) /
-                    4.;
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(
-                        firstNode -
-                        oldNodeLocations_[face->getPtrElementLeft()
-                                              ->getPhysicalGeometry()
-                                              ->getNodeIndex(nodeIndices[0])]) /
-                        currentLength.back());
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(
-                        secondNode -
-                        oldNodeLocations_[face->getPtrElementLeft()
-                                              ->getPhysicalGeometry()
-                                              ->getNodeIndex(nodeIndices[1])]) /
-                        currentLength.back());
-            }
-            worstQuality = 1;
-            for (Element *element :
-                 theMesh_.getElementsList(IteratorType::GLOBAL)) {
-                std::array<double, 3> edgeLengths;
-                for (std::size_t i = 0; i < 3; ++i) {
-                    edgeLengths[i] =
-                        currentLength[element->getFace(i)->getID()];
-                }
-                worstQuality = std::min(
-                    worstQuality,
-                    (edgeLengths[0] + edgeLengths[1] - edgeLengths[2]) *
-                        (edgeLengths[1] + edgeLengths[2] - edgeLengths[0]) *
-                        (edgeLengths[2] + edgeLengths[0] - edgeLengths[1]) /
-                        edgeLengths[0] / edgeLengths[1] / edgeLengths[2]);
+                springPosition[face] = springNodes.size();
+                addSpring(face->getPtrElementLeft(), nodeIndices[0],
+                          nodeIndices[1]);
             }
         } else {
-            currentLength.reserve(
-                theMesh_.getNumberOfEdges(IteratorType::GLOBAL));
             for (Edge *edge : theMesh_.getEdgesList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
                 std::vector<std::size_t> nodeIndices =
                     edge->getElement(0)
                         ->getReferenceGeometry()
                         ->getCodim2EntityLocalIndices(edge->getEdgeNumber(0));
-                firstNode = edge->getElement(0)
-                                ->getPhysicalGeometry()
-                                ->getLocalNodeCoordinates(nodeIndices[0]);
-                secondNode = edge->getElement(0)
-                                 ->getPhysicalGeometry()
-                                 ->getLocalNodeCoordinates(nodeIndices[1]);
-                currentLength.push_back(L2Norm(firstNode - secondNode));
-                totalCurrentLength += currentLength.back() *
-                                      currentLength.back() *
-                                      currentLength.back();
-                totalexpectedLength +=
-                    std::pow(expectedLength[edge->getElement(0)
-                                                ->getNode(nodeIndices[0])
-                                                ->getID()] +
-                                 expectedLength[edge->getElement(0)
-                                                    ->getNode(nodeIndices[1])
-                                                    ->getID()],
-                             3.) /
-                    8.;
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(
-                        firstNode -
-                        oldNodeLocations_[edge->getElement(0)
-                                              ->getPhysicalGeometry()
-                                              ->getNodeIndex(nodeIndices[0])]) /
-                        currentLength.back());
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(
-                        secondNode -
-                        oldNodeLocations_[edge->getElement(0)
-                                              ->getPhysicalGeometry()
-                                              ->getNodeIndex(nodeIndices[1])]) /
-                        currentLength.back());
+                springPosition[edge] = springNodes.size();
+                addSpring(edge->getElement(0), nodeIndices[0], nodeIndices[1]);
             }
         }
 
-        // all regions of the domain where elements are allowed to be as large
-        // as possible must be connected to regions where relativeEdgeLength
-        // provides a limitation
-        logger.assert_debug(
-            !std::isnan(totalexpectedLength) &&
-                !std::isinf(totalexpectedLength),
-            "Could not infer edge sizes for the entirety of the domain");
-    }
-    std::size_t counter = 0;
-    double maxMovement = std::numeric_limits<double>::infinity();
-    std::map<size_t, double> currentLength{};
-    std::map<std::size_t, Geometry::PointPhysical<DIM>> movement;
-    // stop after n iterations, or (when the nodes have stopped moving and the
-    // mesh is not becoming worse), or when the mesh is great, or when the mesh
-    // is decent, but worsening
-    while ((counter < 10000 &&
-            (maxMovement > 1e-3 || oldQuality - worstQuality > 1e-3) &&
-            worstQuality < 0.8 &&
-            (worstQuality < 2. / 3. || oldQuality - worstQuality < 0)) ||
-           counter < 5) {
-        counter++;
-        if ((maxShift > 0.1 && (oldQuality - worstQuality) < 5e-3 * maxShift) ||
-            (oldNodeLocations_.size() !=
-             theMesh_.getNumberOfNodeCoordinates()) ||
-            worstQuality < 1e-6) {
-            maxShift = 0;
-
-            orgQhull::RboxPoints qHullCoordinates{};
-            qHullCoordinates.setDimension(DIM);
-            oldNodeLocations_.clear();
-            oldNodeLocations_.reserve(theMesh_.getNumberOfNodeCoordinates());
-            for (Geometry::PointPhysical<DIM> &point :
-                 theMesh_.getNodeCoordinates()) {
-                oldNodeLocations_.push_back(point);
-            }
-            theMesh_.clear();
-            auto pairingIterator = periodicPairing.begin();
-            for (Geometry::PointPhysical<DIM> point : oldNodeLocations_) {
-                theMesh_.addNodeCoordinate(point);
-                if (pairingIterator == periodicPairing.end()) {
-                    theMesh_.addNode();
+        elementCoordinates.clear();
+        elementSprings.clear();
+        for (Element *element :
+             theMesh_.getElementsList(IteratorType::GLOBAL)) {
+            for (std::size_t i = 0; i < DIM + 1; ++i) {
+                elementCoordinates.push_back(
+                    element->getPhysicalGeometry()->getNodeIndex(i));
+            }
+            for (std::size_t i = 0; i < springsPerElement; ++i) {
+                if (DIM == 1) {
+                    elementSprings.push_back(springPosition[element]);
+                } else if (DIM == 2) {
+                    elementSprings.push_back(
+                        springPosition[element->getFace(i)]);
                 } else {
-                    // skip one insertion for each master/slave pair
-                    pairingIterator++;
+                    elementSprings.push_back(
+                        springPosition[element->getEdge(i)]);
                 }
             }
+        }
 
-            std::vector<std::size_t> vertexIndex{};
-            vertexIndex.resize(theMesh_.getNumberOfNodeCoordinates(),
-                               std::numeric_limits<std::size_t>::max());
-            pairingIterator = periodicPairing.begin();
-            std::size_t currentNodeNumber = 0;
-            for (std::size_t i = 0;
-                 i < theMesh_.getNumberOfNodeCoordinates();) {
-                vertexIndex[i] = currentNodeNumber;
-                // see if there are any new boundary nodes
-                if (isOnPeriodic(theMesh_.getNodeCoordinates()[i]) &&
-                    !(pairingIterator != periodicPairing.end() &&
-                      pairingIterator->first == i)) {
-                    std::size_t j = pairingIterator->first;
-                    periodicPairing.insert(
-                        {i, theMesh_.getNumberOfNodeCoordinates()});
-                    logger(DEBUG, "periodic pair: % % ", i,
-                           theMesh_.getNumberOfNodeCoordinates());
-                    pairingIterator = std::find_if(
-                        periodicPairing.begin(), periodicPairing.end(),
-                        [=](const std::pair<std::size_t, std::size_t> &p)
-                            -> bool { return p.first == std::min(i, j); });
-                    Geometry::PointPhysical<DIM> newNodeCoordinate =
-                        duplicatePeriodic(theMesh_.getNodeCoordinates()[i]);
-                    logger(DEBUG, "new periodic pair coordinates: % %",
-                           theMesh_.getNodeCoordinates()[i], newNodeCoordinate);
-                    theMesh_.addNodeCoordinate(newNodeCoordinate);
-                    oldNodeLocations_.push_back(newNodeCoordinate);
-                    vertexIndex.resize(theMesh_.getNumberOfNodeCoordinates(),
-                                       std::numeric_limits<std::size_t>::max());
-                }
-                // see if there are any non-boundary nodes that slipped into the
-                // boundary
-                if (isOnOtherPeriodic(theMesh_.getNodeCoordinates()[i]) &&
-                    !(pairingIterator != periodicPairing.end() &&
-                      pairingIterator->first == i)) {
-                    theMesh_.getNodeCoordinates()[i] =
-                        safeSpot(theMesh_.getNodeCoordinates()[i]);
-                }
-                // assign boundary nodes
-                while (pairingIterator != periodicPairing.end() &&
-                       pairingIterator->first == i) {
-                    logger(DEBUG, "periodic pair: % % ", pairingIterator->first,
-                           pairingIterator->second);
-                    logger.assert_debug(
-                        Base::L2Norm(
-                            duplicatePeriodic(
-                                theMesh_.getNodeCoordinates()[pairingIterator
-                                                                  ->first]) -
-                            theMesh_.getNodeCoordinates()[pairingIterator
-                                                              ->second]) < 1e-9,
-                        "periodic pair is not moving simulateously");
-                    vertexIndex[pairingIterator->second] = currentNodeNumber;
-                    ++pairingIterator;
-                }
-                currentNodeNumber++;
-                // skip over already set boundary nodes
-                while (i < theMesh_.getNumberOfNodeCoordinates() &&
-                       vertexIndex[i] <
-                           std::numeric_limits<std::size_t>::max()) {
-                    ++i;
-                }
-            }
-            logger(DEBUG, "periodic pairs end");
-
-            // all periodic boundary pairs are used
-            logger.assert_debug(pairingIterator == periodicPairing.end(),
-                                "Somehow missed some periodic pair");
-            // the actual amount of vertices and the assigned amount of vertices
-            // match
-            logger.assert_debug(currentNodeNumber == theMesh_.getNumberOfNodes(
-                                                         IteratorType::GLOBAL),
-                                "Missed some node indexes");
-
-            qHullCoordinates.reserveCoordinates(
-                DIM * theMesh_.getNumberOfNodeCoordinates());
-            for (Geometry::PointPhysical<DIM> &point :
-                 theMesh_.getNodeCoordinates()) {
-                qHullCoordinates.append(DIM, point.data());
-            }
-
-            orgQhull::Qhull triangulation(qHullCoordinates,
-                                          "d PF1e-10 QbB Qx Qc Qt");
-
-            for (orgQhull::QhullFacet triangle : triangulation.facetList()) {
-                if (triangle.isGood() && !triangle.isUpperDelaunay()) {
-                    logger(DEBUG, "adding %", triangle);
-                    Geometry::PointPhysical<DIM> center;
-                    std::vector<std::size_t> pointIndices{};
-                    bool shouldConnect = false;
-                    for (auto vertexIt1 = triangle.vertices().begin();
-                         vertexIt1 != triangle.vertices().end(); ++vertexIt1) {
-                        logger.assert_debug(
-                            (*vertexIt1).point().id() >= 0,
-                            "QHull breaks our assumptions on indexes");
-                        logger(DEBUG, "% % %", shouldConnect,
-                               vertexIndex[(*vertexIt1).point().id()],
-                               *vertexIt1);
-                        center += oldNodeLocations_[(*vertexIt1).point().id()];
-                        pointIndices.push_back((*vertexIt1).point().id());
-                        shouldConnect |=
-                            (std::find(
-                                 dontConnect.begin(), dontConnect.end(),
-                                 vertexIndex[(*vertexIt1).point().id()]) ==
-                             dontConnect.end());
-                    }
-                    center = center / pointIndices.size();
-                    if (domainDescription(center) < -1e-10 && shouldConnect) {
-                        auto newElement = addElement(pointIndices);
-                        for (std::size_t i = 0; i < pointIndices.size(); ++i) {
-                            theMesh_
-                                .getNodesList(IteratorType::GLOBAL)
-                                    [vertexIndex[pointIndices[i]]]
-                                ->addElement(newElement, i);
-                        }
-                    } else {
-                        logger(VERBOSE, "external element % ignored", triangle);
-                    }
-                }
-                if (!triangle.isGood() && !triangle.isUpperDelaunay()) {
-                    logger(VERBOSE, "small element % ignored", triangle);
-                }
-            }
-            for (Node *node : theMesh_.getNodesList(IteratorType::GLOBAL)) {
-                // all of the nodes should be in the interior of the domain or
-                // near the boundary of the domain
-                if (node->getNumberOfElements() == 0) {
-                    for (std::size_t i = 0; i < vertexIndex.size(); ++i) {
-                        if (vertexIndex[i] == node->getID()) {
-                            logger(DEBUG, "% % %", i,
-                                   theMesh_.getNodeCoordinates()[i],
-                                   domainDescription(
-                                       theMesh_.getNodeCoordinates()[i]));
-                        }
-                    }
-                }
-                logger.assert_debug(
-                    node->getNumberOfElements() > 0,
-                    "There is an node without any elements connected to it");
+        // in a simplex mesh, the nodes that share an element with a node are
+        // exactly the nodes that share a spring with it
+        neighbourOffsets.assign(numberOfNodes + 1, 0);
+        for (const std::array<std::size_t, 2> &spring : springNodes) {
+            neighbourOffsets[spring[0] + 1]++;
+            neighbourOffsets[spring[1] + 1]++;
+        }
+        std::partial_sum(neighbourOffsets.begin(), neighbourOffsets.end(),
+                         neighbourOffsets.begin());
+        neighbours.resize(neighbourOffsets.back());
+        std::vector<std::size_t> fill(neighbourOffsets.begin(),
+                                      neighbourOffsets.end() - 1);
+        for (const std::array<std::size_t, 2> &spring : springNodes) {
+            neighbours[fill[spring[0]]++] = spring[1];
+            neighbours[fill[spring[1]]++] = spring[0];
+        }
+
+        isFixed.assign(numberOfNodes, false);
+        for (std::size_t index : fixedPointIdxs) {
+            if (index < numberOfNodes) {
+                isFixed[index] = true;
             }
-            edgeFactory();
-            faceFactory();
         }
-        oldQuality = worstQuality;
+        expectedLength.resize(numberOfNodes);
+        currentLength.resize(springNodes.size());
+        movement.resize(numberOfNodes);
+        numberOfThreads = std::max<std::size_t>(
+            1, std::min(maximumNumberOfThreads,
+                        springNodes.size() / minimumSpringsPerThread));
+        threadMovement.resize(numberOfThreads);
+        for (auto &partialMovement : threadMovement) {
+            partialMovement.resize(numberOfNodes);
+        }
+    };
 
-        std::map<std::size_t, double> expectedLength{};
+    // compute current and expected (relative) edge length
+    auto computeLengths = [&]() {
+        const std::vector<Geometry::PointPhysical<DIM>> &coordinates =
+            theMesh_.getNodeCoordinates();
         std::multimap<double, std::size_t> knownLengths{};
-        // for proper scaling
-        totalCurrentLength = 0;
-        double totalexpectedLength = 0.;
-        for (Node *node : theMesh_.getNodesList(IteratorType::GLOBAL)) {
-            Geometry::PointPhysical<DIM> point =
-                node->getElement(0)
-                    ->getPhysicalGeometry()
-                    ->getLocalNodeCoordinates(node->getNodeNumber(0));
-            expectedLength[node->getID()] = relativeEdgeLength(point);
-            if (!isnan(expectedLength[node->getID()]) &&
-                !isinf(expectedLength[node->getID()])) {
-                knownLengths.insert(
-                    {expectedLength[node->getID()], expectedLength.size() - 1});
-            } else {
+        for (std::size_t i = 0; i < expectedLength.size(); ++i) {
+            expectedLength[i] = relativeEdgeLength(
+                coordinates[nodeCoordinates[nodeCoordinateOffsets[i]]]);
+            if (std::isnan(expectedLength[i]) || std::isinf(expectedLength[i])) {
                 needsExpansion |= true;
+            } else {
+                knownLengths.insert({expectedLength[i], i});
             }
         }
         if (needsExpansion) {
             // iterate over all nodes, sorted by edge lengths
             for (std::pair<double, std::size_t> entry : knownLengths) {
-                Node *current =
-                    theMesh_.getNodesList(IteratorType::GLOBAL)[entry.second];
-                for (Element *element : current->getElements()) {
-                    for (std::size_t i = 0; i < element->getNumberOfNodes();
-                         ++i) {
-                        if (std::isnan(
-                                expectedLength[element->getNode(i)->getID()]) ||
-                            std::isinf(
-                                expectedLength[element->getNode(i)->getID()])) {
-                            expectedLength[element->getNode(i)->getID()] =
-                                growFactor * entry.first;
+                for (std::size_t j = neighbourOffsets[entry.second];
+                     j < neighbourOffsets[entry.second + 1]; ++j) {
+                    std::size_t neighbour = neighbours[j];
+                    if (std::isnan(expectedLength[neighbour]) ||
+                        std::isinf(expectedLength[neighbour])) {
+                        expectedLength[neighbour] = growFactor * entry.first;
 
-                            // inserting does not invalidate the iterators;
-                            // new node has a larger edge length, so it is
-                            // guaranteed to be visited later on
-
-                            knownLengths.insert(
-                                knownLengths.end(),
-                                {growFactor * entry.first,
-                                 std::find(
-                                     getNodesList(IteratorType::GLOBAL).begin(),
-                                     getNodesList(IteratorType::GLOBAL).end(),
-                                     element->getNode(i)) -
-                                     getNodesList(IteratorType::GLOBAL)
-                                         .begin()});
-                        }
+                        // inserting does not invalidate the iterators;
+                        // new node has a larger edge length, so it is
+                        // guaranteed to be visited later on
+                        knownLengths.insert(knownLengths.end(),
+                                            {growFactor * entry.first,
+                                             neighbour});
                     }
                 }
             }
@@ -2738,234 +4647,434 @@ void MeshManipulator<DIM>::updateMesh(
         // the volume scales with (total edge length)^dimension
         // the total volume filled by the edges should be constant
         // so scale appropriately
-        totalCurrentLength = 0;
-        totalexpectedLength = 0;
+        std::vector<double> partialCurrent(numberOfThreads, 0.);
+        std::vector<double> partialExpected(numberOfThreads, 0.);
+        runChunks(springNodes.size(), [&](std::size_t thread,
+                                          std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                currentLength[i] =
+                    L2Norm(coordinates[springCoordinates[i][0]] -
+                           coordinates[springCoordinates[i][1]]);
+                partialCurrent[thread] += std::pow(currentLength[i], DIM);
+                partialExpected[thread] +=
+                    std::pow((expectedLength[springNodes[i][0]] +
+                              expectedLength[springNodes[i][1]]) /
+                                 2.,
+                             DIM);
+            }
+        });
+        totalCurrentLength = std::accumulate(partialCurrent.begin(),
+                                             partialCurrent.end(), 0.);
+        totalexpectedLength = std::accumulate(partialExpected.begin(),
+                                              partialExpected.end(), 0.);
+
+        // all regions of the domain where elements are allowed to be as large
+        // as possible must be connected to regions where relativeEdgeLength
+        // provides a limitation
+        logger.assert_debug(
+            !std::isnan(totalexpectedLength) &&
+                !std::isinf(totalexpectedLength),
+            "Could not infer edge sizes for the entirety of the domain");
+    };
+
+    auto computeQuality = [&]() {
+        const std::vector<Geometry::PointPhysical<DIM>> &coordinates =
+            theMesh_.getNodeCoordinates();
         if (DIM == 1) {
-            // the algorithm is mostly dimension independent, but the data type
-            // it operates on is not
-            for (Element *element :
-                 theMesh_.getElementsList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
-                firstNode =
-                    element->getPhysicalGeometry()->getLocalNodeCoordinates(0);
-                secondNode =
-                    element->getPhysicalGeometry()->getLocalNodeCoordinates(1);
-                currentLength[element->getID()] =
-                    L2Norm(firstNode - secondNode);
-                totalCurrentLength += currentLength[element->getID()];
-                totalexpectedLength +=
-                    expectedLength[element->getNode(0)->getID()] / 2.;
-                totalexpectedLength +=
-                    expectedLength[element->getNode(1)->getID()] / 2.;
+            // quality measure is not an issue in 1D just create a mesh with the
+            // proper lengths
+            worstQuality = 0.5;
+            return;
+        }
+        std::size_t numberOfElements = elementSprings.size() / springsPerElement;
+        std::vector<double> partialQuality(numberOfThreads, 1.);
+        runChunks(numberOfElements, [&](std::size_t thread, std::size_t begin,
+                                        std::size_t end) {
+            std::array<double, springsPerElement> edgeLengths{};
+            for (std::size_t element = begin; element < end; ++element) {
+                for (std::size_t i = 0; i < springsPerElement; ++i) {
+                    edgeLengths[i] = currentLength
+                        [elementSprings[element * springsPerElement + i]];
+                }
+                double quality;
+                if (DIM == 2) {
+                    // ratio between incircle and circumcircle (scaled so
+                    // equilateral is quality 1 and reference is quality ~.8)
+                    quality =
+                        (edgeLengths[0] + edgeLengths[1] - edgeLengths[2]) *
+                        (edgeLengths[1] + edgeLengths[2] - edgeLengths[0]) *
+                        (edgeLengths[2] + edgeLengths[0] - edgeLengths[1]) /
+                        edgeLengths[0] / edgeLengths[1] / edgeLengths[2];
+                } else {
+                    // ratio between volume and cubed average edge length
+                    // (scaled so equilateral is quality 1 and reference is
+                    // quality ~.8)
+                    double average = std::accumulate(edgeLengths.begin(),
+                                                     edgeLengths.end(), 0.) /
+                                     springsPerElement;
+                    const std::size_t *corners =
+                        &elementCoordinates[element * (DIM + 1)];
+                    std::array<LinearAlgebra::SmallVector<DIM>, DIM> sides;
+                    for (std::size_t i = 0; i < DIM; ++i) {
+                        sides[i] = (coordinates[corners[i + 1]] -
+                                    coordinates[corners[0]])
+                                       .getCoordinates();
+                    }
+                    quality =
+                        std::abs(LinearAlgebra::SmallMatrix<DIM, DIM>(sides)
+                                     .determinant()) /
+                        std::pow(average, DIM) * std::sqrt(2);
+                }
+                partialQuality[thread] =
+                    std::min(partialQuality[thread], quality);
             }
-        } else if (DIM == 2) {
-            for (Face *face : theMesh_.getFacesList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
-                std::vector<std::size_t> nodeIndices =
-                    face->getPtrElementLeft()
-                        ->getReferenceGeometry()
-                        ->getCodim1EntityLocalIndices(
-                            face->localFaceNumberLeft());
-                firstNode = face->getPtrElementLeft()
-                                ->getPhysicalGeometry()
-                                ->getLocalNodeCoordinates(nodeIndices[0]);
-                secondNode = face->getPtrElementLeft()
-                                 ->getPhysicalGeometry()
-                                 ->getLocalNodeCoordinates(nodeIndices[1]);
-                currentLength[face->getID()] = L2Norm(firstNode - secondNode);
-                totalCurrentLength +=
-                    currentLength[face->getID()] * currentLength[face->getID()];
-                totalexpectedLength +=
-                    std::pow(expectedLength[face->getPtrElementLeft()
-                                                ->getNode(nodeIndices[0])
-                                                ->getID()] +
-                                 expectedLength[face->getPtrElementLeft()
-                                                    ->getNode(nodeIndices[1])
-                                                    ->getID()],
-                             2.) /
-                    4.;
+        });
+        worstQuality = *std::min_element(partialQuality.begin(),
+                                         partialQuality.end());
+    };
+
+    // largest distance a node has moved since the last triangulation,
+    // relative to the length of the springs attached to it
+    auto computeShift = [&]() {
+        const std::vector<Geometry::PointPhysical<DIM>> &coordinates =
+            theMesh_.getNodeCoordinates();
+        std::vector<double> partialShift(numberOfThreads, 0.);
+        runChunks(springNodes.size(), [&](std::size_t thread,
+                                          std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                for (std::size_t coordinate : springCoordinates[i]) {
+                    partialShift[thread] =
+                        std::max(partialShift[thread],
+                                 L2Norm(coordinates[coordinate] -
+                                        oldNodeLocations_[coordinate]) /
+                                     currentLength[i]);
+                }
+            }
+        });
+        maxShift = std::max(
+            maxShift, *std::max_element(partialShift.begin(), partialShift.end()));
+    };
+
+    auto retriangulate = [&]() {
+        maxShift = 0;
+        numberOfTriangulations++;
+
+        orgQhull::RboxPoints qHullCoordinates{};
+        qHullCoordinates.setDimension(DIM);
+        oldNodeLocations_ = theMesh_.getNodeCoordinates();
+        std::size_t numberOfNodes =
+            theMesh_.getNumberOfNodes(IteratorType::GLOBAL);
+
+        std::vector<std::size_t> vertexIndex{};
+        vertexIndex.resize(theMesh_.getNumberOfNodeCoordinates(),
+                           std::numeric_limits<std::size_t>::max());
+        auto pairingIterator = periodicPairing.begin();
+        std::size_t currentNodeNumber = 0;
+        for (std::size_t i = 0; i < theMesh_.getNumberOfNodeCoordinates();) {
+            vertexIndex[i] = currentNodeNumber;
+            // see if there are any new boundary nodes
+            if (isOnPeriodic(theMesh_.getNodeCoordinates()[i]) &&
+                !(pairingIterator != periodicPairing.end() &&
+                  pairingIterator->first == i)) {
+                std::size_t j = pairingIterator->first;
+                periodicPairing.insert(
+                    {i, theMesh_.getNumberOfNodeCoordinates()});
+                logger(DEBUG, "periodic pair: % % ", i,
+                       theMesh_.getNumberOfNodeCoordinates());
+                pairingIterator = std::find_if(
+                    periodicPairing.begin(), periodicPairing.end(),
+                    [=](const std::pair<std::size_t, std::size_t> &p) -> bool {
+                        return p.first == std::min(i, j);
+                    });
+                Geometry::PointPhysical<DIM> newNodeCoordinate =
+                    duplicatePeriodic(theMesh_.getNodeCoordinates()[i]);
+                logger(DEBUG, "new periodic pair coordinates: % %",
+                       theMesh_.getNodeCoordinates()[i], newNodeCoordinate);
+                theMesh_.addNodeCoordinate(newNodeCoordinate);
+                oldNodeLocations_.push_back(newNodeCoordinate);
+                vertexIndex.resize(theMesh_.getNumberOfNodeCoordinates(),
+                                   std::numeric_limits<std::size_t>::max());
+            }
+            // see if there are any non-boundary nodes that slipped into the
+            // boundary
+            if (isOnOtherPeriodic(theMesh_.getNodeCoordinates()[i]) &&
+                !(pairingIterator != periodicPairing.end() &&
+                  pairingIterator->first == i)) {
+                theMesh_.getNodeCoordinates()[i] =
+                    safeSpot(theMesh_.getNodeCoordinates()[i]);
+            }
+            // assign boundary nodes
+            while (pairingIterator != periodicPairing.end() &&
+                   pairingIterator->first == i) {
+                logger(DEBUG, "periodic pair: % % ", pairingIterator->first,
+                       pairingIterator->second);
+                logger.assert_debug(
+                    Base::L2Norm(
+                        duplicatePeriodic(
+                            theMesh_.getNodeCoordinates()[pairingIterator
+                                                              ->first]) -
+                        theMesh_.getNodeCoordinates()[pairingIterator
+                                                          ->second]) < 1e-9,
+                    "periodic pair is not moving simulateously");
+                vertexIndex[pairingIterator->second] = currentNodeNumber;
+                ++pairingIterator;
+            }
+            currentNodeNumber++;
+            // skip over already set boundary nodes
+            while (i < theMesh_.getNumberOfNodeCoordinates() &&
+                   vertexIndex[i] < std::numeric_limits<std::size_t>::max()) {
+                ++i;
+            }
+        }
+        logger(DEBUG, "periodic pairs end");
+
+        // all periodic boundary pairs are used
+        logger.assert_debug(pairingIterator == periodicPairing.end(),
+                            "Somehow missed some periodic pair");
+        // the actual amount of vertices and the assigned amount of vertices
+        // match
+        logger.assert_debug(currentNodeNumber == numberOfNodes,
+                            "Missed some node indexes");
+
+        qHullCoordinates.reserveCoordinates(
+            DIM * theMesh_.getNumberOfNodeCoordinates());
+        for (Geometry::PointPhysical<DIM> &point :
+             theMesh_.getNodeCoordinates()) {
+            qHullCoordinates.append(DIM, point.data());
+        }
+
+        orgQhull::Qhull triangulation(qHullCoordinates,
+                                      "d PF1e-10 QbB Qx Qc Qt");
+
+        std::vector<std::vector<std::size_t>> newElements{};
+        for (orgQhull::QhullFacet triangle : triangulation.facetList()) {
+            if (triangle.isGood() && !triangle.isUpperDelaunay()) {
+                logger(DEBUG, "adding %", triangle);
+                Geometry::PointPhysical<DIM> center;
+                std::vector<std::size_t> pointIndices{};
+                bool shouldConnect = false;
+                for (auto vertexIt1 = triangle.vertices().begin();
+                     vertexIt1 != triangle.vertices().end(); ++vertexIt1) {
+                    logger.assert_debug(
+                        (*vertexIt1).point().id() >= 0,
+                        "QHull breaks our assumptions on indexes");
+                    logger(DEBUG, "% % %", shouldConnect,
+                           vertexIndex[(*vertexIt1).point().id()],
+                           *vertexIt1);
+                    center += oldNodeLocations_[(*vertexIt1).point().id()];
+                    pointIndices.push_back((*vertexIt1).point().id());
+                    shouldConnect |=
+                        (std::find(dontConnect.begin(), dontConnect.end(),
+                                   vertexIndex[(*vertexIt1).point().id()]) ==
+                         dontConnect.end());
+                }
+                center = center / pointIndices.size();
+                if (domainDescription(center) < -1e-10 && shouldConnect) {
+                    newElements.push_back(pointIndices);
+                } else {
+                    logger(VERBOSE, "external element % ignored", triangle);
+                }
             }
-        } else {
-            for (Edge *edge : theMesh_.getEdgesList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
-                std::vector<std::size_t> nodeIndices =
-                    edge->getElement(0)
-                        ->getReferenceGeometry()
-                        ->getCodim2EntityLocalIndices(edge->getEdgeNumber(0));
-                firstNode = edge->getElement(0)
-                                ->getPhysicalGeometry()
-                                ->getLocalNodeCoordinates(nodeIndices[0]);
-                secondNode = edge->getElement(0)
-                                 ->getPhysicalGeometry()
-                                 ->getLocalNodeCoordinates(nodeIndices[1]);
-                currentLength[edge->getID()] = L2Norm(firstNode - secondNode);
-                totalCurrentLength += currentLength[edge->getID()] *
-                                      currentLength[edge->getID()] *
-                                      currentLength[edge->getID()];
-                totalexpectedLength +=
-                    std::pow(expectedLength[edge->getElement(0)
-                                                ->getNode(nodeIndices[0])
-                                                ->getID()] +
-                                 expectedLength[edge->getElement(0)
-                                                    ->getNode(nodeIndices[1])
-                                                    ->getID()],
-                             3.) /
-                    8.;
+            if (!triangle.isGood() && !triangle.isUpperDelaunay()) {
+                logger(VERBOSE, "small element % ignored", triangle);
             }
         }
 
-        movement.clear();
+        // Moving nodes only rarely flips more than a few elements, so the
+        // mesh is only rebuilt if the triangulation actually differs from the
+        // current one. Without new periodic nodes, the coordinates of the
+        // elements fully determine the connectivity.
+        std::vector<std::vector<std::size_t>> oldSimplices{};
+        std::vector<std::vector<std::size_t>> newSimplices = newElements;
+        for (std::vector<std::size_t> &simplex : newSimplices) {
+            std::sort(simplex.begin(), simplex.end());
+        }
+        std::sort(newSimplices.begin(), newSimplices.end());
+        for (Element *element :
+             theMesh_.getElementsList(IteratorType::GLOBAL)) {
+            oldSimplices.emplace_back();
+            for (std::size_t i = 0; i < element->getNumberOfNodes(); ++i) {
+                oldSimplices.back().push_back(
+                    element->getPhysicalGeometry()->getNodeIndex(i));
+            }
+            std::sort(oldSimplices.back().begin(), oldSimplices.back().end());
+        }
+        std::sort(oldSimplices.begin(), oldSimplices.end());
+        std::vector<std::vector<std::size_t>> changedSimplices{};
+        std::set_difference(newSimplices.begin(), newSimplices.end(),
+                            oldSimplices.begin(), oldSimplices.end(),
+                            std::back_inserter(changedSimplices));
+        if (changedSimplices.empty() &&
+            newSimplices.size() == oldSimplices.size() &&
+            oldNodeLocations_.size() == theMesh_.getNumberOfNodeCoordinates()) {
+            logger(VERBOSE, "Retriangulation did not change the connectivity");
+            if (nodeCoordinateOffsets.empty()) {
+                gatherTopology();
+            }
+            return;
+        }
+        logger(VERBOSE, "Retriangulation changed % of % elements",
+               changedSimplices.size(), newSimplices.size());
 
-        if (DIM == 1) {
-            for (Element *element :
-                 theMesh_.getElementsList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
-                firstNode =
-                    element->getPhysicalGeometry()->getLocalNodeCoordinates(0);
-                secondNode =
-                    element->getPhysicalGeometry()->getLocalNodeCoordinates(1);
-                // it is impossible to detect if a node inside the domain should
-                // be clipped to the edge instead make sure that the nodes that
-                // DO belong dont get pulled into the interior roundoff error
-                // should make sure that nodes move away from the boundary if
-                // there are too many all edges should be squeezed a little if
-                // the algorithm is to work correctly so pretend the volume
-                // is 1.4 times as large remember to scale back from a volume
-                // measure to a length measure the non-linearity makes
-                // everything slightly more robust
-                double length = (expectedLength[element->getNode(0)->getID()] +
-                                 expectedLength[element->getNode(1)->getID()]) /
-                                currentLength[element->getID()] * 1.4 *
-                                totalCurrentLength / totalexpectedLength / 2.;
-                movement[element->getNode(0)->getID()] +=
-                    std::max(length - 1., 0.) * (firstNode - secondNode) *
-                    (length + 1.) * 0.5;
-                movement[element->getNode(1)->getID()] +=
-                    std::max(length - 1., 0.) * (secondNode - firstNode) *
-                    (length + 1.) * 0.5;
+        std::vector<Geometry::PointPhysical<DIM>> coordinates =
+            theMesh_.getNodeCoordinates();
+        theMesh_.clear();
+        for (Geometry::PointPhysical<DIM> &point : coordinates) {
+            theMesh_.addNodeCoordinate(point);
+        }
+        for (std::size_t i = 0; i < numberOfNodes; ++i) {
+            theMesh_.addNode();
+        }
+        for (std::vector<std::size_t> &pointIndices : newElements) {
+            auto newElement = addElement(pointIndices, 0, true);
+            for (std::size_t i = 0; i < pointIndices.size(); ++i) {
+                theMesh_
+                    .getNodesList(
+                        IteratorType::GLOBAL)[vertexIndex[pointIndices[i]]]
+                    ->addElement(newElement, i);
             }
-        } else if (DIM == 2) {
-            for (Face *face : theMesh_.getFacesList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
-                std::vector<std::size_t> nodeIndices =
-                    face->getPtrElementLeft()
-                        ->getReferenceGeometry()
-                        ->getCodim1EntityLocalIndices(
-                            face->localFaceNumberLeft());
-                firstNode = face->getPtrElementLeft()
-                                ->getPhysicalGeometry()
-                                ->getLocalNodeCoordinates(nodeIndices[0]);
-                secondNode = face->getPtrElementLeft()
-                                 ->getPhysicalGeometry()
-                                 ->getLocalNodeCoordinates(nodeIndices[1]);
-                double length =
-                    (expectedLength[face->getPtrElementLeft()
-                                        ->getNode(nodeIndices[0])
-                                        ->getID()] +
-                     expectedLength[face->getPtrElementLeft()
-                                        ->getNode(nodeIndices[1])
-                                        ->getID()]) /
-                    currentLength[face->getID()] *
-                    std::pow(1.4 * totalCurrentLength / totalexpectedLength,
-                             1. / 2.) /
-                    2.;
-                movement[face->getPtrElementLeft()
-                             ->getNode(nodeIndices[0])
-                             ->getID()] += std::max(length - 1., 0.) *
-                                           (firstNode - secondNode) *
-                                           (length + 1.) * 0.5;
-                movement[face->getPtrElementLeft()
-                             ->getNode(nodeIndices[1])
-                             ->getID()] += std::max(length - 1., 0.) *
-                                           (secondNode - firstNode) *
-                                           (length + 1.) * 0.5;
-            }
-        } else if (DIM == 3) {
-            for (Edge *edge : theMesh_.getEdgesList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
-                std::vector<std::size_t> nodeIndices =
-                    edge->getElement(0)
-                        ->getReferenceGeometry()
-                        ->getCodim2EntityLocalIndices(edge->getEdgeNumber(0));
-                firstNode = edge->getElement(0)
-                                ->getPhysicalGeometry()
-                                ->getLocalNodeCoordinates(nodeIndices[0]);
-                secondNode = edge->getElement(0)
-                                 ->getPhysicalGeometry()
-                                 ->getLocalNodeCoordinates(nodeIndices[1]);
-                double length =
-                    (expectedLength[edge->getElement(0)
-                                        ->getNode(nodeIndices[0])
-                                        ->getID()] +
-                     expectedLength[edge->getElement(0)
-                                        ->getNode(nodeIndices[1])
-                                        ->getID()]) /
-                    currentLength[edge->getID()] *
-                    std::pow(1.4 * totalCurrentLength / totalexpectedLength,
-                             1. / 3.) /
-                    2.;
-                movement
-                    [edge->getElement(0)->getNode(nodeIndices[0])->getID()] +=
-                    std::max(length - 1., 0.) * (firstNode - secondNode) *
-                    (length + 1.) * 0.5;
-                movement
-                    [edge->getElement(0)->getNode(nodeIndices[1])->getID()] +=
-                    std::max(length - 1., 0.) * (secondNode - firstNode) *
-                    (length + 1.) * 0.5;
+        }
+        for (Node *node : theMesh_.getNodesList(IteratorType::GLOBAL)) {
+            // all of the nodes should be in the interior of the domain or
+            // near the boundary of the domain
+            if (node->getNumberOfElements() == 0) {
+                for (std::size_t i = 0; i < vertexIndex.size(); ++i) {
+                    if (vertexIndex[i] == node->getID()) {
+                        logger(DEBUG, "% % %", i,
+                               theMesh_.getNodeCoordinates()[i],
+                               domainDescription(
+                                   theMesh_.getNodeCoordinates()[i]));
+                    }
+                }
             }
+            logger.assert_debug(
+                node->getNumberOfElements() > 0,
+                "There is an node without any elements connected to it");
+        }
+        edgeFactory();
+        faceFactory();
+        gatherTopology();
+    };
+
+    // except don't bother if a retriangulation is in order anyway
+    if (oldNodeLocations_.size() == theMesh_.getNodeCoordinates().size()) {
+        gatherTopology();
+        computeLengths();
+        computeShift();
+        computeQuality();
+    }
+    std::size_t counter = 0;
+    // stop after n iterations, or (when the nodes have stopped moving and the
+    // mesh is not becoming worse), or when the mesh is great, or when the mesh
+    // is decent, but worsening
+    while ((counter < 10000 &&
+            (maxMovement > 1e-3 || oldQuality - worstQuality > 1e-3) &&
+            worstQuality < 0.8 &&
+            (worstQuality < 2. / 3. || oldQuality - worstQuality < 0)) ||
+           counter < 5) {
+        counter++;
+        if ((maxShift > 0.1 && (oldQuality - worstQuality) < 5e-3 * maxShift) ||
+            (oldNodeLocations_.size() !=
+             theMesh_.getNumberOfNodeCoordinates()) ||
+            worstQuality < 1e-6) {
+            retriangulate();
         }
+        oldQuality = worstQuality;
+
+        computeLengths();
+
+        // it is impossible to detect if a node inside the domain should be
+        // clipped to the edge instead make sure that the nodes that DO belong
+        // dont get pulled into the interior roundoff error should make sure
+        // that nodes move away from the boundary if there are too many all
+        // edges should be squeezed a little if the algorithm is to work
+        // correctly so pretend the volume is 1.4 times as large remember to
+        // scale back from a volume measure to a length measure the
+        // non-linearity makes everything slightly more robust
+        const double scaling = std::pow(
+            1.4 * totalCurrentLength / totalexpectedLength, 1. / DIM);
+        const std::vector<Geometry::PointPhysical<DIM>> &coordinates =
+            theMesh_.getNodeCoordinates();
+        runChunks(springNodes.size(), [&](std::size_t thread,
+                                          std::size_t begin, std::size_t end) {
+            std::vector<Geometry::PointPhysical<DIM>> &partialMovement =
+                threadMovement[thread];
+            std::fill(partialMovement.begin(), partialMovement.end(),
+                      Geometry::PointPhysical<DIM>());
+            for (std::size_t i = begin; i < end; ++i) {
+                const Geometry::PointPhysical<DIM> &firstNode =
+                    coordinates[springCoordinates[i][0]];
+                const Geometry::PointPhysical<DIM> &secondNode =
+                    coordinates[springCoordinates[i][1]];
+                double length = (expectedLength[springNodes[i][0]] +
+                                 expectedLength[springNodes[i][1]]) /
+                                currentLength[i] * scaling / 2.;
+                if (length > 1.) {
+                    // the push of a very short spring is limited to its
+                    // expected length, so nearly coinciding nodes do not
+                    // shoot through the domain
+                    Geometry::PointPhysical<DIM> force =
+                        std::min((length - 1.) * (length + 1.) * 0.5, length) *
+                        (firstNode - secondNode);
+                    partialMovement[springNodes[i][0]] += force;
+                    partialMovement[springNodes[i][1]] -= force;
+                }
+            }
+        });
+        runChunks(movement.size(), [&](std::size_t, std::size_t begin,
+                                       std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                movement[i] = threadMovement[0][i];
+                for (std::size_t thread = 1; thread < numberOfThreads;
+                     ++thread) {
+                    movement[i] += threadMovement[thread][i];
+                }
+            }
+        });
 
         // forward Euler discretisation of an optimally damped mass-spring
         // system, with time step 0.02 this time step could be 0.1, but there is
         // a stability issue where springs aligned along the periodic boundary
         // are applied twice
+        // moving nodes back into the domain calls the user provided domain
+        // description, so this part stays sequential
         maxMovement = 0;
-        auto moveIterator = movement.begin();
-        auto fixIterator = fixedPointIdxs.begin();
-        for (std::size_t i = 0;
-             i < theMesh_.getNumberOfNodes(IteratorType::GLOBAL);
-             ++moveIterator, ++i) {
-            if (fixIterator != fixedPointIdxs.end() && i == *fixIterator) {
-                ++fixIterator;
-                std::get<1>(*moveIterator) *= 0;
-            } else {
-                Node *node = theMesh_.getNodesList(IteratorType::GLOBAL)[i];
-                Geometry::PointPhysical<DIM> &point =
-                    theMesh_
-                        .getNodeCoordinates()[node->getElement(0)
-                                                  ->getPhysicalGeometry()
-                                                  ->getNodeIndex(
-                                                      node->getNodeNumber(0))];
-                point += 0.1 * std::get<1>(*moveIterator);
-                logger.assert_debug(!(std::isnan(point[0])), "%", i);
-                bool isPeriodic = false;
-                std::map<std::size_t, bool> hasMoved{};
-                hasMoved[node->getElement(0)
-                             ->getPhysicalGeometry()
-                             ->getNodeIndex(node->getNodeNumber(0))] = true;
-                for (std::size_t j = 1; j < node->getNumberOfElements(); ++j) {
-                    if (!hasMoved[node->getElement(j)
-                                      ->getPhysicalGeometry()
-                                      ->getNodeIndex(node->getNodeNumber(j))]) {
-                        Geometry::PointPhysical<DIM> &other =
-                            theMesh_.getNodeCoordinates()
-                                [node->getElement(j)
-                                     ->getPhysicalGeometry()
-                                     ->getNodeIndex(node->getNodeNumber(j))];
-                        other += 0.1 * std::get<1>(*moveIterator);
-                        hasMoved[node->getElement(j)
-                                     ->getPhysicalGeometry()
-                                     ->getNodeIndex(node->getNodeNumber(j))] =
-                            true;
-                        isPeriodic = true;
-                    }
+        for (std::size_t i = 0; i < movement.size(); ++i) {
+            if (isFixed[i]) {
+                movement[i] *= 0;
+                continue;
+            }
+            const std::size_t *nodeCoordinatesBegin =
+                &nodeCoordinates[nodeCoordinateOffsets[i]];
+            const std::size_t *nodeCoordinatesEnd =
+                &nodeCoordinates[0] + nodeCoordinateOffsets[i + 1];
+            Geometry::PointPhysical<DIM> &point =
+                theMesh_.getNodeCoordinates()[*nodeCoordinatesBegin];
+            const Geometry::PointPhysical<DIM> previousPoint = point;
+            for (const std::size_t *coordinate = nodeCoordinatesBegin;
+                 coordinate != nodeCoordinatesEnd; ++coordinate) {
+                theMesh_.getNodeCoordinates()[*coordinate] += 0.1 * movement[i];
+            }
+            logger.assert_debug(!(std::isnan(point[0])), "%", i);
+            bool isPeriodic = nodeCoordinatesEnd - nodeCoordinatesBegin > 1;
+            if (domainDescription(point) > 0 && !isPeriodic) {
+                // the point is outside of the domain, move it back inside
+                double currentValue = domainDescription(point);
+                LinearAlgebra::SmallVector<DIM> gradient;
+                LinearAlgebra::SmallVector<DIM> offset;
+                // one-sided numerical derivative
+                for (std::size_t j = 0; j < DIM; ++j) {
+                    offset[j] = 1e-7;
+                    gradient[j] =
+                        (currentValue - domainDescription(point + offset)) *
+                        1e7;
+                    offset[j] = 0;
                 }
-                if (domainDescription(point) > 0 && !isPeriodic) {
-                    // the point is outside of the domain, move it back inside
-                    double currentValue = domainDescription(point);
-                    LinearAlgebra::SmallVector<DIM> gradient;
-                    LinearAlgebra::SmallVector<DIM> offset;
-                    // one-sided numerical derivative
+                point += currentValue * gradient / L2Norm(gradient);
+                movement[i] += 10 * currentValue * gradient / L2Norm(gradient);
+                currentValue = domainDescription(point);
+                // second step for robustness and accuracy if needed
+                if (currentValue > 0) {
                     for (std::size_t j = 0; j < DIM; ++j) {
                         offset[j] = 1e-7;
                         gradient[j] =
@@ -2974,423 +5083,125 @@ void MeshManipulator<DIM>::updateMesh(
                         offset[j] = 0;
                     }
                     point += currentValue * gradient / L2Norm(gradient);
-                    std::get<1>(*moveIterator) +=
+                    movement[i] +=
                         10 * currentValue * gradient / L2Norm(gradient);
+                    // if two steps are not enough, more are also not likely
+                    // to help
                     currentValue = domainDescription(point);
-                    // second step for robustness and accuracy if needed
-                    if (currentValue > 0) {
-                        for (std::size_t j = 0; j < DIM; ++j) {
-                            offset[j] = 1e-7;
-                            gradient[j] = (currentValue -
-                                           domainDescription(point + offset)) *
-                                          1e7;
-                            offset[j] = 0;
-                        }
-                        point += currentValue * gradient / L2Norm(gradient);
-                        std::get<1>(*moveIterator) +=
-                            10 * currentValue * gradient / L2Norm(gradient);
-                        // if two steps are not enough, more are also not likely
-                        // to help
-                        currentValue = domainDescription(point);
-                        if (currentValue > 1e-10) {
-                            logger(WARN,
-                                   "NOTE: Failed to move point % (%) back into "
-                                   "the domain."
-                                   "\n Distance from boundary is %. Algorithm "
-                                   "may crash.\n Consider fixing "
-                                   "points at corners to remedy this issue.",
-                                   i, point, currentValue);
-                        }
+                    if (currentValue > 1e-10) {
+                        logger(WARN,
+                               "NOTE: Failed to move point % (%) back into "
+                               "the domain."
+                               "\n Distance from boundary is %. Algorithm "
+                               "may crash.\n Consider fixing "
+                               "points at corners to remedy this issue.",
+                               i, point, currentValue);
                     }
                 }
-                if (isPeriodic) {
-                    // do a total of four newton iteration before giving up
-                    Geometry::PointPhysical<DIM> testPoint;
-                    for (std::size_t j = 0; j < 4; ++j) {
-                        // make sure the node stays on the periodic boundary, to
-                        // prevent faces with 3 or more elements connected to
-                        // them
-                        for (std::size_t k = 0; k < node->getNumberOfElements();
-                             ++k) {
-                            testPoint = node->getElement(k)
-                                            ->getPhysicalGeometry()
-                                            ->getLocalNodeCoordinates(
-                                                node->getNodeNumber(k));
-                            double currentValue = domainDescription(testPoint);
-                            if (currentValue > 0) {
-                                LinearAlgebra::SmallVector<DIM> gradient;
-                                LinearAlgebra::SmallVector<DIM> offset;
-                                for (std::size_t l = 0; l < DIM; ++l) {
-                                    offset[l] = 1e-7;
-                                    gradient[l] = (currentValue -
-                                                   domainDescription(testPoint +
-                                                                     offset)) *
-                                                  1e7;
-                                    offset[l] = 0;
-                                }
-                                hasMoved.clear();
-                                for (std::size_t l = 0;
-                                     l < node->getNumberOfElements(); ++l) {
-                                    if (!hasMoved[node->getElement(l)
-                                                      ->getPhysicalGeometry()
-                                                      ->getNodeIndex(
-                                                          node->getNodeNumber(
-                                                              l))]) {
-                                        Geometry::PointPhysical<DIM> &other =
-                                            theMesh_.getNodeCoordinates()
-                                                [node->getElement(l)
-                                                     ->getPhysicalGeometry()
-                                                     ->getNodeIndex(
-                                                         node->getNodeNumber(
-                                                             l))];
-                                        other += currentValue * gradient /
-                                                 L2Norm(gradient);
-                                        hasMoved[node->getElement(l)
-                                                     ->getPhysicalGeometry()
-                                                     ->getNodeIndex(
-                                                         node->getNodeNumber(
-                                                             l))] = true;
-                                    }
-                                }
-                                std::get<1>(*moveIterator) +=
-                                    10 * currentValue * gradient /
-                                    L2Norm(gradient);
+                // a node that is pushed past a corner of the domain is moved
+                // back onto the corner, where there often is a fixed node;
+                // the triangulation drops one of two coinciding nodes, so
+                // keep the node where it was instead
+                auto coincides = [&](std::size_t other) {
+                    const Geometry::PointPhysical<DIM> &otherPoint =
+                        coordinates[nodeCoordinates
+                                        [nodeCoordinateOffsets[other]]];
+                    return L2Norm(point - otherPoint) <
+                           1e-6 * L2Norm(previousPoint - otherPoint);
+                };
+                if (std::any_of(fixedPointIdxs.begin(), fixedPointIdxs.end(),
+                                coincides) ||
+                    std::any_of(neighbours.begin() + neighbourOffsets[i],
+                                neighbours.begin() + neighbourOffsets[i + 1],
+                                coincides)) {
+                    point = previousPoint;
+                    movement[i] *= 0;
+                }
+            }
+            if (isPeriodic) {
+                // do a total of four newton iteration before giving up
+                for (std::size_t j = 0; j < 4; ++j) {
+                    // make sure the node stays on the periodic boundary, to
+                    // prevent faces with 3 or more elements connected to them
+                    for (const std::size_t *test = nodeCoordinatesBegin;
+                         test != nodeCoordinatesEnd; ++test) {
+                        Geometry::PointPhysical<DIM> testPoint =
+                            theMesh_.getNodeCoordinates()[*test];
+                        double currentValue = domainDescription(testPoint);
+                        if (currentValue > 0) {
+                            LinearAlgebra::SmallVector<DIM> gradient;
+                            LinearAlgebra::SmallVector<DIM> offset;
+                            for (std::size_t l = 0; l < DIM; ++l) {
+                                offset[l] = 1e-7;
+                                gradient[l] =
+                                    (currentValue -
+                                     domainDescription(testPoint + offset)) *
+                                    1e7;
+                                offset[l] = 0;
                             }
+                            for (const std::size_t *coordinate =
+                                     nodeCoordinatesBegin;
+                                 coordinate != nodeCoordinatesEnd;
+                                 ++coordinate) {
+                                theMesh_.getNodeCoordinates()[*coordinate] +=
+                                    currentValue * gradient / L2Norm(gradient);
+                            }
+                            movement[i] +=
+                                10 * currentValue * gradient / L2Norm(gradient);
                         }
                     }
-                    for (std::size_t j = 0; j < node->getNumberOfElements();
-                         ++j) {
-                        testPoint = node->getElement(j)
-                                        ->getPhysicalGeometry()
-                                        ->getLocalNodeCoordinates(
-                                            node->getNodeNumber(j));
-                        if (domainDescription(testPoint) > 1e-10) {
-                            logger(WARN,
-                                   "NOTE: Failed to move periodic testPoint % "
-                                   "(%) back to the periodic boundary.\n "
-                                   "Distance from boundary is %. Algorithm may "
-                                   "crash.\n "
-                                   "Consider fixing points at corners to "
-                                   "remedy this issue.",
-                                   i, testPoint, domainDescription(testPoint));
-                        }
-                    };
-                }
-            }
-        }
-
-        worstQuality = 1;
-        if (DIM == 1) {
-            // quality measure is not an issue in 1D just create a mesh with the
-            // proper lengths
-            worstQuality = 0.5;
-            // the algorithm is mostly dimension independent, but the data type
-            // it operates on is not
-            for (Element *element :
-                 theMesh_.getElementsList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
-                firstNode =
-                    element->getPhysicalGeometry()->getLocalNodeCoordinates(0);
-                secondNode =
-                    element->getPhysicalGeometry()->getLocalNodeCoordinates(1);
-                maxMovement =
-                    std::max(maxMovement,
-                             L2Norm(movement[element->getNode(0)->getID()]) /
-                                 10 / currentLength[element->getID()]);
-                maxMovement =
-                    std::max(maxMovement,
-                             L2Norm(movement[element->getNode(1)->getID()]) /
-                                 10 / currentLength[element->getID()]);
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(firstNode -
-                           oldNodeLocations_[element->getPhysicalGeometry()
-                                                 ->getNodeIndex(0)]) /
-                        currentLength[element->getID()]);
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(secondNode -
-                           oldNodeLocations_[element->getPhysicalGeometry()
-                                                 ->getNodeIndex(1)]) /
-                        currentLength[element->getID()]);
-            }
-        } else if (DIM == 2) {
-            // ratio between incircle and circumcircle (scaled so equilateral is
-            // quality 1 and reference is quality ~.8)
-            for (Element *element :
-                 theMesh_.getElementsList(IteratorType::GLOBAL)) {
-                std::array<double, 3> edgeLengths{};
-                for (std::size_t i = 0; i < 3; ++i) {
-                    edgeLengths[i] =
-                        currentLength[element->getFace(i)->getID()];
-                }
-                worstQuality = std::min(
-                    worstQuality,
-                    (edgeLengths[0] + edgeLengths[1] - edgeLengths[2]) *
-                        (edgeLengths[1] + edgeLengths[2] - edgeLengths[0]) *
-                        (edgeLengths[2] + edgeLengths[0] - edgeLengths[1]) /
-                        edgeLengths[0] / edgeLengths[1] / edgeLengths[2]);
-            }
-            for (Face *face : theMesh_.getFacesList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
-                std::vector<std::size_t> nodeIndices =
-                    face->getPtrElementLeft()
-                        ->getReferenceGeometry()
-                        ->getCodim1EntityLocalIndices(
-                            face->localFaceNumberLeft());
-                firstNode = face->getPtrElementLeft()
-                                ->getPhysicalGeometry()
-                                ->getLocalNodeCoordinates(nodeIndices[0]);
-                secondNode = face->getPtrElementLeft()
-                                 ->getPhysicalGeometry()
-                                 ->getLocalNodeCoordinates(nodeIndices[1]);
-                maxMovement = std::max(
-                    maxMovement, L2Norm(movement[face->getPtrElementLeft()
-                                                     ->getNode(nodeIndices[0])
-                                                     ->getID()]) /
-                                     10 / currentLength[face->getID()]);
-                maxMovement = std::max(
-                    maxMovement, L2Norm(movement[face->getPtrElementLeft()
-                                                     ->getNode(nodeIndices[1])
-                                                     ->getID()]) /
-                                     10 / currentLength[face->getID()]);
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(
-                        firstNode -
-                        oldNodeLocations_[face->getPtrElementLeft()
-                                              ->getPhysicalGeometry()
-                                              ->getNodeIndex(nodeIndices[0])]) /
-                        currentLength[face->getID()]);
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(
-                        secondNode -
-                        oldNodeLocations_[face->getPtrElementLeft()
-                                              ->getPhysicalGeometry()
-                                              ->getNodeIndex(nodeIndices[1])]) /
-                        currentLength[face->getID()]);
-            }
-        } else {
-            // ratio between volume and cubed average edge length (scaled so
-            // equilateral is quality 1 and reference is quality ~.8)
-            for (Element *element :
-                 theMesh_.getElementsList(IteratorType::GLOBAL)) {
-                std::array<double, 6> edgeLengths{};
-                for (std::size_t i = 0; i < 6; ++i) {
-                    edgeLengths[i] =
-                        currentLength[element->getEdge(i)->getID()];
-                }
-                double average =
-                    std::accumulate(edgeLengths.begin(), edgeLengths.end(), 0) /
-                    6;
-                const Geometry::PointReference<DIM> &center =
-                    element->getReferenceGeometry()->getCenter();
-                Geometry::Jacobian<DIM, DIM> jac =
-                    element->calcJacobian(center);
-                worstQuality = std::min(
-                    worstQuality, jac.determinant() / average * std::sqrt(2));
-            }
-            for (Edge *edge : theMesh_.getEdgesList(IteratorType::GLOBAL)) {
-                Geometry::PointPhysical<DIM> firstNode, secondNode;
-                std::vector<std::size_t> nodeIndices =
-                    edge->getElement(0)
-                        ->getReferenceGeometry()
-                        ->getCodim2EntityLocalIndices(edge->getEdgeNumber(0));
-                firstNode = edge->getElement(0)
-                                ->getPhysicalGeometry()
-                                ->getLocalNodeCoordinates(nodeIndices[0]);
-                secondNode = edge->getElement(0)
-                                 ->getPhysicalGeometry()
-                                 ->getLocalNodeCoordinates(nodeIndices[1]);
-                maxMovement = std::max(
-                    maxMovement, L2Norm(movement[edge->getElement(0)
-                                                     ->getNode(nodeIndices[0])
-                                                     ->getID()]) /
-                                     10 / currentLength[edge->getID()]);
-                maxMovement = std::max(
-                    maxMovement, L2Norm(movement[edge->getElement(0)
-                                                     ->getNode(nodeIndices[1])
-                                                     ->getID()]) /
-                                     10 / currentLength[edge->getID()]);
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(
-                        firstNode -
-                        oldNodeLocations_[edge->getElement(0)
-                                              ->getPhysicalGeometry()
-                                              ->getNodeIndex(nodeIndices[0])]) /
-                        currentLength[edge->getID()]);
-                maxShift = std::max(
-                    maxShift,
-                    L2Norm(
-                        secondNode -
-                        oldNodeLocations_[edge->getElement(0)
-                                              ->getPhysicalGeometry()
-                                              ->getNodeIndex(nodeIndices[1])]) /
-                        currentLength[edge->getID()]);
-            }
-        }
-
-        // no teleporting nodes in the final iteration
-        ///\todo temporarily toggled off for debug reasons
-        if (counter % 50 == 1 && false) {
-            // the actual sorting is more expensive than computing the lengths
-            // and this does not happen very often
-            std::multimap<double,
-                          std::pair<Geometry::PointPhysical<DIM>, std::size_t>>
-                centerPoints{};
-            if (DIM == 1) {
-                // the algorithm is mostly dimension independent, but the data
-                // type it operates on is not
-                for (Element *element :
-                     theMesh_.getElementsList(IteratorType::GLOBAL)) {
-                    Geometry::PointPhysical<DIM> firstNode, secondNode;
-                    firstNode =
-                        element->getPhysicalGeometry()->getLocalNodeCoordinates(
-                            0);
-                    secondNode =
-                        element->getPhysicalGeometry()->getLocalNodeCoordinates(
-                            1);
-                    // length is scaled in case somebody hasty decides to add
-                    // smoothing at this point all edges should be squeezed a
-                    // little if the algorithm is to work correctly so pretend
-                    // the volume is 1.5 times as large remember to scale back
-                    // from a volume measure to a length measure
-                    double length =
-                        (expectedLength[element->getNode(0)->getID()] +
-                         expectedLength[element->getNode(1)->getID()]) /
-                        currentLength[centerPoints.size()] * 2 *
-                        totalCurrentLength / totalexpectedLength;
-                    centerPoints.insert({length,
-                                         {(firstNode + secondNode) / 2,
-                                          element->getNode(0)->getID()}});
-                }
-            } else if (DIM == 2) {
-                for (Face *face : theMesh_.getFacesList(IteratorType::GLOBAL)) {
-                    Geometry::PointPhysical<DIM> firstNode, secondNode;
-                    std::vector<std::size_t> nodeIndices =
-                        face->getPtrElementLeft()
-                            ->getReferenceGeometry()
-                            ->getCodim1EntityLocalIndices(
-                                face->localFaceNumberLeft());
-                    firstNode = face->getPtrElementLeft()
-                                    ->getPhysicalGeometry()
-                                    ->getLocalNodeCoordinates(nodeIndices[0]);
-                    secondNode = face->getPtrElementLeft()
-                                     ->getPhysicalGeometry()
-                                     ->getLocalNodeCoordinates(nodeIndices[1]);
-                    // length is scaled in case somebody hasty decides to add
-                    // smoothing at this point all edges should be squeezed a
-                    // little if the algorithm is to work correctly so pretend
-                    // the volume is 1.5 times as large remember to scale back
-                    // from a volume measure to a length measure
-                    double length =
-                        (expectedLength[face->getPtrElementLeft()
-                                            ->getNode(nodeIndices[0])
-                                            ->getID()] +
-                         expectedLength[face->getPtrElementLeft()
-                                            ->getNode(nodeIndices[1])
-                                            ->getID()]) /
-                        currentLength[centerPoints.size()] *
-                        std::pow(2 * totalCurrentLength / totalexpectedLength,
-                                 1. / 2.);
-                    centerPoints.insert({length,
-                                         {(firstNode + secondNode) / 2,
-                                          face->getPtrElementLeft()
-                                              ->getNode(nodeIndices[0])
-                                              ->getID()}});
                 }
-            } else {
-                for (Edge *edge : theMesh_.getEdgesList(IteratorType::GLOBAL)) {
-                    Geometry::PointPhysical<DIM> firstNode, secondNode;
-                    std::vector<std::size_t> nodeIndices =
-                        edge->getElement(0)
-                            ->getReferenceGeometry()
-                            ->getCodim2EntityLocalIndices(
-                                edge->getEdgeNumber(0));
-                    firstNode = edge->getElement(0)
-                                    ->getPhysicalGeometry()
-                                    ->getLocalNodeCoordinates(nodeIndices[0]);
-                    secondNode = edge->getElement(0)
-                                     ->getPhysicalGeometry()
-                                     ->getLocalNodeCoordinates(nodeIndices[1]);
-                    // length is scaled in case somebody hasty decides to add
-                    // smoothing at this point all edges should be squeezed a
-                    // little if the algorithm is to work correctly so pretend
-                    // the volume is 1.5 times as large remember to scale back
-                    // from a volume measure to a length measure
-                    double length =
-                        (expectedLength[edge->getElement(0)
-                                            ->getNode(nodeIndices[0])
-                                            ->getID()] +
-                         expectedLength[edge->getElement(0)
-                                            ->getNode(nodeIndices[1])
-                                            ->getID()]) /
-                        currentLength[centerPoints.size()] *
-                        std::pow(2 * totalCurrentLength / totalexpectedLength,
-                                 1. / 3.);
-                    centerPoints.insert({length,
-                                         {(firstNode + secondNode) / 2,
-                                          edge->getElement(0)
-                                              ->getNode(nodeIndices[0])
-                                              ->getID()}});
-                }
-            }
-            std::vector<bool> hasTeleported(
-                theMesh_.getNumberOfNodeCoordinates(), false);
-            auto longEdge = centerPoints.begin();
-            auto shortEdge = centerPoints.rbegin();
-            for (std::size_t index : fixedPointIdxs) {
-                hasTeleported[index] = true;
-            }
-            Geometry::PointPhysical<DIM> point;
-            Geometry::PointPhysical<DIM> other;
-            for (Node *node : theMesh_.getNodesList(IteratorType::GLOBAL)) {
-                point = node->getElement(0)
-                            ->getPhysicalGeometry()
-                            ->getLocalNodeCoordinates(node->getNodeNumber(0));
-                for (std::size_t i = 0; i < node->getNumberOfElements(); ++i) {
-                    other =
-                        node->getElement(i)
-                            ->getPhysicalGeometry()
-                            ->getLocalNodeCoordinates(node->getNodeNumber(i));
-                    if (point != other) {
-                        hasTeleported[node->getID()] = true;
+                for (const std::size_t *test = nodeCoordinatesBegin;
+                     test != nodeCoordinatesEnd; ++test) {
+                    const Geometry::PointPhysical<DIM> &testPoint =
+                        theMesh_.getNodeCoordinates()[*test];
+                    if (domainDescription(testPoint) > 1e-10) {
+                        logger(WARN,
+                               "NOTE: Failed to move periodic testPoint % "
+                               "(%) back to the periodic boundary.\n "
+                               "Distance from boundary is %. Algorithm may "
+                               "crash.\n "
+                               "Consider fixing points at corners to "
+                               "remedy this issue.",
+                               i, testPoint, domainDescription(testPoint));
                     }
                 }
             }
-            // remember that the size measure is inverted
-            while (3 * longEdge->first < shortEdge->first) {
-                if (hasTeleported[shortEdge->second.second]) {
-                    shortEdge++;
-                } else {
-                    if (domainDescription(longEdge->second.first) < 0) {
-                        maxMovement = std::max(
-                            maxMovement,
-                            L2Norm(
-                                longEdge->second.first -
-                                theMesh_.getNodeCoordinates()[shortEdge->second
-                                                                  .second]));
-                        // it is quite unlikely that the current triangulation
-                        // suffices after randomly teleporting nodes about
-                        maxShift = std::numeric_limits<double>::infinity();
-                        theMesh_
-                            .getNodeCoordinates()[shortEdge->second.second] =
-                            longEdge->second.first;
-                        hasTeleported[shortEdge->second.second] = true;
-                        shortEdge++;
-                    }
-                    longEdge++;
+        }
+
+        std::vector<double> partialMaxMovement(numberOfThreads, 0.);
+        runChunks(springNodes.size(), [&](std::size_t thread,
+                                          std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                for (std::size_t node : springNodes[i]) {
+                    partialMaxMovement[thread] = std::max(
+                        partialMaxMovement[thread],
+                        L2Norm(movement[node]) / 10 / currentLength[i]);
                 }
             }
-        }
+        });
+        maxMovement = *std::max_element(partialMaxMovement.begin(),
+                                        partialMaxMovement.end());
+        computeShift();
+        computeQuality();
+        logger(VERBOSE,
+               "r-refinement iteration %: largest movement %, largest shift "
+               "since triangulation %, worst element quality %",
+               counter, maxMovement, maxShift, worstQuality);
     }
     if (counter == 10000) {
         logger(WARN,
                "WARNING: Maximum iteration count reached, mesh quality may not "
                "be optimal");
     }
+    logger(INFO,
+           "r-refinement took % iterations and % triangulations in % s, worst "
+           "element quality %",
+           counter, numberOfTriangulations,
+           std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         startTime)
+               .count(),
+           worstQuality);
     // coordinate transformation may have changed, update to the current
     // situation
     for (Element *element : theMesh_.getElementsList()) {
@@ -3400,113 +5211,264 @@ void MeshManipulator<DIM>::updateMesh(
 
 #endif
 
-/// \bug does not do the bc flags yet
 template <std::size_t DIM>
-void MeshManipulator<DIM>::faceFactory() {
-    getFacesList(IteratorType::GLOBAL).setPreOrderTraversal();
-    std::vector<std::size_t> nodeIndices;
-    std::vector<Element *> candidates;
-
+std::vector<Element *> MeshManipulator<DIM>::getActiveElements() {
+    // only the leaves of the refinement tree are part of the active mesh
+    std::vector<Element *> activeElements;
     getElementsList(IteratorType::GLOBAL).setPreOrderTraversal();
     for (Element *element : theMesh_.getElementsList(IteratorType::GLOBAL)) {
-        for (std::size_t i = 0; i < element->getNumberOfFaces(); ++i) {
-            std::vector<const Node *> localNodes;
-            // if this face is not there yet
-            if (element->getFace(i) == nullptr) {
-                localNodes.clear();
-                candidates.clear();
-                nodeIndices = element->getReferenceGeometry()
-                                  ->getCodim1EntityLocalIndices(i);
-
-                candidates = element->getNode(nodeIndices[0])->getElements();
-                localNodes.push_back(element->getNode(nodeIndices[0]));
-                std::sort(candidates.begin(), candidates.end(),
-                          [](Element *left, Element *right) {
-                              return left->getID() < right->getID();
-                          });
-
-                logger(DEBUG, "Candidates: ");
-                for (Element *coutElement : candidates) {
-                    logger(DEBUG, "Element %: %", coutElement->getID(),
-                           *coutElement);
-                }
-                for (std::size_t j = 1; j < nodeIndices.size(); ++j) {
-                    localNodes.push_back(element->getNode(nodeIndices[j]));
-                    std::vector<Element *> temp, nextIndices;
-                    nextIndices =
-                        element->getNode(nodeIndices[j])->getElements();
-                    std::sort(nextIndices.begin(), nextIndices.end(),
-                              [](Element *left, Element *right) {
-                                  return left->getID() < right->getID();
-                              });
-                    std::set_intersection(
-                        candidates.begin(), candidates.end(),
-                        nextIndices.begin(), nextIndices.end(),
-                        std::back_inserter(temp),
-                        [](Element *left, Element *right) {
-                            return left->getID() < right->getID();
-                        });
-                    candidates = std::move(temp);
-                    logger(DEBUG, "Candidates: ");
-                    for (Element *coutElement : candidates) {
-                        logger(DEBUG, "Element %: %", coutElement->getID(),
-                               *coutElement);
+        if (!element->getPositionInTree()->hasChild()) {
+            activeElements.push_back(element);
+        }
+    }
+    return activeElements;
+}
+
+/// \bug does not do the bc flags yet
+/// \details A child of a refined element gets a nonconforming face for each of
+/// its faces that lies on a split face of its parent, if the element on the
+/// other side of that face of the parent is still active. The mapping to the
+/// coarse element is affine and is found from the vertices of the face: their
+/// position on the face of the parent is matched to the coarse element by the
+/// nodes the parent and the coarse element share, so this also works across
+/// periodic boundaries.
+template <std::size_t DIM>
+void MeshManipulator<DIM>::nonconformingFaceFactory() {
+    const std::size_t faceDimension = DIM - 1;
+    std::size_t numberOfNonconformingFaces = 0;
+    LevelTree<Element *> &elements = getElementsList(IteratorType::GLOBAL);
+    elements.setPreOrderTraversal();
+    for (Element *element : elements) {
+        const TreeEntry<Element *> *position = element->getPositionInTree();
+        if (position->isRoot() || !position->isLeaf()) {
+            continue;
+        }
+        const Element *parent = position->getParent()->getData();
+        const Geometry::RefinementMapping *refinementMap =
+            parent->getRefinementMap();
+        for (std::size_t i = 0; i < parent->getNumberOfFaces(); ++i) {
+            const Geometry::RefinementMapping *faceRefinementMap =
+                refinementMap->getCodim1RefinementMaps()[i];
+            if (faceRefinementMap->getNumberOfNewNodes() == 0) {
+                continue;
+            }
+            for (std::size_t j = 0;
+                 j < faceRefinementMap->getNumberOfSubElements(); ++j) {
+                std::size_t elementIndex, faceIndex;
+                std::tie(elementIndex, faceIndex) =
+                    refinementMap->getSubElementAndLocalFaceIndex(i, j);
+                if (elementIndex != position->getSiblingIndex() ||
+                    element->getFace(faceIndex) != nullptr) {
+                    continue;
+                }
+
+                // find the active element that has the face of the parent as
+                // one of its faces
+                std::vector<std::size_t> parentFaceNodes =
+                    parent->getReferenceGeometry()->getCodim1EntityLocalIndices(
+                        i);
+                std::vector<const Node *> faceNodes;
+                for (std::size_t localNode : parentFaceNodes) {
+                    faceNodes.push_back(parent->getNode(localNode));
+                }
+                std::sort(faceNodes.begin(), faceNodes.end());
+                Element *coarse = nullptr;
+                std::size_t coarseFace = 0;
+                for (Element *candidate : faceNodes[0]->getElements()) {
+                    if (candidate == parent ||
+                        !candidate->getPositionInTree()->isLeaf()) {
+                        continue;
+                    }
+                    for (std::size_t g = 0; g < candidate->getNumberOfFaces();
+                         ++g) {
+                        std::vector<const Node *> candidateNodes;
+                        for (std::size_t localNode :
+                             candidate->getReferenceGeometry()
+                                 ->getCodim1EntityLocalIndices(g)) {
+                            candidateNodes.push_back(
+                                candidate->getNode(localNode));
+                        }
+                        std::sort(candidateNodes.begin(), candidateNodes.end());
+                        if (candidateNodes == faceNodes) {
+                            coarse = candidate;
+                            coarseFace = g;
+                        }
                     }
                 }
+                if (coarse == nullptr) {
+                    continue;
+                }
 
-                // the current element does not bound the face or more than two
-                // elements bound the face
-                logger.assert_always(
-                    candidates.size() == 1 || candidates.size() == 2,
-                    "Detected % bounding elements for face %, which is "
-                    "impossible",
-                    candidates.size(),
-                    theMesh_.getFacesList(IteratorType::GLOBAL).size() + 1);
-                // boundary face
-                if (candidates.size() == 1) {
-                    logger.assert_debug(candidates[0] == element,
-                                        "dropped the original element");
-                    addFace(element, i, nullptr, 0,
-                            Geometry::FaceType::WALL_BC);
-                }
-                if (candidates.size() == 2) {
-                    Element *other;
-                    if (candidates[0] == element) {
-                        other = candidates[1];
-                    } else {
-                        other = candidates[0];
+                // express the vertices of the face in the vertices of the face
+                // of the parent and map those to the coarse element
+                const Geometry::ReferenceGeometry *faceGeometry =
+                    element->getReferenceGeometry()->getCodim1ReferenceGeometry(
+                        faceIndex);
+                std::vector<Geometry::PointReference<DIM>> parentVertices,
+                    coarseVertices;
+                for (std::size_t m = 0; m <= faceDimension; ++m) {
+                    parentVertices.push_back(
+                        static_cast<const Geometry::PointReference<DIM> &>(
+                            parent->getReferenceGeometry()
+                                ->getReferenceNodeCoordinate(
+                                    parentFaceNodes[m])));
+                    for (std::size_t localNode :
+                         coarse->getReferenceGeometry()
+                             ->getCodim1EntityLocalIndices(coarseFace)) {
+                        if (coarse->getNode(localNode) ==
+                            parent->getNode(parentFaceNodes[m])) {
+                            coarseVertices.push_back(
+                                static_cast<
+                                    const Geometry::PointReference<DIM> &>(
+                                    coarse->getReferenceGeometry()
+                                        ->getReferenceNodeCoordinate(
+                                            localNode)));
+                        }
                     }
-                    bool matchFound = false;
-                    std::vector<std::size_t> otherNodeIndices;
-                    for (std::size_t j = 0; j < other->getNumberOfFaces();
-                         ++j) {
-                        otherNodeIndices = other->getReferenceGeometry()
-                                               ->getCodim1EntityLocalIndices(j);
-                        bool match = true;
-                        for (std::size_t k : otherNodeIndices) {
-                            if (std::find(localNodes.begin(), localNodes.end(),
-                                          other->getNode(k)) ==
-                                localNodes.end()) {
-                                match = false;
-                            }
+                }
+                logger.assert_debug(
+                    coarseVertices.size() == faceDimension + 1,
+                    "Could not match the face of element % to element %",
+                    parent->getID(), coarse->getID());
+                LinearAlgebra::MiddleSizeMatrix parentEdges(DIM, faceDimension);
+                for (std::size_t m = 0; m < faceDimension; ++m) {
+                    for (std::size_t d = 0; d < DIM; ++d) {
+                        parentEdges(d, m) =
+                            parentVertices[m + 1][d] - parentVertices[0][d];
+                    }
+                }
+                LinearAlgebra::MiddleSizeMatrix gram =
+                    parentEdges.transpose() * parentEdges;
+                std::vector<Geometry::PointReference<DIM - 1>> faceVertices;
+                std::vector<Geometry::PointReference<DIM>> images;
+                for (std::size_t k = 0; k <= faceDimension; ++k) {
+                    faceVertices.push_back(
+                        static_cast<const Geometry::PointReference<DIM - 1> &>(
+                            faceGeometry->getReferenceNodeCoordinate(k)));
+                    Geometry::PointReference<DIM> positionInParent =
+                        refinementMap->refinementTransform(
+                            elementIndex,
+                            element->getReferenceGeometry()
+                                ->getCodim1MappingPtr(faceIndex)
+                                ->transform(faceVertices[k]));
+                    LinearAlgebra::MiddleSizeVector weights(faceDimension);
+                    for (std::size_t m = 0; m < faceDimension; ++m) {
+                        weights[m] = 0;
+                        for (std::size_t d = 0; d < DIM; ++d) {
+                            weights[m] +=
+                                parentEdges(d, m) *
+                                (positionInParent[d] - parentVertices[0][d]);
                         }
-                        if (match) {
-                            logger.assert_debug(
-                                !matchFound,
-                                "Found two opposing faces for face % "
-                                " of element % in opposing element %.",
-                                i, element->getID(), other->getID());
-                            addFace(element, i, other, j);
-                            matchFound = true;
+                    }
+                    gram.solve(weights);
+                    Geometry::PointReference<DIM> image = coarseVertices[0];
+                    for (std::size_t m = 0; m < faceDimension; ++m) {
+                        for (std::size_t d = 0; d < DIM; ++d) {
+                            image[d] += weights[m] * (coarseVertices[m + 1][d] -
+                                                      coarseVertices[0][d]);
                         }
                     }
-                    logger.assert_debug(
-                        matchFound,
-                        "Could not find matching face for face % "
-                        "of element % in opposing element %.",
-                        i, element->getID(), other->getID());
+                    images.push_back(image);
+                }
+                // solve jacobian * (r_k - r_0) = z_k - z_0 for the face
+                // vertices r_k and their images z_k
+                LinearAlgebra::MiddleSizeMatrix faceEdges(faceDimension,
+                                                          faceDimension);
+                LinearAlgebra::MiddleSizeMatrix imageEdges(faceDimension, DIM);
+                for (std::size_t m = 0; m < faceDimension; ++m) {
+                    for (std::size_t n = 0; n < faceDimension; ++n) {
+                        faceEdges(m, n) =
+                            faceVertices[m + 1][n] - faceVertices[0][n];
+                    }
+                    for (std::size_t d = 0; d < DIM; ++d) {
+                        imageEdges(m, d) = images[m + 1][d] - images[0][d];
+                    }
+                }
+                faceEdges.solve(imageEdges);
+                std::vector<double> jacobian(DIM * faceDimension);
+                std::vector<double> offset(DIM);
+                for (std::size_t d = 0; d < DIM; ++d) {
+                    offset[d] = images[0][d];
+                    for (std::size_t n = 0; n < faceDimension; ++n) {
+                        jacobian[d * faceDimension + n] = imageEdges(n, d);
+                        offset[d] -= imageEdges(n, d) * faceVertices[0][n];
+                    }
+                }
+
+                theMesh_.addNonconformingFace(
+                    element, faceIndex, coarse, coarseFace,
+                    &Geometry::NonconformingFaceMapping::instance(jacobian,
+                                                                  offset));
+                Face *face =
+                    *(--theMesh_.getFacesList(IteratorType::GLOBAL).end());
+                logger.suppressWarnings(
+                    [&]() { theMesh_.getSubmesh().add(face); });
+                std::vector<std::size_t> parentCoordinates =
+                    parent->getPhysicalGeometry()->getGlobalFaceNodeIndices(i);
+                std::vector<std::size_t> coarseCoordinates =
+                    coarse->getPhysicalGeometry()->getGlobalFaceNodeIndices(
+                        coarseFace);
+                std::sort(parentCoordinates.begin(), parentCoordinates.end());
+                std::sort(coarseCoordinates.begin(), coarseCoordinates.end());
+                if (parentCoordinates != coarseCoordinates) {
+                    face->setFaceType(Geometry::FaceType::PERIODIC_BC);
                 }
+                ++numberOfNonconformingFaces;
+            }
+        }
+    }
+    logger(VERBOSE, "Number of faces with a hanging node: %",
+           numberOfNonconformingFaces);
+}
+
+template <std::size_t DIM>
+void MeshManipulator<DIM>::faceFactory() {
+    getFacesList(IteratorType::GLOBAL).setPreOrderTraversal();
+    EntityConnectivity connectivity(getActiveElements(), 1);
+    std::vector<std::size_t> sharingIncidences;
+    for (std::size_t i = 0; i < connectivity.getNumberOfIncidences(); ++i) {
+        Element *element = connectivity.getIncidence(i).element;
+        std::size_t localFace = connectivity.getIncidence(i).localIndex;
+        // if this face is not there yet
+        if (element->getFace(localFace) != nullptr) {
+            continue;
+        }
+        // find the other elements that contain all nodes of this face, the
+        // sharing incidences are grouped by element
+        connectivity.getSharingIncidences(i, sharingIncidences);
+        const EntityConnectivity::Incidence *other = nullptr;
+        std::size_t numberOfBoundingElements = 1;
+        for (std::size_t j : sharingIncidences) {
+            const EntityConnectivity::Incidence &candidate =
+                connectivity.getIncidence(j);
+            if (candidate.element == element) {
+                continue;
+            }
+            if (other == nullptr || other->element != candidate.element) {
+                ++numberOfBoundingElements;
+            } else {
+                logger.assert_debug(false,
+                                    "Found two opposing faces for face % "
+                                    " of element % in opposing element %.",
+                                    localFace, element->getID(),
+                                    candidate.element->getID());
             }
+            other = &candidate;
+        }
+
+        // the current element does not bound the face or more than two
+        // elements bound the face
+        logger.assert_always(
+            numberOfBoundingElements == 1 || numberOfBoundingElements == 2,
+            "Detected % bounding elements for face %, which is impossible",
+            numberOfBoundingElements,
+            theMesh_.getFacesList(IteratorType::GLOBAL).size() + 1);
+        if (other == nullptr) {
+            // boundary face
+            addFace(element, localFace, nullptr, 0,
+                    Geometry::FaceType::WALL_BC);
+        } else {
+            addFace(element, localFace, other->element, other->localIndex);
         }
     }
 
@@ -3514,64 +5476,30 @@ void MeshManipulator<DIM>::faceFactory() {
            getFacesList(IteratorType::GLOBAL).size());
 }
 
-// the algorithm for the edge factory is based on that of the face factory
-// with some minor adaptation to account for the fact that there may be
+// the edges are matched in the same way as the faces, except that there may be
 // more than two elements per edge
-///\bug does not do 4D yet
 template <std::size_t DIM>
 void MeshManipulator<DIM>::edgeFactory() {
     getEdgesList(IteratorType::GLOBAL).setPreOrderTraversal();
     //'edges' in DIM 2 are actually nodes
     if (DIM != 2) {
-        std::vector<std::size_t> nodeList, otherNodeList;
-
-        const Node *nodes[2];
-
-        getElementsList(IteratorType::GLOBAL).setPreOrderTraversal();
-        for (Element *element :
-             theMesh_.getElementsList(IteratorType::GLOBAL)) {
-            for (std::size_t i = 0; i < element->getNumberOfEdges(); ++i) {
-                if (element->getEdge(i) == nullptr) {
-                    nodeList = element->getReferenceGeometry()
-                                   ->getCodim2EntityLocalIndices(i);
-                    std::vector<Element *> candidates(0);
-                    auto &leftElements =
-                        element->getNode(nodeList[0])->getElements();
-                    auto &rightElements =
-                        element->getNode(nodeList[1])->getElements();
-                    std::set_intersection(
-                        leftElements.begin(), leftElements.end(),
-                        rightElements.begin(), rightElements.end(),
-                        std::back_inserter(candidates),
-                        [](Element *a, Element *b) {
-                            return a->getID() < b->getID();
-                        });
-                    logger.assert_debug(
-                        candidates.size() > 0,
-                        "current element is not adjacent to its own edges");
-                    addEdge();
-                    nodes[0] = element->getNode(nodeList[0]);
-                    nodes[1] = element->getNode(nodeList[1]);
-                    Edge *newEdge =
-                        *(--theMesh_.getEdgesList(IteratorType::GLOBAL).end());
-                    newEdge->addElement(element, i);
-                    for (std::size_t j = 1; j < candidates.size(); ++j) {
-                        Element *other = candidates[j];
-                        for (std::size_t k = 0; k < other->getNumberOfEdges();
-                             ++k) {
-                            otherNodeList =
-                                other->getReferenceGeometry()
-                                    ->getCodim2EntityLocalIndices(k);
-                            if ((other->getNode(otherNodeList[0]) == nodes[0] ||
-                                 other->getNode(otherNodeList[0]) ==
-                                     nodes[1]) &&
-                                (other->getNode(otherNodeList[1]) == nodes[0] ||
-                                 other->getNode(otherNodeList[1]) ==
-                                     nodes[1])) {
-                                newEdge->addElement(other, k);
-                            }
-                        }
-                    }
+        EntityConnectivity connectivity(getActiveElements(), 2);
+        std::vector<std::size_t> sharingIncidences;
+        for (std::size_t i = 0; i < connectivity.getNumberOfIncidences();
+             ++i) {
+            Element *element = connectivity.getIncidence(i).element;
+            std::size_t localEdge = connectivity.getIncidence(i).localIndex;
+            if (element->getEdge(localEdge) != nullptr) {
+                continue;
+            }
+            Edge *newEdge = addEdge();
+            newEdge->addElement(element, localEdge);
+            connectivity.getSharingIncidences(i, sharingIncidences);
+            for (std::size_t j : sharingIncidences) {
+                const EntityConnectivity::Incidence &other =
+                    connectivity.getIncidence(j);
+                if (other.element != element) {
+                    newEdge->addElement(other.element, other.localIndex);
                 }
             }
         }
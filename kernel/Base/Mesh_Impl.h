@@ -36,7 +36,9 @@
  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
 #include <limits>
+#include <unordered_map>
 
 #include "MpiContainer.h"
 #include "Mesh.h"
@@ -48,6 +50,7 @@
 #include "Geometry/PointPhysical.h"
 #include "Geometry/ReferenceGeometry.h"
 #include "Geometry/PointReference.h"
+#include "Utilities/SpaceFillingCurvePartitioner.h"
 
 #ifdef HPGEM_USE_METIS
 #include <metis.h>
@@ -141,10 +144,18 @@ template <std::size_t DIM>
 Element* Mesh<DIM>::addElement(
     const std::vector<std::size_t>& globalNodeIndexes, std::size_t owner,
     bool owning) {
+    return addElement(globalNodeIndexes, owner, owning,
+                      GlobalUniqueIndex::instance().getElementIndex());
+}
+
+template <std::size_t DIM>
+Element* Mesh<DIM>::addElement(
+    const std::vector<std::size_t>& globalNodeIndexes, std::size_t owner,
+    bool owning, std::size_t id) {
     // some users don't want to see their elements added locally so don't mess
     // with the submesh here
     Element* newElement = ElementFactory::instance().makeElement(
-        globalNodeIndexes, nodeCoordinates_, owner, owning);
+        globalNodeIndexes, nodeCoordinates_, owner, owning, id);
     elements_.addRootEntry(newElement);
     newElement->setPositionInTree((--elements_.end()).getTreeEntry());
     return newElement;
@@ -163,27 +174,71 @@ void Mesh<DIM>::addSubElements(Base::Element* parent,
     }
 }
 
+template <std::size_t DIM>
+void Mesh<DIM>::removeSubElements(Base::Element* parent) {
+    // the mesh owns the tree entries, even though elements only expose them as
+    // constant
+    auto position =
+        const_cast<TreeEntry<Element*>*>(parent->getPositionInTree());
+    for (TreeEntry<Element*>* child : position->getChildren()) {
+        logger.assert_debug(child->isLeaf(),
+                            "Cannot remove sub-elements that are refined");
+        Element* subElement = child->getData();
+        for (std::size_t i = 0; i < subElement->getNumberOfNodes(); ++i) {
+            subElement->getNode(i)->removeElement(subElement);
+        }
+        delete subElement;
+    }
+    elements_.eraseChilds(
+        position->getIterator(Base::TreeTraversalMethod::ALLLEVEL));
+    parent->setRefinementMap(nullptr);
+}
+
 template <std::size_t DIM>
 bool Mesh<DIM>::addFace(Element* leftElementPtr,
                         std::size_t leftElementLocalFaceNo,
                         Element* rightElementPtr,
                         std::size_t rightElementLocalFaceNo,
                         const Geometry::FaceType& faceType) {
+    return addFace(leftElementPtr, leftElementLocalFaceNo, rightElementPtr,
+                   rightElementLocalFaceNo, faceType,
+                   GlobalUniqueIndex::instance().getFaceIndex());
+}
+
+template <std::size_t DIM>
+bool Mesh<DIM>::addFace(Element* leftElementPtr,
+                        std::size_t leftElementLocalFaceNo,
+                        Element* rightElementPtr,
+                        std::size_t rightElementLocalFaceNo,
+                        const Geometry::FaceType& faceType, std::size_t id) {
     Face* newFace = nullptr;
     logger.assert_debug(leftElementPtr != nullptr, "Invalid element passed");
     if (rightElementPtr == nullptr) {
         newFace = FaceFactory::instance().makeFace(
-            leftElementPtr, leftElementLocalFaceNo, faceType);
+            leftElementPtr, leftElementLocalFaceNo, faceType, id);
     } else {
         newFace = FaceFactory::instance().makeFace(
             leftElementPtr, leftElementLocalFaceNo, rightElementPtr,
-            rightElementLocalFaceNo);
+            rightElementLocalFaceNo, id);
     }
     faces_.addRootEntry(newFace);
     newFace->setPositionInTree((--faces_.end()).getTreeEntry());
     return true;
 }
 
+template <std::size_t DIM>
+bool Mesh<DIM>::addNonconformingFace(
+    Element* leftElementPtr, std::size_t leftElementLocalFaceNo,
+    Element* rightElementPtr, std::size_t rightElementLocalFaceNo,
+    const Geometry::MappingReferenceToReference<1>* nonconformingMapR) {
+    Face* newFace = FaceFactory::instance().makeFace(
+        leftElementPtr, leftElementLocalFaceNo, rightElementPtr,
+        rightElementLocalFaceNo, nonconformingMapR);
+    faces_.addRootEntry(newFace);
+    newFace->setPositionInTree((--faces_.end()).getTreeEntry());
+    return true;
+}
+
 template <std::size_t DIM>
 void Mesh<DIM>::addSubFaces(const Base::Face* parent,
                             const std::vector<Base::Face*> subFaces) {
@@ -199,12 +254,125 @@ void Mesh<DIM>::addSubFaces(const Base::Face* parent,
 
 template <std::size_t DIM>
 Edge* Mesh<DIM>::addEdge() {
-    Edge* newEdge = new Edge(GlobalUniqueIndex::instance().getEdgeIndex());
+    return addEdge(GlobalUniqueIndex::instance().getEdgeIndex());
+}
+
+template <std::size_t DIM>
+Edge* Mesh<DIM>::addEdge(std::size_t id) {
+    Edge* newEdge = new Edge(id);
     edges_.addRootEntry(newEdge);
     newEdge->setPositionInTree((--edges_.end()).getTreeEntry());
     return newEdge;
 }
 
+template <std::size_t DIM>
+void Mesh<DIM>::resetActiveMesh() {
+    faces_.setPreOrderTraversal();
+    for (Face* face : faces_) {
+        delete face;
+    }
+    edges_.setPreOrderTraversal();
+    for (Edge* edge : edges_) {
+        delete edge;
+    }
+    faces_.clear();
+    edges_.clear();
+    submeshes_.clear();
+    elements_.setPreOrderTraversal();
+    for (Element* element : elements_) {
+        element->clearFacesAndEdges();
+    }
+}
+
+template <std::size_t DIM>
+void Mesh<DIM>::sortAlongSpaceFillingCurve() {
+    if (elements_.empty()) {
+        return;
+    }
+    // Morton index of the centre of every element of the unrefined mesh
+    std::vector<std::pair<std::uint64_t, const Element*>> curvePositions;
+    std::vector<LinearAlgebra::SmallVector<DIM>> centers;
+    for (const TreeEntry<Element*>* entry : elements_.getRootEntries()) {
+        const Element* element = entry->getData();
+        const Geometry::PointReference<DIM>& center =
+            element->getReferenceGeometry()->getCenter();
+        centers.push_back(element->referenceToPhysical(center).getCoordinates());
+    }
+    LinearAlgebra::SmallVector<DIM> lowerCorner = centers[0];
+    LinearAlgebra::SmallVector<DIM> upperCorner = centers[0];
+    for (const LinearAlgebra::SmallVector<DIM>& center : centers) {
+        for (std::size_t i = 0; i < DIM; ++i) {
+            lowerCorner[i] = std::min(lowerCorner[i], center[i]);
+            upperCorner[i] = std::max(upperCorner[i], center[i]);
+        }
+    }
+    std::size_t i = 0;
+    for (const TreeEntry<Element*>* entry : elements_.getRootEntries()) {
+        curvePositions.emplace_back(
+            Utilities::computeMortonIndex(centers[i++], lowerCorner,
+                                          upperCorner),
+            entry->getData());
+    }
+    std::stable_sort(curvePositions.begin(), curvePositions.end(),
+                     [](const std::pair<std::uint64_t, const Element*>& a,
+                        const std::pair<std::uint64_t, const Element*>& b) {
+                         return a.first < b.first;
+                     });
+    std::unordered_map<const Element*, std::size_t> elementPositions;
+    for (std::size_t position = 0; position < curvePositions.size();
+         ++position) {
+        elementPositions[curvePositions[position].second] = position;
+    }
+    // Refined elements share the position of the element they were split from
+    auto getPosition = [&](const Element* element) {
+        const TreeEntry<Element*>* entry = element->getPositionInTree();
+        while (!entry->isRoot()) {
+            entry = entry->getParent();
+        }
+        return elementPositions.at(entry->getData());
+    };
+    auto getFacePosition = [&](const Face* face) {
+        std::size_t left = getPosition(face->getPtrElementLeft());
+        if (!face->isInternal()) {
+            return std::make_pair(left, left);
+        }
+        std::size_t right = getPosition(face->getPtrElementRight());
+        return std::make_pair(std::min(left, right), std::max(left, right));
+    };
+    auto getEdgePosition = [&](const Edge* edge) {
+        std::size_t position = std::numeric_limits<std::size_t>::max();
+        for (std::size_t j = 0; j < edge->getNumberOfElements(); ++j) {
+            position = std::min(position, getPosition(edge->getElement(j)));
+        }
+        return position;
+    };
+    auto getNodePosition = [&](const Node* node) {
+        std::size_t position = std::numeric_limits<std::size_t>::max();
+        for (std::size_t j = 0; j < node->getNumberOfElements(); ++j) {
+            position = std::min(position, getPosition(node->getElement(j)));
+        }
+        return position;
+    };
+    auto sortNodes = [&](std::vector<Node*>& nodes) {
+        std::stable_sort(nodes.begin(), nodes.end(),
+                         [&](const Node* a, const Node* b) {
+                             return getNodePosition(a) < getNodePosition(b);
+                         });
+    };
+    for (LevelTree<Element*>* elements :
+         {&elements_, &submeshes_.elements_}) {
+        elements->sortRootEntries(getPosition);
+    }
+    for (LevelTree<Face*>* faces : {&faces_, &submeshes_.faces_}) {
+        faces->sortRootEntries(getFacePosition);
+    }
+    for (LevelTree<Edge*>* edges : {&edges_, &submeshes_.edges_}) {
+        edges->sortRootEntries(getEdgePosition);
+    }
+    sortNodes(nodes_);
+    sortNodes(submeshes_.nodes_);
+}
+
 template <std::size_t DIM>
 void Mesh<DIM>::addNodeCoordinate(Geometry::PointPhysical<DIM> node) {
     nodeCoordinates_.push_back(node);
@@ -212,7 +380,12 @@ void Mesh<DIM>::addNodeCoordinate(Geometry::PointPhysical<DIM> node) {
 
 template <std::size_t DIM>
 Node* Mesh<DIM>::addNode() {
-    Node* node = new Node(GlobalUniqueIndex::instance().getNodeIndex());
+    return addNode(GlobalUniqueIndex::instance().getNodeIndex());
+}
+
+template <std::size_t DIM>
+Node* Mesh<DIM>::addNode(std::size_t id) {
+    Node* node = new Node(id);
     nodes_.push_back(node);
     return node;
 }
@@ -56,7 +56,31 @@ MPI_Datatype matchSizeInternal(int typeclass, int size) {
 #endif
 }  // namespace Detail
 
+namespace {
+// Number of groups requested through splitWorld, used on construction
+int requestedNumberOfGroups = 1;
+bool isConstructed = false;
+}  // namespace
+
+void MPIContainer::splitWorld(int numberOfGroups) {
+    logger.assert_always(!isConstructed,
+                         "The processors can only be split into groups before "
+                         "the MPIContainer is used");
+    logger.assert_always(numberOfGroups > 0,
+                         "Need at least one group of processors, got %",
+                         numberOfGroups);
+#ifndef HPGEM_USE_MPI
+    if (numberOfGroups > 1) {
+        logger(WARN, "Splitting into % groups needs MPI, using one group",
+               numberOfGroups);
+        numberOfGroups = 1;
+    }
+#endif
+    requestedNumberOfGroups = numberOfGroups;
+}
+
 MPIContainer::MPIContainer() {
+    isConstructed = true;
 #ifdef HPGEM_USE_MPI
 
     int flag;
@@ -68,7 +92,19 @@ MPIContainer::MPIContainer() {
     // this should be replaced by this comm.
 
     // Assume that we can clone the world comm without error.
-    MPI_Comm_dup(MPI_COMM_WORLD, &communicator_);
+    MPI_Comm_dup(MPI_COMM_WORLD, &worldCommunicator_);
+    MPI_Comm_set_errhandler(worldCommunicator_, MPI_ERRORS_ARE_FATAL);
+    int worldID, worldSize;
+    MPI_Comm_rank(worldCommunicator_, &worldID);
+    MPI_Comm_size(worldCommunicator_, &worldSize);
+    logger.assert_always(requestedNumberOfGroups <= worldSize,
+                         "Cannot split % processors into % groups", worldSize,
+                         requestedNumberOfGroups);
+    numberOfGroups_ = requestedNumberOfGroups;
+    // Contiguous blocks of ranks, so that a group is likely to share a node
+    groupID_ = static_cast<int>(static_cast<long>(worldID) * numberOfGroups_ /
+                                worldSize);
+    MPI_Comm_split(worldCommunicator_, groupID_, worldID, &communicator_);
     // Make sure that errors are fatal, thus absolving us from checking for
     // the return codes.
     MPI_Comm_set_errhandler(communicator_, MPI_ERRORS_ARE_FATAL);
@@ -78,6 +114,8 @@ MPIContainer::MPIContainer() {
 #else
     numberOfProcessors_ = 1;
     processorID_ = 0;
+    numberOfGroups_ = 1;
+    groupID_ = 0;
 #endif
 }
 
@@ -85,6 +123,10 @@ int MPIContainer::getNumberOfProcessors() { return numberOfProcessors_; }
 
 int MPIContainer::getProcessorID() { return processorID_; }
 
+int MPIContainer::getGroupID() { return groupID_; }
+
+int MPIContainer::getNumberOfGroups() { return numberOfGroups_; }
+
 #ifdef HPGEM_USE_MPI
 
 void MPIContainer::sendWrapper(const void *buf, int count,
@@ -116,6 +158,8 @@ void MPIContainer::reduceWrapper(void *buffer, int count, MPI_Datatype datatype,
 }
 
 MPI_Comm &MPIContainer::getComm() { return communicator_; }
+
+MPI_Comm &MPIContainer::getWorldComm() { return worldCommunicator_; }
 #endif
 
 }  // namespace Base
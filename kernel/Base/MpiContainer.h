@@ -111,6 +111,20 @@ class MPIContainer {
     /// get the total number of processors participating in this simulation
     int getNumberOfProcessors();
 
+    /// Split the processors into independent groups of (nearly) equal size,
+    /// each running its own replica of the computation. Processors are
+    /// assigned to groups in contiguous blocks of ranks. Afterwards all
+    /// communication through this container (and PETSc) is restricted to the
+    /// group of this processor. Must be called before the first call to
+    /// Instance().
+    static void splitWorld(int numberOfGroups);
+
+    /// get the index of the group this processor belongs to, see splitWorld
+    int getGroupID();
+
+    /// get the number of independent groups, see splitWorld
+    int getNumberOfGroups();
+
     /// pass a function that only has to be executed on one processor (that is
     /// not processor 0) this function cannot return anything, but it is allowed
     /// to alter its arguments
@@ -347,6 +361,54 @@ class MPIContainer {
 #endif
     }
 
+    /// send a vector of data to every processor and receive a vector of data
+    /// from every processor, without knowing in advance how much data will
+    /// arrive. All processors must call this function. \param toSend the data
+    /// for processor i is in toSend[i], this may be empty \return the data
+    /// that processor i sent to this processor is in position i
+    template <typename T>
+    std::vector<std::vector<T>> exchange(
+        const std::vector<std::vector<T>>& toSend) {
+        logger.assert_always(
+            toSend.size() == static_cast<std::size_t>(getNumberOfProcessors()),
+            "There should be data for each of the % processors, not for %",
+            getNumberOfProcessors(), toSend.size());
+#if HPGEM_USE_MPI
+        std::vector<int> sendCounts(toSend.size()),
+            sendOffsets(toSend.size()), receiveCounts(toSend.size()),
+            receiveOffsets(toSend.size());
+        std::vector<T> sendBuffer;
+        for (std::size_t i = 0; i < toSend.size(); ++i) {
+            sendOffsets[i] = static_cast<int>(sendBuffer.size());
+            sendCounts[i] = static_cast<int>(toSend[i].size());
+            sendBuffer.insert(sendBuffer.end(), toSend[i].begin(),
+                              toSend[i].end());
+        }
+        MPI_Alltoall(sendCounts.data(), 1, MPI_INT, receiveCounts.data(), 1,
+                     MPI_INT, communicator_);
+        int totalReceiveCount = 0;
+        for (std::size_t i = 0; i < toSend.size(); ++i) {
+            receiveOffsets[i] = totalReceiveCount;
+            totalReceiveCount += receiveCounts[i];
+        }
+        std::vector<T> receiveBuffer(totalReceiveCount);
+        MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendOffsets.data(),
+                      Detail::toMPIType(T()), receiveBuffer.data(),
+                      receiveCounts.data(), receiveOffsets.data(),
+                      Detail::toMPIType(T()), communicator_);
+        std::vector<std::vector<T>> received(toSend.size());
+        for (std::size_t i = 0; i < toSend.size(); ++i) {
+            received[i].assign(
+                receiveBuffer.begin() + receiveOffsets[i],
+                receiveBuffer.begin() + receiveOffsets[i] + receiveCounts[i]);
+        }
+        return received;
+#else
+        // we are the only processor if there is no MPI
+        return toSend;
+#endif
+    }
+
 #ifdef HPGEM_USE_MPI
 
     /// make sure a vector of data gets collected on one processor. This routine
@@ -397,6 +459,10 @@ class MPIContainer {
     /// that an unspecified amount of resources, such as asynchronous
     /// communication tags, is already in use by hpGEM
     MPI_Comm& getComm();
+
+    /// retrieve a communicator containing all processors of all groups, for
+    /// gathering the results of independent groups (see splitWorld)
+    MPI_Comm& getWorldComm();
 #endif
 
     MPIContainer(const MPIContainer& orig) = delete;
@@ -416,9 +482,12 @@ class MPIContainer {
     // Conforming with MPI types.
     int processorID_;
     int numberOfProcessors_;
+    int groupID_;
+    int numberOfGroups_;
 #ifdef HPGEM_USE_MPI
     std::vector<MPI_Request> pending_;
     MPI_Comm communicator_;
+    MPI_Comm worldCommunicator_;
 #endif
 };
 
@@ -63,6 +63,16 @@ void Base::Node::addElement(Element *element, std::size_t localNodeNumber) {
     }
 }
 
+void Base::Node::removeElement(const Element *element) {
+    auto position = std::find(elements_.begin(), elements_.end(), element);
+    logger.assert_always(position != elements_.end(),
+                         "Element % is not adjacent to this node",
+                         element->getID());
+    localNodeNumbers_.erase(localNodeNumbers_.begin() +
+                            (position - elements_.begin()));
+    elements_.erase(position);
+}
+
 Base::Element *Base::Node::getElement(std::size_t i) {
     logger.assert_debug(i < getNumberOfElements(),
                         "asked for element %, but there are only % elements", i,
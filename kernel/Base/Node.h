@@ -75,6 +75,10 @@ class Node {
 
     void addElement(Element *element, std::size_t localNodeNumber);
 
+    /// Disconnect an element from this node, for example because it was
+    /// removed while coarsening the mesh.
+    void removeElement(const Element *element);
+
     ///\deprecated Does not conform naming conventions, use
     /// getLocalNumberOfBasisFunctions instead
     std::size_t getLocalNrOfBasisFunctions() const {
@@ -619,8 +619,14 @@ inline void PhysicalElement<DIM>::setPointReference(
 
 template <std::size_t DIM>
 inline void PhysicalElement<DIM>::setElement(const Element* element) {
+    // compare with the size of the buffers, the previous element may have been
+    // deleted in the meantime (e.g. when the mesh is adapted)
+    std::size_t numberOfBufferedBasisFunctions = 0;
+    for (const std::vector<double>& values : basisFunctionValue) {
+        numberOfBufferedBasisFunctions += values.size();
+    }
     if (!hasElement || element->getTotalNumberOfBasisFunctions() !=
-                           theElement_->getTotalNumberOfBasisFunctions()) {
+                           numberOfBufferedBasisFunctions) {
         basisFunctionValue.resize(element->getNumberOfUnknowns());
         vectorBasisFunctionValue.resize(element->getNumberOfUnknowns());
         basisFunctionDeriv_.resize(element->getNumberOfUnknowns());
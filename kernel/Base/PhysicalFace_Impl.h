@@ -914,7 +914,22 @@ inline void PhysicalFace<DIM>::setFace(const Face* face) {
                         "This face is not supported by this physical face");
     std::size_t numberOfUnknowns =
         face->getPtrElementLeft()->getNumberOfUnknowns();
-    if (!hasFace) {
+    // The elements of different faces may have different polynomial orders, so
+    // compare with the size of the buffers.
+    bool hasMatchingBuffers = hasFace;
+    for (std::size_t i = 0; i < numberOfUnknowns && hasMatchingBuffers; ++i) {
+        std::size_t numberOfLeftBasisFunctions =
+            face->getPtrElementLeft()->getNumberOfBasisFunctions(i);
+        std::size_t numberOfBasisFunctions =
+            numberOfLeftBasisFunctions +
+            (isInternal_
+                 ? face->getPtrElementRight()->getNumberOfBasisFunctions(i)
+                 : 0);
+        hasMatchingBuffers =
+            nLeftBasisFunctions[i] == numberOfLeftBasisFunctions &&
+            basisFunctionNormal_[i].size() == numberOfBasisFunctions;
+    }
+    if (!hasMatchingBuffers) {
         std::size_t leftCoefficients =
             face->getPtrElementLeft()->getTotalNumberOfBasisFunctions();
         nLeftBasisFunctions.resize(numberOfUnknowns);
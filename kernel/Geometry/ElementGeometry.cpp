@@ -61,6 +61,7 @@
 #include "Mappings/MappingToPhysSimplexLinear.h"
 #include "Mappings/MappingToPhysPyramid.h"
 #include "Mappings/MappingToPhysTriangularPrism.h"
+#include "Mappings/MappingToPhysLagrange.h"
 
 #include "PointReference.h"
 
@@ -101,7 +102,8 @@ ElementGeometry::ElementGeometry(const ElementGeometry& other)
                 static_cast<PhysicalGeometry<1>*>(other.physicalGeometry_)
                     ->getNodeCoordinates(),
                 referenceGeometry_);
-            referenceToPhysicalMapping_ = createMappings<1>(
+            referenceToPhysicalMapping_ = copyMapping<1>(
+                other.referenceToPhysicalMapping_,
                 other.physicalGeometry_->getNodeIndexes().size(),
                 static_cast<PhysicalGeometry<1>*>(physicalGeometry_));
             break;
@@ -112,7 +114,8 @@ ElementGeometry::ElementGeometry(const ElementGeometry& other)
                 static_cast<PhysicalGeometry<2>*>(other.physicalGeometry_)
                     ->getNodeCoordinates(),
                 referenceGeometry_);
-            referenceToPhysicalMapping_ = createMappings<2>(
+            referenceToPhysicalMapping_ = copyMapping<2>(
+                other.referenceToPhysicalMapping_,
                 other.physicalGeometry_->getNodeIndexes().size(),
                 static_cast<PhysicalGeometry<2>*>(physicalGeometry_));
             break;
@@ -125,7 +128,8 @@ ElementGeometry::ElementGeometry(const ElementGeometry& other)
                 static_cast<PhysicalGeometry<3>*>(other.physicalGeometry_)
                     ->getNodeCoordinates(),
                 referenceGeometry_);
-            referenceToPhysicalMapping_ = createMappings<3>(
+            referenceToPhysicalMapping_ = copyMapping<3>(
+                other.referenceToPhysicalMapping_,
                 other.physicalGeometry_->getNodeIndexes().size(),
                 static_cast<PhysicalGeometry<3>*>(physicalGeometry_));
             break;
@@ -135,7 +139,8 @@ ElementGeometry::ElementGeometry(const ElementGeometry& other)
                 static_cast<PhysicalGeometry<4>*>(other.physicalGeometry_)
                     ->getNodeCoordinates(),
                 referenceGeometry_);
-            referenceToPhysicalMapping_ = createMappings<4>(
+            referenceToPhysicalMapping_ = copyMapping<4>(
+                other.referenceToPhysicalMapping_,
                 other.physicalGeometry_->getNodeIndexes().size(),
                 static_cast<PhysicalGeometry<4>*>(physicalGeometry_));
             break;
@@ -160,6 +165,15 @@ MappingReferenceToPhysical* ElementGeometry::getReferenceToPhysicalMap() {
     return referenceToPhysicalMapping_;
 }
 
+void ElementGeometry::setReferenceToPhysicalMap(
+    MappingReferenceToPhysical* mapping) {
+    logger.assert_debug(mapping != nullptr, "Invalid mapping passed");
+    if (mapping != referenceToPhysicalMapping_) {
+        delete referenceToPhysicalMapping_;
+        referenceToPhysicalMapping_ = mapping;
+    }
+}
+
 /// Returns a pointer to the physicalGeometry object.
 
 const PhysicalGeometryBase* ElementGeometry::getPhysicalGeometry() const {
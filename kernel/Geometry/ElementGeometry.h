@@ -69,6 +69,7 @@
 #include "Mappings/MappingToPhysSimplexLinear.h"
 #include "Mappings/MappingToPhysPyramid.h"
 #include "Mappings/MappingToPhysTriangularPrism.h"
+#include "Mappings/MappingToPhysLagrange.h"
 
 #include "PointReference.h"
 
@@ -102,6 +103,11 @@ class ElementGeometry {
     const MappingReferenceToPhysical* getReferenceToPhysicalMap() const;
     MappingReferenceToPhysical* getReferenceToPhysicalMap();
 
+    /// Replace the mapping from the reference geometry to physical space, for
+    /// example by a curved MappingToPhysLagrange. This geometry takes
+    /// ownership of the mapping.
+    void setReferenceToPhysicalMap(MappingReferenceToPhysical* mapping);
+
     /// Returns a pointer to the physicalGeometry object.
     const PhysicalGeometryBase* getPhysicalGeometry() const;
 
@@ -123,6 +129,12 @@ class ElementGeometry {
     /// Returns a pointer to the refinementMapping object.
     const RefinementMapping* getRefinementMap() const;
 
+    /// Sets the refinementMapping that was used to split this element into
+    /// its children, or nullptr if the element is not refined (anymore).
+    void setRefinementMap(const RefinementMapping* refinementMap) {
+        refinementMap_ = refinementMap;
+    }
+
     /// This method gets a PointReference, which specifies a coordinate in the
     /// ReferenceGeometry, and returns a PointPhysical which is the
     /// corresponding point in the PhysicalGeometry, given the mapping.
@@ -165,6 +177,12 @@ class ElementGeometry {
     static MappingReferenceToPhysical* createMappings(
         std::size_t size, const PhysicalGeometry<DIM>* const pGeo);
 
+    /// Linear mapping for pGeo, or a copy of other if that is curved
+    template <std::size_t DIM>
+    static MappingReferenceToPhysical* copyMapping(
+        const MappingReferenceToPhysical* other, std::size_t size,
+        const PhysicalGeometry<DIM>* const pGeo);
+
    protected:
     /// The corresponding referenceGeometry object, for integration.
     ReferenceGeometry* const referenceGeometry_;
@@ -178,7 +196,7 @@ class ElementGeometry {
     MappingReferenceToPhysical* referenceToPhysicalMapping_;
 
     /// The corresponding refinementGeometry object
-    RefinementMapping* refinementMap_;
+    const RefinementMapping* refinementMap_;
 };
 
 /// This method gets a PointReference, which specifies a coordinate in the
@@ -346,6 +364,17 @@ inline MappingReferenceToPhysical* ElementGeometry::createMappings(
     return new Geometry::MappingToPhysHypercubeLinear<4>(pGeo);
 }
 
+template <std::size_t DIM>
+MappingReferenceToPhysical* ElementGeometry::copyMapping(
+    const MappingReferenceToPhysical* other, std::size_t size,
+    const PhysicalGeometry<DIM>* const pGeo) {
+    auto curved = dynamic_cast<const MappingToPhysLagrange<DIM>*>(other);
+    if (curved != nullptr) {
+        return new MappingToPhysLagrange<DIM>(*curved, pGeo);
+    }
+    return createMappings<DIM>(size, pGeo);
+}
+
 template <std::size_t DIM>
 ElementGeometry::ElementGeometry(
     const std::vector<std::size_t>& globalNodeIndexes,
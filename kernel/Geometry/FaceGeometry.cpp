@@ -77,6 +77,7 @@ FaceGeometry::FaceGeometry(ElementGeometry* ptrElemL,
       localFaceNumberLeft_(localFaceNumberL),
       localFaceNumberRight_(localFaceNumberR),
       faceToFaceMapIndex_(Geometry::MAXSIZET),
+      nonconformingMapR_(nullptr),
       faceType_(FaceType::INTERNAL),
       diameter_(-1) {
     logger.assert_debug(ptrElemL != nullptr, "Invalid main element passed");
@@ -84,6 +85,25 @@ FaceGeometry::FaceGeometry(ElementGeometry* ptrElemL,
                         "This constructor is intended for internal faces");
 }
 
+FaceGeometry::FaceGeometry(
+    ElementGeometry* ptrElemL, const std::size_t& localFaceNumberL,
+    ElementGeometry* ptrElemR, const std::size_t& localFaceNumberR,
+    const MappingReferenceToReference<1>* nonconformingMapR)
+    : leftElementGeom_(ptrElemL),
+      rightElementGeom_(ptrElemR),
+      localFaceNumberLeft_(localFaceNumberL),
+      localFaceNumberRight_(localFaceNumberR),
+      faceToFaceMapIndex_(Geometry::MAXSIZET),
+      nonconformingMapR_(nonconformingMapR),
+      faceType_(FaceType::INTERNAL),
+      diameter_(-1) {
+    logger.assert_debug(ptrElemL != nullptr, "Invalid main element passed");
+    logger.assert_debug(ptrElemR != nullptr,
+                        "This constructor is intended for internal faces");
+    logger.assert_debug(nonconformingMapR != nullptr,
+                        "Invalid mapping to the right element passed");
+}
+
 //! Constructor for boundary faces.
 FaceGeometry::FaceGeometry(ElementGeometry* ptrElemL,
                            const std::size_t& localFaceNumberL,
@@ -93,6 +113,7 @@ FaceGeometry::FaceGeometry(ElementGeometry* ptrElemL,
       localFaceNumberLeft_(localFaceNumberL),
       localFaceNumberRight_(Geometry::MAXSIZET),
       faceToFaceMapIndex_(0),
+      nonconformingMapR_(nullptr),
       faceType_(boundaryLabel),
       diameter_(-1) {
     logger.assert_debug(ptrElemL != nullptr, "Invalid main element passed");
@@ -109,6 +130,7 @@ FaceGeometry::FaceGeometry(const FaceGeometry& other, ElementGeometry* ptrElemL,
     localFaceNumberLeft_ = localFaceNumberL;
     localFaceNumberRight_ = localFaceNumberR;
     faceToFaceMapIndex_ = other.faceToFaceMapIndex_;
+    nonconformingMapR_ = other.nonconformingMapR_;
     faceType_ = other.faceType_;
 }
 
@@ -135,6 +157,11 @@ std::shared_ptr<const MappingReferenceToReference<1> >
 //! Return a mapping to the right reference element.
 std::shared_ptr<const MappingReferenceToReference<1> >
     FaceGeometry::refFaceToRefElemMapR() const {
+    if (nonconformingMapR_ != nullptr) {
+        // the nonconforming mappings are shared and are never deleted
+        return std::shared_ptr<const MappingReferenceToReference<1> >(
+            nonconformingMapR_, [](const MappingReferenceToReference<1>*) {});
+    }
     const MappingReferenceToReference<0>* const m1Ptr =
         this->getReferenceGeometry()->getCodim0MappingPtr(faceToFaceMapIndex_);
     const MappingReferenceToReference<1>* const m2Ptr =
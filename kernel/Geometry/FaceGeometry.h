@@ -210,6 +210,16 @@ class FaceGeometry {
     FaceGeometry(ElementGeometry* ptrElemL, const std::size_t& localFaceNumberL,
                  const FaceType& boundaryLabel);
 
+    /// Constructor for interior faces that only cover part of the face of the
+    /// right element, because the right element is coarser than the left
+    /// element. The given mapping maps the reference face onto the reference
+    /// geometry of the right element and is used instead of a face to face
+    /// mapping.
+    FaceGeometry(ElementGeometry* ptrElemL, const std::size_t& localFaceNumberL,
+                 ElementGeometry* ptrElemRight,
+                 const std::size_t& localFaceNumberR,
+                 const MappingReferenceToReference<1>* nonconformingMapR);
+
     /// Copy constructor with new elements, for both internal and boundary
     /// faces.
     FaceGeometry(const FaceGeometry& other, ElementGeometry* ptrElemL,
@@ -254,7 +264,15 @@ class FaceGeometry {
         }
     }
 
-    std::size_t getFaceToFaceMapIndex() const { return faceToFaceMapIndex_; }
+    std::size_t getFaceToFaceMapIndex() const {
+        logger.assert_debug(!isNonconforming(),
+                            "A nonconforming face has no face to face mapping");
+        return faceToFaceMapIndex_;
+    }
+
+    /// \brief Returns true if the face only covers part of the face of the
+    /// right element, that is, if there is a hanging node.
+    bool isNonconforming() const { return nonconformingMapR_ != nullptr; }
 
     const ReferenceGeometry* getReferenceGeometry() const;
 
@@ -338,6 +356,10 @@ class FaceGeometry {
     /// Index corresponding to a face-to-face mapping.
     std::size_t faceToFaceMapIndex_;
 
+    /// Mapping to the right element for nonconforming faces, nullptr
+    /// otherwise.
+    const MappingReferenceToReference<1>* nonconformingMapR_;
+
     /// Type of face (internal, boundary, ...)
     FaceType faceType_;
 
@@ -368,7 +390,9 @@ PointReference<DIM + 1> FaceGeometry::mapRefFaceToRefElemR(
     // point transformed from the right side of the face onto the
     // right element is the same as the one on the left side of the
     // face, we have to use the refFace2RefFace mapping.
-
+    if (nonconformingMapR_ != nullptr) {
+        return nonconformingMapR_->transform(pRefFace);
+    }
     return rightElementGeom_->getReferenceGeometry()
         ->getCodim1MappingPtr(localFaceNumberRight_)
         ->transform(mapRefFaceToRefFace(pRefFace));
@@ -379,6 +403,8 @@ PointReference<DIM + 1> FaceGeometry::mapRefFaceToRefElemR(
 template <std::size_t DIM>
 PointReference<DIM> FaceGeometry::mapRefFaceToRefFace(
     const PointReference<DIM>& pIn) const {
+    logger.assert_debug(!isNonconforming(),
+                        "A nonconforming face has no face to face mapping");
     return getReferenceGeometry()
         ->getCodim0MappingPtr(faceToFaceMapIndex_)
         ->transform(pIn);
@@ -132,6 +132,10 @@ class MappingReferenceToPhysical : public MappingInterface<0> {
     /// computing.
     virtual void reinit() = 0;
 
+    /// Whether the mapping is affine, so that its Jacobian is the same in every
+    /// point of the reference geometry.
+    virtual bool isAffine() const { return false; }
+
    protected:
     const PhysicalGeometryBase* geometry;  /// Pointer to the physical geometry
                                            /// (for reinitialisation)
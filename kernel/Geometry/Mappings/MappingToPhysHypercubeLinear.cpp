@@ -200,6 +200,12 @@ void MappingToPhysHypercubeLinear<2>::reinit() {
     a2 *= 0.5;
 }
 
+bool MappingToPhysHypercubeLinear<2>::isAffine() const {
+    // the bilinear term vanishes, relative to the size of the element
+    return Base::L2Norm(a12) <=
+           1e-12 * (Base::L2Norm(a1) + Base::L2Norm(a2));
+}
+
 bool MappingToPhysHypercubeLinear<2>::isValidPoint(
     const PointReference<2>& pointReference) const {
     return !((pointReference[0] < -1.) || (pointReference[0] > 1.) ||
@@ -303,6 +309,15 @@ void MappingToPhysHypercubeLinear<3>::reinit() {
     a123 = 0.125 * (p1 - p0 + p2 - p3 + p4 - p5 + p7 - p6);
 }
 
+bool MappingToPhysHypercubeLinear<3>::isAffine() const {
+    // the bilinear and trilinear terms vanish, relative to the size of the
+    // element
+    double size = Base::L2Norm(a1) + Base::L2Norm(a2) + Base::L2Norm(a3);
+    return Base::L2Norm(a12) + Base::L2Norm(a13) + Base::L2Norm(a23) +
+               Base::L2Norm(a123) <=
+           1e-12 * size;
+}
+
 bool MappingToPhysHypercubeLinear<3>::isValidPoint(
     const PointReference<3>& pointReference) const {
     logger.assert_debug(pointReference.size() == 3,
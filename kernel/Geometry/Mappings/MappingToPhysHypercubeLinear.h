@@ -72,6 +72,7 @@ class MappingToPhysHypercubeLinear<1> : public MappingReferenceToPhysical {
     Jacobian<1, 1> calcJacobian(const PointReference<1> &) const final;
     void reinit() final;
     std::size_t getTargetDimension() const final { return 1; }
+    bool isAffine() const final { return true; }
 
    private:
     bool isValidPoint(const PointReference<1> &) const;
@@ -92,6 +93,8 @@ class MappingToPhysHypercubeLinear<2> : public MappingReferenceToPhysical {
     Jacobian<2, 2> calcJacobian(const PointReference<2> &) const final;
     void reinit() final;
     std::size_t getTargetDimension() const final { return 2; }
+    /// only affine if the quadrilateral is a parallelogram
+    bool isAffine() const final;
 
    private:
     bool isValidPoint(const PointReference<2> &) const;
@@ -112,6 +115,8 @@ class MappingToPhysHypercubeLinear<3> : public MappingReferenceToPhysical {
     Jacobian<3, 3> calcJacobian(const PointReference<3> &) const final;
     void reinit() final;
     std::size_t getTargetDimension() const final { return 3; }
+    /// only affine if the hexahedron is a parallelepiped
+    bool isAffine() const final;
 
    private:
     bool isValidPoint(const PointReference<3> &) const;
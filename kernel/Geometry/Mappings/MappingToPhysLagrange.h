@@ -0,0 +1,212 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HPGEM_KERNEL_MAPPINGTOPHYSLAGRANGE_H
+#define HPGEM_KERNEL_MAPPINGTOPHYSLAGRANGE_H
+
+#include "MappingReferenceToPhysical.h"
+#include "Geometry/PointPhysical.h"
+#include "Geometry/PointReference.h"
+#include "Geometry/PhysicalGeometry.h"
+#include "Geometry/ReferenceGeometry.h"
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace hpgem {
+namespace Geometry {
+/*!
+ * Curved (isoparametric or subparametric) mapping from the reference element
+ * to physical space. The mapping interpolates a set of geometry nodes with
+ * Lagrange polynomials of a given order, so x(xi) = sum_i N_i(xi) x_i. The
+ * geometry nodes are the points of the equidistant lattice of that order on
+ * the reference element:
+ *  - lines, squares and cubes: the tensor product of the points
+ *    -1 + 2k/order, numbered with the first coordinate running fastest
+ *  - triangles and tetrahedra: the points (i, j, k)/order with
+ *    i + j + k <= order, also numbered with the first coordinate running
+ *    fastest
+ * so order 1 gives the vertices in the order of the reference geometry, and
+ * the same mapping as MappingToPhysHypercubeLinear and
+ * MappingToPhysSimplexLinear. Prisms, pyramids and hypercubes are not
+ * supported.
+ *
+ * A new mapping has straight sides: the geometry nodes are the images of the
+ * lattice points under the linear mapping of the vertices. Curved elements are
+ * made by moving geometry nodes with setGeometryNode, for example with nodes
+ * read from a file or projected to the boundary of the domain. The mapping
+ * stores the offset of each geometry node from its straight sided position,
+ * so reinit (after the vertices moved) keeps the curvature.
+ *
+ * Most of the cost of evaluating the mapping is in the Lagrange polynomials,
+ * which only depend on the reference geometry, the order and the reference
+ * point. All mappings with the same reference geometry and order therefore
+ * share one table with the lattice of geometry nodes and the values and
+ * derivatives of the Lagrange polynomials at the points where the mapping has
+ * been evaluated. The integration routines always evaluate at the points of a
+ * few quadrature rules, so the table holds an entry per quadrature point in
+ * use, for the whole mesh. Points are identified by their exact coordinates
+ * and at most maximumTableSize points are kept per table. What remains per
+ * evaluation is the sum over the geometry nodes of the element.
+ */
+template <std::size_t DIM>
+class MappingToPhysLagrange : public MappingReferenceToPhysical {
+   public:
+    /// Straight sided mapping of the given order
+    MappingToPhysLagrange(const PhysicalGeometry<DIM>* const& pG,
+                          std::size_t order);
+
+    MappingToPhysLagrange(const MappingToPhysLagrange<DIM>& other) = default;
+
+    /// Copy of other for another (copy of the) physical geometry
+    MappingToPhysLagrange(const MappingToPhysLagrange<DIM>& other,
+                          const PhysicalGeometry<DIM>* const& pG);
+
+    PointPhysical<DIM> transform(const PointReference<DIM>&) const final;
+
+    /// Newton iteration, starting from the centre of the reference geometry
+    PointReference<DIM> inverseTransform(const PointPhysical<DIM>&) const final;
+    Jacobian<DIM, DIM> calcJacobian(const PointReference<DIM>&) const final;
+    void reinit() final;
+    std::size_t getTargetDimension() const final { return DIM; }
+
+    /// Polynomial order of the mapping
+    std::size_t getOrder() const { return table_->order; }
+
+    std::size_t getNumberOfGeometryNodes() const {
+        return table_->referenceNodes.size();
+    }
+
+    /// Location of geometry node i in the reference geometry
+    const PointReference<DIM>& getReferenceGeometryNode(std::size_t i) const {
+        logger.assert_debug(i < getNumberOfGeometryNodes(),
+                            "Asked for geometry node %, but there are only %",
+                            i, getNumberOfGeometryNodes());
+        return table_->referenceNodes[i];
+    }
+
+    /// Location of geometry node i in physical space
+    const PointPhysical<DIM>& getGeometryNode(std::size_t i) const {
+        logger.assert_debug(i < getNumberOfGeometryNodes(),
+                            "Asked for geometry node %, but there are only %",
+                            i, getNumberOfGeometryNodes());
+        return nodes_[i];
+    }
+
+    /// Move geometry node i to the given physical location
+    void setGeometryNode(std::size_t i, const PointPhysical<DIM>& node);
+
+    /// The vertices of the reference geometry that span the smallest vertex,
+    /// edge, face or element that contains geometry node i. A geometry node
+    /// lies on a face of the element exactly when all these vertices are
+    /// vertices of that face.
+    std::vector<std::size_t> getGeometryNodeVertices(std::size_t i) const;
+
+    /// Number of reference points for which the values of the Lagrange
+    /// polynomials are kept, per reference geometry and order
+    static const std::size_t maximumTableSize = 1024;
+
+   private:
+    /// Values and derivatives of the Lagrange polynomials of all geometry
+    /// nodes at one reference point
+    struct ShapeFunctionValues {
+        std::vector<double> values;
+        std::vector<LinearAlgebra::SmallVector<DIM>> derivatives;
+    };
+
+    struct CoordinateHash {
+        std::size_t operator()(const std::array<double, DIM>& key) const {
+            std::size_t result = 0;
+            for (double coordinate : key) {
+                result = result * 31 + std::hash<double>()(coordinate);
+            }
+            return result;
+        }
+    };
+
+    /// Everything that only depends on the reference geometry and the order,
+    /// shared by all mappings with the same reference geometry and order.
+    /// Entries of the map are never removed, so references to them stay valid
+    /// after the mutex is released.
+    struct LagrangeTable {
+        ReferenceGeometryType geometryType;
+        std::size_t order;
+        /// position of each geometry node in the lattice
+        std::vector<std::array<std::size_t, DIM>> latticeIndices;
+        std::vector<PointReference<DIM>> referenceNodes;
+
+        std::mutex mutex;
+        std::unordered_map<std::array<double, DIM>, ShapeFunctionValues,
+                           CoordinateHash>
+            shapeFunctions;
+
+        bool isSimplex() const;
+
+        /// Values and derivatives of the Lagrange polynomials at the point
+        void evaluate(const PointReference<DIM>& point,
+                      ShapeFunctionValues& result) const;
+    };
+
+    /// The table for the given reference geometry and order, it is created on
+    /// first use and lives until the end of the program
+    static LagrangeTable* getTable(ReferenceGeometryType geometryType,
+                                   std::size_t order);
+
+    /// The point and the Jacobian for the given shape function values
+    void combine(const ShapeFunctionValues& shapeFunctions,
+                 PointPhysical<DIM>* point, Jacobian<DIM, DIM>* jacobian) const;
+
+    /// The point and/or the Jacobian at the given point, using the table
+    void evaluate(const PointReference<DIM>& point, PointPhysical<DIM>* result,
+                  Jacobian<DIM, DIM>* jacobian) const;
+
+    /// Image of a reference point under the linear mapping of the vertices
+    PointPhysical<DIM> transformLinear(const PointReference<DIM>& point) const;
+
+    LagrangeTable* table_;
+
+    /// offset of each geometry node from its straight sided position
+    std::vector<LinearAlgebra::SmallVector<DIM>> offsets_;
+    std::vector<PointPhysical<DIM>> nodes_;
+};
+}  // namespace Geometry
+}  // namespace hpgem
+#include "MappingToPhysLagrange_Impl.h"
+
+#endif  // HPGEM_KERNEL_MAPPINGTOPHYSLAGRANGE_H
@@ -0,0 +1,402 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HPGEM_KERNEL_MAPPINGTOPHYSLAGRANGE_IMPL_H
+#define HPGEM_KERNEL_MAPPINGTOPHYSLAGRANGE_IMPL_H
+
+#include "Geometry/Jacobian.h"
+
+#include <map>
+#include <memory>
+
+namespace hpgem {
+namespace Geometry {
+
+template <std::size_t DIM>
+typename MappingToPhysLagrange<DIM>::LagrangeTable*
+    MappingToPhysLagrange<DIM>::getTable(ReferenceGeometryType geometryType,
+                                         std::size_t order) {
+    static std::mutex tablesMutex;
+    static std::map<std::pair<ReferenceGeometryType, std::size_t>,
+                    std::unique_ptr<LagrangeTable>>
+        tables;
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    std::unique_ptr<LagrangeTable>& table = tables[{geometryType, order}];
+    if (table) {
+        return table.get();
+    }
+    logger.assert_always(order > 0, "A mapping needs at least order 1");
+    logger.assert_always(geometryType == ReferenceGeometryType::LINE ||
+                             geometryType == ReferenceGeometryType::SQUARE ||
+                             geometryType == ReferenceGeometryType::CUBE ||
+                             geometryType == ReferenceGeometryType::TRIANGLE ||
+                             geometryType == ReferenceGeometryType::TETRAHEDRON,
+                         "Curved mappings are not implemented for this "
+                         "reference geometry");
+    table.reset(new LagrangeTable());
+    table->geometryType = geometryType;
+    table->order = order;
+    // Run through the lattice of the cube with the first coordinate running
+    // fastest, and keep the points in the simplex for a triangle or
+    // tetrahedron
+    const double q = static_cast<double>(order);
+    std::size_t numberOfCubeNodes = 1;
+    for (std::size_t i = 0; i < DIM; ++i) {
+        numberOfCubeNodes *= order + 1;
+    }
+    for (std::size_t node = 0; node < numberOfCubeNodes; ++node) {
+        std::array<std::size_t, DIM> index;
+        std::size_t remainder = node, sum = 0;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            index[i] = remainder % (order + 1);
+            remainder /= order + 1;
+            sum += index[i];
+        }
+        PointReference<DIM> referenceNode;
+        if (table->isSimplex()) {
+            if (sum > order) continue;
+            for (std::size_t i = 0; i < DIM; ++i) {
+                referenceNode[i] = static_cast<double>(index[i]) / q;
+            }
+        } else {
+            for (std::size_t i = 0; i < DIM; ++i) {
+                referenceNode[i] = -1. + 2. * static_cast<double>(index[i]) / q;
+            }
+        }
+        table->latticeIndices.push_back(index);
+        table->referenceNodes.push_back(referenceNode);
+    }
+    return table.get();
+}
+
+template <std::size_t DIM>
+MappingToPhysLagrange<DIM>::MappingToPhysLagrange(
+    const PhysicalGeometry<DIM>* const& pG, std::size_t order)
+    : MappingReferenceToPhysical(pG),
+      table_(getTable(pG->getRefGeometry()->getGeometryType(), order)) {
+    logger.assert_debug(pG != nullptr, "Invalid physical geometry passed");
+    offsets_.resize(table_->referenceNodes.size());
+    reinit();
+}
+
+template <std::size_t DIM>
+MappingToPhysLagrange<DIM>::MappingToPhysLagrange(
+    const MappingToPhysLagrange<DIM>& other,
+    const PhysicalGeometry<DIM>* const& pG)
+    : MappingReferenceToPhysical(pG),
+      table_(other.table_),
+      offsets_(other.offsets_) {
+    logger.assert_debug(pG != nullptr, "Invalid physical geometry passed");
+    reinit();
+}
+
+template <std::size_t DIM>
+bool MappingToPhysLagrange<DIM>::LagrangeTable::isSimplex() const {
+    return geometryType == ReferenceGeometryType::TRIANGLE ||
+           geometryType == ReferenceGeometryType::TETRAHEDRON;
+}
+
+template <std::size_t DIM>
+PointPhysical<DIM> MappingToPhysLagrange<DIM>::transformLinear(
+    const PointReference<DIM>& point) const {
+    PointPhysical<DIM> result;
+    for (std::size_t vertex = 0; vertex < geometry->getNumberOfNodes();
+         ++vertex) {
+        // barycentric coordinates for simplices, products of (1 -+ xi)/2 for
+        // the vertex at -+1 for cubes
+        double weight = 1.;
+        if (table_->isSimplex()) {
+            if (vertex == 0) {
+                for (std::size_t i = 0; i < DIM; ++i) {
+                    weight -= point[i];
+                }
+            } else {
+                weight = point[vertex - 1];
+            }
+        } else {
+            for (std::size_t i = 0; i < DIM; ++i) {
+                weight *= ((vertex >> i) & 1) ? (1. + point[i]) / 2.
+                                              : (1. - point[i]) / 2.;
+            }
+        }
+        const PointPhysical<DIM>& vertexCoordinates =
+            geometry->getLocalNodeCoordinates(vertex);
+        result.axpy(weight, vertexCoordinates);
+    }
+    return result;
+}
+
+template <std::size_t DIM>
+void MappingToPhysLagrange<DIM>::LagrangeTable::evaluate(
+    const PointReference<DIM>& point, ShapeFunctionValues& result) const {
+    const std::size_t numberOfNodes = referenceNodes.size();
+    const double q = static_cast<double>(order);
+    std::vector<double>& values = result.values;
+    std::vector<LinearAlgebra::SmallVector<DIM>>& derivatives =
+        result.derivatives;
+    values.assign(numberOfNodes, 1.);
+    derivatives.assign(numberOfNodes, LinearAlgebra::SmallVector<DIM>());
+    if (isSimplex()) {
+        // The Lagrange polynomial of the node with barycentric lattice
+        // coordinates (a_0, ..., a_DIM) is the product over b of
+        // P_{a_b}(lambda_b), with P_a(lambda) = prod_{j<a} (q lambda - j)/(j+1)
+        std::array<std::vector<double>, DIM + 1> factor, factorDerivative;
+        for (std::size_t b = 0; b <= DIM; ++b) {
+            double lambda = 1.;
+            if (b == 0) {
+                for (std::size_t i = 0; i < DIM; ++i) {
+                    lambda -= point[i];
+                }
+            } else {
+                lambda = point[b - 1];
+            }
+            factor[b].assign(order + 1, 1.);
+            factorDerivative[b].assign(order + 1, 0.);
+            for (std::size_t a = 0; a < order; ++a) {
+                const double scale = q * lambda - static_cast<double>(a);
+                const double denominator = static_cast<double>(a + 1);
+                factor[b][a + 1] = factor[b][a] * scale / denominator;
+                factorDerivative[b][a + 1] =
+                    (factorDerivative[b][a] * scale + factor[b][a] * q) /
+                    denominator;
+            }
+        }
+        for (std::size_t node = 0; node < numberOfNodes; ++node) {
+            std::array<std::size_t, DIM + 1> a;
+            a[0] = order;
+            for (std::size_t i = 0; i < DIM; ++i) {
+                a[i + 1] = latticeIndices[node][i];
+                a[0] -= a[i + 1];
+            }
+            for (std::size_t b = 0; b <= DIM; ++b) {
+                values[node] *= factor[b][a[b]];
+            }
+            // lambda_0 depends on all coordinates, lambda_{i+1} only on xi_i
+            for (std::size_t i = 0; i < DIM; ++i) {
+                double fromOwn = factorDerivative[i + 1][a[i + 1]];
+                double fromFirst = -factorDerivative[0][a[0]];
+                for (std::size_t b = 0; b <= DIM; ++b) {
+                    if (b != i + 1) fromOwn *= factor[b][a[b]];
+                    if (b != 0) fromFirst *= factor[b][a[b]];
+                }
+                derivatives[node][i] = fromOwn + fromFirst;
+            }
+        }
+    } else {
+        // Tensor product of the 1D Lagrange polynomials through the points
+        // -1 + 2k/q
+        std::vector<double> lattice(order + 1);
+        for (std::size_t k = 0; k <= order; ++k) {
+            lattice[k] = -1. + 2. * static_cast<double>(k) / q;
+        }
+        std::array<std::vector<double>, DIM> factor, factorDerivative;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            factor[i].assign(order + 1, 1.);
+            factorDerivative[i].assign(order + 1, 0.);
+            for (std::size_t k = 0; k <= order; ++k) {
+                for (std::size_t m = 0; m <= order; ++m) {
+                    if (m == k) continue;
+                    const double denominator = lattice[k] - lattice[m];
+                    // product rule: d/dt (f (t - t_m)/d) = (f' (t - t_m) + f)/d
+                    factorDerivative[i][k] =
+                        (factorDerivative[i][k] * (point[i] - lattice[m]) +
+                         factor[i][k]) /
+                        denominator;
+                    factor[i][k] *= (point[i] - lattice[m]) / denominator;
+                }
+            }
+        }
+        for (std::size_t node = 0; node < numberOfNodes; ++node) {
+            const std::array<std::size_t, DIM>& index = latticeIndices[node];
+            for (std::size_t i = 0; i < DIM; ++i) {
+                values[node] *= factor[i][index[i]];
+                double derivative = factorDerivative[i][index[i]];
+                for (std::size_t j = 0; j < DIM; ++j) {
+                    if (j != i) derivative *= factor[j][index[j]];
+                }
+                derivatives[node][i] = derivative;
+            }
+        }
+    }
+}
+
+template <std::size_t DIM>
+void MappingToPhysLagrange<DIM>::combine(
+    const ShapeFunctionValues& shapeFunctions, PointPhysical<DIM>* point,
+    Jacobian<DIM, DIM>* jacobian) const {
+    for (std::size_t node = 0; node < nodes_.size(); ++node) {
+        if (point != nullptr) {
+            point->axpy(shapeFunctions.values[node], nodes_[node]);
+        }
+        if (jacobian != nullptr) {
+            for (std::size_t i = 0; i < DIM; ++i) {
+                for (std::size_t j = 0; j < DIM; ++j) {
+                    (*jacobian)(i, j) +=
+                        nodes_[node][i] * shapeFunctions.derivatives[node][j];
+                }
+            }
+        }
+    }
+}
+
+template <std::size_t DIM>
+void MappingToPhysLagrange<DIM>::evaluate(const PointReference<DIM>& point,
+                                          PointPhysical<DIM>* result,
+                                          Jacobian<DIM, DIM>* jacobian) const {
+    std::array<double, DIM> key;
+    for (std::size_t i = 0; i < DIM; ++i) {
+        key[i] = point[i];
+    }
+    const ShapeFunctionValues* stored = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(table_->mutex);
+        auto found = table_->shapeFunctions.find(key);
+        if (found != table_->shapeFunctions.end()) {
+            stored = &found->second;
+        }
+    }
+    if (stored != nullptr) {
+        combine(*stored, result, jacobian);
+        return;
+    }
+    ShapeFunctionValues computed;
+    table_->evaluate(point, computed);
+    combine(computed, result, jacobian);
+    std::lock_guard<std::mutex> lock(table_->mutex);
+    if (table_->shapeFunctions.size() < maximumTableSize) {
+        table_->shapeFunctions.emplace(key, std::move(computed));
+    }
+}
+
+template <std::size_t DIM>
+PointPhysical<DIM> MappingToPhysLagrange<DIM>::transform(
+    const PointReference<DIM>& pointReference) const {
+    PointPhysical<DIM> result;
+    evaluate(pointReference, &result, nullptr);
+    return result;
+}
+
+template <std::size_t DIM>
+Jacobian<DIM, DIM> MappingToPhysLagrange<DIM>::calcJacobian(
+    const PointReference<DIM>& pointReference) const {
+    Jacobian<DIM, DIM> result;
+    evaluate(pointReference, nullptr, &result);
+    return result;
+}
+
+template <std::size_t DIM>
+PointReference<DIM> MappingToPhysLagrange<DIM>::inverseTransform(
+    const PointPhysical<DIM>& pointPhysical) const {
+    const PointReference<DIM>& center = geometry->getRefGeometry()->getCenter();
+    LinearAlgebra::SmallVector<DIM> coordinates = center.getCoordinates();
+    // The iterates are not stored in the table, they are not likely to be
+    // used again
+    ShapeFunctionValues shapeFunctions;
+    for (std::size_t iteration = 0; iteration < 50; ++iteration) {
+        table_->evaluate(PointReference<DIM>(coordinates), shapeFunctions);
+        PointPhysical<DIM> point;
+        Jacobian<DIM, DIM> jacobian;
+        combine(shapeFunctions, &point, &jacobian);
+        LinearAlgebra::SmallVector<DIM> step =
+            (pointPhysical - point).getCoordinates();
+        jacobian.solve(step);
+        coordinates += step;
+        if (step.l2Norm() < 1e-14) {
+            break;
+        }
+    }
+    return PointReference<DIM>(coordinates);
+}
+
+template <std::size_t DIM>
+void MappingToPhysLagrange<DIM>::reinit() {
+    const std::vector<PointReference<DIM>>& referenceNodes =
+        table_->referenceNodes;
+    nodes_.resize(referenceNodes.size());
+    for (std::size_t i = 0; i < referenceNodes.size(); ++i) {
+        nodes_[i] = transformLinear(referenceNodes[i]) + offsets_[i];
+    }
+}
+
+template <std::size_t DIM>
+void MappingToPhysLagrange<DIM>::setGeometryNode(
+    std::size_t i, const PointPhysical<DIM>& node) {
+    logger.assert_debug(i < getNumberOfGeometryNodes(),
+                        "Asked for geometry node %, but there are only %", i,
+                        getNumberOfGeometryNodes());
+    offsets_[i] =
+        (node - transformLinear(table_->referenceNodes[i])).getCoordinates();
+    nodes_[i] = node;
+}
+
+template <std::size_t DIM>
+std::vector<std::size_t> MappingToPhysLagrange<DIM>::getGeometryNodeVertices(
+    std::size_t i) const {
+    logger.assert_debug(i < getNumberOfGeometryNodes(),
+                        "Asked for geometry node %, but there are only %", i,
+                        getNumberOfGeometryNodes());
+    const std::array<std::size_t, DIM>& index = table_->latticeIndices[i];
+    const std::size_t order = table_->order;
+    std::vector<std::size_t> result;
+    if (table_->isSimplex()) {
+        std::size_t sum = 0;
+        for (std::size_t j = 0; j < DIM; ++j) {
+            sum += index[j];
+        }
+        if (sum < order) result.push_back(0);
+        for (std::size_t j = 0; j < DIM; ++j) {
+            if (index[j] > 0) result.push_back(j + 1);
+        }
+    } else {
+        // the vertex at -1 (bit 0) or at 1 (bit 1) in each direction
+        for (std::size_t vertex = 0; vertex < (std::size_t(1) << DIM);
+             ++vertex) {
+            bool contains = true;
+            for (std::size_t j = 0; j < DIM; ++j) {
+                contains = contains && (((vertex >> j) & 1) ? index[j] > 0
+                                                             : index[j] < order);
+            }
+            if (contains) result.push_back(vertex);
+        }
+    }
+    return result;
+}
+
+}  // namespace Geometry
+}  // namespace hpgem
+
+#endif  // HPGEM_KERNEL_MAPPINGTOPHYSLAGRANGE_IMPL_H
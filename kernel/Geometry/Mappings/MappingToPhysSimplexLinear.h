@@ -78,6 +78,7 @@ class MappingToPhysSimplexLinear : public MappingReferenceToPhysical {
     Jacobian<DIM, DIM> calcJacobian(const PointReference<DIM>&) const final;
     void reinit() final;
     std::size_t getTargetDimension() const final { return DIM; }
+    bool isAffine() const final { return true; }
 
    private:
     ///\todo: Implement this function.
@@ -0,0 +1,155 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "NonconformingFaceMapping.h"
+
+#include "Geometry/PointReference.h"
+#include "Geometry/Jacobian.h"
+
+#include <cmath>
+#include <map>
+#include <memory>
+
+namespace hpgem {
+
+namespace Geometry {
+
+const NonconformingFaceMapping& NonconformingFaceMapping::instance(
+    const std::vector<double>& jacobian, const std::vector<double>& offset) {
+    logger.assert_debug(
+        offset.size() > 0 && jacobian.size() % offset.size() == 0,
+        "A jacobian with % entries does not fit an offset of size %",
+        jacobian.size(), offset.size());
+    static std::map<std::vector<long long>,
+                    std::unique_ptr<const NonconformingFaceMapping>>
+        instances;
+    // the coefficients are computed from reference coordinates, so rounding
+    // them identifies mappings that only differ by round-off
+    std::vector<long long> key;
+    key.reserve(jacobian.size() + offset.size() + 1);
+    key.push_back(static_cast<long long>(offset.size()));
+    for (double coefficient : jacobian) {
+        key.push_back(std::llround(coefficient * 1e10));
+    }
+    for (double coefficient : offset) {
+        key.push_back(std::llround(coefficient * 1e10));
+    }
+    std::unique_ptr<const NonconformingFaceMapping>& mapping = instances[key];
+    if (!mapping) {
+        mapping.reset(new NonconformingFaceMapping(jacobian, offset));
+    }
+    return *mapping;
+}
+
+NonconformingFaceMapping::NonconformingFaceMapping(
+    const std::vector<double>& jacobian, const std::vector<double>& offset)
+    : jacobian_(jacobian), offset_(offset) {}
+
+template <std::size_t DIM>
+PointReference<DIM + 1> NonconformingFaceMapping::transformImpl(
+    const PointReference<DIM>& p) const {
+    logger.assert_debug(offset_.size() == DIM + 1,
+                        "This mapping maps to dimension %, not %",
+                        offset_.size(), DIM + 1);
+    PointReference<DIM + 1> result;
+    for (std::size_t i = 0; i < DIM + 1; ++i) {
+        result[i] = offset_[i];
+        for (std::size_t j = 0; j < DIM; ++j) {
+            result[i] += jacobian_[i * DIM + j] * p[j];
+        }
+    }
+    return result;
+}
+
+template <std::size_t DIM>
+Jacobian<DIM, DIM + 1> NonconformingFaceMapping::calcJacobianImpl() const {
+    logger.assert_debug(offset_.size() == DIM + 1,
+                        "This mapping maps to dimension %, not %",
+                        offset_.size(), DIM + 1);
+    Jacobian<DIM, DIM + 1> result;
+    for (std::size_t i = 0; i < DIM + 1; ++i) {
+        for (std::size_t j = 0; j < DIM; ++j) {
+            result(i, j) = jacobian_[i * DIM + j];
+        }
+    }
+    return result;
+}
+
+PointReference<1> NonconformingFaceMapping::transform(
+    const PointReference<0>& p) const {
+    return transformImpl(p);
+}
+
+PointReference<2> NonconformingFaceMapping::transform(
+    const PointReference<1>& p) const {
+    return transformImpl(p);
+}
+
+PointReference<3> NonconformingFaceMapping::transform(
+    const PointReference<2>& p) const {
+    return transformImpl(p);
+}
+
+PointReference<4> NonconformingFaceMapping::transform(
+    const PointReference<3>& p) const {
+    return transformImpl(p);
+}
+
+Jacobian<0, 1> NonconformingFaceMapping::calcJacobian(
+    const PointReference<0>&) const {
+    return calcJacobianImpl<0>();
+}
+
+Jacobian<1, 2> NonconformingFaceMapping::calcJacobian(
+    const PointReference<1>&) const {
+    return calcJacobianImpl<1>();
+}
+
+Jacobian<2, 3> NonconformingFaceMapping::calcJacobian(
+    const PointReference<2>&) const {
+    return calcJacobianImpl<2>();
+}
+
+Jacobian<3, 4> NonconformingFaceMapping::calcJacobian(
+    const PointReference<3>&) const {
+    return calcJacobianImpl<3>();
+}
+
+}  // namespace Geometry
+
+}  // namespace hpgem
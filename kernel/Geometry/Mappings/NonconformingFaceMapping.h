@@ -0,0 +1,98 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPGEM_KERNEL_NONCONFORMINGFACEMAPPING_H
+#define HPGEM_KERNEL_NONCONFORMINGFACEMAPPING_H
+
+#include "MappingReferenceToReference.h"
+
+#include <vector>
+
+namespace hpgem {
+
+namespace Geometry {
+/*! Affine mapping from the reference geometry of a face to the reference
+ *  geometry of an element that only contains part of the face. This is the
+ *  mapping to the coarse element on the other side of a hanging node, where
+ *  the face of a refined element covers a part of a face of its coarser
+ *  neighbour.
+ *
+ *  The mapping is \f$ x \mapsto Jx + b \f$. Mappings with the same coefficients
+ *  are shared and live until the end of the program, like the other reference
+ *  to reference mappings, so they can be used as keys for the cached basis
+ *  function values of a quadrature rule. */
+class NonconformingFaceMapping : public MappingReferenceToReference<1> {
+   public:
+    /// Return the mapping with the given jacobian, stored row by row, and
+    /// offset. The number of rows is the size of the offset.
+    static const NonconformingFaceMapping& instance(
+        const std::vector<double>& jacobian, const std::vector<double>& offset);
+
+    NonconformingFaceMapping(const NonconformingFaceMapping&) = delete;
+    NonconformingFaceMapping& operator=(const NonconformingFaceMapping&) =
+        delete;
+
+    PointReference<1> transform(const PointReference<0>& p) const final;
+    PointReference<2> transform(const PointReference<1>& p) const final;
+    PointReference<3> transform(const PointReference<2>& p) const final;
+    PointReference<4> transform(const PointReference<3>& p) const final;
+
+    Jacobian<0, 1> calcJacobian(const PointReference<0>& p) const final;
+    Jacobian<1, 2> calcJacobian(const PointReference<1>& p) const final;
+    Jacobian<2, 3> calcJacobian(const PointReference<2>& p) const final;
+    Jacobian<3, 4> calcJacobian(const PointReference<3>& p) const final;
+
+    std::size_t getTargetDimension() const final { return offset_.size(); }
+
+   private:
+    NonconformingFaceMapping(const std::vector<double>& jacobian,
+                             const std::vector<double>& offset);
+
+    template <std::size_t DIM>
+    PointReference<DIM + 1> transformImpl(const PointReference<DIM>& p) const;
+
+    template <std::size_t DIM>
+    Jacobian<DIM, DIM + 1> calcJacobianImpl() const;
+
+    std::vector<double> jacobian_;
+    std::vector<double> offset_;
+};
+}  // namespace Geometry
+}  // namespace hpgem
+
+#endif  // HPGEM_KERNEL_NONCONFORMINGFACEMAPPING_H
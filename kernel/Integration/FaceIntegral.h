@@ -103,6 +103,30 @@ class FaceIntegral {
         const Base::Face* fa, FunctionType integrandFunc,
         QuadratureRules::GaussQuadratureRule* qdrRule = nullptr);
 
+    //! \brief Integrate in passes, so that the expensive pointwise work (e.g.
+    //! a Riemann solver) can be done for all quadrature points of the face at
+    //! once. gather(face, i) is called for every quadrature point i, then
+    //! evaluate(numberOfPoints) once, and finally integrandFunc(face, i) for
+    //! every quadrature point to produce the integrand.
+    template <typename GatherType, typename EvaluateType,
+              typename FunctionType>
+    std::result_of_t<FunctionType(Base::PhysicalFace<DIM>&, std::size_t)>
+        integrateBatched(
+            const Base::Face* fa, GatherType gather, EvaluateType evaluate,
+            FunctionType integrandFunc,
+            QuadratureRules::GaussQuadratureRule* qdrRule = nullptr);
+
+    //! \brief integrateBatched for an integrandFunc that returns a pair, for
+    //! example the integrands for the left and right side of a face that
+    //! share the pointwise data.
+    template <typename GatherType, typename EvaluateType,
+              typename FunctionType>
+    std::result_of_t<FunctionType(Base::PhysicalFace<DIM>&, std::size_t)>
+        integratePairBatched(
+            const Base::Face* fa, GatherType gather, EvaluateType evaluate,
+            FunctionType integrandFunc,
+            QuadratureRules::GaussQuadratureRule* qdrRule = nullptr);
+
     /// \brief Compute the integral on a reference element. IntegrandType needs
     /// to have the function LinearAlgebra::axpy() implemented.
     // need to know information about the face to perform the integration
@@ -112,6 +136,16 @@ class FaceIntegral {
     // std::function<IntegrandType()> integrandFunction) const;
 
    private:
+    //! \brief The passes shared by integrateBatched and integratePairBatched:
+    //! gather and evaluate the pointwise data, then call
+    //! accumulate(face, i, weight) for every quadrature point i, where weight
+    //! includes the integrand scale factor.
+    template <typename GatherType, typename EvaluateType,
+              typename AccumulateType>
+    void accumulateBatched(const Base::Face* fa, GatherType gather,
+                           EvaluateType evaluate, AccumulateType accumulate,
+                           QuadratureRules::GaussQuadratureRule* qdrRule);
+
     Base::PhysicalFace<DIM> internalFace_;
     Base::PhysicalFace<DIM> boundaryFace_;
 
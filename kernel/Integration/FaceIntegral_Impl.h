@@ -203,6 +203,94 @@ std::result_of_t<FunctionType(Base::PhysicalFace<DIM>&)>
     return result;
 }  // function
 
+template <std::size_t DIM>
+template <typename GatherType, typename EvaluateType, typename AccumulateType>
+void FaceIntegral<DIM>::accumulateBatched(
+    const Base::Face* fa, GatherType gather, EvaluateType evaluate,
+    AccumulateType accumulate, QuadratureRules::GaussQuadratureRule* qdrRule) {
+    logger.assert_debug(fa != nullptr, "Invalid face detected");
+    Base::PhysicalFace<DIM>* face_ =
+        fa->isInternal() ? &internalFace_ : &boundaryFace_;
+    face_->setFace(fa);
+    // quadrature rule is allowed to be equal to nullptr!
+    QuadratureRules::GaussQuadratureRule* qdrRuleLoc =
+        (qdrRule == nullptr ? fa->getGaussQuadratureRule() : qdrRule);
+    logger.assert_debug(
+        (qdrRuleLoc->forReferenceGeometry() == fa->getReferenceGeometry()),
+        "FaceIntegral: " + qdrRuleLoc->getName() +
+            " rule is not for THIS ReferenceGeometry!");
+    std::size_t numberOfPoints = qdrRuleLoc->getNumberOfPoints();
+
+    // first pass: collect the pointwise data
+    face_->setQuadratureRule(qdrRuleLoc);
+    gather(*face_, 0);
+    for (std::size_t i = 1; i < numberOfPoints; ++i) {
+        face_->setQuadraturePointIndex(i);
+        gather(*face_, i);
+    }
+
+    evaluate(numberOfPoints);
+
+    // second pass: the actual integration
+    for (std::size_t i = 0; i < numberOfPoints; ++i) {
+        face_->setQuadraturePointIndex(i);
+        accumulate(*face_, i,
+                   qdrRuleLoc->weight(i) *
+                       face_->getTransform(0)->getIntegrandScaleFactor(*face_));
+    }
+}
+
+template <std::size_t DIM>
+template <typename GatherType, typename EvaluateType, typename FunctionType>
+std::result_of_t<FunctionType(Base::PhysicalFace<DIM>&, std::size_t)>
+    FaceIntegral<DIM>::integrateBatched(
+        const Base::Face* fa, GatherType gather, EvaluateType evaluate,
+        FunctionType integrandFunc,
+        QuadratureRules::GaussQuadratureRule* qdrRule) {
+    using ReturnTrait1 = std::result_of_t<FunctionType(
+        Base::PhysicalFace<DIM>&, std::size_t)>;
+    ReturnTrait1 result;
+    accumulateBatched(
+        fa, gather, evaluate,
+        [&](Base::PhysicalFace<DIM>& face, std::size_t i, double weight) {
+            if (i == 0) {
+                result = integrandFunc(face, 0);
+                result *= weight;
+            } else {
+                LinearAlgebra::axpy(weight, integrandFunc(face, i), result);
+            }
+        },
+        qdrRule);
+    return result;
+}
+
+template <std::size_t DIM>
+template <typename GatherType, typename EvaluateType, typename FunctionType>
+std::result_of_t<FunctionType(Base::PhysicalFace<DIM>&, std::size_t)>
+    FaceIntegral<DIM>::integratePairBatched(
+        const Base::Face* fa, GatherType gather, EvaluateType evaluate,
+        FunctionType integrandFunc,
+        QuadratureRules::GaussQuadratureRule* qdrRule) {
+    using ReturnTrait1 = std::result_of_t<FunctionType(
+        Base::PhysicalFace<DIM>&, std::size_t)>;
+    ReturnTrait1 result;
+    accumulateBatched(
+        fa, gather, evaluate,
+        [&](Base::PhysicalFace<DIM>& face, std::size_t i, double weight) {
+            if (i == 0) {
+                result = integrandFunc(face, 0);
+                result.first *= weight;
+                result.second *= weight;
+            } else {
+                ReturnTrait1 value = integrandFunc(face, i);
+                LinearAlgebra::axpy(weight, value.first, result.first);
+                LinearAlgebra::axpy(weight, value.second, result.second);
+            }
+        },
+        qdrRule);
+    return result;
+}
+
 // \param[in] ptrQdrRule A pointer to a quadrature rule used for the
 // integration. \param[in] integrandFunction A function that is integrated on
 // the reference face. It takes as input argument a reference point and returns
@@ -41,6 +41,21 @@
 
 namespace hpgem {
 
+namespace {
+/// Tabulate the gradients of all basis functions of the set at the point.
+template <std::size_t DIM>
+void tabulateGradients(const Base::BasisFunctionSet* set,
+                       const Geometry::PointReference<DIM>& point,
+                       std::vector<LinearAlgebra::MiddleSizeVector>& result) {
+    std::vector<LinearAlgebra::SmallVector<DIM>> gradients;
+    set->evalAllDerivs(point, gradients);
+    result.resize(gradients.size());
+    for (std::size_t j = 0; j < gradients.size(); ++j) {
+        result[j] = gradients[j];
+    }
+}
+}  // namespace
+
 double QuadratureRules::GaussQuadratureRule::eval(
     const Base::BasisFunctionSet* set, std::size_t basisFunctionIndex,
     std::size_t quadraturePointIndex) {
@@ -59,31 +74,23 @@ double QuadratureRules::GaussQuadratureRule::eval(
         set->registerQuadratureRule(this);
         basisFunctionValues_[set].resize(getNumberOfPoints());
         for (std::size_t i = 0; i < getNumberOfPoints(); ++i) {
-            basisFunctionValues_[set][i].resize(set->size());
+            std::vector<double>& values = basisFunctionValues_[set][i];
             switch (dimension()) {
                 case 1: {
                     const Geometry::PointReference<1>& point1D = getPoint(i);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        basisFunctionValues_[set][i][j] = set->eval(j, point1D);
-                    }
+                    set->evalAll(point1D, values);
                 } break;
                 case 2: {
                     const Geometry::PointReference<2>& point2D = getPoint(i);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        basisFunctionValues_[set][i][j] = set->eval(j, point2D);
-                    }
+                    set->evalAll(point2D, values);
                 } break;
                 case 3: {
                     const Geometry::PointReference<3>& point3D = getPoint(i);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        basisFunctionValues_[set][i][j] = set->eval(j, point3D);
-                    }
+                    set->evalAll(point3D, values);
                 } break;
                 case 4: {
                     const Geometry::PointReference<4>& point4D = getPoint(i);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        basisFunctionValues_[set][i][j] = set->eval(j, point4D);
-                    }
+                    set->evalAll(point4D, values);
                 } break;
                 default:
                     logger(ERROR,
@@ -119,47 +126,36 @@ double QuadratureRules::GaussQuadratureRule::eval(
         set->registerQuadratureRule(this);
         faceBasisFunctionValues_[set][containedMap].resize(getNumberOfPoints());
         for (std::size_t i = 0; i < getNumberOfPoints(); ++i) {
-            faceBasisFunctionValues_[set][containedMap][i].resize(set->size());
+            std::vector<double>& values =
+                faceBasisFunctionValues_[set][containedMap][i];
             switch (dimension()) {
                 case 0: {
                     const Geometry::PointReference<0>& facePoint0D =
                         getPoint(i);
                     const Geometry::PointReference<1>& point1D =
                         map->transform(facePoint0D);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        faceBasisFunctionValues_[set][containedMap][i][j] =
-                            set->eval(j, point1D);
-                    }
+                    set->evalAll(point1D, values);
                 } break;
                 case 1: {
                     const Geometry::PointReference<1>& facePoint1D =
                         getPoint(i);
                     const Geometry::PointReference<2>& point2D =
                         map->transform(facePoint1D);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        faceBasisFunctionValues_[set][containedMap][i][j] =
-                            set->eval(j, point2D);
-                    }
+                    set->evalAll(point2D, values);
                 } break;
                 case 2: {
                     const Geometry::PointReference<2>& facePoint2D =
                         getPoint(i);
                     const Geometry::PointReference<3>& point3D =
                         map->transform(facePoint2D);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        faceBasisFunctionValues_[set][containedMap][i][j] =
-                            set->eval(j, point3D);
-                    }
+                    set->evalAll(point3D, values);
                 } break;
                 case 3: {
                     const Geometry::PointReference<3>& facePoint3D =
                         getPoint(i);
                     const Geometry::PointReference<4>& point4D =
                         map->transform(facePoint3D);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        faceBasisFunctionValues_[set][containedMap][i][j] =
-                            set->eval(j, point4D);
-                    }
+                    set->evalAll(point4D, values);
                 } break;
                 default:
                     logger(ERROR, "hpGEM does not support faces of dimension %",
@@ -197,35 +193,24 @@ const LinearAlgebra::MiddleSizeVector&
         set->registerQuadratureRule(this);
         basisFunctionGrads_[set].resize(getNumberOfPoints());
         for (std::size_t i = 0; i < getNumberOfPoints(); ++i) {
-            basisFunctionGrads_[set][i].resize(set->size());
+            std::vector<LinearAlgebra::MiddleSizeVector>& gradients =
+                basisFunctionGrads_[set][i];
             switch (dimension()) {
                 case 1: {
                     const Geometry::PointReference<1>& point1D = getPoint(i);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        basisFunctionGrads_[set][i][j] =
-                            set->evalDeriv(j, point1D);
-                    }
+                    tabulateGradients(set, point1D, gradients);
                 } break;
                 case 2: {
                     const Geometry::PointReference<2>& point2D = getPoint(i);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        basisFunctionGrads_[set][i][j] =
-                            set->evalDeriv(j, point2D);
-                    }
+                    tabulateGradients(set, point2D, gradients);
                 } break;
                 case 3: {
                     const Geometry::PointReference<3>& point3D = getPoint(i);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        basisFunctionGrads_[set][i][j] =
-                            set->evalDeriv(j, point3D);
-                    }
+                    tabulateGradients(set, point3D, gradients);
                 } break;
                 case 4: {
                     const Geometry::PointReference<4>& point4D = getPoint(i);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        basisFunctionGrads_[set][i][j] =
-                            set->evalDeriv(j, point4D);
-                    }
+                    tabulateGradients(set, point4D, gradients);
                 } break;
                 default:
                     logger(ERROR,
@@ -270,47 +255,36 @@ const LinearAlgebra::MiddleSizeVector&
         set->registerQuadratureRule(this);
         faceBasisFunctionGrads_[set][containedMap].resize(getNumberOfPoints());
         for (std::size_t i = 0; i < getNumberOfPoints(); ++i) {
-            faceBasisFunctionGrads_[set][containedMap][i].resize(set->size());
+            std::vector<LinearAlgebra::MiddleSizeVector>& gradients =
+                faceBasisFunctionGrads_[set][containedMap][i];
             switch (dimension()) {
                 case 0: {
                     const Geometry::PointReference<0>& facePoint0D =
                         getPoint(i);
                     const Geometry::PointReference<1>& point1D =
                         map->transform(facePoint0D);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        faceBasisFunctionGrads_[set][containedMap][i][j] =
-                            set->evalDeriv(j, point1D);
-                    }
+                    tabulateGradients(set, point1D, gradients);
                 } break;
                 case 1: {
                     const Geometry::PointReference<1>& facePoint1D =
                         getPoint(i);
                     const Geometry::PointReference<2>& point2D =
                         map->transform(facePoint1D);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        faceBasisFunctionGrads_[set][containedMap][i][j] =
-                            set->evalDeriv(j, point2D);
-                    }
+                    tabulateGradients(set, point2D, gradients);
                 } break;
                 case 2: {
                     const Geometry::PointReference<2>& facePoint2D =
                         getPoint(i);
                     const Geometry::PointReference<3>& point3D =
                         map->transform(facePoint2D);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        faceBasisFunctionGrads_[set][containedMap][i][j] =
-                            set->evalDeriv(j, point3D);
-                    }
+                    tabulateGradients(set, point3D, gradients);
                 } break;
                 case 3: {
                     const Geometry::PointReference<3>& facePoint3D =
                         getPoint(i);
                     const Geometry::PointReference<4>& point4D =
                         map->transform(facePoint3D);
-                    for (std::size_t j = 0; j < set->size(); ++j) {
-                        faceBasisFunctionGrads_[set][containedMap][i][j] =
-                            set->evalDeriv(j, point4D);
-                    }
+                    tabulateGradients(set, point4D, gradients);
                 } break;
                 default:
                     logger(ERROR, "hpGEM does not support faces of dimension %",
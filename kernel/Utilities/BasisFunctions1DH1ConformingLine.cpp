@@ -94,6 +94,7 @@ Base::BasisFunctionSet* createDGBasisFunctionSet1DH1Line(
     for (auto* bf : createDGBasisFunctions1DH1Line(polynomialOrder)) {
         result->addBasisFunction(bf);
     }
+    useTensorProductEvaluator<1>(result);
     return result;
 }
 
@@ -106,6 +107,7 @@ Base::BasisFunctionSet* createInteriorBasisFunctionSet1DH1Line(
     for (std::size_t i = 0; i + 2 <= polynomialOrder; ++i) {
         result->addBasisFunction(new BasisFunction1DInteriorLine(i));
     }
+    useTensorProductEvaluator<1>(result);
     return result;
 }
 
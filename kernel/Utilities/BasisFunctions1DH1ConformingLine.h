@@ -40,6 +40,7 @@
 #define HPGEM_KERNEL_BASISFUNCTIONS1DH1CONFORMINGLINE_H
 
 #include "Base/BaseBasisFunction.h"
+#include "TensorProductBasisFunction.h"
 #include <vector>
 
 namespace hpgem {
@@ -56,7 +57,7 @@ class PointReference;
 
 namespace Utilities {
 
-class BasisFunction1DVertexLine : public Base::BaseBasisFunction {
+class BasisFunction1DVertexLine : public TensorProductBasisFunction<1> {
    public:
     BasisFunction1DVertexLine(std::size_t node)
         : nodePosition_(2 * static_cast<int>(node) - 1) {
@@ -67,11 +68,15 @@ class BasisFunction1DVertexLine : public Base::BaseBasisFunction {
 
     double evalDeriv0(const Geometry::PointReference<1>& p) const override;
 
+    std::array<TensorProductFactor, 1> getFactors() const override {
+        return {vertexFactor(nodePosition_)};
+    }
+
    private:
     int nodePosition_;
 };
 
-class BasisFunction1DInteriorLine : public Base::BaseBasisFunction {
+class BasisFunction1DInteriorLine : public TensorProductBasisFunction<1> {
    public:
     BasisFunction1DInteriorLine(std::size_t polynomialOrder)
         : polynomialOrder_(polynomialOrder) {}
@@ -80,6 +85,10 @@ class BasisFunction1DInteriorLine : public Base::BaseBasisFunction {
 
     double evalDeriv0(const Geometry::PointReference<1>& p) const override;
 
+    std::array<TensorProductFactor, 1> getFactors() const override {
+        return {bubbleFactor(polynomialOrder_)};
+    }
+
    private:
     std::size_t polynomialOrder_;
 };
@@ -180,6 +180,7 @@ Base::BasisFunctionSet* createDGBasisFunctionSet2DH1Square(std::size_t order) {
     } else {
         addPiecewiseConstantBasisFunction2D(*result);
     }
+    useTensorProductEvaluator<2>(result);
     return result;
 }
 
@@ -194,6 +195,7 @@ Base::BasisFunctionSet* createInteriorBasisFunctionSet2DH1Square(
             result->addBasisFunction(new BasisFunction2DInteriorSquare(i, j));
         }
     }
+    useTensorProductEvaluator<2>(result);
     return result;
 }
 
@@ -40,6 +40,7 @@
 #define HPGEM_KERNEL_BASISFUNCTIONS2DH1CONFORMINGSQUARE_H
 
 #include "Base/BaseBasisFunction.h"
+#include "TensorProductBasisFunction.h"
 #include <vector>
 
 namespace hpgem {
@@ -56,7 +57,7 @@ class PointReference;
 
 namespace Utilities {
 
-class BasisFunction2DVertexSquare : public Base::BaseBasisFunction {
+class BasisFunction2DVertexSquare : public TensorProductBasisFunction<2> {
    public:
     BasisFunction2DVertexSquare(std::size_t node)
         : nodePosition0_((static_cast<int>(node) % 2) * 2 - 1),
@@ -70,12 +71,16 @@ class BasisFunction2DVertexSquare : public Base::BaseBasisFunction {
 
     double evalDeriv1(const Geometry::PointReference<2>& p) const override;
 
+    std::array<TensorProductFactor, 2> getFactors() const override {
+        return {vertexFactor(nodePosition0_), vertexFactor(nodePosition1_)};
+    }
+
    private:
     int nodePosition0_;
     int nodePosition1_;
 };
 
-class BasisFunction2DFaceSquare_0 : public Base::BaseBasisFunction {
+class BasisFunction2DFaceSquare_0 : public TensorProductBasisFunction<2> {
    public:
     BasisFunction2DFaceSquare_0(std::size_t node0, std::size_t node1,
                                 std::size_t polynomialOrder);
@@ -86,13 +91,18 @@ class BasisFunction2DFaceSquare_0 : public Base::BaseBasisFunction {
 
     double evalDeriv1(const Geometry::PointReference<2>& p) const override;
 
+    std::array<TensorProductFactor, 2> getFactors() const override {
+        return {bubbleFactor(polynomialOrder_, mirroring_),
+                vertexFactor(edgePosition_)};
+    }
+
    private:
     int edgePosition_;
     int mirroring_;
     std::size_t polynomialOrder_;
 };
 
-class BasisFunction2DFaceSquare_1 : public Base::BaseBasisFunction {
+class BasisFunction2DFaceSquare_1 : public TensorProductBasisFunction<2> {
    public:
     BasisFunction2DFaceSquare_1(std::size_t node0, std::size_t node1,
                                 std::size_t polynomialOrder);
@@ -103,13 +113,18 @@ class BasisFunction2DFaceSquare_1 : public Base::BaseBasisFunction {
 
     double evalDeriv1(const Geometry::PointReference<2>& p) const override;
 
+    std::array<TensorProductFactor, 2> getFactors() const override {
+        return {vertexFactor(edgePosition_),
+                bubbleFactor(polynomialOrder_, mirroring_)};
+    }
+
    private:
     int edgePosition_;
     int mirroring_;
     std::size_t polynomialOrder_;
 };
 
-class BasisFunction2DInteriorSquare : public Base::BaseBasisFunction {
+class BasisFunction2DInteriorSquare : public TensorProductBasisFunction<2> {
    public:
     BasisFunction2DInteriorSquare(std::size_t polynomialOrder0,
                                   std::size_t polynomialOrder1)
@@ -122,6 +137,11 @@ class BasisFunction2DInteriorSquare : public Base::BaseBasisFunction {
 
     double evalDeriv1(const Geometry::PointReference<2>& p) const override;
 
+    std::array<TensorProductFactor, 2> getFactors() const override {
+        return {bubbleFactor(polynomialOrder0_),
+                bubbleFactor(polynomialOrder1_)};
+    }
+
    private:
     std::size_t polynomialOrder0_, polynomialOrder1_;
 };
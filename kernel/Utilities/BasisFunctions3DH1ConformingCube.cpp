@@ -524,6 +524,7 @@ Base::BasisFunctionSet* createDGBasisFunctionSet3DH1Cube(std::size_t order) {
     } else {
         addPiecewiseConstantBasisFunction3D(*result);
     }
+    useTensorProductEvaluator<3>(result);
     return result;
 }
 
@@ -541,6 +542,7 @@ Base::BasisFunctionSet* createInteriorBasisFunctionSet3DH1Cube(
             }
         }
     }
+    useTensorProductEvaluator<3>(result);
     return result;
 }
 
@@ -40,6 +40,7 @@
 #define HPGEM_KERNEL_BASISFUNCTIONS3DH1CONFORMINGCUBE_H
 
 #include "Base/BaseBasisFunction.h"
+#include "TensorProductBasisFunction.h"
 #include <vector>
 
 namespace hpgem {
@@ -56,7 +57,7 @@ class PointReference;
 
 namespace Utilities {
 
-class BasisFunction3DVertexCube : public Base::BaseBasisFunction {
+class BasisFunction3DVertexCube : public TensorProductBasisFunction<3> {
    public:
     BasisFunction3DVertexCube(std::size_t node);
 
@@ -68,11 +69,17 @@ class BasisFunction3DVertexCube : public Base::BaseBasisFunction {
 
     double evalDeriv2(const Geometry::PointReference<3>& p) const override;
 
+    std::array<TensorProductFactor, 3> getFactors() const override {
+        return {vertexFactor(nodePosition0_),
+                vertexFactor(nodePosition1_),
+                vertexFactor(nodePosition2_)};
+    }
+
    private:
     int nodePosition0_, nodePosition1_, nodePosition2_;
 };
 
-class BasisFunction3DEdgeCube_0 : public Base::BaseBasisFunction {
+class BasisFunction3DEdgeCube_0 : public TensorProductBasisFunction<3> {
    public:
     BasisFunction3DEdgeCube_0(std::size_t node0, std::size_t node1,
                               std::size_t polynomialOrder);
@@ -85,6 +92,12 @@ class BasisFunction3DEdgeCube_0 : public Base::BaseBasisFunction {
 
     double evalDeriv2(const Geometry::PointReference<3>& p) const override;
 
+    std::array<TensorProductFactor, 3> getFactors() const override {
+        return {bubbleFactor(polynomialOrder_, mirroring_),
+                vertexFactor(edgePosition1_),
+                vertexFactor(edgePosition2_)};
+    }
+
    private:
     int edgePosition1_;
     int edgePosition2_;
@@ -92,7 +105,7 @@ class BasisFunction3DEdgeCube_0 : public Base::BaseBasisFunction {
     std::size_t polynomialOrder_;
 };
 
-class BasisFunction3DEdgeCube_1 : public Base::BaseBasisFunction {
+class BasisFunction3DEdgeCube_1 : public TensorProductBasisFunction<3> {
    public:
     BasisFunction3DEdgeCube_1(std::size_t node0, std::size_t node1,
                               std::size_t polynomialOrder);
@@ -105,6 +118,12 @@ class BasisFunction3DEdgeCube_1 : public Base::BaseBasisFunction {
 
     double evalDeriv2(const Geometry::PointReference<3>& p) const override;
 
+    std::array<TensorProductFactor, 3> getFactors() const override {
+        return {vertexFactor(edgePosition0_),
+                bubbleFactor(polynomialOrder_, mirroring_),
+                vertexFactor(edgePosition2_)};
+    }
+
    private:
     int edgePosition0_;
     int edgePosition2_;
@@ -112,7 +131,7 @@ class BasisFunction3DEdgeCube_1 : public Base::BaseBasisFunction {
     std::size_t polynomialOrder_;
 };
 
-class BasisFunction3DEdgeCube_2 : public Base::BaseBasisFunction {
+class BasisFunction3DEdgeCube_2 : public TensorProductBasisFunction<3> {
    public:
     BasisFunction3DEdgeCube_2(std::size_t node0, std::size_t node1,
                               std::size_t polynomialOrder);
@@ -125,6 +144,12 @@ class BasisFunction3DEdgeCube_2 : public Base::BaseBasisFunction {
 
     double evalDeriv2(const Geometry::PointReference<3>& p) const override;
 
+    std::array<TensorProductFactor, 3> getFactors() const override {
+        return {vertexFactor(edgePosition0_),
+                vertexFactor(edgePosition1_),
+                bubbleFactor(polynomialOrder_, mirroring_)};
+    }
+
    private:
     int edgePosition0_;
     int edgePosition1_;
@@ -132,7 +157,7 @@ class BasisFunction3DEdgeCube_2 : public Base::BaseBasisFunction {
     std::size_t polynomialOrder_;
 };
 
-class BasisFunction3DFaceCube_0 : public Base::BaseBasisFunction {
+class BasisFunction3DFaceCube_0 : public TensorProductBasisFunction<3> {
    public:
     BasisFunction3DFaceCube_0(std::size_t node0, std::size_t node1,
                               std::size_t node2, std::size_t polynomialOrder1,
@@ -146,6 +171,12 @@ class BasisFunction3DFaceCube_0 : public Base::BaseBasisFunction {
 
     double evalDeriv2(const Geometry::PointReference<3>& p) const override;
 
+    std::array<TensorProductFactor, 3> getFactors() const override {
+        return {vertexFactor(facePosition_),
+                bubbleFactor(polynomialOrder1_, mirroring1_),
+                bubbleFactor(polynomialOrder2_, mirroring2_)};
+    }
+
    private:
     int facePosition_;
     int mirroring1_;
@@ -154,7 +185,7 @@ class BasisFunction3DFaceCube_0 : public Base::BaseBasisFunction {
     std::size_t polynomialOrder2_;
 };
 
-class BasisFunction3DFaceCube_1 : public Base::BaseBasisFunction {
+class BasisFunction3DFaceCube_1 : public TensorProductBasisFunction<3> {
    public:
     BasisFunction3DFaceCube_1(std::size_t node0, std::size_t node1,
                               std::size_t node2, std::size_t polynomialOrder0,
@@ -168,6 +199,12 @@ class BasisFunction3DFaceCube_1 : public Base::BaseBasisFunction {
 
     double evalDeriv2(const Geometry::PointReference<3>& p) const override;
 
+    std::array<TensorProductFactor, 3> getFactors() const override {
+        return {bubbleFactor(polynomialOrder0_, mirroring0_),
+                vertexFactor(facePosition_),
+                bubbleFactor(polynomialOrder2_, mirroring2_)};
+    }
+
    private:
     int facePosition_;
     int mirroring0_;
@@ -176,7 +213,7 @@ class BasisFunction3DFaceCube_1 : public Base::BaseBasisFunction {
     std::size_t polynomialOrder2_;
 };
 
-class BasisFunction3DFaceCube_2 : public Base::BaseBasisFunction {
+class BasisFunction3DFaceCube_2 : public TensorProductBasisFunction<3> {
    public:
     BasisFunction3DFaceCube_2(std::size_t node0, std::size_t node1,
                               std::size_t node2, std::size_t polynomialOrder0,
@@ -190,6 +227,12 @@ class BasisFunction3DFaceCube_2 : public Base::BaseBasisFunction {
 
     double evalDeriv2(const Geometry::PointReference<3>& p) const override;
 
+    std::array<TensorProductFactor, 3> getFactors() const override {
+        return {bubbleFactor(polynomialOrder0_, mirroring0_),
+                bubbleFactor(polynomialOrder1_, mirroring1_),
+                vertexFactor(facePosition_)};
+    }
+
    private:
     int facePosition_;
     int mirroring0_;
@@ -198,7 +241,7 @@ class BasisFunction3DFaceCube_2 : public Base::BaseBasisFunction {
     std::size_t polynomialOrder1_;
 };
 
-class BasisFunction3DInteriorCube : public Base::BaseBasisFunction {
+class BasisFunction3DInteriorCube : public TensorProductBasisFunction<3> {
    public:
     BasisFunction3DInteriorCube(std::size_t polynomialOrder0,
                                 std::size_t polynomialOrder1,
@@ -215,6 +258,12 @@ class BasisFunction3DInteriorCube : public Base::BaseBasisFunction {
 
     double evalDeriv2(const Geometry::PointReference<3>& p) const override;
 
+    std::array<TensorProductFactor, 3> getFactors() const override {
+        return {bubbleFactor(polynomialOrder0_),
+                bubbleFactor(polynomialOrder1_),
+                bubbleFactor(polynomialOrder2_)};
+    }
+
    private:
     std::size_t polynomialOrder0_, polynomialOrder1_, polynomialOrder2_;
 };
@@ -0,0 +1,424 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BasisFunctionsOrthonormal.h"
+
+#include <array>
+#include <cmath>
+#include <vector>
+#include "Base/BaseBasisFunction.h"
+#include "Base/BasisFunctionSet.h"
+#include "Geometry/PointReference.h"
+
+namespace hpgem {
+
+namespace Utilities {
+
+namespace {
+
+double integerPower(double value, std::size_t power) {
+    double result = 1.0;
+    for (std::size_t i = 0; i < power; ++i) result *= value;
+    return result;
+}
+
+/// Jacobi polynomials P_n^{(alpha, 0)} and their derivatives at x for
+/// n = 0, ..., degree, normalised such that the integral over [-1, 1] of
+/// (1 - x)^alpha P_n P_m is 1 if n = m and 0 otherwise. Uses the three term
+/// recurrence of Hesthaven and Warburton, Nodal Discontinuous Galerkin
+/// Methods, appendix A.
+void computeJacobiPolynomials(std::size_t degree, double alpha, double x,
+                              std::vector<double>& values,
+                              std::vector<double>& derivatives) {
+    values.resize(degree + 1);
+    derivatives.resize(degree + 1);
+    double gamma0 = std::pow(2., alpha + 1.) / (alpha + 1.);
+    values[0] = 1. / std::sqrt(gamma0);
+    derivatives[0] = 0.;
+    if (degree == 0) {
+        return;
+    }
+    double gamma1 = (alpha + 1.) / (alpha + 3.) * gamma0;
+    values[1] = ((alpha + 2.) * x / 2. + alpha / 2.) / std::sqrt(gamma1);
+    derivatives[1] = (alpha + 2.) / 2. / std::sqrt(gamma1);
+    double aOld = 2. / (2. + alpha) * std::sqrt((alpha + 1.) / (alpha + 3.));
+    for (std::size_t n = 1; n < degree; ++n) {
+        const double m = static_cast<double>(n);
+        double h = 2. * m + alpha;
+        double aNew = 2. / (h + 2.) *
+                      std::sqrt((m + 1.) * (m + 1. + alpha) * (m + 1. + alpha) *
+                                (m + 1.) / (h + 1.) / (h + 3.));
+        double bNew = -alpha * alpha / h / (h + 2.);
+        values[n + 1] =
+            (-aOld * values[n - 1] + (x - bNew) * values[n]) / aNew;
+        derivatives[n + 1] = (-aOld * derivatives[n - 1] + values[n] +
+                              (x - bNew) * derivatives[n]) /
+                             aNew;
+        aOld = aNew;
+    }
+}
+
+/// normalised Legendre polynomial of the given degree and its derivative
+void computeLegendre(std::size_t degree, double x, double& value,
+                     double& derivative) {
+    std::vector<double> values, derivatives;
+    computeJacobiPolynomials(degree, 0., x, values, derivatives);
+    value = values[degree];
+    derivative = derivatives[degree];
+}
+
+/// Product of normalised Legendre polynomials in each coordinate direction,
+/// orthonormal on [-1, 1]^DIM
+template <std::size_t DIM>
+class OrthonormalTensorProduct {
+   public:
+    explicit OrthonormalTensorProduct(std::array<std::size_t, DIM> degrees)
+        : degrees_(degrees) {}
+
+    double evalDIM(const Geometry::PointReference<DIM>& p) const {
+        double result = 1., value, derivative;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            computeLegendre(degrees_[i], p[i], value, derivative);
+            result *= value;
+        }
+        return result;
+    }
+
+    double evalDerivDIM(const Geometry::PointReference<DIM>& p,
+                        std::size_t derivCoord) const {
+        double result = 1., value, derivative;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            computeLegendre(degrees_[i], p[i], value, derivative);
+            result *= (i == derivCoord ? derivative : value);
+        }
+        return result;
+    }
+
+   private:
+    std::array<std::size_t, DIM> degrees_;
+};
+
+class OrthonormalBasisFunction1DLine : public Base::BaseBasisFunction,
+                                       private OrthonormalTensorProduct<1> {
+   public:
+    explicit OrthonormalBasisFunction1DLine(std::size_t degree)
+        : OrthonormalTensorProduct<1>({degree}) {}
+
+    double eval(const Geometry::PointReference<1>& p) const final {
+        return evalDIM(p);
+    }
+
+    double evalDeriv0(const Geometry::PointReference<1>& p) const final {
+        return evalDerivDIM(p, 0);
+    }
+};
+
+class OrthonormalBasisFunction2DSquare : public Base::BaseBasisFunction,
+                                         private OrthonormalTensorProduct<2> {
+   public:
+    OrthonormalBasisFunction2DSquare(std::size_t degree0, std::size_t degree1)
+        : OrthonormalTensorProduct<2>({degree0, degree1}) {}
+
+    double eval(const Geometry::PointReference<2>& p) const final {
+        return evalDIM(p);
+    }
+
+    double evalDeriv0(const Geometry::PointReference<2>& p) const final {
+        return evalDerivDIM(p, 0);
+    }
+
+    double evalDeriv1(const Geometry::PointReference<2>& p) const final {
+        return evalDerivDIM(p, 1);
+    }
+};
+
+class OrthonormalBasisFunction3DCube : public Base::BaseBasisFunction,
+                                       private OrthonormalTensorProduct<3> {
+   public:
+    OrthonormalBasisFunction3DCube(std::size_t degree0, std::size_t degree1,
+                                   std::size_t degree2)
+        : OrthonormalTensorProduct<3>({degree0, degree1, degree2}) {}
+
+    double eval(const Geometry::PointReference<3>& p) const final {
+        return evalDIM(p);
+    }
+
+    double evalDeriv0(const Geometry::PointReference<3>& p) const final {
+        return evalDerivDIM(p, 0);
+    }
+
+    double evalDeriv1(const Geometry::PointReference<3>& p) const final {
+        return evalDerivDIM(p, 1);
+    }
+
+    double evalDeriv2(const Geometry::PointReference<3>& p) const final {
+        return evalDerivDIM(p, 2);
+    }
+};
+
+/// Dubiner polynomial on the reference triangle (0,0), (1,0), (0,1). With
+/// r = 2x - 1 and s = 2y - 1 it is the product of Jacobi polynomials in the
+/// collapsed coordinates a = 2(1 + r)/(1 - s) - 1 and b = s:
+/// sqrt(8) P_i^{(0,0)}(a) P_j^{(2i+1,0)}(b) (1 - b)^i. The derivatives are
+/// written such that they do not divide by 1 - b, so they are also correct in
+/// the collapsed vertex (0,1).
+class OrthonormalBasisFunction2DTriangle : public Base::BaseBasisFunction {
+   public:
+    OrthonormalBasisFunction2DTriangle(std::size_t i, std::size_t j)
+        : i_(i), j_(j) {}
+
+    double eval(const Geometry::PointReference<2>& p) const final {
+        double a, b;
+        std::vector<double> A, dA, B, dB;
+        evaluateFactors(p, a, b, A, dA, B, dB);
+        return std::sqrt(8.) * A[i_] * B[j_] * integerPower(1. - b, i_);
+    }
+
+    double evalDeriv0(const Geometry::PointReference<2>& p) const final {
+        double a, b;
+        std::vector<double> A, dA, B, dB;
+        evaluateFactors(p, a, b, A, dA, B, dB);
+        return 2. * std::sqrt(8.) * derivativeR(b, dA, B);
+    }
+
+    double evalDeriv1(const Geometry::PointReference<2>& p) const final {
+        double a, b;
+        std::vector<double> A, dA, B, dB;
+        evaluateFactors(p, a, b, A, dA, B, dB);
+        double result = (1. + a) / 2. * derivativeR(b, dA, B) +
+                        A[i_] * dB[j_] * integerPower(1. - b, i_);
+        if (i_ > 0) {
+            result -= A[i_] * static_cast<double>(i_) * B[j_] *
+                      integerPower(1. - b, i_ - 1);
+        }
+        return 2. * std::sqrt(8.) * result;
+    }
+
+   private:
+    void evaluateFactors(const Geometry::PointReference<2>& p, double& a,
+                         double& b, std::vector<double>& A,
+                         std::vector<double>& dA, std::vector<double>& B,
+                         std::vector<double>& dB) const {
+        // the value of a does not matter in the collapsed vertex
+        a = std::abs(1. - p[1]) < 1e-14 ? -1. : 2. * p[0] / (1. - p[1]) - 1.;
+        b = 2. * p[1] - 1.;
+        computeJacobiPolynomials(i_, 0., a, A, dA);
+        computeJacobiPolynomials(j_, 2. * static_cast<double>(i_) + 1., b, B,
+                                 dB);
+    }
+
+    /// derivative with respect to r, without the normalisation factor
+    double derivativeR(double b, const std::vector<double>& dA,
+                       const std::vector<double>& B) const {
+        if (i_ == 0) {
+            return 0.;
+        }
+        return 2. * dA[i_] * B[j_] * integerPower(1. - b, i_ - 1);
+    }
+
+    std::size_t i_, j_;
+};
+
+/// Dubiner polynomial on the reference tetrahedron (0,0,0), (1,0,0), (0,1,0),
+/// (0,0,1). With r = 2x - 1, s = 2y - 1 and t = 2z - 1 it is the product of
+/// Jacobi polynomials in the collapsed coordinates a = 2(1 + r)/(-s - t) - 1,
+/// b = 2(1 + s)/(1 - t) - 1 and c = t: 8 P_i^{(0,0)}(a) P_j^{(2i+1,0)}(b)
+/// P_k^{(2i+2j+2,0)}(c) (1 - b)^i (1 - c)^(i+j). The derivatives are written
+/// such that they do not divide by 1 - b or 1 - c.
+class OrthonormalBasisFunction3DTetrahedron : public Base::BaseBasisFunction {
+   public:
+    OrthonormalBasisFunction3DTetrahedron(std::size_t i, std::size_t j,
+                                          std::size_t k)
+        : i_(i), j_(j), k_(k) {}
+
+    double eval(const Geometry::PointReference<3>& p) const final {
+        Factors f(*this, p);
+        return 8. * f.A[i_] * f.B[j_] * f.C[k_] *
+               integerPower(1. - f.b, i_) * integerPower(1. - f.c, i_ + j_);
+    }
+
+    double evalDeriv0(const Geometry::PointReference<3>& p) const final {
+        Factors f(*this, p);
+        return 16. * derivativeR(f);
+    }
+
+    double evalDeriv1(const Geometry::PointReference<3>& p) const final {
+        Factors f(*this, p);
+        return 16. * ((1. + f.a) / 2. * derivativeR(f) + derivativeB(f));
+    }
+
+    double evalDeriv2(const Geometry::PointReference<3>& p) const final {
+        Factors f(*this, p);
+        double result = (1. + f.a) / 2. * derivativeR(f) +
+                        (1. + f.b) / 2. * derivativeB(f);
+        double derivativeC = f.dC[k_] * integerPower(1. - f.c, i_ + j_);
+        if (i_ + j_ > 0) {
+            derivativeC -= static_cast<double>(i_ + j_) * f.C[k_] *
+                           integerPower(1. - f.c, i_ + j_ - 1);
+        }
+        result +=
+            f.A[i_] * f.B[j_] * integerPower(1. - f.b, i_) * derivativeC;
+        return 16. * result;
+    }
+
+   private:
+    /// the collapsed coordinates and the Jacobi polynomials in them
+    struct Factors {
+        Factors(const OrthonormalBasisFunction3DTetrahedron& function,
+                const Geometry::PointReference<3>& p) {
+            // the value of a (b) does not matter on the collapsed edge
+            // (vertex)
+            double denominatorA = 1. - p[1] - p[2];
+            double denominatorB = 1. - p[2];
+            a = std::abs(denominatorA) < 1e-14 ? -1.
+                                                : 2. * p[0] / denominatorA - 1.;
+            b = std::abs(denominatorB) < 1e-14 ? -1.
+                                                : 2. * p[1] / denominatorB - 1.;
+            c = 2. * p[2] - 1.;
+            computeJacobiPolynomials(function.i_, 0., a, A, dA);
+            computeJacobiPolynomials(
+                function.j_, 2. * static_cast<double>(function.i_) + 1., b, B,
+                dB);
+            computeJacobiPolynomials(
+                function.k_,
+                2. * static_cast<double>(function.i_ + function.j_) + 2., c, C,
+                dC);
+        }
+
+        double a, b, c;
+        std::vector<double> A, dA, B, dB, C, dC;
+    };
+
+    /// derivative with respect to r, without the normalisation factor
+    double derivativeR(const Factors& f) const {
+        if (i_ == 0) {
+            return 0.;
+        }
+        return 4. * f.dA[i_] * f.B[j_] * integerPower(1. - f.b, i_ - 1) *
+               f.C[k_] * integerPower(1. - f.c, i_ + j_ - 1);
+    }
+
+    /// contribution of the derivative with respect to b to the derivative
+    /// with respect to s, without the normalisation factor
+    double derivativeB(const Factors& f) const {
+        if (i_ + j_ == 0) {
+            return 0.;
+        }
+        double derivativeG = f.dB[j_] * integerPower(1. - f.b, i_);
+        if (i_ > 0) {
+            derivativeG -= static_cast<double>(i_) * f.B[j_] *
+                           integerPower(1. - f.b, i_ - 1);
+        }
+        return 2. * f.A[i_] * derivativeG * f.C[k_] *
+               integerPower(1. - f.c, i_ + j_ - 1);
+    }
+
+    std::size_t i_, j_, k_;
+};
+
+}  // namespace
+
+Base::BasisFunctionSet* createOrthonormalBasisFunctionSet1DLine(
+    std::size_t order) {
+    Base::BasisFunctionSet* result(new Base::BasisFunctionSet(order));
+    for (std::size_t i = 0; i <= order; ++i) {
+        result->addBasisFunction(new OrthonormalBasisFunction1DLine(i));
+    }
+    result->setOrthonormal(true);
+    return result;
+}
+
+Base::BasisFunctionSet* createOrthonormalBasisFunctionSet2DSquare(
+    std::size_t order) {
+    Base::BasisFunctionSet* result(new Base::BasisFunctionSet(order));
+    for (std::size_t i = 0; i <= order; ++i) {
+        for (std::size_t j = 0; j <= order; ++j) {
+            result->addBasisFunction(
+                new OrthonormalBasisFunction2DSquare(i, j));
+        }
+    }
+    result->setOrthonormal(true);
+    return result;
+}
+
+Base::BasisFunctionSet* createOrthonormalBasisFunctionSet2DTriangle(
+    std::size_t order) {
+    Base::BasisFunctionSet* result(new Base::BasisFunctionSet(order));
+    for (std::size_t i = 0; i <= order; ++i) {
+        for (std::size_t j = 0; i + j <= order; ++j) {
+            result->addBasisFunction(
+                new OrthonormalBasisFunction2DTriangle(i, j));
+        }
+    }
+    result->setOrthonormal(true);
+    return result;
+}
+
+Base::BasisFunctionSet* createOrthonormalBasisFunctionSet3DCube(
+    std::size_t order) {
+    Base::BasisFunctionSet* result(new Base::BasisFunctionSet(order));
+    for (std::size_t i = 0; i <= order; ++i) {
+        for (std::size_t j = 0; j <= order; ++j) {
+            for (std::size_t k = 0; k <= order; ++k) {
+                result->addBasisFunction(
+                    new OrthonormalBasisFunction3DCube(i, j, k));
+            }
+        }
+    }
+    result->setOrthonormal(true);
+    return result;
+}
+
+Base::BasisFunctionSet* createOrthonormalBasisFunctionSet3DTetrahedron(
+    std::size_t order) {
+    Base::BasisFunctionSet* result(new Base::BasisFunctionSet(order));
+    for (std::size_t i = 0; i <= order; ++i) {
+        for (std::size_t j = 0; i + j <= order; ++j) {
+            for (std::size_t k = 0; i + j + k <= order; ++k) {
+                result->addBasisFunction(
+                    new OrthonormalBasisFunction3DTetrahedron(i, j, k));
+            }
+        }
+    }
+    result->setOrthonormal(true);
+    return result;
+}
+
+}  // namespace Utilities
+
+}  // namespace hpgem
@@ -0,0 +1,75 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPGEM_KERNEL_BASISFUNCTIONSORTHONORMAL_H
+#define HPGEM_KERNEL_BASISFUNCTIONSORTHONORMAL_H
+
+#include <cstddef>
+
+namespace hpgem {
+
+namespace Base {
+class BasisFunctionSet;
+}
+
+namespace Utilities {
+
+/// \brief Orthonormal modal DG basis functions
+/// \details The basis functions are orthonormal in the L2 inner product on the
+/// reference element, so the mass matrix of an element with an affine mapping
+/// is |J| times the identity matrix. Lines, squares and cubes use products of
+/// normalised Legendre polynomials (all degrees up to order in each direction,
+/// like the default DG basis functions), triangles and tetrahedra use the
+/// Dubiner (Proriol-Koornwinder) polynomials of total degree up to order. The
+/// returned sets are marked as orthonormal.
+Base::BasisFunctionSet* createOrthonormalBasisFunctionSet1DLine(
+    std::size_t order);
+Base::BasisFunctionSet* createOrthonormalBasisFunctionSet2DSquare(
+    std::size_t order);
+Base::BasisFunctionSet* createOrthonormalBasisFunctionSet2DTriangle(
+    std::size_t order);
+Base::BasisFunctionSet* createOrthonormalBasisFunctionSet3DCube(
+    std::size_t order);
+Base::BasisFunctionSet* createOrthonormalBasisFunctionSet3DTetrahedron(
+    std::size_t order);
+
+}  // namespace Utilities
+
+}  // namespace hpgem
+
+#endif  // HPGEM_KERNEL_BASISFUNCTIONSORTHONORMAL_H
@@ -0,0 +1,198 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SpaceFillingCurvePartitioner.h"
+#include "Base/MpiContainer.h"
+
+#include <cmath>
+#include <numeric>
+
+namespace hpgem {
+
+namespace Utilities {
+
+std::vector<std::size_t> partitionAlongCurve(
+    const std::vector<std::uint64_t>& curveIndices,
+    const std::vector<double>& weights, std::size_t numberOfPartitions) {
+    logger.assert_always(curveIndices.size() == weights.size(),
+                         "There are % curve indices, but % weights",
+                         curveIndices.size(), weights.size());
+    logger.assert_always(numberOfPartitions > 0,
+                         "Need at least one partition");
+    const std::size_t numberOfItems = curveIndices.size();
+    std::vector<std::size_t> order(numberOfItems);
+    std::iota(order.begin(), order.end(), 0);
+    // Stable, so that items at the same location keep their original order
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t a, std::size_t b) {
+                         return curveIndices[a] < curveIndices[b];
+                     });
+    double totalWeight = 0;
+    for (double weight : weights) {
+        logger.assert_debug(weight >= 0, "Negative weight %", weight);
+        totalWeight += weight;
+    }
+
+    std::vector<std::size_t> result(numberOfItems, 0);
+    double weightBefore = 0;
+    std::size_t previousPartition = 0;
+    for (std::size_t i = 0; i < numberOfItems; ++i) {
+        std::size_t item = order[i];
+        // Assign each item to the partition that contains its midpoint
+        double midpoint = weightBefore + weights[item] / 2;
+        std::size_t partition = 0;
+        if (totalWeight > 0) {
+            partition = static_cast<std::size_t>(
+                std::floor(static_cast<double>(numberOfPartitions) * midpoint /
+                           totalWeight));
+        }
+        // Leave enough items for the remaining partitions, and do not skip a
+        // partition when a single item is heavier than the target weight.
+        if (numberOfItems - i < numberOfPartitions) {
+            partition =
+                std::max(partition, numberOfPartitions - (numberOfItems - i));
+        }
+        if (i > 0) {
+            partition = std::min(partition, previousPartition + 1);
+        } else {
+            partition = 0;
+        }
+        partition = std::min(partition, numberOfPartitions - 1);
+        result[item] = partition;
+        previousPartition = partition;
+        weightBefore += weights[item];
+    }
+    return result;
+}
+
+std::vector<std::size_t> partitionAlongCurveInParallel(
+    const std::vector<std::uint64_t>& curveIndices,
+    const std::vector<double>& weights, std::size_t numberOfPartitions) {
+    logger.assert_always(curveIndices.size() == weights.size(),
+                         "There are % curve indices, but % weights",
+                         curveIndices.size(), weights.size());
+    logger.assert_always(numberOfPartitions > 0,
+                         "Need at least one partition");
+    const std::size_t numberOfItems = curveIndices.size();
+    std::vector<std::size_t> order(numberOfItems);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return curveIndices[a] < curveIndices[b];
+    });
+    std::vector<std::uint64_t> sortedIndices(numberOfItems);
+    // weightBefore[i] is the weight of the first i local items along the curve
+    std::vector<double> weightBefore(numberOfItems + 1, 0.);
+    for (std::size_t i = 0; i < numberOfItems; ++i) {
+        logger.assert_debug(weights[order[i]] >= 0, "Negative weight %",
+                            weights[order[i]]);
+        sortedIndices[i] = curveIndices[order[i]];
+        weightBefore[i + 1] = weightBefore[i] + weights[order[i]];
+    }
+    double totalWeight = weightBefore.back();
+#ifdef HPGEM_USE_MPI
+    auto& communicator = Base::MPIContainer::Instance();
+    communicator.reduce(totalWeight, MPI_SUM);
+    communicator.broadcast(totalWeight);
+#endif
+    if (totalWeight <= 0) {
+        return std::vector<std::size_t>(numberOfItems, 0);
+    }
+
+    // Partition j + 1 starts at the smallest curve index s for which the
+    // weight before s plus half the weight at s is at least (j + 1) /
+    // numberOfPartitions of the total weight. The curve indices use 63 bits.
+    std::vector<std::uint64_t> lower(numberOfPartitions - 1, 0);
+    std::vector<std::uint64_t> upper(numberOfPartitions - 1,
+                                     std::uint64_t(1) << 63);
+    std::vector<double> sums(2 * (numberOfPartitions - 1));
+    bool converged = numberOfPartitions == 1;
+    while (!converged) {
+        for (std::size_t j = 0; j + 1 < numberOfPartitions; ++j) {
+            std::uint64_t middle = lower[j] + (upper[j] - lower[j]) / 2;
+            auto begin = std::lower_bound(sortedIndices.begin(),
+                                          sortedIndices.end(), middle) -
+                         sortedIndices.begin();
+            auto end = std::upper_bound(sortedIndices.begin(),
+                                        sortedIndices.end(), middle) -
+                       sortedIndices.begin();
+            sums[2 * j] = weightBefore[begin];
+            sums[2 * j + 1] = weightBefore[end] - weightBefore[begin];
+        }
+#ifdef HPGEM_USE_MPI
+        communicator.reduce(sums, MPI_SUM);
+        communicator.broadcast(sums);
+#endif
+        converged = true;
+        for (std::size_t j = 0; j + 1 < numberOfPartitions; ++j) {
+            std::uint64_t middle = lower[j] + (upper[j] - lower[j]) / 2;
+            double target = totalWeight * static_cast<double>(j + 1) /
+                            static_cast<double>(numberOfPartitions);
+            if (sums[2 * j] + sums[2 * j + 1] / 2 >= target) {
+                upper[j] = middle;
+            } else {
+                lower[j] = middle + 1;
+            }
+            converged = converged && lower[j] == upper[j];
+        }
+    }
+
+    std::vector<std::size_t> result(numberOfItems);
+    for (std::size_t i = 0; i < numberOfItems; ++i) {
+        result[i] = static_cast<std::size_t>(
+            std::upper_bound(lower.begin(), lower.end(), curveIndices[i]) -
+            lower.begin());
+    }
+    return result;
+}
+
+namespace Detail {
+void minimumOverProcessors(std::vector<double>& values) {
+#ifdef HPGEM_USE_MPI
+    auto& communicator = Base::MPIContainer::Instance();
+    communicator.reduce(values, MPI_MIN);
+    communicator.broadcast(values);
+#else
+    // we are the only processor if there is no MPI
+    (void)values;
+#endif
+}
+}  // namespace Detail
+
+}  // namespace Utilities
+
+}  // namespace hpgem
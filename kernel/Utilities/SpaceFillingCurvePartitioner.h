@@ -0,0 +1,197 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HPGEM_KERNEL_SPACEFILLINGCURVEPARTITIONER_H
+#define HPGEM_KERNEL_SPACEFILLINGCURVEPARTITIONER_H
+
+#include "LinearAlgebra/SmallVector.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace hpgem {
+
+namespace Utilities {
+
+/// Position of a point along a Morton (Z-order) curve through an axis aligned
+/// bounding box. Points that are close along the curve are also close in
+/// space, so cutting the curve into consecutive pieces gives compact
+/// partitions.
+/// \param point The point, clamped to the bounding box
+/// \param lowerCorner The lower corner of the bounding box
+/// \param upperCorner The upper corner of the bounding box
+template <std::size_t DIM>
+std::uint64_t computeMortonIndex(
+    const LinearAlgebra::SmallVector<DIM>& point,
+    const LinearAlgebra::SmallVector<DIM>& lowerCorner,
+    const LinearAlgebra::SmallVector<DIM>& upperCorner) {
+    // Number of bits per direction, such that all directions fit in 63 bits
+    const std::size_t bitsPerDirection = 63 / std::max<std::size_t>(DIM, 1);
+    const std::uint64_t maximumCoordinate =
+        (std::uint64_t(1) << bitsPerDirection) - 1;
+    std::vector<std::uint64_t> coordinates(DIM);
+    for (std::size_t i = 0; i < DIM; ++i) {
+        double width = upperCorner[i] - lowerCorner[i];
+        double relative =
+            width > 0 ? (point[i] - lowerCorner[i]) / width : 0.;
+        relative = std::min(std::max(relative, 0.), 1.);
+        coordinates[i] = static_cast<std::uint64_t>(
+            relative * static_cast<double>(maximumCoordinate));
+        coordinates[i] = std::min(coordinates[i], maximumCoordinate);
+    }
+    // Interleave the bits, most significant bits first, with the first
+    // coordinate in the least significant position
+    std::uint64_t result = 0;
+    for (std::size_t bit = bitsPerDirection; bit-- > 0;) {
+        for (std::size_t i = DIM; i-- > 0;) {
+            result = (result << 1) | ((coordinates[i] >> bit) & 1);
+        }
+    }
+    return result;
+}
+
+/// Cut a sequence of weighted items into consecutive partitions of
+/// approximately equal weight, in order of increasing curve index.
+/// \param curveIndices Position of each item along the curve
+/// \param weights The (positive) weight of each item
+/// \param numberOfPartitions The number of partitions to create
+/// \return The partition of each item. When there are at least as many items
+/// as partitions, every partition receives at least one item.
+std::vector<std::size_t> partitionAlongCurve(
+    const std::vector<std::uint64_t>& curveIndices,
+    const std::vector<double>& weights, std::size_t numberOfPartitions);
+
+/// Partition weighted points by cutting the Morton curve through their
+/// bounding box into pieces of approximately equal weight.
+/// \param points The location of each item, for example element centres
+/// \param weights The (positive) weight of each item
+/// \param numberOfPartitions The number of partitions to create
+/// \return The partition of each item
+template <std::size_t DIM>
+std::vector<std::size_t> partitionAlongSpaceFillingCurve(
+    const std::vector<LinearAlgebra::SmallVector<DIM>>& points,
+    const std::vector<double>& weights, std::size_t numberOfPartitions) {
+    logger.assert_always(points.size() == weights.size(),
+                         "There are % points, but % weights", points.size(),
+                         weights.size());
+    if (points.empty()) {
+        return {};
+    }
+    LinearAlgebra::SmallVector<DIM> lowerCorner = points[0];
+    LinearAlgebra::SmallVector<DIM> upperCorner = points[0];
+    for (const LinearAlgebra::SmallVector<DIM>& point : points) {
+        for (std::size_t i = 0; i < DIM; ++i) {
+            lowerCorner[i] = std::min(lowerCorner[i], point[i]);
+            upperCorner[i] = std::max(upperCorner[i], point[i]);
+        }
+    }
+    std::vector<std::uint64_t> curveIndices;
+    curveIndices.reserve(points.size());
+    for (const LinearAlgebra::SmallVector<DIM>& point : points) {
+        curveIndices.push_back(
+            computeMortonIndex(point, lowerCorner, upperCorner));
+    }
+    return partitionAlongCurve(curveIndices, weights, numberOfPartitions);
+}
+
+/// Cut the curve through the items of all processors into partitions of
+/// approximately equal weight, without collecting the items on one processor.
+/// Like in partitionAlongCurve an item goes to the partition that contains the
+/// midpoint of its weight, but partitions may stay empty. The first curve index
+/// of every partition is found by bisection over all curve indices, which
+/// takes one reduction of 2 * numberOfPartitions numbers per bit of the curve
+/// index. All processors must call this function.
+/// \param curveIndices Position of each local item along the curve
+/// \param weights The (positive) weight of each local item
+/// \param numberOfPartitions The number of partitions to create
+/// \return The partition of each local item
+std::vector<std::size_t> partitionAlongCurveInParallel(
+    const std::vector<std::uint64_t>& curveIndices,
+    const std::vector<double>& weights, std::size_t numberOfPartitions);
+
+namespace Detail {
+/// Replace each value by its minimum over all processors
+void minimumOverProcessors(std::vector<double>& values);
+}  // namespace Detail
+
+/// Partition weighted points that are spread over all processors by cutting
+/// the Morton curve through their bounding box into pieces of approximately
+/// equal weight, see partitionAlongCurveInParallel. All processors must call
+/// this function.
+/// \param points The location of each local item, for example element centres
+/// \param weights The (positive) weight of each local item
+/// \param numberOfPartitions The number of partitions to create
+/// \return The partition of each local item
+template <std::size_t DIM>
+std::vector<std::size_t> partitionAlongSpaceFillingCurveInParallel(
+    const std::vector<LinearAlgebra::SmallVector<DIM>>& points,
+    const std::vector<double>& weights, std::size_t numberOfPartitions) {
+    logger.assert_always(points.size() == weights.size(),
+                         "There are % points, but % weights", points.size(),
+                         weights.size());
+    // the upper corner is the minimum of the negated coordinates
+    std::vector<double> corners(2 * DIM, std::numeric_limits<double>::max());
+    for (const LinearAlgebra::SmallVector<DIM>& point : points) {
+        for (std::size_t i = 0; i < DIM; ++i) {
+            corners[i] = std::min(corners[i], point[i]);
+            corners[DIM + i] = std::min(corners[DIM + i], -point[i]);
+        }
+    }
+    Detail::minimumOverProcessors(corners);
+    LinearAlgebra::SmallVector<DIM> lowerCorner, upperCorner;
+    for (std::size_t i = 0; i < DIM; ++i) {
+        lowerCorner[i] = corners[i];
+        upperCorner[i] = -corners[DIM + i];
+    }
+    std::vector<std::uint64_t> curveIndices;
+    curveIndices.reserve(points.size());
+    for (const LinearAlgebra::SmallVector<DIM>& point : points) {
+        curveIndices.push_back(
+            computeMortonIndex(point, lowerCorner, upperCorner));
+    }
+    return partitionAlongCurveInParallel(curveIndices, weights,
+                                         numberOfPartitions);
+}
+
+}  // namespace Utilities
+
+}  // namespace hpgem
+
+#endif  // HPGEM_KERNEL_SPACEFILLINGCURVEPARTITIONER_H
@@ -0,0 +1,126 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPGEM_KERNEL_TENSORPRODUCTBASISFUNCTION_H
+#define HPGEM_KERNEL_TENSORPRODUCTBASISFUNCTION_H
+
+#include <array>
+#include <vector>
+#include "Base/BaseBasisFunction.h"
+#include "Base/BasisFunctionSetEvaluator.h"
+
+namespace hpgem {
+
+namespace Base {
+class BasisFunctionSet;
+}
+
+namespace Utilities {
+
+/// One dimensional factor of a tensor product basis function. It is either
+/// the linear function (1 + vertexPosition * x) / 2 that is 1 in the vertex at
+/// vertexPosition = -1 or 1, or (if vertexPosition is 0) the bubble
+/// (1 - x) * (1 + x) / 4 * LobattoPolynomial(degree, mirroring * x)
+struct TensorProductFactor {
+    int vertexPosition;
+    std::size_t degree;
+    int mirroring;
+};
+
+inline TensorProductFactor vertexFactor(int vertexPosition) {
+    return {vertexPosition, 0, 1};
+}
+
+inline TensorProductFactor bubbleFactor(std::size_t degree,
+                                        int mirroring = 1) {
+    return {0, degree, mirroring};
+}
+
+/// Basis function on a line, square or cube that is the product of one
+/// dimensional factors in each coordinate direction. Sets that consist of
+/// these basis functions only can be evaluated by a TensorProductEvaluator.
+template <std::size_t DIM>
+class TensorProductBasisFunction : public Base::BaseBasisFunction {
+   public:
+    virtual std::array<TensorProductFactor, DIM> getFactors() const = 0;
+};
+
+/// Evaluates all basis functions of a set of TensorProductBasisFunctions at
+/// once. The Lobatto polynomials are computed only once per coordinate
+/// direction and reused for all basis functions that share them.
+template <std::size_t DIM>
+class TensorProductEvaluator : public Base::BasisFunctionSetEvaluator {
+   public:
+    explicit TensorProductEvaluator(
+        const std::vector<const TensorProductBasisFunction<DIM>*>& functions);
+
+    void evalAll(const Geometry::PointReference<DIM>& p,
+                 std::vector<double>& values) const override;
+
+    void evalAllDerivs(
+        const Geometry::PointReference<DIM>& p,
+        std::vector<LinearAlgebra::SmallVector<DIM>>& derivs) const override;
+
+   private:
+    /// values and derivatives of all factors in each coordinate direction
+    void computeFactors(
+        const Geometry::PointReference<DIM>& p,
+        std::array<std::vector<double>, DIM>& values,
+        std::array<std::vector<double>, DIM>* derivatives) const;
+
+    /// for every basis function the position of its factors in the tables
+    /// computed by computeFactors
+    std::vector<std::array<std::size_t, DIM>> factorIndices_;
+    /// the combined sign of the mirrored bubble factors of a basis function
+    std::vector<double> signs_;
+    std::size_t numberOfBubbles_;
+};
+
+/// Sets a TensorProductEvaluator for the basis function set, if all its basis
+/// functions are TensorProductBasisFunctions. Otherwise the set keeps
+/// evaluating its basis functions one by one.
+template <std::size_t DIM>
+void useTensorProductEvaluator(Base::BasisFunctionSet* set);
+
+}  // namespace Utilities
+
+}  // namespace hpgem
+
+#include "TensorProductBasisFunction_Impl.h"
+
+#endif  // HPGEM_KERNEL_TENSORPRODUCTBASISFUNCTION_H
@@ -0,0 +1,166 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TensorProductBasisFunction.h"
+
+#include <algorithm>
+#include "helperFunctions.h"
+#include "Base/BasisFunctionSet.h"
+#include "Geometry/PointReference.h"
+#include "LinearAlgebra/SmallVector.h"
+
+namespace hpgem {
+
+namespace Utilities {
+
+template <std::size_t DIM>
+TensorProductEvaluator<DIM>::TensorProductEvaluator(
+    const std::vector<const TensorProductBasisFunction<DIM>*>& functions)
+    : factorIndices_(functions.size()),
+      signs_(functions.size(), 1.),
+      numberOfBubbles_(0) {
+    for (std::size_t i = 0; i < functions.size(); ++i) {
+        std::array<TensorProductFactor, DIM> factors =
+            functions[i]->getFactors();
+        for (std::size_t d = 0; d < DIM; ++d) {
+            const TensorProductFactor& factor = factors[d];
+            if (factor.vertexPosition != 0) {
+                logger.assert_debug(
+                    factor.vertexPosition == 1 || factor.vertexPosition == -1,
+                    "A vertex factor should be 1 in vertex -1 or in vertex 1");
+                factorIndices_[i][d] = (factor.vertexPosition + 1) / 2;
+            } else {
+                // the (anti-)symmetry of the Lobatto polynomials allows to
+                // evaluate the mirrored bubble by changing the sign
+                if (factor.mirroring == -1 && factor.degree % 2 == 1) {
+                    signs_[i] = -signs_[i];
+                }
+                factorIndices_[i][d] = 2 + factor.degree;
+                numberOfBubbles_ =
+                    std::max(numberOfBubbles_, factor.degree + 1);
+            }
+        }
+    }
+}
+
+template <std::size_t DIM>
+void TensorProductEvaluator<DIM>::computeFactors(
+    const Geometry::PointReference<DIM>& p,
+    std::array<std::vector<double>, DIM>& values,
+    std::array<std::vector<double>, DIM>* derivatives) const {
+    std::vector<double> lobatto, lobattoDerivative;
+    for (std::size_t d = 0; d < DIM; ++d) {
+        double x = p[d];
+        values[d].resize(2 + numberOfBubbles_);
+        values[d][0] = (1. - x) / 2.;
+        values[d][1] = (1. + x) / 2.;
+        if (derivatives != nullptr) {
+            (*derivatives)[d].resize(2 + numberOfBubbles_);
+            (*derivatives)[d][0] = -0.5;
+            (*derivatives)[d][1] = 0.5;
+        }
+        if (numberOfBubbles_ == 0) {
+            continue;
+        }
+        computeLobattoPolynomials(numberOfBubbles_ - 1, x, lobatto,
+                                  lobattoDerivative);
+        double bubble = (1. - x) * (1. + x) / 4.;
+        for (std::size_t k = 0; k < numberOfBubbles_; ++k) {
+            values[d][2 + k] = bubble * lobatto[k];
+            if (derivatives != nullptr) {
+                (*derivatives)[d][2 + k] =
+                    -x * lobatto[k] / 2. + bubble * lobattoDerivative[k];
+            }
+        }
+    }
+}
+
+template <std::size_t DIM>
+void TensorProductEvaluator<DIM>::evalAll(
+    const Geometry::PointReference<DIM>& p, std::vector<double>& values) const {
+    std::array<std::vector<double>, DIM> factorValues;
+    computeFactors(p, factorValues, nullptr);
+    values.resize(factorIndices_.size());
+    for (std::size_t i = 0; i < factorIndices_.size(); ++i) {
+        double value = signs_[i];
+        for (std::size_t d = 0; d < DIM; ++d) {
+            value *= factorValues[d][factorIndices_[i][d]];
+        }
+        values[i] = value;
+    }
+}
+
+template <std::size_t DIM>
+void TensorProductEvaluator<DIM>::evalAllDerivs(
+    const Geometry::PointReference<DIM>& p,
+    std::vector<LinearAlgebra::SmallVector<DIM>>& derivs) const {
+    std::array<std::vector<double>, DIM> factorValues, factorDerivatives;
+    computeFactors(p, factorValues, &factorDerivatives);
+    derivs.resize(factorIndices_.size());
+    for (std::size_t i = 0; i < factorIndices_.size(); ++i) {
+        for (std::size_t j = 0; j < DIM; ++j) {
+            double value = signs_[i];
+            for (std::size_t d = 0; d < DIM; ++d) {
+                if (d == j) {
+                    value *= factorDerivatives[d][factorIndices_[i][d]];
+                } else {
+                    value *= factorValues[d][factorIndices_[i][d]];
+                }
+            }
+            derivs[i][j] = value;
+        }
+    }
+}
+
+template <std::size_t DIM>
+void useTensorProductEvaluator(Base::BasisFunctionSet* set) {
+    std::vector<const TensorProductBasisFunction<DIM>*> functions;
+    for (const Base::BaseBasisFunction* function : *set) {
+        auto tensorFunction =
+            dynamic_cast<const TensorProductBasisFunction<DIM>*>(function);
+        if (tensorFunction == nullptr) {
+            return;
+        }
+        functions.push_back(tensorFunction);
+    }
+    set->setEvaluator(new TensorProductEvaluator<DIM>(functions));
+}
+
+}  // namespace Utilities
+
+}  // namespace hpgem
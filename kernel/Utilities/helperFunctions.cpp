@@ -45,6 +45,15 @@ namespace hpgem {
 
 namespace Utilities {
 
+namespace {
+/// scaling of the derivative of the legendre polynomial of degree + 1, such
+/// that the lobatto polynomials are normalised
+double LobattoScaling(std::size_t degree) {
+    const double k = static_cast<double>(degree);
+    return -2. * std::sqrt(2. * (2. * k + 3.)) / ((k + 1.) * (k + 2.));
+}
+}  // namespace
+
 /// computes the lobatto polynomials. Excludes the (1-x*x) component
 double LobattoPolynomial(std::size_t degree, double x) {
     switch (degree) {
@@ -60,7 +69,7 @@ double LobattoPolynomial(std::size_t degree, double x) {
                  // automatic testing of quadrature rules
             return std::sqrt(11. / 2.) * ((21 * x * x - 14) * x * x + 1) / -4.;
         case 5:
-            return std::sqrt(13. / 2.) * ((33 * x * x - 30 * x * x) + 5) * x /
+            return std::sqrt(13. / 2.) * ((33 * x * x - 30) * x * x + 5) * x /
                    -4.;
         case 6:
             return std::sqrt(15. / 2.) *
@@ -82,7 +91,8 @@ double LobattoPolynomial(std::size_t degree, double x) {
                     63) *
                    x / -64.;
         default:
-            return LegendrePolynomialDerivative(degree + 1, x);
+            return LobattoScaling(degree) *
+                   LegendrePolynomialDerivative(degree + 1, x);
     }
     // Be nice to the compiler and don't remove this.
     return 0;
@@ -99,40 +109,70 @@ double LobattoPolynomialDerivative(std::size_t degree, double x) {
         case 3:
             return -2 * std::sqrt(9. / 2.) * (5.25 * x * x - .75);
         default:
-            logger(FATAL,
-                   "Derivatives of Lobatto polynomials of this order have not "
-                   "been implemented");
+            std::vector<double> values, derivatives;
+            computeLobattoPolynomials(degree, x, values, derivatives);
+            return derivatives[degree];
     }
     // Be nice to the compiler and don't remove this.
     return 0;
 }
 
 double LegendrePolynomial(std::size_t degree, double x) {
-    switch (degree) {
-        case 0:
-            return 1;
-        case 1:
-            return x;
-        default:
-            return (2. * degree - 1.) / double(degree) * x *
-                       LegendrePolynomial(degree - 1, x) -
-                   (degree - 1.) / double(degree) *
-                       LegendrePolynomial(degree - 2, x);
+    // P_n = ((2n - 1) x P_{n-1} - (n - 1) P_{n-2}) / n
+    double previous = 0., current = 1.;
+    for (std::size_t i = 1; i <= degree; ++i) {
+        const double n = static_cast<double>(i);
+        double next = ((2. * n - 1.) * x * current - (n - 1.) * previous) / n;
+        previous = current;
+        current = next;
     }
+    return current;
 }
 
 double LegendrePolynomialDerivative(std::size_t degree, double x) {
-    switch (degree) {
-        case 0:
-            return 0;
-        case 1:
-            return 1;
-        default:
-            return (2. * degree - 1.) / double(degree) *
-                       (x * LegendrePolynomialDerivative(degree - 1, x) +
-                        LegendrePolynomial(degree - 1, x)) -
-                   (degree - 1.) / double(degree) *
-                       LegendrePolynomialDerivative(degree - 2, x);
+    // P'_n = P'_{n-2} + (2n - 1) P_{n-1}
+    double legendrePrevious = 0., legendre = 1.;
+    double derivativePrevious = 0., derivative = 0.;
+    for (std::size_t i = 1; i <= degree; ++i) {
+        const double n = static_cast<double>(i);
+        double nextDerivative = derivativePrevious + (2. * n - 1.) * legendre;
+        double next =
+            ((2. * n - 1.) * x * legendre - (n - 1.) * legendrePrevious) / n;
+        legendrePrevious = legendre;
+        legendre = next;
+        derivativePrevious = derivative;
+        derivative = nextDerivative;
+    }
+    return derivative;
+}
+
+/// The lobatto polynomial of degree k is a scaled version of the derivative of
+/// the legendre polynomial of degree k + 1, so we need the legendre polynomials
+/// and their first and second derivatives. These satisfy
+/// P'_n = P'_{n-2} + (2n - 1) P_{n-1} and P''_n = P''_{n-2} + (2n - 1) P'_{n-1}
+void computeLobattoPolynomials(std::size_t maxDegree, double x,
+                               std::vector<double>& values,
+                               std::vector<double>& derivatives) {
+    values.resize(maxDegree + 1);
+    derivatives.resize(maxDegree + 1);
+    // legendre polynomials and derivatives of degree n - 1 and n - 2
+    double legendre = 1., legendrePrevious = 0.;
+    double first = 0., firstPrevious = 0.;
+    double second = 0., secondPrevious = 0.;
+    for (std::size_t i = 1; i <= maxDegree + 1; ++i) {
+        const double n = static_cast<double>(i);
+        double nextLegendre =
+            ((2. * n - 1.) * x * legendre - (n - 1.) * legendrePrevious) / n;
+        double nextFirst = firstPrevious + (2. * n - 1.) * legendre;
+        double nextSecond = secondPrevious + (2. * n - 1.) * first;
+        legendrePrevious = legendre;
+        legendre = nextLegendre;
+        firstPrevious = first;
+        first = nextFirst;
+        secondPrevious = second;
+        second = nextSecond;
+        values[i - 1] = LobattoScaling(i - 1) * first;
+        derivatives[i - 1] = LobattoScaling(i - 1) * second;
     }
 }
 
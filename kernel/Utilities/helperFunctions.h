@@ -39,6 +39,7 @@
 #define HPGEM_KERNEL_HELPERFUNCTIONS_H
 
 #include <cstdlib>
+#include <vector>
 
 namespace hpgem {
 
@@ -57,6 +58,13 @@ double LegendrePolynomial(std::size_t degree, double x);
 
 double LegendrePolynomialDerivative(std::size_t degree, double x);
 
+/// computes the lobatto polynomials of degree 0 up to and including maxDegree
+/// and their derivatives in one pass of the recurrence relations. Excludes the
+/// (1-x*x) component
+void computeLobattoPolynomials(std::size_t maxDegree, double x,
+                               std::vector<double>& values,
+                               std::vector<double>& derivatives);
+
 double baricentric_3D(std::size_t node, const Geometry::PointReference<3>& p);
 
 double baricentric_2D(std::size_t node, const Geometry::PointReference<2>& p);
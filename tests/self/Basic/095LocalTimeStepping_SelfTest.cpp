@@ -0,0 +1,192 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <functional>
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/HpgemAPISimplified.h"
+#include "Logger.h"
+
+#include "upwindAdvection.h"
+
+/// This class is used to test local time stepping in HpgemAPISimplified. It
+/// solves the 1D advection equation du/dt + a du/dx = 0 with an upwind flux
+/// on a periodic mesh. The left half of the domain is pretended to be three
+/// times as restrictive for the time step as the right half, such that the
+/// elements are divided over several local time levels.
+using namespace hpgem;
+class LocalAdvection : public Base::HpgemAPISimplified<1> {
+   public:
+    explicit LocalAdvection(const std::size_t p)
+        : Base::HpgemAPISimplified<1>(
+              1, p,
+              TimeIntegration::AllTimeIntegrators::Instance().getRule(3, 3,
+                                                                      true)),
+          a({0.5}) {}
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtElement(
+        Base::Element *ptrElement,
+        const LinearAlgebra::MiddleSizeVector &inputFunctionCoefficients,
+        const double /*time*/) final {
+        return AdvectionTest::integrateAdvectionAtElement(
+            elementIntegrator_, ptrElement, a, inputFunctionCoefficients);
+    }
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtFace(
+        Base::Face *ptrFace, const Base::Side iSide,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsLeft,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsRight,
+        const double /*time*/) final {
+        return AdvectionTest::integrateUpwindFluxAtFace(
+            faceIntegrator_, ptrFace, iSide, a, inputFunctionCoefficientsLeft,
+            inputFunctionCoefficientsRight);
+    }
+
+    LinearAlgebra::MiddleSizeVector getExactSolution(
+        const PointPhysicalT &point, const double &time,
+        const std::size_t /*orderTimeDerivative*/) final {
+        LinearAlgebra::MiddleSizeVector exactSolution(1);
+        exactSolution(0) = 1. + std::sin(2 * M_PI * (point[0] - a[0] * time));
+        return exactSolution;
+    }
+
+    LinearAlgebra::MiddleSizeVector getInitialSolution(
+        const PointPhysicalT &point, const double &startTime,
+        const std::size_t orderTimeDerivative) final {
+        return getExactSolution(point, startTime, orderTimeDerivative);
+    }
+
+    /// Pretend that the elements in the left half of the domain are more
+    /// restrictive for the time step.
+    double computeLocalTimeStepAtElement(Base::Element *ptrElement) final {
+        const Geometry::PointReference<1> &center =
+            ptrElement->getReferenceGeometry()->getCenter();
+        if (ptrElement->referenceToPhysical(center)[0] < 0.5) {
+            return 1.;
+        }
+        return 3.;
+    }
+
+    LinearAlgebra::MiddleSizeVector::type createAndSolve(
+        const std::string fileName, const double T, const std::size_t nT) {
+        readMesh(fileName);
+        setInitialSolution(solutionVectorId_, 0, 0);
+        initialMass_ = computeMass();
+        solve(0, T, T / static_cast<double>(nT), 0, false);
+        return computeTotalError(solutionVectorId_, T);
+    }
+
+    /// Integral of the numerical solution over the domain.
+    double computeMass() {
+        return AdvectionTest::computeMass(elementIntegrator_, *meshes_[0],
+                                          solutionVectorId_);
+    }
+
+    /// Check that the left half of the domain is on the finest level.
+    void checkLocalTimeLevels() {
+        for (Base::Element *ptrElement : meshes_[0]->getElementsList()) {
+            const Geometry::PointReference<1> &center =
+                ptrElement->getReferenceGeometry()->getCenter();
+            const std::size_t expectedLevel =
+                ptrElement->referenceToPhysical(center)[0] < 0.5 ? 1 : 0;
+            logger.assert_always(
+                getLocalTimeLevel(ptrElement) == expectedLevel,
+                "Element % is on level % instead of %", ptrElement->getID(),
+                getLocalTimeLevel(ptrElement), expectedLevel);
+        }
+        // Recomputing the levels (as after mesh adaptation) reuses the extra
+        // time integration vectors
+        const Base::Element *ptrElement =
+            *meshes_[0]->getElementsList().begin();
+        const std::size_t numberOfVectors =
+            ptrElement->getNumberOfTimeIntegrationVectors();
+        computeLocalTimeLevels(1. / 256);
+        logger.assert_always(
+            ptrElement->getNumberOfTimeIntegrationVectors() == numberOfVectors,
+            "Recomputing the levels changed the number of vectors from % to %",
+            numberOfVectors, ptrElement->getNumberOfTimeIntegrationVectors());
+    }
+
+    double initialMass_ = 0;
+
+   private:
+    /// Advection velocity
+    LinearAlgebra::SmallVector<1> a;
+};
+
+int main(int argc, char **argv) {
+    using namespace std::string_literals;
+    Base::parse_options(argc, argv);
+
+    const std::string fileName = Base::getCMAKE_hpGEM_SOURCE_DIR() +
+                                 "/tests/files/advectionMesh1.hpgem"s;
+    const double T = 0.5;
+    const std::size_t nT = 256;
+
+    // Reference: all elements use the time step of the finest level.
+    Base::numberOfLocalTimeLevels.getValue() = 1;
+    LocalAdvection globalTest(2);
+    const LinearAlgebra::MiddleSizeVector::type globalError =
+        globalTest.createAndSolve(fileName, T, nT);
+    logger.assert_always(globalTest.getNumberOfLocalTimeLevels() == 0,
+                         "Local time levels were computed without request");
+
+    Base::numberOfLocalTimeLevels.getValue() = 3;
+    LocalAdvection localTest(2);
+    const LinearAlgebra::MiddleSizeVector::type localError =
+        localTest.createAndSolve(fileName, T, nT);
+    logger.assert_always(localTest.getNumberOfLocalTimeLevels() == 2,
+                         "Expected 2 local time levels, got %",
+                         localTest.getNumberOfLocalTimeLevels());
+    localTest.checkLocalTimeLevels();
+    logger.assert_always(std::abs(localTest.computeMass() -
+                                  localTest.initialMass_) < 1e-12,
+                         "Local time stepping changed the mass from % to %",
+                         localTest.initialMass_, localTest.computeMass());
+
+    std::cout << "Error with global time step: " << globalError << "\n";
+    std::cout << "Error with local time steps: " << localError << "\n";
+    logger.assert_always(
+        std::abs(localError - globalError) < 0.1 * std::abs(globalError),
+        "Local time stepping changed the error too much");
+    return 0;
+}
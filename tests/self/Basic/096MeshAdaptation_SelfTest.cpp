@@ -0,0 +1,172 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <functional>
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/HpgemAPISimplified.h"
+#include "Logger.h"
+
+#include "upwindAdvection.h"
+
+/// This class is used to test mesh adaptation in HpgemAPISimplified. It solves
+/// the 1D advection equation du/dt + a du/dx = 0 with an upwind flux on a
+/// periodic mesh, for a narrow pulse that is not resolved by the initial mesh.
+using namespace hpgem;
+class AdaptiveAdvection : public Base::HpgemAPISimplified<1> {
+   public:
+    explicit AdaptiveAdvection(const std::size_t p)
+        : Base::HpgemAPISimplified<1>(
+              1, p,
+              TimeIntegration::AllTimeIntegrators::Instance().getRule(3, 3,
+                                                                      true)),
+          a({0.5}) {}
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtElement(
+        Base::Element *ptrElement,
+        const LinearAlgebra::MiddleSizeVector &inputFunctionCoefficients,
+        const double /*time*/) final {
+        return AdvectionTest::integrateAdvectionAtElement(
+            elementIntegrator_, ptrElement, a, inputFunctionCoefficients);
+    }
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtFace(
+        Base::Face *ptrFace, const Base::Side iSide,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsLeft,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsRight,
+        const double /*time*/) final {
+        return AdvectionTest::integrateUpwindFluxAtFace(
+            faceIntegrator_, ptrFace, iSide, a, inputFunctionCoefficientsLeft,
+            inputFunctionCoefficientsRight);
+    }
+
+    LinearAlgebra::MiddleSizeVector getExactSolution(
+        const PointPhysicalT &point, const double &time,
+        const std::size_t /*orderTimeDerivative*/) final {
+        LinearAlgebra::MiddleSizeVector exactSolution(1);
+        exactSolution(0) = AdvectionTest::pulse(point[0], a[0], time);
+        return exactSolution;
+    }
+
+    LinearAlgebra::MiddleSizeVector getInitialSolution(
+        const PointPhysicalT &point, const double &startTime,
+        const std::size_t orderTimeDerivative) final {
+        return getExactSolution(point, startTime, orderTimeDerivative);
+    }
+
+    /// Integral of the numerical solution over the domain.
+    double computeMass() {
+        return AdvectionTest::computeMass(elementIntegrator_, *meshes_[0],
+                                          solutionVectorId_);
+    }
+
+    /// Record the mass before the first adaptation (the upwind scheme itself
+    /// conserves mass) and the largest size of the mesh.
+    void showProgress(const double /*time*/,
+                      const std::size_t timeStepID) final {
+        if (timeStepID == 1) {
+            initialMass_ = computeMass();
+        }
+        maximumNumberOfElements_ = std::max(
+            maximumNumberOfElements_, meshes_[0]->getNumberOfElements());
+    }
+
+    LinearAlgebra::MiddleSizeVector::type createAndSolve(
+        const std::string fileName, const std::string outputFileName,
+        const double T, const std::size_t nT) {
+        readMesh(fileName);
+        setOutputNames(outputFileName, "AdaptiveAdvection", "u", {"u"});
+        solve(0, T, T / static_cast<double>(nT), 0, false);
+        return computeTotalError(solutionVectorId_, T);
+    }
+
+    double initialMass_ = 0;
+    std::size_t maximumNumberOfElements_ = 0;
+
+   private:
+    /// Advection velocity
+    LinearAlgebra::SmallVector<1> a;
+};
+
+int main(int argc, char **argv) {
+    using namespace std::string_literals;
+    Base::parse_options(argc, argv);
+
+    const std::string fileName = Base::getCMAKE_hpGEM_SOURCE_DIR() +
+                                 "/tests/files/advectionMesh1.hpgem"s;
+    // Write the output next to the test executable (in the build directory)
+    // instead of the current working directory.
+    const std::string executable = argv[0];
+    const std::string outputDirectory =
+        executable.substr(0, executable.find_last_of('/') + 1);
+    const double T = 0.5;
+    const std::size_t nT = 400;
+
+    // Reference: the initial mesh is kept.
+    Base::numberOfStepsBetweenAdaptations.getValue() = 0;
+    AdaptiveAdvection uniformTest(2);
+    const LinearAlgebra::MiddleSizeVector::type uniformError =
+        uniformTest.createAndSolve(
+        fileName, outputDirectory + "096MeshAdaptationUniform", T, nT);
+
+    Base::numberOfStepsBetweenAdaptations.getValue() = 5;
+    Base::maximumRefinementLevel.getValue() = 2;
+    Base::adaptFraction.getValue() = 0.2;
+    AdaptiveAdvection adaptiveTest(2);
+    const LinearAlgebra::MiddleSizeVector::type adaptiveError =
+        adaptiveTest.createAndSolve(
+        fileName, outputDirectory + "096MeshAdaptation", T, nT);
+
+    std::cout << "Error on the initial mesh: " << uniformError << "\n";
+    std::cout << "Error on the adapted mesh: " << adaptiveError << "\n";
+    std::cout << "Maximum number of elements: "
+              << adaptiveTest.maximumNumberOfElements_ << "\n";
+    logger.assert_always(adaptiveTest.maximumNumberOfElements_ > 16,
+                         "The mesh was not refined");
+    logger.assert_always(std::abs(adaptiveTest.computeMass() -
+                                  adaptiveTest.initialMass_) < 1e-10,
+                         "Adaptation changed the mass from % to %",
+                         adaptiveTest.initialMass_, adaptiveTest.computeMass());
+    logger.assert_always(std::abs(adaptiveError) < std::abs(uniformError),
+                         "Adaptation did not reduce the error");
+    return 0;
+}
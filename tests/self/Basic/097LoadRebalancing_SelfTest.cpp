@@ -0,0 +1,243 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <functional>
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/HpgemAPISimplified.h"
+#include "Base/MpiContainer.h"
+#include "Logger.h"
+
+#include "upwindAdvection.h"
+
+/// This class is used to test load rebalancing in HpgemAPISimplified. It solves
+/// the 1D advection equation du/dt + a du/dx = 0 with an upwind flux on a
+/// periodic mesh, redistributing the mesh during the time integration. The
+/// elements on the left part of the domain are made artificially expensive, so
+/// the initial distribution is unbalanced. Alternatively every element can be
+/// moved to the next processor at every check, which also moves all elements on
+/// a single processor.
+using namespace hpgem;
+class RebalancedAdvection : public Base::HpgemAPISimplified<1> {
+   public:
+    RebalancedAdvection(const std::size_t p, bool rotateOwners)
+        : Base::HpgemAPISimplified<1>(
+              1, p,
+              TimeIntegration::AllTimeIntegrators::Instance().getRule(3, 3,
+                                                                      true)),
+          a({0.5}),
+          rotateOwners_(rotateOwners) {}
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtElement(
+        Base::Element *ptrElement,
+        const LinearAlgebra::MiddleSizeVector &inputFunctionCoefficients,
+        const double /*time*/) final {
+        return AdvectionTest::integrateAdvectionAtElement(
+            elementIntegrator_, ptrElement, a, inputFunctionCoefficients);
+    }
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtFace(
+        Base::Face *ptrFace, const Base::Side iSide,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsLeft,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsRight,
+        const double /*time*/) final {
+        return AdvectionTest::integrateUpwindFluxAtFace(
+            faceIntegrator_, ptrFace, iSide, a, inputFunctionCoefficientsLeft,
+            inputFunctionCoefficientsRight);
+    }
+
+    /// The mesh is periodic, so the only faces with one element are faces of
+    /// shadow elements whose neighbour is on another processor. The result on
+    /// shadow elements is overwritten when the processors synchronize.
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtFace(
+        Base::Face *ptrFace,
+        LinearAlgebra::MiddleSizeVector & /*inputFunctionCoefficients*/,
+        const double /*time*/) final {
+        return LinearAlgebra::MiddleSizeVector(
+            ptrFace->getPtrElementLeft()->getNumberOfBasisFunctions());
+    }
+
+    LinearAlgebra::MiddleSizeVector getExactSolution(
+        const PointPhysicalT &point, const double &time,
+        const std::size_t /*orderTimeDerivative*/) final {
+        LinearAlgebra::MiddleSizeVector exactSolution(1);
+        exactSolution(0) = AdvectionTest::pulse(point[0], a[0], time);
+        return exactSolution;
+    }
+
+    LinearAlgebra::MiddleSizeVector getInitialSolution(
+        const PointPhysicalT &point, const double &startTime,
+        const std::size_t orderTimeDerivative) final {
+        return getExactSolution(point, startTime, orderTimeDerivative);
+    }
+
+    /// The elements left of x = 0.25 are four times as expensive as the others
+    double computeElementCost(const Base::Element *ptrElement) final {
+        const PointReferenceT &centerReference =
+            ptrElement->getReferenceGeometry()->getCenter();
+        const PointPhysicalT center =
+            ptrElement->referenceToPhysical(centerReference);
+        return center[0] < 0.25 ? 4. : 1.;
+    }
+
+    /// Count the redistributions of the mesh, or move all elements to the next
+    /// processor.
+    bool rebalance() final {
+        bool hasRebalanced = false;
+        if (rotateOwners_) {
+            const std::size_t numberOfProcessors =
+                Base::MPIContainer::Instance().getNumberOfProcessors();
+            std::vector<std::size_t> newOwners;
+            for (Base::Element *ptrElement : meshes_[0]->getElementsList()) {
+                newOwners.push_back((ptrElement->getOwner() + 1) %
+                                    numberOfProcessors);
+            }
+            meshes_[0]->redistribute(newOwners);
+            hasRebalanced = true;
+        } else {
+            hasRebalanced = Base::HpgemAPISimplified<1>::rebalance();
+        }
+        if (hasRebalanced) {
+            ++numberOfRebalances_;
+        }
+        return hasRebalanced;
+    }
+
+    /// The largest load of a processor divided by the average load
+    double computeImbalance() {
+        const std::size_t numberOfProcessors =
+            Base::MPIContainer::Instance().getNumberOfProcessors();
+        double maximumLoad = 0;
+        for (Base::Element *ptrElement : meshes_[0]->getElementsList()) {
+            maximumLoad += computeElementCost(ptrElement);
+        }
+        double totalLoad = maximumLoad;
+#ifdef HPGEM_USE_MPI
+        auto &communicator = Base::MPIContainer::Instance();
+        communicator.reduce(maximumLoad, MPI_MAX);
+        communicator.broadcast(maximumLoad);
+        communicator.reduce(totalLoad, MPI_SUM);
+        communicator.broadcast(totalLoad);
+#endif
+        return maximumLoad * static_cast<double>(numberOfProcessors) /
+               totalLoad;
+    }
+
+    LinearAlgebra::MiddleSizeVector::type createAndSolve(
+        const std::string fileName, const double T, const std::size_t nT) {
+        readMesh(fileName);
+        initialImbalance_ = computeImbalance();
+        solve(0, T, T / static_cast<double>(nT), 0, false);
+        return computeTotalError(solutionVectorId_, T);
+    }
+
+    std::size_t numberOfRebalances_ = 0;
+    double initialImbalance_ = 1.;
+
+   private:
+    /// Advection velocity
+    LinearAlgebra::SmallVector<1> a;
+
+    bool rotateOwners_;
+};
+
+int main(int argc, char **argv) {
+    using namespace std::string_literals;
+    Base::parse_options(argc, argv);
+    const std::size_t numberOfProcessors =
+        Base::MPIContainer::Instance().getNumberOfProcessors();
+
+    const std::string fileName = Base::getCMAKE_hpGEM_SOURCE_DIR() +
+                                 "/tests/files/advectionMesh1.hpgem"s;
+    const double T = 0.5;
+    const std::size_t nT = 100;
+
+    Base::numberOfStepsBetweenRebalancing.getValue() = 0;
+    RebalancedAdvection referenceTest(2, false);
+    const LinearAlgebra::MiddleSizeVector::type referenceError =
+        referenceTest.createAndSolve(fileName, T, nT);
+    std::cout << "Error without rebalancing: " << referenceError << "\n";
+
+    // On more than one processor the expensive elements are spread out at the
+    // first check, after which the load is balanced well enough. On a single
+    // processor there is nothing to balance.
+    Base::numberOfStepsBetweenRebalancing.getValue() = 10;
+    Base::imbalanceTolerance.getValue() = 1.3;
+    RebalancedAdvection rebalancedTest(2, false);
+    const LinearAlgebra::MiddleSizeVector::type rebalancedError =
+        rebalancedTest.createAndSolve(fileName, T, nT);
+    const double finalImbalance = rebalancedTest.computeImbalance();
+    std::cout << "Error with rebalancing: " << rebalancedError << "\n";
+    std::cout << "Load imbalance from " << rebalancedTest.initialImbalance_
+              << " to " << finalImbalance << "\n";
+    const std::size_t expectedRebalances = numberOfProcessors > 1 ? 1 : 0;
+    logger.assert_always(
+        rebalancedTest.numberOfRebalances_ == expectedRebalances,
+        "Expected % redistributions, but got %", expectedRebalances,
+        rebalancedTest.numberOfRebalances_);
+    if (numberOfProcessors > 1) {
+        logger.assert_always(
+            rebalancedTest.initialImbalance_ > 1.3 && finalImbalance <= 1.3,
+            "Rebalancing should reduce the load imbalance below 1.3, but it "
+            "went from % to %",
+            rebalancedTest.initialImbalance_, finalImbalance);
+    }
+    logger.assert_always(
+        std::abs(rebalancedError - referenceError) < 1e-12,
+        "Rebalancing the mesh changed the error from % to %", referenceError,
+        rebalancedError);
+
+    // Moving every element, with its shadow elements, faces and data, should
+    // not change the solution either
+    RebalancedAdvection rotatedTest(2, true);
+    const LinearAlgebra::MiddleSizeVector::type rotatedError =
+        rotatedTest.createAndSolve(fileName, T, nT);
+    std::cout << "Error with moving elements: " << rotatedError << "\n";
+    logger.assert_always(rotatedTest.numberOfRebalances_ == nT / 10,
+                         "Expected % redistributions, but got %", nT / 10,
+                         rotatedTest.numberOfRebalances_);
+    logger.assert_always(
+        std::abs(rotatedError - referenceError) < 1e-12,
+        "Moving the elements changed the error from % to %", referenceError,
+        rotatedError);
+    return 0;
+}
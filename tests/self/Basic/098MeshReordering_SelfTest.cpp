@@ -0,0 +1,151 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/ConfigurationData.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/MeshManipulator.h"
+#include "Utilities/GlobalIndexing.h"
+#include "Logger.h"
+
+// Test of MeshManipulator::sortAlongSpaceFillingCurve. The mesh is first stored
+// in a random order, as for example meshes converted from Centaur are, and then
+// sorted. Since GlobalIndexing numbers the unknowns in the order of the element
+// list, the effect is measured as the distance between the global indices of
+// the two elements adjacent to an internal face, i.e. the distance of the
+// coupling block of that face from the diagonal of the global matrix.
+using namespace hpgem;
+
+/// Deterministic pseudo random key, to shuffle the mesh
+std::uint64_t shuffleKey(std::size_t id) {
+    return (static_cast<std::uint64_t>(id) * 2654435761u) % 4294967296u;
+}
+
+template <typename T>
+std::uint64_t shuffleKeyOf(const T* entity) {
+    return shuffleKey(entity->getID());
+}
+
+/// Average and maximum distance from the diagonal of the face coupling blocks
+std::pair<double, int> couplingDistance(Base::MeshManipulator<3>& mesh) {
+    Utilities::GlobalIndexing indexing(&mesh);
+    double totalDistance = 0;
+    int maximumDistance = 0;
+    std::size_t numberOfInternalFaces = 0;
+    for (Base::Face* face : mesh.getFacesList()) {
+        if (!face->isInternal()) {
+            continue;
+        }
+        int distance =
+            std::abs(indexing.getGlobalIndex(face->getPtrElementLeft(), 0) -
+                     indexing.getGlobalIndex(face->getPtrElementRight(), 0));
+        totalDistance += distance;
+        maximumDistance = std::max(maximumDistance, distance);
+        ++numberOfInternalFaces;
+    }
+    return {totalDistance / static_cast<double>(numberOfInternalFaces),
+            maximumDistance};
+}
+
+int main(int argc, char** argv) {
+    using namespace std::string_literals;
+    Base::parse_options(argc, argv);
+
+    Base::ConfigurationData config(1);
+    Base::MeshManipulator<3> mesh(&config);
+    mesh.readMesh(Base::getCMAKE_hpGEM_SOURCE_DIR() +
+                  "/tests/files/poissonMesh15.hpgem"s);
+    mesh.useDefaultDGBasisFunctions(2);
+    const std::size_t numberOfElements = mesh.getNumberOfElements();
+    const std::size_t numberOfFaces = mesh.getNumberOfFaces();
+    const std::size_t numberOfEdges = mesh.getNumberOfEdges();
+    const std::size_t numberOfNodes = mesh.getNumberOfNodes();
+    std::vector<std::size_t> elementIDs;
+    for (Base::Element* element : mesh.getElementsList()) {
+        elementIDs.push_back(element->getID());
+    }
+
+    const std::pair<double, int> fileOrder = couplingDistance(mesh);
+
+    Base::Mesh<3>& theMesh = mesh.getMesh();
+    for (auto part : {Base::IteratorType::LOCAL, Base::IteratorType::GLOBAL}) {
+        theMesh.getElementsList(part).sortRootEntries(
+            shuffleKeyOf<Base::Element>);
+        theMesh.getFacesList(part).sortRootEntries(shuffleKeyOf<Base::Face>);
+        theMesh.getEdgesList(part).sortRootEntries(shuffleKeyOf<Base::Edge>);
+    }
+    const std::pair<double, int> shuffled = couplingDistance(mesh);
+
+    mesh.sortAlongSpaceFillingCurve();
+    const std::pair<double, int> sorted = couplingDistance(mesh);
+
+    std::cout << "Distance of the face blocks from the diagonal (average, "
+                 "maximum): "
+              << fileOrder.first << ", " << fileOrder.second << " (file), "
+              << shuffled.first << ", " << shuffled.second << " (shuffled), "
+              << sorted.first << ", " << sorted.second << " (sorted)\n";
+
+    logger.assert_always(mesh.getNumberOfElements() == numberOfElements &&
+                             mesh.getNumberOfFaces() == numberOfFaces &&
+                             mesh.getNumberOfEdges() == numberOfEdges &&
+                             mesh.getNumberOfNodes() == numberOfNodes,
+                         "Sorting changed the size of the mesh");
+    std::size_t position = 0;
+    std::vector<std::size_t> sortedIDs;
+    for (Base::Element* element : mesh.getElementsList()) {
+        logger.assert_always(
+            element->getPositionInTree()->getSiblingIndex() == position++,
+            "Inconsistent position of element %", element->getID());
+        sortedIDs.push_back(element->getID());
+    }
+    std::sort(elementIDs.begin(), elementIDs.end());
+    std::sort(sortedIDs.begin(), sortedIDs.end());
+    logger.assert_always(elementIDs == sortedIDs,
+                         "Sorting changed the element IDs");
+    logger.assert_always(sorted.first < shuffled.first / 10,
+                         "Sorting did not reduce the average distance enough");
+    logger.assert_always(sorted.second < shuffled.second,
+                         "Sorting did not reduce the bandwidth");
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/ConfigurationData.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/GlobalUniqueIndex.h"
+#include "Base/MeshManipulator.h"
+#include "Base/MpiContainer.h"
+#include "Logger.h"
+#include "compareMeshes.h"
+
+// Test of MeshManipulator::createStructuredMesh. The generated meshes should be
+// the same as the meshes the preprocessor makes from the same description:
+// same elements in the same order with the same nodes, and the same faces and
+// edges. On several processors, the generated mesh should be the same as the
+// file read with the same partitioning, with the same shadow elements.
+using namespace hpgem;
+
+template <std::size_t DIM>
+void testStructuredMesh(const std::string& name,
+                        const std::array<std::size_t, DIM>& numberOfElements,
+                        bool triangular,
+                        const std::array<bool, DIM>& periodic) {
+    Base::ConfigurationData config(1);
+    Base::GlobalUniqueIndex& indices = Base::GlobalUniqueIndex::instance();
+    Base::MeshManipulator<DIM> generated(&config);
+    Geometry::PointPhysical<DIM> bottomLeft, topRight;
+    for (std::size_t i = 0; i < DIM; ++i) {
+        topRight[i] = 1.;
+    }
+    const std::size_t firstFaceID = indices.peekFaceIndex();
+    const std::size_t firstEdgeID = indices.peekEdgeIndex();
+    generated.createStructuredMesh(bottomLeft, topRight, numberOfElements,
+                                   triangular, periodic);
+    const std::size_t numberOfFaceIDs = indices.peekFaceIndex() - firstFaceID;
+    const std::size_t numberOfEdgeIDs = indices.peekEdgeIndex() - firstEdgeID;
+    for (const Base::Face* face :
+         generated.getFacesList(Base::IteratorType::GLOBAL)) {
+        logger.assert_always(
+            firstFaceID <= face->getID() &&
+                face->getID() < firstFaceID + numberOfFaceIDs,
+            "Face % of the generated mesh % has a reserved id", face->getID(),
+            name);
+    }
+
+    // the generated mesh is distributed over the processors as blocks, read
+    // the file with the same distribution
+    std::vector<std::size_t> partitions(generated.getNumberOfElementsInFile(),
+                                        0);
+    for (const Base::Element* element : generated.getElementsList()) {
+        partitions[generated.getElementIndexInFile(element)] =
+            static_cast<std::size_t>(
+                Base::MPIContainer::Instance().getProcessorID());
+    }
+#ifdef HPGEM_USE_MPI
+    Base::MPIContainer::Instance().reduce(partitions, MPI_SUM);
+    Base::MPIContainer::Instance().broadcast(partitions);
+#endif
+    Base::MeshManipulator<DIM> read(&config);
+    const std::size_t firstReadFaceID = indices.peekFaceIndex();
+    const std::size_t firstReadEdgeID = indices.peekEdgeIndex();
+    read.readMesh(Base::getCMAKE_hpGEM_SOURCE_DIR() + "/tests/files/" + name,
+                  partitions);
+    MeshTest::compareMeshes(generated, read, name);
+
+    // the faces and edges are numbered densely, like in the file
+    const std::size_t numberOfReadFaceIDs =
+        indices.peekFaceIndex() - firstReadFaceID;
+    const std::size_t numberOfReadEdgeIDs =
+        indices.peekEdgeIndex() - firstReadEdgeID;
+    logger.assert_always(DIM == 1 || numberOfFaceIDs == numberOfReadFaceIDs,
+                         "The generated mesh % uses % face ids instead of %",
+                         name, numberOfFaceIDs, numberOfReadFaceIDs);
+    logger.assert_always(DIM < 3 || numberOfEdgeIDs == numberOfReadEdgeIDs,
+                         "The generated mesh % uses % edge ids instead of %",
+                         name, numberOfEdgeIDs, numberOfReadEdgeIDs);
+}
+
+int main(int argc, char** argv) {
+    Base::parse_options(argc, argv);
+
+    testStructuredMesh<1>("1Drectangular2mesh.hpgem", {3}, false, {false});
+    testStructuredMesh<1>("advectionMesh5.hpgem", {4}, false, {true});
+    testStructuredMesh<2>("2Drectangular1mesh.hpgem", {2, 3}, false,
+                          {false, false});
+    testStructuredMesh<2>("2Dtriangular2mesh.hpgem", {3, 2}, true,
+                          {false, false});
+    testStructuredMesh<2>("advectionMesh8.hpgem", {4, 4}, true, {true, true});
+    testStructuredMesh<3>("3Drectangular2mesh.hpgem", {2, 3, 2}, false,
+                          {false, false, false});
+    testStructuredMesh<3>("3Dtriangular1mesh.hpgem", {2, 2, 3}, true,
+                          {false, false, false});
+    testStructuredMesh<3>("advectionMesh13.hpgem", {4, 4, 4}, false,
+                          {true, true, true});
+    testStructuredMesh<3>("advectionMesh14.hpgem", {4, 4, 4}, true,
+                          {true, true, true});
+    return 0;
+}
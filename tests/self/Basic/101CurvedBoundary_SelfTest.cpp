@@ -0,0 +1,132 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cmath>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/ConfigurationData.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/MeshManipulator.h"
+#include "Geometry/Mappings/MappingToPhysLagrange.h"
+#include "Integration/QuadratureRules/GaussQuadratureRule.h"
+#include "Logger.h"
+
+// Test of MeshManipulator::curveBoundaryElements. The bottom of the unit square
+// or cube is bent to the curve x_DIM = -0.1 sin(pi x_1), which adds 0.2 / pi to
+// the volume. The volume of the curved mesh should converge to this with the
+// order of the geometry, and only the elements at the bottom should be curved.
+using namespace hpgem;
+
+template <std::size_t DIM>
+void testCurvedBoundary(const std::array<std::size_t, DIM>& numberOfElements,
+                        bool triangular) {
+    Geometry::PointPhysical<DIM> bottomLeft, topRight;
+    for (std::size_t i = 0; i < DIM; ++i) {
+        topRight[i] = 1.;
+    }
+    auto projectToBottom = [](const Geometry::PointPhysical<DIM>& point) {
+        Geometry::PointPhysical<DIM> result = point;
+        if (std::abs(point[DIM - 1]) < 1e-12) {
+            result[DIM - 1] = -0.1 * std::sin(M_PI * point[0]);
+        }
+        return result;
+    };
+    // faces at the bottom have all their vertices at x_DIM = 0
+    auto isBottom = [](const Base::Face* face) {
+        const Geometry::PointReference<DIM - 1>& centerReference =
+            face->getReferenceGeometry()->getCenter();
+        const Geometry::PointPhysical<DIM> center =
+            face->referenceToPhysical(centerReference);
+        return std::abs(center[DIM - 1]) < 1e-12;
+    };
+    const double expectedVolume = 1. + 0.2 / M_PI;
+    double previousError = 1.;
+    for (std::size_t order = 1; order < 6; ++order) {
+        Base::ConfigurationData config(1);
+        Base::MeshManipulator<DIM> mesh(&config);
+        mesh.createStructuredMesh(bottomLeft, topRight, numberOfElements,
+                                  triangular);
+        mesh.curveBoundaryElements(order, projectToBottom, isBottom);
+        double volume = 0.;
+        std::size_t numberOfCurvedElements = 0;
+        for (Base::Element* element : mesh.getElementsList()) {
+            if (dynamic_cast<const Geometry::MappingToPhysLagrange<DIM>*>(
+                    element->getReferenceToPhysicalMap()) != nullptr) {
+                ++numberOfCurvedElements;
+            } else {
+                for (std::size_t i = 0; i < element->getNumberOfNodes(); ++i) {
+                    const Geometry::PointPhysical<DIM>& node =
+                        element->getPhysicalGeometry()->getLocalNodeCoordinates(
+                            i);
+                    logger.assert_always(std::abs(node[DIM - 1]) > 1e-12,
+                                         "An element at the bottom is not "
+                                         "curved");
+                }
+            }
+            QuadratureRules::GaussQuadratureRule* rule =
+                element->getReferenceGeometry()->getGaussQuadratureRule(11);
+            for (std::size_t i = 0; i < rule->getNumberOfPoints(); ++i) {
+                const Geometry::PointReference<DIM>& point = rule->getPoint(i);
+                volume += rule->weight(i) *
+                          std::abs(element->calcJacobian(point).determinant());
+            }
+        }
+        logger.assert_always(numberOfCurvedElements > 0,
+                             "No elements were curved");
+        const double error = std::abs(volume - expectedVolume);
+        logger(VERBOSE, "Volume with geometry order %: % (error %)", order,
+               volume, error);
+        logger.assert_always(order == 1 || error < previousError,
+                             "The volume does not converge (% after %)", error,
+                             previousError);
+        previousError = error;
+    }
+    logger.assert_always(previousError < 1e-6,
+                         "The volume of the curved mesh is % off",
+                         previousError);
+}
+
+int main(int argc, char** argv) {
+    Base::parse_options(argc, argv);
+
+    testCurvedBoundary<2>({4, 3}, false);
+    testCurvedBoundary<2>({4, 3}, true);
+    testCurvedBoundary<3>({4, 2, 2}, false);
+    testCurvedBoundary<3>({4, 2, 2}, true);
+    return 0;
+}
@@ -0,0 +1,305 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <vector>
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/HpgemAPILinear.h"
+#include "Base/HpgemAPISimplified.h"
+#include "Utilities/GlobalIndexing.h"
+#include "Utilities/SparsityEstimator.h"
+#include "Logger.h"
+
+#include "upwindAdvection.h"
+
+/// This class is used to test p-adaptation in HpgemAPISimplified. It solves
+/// the 1D advection equation du/dt + a du/dx = 0 with an upwind flux on a
+/// periodic mesh, for a narrow pulse that is not resolved by the initial
+/// polynomial order. The upwind flux couples elements of different orders.
+using namespace hpgem;
+class PAdaptiveAdvection : public Base::HpgemAPISimplified<1> {
+   public:
+    explicit PAdaptiveAdvection(const std::size_t p)
+        : Base::HpgemAPISimplified<1>(
+              1, p,
+              TimeIntegration::AllTimeIntegrators::Instance().getRule(3, 3,
+                                                                      true)),
+          a({0.5}) {}
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtElement(
+        Base::Element *ptrElement,
+        const LinearAlgebra::MiddleSizeVector &inputFunctionCoefficients,
+        const double /*time*/) final {
+        return AdvectionTest::integrateAdvectionAtElement(
+            elementIntegrator_, ptrElement, a, inputFunctionCoefficients);
+    }
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtFace(
+        Base::Face *ptrFace, const Base::Side iSide,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsLeft,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsRight,
+        const double /*time*/) final {
+        return AdvectionTest::integrateUpwindFluxAtFace(
+            faceIntegrator_, ptrFace, iSide, a, inputFunctionCoefficientsLeft,
+            inputFunctionCoefficientsRight);
+    }
+
+    LinearAlgebra::MiddleSizeVector getExactSolution(
+        const PointPhysicalT &point, const double &time,
+        const std::size_t /*orderTimeDerivative*/) final {
+        LinearAlgebra::MiddleSizeVector exactSolution(1);
+        exactSolution(0) = AdvectionTest::pulse(point[0], a[0], time);
+        return exactSolution;
+    }
+
+    LinearAlgebra::MiddleSizeVector getInitialSolution(
+        const PointPhysicalT &point, const double &startTime,
+        const std::size_t orderTimeDerivative) final {
+        return getExactSolution(point, startTime, orderTimeDerivative);
+    }
+
+    /// Integral of the numerical solution over the domain.
+    double computeMass() {
+        return AdvectionTest::computeMass(elementIntegrator_, *meshes_[0],
+                                          solutionVectorId_);
+    }
+
+    /// Record the mass before the first adaptation (the upwind scheme itself
+    /// conserves mass) and the orders that have been used.
+    void showProgress(const double /*time*/,
+                      const std::size_t timeStepID) final {
+        if (timeStepID == 1) {
+            initialMass_ = computeMass();
+        }
+        for (Base::Element *ptrElement : meshes_[0]->getElementsList()) {
+            minimumOrder_ =
+                std::min(minimumOrder_, ptrElement->getPolynomialOrder());
+            maximumOrder_ =
+                std::max(maximumOrder_, ptrElement->getPolynomialOrder());
+        }
+    }
+
+    LinearAlgebra::MiddleSizeVector::type createAndSolve(
+        const std::string fileName, const double T, const std::size_t nT) {
+        readMesh(fileName);
+        solve(0, T, T / static_cast<double>(nT), 0, false);
+        return computeTotalError(solutionVectorId_, T);
+    }
+
+    /// Check that the global indices and the sparsity estimate account for the
+    /// number of basis functions of each element.
+    void checkGlobalIndexing() {
+        Utilities::GlobalIndexing indexing(meshes_[0]);
+        std::size_t numberOfBasisFunctions = 0;
+        for (Base::Element *ptrElement : meshes_[0]->getElementsList()) {
+            numberOfBasisFunctions += ptrElement->getNumberOfBasisFunctions();
+        }
+        logger.assert_always(
+            indexing.getNumberOfLocalBasisFunctions() == numberOfBasisFunctions,
+            "The indexing has % basis functions instead of %",
+            indexing.getNumberOfLocalBasisFunctions(), numberOfBasisFunctions);
+
+        Utilities::SparsityEstimator estimator(indexing);
+        std::vector<int> nonZeroPerRowOwned, nonZeroPerRowNonOwned;
+        estimator.computeSparsityEstimate(nonZeroPerRowOwned,
+                                          nonZeroPerRowNonOwned, true);
+        for (Base::Element *ptrElement : meshes_[0]->getElementsList()) {
+            std::size_t expectedNonZeros =
+                ptrElement->getNumberOfBasisFunctions();
+            for (const Base::Face *ptrFace : ptrElement->getFacesList()) {
+                if (!ptrFace->isInternal()) {
+                    continue;
+                }
+                const Base::Element *ptrNeighbour =
+                    ptrFace->getPtrElementLeft() == ptrElement
+                        ? ptrFace->getPtrElementRight()
+                        : ptrFace->getPtrElementLeft();
+                expectedNonZeros += ptrNeighbour->getNumberOfBasisFunctions();
+            }
+            const int offset = indexing.getProcessorLocalIndex(ptrElement, 0);
+            for (std::size_t i = 0; i < ptrElement->getNumberOfBasisFunctions();
+                 ++i) {
+                logger.assert_always(
+                    nonZeroPerRowOwned[offset + i] ==
+                        static_cast<int>(expectedNonZeros),
+                    "Row % of element % has % non zeros instead of %", i,
+                    ptrElement->getID(), nonZeroPerRowOwned[offset + i],
+                    expectedNonZeros);
+            }
+        }
+    }
+
+    double initialMass_ = 0;
+    std::size_t minimumOrder_ = std::numeric_limits<std::size_t>::max();
+    std::size_t maximumOrder_ = 0;
+
+   private:
+    /// Advection velocity
+    LinearAlgebra::SmallVector<1> a;
+};
+
+/// The same problem with HpgemAPILinear, which stores the mass and stiffness
+/// matrices and has to compute them again after every adaptation.
+class LinearPAdaptiveAdvection : public Base::HpgemAPILinear<1> {
+   public:
+    explicit LinearPAdaptiveAdvection(const std::size_t p)
+        : Base::HpgemAPILinear<1>(
+              1, p,
+              TimeIntegration::AllTimeIntegrators::Instance().getRule(3, 3,
+                                                                      true)),
+          a({0.5}) {}
+
+    LinearAlgebra::MiddleSizeMatrix computeIntegrandStiffnessMatrixAtElement(
+        Base::PhysicalElement<1> &element) final {
+        const std::size_t numberOfBasisFunctions =
+            element.getNumberOfBasisFunctions();
+        LinearAlgebra::MiddleSizeMatrix &result = element.getResultMatrix();
+        for (std::size_t i = 0; i < numberOfBasisFunctions; ++i) {
+            for (std::size_t j = 0; j < numberOfBasisFunctions; ++j) {
+                result(j, i) = element.basisFunction(i) *
+                               (a * element.basisFunctionDeriv(j));
+            }
+        }
+        return result;
+    }
+
+    Base::FaceMatrix computeIntegrandStiffnessMatrixAtFace(
+        Base::PhysicalFace<1> &face) final {
+        const std::size_t numberOfBasisFunctions =
+            face.getFace()->getNumberOfBasisFunctions();
+        Base::FaceMatrix &result = face.getResultMatrix();
+        result *= 0;
+        const Base::Side upwindSide = a * face.getUnitNormalVector() > 0
+                                          ? Base::Side::LEFT
+                                          : Base::Side::RIGHT;
+        for (std::size_t i = 0; i < numberOfBasisFunctions; ++i) {
+            if (face.getFace()->getSide(i) != upwindSide) {
+                continue;
+            }
+            for (std::size_t j = 0; j < numberOfBasisFunctions; ++j) {
+                result(j, i) = -(a * face.basisFunctionUnitNormal(j)) *
+                               face.basisFunction(i);
+            }
+        }
+        return result;
+    }
+
+    LinearAlgebra::MiddleSizeVector getExactSolution(
+        const PointPhysicalT &point, const double &time,
+        const std::size_t /*orderTimeDerivative*/) final {
+        LinearAlgebra::MiddleSizeVector exactSolution(1);
+        exactSolution(0) = AdvectionTest::pulse(point[0], a[0], time);
+        return exactSolution;
+    }
+
+    LinearAlgebra::MiddleSizeVector getInitialSolution(
+        const PointPhysicalT &point, const double &startTime,
+        const std::size_t orderTimeDerivative) final {
+        return getExactSolution(point, startTime, orderTimeDerivative);
+    }
+
+    LinearAlgebra::MiddleSizeVector::type createAndSolve(
+        const std::string fileName, const double T, const std::size_t nT) {
+        readMesh(fileName);
+        solve(0, T, T / static_cast<double>(nT), 0, false);
+        return computeTotalError(solutionVectorId_, T);
+    }
+
+   private:
+    /// Advection velocity
+    LinearAlgebra::SmallVector<1> a;
+};
+
+int main(int argc, char **argv) {
+    using namespace std::string_literals;
+    Base::parse_options(argc, argv);
+
+    const std::string fileName = Base::getCMAKE_hpGEM_SOURCE_DIR() +
+                                 "/tests/files/advectionMesh1.hpgem"s;
+    const double T = 0.5;
+    const std::size_t nT = 400;
+
+    // Reference: every element keeps the initial order.
+    Base::numberOfStepsBetweenPAdaptations.getValue() = 0;
+    PAdaptiveAdvection uniformTest(2);
+    const LinearAlgebra::MiddleSizeVector::type uniformError =
+        uniformTest.createAndSolve(fileName, T, nT);
+
+    Base::numberOfStepsBetweenPAdaptations.getValue() = 5;
+    Base::minimumPolynomialOrder.getValue() = 1;
+    Base::maximumPolynomialOrder.getValue() = 5;
+    Base::adaptFraction.getValue() = 0.2;
+    PAdaptiveAdvection adaptiveTest(2);
+    const LinearAlgebra::MiddleSizeVector::type adaptiveError =
+        adaptiveTest.createAndSolve(fileName, T, nT);
+
+    std::cout << "Error with uniform order: " << uniformError << "\n";
+    std::cout << "Error with adapted orders: " << adaptiveError << "\n";
+    std::cout << "Orders used: " << adaptiveTest.minimumOrder_ << " to "
+              << adaptiveTest.maximumOrder_ << "\n";
+    logger.assert_always(adaptiveTest.minimumOrder_ == 1,
+                         "The order was not lowered");
+    logger.assert_always(adaptiveTest.maximumOrder_ == 5,
+                         "The order was not raised");
+    logger.assert_always(std::abs(adaptiveTest.computeMass() -
+                                  adaptiveTest.initialMass_) < 1e-10,
+                         "Adaptation changed the mass from % to %",
+                         adaptiveTest.initialMass_, adaptiveTest.computeMass());
+    logger.assert_always(std::abs(adaptiveError) < std::abs(uniformError),
+                         "Adaptation did not reduce the error");
+    adaptiveTest.checkGlobalIndexing();
+
+    // The stored matrices must follow the new orders, otherwise the solution
+    // is multiplied with matrices of the wrong size.
+    LinearPAdaptiveAdvection linearTest(2);
+    const LinearAlgebra::MiddleSizeVector::type linearError =
+        linearTest.createAndSolve(fileName, T, nT);
+    std::cout << "Error with adapted orders and stored matrices: "
+              << linearError << "\n";
+    logger.assert_always(std::abs(linearError - adaptiveError) < 1e-8,
+                         "Stored matrices give the error % instead of %",
+                         linearError, adaptiveError);
+    return 0;
+}
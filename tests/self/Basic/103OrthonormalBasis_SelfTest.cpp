@@ -0,0 +1,184 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <functional>
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/HpgemAPISimplified.h"
+#include "Logger.h"
+
+#include "upwindAdvection.h"
+
+/// This class is used to test the orthonormal basis functions in
+/// HpgemAPISimplified. It solves the linear advection equation du/dt + a.grad u
+/// = 0 with an upwind flux on a periodic mesh, once with the default basis
+/// functions and once with the orthonormal ones. Both span the same space, so
+/// the errors should be the same, but with orthonormal basis functions on the
+/// affine elements of these meshes each mass matrix should only be computed
+/// once, to check that it is the scaled identity matrix.
+using namespace hpgem;
+template <std::size_t DIM>
+class Advection : public Base::HpgemAPISimplified<DIM> {
+   public:
+    using typename Base::HpgemAPIBase<DIM>::PointPhysicalT;
+
+    Advection(const std::string fileName, const std::size_t p)
+        : Base::HpgemAPISimplified<DIM>(1, p), fileName_(fileName) {
+        for (std::size_t i = 0; i < DIM; ++i) {
+            a_[i] = 0.1 + 0.1 * static_cast<double>(i);
+        }
+    }
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtElement(
+        Base::Element *ptrElement,
+        const LinearAlgebra::MiddleSizeVector &inputFunctionCoefficients,
+        const double /*time*/) final {
+        return AdvectionTest::integrateAdvectionAtElement(
+            this->elementIntegrator_, ptrElement, a_,
+            inputFunctionCoefficients);
+    }
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtFace(
+        Base::Face *ptrFace, const Base::Side iSide,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsLeft,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsRight,
+        const double /*time*/) final {
+        return AdvectionTest::integrateUpwindFluxAtFace(
+            this->faceIntegrator_, ptrFace, iSide, a_,
+            inputFunctionCoefficientsLeft, inputFunctionCoefficientsRight);
+    }
+
+    LinearAlgebra::MiddleSizeVector getExactSolution(
+        const PointPhysicalT &point, const double &time,
+        const std::size_t /*orderTimeDerivative*/) final {
+        LinearAlgebra::MiddleSizeVector exactSolution(1);
+        exactSolution(0) = 1.;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            exactSolution(0) *= std::sin(2 * M_PI * (point[i] - a_[i] * time));
+        }
+        return exactSolution;
+    }
+
+    LinearAlgebra::MiddleSizeVector getInitialSolution(
+        const PointPhysicalT &point, const double &startTime,
+        const std::size_t orderTimeDerivative) final {
+        return getExactSolution(point, startTime, orderTimeDerivative);
+    }
+
+    /// Count the mass matrices, to check that they are skipped
+    LinearAlgebra::MiddleSizeMatrix computeMassMatrixAtElement(
+        Base::Element *ptrElement) final {
+        ++numberOfMassMatrices_;
+        return Base::HpgemAPISimplified<DIM>::computeMassMatrixAtElement(
+            ptrElement);
+    }
+
+    LinearAlgebra::MiddleSizeVector::type createAndSolve(const double T,
+                                                         const std::size_t nT) {
+        this->readMesh(fileName_);
+        numberOfElements_ = this->meshes_[0]->getNumberOfElements();
+        this->solve(0, T, T / static_cast<double>(nT), 0, false);
+        return this->computeTotalError(this->solutionVectorId_, T);
+    }
+
+    std::size_t numberOfMassMatrices_ = 0;
+    std::size_t numberOfElements_ = 0;
+
+   private:
+    std::string fileName_;
+
+    /// Advection velocity
+    LinearAlgebra::SmallVector<DIM> a_;
+};
+
+template <std::size_t DIM>
+void compareBasisFunctions(const std::string fileName, const std::size_t p,
+                           const double T, const std::size_t nT) {
+    Base::orthonormalBasis.getValue() = false;
+    Advection<DIM> defaultTest(fileName, p);
+    const LinearAlgebra::MiddleSizeVector::type defaultError =
+        defaultTest.createAndSolve(T, nT);
+
+    Base::orthonormalBasis.getValue() = true;
+    Advection<DIM> orthonormalTest(fileName, p);
+    const LinearAlgebra::MiddleSizeVector::type orthonormalError =
+        orthonormalTest.createAndSolve(T, nT);
+
+    std::cout << fileName << ": error " << defaultError << " with "
+              << defaultTest.numberOfMassMatrices_
+              << " mass matrices, error " << orthonormalError << " with "
+              << orthonormalTest.numberOfMassMatrices_
+              << " mass matrices\n";
+    logger.assert_always(std::abs(defaultError - orthonormalError) <
+                             1e-10 * std::abs(defaultError),
+                         "The orthonormal basis functions give error % "
+                         "instead of %",
+                         orthonormalError, defaultError);
+    logger.assert_always(defaultTest.numberOfMassMatrices_ >
+                             orthonormalTest.numberOfMassMatrices_,
+                         "The default basis functions need more mass matrices");
+    logger.assert_always(orthonormalTest.numberOfMassMatrices_ ==
+                             orthonormalTest.numberOfElements_,
+                         "% mass matrices were computed for orthonormal basis "
+                         "functions on % elements",
+                         orthonormalTest.numberOfMassMatrices_,
+                         orthonormalTest.numberOfElements_);
+}
+
+int main(int argc, char **argv) {
+    using namespace std::string_literals;
+    Base::parse_options(argc, argv);
+
+    const std::string directory =
+        Base::getCMAKE_hpGEM_SOURCE_DIR() + "/tests/files/"s;
+    // lines
+    compareBasisFunctions<1>(directory + "advectionMesh2.hpgem"s, 3, 0.1, 10);
+    // triangles
+    compareBasisFunctions<2>(directory + "advectionMesh8.hpgem"s, 2, 0.1, 5);
+    // squares
+    compareBasisFunctions<2>(directory + "advectionMesh9.hpgem"s, 3, 0.1, 5);
+    // cubes
+    compareBasisFunctions<3>(directory + "advectionMesh13.hpgem"s, 2, 0.1, 2);
+    // tetrahedra
+    compareBasisFunctions<3>(directory + "advectionMesh14.hpgem"s, 2, 0.1, 2);
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/ConfigurationData.h"
+#include "Base/Element.h"
+#include "Base/MeshManipulator.h"
+#include "Base/MpiContainer.h"
+#include "LinearAlgebra/MiddleSizeMatrix.h"
+#include "LinearAlgebra/MiddleSizeVector.h"
+#include "Logger.h"
+#include "compareMeshes.h"
+
+// Test of MeshManipulator::redistribute. The elements of a mesh are moved to
+// the next processor and back again. After the first move each processor
+// should own the right elements, and the element data should have moved with
+// them. After moving back, the mesh should be the same as the mesh that was
+// read from the file.
+using namespace hpgem;
+
+template <std::size_t DIM>
+void setData(Base::MeshManipulator<DIM>& mesh) {
+    for (Base::Element* element :
+         mesh.getElementsList(Base::IteratorType::GLOBAL)) {
+        double index = static_cast<double>(mesh.getElementIndexInFile(element));
+        std::size_t numberOfBasisFunctions =
+            element->getNumberOfBasisFunctions();
+        LinearAlgebra::MiddleSizeVector vector(numberOfBasisFunctions);
+        LinearAlgebra::MiddleSizeMatrix matrix(numberOfBasisFunctions,
+                                               numberOfBasisFunctions);
+        for (std::size_t i = 0; i < numberOfBasisFunctions; ++i) {
+            vector[i] = index + static_cast<double>(i);
+            for (std::size_t j = 0; j < numberOfBasisFunctions; ++j) {
+                matrix(i, j) = index * static_cast<double>(i + j);
+            }
+        }
+        element->setNumberOfTimeIntegrationVectors(1);
+        element->setTimeIntegrationVector(0, vector);
+        element->setElementMatrix(matrix, 0);
+    }
+}
+
+template <std::size_t DIM>
+void checkData(Base::MeshManipulator<DIM>& mesh, const std::string& name) {
+    for (Base::Element* element :
+         mesh.getElementsList(Base::IteratorType::GLOBAL)) {
+        double index = static_cast<double>(mesh.getElementIndexInFile(element));
+        std::size_t numberOfBasisFunctions =
+            element->getNumberOfBasisFunctions();
+        const LinearAlgebra::MiddleSizeVector& vector =
+            element->getTimeIntegrationVector(0);
+        const LinearAlgebra::MiddleSizeMatrix& matrix =
+            element->getElementMatrix(0);
+        logger.assert_always(
+            vector.size() == numberOfBasisFunctions &&
+                matrix.getNumberOfRows() == numberOfBasisFunctions &&
+                matrix.getNumberOfColumns() == numberOfBasisFunctions,
+            "The data of element % of mesh % has the wrong size", index, name);
+        for (std::size_t i = 0; i < numberOfBasisFunctions; ++i) {
+            logger.assert_always(vector[i] == index + static_cast<double>(i),
+                                 "The vector of element % of mesh % did not "
+                                 "move with it",
+                                 index, name);
+            for (std::size_t j = 0; j < numberOfBasisFunctions; ++j) {
+                logger.assert_always(
+                    matrix(i, j) == index * static_cast<double>(i + j),
+                    "The matrix of element % of mesh % did not move with it",
+                    index, name);
+            }
+        }
+    }
+}
+
+template <std::size_t DIM>
+void testRedistribution(const std::string& name) {
+    std::string fileName =
+        Base::getCMAKE_hpGEM_SOURCE_DIR() + "/tests/files/" + name;
+    std::size_t numberOfProcessors = static_cast<std::size_t>(
+        Base::MPIContainer::Instance().getNumberOfProcessors());
+    std::size_t processorID = static_cast<std::size_t>(
+        Base::MPIContainer::Instance().getProcessorID());
+    Base::ConfigurationData config(1);
+
+    Base::MeshManipulator<DIM> file(&config);
+    file.readMesh(fileName);
+    std::vector<std::size_t> partitions(file.getNumberOfElementsInFile());
+    for (std::size_t i = 0; i < partitions.size(); ++i) {
+        partitions[i] = i % numberOfProcessors;
+    }
+
+    Base::MeshManipulator<DIM> expected(&config, 1);
+    expected.readMesh(fileName, partitions);
+    expected.useDefaultDGBasisFunctions(2);
+
+    Base::MeshManipulator<DIM> moved(&config, 1);
+    moved.readMesh(fileName, partitions);
+    moved.useDefaultDGBasisFunctions(2);
+    setData(moved);
+
+    std::vector<std::size_t> newOwners;
+    for (const Base::Element* element : moved.getElementsList()) {
+        newOwners.push_back((element->getOwner() + 1) % numberOfProcessors);
+    }
+    moved.redistribute(newOwners);
+    std::size_t numberOfOwnedElements = 0;
+    for (std::size_t i = 0; i < partitions.size(); ++i) {
+        if ((partitions[i] + 1) % numberOfProcessors == processorID) {
+            ++numberOfOwnedElements;
+        }
+    }
+    logger.assert_always(
+        moved.getNumberOfElements() == numberOfOwnedElements,
+        "Processor % owns % elements of mesh %, but should own %", processorID,
+        moved.getNumberOfElements(), name, numberOfOwnedElements);
+    for (const Base::Element* element : moved.getElementsList()) {
+        std::size_t index = moved.getElementIndexInFile(element);
+        logger.assert_always(
+            element->getOwner() == processorID &&
+                (partitions[index] + 1) % numberOfProcessors == processorID,
+            "Element % of mesh % is on the wrong processor", index, name);
+    }
+    checkData(moved, name);
+
+    newOwners.clear();
+    for (const Base::Element* element : moved.getElementsList()) {
+        newOwners.push_back(partitions[moved.getElementIndexInFile(element)]);
+    }
+    moved.redistribute(newOwners);
+    MeshTest::compareMeshes(moved, expected, name);
+    checkData(moved, name);
+}
+
+int main(int argc, char** argv) {
+    Base::parse_options(argc, argv);
+
+    testRedistribution<1>("1Drectangular2mesh.hpgem");
+    testRedistribution<1>("advectionMesh5.hpgem");
+    testRedistribution<2>("2Drectangular1mesh.hpgem");
+    testRedistribution<2>("advectionMesh8.hpgem");
+    testRedistribution<3>("3Dtriangular1mesh.hpgem");
+    testRedistribution<3>("advectionMesh14.hpgem");
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/ConfigurationData.h"
+#include "Base/Element.h"
+#include "Base/MeshManipulator.h"
+#include "Base/MpiContainer.h"
+#include "Logger.h"
+#include "compareMeshes.h"
+
+// Test of MeshManipulator::readMesh with a mesh file that is not partitioned
+// for the current number of processors, so the mesh is partitioned while it is
+// read. Each processor should own about the same number of elements, and the
+// mesh should be the same as the mesh that readMesh makes when it is given the
+// same partitioning.
+using namespace hpgem;
+
+template <std::size_t DIM>
+void testPartitioning(const std::string& name) {
+    std::string fileName =
+        Base::getCMAKE_hpGEM_SOURCE_DIR() + "/tests/files/" + name;
+    auto& communicator = Base::MPIContainer::Instance();
+    std::size_t numberOfProcessors =
+        static_cast<std::size_t>(communicator.getNumberOfProcessors());
+    std::size_t processorID =
+        static_cast<std::size_t>(communicator.getProcessorID());
+    Base::ConfigurationData config(1);
+
+    Base::MeshManipulator<DIM> partitioned(&config);
+    partitioned.readMesh(fileName);
+    std::size_t numberOfElements = partitioned.getNumberOfElementsInFile();
+    logger.assert_always(
+        partitioned.getNumberOfElements() <=
+            (numberOfElements + numberOfProcessors - 1) / numberOfProcessors +
+                1,
+        "Processor % owns % of the % elements of mesh %", processorID,
+        partitioned.getNumberOfElements(), numberOfElements, name);
+
+    // the partition of each element of the file, as it was chosen
+    std::vector<std::size_t> partitions(numberOfElements, 0);
+    for (const Base::Element* element : partitioned.getElementsList()) {
+        partitions[partitioned.getElementIndexInFile(element)] = processorID;
+    }
+#ifdef HPGEM_USE_MPI
+    communicator.reduce(partitions, MPI_SUM);
+    communicator.broadcast(partitions);
+#endif
+
+    Base::MeshManipulator<DIM> expected(&config);
+    expected.readMesh(fileName, partitions);
+    MeshTest::compareMeshes(partitioned, expected, name);
+}
+
+int main(int argc, char** argv) {
+    Base::parse_options(argc, argv);
+
+    testPartitioning<1>("1Drectangular2mesh.hpgem");
+    testPartitioning<1>("advectionMesh5.hpgem");
+    testPartitioning<2>("2Drectangular1mesh.hpgem");
+    testPartitioning<2>("advectionMesh8.hpgem");
+    testPartitioning<3>("3Dtriangular1mesh.hpgem");
+    testPartitioning<3>("advectionMesh14.hpgem");
+    return 0;
+}
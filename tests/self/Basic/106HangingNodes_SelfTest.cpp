@@ -0,0 +1,316 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <functional>
+#include <map>
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/HpgemAPISimplified.h"
+#include "Geometry/PointReference.h"
+#include "Logger.h"
+
+#include "upwindAdvection.h"
+
+/// This class is used to test local refinement with hanging nodes in 2D. It
+/// solves the advection equation du/dt + a.grad u = 0 with an upwind flux on a
+/// periodic mesh of the unit square, for a narrow pulse that is not resolved by
+/// the initial mesh.
+using namespace hpgem;
+class AdaptiveAdvection : public Base::HpgemAPISimplified<2> {
+   public:
+    explicit AdaptiveAdvection(const std::size_t p)
+        : Base::HpgemAPISimplified<2>(
+              1, p,
+              TimeIntegration::AllTimeIntegrators::Instance().getRule(3, 3,
+                                                                      true)),
+          a({0.5, 0.25}) {}
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtElement(
+        Base::Element *ptrElement,
+        const LinearAlgebra::MiddleSizeVector &inputFunctionCoefficients,
+        const double /*time*/) final {
+        return AdvectionTest::integrateAdvectionAtElement(
+            elementIntegrator_, ptrElement, a, inputFunctionCoefficients);
+    }
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtFace(
+        Base::Face *ptrFace, const Base::Side iSide,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsLeft,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsRight,
+        const double /*time*/) final {
+        return AdvectionTest::integrateUpwindFluxAtFace(
+            faceIntegrator_, ptrFace, iSide, a, inputFunctionCoefficientsLeft,
+            inputFunctionCoefficientsRight);
+    }
+
+    LinearAlgebra::MiddleSizeVector getInitialSolution(
+        const PointPhysicalT &point, const double &startTime,
+        const std::size_t /*orderTimeDerivative*/) final {
+        LinearAlgebra::MiddleSizeVector initialSolution(1);
+        initialSolution(0) = AdvectionTest::pulse(point[0], a[0], startTime) *
+                             AdvectionTest::pulse(point[1], a[1], startTime);
+        return initialSolution;
+    }
+
+    /// Integral of the numerical solution over the domain.
+    double computeMass() {
+        return AdvectionTest::computeMass(elementIntegrator_, *meshes_[0],
+                                          solutionVectorId_);
+    }
+
+    /// Record the mass before the first adaptation (the upwind scheme itself
+    /// conserves mass) and the largest size of the mesh.
+    void showProgress(const double /*time*/,
+                      const std::size_t timeStepID) final {
+        if (timeStepID == 1) {
+            initialMass_ = computeMass();
+        }
+        maximumNumberOfElements_ = std::max(
+            maximumNumberOfElements_, meshes_[0]->getNumberOfElements());
+        checkFaces();
+    }
+
+    /// Refine only the active element whose centre is closest to the point.
+    void refineAt(const PointPhysicalT &point) {
+        const Base::Element *marked = nullptr;
+        double smallestDistance = std::numeric_limits<double>::infinity();
+        for (const Base::Element *element : meshes_[0]->getElementsList()) {
+            const double distance =
+                (element
+                     ->referenceToPhysical(
+                         static_cast<const Geometry::PointReference<2> &>(
+                             element->getReferenceGeometry()->getCenter()))
+                     .getCoordinates() -
+                 point.getCoordinates())
+                    .l2Norm();
+            if (distance < smallestDistance) {
+                smallestDistance = distance;
+                marked = element;
+            }
+        }
+        meshes_[0]->refine(getRefinementMapping(marked),
+                           [&](const Base::Element *element) {
+                               return element == marked;
+                           });
+        checkFaces();
+    }
+
+    /// Coarsen every refined element whose children are active.
+    void coarsenAll() {
+        meshes_[0]->coarsen([](const Base::Element *) { return true; });
+        checkFaces();
+    }
+
+    /// Number of active elements on the given level of refinement.
+    std::size_t getNumberOfElementsOnLevel(const std::size_t level) const {
+        std::size_t numberOfElements = 0;
+        for (const Base::Element *element : meshes_[0]->getElementsList()) {
+            if (element->getPositionInTree()->getLevel() == level) {
+                ++numberOfElements;
+            }
+        }
+        return numberOfElements;
+    }
+
+    const Base::MeshManipulator<2> *getMesh() const { return meshes_[0]; }
+
+    std::size_t getNumberOfNonconformingFaces() const {
+        std::size_t numberOfFaces = 0;
+        for (const Base::Face *face : meshes_[0]->getFacesList()) {
+            if (face->isNonconforming()) {
+                ++numberOfFaces;
+            }
+        }
+        return numberOfFaces;
+    }
+
+    /// Check that both sides of every face are at the same physical points
+    /// (up to a period) and that the faces close every element: the integral
+    /// of the normal over the boundary of each element vanishes only if the
+    /// faces cover the whole boundary, including the split faces of the coarse
+    /// elements.
+    void checkFaces() const {
+        std::map<const Base::Element *, LinearAlgebra::SmallVector<2>>
+            normalIntegrals;
+        for (const Base::Face *face : meshes_[0]->getFacesList()) {
+            const QuadratureRules::GaussQuadratureRule *rule =
+                face->getGaussQuadratureRule();
+            LinearAlgebra::SmallVector<2> normalIntegral;
+            for (std::size_t i = 0; i < rule->getNumberOfPoints(); ++i) {
+                const Geometry::PointReference<1> &point =
+                    static_cast<const Geometry::PointReference<1> &>(
+                        rule->getPoint(i));
+                normalIntegral += rule->weight(i) * face->getNormalVector(point);
+                if (!face->isInternal()) {
+                    continue;
+                }
+                LinearAlgebra::SmallVector<2> difference =
+                    face->getPtrElementLeft()
+                        ->referenceToPhysical(face->mapRefFaceToRefElemL(point))
+                        .getCoordinates() -
+                    face->getPtrElementRight()
+                        ->referenceToPhysical(face->mapRefFaceToRefElemR(point))
+                        .getCoordinates();
+                for (std::size_t d = 0; d < 2; ++d) {
+                    difference[d] -= std::round(difference[d]);
+                }
+                logger.assert_always(difference.l2Norm() < 1e-12,
+                                     "The sides of face % do not match",
+                                     face->getID());
+            }
+            normalIntegrals[face->getPtrElementLeft()] += normalIntegral;
+            if (face->isInternal()) {
+                normalIntegrals[face->getPtrElementRight()] -= normalIntegral;
+            }
+        }
+        logger.assert_always(
+            normalIntegrals.size() == meshes_[0]->getNumberOfElements(),
+            "Not every element has faces");
+        for (const auto &normalIntegral : normalIntegrals) {
+            logger.assert_always(normalIntegral.second.l2Norm() < 1e-12,
+                                 "The faces of element % do not close it",
+                                 normalIntegral.first->getID());
+        }
+    }
+
+    void createAndSolve(const std::string fileName,
+                        const std::string outputFileName, const double T,
+                        const std::size_t nT) {
+        readMesh(fileName);
+        setOutputNames(outputFileName, "HangingNodes", "u", {"u"});
+        solve(0, T, T / static_cast<double>(nT), 0, false);
+    }
+
+    double initialMass_ = 0;
+    std::size_t maximumNumberOfElements_ = 0;
+
+   private:
+    /// Advection velocity
+    LinearAlgebra::SmallVector<2> a;
+};
+
+/// Refine one element and then one of its children, and check that only the
+/// marked element and the face neighbours it needs to stay within one level
+/// are refined. Then coarsen the mesh back to the initial mesh.
+void testLocalRefinement(const std::string &fileName) {
+    AdaptiveAdvection test(1);
+    test.readMesh(fileName);
+    const std::size_t initialNumberOfElements =
+        test.getNumberOfElementsOnLevel(0);
+    const std::size_t numberOfFaces =
+        (*test.getMesh()->getElementsList().begin())->getNumberOfFaces();
+    const std::size_t numberOfChildren =
+        numberOfFaces == 3 ? 4 : 2 * numberOfFaces - 4;
+
+    test.refineAt({0.3, 0.3});
+    logger.assert_always(test.getNumberOfElementsOnLevel(0) ==
+                             initialNumberOfElements - 1,
+                         "A neighbour on the same level was refined as well");
+    logger.assert_always(test.getNumberOfNonconformingFaces() ==
+                             2 * numberOfFaces,
+                         "Expected % faces with a hanging node, but found %",
+                         2 * numberOfFaces,
+                         test.getNumberOfNonconformingFaces());
+
+    // refining a child that lies against the coarse neighbours of its parent
+    // also refines those neighbours, but nothing else
+    test.refineAt({0.27, 0.27});
+    const std::size_t numberOfRefinedNeighbours =
+        initialNumberOfElements - 1 - test.getNumberOfElementsOnLevel(0);
+    std::cout << "Refined " << numberOfRefinedNeighbours
+              << " neighbours, the mesh has " << test.getNumberOfElements(0)
+              << " elements\n";
+    logger.assert_always(
+        numberOfRefinedNeighbours > 0 &&
+            numberOfRefinedNeighbours < numberOfFaces,
+        "Refined % neighbours of the marked element", numberOfRefinedNeighbours);
+    logger.assert_always(
+        test.getNumberOfElementsOnLevel(2) == numberOfChildren,
+        "Only the marked child should be on level 2");
+    logger.assert_always(
+        test.getNumberOfElements(0) ==
+            initialNumberOfElements - 1 - numberOfRefinedNeighbours +
+                numberOfChildren * numberOfRefinedNeighbours +
+                2 * numberOfChildren - 1,
+        "The mesh has % elements", test.getNumberOfElements(0));
+
+    test.coarsenAll();
+    test.coarsenAll();
+    logger.assert_always(
+        test.getNumberOfElements(0) == initialNumberOfElements &&
+            test.getNumberOfNonconformingFaces() == 0,
+        "Coarsening did not restore the initial mesh");
+}
+
+int main(int argc, char **argv) {
+    using namespace std::string_literals;
+    Base::parse_options(argc, argv);
+
+    const std::string directory =
+        Base::getCMAKE_hpGEM_SOURCE_DIR() + "/tests/files/"s;
+    // squares and triangles
+    testLocalRefinement(directory + "advectionMesh9.hpgem"s);
+    testLocalRefinement(directory + "advectionMesh8.hpgem"s);
+
+    // Write the output next to the test executable (in the build directory)
+    // instead of the current working directory.
+    const std::string executable = argv[0];
+    const std::string outputDirectory =
+        executable.substr(0, executable.find_last_of('/') + 1);
+    Base::numberOfStepsBetweenAdaptations.getValue() = 5;
+    Base::maximumRefinementLevel.getValue() = 2;
+    Base::adaptFraction.getValue() = 0.1;
+    AdaptiveAdvection adaptiveTest(1);
+    adaptiveTest.createAndSolve(directory + "advectionMesh9.hpgem"s,
+                                outputDirectory + "106HangingNodes", 0.2, 100);
+    std::cout << "Maximum number of elements: "
+              << adaptiveTest.maximumNumberOfElements_ << "\n";
+    // uniform refinement to the finest level would give 256 elements
+    logger.assert_always(adaptiveTest.maximumNumberOfElements_ > 16 &&
+                             adaptiveTest.maximumNumberOfElements_ < 128,
+                         "The mesh was not refined locally");
+    logger.assert_always(std::abs(adaptiveTest.computeMass() -
+                                  adaptiveTest.initialMass_) < 1e-10,
+                         "Adaptation changed the mass from % to %",
+                         adaptiveTest.initialMass_, adaptiveTest.computeMass());
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HPGEM_COMPAREMESHES_H
+#define HPGEM_COMPAREMESHES_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Base/Edge.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/MeshManipulator.h"
+#include "Geometry/PhysicalGeometry.h"
+#include "Logger.h"
+
+namespace MeshTest {
+
+using namespace hpgem;
+
+/// Check that two meshes are the same: the same elements in the same order
+/// with the same nodes, and the same faces and edges, all identified by the
+/// index of the elements in the file, and the same elements to send to and
+/// receive from the other processors. The name is used in the error messages.
+template <std::size_t DIM>
+void compareMeshes(Base::MeshManipulator<DIM>& generated,
+                   Base::MeshManipulator<DIM>& read, const std::string& name) {
+    for (auto part : {Base::IteratorType::LOCAL, Base::IteratorType::GLOBAL}) {
+        logger.assert_always(
+            generated.getNumberOfElements(part) ==
+                    read.getNumberOfElements(part) &&
+                generated.getNumberOfFaces(part) ==
+                    read.getNumberOfFaces(part) &&
+                generated.getNumberOfEdges(part) ==
+                    read.getNumberOfEdges(part) &&
+                generated.getNumberOfNodes(part) == read.getNumberOfNodes(part),
+            "The generated mesh % has a different size", name);
+    }
+    logger.assert_always(generated.getNumberOfElementsInFile() ==
+                             read.getNumberOfElementsInFile(),
+                         "The generated mesh % has a different size", name);
+
+    auto generatedElement =
+        generated.getElementsList(Base::IteratorType::GLOBAL).begin();
+    for (const Base::Element* element :
+         read.getElementsList(Base::IteratorType::GLOBAL)) {
+        logger.assert_always(
+            generated.getElementIndexInFile(*generatedElement) ==
+                    read.getElementIndexInFile(element) &&
+                (*generatedElement)->getNumberOfNodes() ==
+                    element->getNumberOfNodes(),
+            "Element % of the generated mesh % is different",
+            read.getElementIndexInFile(element), name);
+        for (std::size_t i = 0; i < element->getNumberOfNodes(); ++i) {
+            const Geometry::PointPhysical<DIM>& expected =
+                element->getPhysicalGeometry()->getLocalNodeCoordinates(i);
+            const Geometry::PointPhysical<DIM>& actual =
+                (*generatedElement)
+                    ->getPhysicalGeometry()
+                    ->getLocalNodeCoordinates(i);
+            for (std::size_t j = 0; j < DIM; ++j) {
+                logger.assert_always(
+                    actual[j] == expected[j],
+                    "Node % of element % of the generated mesh % is at %, "
+                    "but should be at %",
+                    i, read.getElementIndexInFile(element), name, actual,
+                    expected);
+            }
+        }
+        ++generatedElement;
+    }
+
+    // (element, local face) -> (element on the other side, local face, type)
+    using FaceDescription =
+        std::map<std::pair<std::size_t, std::size_t>,
+                 std::tuple<std::size_t, std::size_t, Geometry::FaceType>>;
+    auto describeFaces = [](Base::MeshManipulator<DIM>& mesh) {
+        FaceDescription result;
+        for (const Base::Face* face :
+             mesh.getFacesList(Base::IteratorType::GLOBAL)) {
+            std::size_t right = mesh.getNumberOfElementsInFile();
+            std::size_t localRight = 0;
+            if (face->isInternal()) {
+                right = mesh.getElementIndexInFile(face->getPtrElementRight());
+                localRight = face->localFaceNumberRight();
+            }
+            result[{mesh.getElementIndexInFile(face->getPtrElementLeft()),
+                    face->localFaceNumberLeft()}] =
+                std::make_tuple(right, localRight, face->getFaceType());
+        }
+        return result;
+    };
+    logger.assert_always(describeFaces(generated) == describeFaces(read),
+                         "The faces of the generated mesh % are different",
+                         name);
+
+    auto describeEdges = [](Base::MeshManipulator<DIM>& mesh) {
+        std::set<std::set<std::pair<std::size_t, std::size_t>>> result;
+        for (const Base::Edge* edge :
+             mesh.getEdgesList(Base::IteratorType::GLOBAL)) {
+            std::set<std::pair<std::size_t, std::size_t>> edgeElements;
+            for (std::size_t i = 0; i < edge->getNumberOfElements(); ++i) {
+                edgeElements.insert(
+                    {mesh.getElementIndexInFile(edge->getElement(i)),
+                     edge->getEdgeNumber(i)});
+            }
+            result.insert(edgeElements);
+        }
+        return result;
+    };
+    logger.assert_always(describeEdges(generated) == describeEdges(read),
+                         "The edges of the generated mesh % are different",
+                         name);
+
+    // the elements that are sent to and received from the other processors,
+    // in the order in which they are communicated
+    using Communication = std::map<int, std::vector<std::size_t>>;
+    auto describeCommunication =
+        [](Base::MeshManipulator<DIM>& mesh,
+           const std::map<int, std::vector<Base::Element*>>& elements) {
+            Communication result;
+            for (const auto& pair : elements) {
+                for (const Base::Element* element : pair.second) {
+                    result[pair.first].push_back(
+                        mesh.getElementIndexInFile(element));
+                }
+            }
+            return result;
+        };
+    logger.assert_always(
+        describeCommunication(generated, generated.getPushElements()) ==
+                describeCommunication(read, read.getPushElements()) &&
+            describeCommunication(generated, generated.getPullElements()) ==
+                describeCommunication(read, read.getPullElements()),
+        "The generated mesh % communicates different elements", name);
+}
+}  // namespace MeshTest
+
+#endif  // HPGEM_COMPAREMESHES_H
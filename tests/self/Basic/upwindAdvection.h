@@ -0,0 +1,147 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HPGEM_UPWINDADVECTION_H
+#define HPGEM_UPWINDADVECTION_H
+
+#include <cmath>
+#include <functional>
+
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/MeshManipulator.h"
+#include "Integration/ElementIntegral.h"
+#include "Integration/FaceIntegral.h"
+#include "LinearAlgebra/MiddleSizeVector.h"
+#include "LinearAlgebra/SmallVector.h"
+
+/// Building blocks for the self tests that solve the linear advection equation
+/// du/dt + a.grad u = -k u with an upwind flux on a periodic mesh. The elements
+/// may have different numbers of basis functions.
+namespace AdvectionTest {
+
+using namespace hpgem;
+
+/// \brief Integrate the element part of the right hand side,
+/// \f$ \int (u a \cdot \nabla \phi_i - k u \phi_i) \f$.
+template <std::size_t DIM>
+LinearAlgebra::MiddleSizeVector integrateAdvectionAtElement(
+    Integration::ElementIntegral<DIM> &elementIntegrator,
+    Base::Element *ptrElement, const LinearAlgebra::SmallVector<DIM> &velocity,
+    const LinearAlgebra::MiddleSizeVector &coefficients,
+    const double decay = 0) {
+    std::function<LinearAlgebra::MiddleSizeVector(Base::PhysicalElement<DIM> &)>
+        integrandFunction = [&](Base::PhysicalElement<DIM> &element)
+        -> LinearAlgebra::MiddleSizeVector {
+        const std::size_t numberOfBasisFunctions =
+            element.getNumberOfBasisFunctions();
+        LinearAlgebra::MiddleSizeVector &result = element.getResultVector();
+        LinearAlgebra::MiddleSizeVector::type functionValue = 0;
+        for (std::size_t j = 0; j < numberOfBasisFunctions; ++j) {
+            functionValue += coefficients(j) * element.basisFunction(j);
+        }
+        for (std::size_t i = 0; i < numberOfBasisFunctions; ++i) {
+            result(i) =
+                functionValue * (velocity * element.basisFunctionDeriv(i) -
+                                 decay * element.basisFunction(i));
+        }
+        return result;
+    };
+    return elementIntegrator.integrate(ptrElement, integrandFunction);
+}
+
+/// \brief Integrate the upwind flux \f$ -\int a \cdot n u_{up} \phi_i \f$ for
+/// the element at side iSide of the face.
+template <std::size_t DIM>
+LinearAlgebra::MiddleSizeVector integrateUpwindFluxAtFace(
+    Integration::FaceIntegral<DIM> &faceIntegrator, Base::Face *ptrFace,
+    const Base::Side iSide, const LinearAlgebra::SmallVector<DIM> &velocity,
+    const LinearAlgebra::MiddleSizeVector &coefficientsLeft,
+    const LinearAlgebra::MiddleSizeVector &coefficientsRight) {
+    std::function<LinearAlgebra::MiddleSizeVector(Base::PhysicalFace<DIM> &)>
+        integrandFunction = [&](Base::PhysicalFace<DIM> &face)
+        -> LinearAlgebra::MiddleSizeVector {
+        LinearAlgebra::MiddleSizeVector &result = face.getResultVector(iSide);
+        // normal speed with respect to the normal of the left element
+        const double normalSpeed = velocity * face.getUnitNormalVector();
+        const Base::Side upwindSide =
+            normalSpeed > 0 ? Base::Side::LEFT : Base::Side::RIGHT;
+        const LinearAlgebra::MiddleSizeVector &upwindCoefficients =
+            upwindSide == Base::Side::LEFT ? coefficientsLeft
+                                           : coefficientsRight;
+        LinearAlgebra::MiddleSizeVector::type upwindValue = 0;
+        for (std::size_t j = 0; j < upwindCoefficients.size(); ++j) {
+            upwindValue +=
+                upwindCoefficients(j) * face.basisFunction(upwindSide, j);
+        }
+        const double sign = iSide == Base::Side::LEFT ? 1. : -1.;
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result(i) = -sign * normalSpeed * upwindValue *
+                        face.basisFunction(iSide, i);
+        }
+        return result;
+    };
+    return faceIntegrator.integrate(ptrFace, integrandFunction);
+}
+
+/// \brief Integral of the (real part of the) solution over the local elements.
+template <std::size_t DIM>
+double computeMass(Integration::ElementIntegral<DIM> &elementIntegrator,
+                   Base::MeshManipulator<DIM> &mesh,
+                   const std::size_t solutionVectorId) {
+    double mass = 0;
+    for (Base::Element *ptrElement : mesh.getElementsList()) {
+        std::function<double(Base::PhysicalElement<DIM> &)> integrandFunction =
+            [&](Base::PhysicalElement<DIM> &element) {
+                return std::real(ptrElement->getSolution(
+                    solutionVectorId, element.getPointReference())[0]);
+            };
+        mass += elementIntegrator.integrate(ptrElement, integrandFunction);
+    }
+    return mass;
+}
+
+/// \brief Narrow Gaussian pulse, centred at 0.3 at time zero, that is advected
+/// with speed a through the periodic domain [0,1].
+inline double pulse(const double x, const double a, const double time) {
+    double distance = x - a * time - 0.3;
+    distance -= std::round(distance);
+    return std::exp(-distance * distance / 0.004);
+}
+}  // namespace AdvectionTest
+
+#endif  // HPGEM_UPWINDADVECTION_H
@@ -0,0 +1,119 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Base/CommandLineOptions.h"
+#include "Base/ConfigurationData.h"
+#include "Base/MeshManipulator.h"
+
+#include "Algorithms/DGMaxHarmonic.h"
+#include "DGMaxLogger.h"
+#include "DGMaxProgramUtils.h"
+
+#include <CMakeDefinitions.h>
+
+// Test of the frequency sweep of DGMaxHarmonic. On a periodic mesh a constant
+// source J gives the constant solution E = -J / omega^2, which is in the
+// discrete space. The right hand side is assembled once, so each frequency
+// only recovers this solution when the sweep replaces omega correctly.
+
+/// Constant source term on a periodic domain, independent of omega
+class ConstantSourceProblem : public HarmonicProblem<2> {
+   public:
+    double omega() const override { return 1.0; }
+    void sourceTerm(const Geometry::PointPhysical<2>&,
+                    LinearAlgebra::SmallVector<2>& result) const override {
+        result = source();
+    }
+    void boundaryCondition(
+        const Geometry::PointPhysical<2>&, Base::PhysicalFace<2>&,
+        LinearAlgebra::SmallVector<2>& result) const override {
+        result.set(0);
+    }
+    bool rhsDependsOnOmega() const override { return false; }
+
+    static LinearAlgebra::SmallVector<2> source() { return {1.0, -0.5}; }
+};
+
+int main(int argc, char** argv) {
+    using namespace std::string_literals;
+    Base::parse_options(argc, argv);
+    initDGMaxLogging();
+
+    Base::ConfigurationData configData(1, 1);
+    auto mesh = DGMax::readMesh<2>(
+        Base::getCMAKE_hpGEM_SOURCE_DIR() +
+            "/tests/files/unitPeriodicSimplexD2N8P1.hpgem"s,
+        &configData, [](const Geometry::PointPhysical<2>&) { return 1.0; });
+    for (Base::Element* element :
+         mesh->getElementsList(Base::IteratorType::GLOBAL)) {
+        element->setNumberOfTimeIntegrationVectors(1);
+    }
+
+    DGMaxHarmonic<2> solver(*mesh, 1);
+    ConstantSourceProblem problem;
+    // The first two frequencies are close enough to reuse the preconditioner
+    std::vector<double> frequencies = {1.0, 1.01, 1.5, 3.0};
+    std::vector<bool> solved(frequencies.size(), false);
+    solver.solveSweep(
+        problem, frequencies, 100,
+        [&](std::size_t index, double omega) {
+            logger.assert_always(omega == frequencies[index],
+                                 "Wrong frequency % for index %", omega,
+                                 index);
+            LinearAlgebra::SmallVector<2> expected =
+                ConstantSourceProblem::source() / (-omega * omega);
+            auto errors = solver.computeError(
+                {DGMaxDiscretizationBase::L2},
+                [&](const Geometry::PointPhysical<2>&,
+                    LinearAlgebra::SmallVector<2>& result) {
+                    result = expected;
+                },
+                [](const Geometry::PointPhysical<2>&,
+                   LinearAlgebra::SmallVector<2>& result) { result.set(0); });
+            logger(INFO, "L2 error for omega = %: %", omega,
+                   errors[DGMaxDiscretizationBase::L2]);
+            logger.assert_always(errors[DGMaxDiscretizationBase::L2] < 1e-6,
+                                 "Wrong solution for omega = %", omega);
+            solved[index] = true;
+        });
+    // Without groups this processor solves all frequencies
+    for (std::size_t i = 0; i < frequencies.size(); ++i) {
+        logger.assert_always(solved[i], "Frequency % was not solved", i);
+    }
+    return 0;
+}
@@ -0,0 +1,266 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2014, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <functional>
+#include <CMakeDefinitions.h>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/Element.h"
+#include "Base/Face.h"
+#include "Base/HpgemAPIImplicit.h"
+#include "Integration/ElementIntegral.h"
+#include "Integration/FaceIntegral.h"
+#include "Logger.h"
+
+#include "../Basic/upwindAdvection.h"
+
+/// This class is used to test the implicit time integration of
+/// HpgemAPIImplicit. It solves the 1D advection equation with a relaxation
+/// term du/dt + a du/dx = -k (u - g) with an upwind flux on a periodic mesh,
+/// where g = sin(2 pi (x - a t)) is also the exact solution. The solution thus
+/// stays O(1) however stiff the relaxation is. With IMEX the advection is
+/// treated explicitly and the relaxation implicitly.
+using namespace hpgem;
+class ImplicitAdvection : public Base::HpgemAPIImplicit<1> {
+   public:
+    ImplicitAdvection(const std::size_t p, const double relaxationRate,
+                      const bool useImex, const bool assembleJacobian)
+        : Base::HpgemAPIImplicit<1>(1, p, useImex, assembleJacobian),
+          a({0.5}),
+          k(relaxationRate) {}
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtElement(
+        Base::Element *ptrElement,
+        const LinearAlgebra::MiddleSizeVector &inputFunctionCoefficients,
+        const double time) final {
+        const LinearAlgebra::SmallVector<1> advection =
+            getRightHandSidePart() == Base::RightHandSidePart::IMPLICIT
+                ? LinearAlgebra::SmallVector<1>()
+                : a;
+        const double relaxation =
+            getRightHandSidePart() == Base::RightHandSidePart::EXPLICIT ? 0.
+                                                                        : k;
+        LinearAlgebra::MiddleSizeVector result =
+            AdvectionTest::integrateAdvectionAtElement(
+                elementIntegrator_, ptrElement, advection,
+                inputFunctionCoefficients, relaxation);
+        if (relaxation == 0) {
+            return result;
+        }
+        // The part k g of the relaxation term does not depend on u
+        std::function<LinearAlgebra::MiddleSizeVector(
+            Base::PhysicalElement<1> &)>
+            integrandFunction = [&](Base::PhysicalElement<1> &element)
+            -> LinearAlgebra::MiddleSizeVector {
+            LinearAlgebra::MiddleSizeVector &integrand =
+                element.getResultVector();
+            const double target =
+                computeExactSolution(element.getPointPhysical()[0], time);
+            for (std::size_t i = 0; i < element.getNumberOfBasisFunctions();
+                 ++i) {
+                integrand(i) = relaxation * target * element.basisFunction(i);
+            }
+            return integrand;
+        };
+        result += elementIntegrator_.integrate(ptrElement, integrandFunction);
+        return result;
+    }
+
+    LinearAlgebra::MiddleSizeVector computeRightHandSideAtFace(
+        Base::Face *ptrFace, const Base::Side iSide,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsLeft,
+        LinearAlgebra::MiddleSizeVector &inputFunctionCoefficientsRight,
+        const double /*time*/) final {
+        if (getRightHandSidePart() == Base::RightHandSidePart::IMPLICIT) {
+            return LinearAlgebra::MiddleSizeVector(
+                ptrFace->getPtrElement(iSide)->getNumberOfBasisFunctions());
+        }
+        return AdvectionTest::integrateUpwindFluxAtFace(
+            faceIntegrator_, ptrFace, iSide, a, inputFunctionCoefficientsLeft,
+            inputFunctionCoefficientsRight);
+    }
+
+    LinearAlgebra::MiddleSizeMatrix computeJacobianAtElement(
+        Base::Element *ptrElement,
+        const LinearAlgebra::MiddleSizeVector &/*solutionCoefficients*/,
+        const double /*time*/) final {
+        // With IMEX only the relaxation is part of the implicit right hand side
+        const double advection = useImex_ ? 0. : a[0];
+        std::function<LinearAlgebra::MiddleSizeMatrix(
+            Base::PhysicalElement<1> &)>
+            integrandFunction = [=](Base::PhysicalElement<1> &element)
+            -> LinearAlgebra::MiddleSizeMatrix {
+            std::size_t numberOfBasisFunctions =
+                element.getNumberOfBasisFunctions();
+            LinearAlgebra::MiddleSizeMatrix &result = element.getResultMatrix();
+            for (std::size_t i = 0; i < numberOfBasisFunctions; ++i) {
+                for (std::size_t j = 0; j < numberOfBasisFunctions; ++j) {
+                    result(i, j) =
+                        element.basisFunction(j) *
+                        (advection * element.basisFunctionDeriv(i)[0] -
+                         k * element.basisFunction(i));
+                }
+            }
+            return result;
+        };
+        return this->elementIntegrator_.integrate(ptrElement,
+                                                  integrandFunction);
+    }
+
+    LinearAlgebra::MiddleSizeMatrix computeJacobianAtFace(
+        Base::Face *ptrFace,
+        LinearAlgebra::MiddleSizeVector &/*solutionCoefficientsLeft*/,
+        LinearAlgebra::MiddleSizeVector &/*solutionCoefficientsRight*/,
+        const double /*time*/, const Base::Side elementSide,
+        const Base::Side derivativeSide) final {
+        const std::size_t numberOfTestFunctions =
+            ptrFace->getPtrElement(elementSide)->getNumberOfBasisFunctions();
+        const std::size_t numberOfDerivatives =
+            ptrFace->getPtrElement(derivativeSide)->getNumberOfBasisFunctions();
+        if (useImex_) {
+            return LinearAlgebra::MiddleSizeMatrix(numberOfTestFunctions,
+                                                   numberOfDerivatives);
+        }
+        std::function<LinearAlgebra::MiddleSizeMatrix(
+            Base::PhysicalFace<1> &)>
+            integrandFunction = [=](Base::PhysicalFace<1> &face)
+            -> LinearAlgebra::MiddleSizeMatrix {
+            LinearAlgebra::MiddleSizeMatrix result(numberOfTestFunctions,
+                                                   numberOfDerivatives);
+            // only the upwind coefficients appear in the flux
+            const double normal = face.getUnitNormalVector()[0];
+            const Base::Side upwindSide =
+                normal > 0 ? Base::Side::LEFT : Base::Side::RIGHT;
+            if (derivativeSide != upwindSide) {
+                return result;
+            }
+            const double sign = elementSide == Base::Side::LEFT ? 1. : -1.;
+            for (std::size_t i = 0; i < numberOfTestFunctions; ++i) {
+                for (std::size_t j = 0; j < numberOfDerivatives; ++j) {
+                    result(i, j) = -sign * a[0] * normal *
+                                   face.basisFunction(upwindSide, j) *
+                                   face.basisFunction(elementSide, i);
+                }
+            }
+            return result;
+        };
+        return this->faceIntegrator_.integrate(ptrFace, integrandFunction);
+    }
+
+    LinearAlgebra::MiddleSizeVector getExactSolution(
+        const PointPhysicalT &point, const double &time,
+        const std::size_t /*orderTimeDerivative*/) final {
+        LinearAlgebra::MiddleSizeVector exactSolution(1);
+        exactSolution(0) = computeExactSolution(point[0], time);
+        return exactSolution;
+    }
+
+    LinearAlgebra::MiddleSizeVector getInitialSolution(
+        const PointPhysicalT &point, const double &startTime,
+        const std::size_t orderTimeDerivative) final {
+        return getExactSolution(point, startTime, orderTimeDerivative);
+    }
+
+    LinearAlgebra::MiddleSizeVector::type createAndSolve(
+        const std::string fileName, const double T, const std::size_t nT) {
+        readMesh(fileName);
+        solve(0, T, T / static_cast<double>(nT), 0, false);
+        return computeTotalError(solutionVectorId_, T);
+    }
+
+   private:
+    double computeExactSolution(const double x, const double time) const {
+        return std::sin(2 * M_PI * (x - a[0] * time));
+    }
+
+    /// Advection velocity
+    LinearAlgebra::SmallVector<1> a;
+    /// Relaxation rate
+    double k;
+};
+
+int main(int argc, char **argv) {
+    using namespace std::string_literals;
+    Base::parse_options(argc, argv);
+
+    const std::string fileName = Base::getCMAKE_hpGEM_SOURCE_DIR() +
+                                 "/tests/files/advectionMesh1.hpgem"s;
+    const double T = 0.5;
+
+    // Fully implicit with time steps beyond the explicit stability limit,
+    // both with a finite difference and with an assembled Jacobian.
+    ImplicitAdvection matrixFreeTest(2, 1., false, false);
+    const LinearAlgebra::MiddleSizeVector::type matrixFreeError =
+        matrixFreeTest.createAndSolve(fileName, T, 8);
+    ImplicitAdvection assembledTest(2, 1., false, true);
+    const LinearAlgebra::MiddleSizeVector::type assembledError =
+        assembledTest.createAndSolve(fileName, T, 8);
+    ImplicitAdvection refinedTest(2, 1., false, true);
+    const LinearAlgebra::MiddleSizeVector::type refinedError =
+        refinedTest.createAndSolve(fileName, T, 16);
+
+    std::cout << "Error with matrix free Jacobian: " << matrixFreeError << "\n";
+    std::cout << "Error with assembled Jacobian: " << assembledError << "\n";
+    std::cout << "Error with assembled Jacobian and half the time step: "
+              << refinedError << "\n";
+    logger.assert_always(std::abs(matrixFreeError - assembledError) <
+                             1e-3 * std::abs(assembledError),
+                         "The Jacobian should not change the solution");
+    logger.assert_always(std::abs(assembledError) < 0.1,
+                         "Implicit time step unstable");
+    logger.assert_always(std::abs(refinedError) < std::abs(assembledError),
+                         "Error does not decrease with the time step");
+    // The problem is linear, so one Newton iteration per stage suffices with
+    // the exact Jacobian.
+    logger.assert_always(assembledTest.getNumberOfNonlinearIterations() <=
+                             matrixFreeTest.getNumberOfNonlinearIterations(),
+                         "The exact Jacobian needs more Newton iterations");
+
+    // IMEX with a relaxation that would need a time step of 2e-4 when treated
+    // explicitly. The time step is limited by the explicit advection only. The
+    // L2 norm of the exact solution is 1/sqrt(2), so the error is relative to
+    // an O(1) solution.
+    ImplicitAdvection imexTest(2, 1e4, true, true);
+    const LinearAlgebra::MiddleSizeVector::type imexError =
+        imexTest.createAndSolve(fileName, T, 64);
+    std::cout << "Error with IMEX: " << imexError << "\n";
+    logger.assert_always(std::abs(imexError) < 1e-2,
+                         "IMEX time step unstable or inaccurate");
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Base/CommandLineOptions.h"
+#include "Base/ConfigurationData.h"
+#include "Base/Element.h"
+#include "Base/MeshManipulator.h"
+#include "Base/Node.h"
+#include "Geometry/PhysicalGeometryBase.h"
+#include "Logger.h"
+
+// Test of MeshManipulator::createUnstructuredMesh and the r-refinement loop of
+// updateMesh. The generated mesh should fill the domain without overlapping or
+// inverted elements, the elements should have a reasonable quality, and the
+// element size should follow the requested relative edge length.
+using namespace hpgem;
+
+template <std::size_t DIM>
+const Geometry::PointPhysical<DIM>& getCorner(const Base::Element* element,
+                                              std::size_t i) {
+    return static_cast<const Geometry::PointPhysical<DIM>&>(
+        element->getPhysicalGeometry()->getLocalNodeCoordinates(i));
+}
+
+// signed length of a line segment or area of a triangle
+template <std::size_t DIM>
+double getVolume(const Base::Element* element) {
+    const Geometry::PointPhysical<DIM>& first = getCorner<DIM>(element, 0);
+    const Geometry::PointPhysical<DIM>& second = getCorner<DIM>(element, 1);
+    if (DIM == 1) {
+        return second[0] - first[0];
+    }
+    const Geometry::PointPhysical<DIM>& third = getCorner<DIM>(element, 2);
+    return ((second[0] - first[0]) * (third[1] - first[1]) -
+            (third[0] - first[0]) * (second[1] - first[1])) /
+           2.;
+}
+
+// ratio between the incircle and the circumcircle, scaled so an equilateral
+// triangle has quality 1 (same measure as updateMesh)
+double getQuality(const Base::Element* element) {
+    double a = Base::L2Norm(getCorner<2>(element, 0) - getCorner<2>(element, 1));
+    double b = Base::L2Norm(getCorner<2>(element, 1) - getCorner<2>(element, 2));
+    double c = Base::L2Norm(getCorner<2>(element, 2) - getCorner<2>(element, 0));
+    return (a + b - c) * (b + c - a) * (c + a - b) / a / b / c;
+}
+
+// Mesh the unit interval or square with elements that are twice as small near
+// the origin as near the opposite corner.
+template <std::size_t DIM>
+void testUnstructuredMesh(std::size_t numberOfNodes) {
+    Base::ConfigurationData config(1);
+    Base::MeshManipulator<DIM> mesh(&config);
+    Geometry::PointPhysical<DIM> bottomLeft, topRight;
+    for (std::size_t i = 0; i < DIM; ++i) {
+        topRight[i] = 1.;
+    }
+    // distance to the boundary of the unit square, negative inside
+    auto domain = [](const Geometry::PointPhysical<DIM>& point) {
+        double distance = -std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; i < DIM; ++i) {
+            distance = std::max(distance, std::abs(point[i] - 0.5) - 0.5);
+        }
+        return distance;
+    };
+    auto edgeLength = [](const Geometry::PointPhysical<DIM>& point) {
+        double sum = 0;
+        for (std::size_t i = 0; i < DIM; ++i) {
+            sum += point[i];
+        }
+        return 1. + sum / DIM;
+    };
+    // the corners of the domain
+    std::vector<Geometry::PointPhysical<DIM>> corners(1);
+    for (std::size_t i = 0; i < DIM; ++i) {
+        std::size_t numberOfCorners = corners.size();
+        for (std::size_t j = 0; j < numberOfCorners; ++j) {
+            corners.push_back(corners[j]);
+            corners.back()[i] = 1.;
+        }
+    }
+    mesh.createUnstructuredMesh(bottomLeft, topRight, numberOfNodes, domain,
+                                corners, edgeLength);
+
+    const double expectedElementVolume =
+        DIM == 1 ? 1. / static_cast<double>(numberOfNodes)
+                 : 2. / static_cast<double>(numberOfNodes);
+    double totalVolume = 0;
+    double worstQuality = 1;
+    double nearVolume = 0, farVolume = 0;
+    std::size_t numberOfNearElements = 0, numberOfFarElements = 0;
+    for (const Base::Element* element :
+         mesh.getElementsList(Base::IteratorType::GLOBAL)) {
+        double volume = std::abs(getVolume<DIM>(element));
+        logger.assert_always(volume > 1e-3 * expectedElementVolume,
+                             "Element % is (almost) degenerate",
+                             element->getID());
+        totalVolume += volume;
+        if (DIM == 2) {
+            worstQuality = std::min(worstQuality, getQuality(element));
+        }
+        double distance = 0;
+        for (std::size_t i = 0; i < element->getNumberOfNodes(); ++i) {
+            distance += Base::L2Norm(getCorner<DIM>(element, i)) /
+                        static_cast<double>(element->getNumberOfNodes());
+        }
+        if (distance < 0.4) {
+            nearVolume += volume;
+            ++numberOfNearElements;
+        }
+        if (distance > std::sqrt(double(DIM)) - 0.4) {
+            farVolume += volume;
+            ++numberOfFarElements;
+        }
+    }
+    for (const Base::Node* node :
+         mesh.getNodesList(Base::IteratorType::GLOBAL)) {
+        logger.assert_always(node->getNumberOfElements() > 0,
+                             "Node % of the %D mesh is not part of the mesh",
+                             node->getID(), DIM);
+    }
+    // the elements cover the domain without overlapping
+    logger.assert_always(std::abs(totalVolume - 1.) < 1e-8,
+                         "The elements of the %D mesh cover a volume of %", DIM,
+                         totalVolume);
+    logger.assert_always(worstQuality > 0.3,
+                         "The %D mesh has an element of quality %", DIM,
+                         worstQuality);
+    // the edges far away should be up to twice as long, the volume of the
+    // elements scales with the edge length to the power DIM; the samples are
+    // not taken at the corners themselves and the mesher only approximates
+    // the requested lengths, so only check that the mesh is clearly graded
+    const double ratio = farVolume / static_cast<double>(numberOfFarElements) /
+                         nearVolume *
+                         static_cast<double>(numberOfNearElements);
+    logger(INFO, "%D mesh: % elements, worst quality %, volume ratio %", DIM,
+           mesh.getNumberOfElements(Base::IteratorType::GLOBAL), worstQuality,
+           ratio);
+    logger.assert_always(
+        ratio > std::pow(1.3, DIM) && ratio < 2. * std::pow(2., DIM),
+        "The elements far from the origin of the %D mesh are % times as "
+        "large as the elements close to the origin",
+        DIM, ratio);
+}
+
+int main(int argc, char** argv) {
+    Base::parse_options(argc, argv);
+
+    testUnstructuredMesh<1>(40);
+    testUnstructuredMesh<2>(400);
+
+    return 0;
+}
@@ -41,6 +41,9 @@
 // unit test indicate the culprit class and other 'unit' tests may assume
 // correct execution of all prior unit tests
 #include "Utilities/BasisFunctionsMonomials.h"
+#include "Utilities/BasisFunctions1DH1ConformingLine.h"
+#include "Utilities/BasisFunctions2DH1ConformingSquare.h"
+#include "Utilities/BasisFunctions3DH1ConformingCube.h"
 
 #include "Base/BasisFunctionSet.h"
 #include "Geometry/PointReference.h"
@@ -51,7 +54,32 @@
 
 #include "../catch.hpp"
 
+#include <cmath>
+#include <memory>
+
 using namespace hpgem;
+
+// evaluating the whole set at once should give the same result as evaluating
+// the basis functions one by one
+template <std::size_t DIM>
+void checkEvalAll(const Base::BasisFunctionSet& set,
+                  const Geometry::PointReference<DIM>& point) {
+    std::vector<double> values;
+    std::vector<LinearAlgebra::SmallVector<DIM>> derivs;
+    set.evalAll(point, values);
+    set.evalAllDerivs(point, derivs);
+    REQUIRE(values.size() == set.size());
+    REQUIRE(derivs.size() == set.size());
+    for (std::size_t i = 0; i < set.size(); ++i) {
+        INFO("eval");
+        CHECK(std::abs(values[i] - set.eval(i, point)) < 1e-12);
+        LinearAlgebra::SmallVector<DIM> deriv = set.evalDeriv(i, point);
+        for (std::size_t j = 0; j < DIM; ++j) {
+            INFO("derivative");
+            CHECK(std::abs(derivs[i][j] - deriv[j]) < 1e-12);
+        }
+    }
+}
 TEST_CASE("030BasisFunctionSet_UnitTest", "[030BasisFunctionSet_UnitTest]") {
 
     Base::BasisFunctionSet all1DbasisFunctions(5);
@@ -115,3 +143,35 @@ TEST_CASE("030BasisFunctionSet_UnitTest", "[030BasisFunctionSet_UnitTest]") {
         }
     }
 }
+
+TEST_CASE("030BasisFunctionSet_EvalAll", "[030BasisFunctionSet_UnitTest]") {
+    for (std::size_t order = 1; order <= 5; ++order) {
+        std::unique_ptr<Base::BasisFunctionSet> lineSet(
+            Utilities::createDGBasisFunctionSet1DH1Line(order));
+        std::unique_ptr<Base::BasisFunctionSet> squareSet(
+            Utilities::createDGBasisFunctionSet2DH1Square(order));
+        std::unique_ptr<Base::BasisFunctionSet> cubeSet(
+            Utilities::createDGBasisFunctionSet3DH1Cube(order));
+        CHECK(lineSet->hasEvaluator());
+        CHECK(squareSet->hasEvaluator());
+        CHECK(cubeSet->hasEvaluator());
+        Geometry::PointReference<1> point1D;
+        for (point1D[0] = -1.; point1D[0] < 1.01; point1D[0] += 0.25) {
+            checkEvalAll(*lineSet, point1D);
+        }
+        Geometry::PointReference<2> point2D;
+        for (point2D[0] = -1.; point2D[0] < 1.01; point2D[0] += 0.4) {
+            for (point2D[1] = -1.; point2D[1] < 1.01; point2D[1] += 0.3) {
+                checkEvalAll(*squareSet, point2D);
+            }
+        }
+        Geometry::PointReference<3> point3D;
+        for (point3D[0] = -1.; point3D[0] < 1.01; point3D[0] += 0.6) {
+            for (point3D[1] = -1.; point3D[1] < 1.01; point3D[1] += 0.7) {
+                for (point3D[2] = -1.; point3D[2] < 1.01; point3D[2] += 0.5) {
+                    checkEvalAll(*cubeSet, point3D);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/SnapshotStream.h"
+
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+
+#include <petsc.h>
+#define CATCH_CONFIG_RUNNER
+#include "../catch.hpp"
+
+namespace DGMax {
+
+/// Sink that records the order of the snapshots and whether it was finished
+class RecordingSink : public SnapshotSink {
+   public:
+    void consume(const Snapshot& snapshot) override {
+        indices_.push_back(snapshot.index);
+    }
+    void finish() override { ++finished_; }
+
+    std::vector<std::size_t> indices_;
+    std::size_t finished_ = 0;
+};
+
+class ThrowingSink : public SnapshotSink {
+   public:
+    void consume(const Snapshot& snapshot) override {
+        if (snapshot.index == 1) {
+            throw std::runtime_error("Sink failure");
+        }
+    }
+};
+
+/// Snapshot at time t with coefficients 1, t and e^{i omega t}
+Snapshot testSnapshot(std::size_t index, double t, double omega) {
+    Snapshot snapshot;
+    snapshot.index = index;
+    snapshot.time = t;
+    snapshot.indexing = nullptr;
+    snapshot.coefficients = {1.0, t,
+                             std::complex<double>(std::cos(omega * t),
+                                                  std::sin(omega * t))};
+    return snapshot;
+}
+
+TEST_CASE("Snapshot queue", "[SnapshotStreamUnitTest]") {
+    auto recorder = std::make_shared<RecordingSink>();
+    {
+        SnapshotQueue queue({recorder}, 2);
+        for (std::size_t i = 0; i < 10; ++i) {
+            queue.push(testSnapshot(i, 0.1 * i, 0));
+        }
+        queue.close();
+    }
+    INFO("All snapshots are consumed in order");
+    REQUIRE(recorder->indices_.size() == 10);
+    for (std::size_t i = 0; i < 10; ++i) {
+        CHECK(recorder->indices_[i] == i);
+    }
+    INFO("The sink is finished once");
+    CHECK(recorder->finished_ == 1);
+
+    SECTION("Exceptions of sinks") {
+        SnapshotQueue queue({std::make_shared<ThrowingSink>()}, 1);
+        for (std::size_t i = 0; i < 5; ++i) {
+            queue.push(testSnapshot(i, 0.1 * i, 0));
+        }
+        INFO("The exception of the sink is rethrown when closing");
+        CHECK_THROWS_AS(queue.close(), std::runtime_error);
+    }
+}
+
+TEST_CASE("Fourier transform of snapshots", "[SnapshotStreamUnitTest]") {
+    // The trapezoidal rule is exact for the integrands 1, t and
+    // e^{i omega t} e^{-i omega t} = 1, also with a shorter last interval
+    const double omega = 3.0;
+    std::vector<double> times;
+    for (std::size_t i = 0; i <= 10; ++i) {
+        times.push_back(0.1 * i);
+    }
+    times.push_back(1.05);
+    const double endTime = times.back();
+
+    auto fourier = std::make_shared<FourierSnapshotSink>(
+        std::vector<double>({0.0, omega}));
+    SnapshotQueue queue({fourier}, 2);
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        queue.push(testSnapshot(i, times[i], omega));
+    }
+    queue.close();
+
+    const std::vector<PetscScalar>& zeroFrequency = fourier->getTransform(0);
+    const std::vector<PetscScalar>& omegaFrequency = fourier->getTransform(1);
+    REQUIRE(zeroFrequency.size() == 3);
+    INFO("Integral of 1");
+    CHECK(std::abs(zeroFrequency[0] - endTime) < 1e-12);
+    INFO("Integral of t");
+    CHECK(std::abs(zeroFrequency[1] - endTime * endTime / 2) < 1e-12);
+    INFO("Integral of e^{i omega t} e^{-i omega t}");
+    CHECK(std::abs(omegaFrequency[2] - endTime) < 1e-12);
+}
+
+}  // namespace DGMax
+
+int main(int argc, char* argv[]) {
+    PetscErrorCode ierr = PetscInitialize(&argc, &argv, nullptr, nullptr);
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+
+    int result = Catch::Session().run(argc, argv);
+
+    ierr = PetscFinalize();
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    return result;
+}
@@ -142,6 +142,8 @@ TEST_CASE("010MappingToPhysicalHypercubeLinear_UnitTest",
 
     INFO("getTargetDimension");
     CHECK((mapping1D.getTargetDimension() == 1));
+    INFO("isAffine");
+    CHECK(mapping1D.isAffine());
     // dim2
     pointIndexes[1] = 7;
 
@@ -248,6 +250,13 @@ TEST_CASE("010MappingToPhysicalHypercubeLinear_UnitTest",
 
     INFO("getTargetDimension");
     CHECK((mapping2D.getTargetDimension() == 2));
+    INFO("isAffine");
+    CHECK(!mapping2D.isAffine());
+    std::vector<Geometry::PointPhysical<2> > parallelogramNodes = {
+        {0., 0.}, {2., 1.}, {1., 3.}, {3., 4.}};
+    Geometry::PhysicalQuadrilateral parallelogram({0, 1, 2, 3},
+                                                  parallelogramNodes);
+    CHECK(Geometry::MappingToPhysHypercubeLinear<2>(&parallelogram).isAffine());
     // dim3
     pointIndexes[3] = 18;
 
@@ -395,4 +404,6 @@ TEST_CASE("010MappingToPhysicalHypercubeLinear_UnitTest",
 
     INFO("getTargetDimension");
     CHECK((mapping3D.getTargetDimension() == 3));
+    INFO("isAffine");
+    CHECK(!mapping3D.isAffine());
 }
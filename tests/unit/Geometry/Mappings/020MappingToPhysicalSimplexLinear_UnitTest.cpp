@@ -188,6 +188,8 @@ TEST_CASE("020MappingToPhysicalSimplexLinear_UnitTest",
 
     INFO("getTargetDimension");
     CHECK((mapping2D.getTargetDimension() == 2));
+    INFO("isAffine");
+    CHECK(mapping2D.isAffine());
     // dim3
     pointIndexes[2] = 18;
 
@@ -332,4 +334,6 @@ TEST_CASE("020MappingToPhysicalSimplexLinear_UnitTest",
 
     INFO("getTargetDimension");
     CHECK((mapping3D.getTargetDimension() == 3));
+    INFO("isAffine");
+    CHECK(mapping3D.isAffine());
 }
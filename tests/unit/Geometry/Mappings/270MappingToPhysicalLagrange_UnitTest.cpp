@@ -0,0 +1,214 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+// naming convention: <Digit><ClassName>_UnitTest.cpp where <Digit> is a number
+// that will make sure the unit tests are ordered such that the first failing
+// unit test indicate the culprit class and other 'unit' tests may assume
+// correct execution of all prior unit tests
+#include "Geometry/Mappings/MappingToPhysLagrange.h"
+#include "Geometry/Mappings/MappingToPhysHypercubeLinear.h"
+#include "Geometry/Mappings/MappingToPhysSimplexLinear.h"
+#include "Logger.h"
+
+#include "Geometry/ReferenceSquare.h"
+#include "Geometry/PhysicalLine.h"
+#include "Geometry/PhysicalTriangle.h"
+#include "Geometry/PhysicalQuadrilateral.h"
+#include "Geometry/PhysicalTetrahedron.h"
+#include "Geometry/PhysicalHexahedron.h"
+#include "Geometry/PointPhysical.h"
+#include "Integration/QuadratureRules/GaussQuadratureRule.h"
+#include <cmath>
+
+#include "../catch.hpp"
+
+using namespace hpgem;
+
+// The mapping of order q on straight sided geometry nodes should be the
+// linear mapping, for every q
+template <std::size_t DIM>
+void checkStraightSided(const Geometry::PhysicalGeometry<DIM>& geometry,
+                        const Geometry::MappingReferenceToPhysical& linear) {
+    for (std::size_t order = 1; order < 5; ++order) {
+        Geometry::MappingToPhysLagrange<DIM> mapping(&geometry, order);
+        for (std::size_t sample = 0; sample < 20; ++sample) {
+            Geometry::PointReference<DIM> point;
+            for (std::size_t i = 0; i < DIM; ++i) {
+                point[i] =
+                    0.2 + 0.03 * static_cast<double>((sample * (i + 3)) % 7);
+            }
+            Geometry::PointPhysical<DIM> expected = linear.transform(point);
+            Geometry::PointPhysical<DIM> actual = mapping.transform(point);
+            Geometry::Jacobian<DIM, DIM> expectedJacobian =
+                linear.calcJacobian(point);
+            Geometry::Jacobian<DIM, DIM> actualJacobian =
+                mapping.calcJacobian(point);
+            for (std::size_t i = 0; i < DIM; ++i) {
+                CHECK(std::abs(expected[i] - actual[i]) < 1e-12);
+                for (std::size_t j = 0; j < DIM; ++j) {
+                    CHECK(std::abs(expectedJacobian(i, j) -
+                                   actualJacobian(i, j)) < 1e-11);
+                }
+            }
+            Geometry::PointReference<DIM> inverse =
+                mapping.inverseTransform(actual);
+            for (std::size_t i = 0; i < DIM; ++i) {
+                CHECK(std::abs(inverse[i] - point[i]) < 1e-12);
+            }
+        }
+    }
+}
+
+// Quarter annulus between radius 1 and 2
+Geometry::PointPhysical<2> annulus(const Geometry::PointReference<2>& p) {
+    double radius = 1.5 + 0.5 * p[0];
+    double angle = M_PI / 4. * (1. + p[1]);
+    return {radius * std::cos(angle), radius * std::sin(angle)};
+}
+
+TEST_CASE("270MappingToPhysicalLagrange_UnitTest",
+          "[270MappingToPhysicalLagrange_UnitTest]") {
+    std::vector<Geometry::PointPhysical<1>> nodes1D = {{0.3}, {1.7}};
+    Geometry::PhysicalLine line({0, 1}, nodes1D);
+    checkStraightSided<1>(
+        line, Geometry::MappingToPhysHypercubeLinear<1>(&line));
+
+    std::vector<Geometry::PointPhysical<2>> nodes2D = {
+        {0.1, 0.2}, {1.3, 0.1}, {0.2, 1.1}, {1.5, 1.4}};
+    Geometry::PhysicalTriangle triangle({0, 1, 2}, nodes2D);
+    checkStraightSided<2>(
+        triangle, Geometry::MappingToPhysSimplexLinear<2>(&triangle));
+    Geometry::PhysicalQuadrilateral quadrilateral({0, 1, 2, 3}, nodes2D);
+    checkStraightSided<2>(
+        quadrilateral,
+        Geometry::MappingToPhysHypercubeLinear<2>(&quadrilateral));
+
+    std::vector<Geometry::PointPhysical<3>> nodes3D = {
+        {0.1, 0.2, 0.}, {1.3, 0.1, 0.1}, {0.2, 1.1, 0.},  {1.5, 1.4, 0.2},
+        {0., 0.1, 1.2}, {1.1, 0., 1.4},  {0.1, 1.2, 1.1}, {1.2, 1.3, 1.5}};
+    Geometry::PhysicalTetrahedron tetrahedron({0, 1, 2, 4}, nodes3D);
+    checkStraightSided<3>(
+        tetrahedron, Geometry::MappingToPhysSimplexLinear<3>(&tetrahedron));
+    Geometry::PhysicalHexahedron hexahedron({0, 1, 2, 3, 4, 5, 6, 7},
+                                            nodes3D);
+    checkStraightSided<3>(
+        hexahedron, Geometry::MappingToPhysHypercubeLinear<3>(&hexahedron));
+
+    // the geometry nodes of order 2 on a triangle: the vertices and the
+    // midpoints of the edges
+    Geometry::MappingToPhysLagrange<2> quadratic(&triangle, 2);
+    INFO("geometry nodes");
+    CHECK(quadratic.getNumberOfGeometryNodes() == 6);
+    CHECK(quadratic.getGeometryNodeVertices(0) ==
+          std::vector<std::size_t>({0}));
+    CHECK(quadratic.getGeometryNodeVertices(1) ==
+          std::vector<std::size_t>({0, 1}));
+    CHECK(quadratic.getGeometryNodeVertices(4) ==
+          std::vector<std::size_t>({1, 2}));
+    CHECK(quadratic.getGeometryNodeVertices(5) ==
+          std::vector<std::size_t>({2}));
+    Geometry::MappingToPhysLagrange<3> cubic(&hexahedron, 3);
+    CHECK(cubic.getNumberOfGeometryNodes() == 64);
+    CHECK(cubic.getGeometryNodeVertices(1) == std::vector<std::size_t>({0, 1}));
+    CHECK(cubic.getGeometryNodeVertices(21) ==
+          std::vector<std::size_t>({0, 1, 2, 3, 4, 5, 6, 7}));
+
+    // A quadrilateral with the geometry nodes on a quarter annulus converges
+    // to the annulus with the order of the mapping
+    std::vector<Geometry::PointPhysical<2>> annulusNodes = {
+        {1., 0.}, {2., 0.}, {0., 1.}, {0., 2.}};
+    Geometry::PhysicalQuadrilateral annulusElement({0, 1, 2, 3},
+                                                   annulusNodes);
+    QuadratureRules::GaussQuadratureRule* rule =
+        Geometry::ReferenceSquare::Instance().getGaussQuadratureRule(11);
+    double previousError = 1.;
+    for (std::size_t order = 1; order < 7; ++order) {
+        Geometry::MappingToPhysLagrange<2> mapping(&annulusElement, order);
+        for (std::size_t i = 0; i < mapping.getNumberOfGeometryNodes(); ++i) {
+            mapping.setGeometryNode(
+                i, annulus(mapping.getReferenceGeometryNode(i)));
+        }
+        double area = 0.;
+        for (std::size_t i = 0; i < rule->getNumberOfPoints(); ++i) {
+            const Geometry::PointReference<2>& point = rule->getPoint(i);
+            area += rule->weight(i) *
+                    std::abs(mapping.calcJacobian(point).determinant());
+        }
+        double error = std::abs(area - 3. * M_PI / 4.);
+        INFO("area of order " << order << " is " << area);
+        CHECK(error < previousError);
+        previousError = error;
+
+        // Jacobian against finite differences, and the cached values are the
+        // same as the first evaluation
+        Geometry::PointReference<2> point = {0.3, -0.6};
+        Geometry::Jacobian<2, 2> jacobian = mapping.calcJacobian(point);
+        Geometry::Jacobian<2, 2> cachedJacobian = mapping.calcJacobian(point);
+        for (std::size_t j = 0; j < 2; ++j) {
+            Geometry::PointReference<2> left = point, right = point;
+            left[j] -= 1e-6;
+            right[j] += 1e-6;
+            Geometry::PointPhysical<2> difference =
+                mapping.transform(right) - mapping.transform(left);
+            for (std::size_t i = 0; i < 2; ++i) {
+                CHECK(std::abs(jacobian(i, j) - difference[i] / 2e-6) < 1e-7);
+                CHECK(jacobian(i, j) == cachedJacobian(i, j));
+            }
+        }
+        Geometry::PointReference<2> inverse =
+            mapping.inverseTransform(mapping.transform(point));
+        CHECK(std::abs(inverse[0] - point[0]) < 1e-12);
+        CHECK(std::abs(inverse[1] - point[1]) < 1e-12);
+
+        // the curvature is kept when the vertices move
+        Geometry::PointPhysical<2> before = mapping.transform(point);
+        annulusNodes[1][0] += 0.25;
+        mapping.reinit();
+        Geometry::PointPhysical<2> after = mapping.transform(point);
+        Geometry::MappingToPhysHypercubeLinear<2> linear(&annulusElement);
+        Geometry::PointPhysical<2> linearAfter = linear.transform(point);
+        annulusNodes[1][0] -= 0.25;
+        linear.reinit();
+        Geometry::PointPhysical<2> linearBefore = linear.transform(point);
+        mapping.reinit();
+        CHECK(std::abs(after[0] - before[0] -
+                       (linearAfter[0] - linearBefore[0])) < 1e-12);
+        CHECK(std::abs(after[1] - before[1] -
+                       (linearAfter[1] - linearBefore[1])) < 1e-12);
+    }
+    CHECK(previousError < 1e-5);
+}
@@ -130,7 +130,7 @@ void testRule(QuadratureRules::GaussQuadratureRule& test,
             CHECK((std::abs(integrated + 0.0003743417373047) < 1e-12));
         } else if (i == 46 || i == 50) {
             INFO("integration");
-            CHECK((std::abs(integrated + 0.0045990061560235) < 1e-12));
+            CHECK((std::abs(integrated + 0.0003999135787847) < 1e-12));
         } else if (i == 47 || i == 49) {
             INFO("integration");
             CHECK((std::abs(integrated + 0.0005242977910035) < 1e-12));
@@ -142,7 +142,7 @@ void testRule(QuadratureRules::GaussQuadratureRule& test,
             CHECK((std::abs(integrated - 0.0004027275873253) < 1e-12));
         } else if (i == 57) {
             INFO("integration");
-            CHECK((std::abs(integrated + 0.001833588494787) < 1e-12));
+            CHECK((std::abs(integrated - 0.0002957400798044) < 1e-12));
         } else if (i == 58) {
             INFO("integration");
             CHECK((std::abs(integrated - 0.0002669631696782) < 1e-12));
@@ -151,7 +151,7 @@ void testRule(QuadratureRules::GaussQuadratureRule& test,
             CHECK((std::abs(integrated + 0.0002669631696782) < 1e-12));
         } else if (i == 60) {
             INFO("integration");
-            CHECK((std::abs(integrated - 0.001833588494787) < 1e-12));
+            CHECK((std::abs(integrated + 0.0002957400798044) < 1e-12));
         } else if (i == 61) {
             INFO("integration");
             CHECK((std::abs(integrated + 0.0004027275873253) < 1e-12));
@@ -169,7 +169,7 @@ void testRule(QuadratureRules::GaussQuadratureRule& test,
             CHECK((std::abs(integrated + 5.5593265874347e-05) < 1e-12));
         } else if (i == 69 || i == 71) {
             INFO("integration");
-            CHECK((std::abs(integrated - 0.0018449672212449) < 1e-12));
+            CHECK((std::abs(integrated - 0.0003137635545815) < 1e-12));
         } else if (i == 70) {
             INFO("integration");
             CHECK((std::abs(integrated - 0.00021701388888889) < 1e-12));
@@ -0,0 +1,126 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utilities/SpaceFillingCurvePartitioner.h"
+#include "../catch.hpp"
+
+using namespace hpgem;
+
+TEST_CASE("Morton index: quadrants", "[SpaceFillingCurve]") {
+    LinearAlgebra::SmallVector<2> lower({0, 0}), upper({1, 1});
+    std::uint64_t lowerLeft = Utilities::computeMortonIndex<2>(
+        LinearAlgebra::SmallVector<2>({0.25, 0.25}), lower, upper);
+    std::uint64_t lowerRight = Utilities::computeMortonIndex<2>(
+        LinearAlgebra::SmallVector<2>({0.75, 0.25}), lower, upper);
+    std::uint64_t upperLeft = Utilities::computeMortonIndex<2>(
+        LinearAlgebra::SmallVector<2>({0.25, 0.75}), lower, upper);
+    std::uint64_t upperRight = Utilities::computeMortonIndex<2>(
+        LinearAlgebra::SmallVector<2>({0.75, 0.75}), lower, upper);
+    // The curve visits the quadrants one after another
+    REQUIRE(lowerLeft < lowerRight);
+    REQUIRE(lowerRight < upperLeft);
+    REQUIRE(upperLeft < upperRight);
+}
+
+TEST_CASE("Partitioning along a curve: balance", "[SpaceFillingCurve]") {
+    std::size_t numberOfPartitions = GENERATE(1, 2, 3, 7);
+    // A 10x10 grid of points with more weight on the left half
+    std::vector<LinearAlgebra::SmallVector<2>> points;
+    std::vector<double> weights;
+    for (std::size_t i = 0; i < 10; ++i) {
+        for (std::size_t j = 0; j < 10; ++j) {
+            points.push_back(LinearAlgebra::SmallVector<2>(
+                {static_cast<double>(i) + 0.5, static_cast<double>(j) + 0.5}));
+            weights.push_back(i < 5 ? 4. : 1.);
+        }
+    }
+    std::vector<std::size_t> partitions =
+        Utilities::partitionAlongSpaceFillingCurve(points, weights,
+                                                   numberOfPartitions);
+    REQUIRE(partitions.size() == points.size());
+    std::vector<double> loads(numberOfPartitions, 0.);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        REQUIRE(partitions[i] < numberOfPartitions);
+        loads[partitions[i]] += weights[i];
+    }
+    const double average = 250. / static_cast<double>(numberOfPartitions);
+    for (double load : loads) {
+        // Off by at most the largest weight
+        REQUIRE(std::abs(load - average) <= 4.);
+    }
+}
+
+TEST_CASE("Partitioning along a curve: consecutive and non empty",
+          "[SpaceFillingCurve]") {
+    // One very heavy item should not leave partitions empty
+    std::vector<std::uint64_t> curveIndices = {5, 3, 0, 4, 1, 2};
+    std::vector<double> weights = {1, 1, 100, 1, 1, 1};
+    std::vector<std::size_t> partitions =
+        Utilities::partitionAlongCurve(curveIndices, weights, 4);
+    // In order along the curve the partitions do not decrease and increase by
+    // at most one.
+    std::vector<std::size_t> inCurveOrder(curveIndices.size());
+    for (std::size_t i = 0; i < curveIndices.size(); ++i) {
+        inCurveOrder[curveIndices[i]] = partitions[i];
+    }
+    REQUIRE(inCurveOrder.front() == 0);
+    REQUIRE(inCurveOrder.back() == 3);
+    for (std::size_t i = 1; i < inCurveOrder.size(); ++i) {
+        REQUIRE(inCurveOrder[i] >= inCurveOrder[i - 1]);
+        REQUIRE(inCurveOrder[i] <= inCurveOrder[i - 1] + 1);
+    }
+}
+
+TEST_CASE("Partitioning along a curve in parallel", "[SpaceFillingCurve]") {
+    std::size_t numberOfPartitions = GENERATE(1, 2, 3, 7);
+    std::vector<LinearAlgebra::SmallVector<2>> points;
+    std::vector<double> weights;
+    for (std::size_t i = 0; i < 10; ++i) {
+        for (std::size_t j = 0; j < 10; ++j) {
+            points.push_back(LinearAlgebra::SmallVector<2>(
+                {static_cast<double>(i) + 0.5, static_cast<double>(j) + 0.5}));
+            weights.push_back(i < 5 ? 4. : 1.);
+        }
+    }
+    // When no item is heavier than a partition, the bisection for the cuts
+    // finds the same partitions as walking along the sorted curve
+    REQUIRE(Utilities::partitionAlongSpaceFillingCurveInParallel(
+                points, weights, numberOfPartitions) ==
+            Utilities::partitionAlongSpaceFillingCurve(points, weights,
+                                                       numberOfPartitions));
+}
@@ -0,0 +1,158 @@
+/*
+ This file forms part of hpGEM. This package has been developed over a number of
+ years by various people at the University of Twente and a full list of
+ contributors can be found at http://hpgem.org/about-the-code/team
+
+ This code is distributed using BSD 3-Clause License. A copy of which can found
+ below.
+
+
+ Copyright (c) 2026, University of Twente
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ 3. Neither the name of the copyright holder nor the names of its contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utilities/BasisFunctionsOrthonormal.h"
+#include "Utilities/BasisFunctionsMonomials.h"
+#include "Base/BasisFunctionSet.h"
+#include "Geometry/PointReference.h"
+#include "Geometry/ReferenceCube.h"
+#include "Geometry/ReferenceLine.h"
+#include "Geometry/ReferenceSquare.h"
+#include "Geometry/ReferenceTetrahedron.h"
+#include "Geometry/ReferenceTriangle.h"
+#include "Integration/QuadratureRules/AllGaussQuadratureRules.h"
+#include "LinearAlgebra/SmallVector.h"
+#include <memory>
+
+#include "../catch.hpp"
+
+using namespace hpgem;
+
+// The mass matrix on the reference geometry should be the identity matrix
+template <std::size_t DIM>
+void checkOrthonormality(const Base::BasisFunctionSet& set,
+                         Geometry::ReferenceGeometry* geometry) {
+    QuadratureRules::GaussQuadratureRule* rule =
+        QuadratureRules::AllGaussQuadratureRules::instance().getRule(
+            geometry, 2 * set.getOrder());
+    for (std::size_t i = 0; i < set.size(); ++i) {
+        for (std::size_t j = 0; j < set.size(); ++j) {
+            double product = 0;
+            for (std::size_t q = 0; q < rule->getNumberOfPoints(); ++q) {
+                const Geometry::PointReference<DIM>& point = rule->getPoint(q);
+                product += rule->weight(q) * set.eval(i, point) *
+                           set.eval(j, point);
+            }
+            INFO("Basis functions " << i << " and " << j);
+            CHECK(product == Approx(i == j ? 1. : 0.).margin(1e-12));
+        }
+    }
+}
+
+// Compare the derivatives with central differences in the given points
+template <std::size_t DIM>
+void checkDerivatives(
+    const Base::BasisFunctionSet& set,
+    const std::vector<Geometry::PointReference<DIM>>& points) {
+    const double h = 1e-6;
+    for (const Geometry::PointReference<DIM>& point : points) {
+        for (std::size_t i = 0; i < set.size(); ++i) {
+            LinearAlgebra::SmallVector<DIM> derivative =
+                set[i]->evalDeriv(point);
+            for (std::size_t d = 0; d < DIM; ++d) {
+                Geometry::PointReference<DIM> left = point, right = point;
+                left[d] -= h;
+                right[d] += h;
+                double difference =
+                    (set.eval(i, right) - set.eval(i, left)) / (2 * h);
+                INFO("Basis function " << i << ", direction " << d);
+                CHECK(derivative[d] == Approx(difference).margin(1e-5));
+            }
+        }
+    }
+}
+
+TEST_CASE("Orthonormal basis functions: line", "[OrthonormalBasis]") {
+    std::unique_ptr<Base::BasisFunctionSet> set(
+        Utilities::createOrthonormalBasisFunctionSet1DLine(5));
+    REQUIRE(set->size() == 6);
+    CHECK(set->isOrthonormal());
+    checkOrthonormality<1>(*set, &Geometry::ReferenceLine::Instance());
+    checkDerivatives<1>(*set, {{-0.9}, {-0.3}, {0.}, {0.55}, {0.95}});
+}
+
+TEST_CASE("Orthonormal basis functions: square", "[OrthonormalBasis]") {
+    std::unique_ptr<Base::BasisFunctionSet> set(
+        Utilities::createOrthonormalBasisFunctionSet2DSquare(4));
+    REQUIRE(set->size() == 25);
+    CHECK(set->isOrthonormal());
+    checkOrthonormality<2>(*set, &Geometry::ReferenceSquare::Instance());
+    checkDerivatives<2>(*set, {{-0.9, 0.2}, {0.3, -0.7}, {0.8, 0.85}});
+}
+
+TEST_CASE("Orthonormal basis functions: triangle", "[OrthonormalBasis]") {
+    std::unique_ptr<Base::BasisFunctionSet> set(
+        Utilities::createOrthonormalBasisFunctionSet2DTriangle(5));
+    REQUIRE(set->size() == 21);
+    CHECK(set->isOrthonormal());
+    checkOrthonormality<2>(*set, &Geometry::ReferenceTriangle::Instance());
+    // includes points close to the collapsed vertex (0,1)
+    checkDerivatives<2>(*set, {{0.2, 0.3}, {0.6, 0.1}, {0.05, 0.9},
+                               {0.001, 0.99}, {0.3, 0.69}});
+}
+
+TEST_CASE("Orthonormal basis functions: cube", "[OrthonormalBasis]") {
+    std::unique_ptr<Base::BasisFunctionSet> set(
+        Utilities::createOrthonormalBasisFunctionSet3DCube(3));
+    REQUIRE(set->size() == 64);
+    CHECK(set->isOrthonormal());
+    checkOrthonormality<3>(*set, &Geometry::ReferenceCube::Instance());
+    checkDerivatives<3>(*set, {{-0.9, 0.2, 0.4}, {0.3, -0.7, -0.1}});
+}
+
+TEST_CASE("Orthonormal basis functions: tetrahedron", "[OrthonormalBasis]") {
+    std::unique_ptr<Base::BasisFunctionSet> set(
+        Utilities::createOrthonormalBasisFunctionSet3DTetrahedron(4));
+    REQUIRE(set->size() == 35);
+    CHECK(set->isOrthonormal());
+    checkOrthonormality<3>(*set, &Geometry::ReferenceTetrahedron::Instance());
+    // includes points close to the collapsed edge and vertex
+    checkDerivatives<3>(*set,
+                        {{0.2, 0.3, 0.1}, {0.1, 0.1, 0.7}, {0.01, 0.49, 0.49},
+                         {0.001, 0.002, 0.99}});
+}
+
+TEST_CASE("Orthonormal basis functions: adding a basis function",
+          "[OrthonormalBasis]") {
+    std::unique_ptr<Base::BasisFunctionSet> set(
+        Utilities::createOrthonormalBasisFunctionSet1DLine(1));
+    // the constant monomial is not orthogonal to the constant Legendre
+    // polynomial
+    Utilities::assembleMonomialBasisFunctions1D(*set, 0);
+    CHECK_FALSE(set->isOrthonormal());
+}